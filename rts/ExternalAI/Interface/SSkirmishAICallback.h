@@ -2273,6 +2273,23 @@ struct SSkirmishAICallback {
 
 	bool              (CALLING_CONV *Debug_GraphDrawer_isEnabled)(int skirmishAIId);
 
+	/**
+	 * Writes the state of all units matching <unitFilter> (a combination of
+	 * the UNIT_SNAPSHOT_* filter bits) into <records> in one call, see
+	 * aidefines.h for the layout. Enemy and neutral units are included if
+	 * they are in LOS or radar, and all fields follow the same visibility
+	 * rules as the matching Unit_get* callbacks (or those of the cheat
+	 * interface if cheats are enabled).
+	 * If <changedOnly> is true, only records which differ from the previous
+	 * snapshot taken with the same filter are written; units that are no
+	 * longer included get a record with all fields except unitId at -1.
+	 * Calling this with records set to NULL returns the required size
+	 * without writing anything, and in that case does not count as the
+	 * previous snapshot.
+	 * @return the number of floats written, including the header
+	 */
+	int               (CALLING_CONV *getUnitSnapshot)(int skirmishAIId, int unitFilter, bool changedOnly, float* records, int records_sizeMax); //$ ARRAY:records
+
 };
 
 #if	defined(__cplusplus)
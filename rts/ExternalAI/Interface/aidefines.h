@@ -82,4 +82,22 @@
 // Size of buffer for response from lua UI/Rules, including '\0'
 #define MAX_RESPONSE_SIZE 10240
 
+/**
+ * Layout of the buffer filled by SSkirmishAICallback::getUnitSnapshot.
+ * A header of UNIT_SNAPSHOT_HEADER_SIZE floats
+ *   (UNIT_SNAPSHOT_VERSION, frame, number of records, UNIT_SNAPSHOT_RECORD_SIZE)
+ * is followed by one record of UNIT_SNAPSHOT_RECORD_SIZE floats per unit:
+ *   (unitId, unitDefId, teamId, losStatus, health, maxHealth, pos[3], vel[3])
+ * Fields the AI could not query through the single-unit callbacks hold -1
+ * (or 0 for pos and vel), exactly like those callbacks would return.
+ */
+#define UNIT_SNAPSHOT_VERSION     1
+#define UNIT_SNAPSHOT_HEADER_SIZE 4
+#define UNIT_SNAPSHOT_RECORD_SIZE 12
+
+/// unit filter bits for SSkirmishAICallback::getUnitSnapshot
+#define UNIT_SNAPSHOT_FRIENDLY 1
+#define UNIT_SNAPSHOT_ENEMY    2
+#define UNIT_SNAPSHOT_NEUTRAL  4
+
 #endif // AI_DEFINES_H
@@ -41,6 +41,7 @@
 #include "Sim/Misc/ResourceMapAnalyzer.h"
 #include "Sim/Misc/LosHandler.h"
 #include "Sim/Misc/TeamHandler.h"
+#include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/QuadField.h" // for quadField.GetFeaturesExact(pos, radius)
 #include "System/SafeCStrings.h"
@@ -62,6 +63,23 @@ static std::vector<LineMarker> AI_TMP_LINE_MARKERS[MAX_AIS];
 static constexpr size_t MAX_NUM_MARKERS = 16384;
 
 
+struct UnitSnapshotState {
+	int unitFilter = -1;
+
+	/// previous snapshot, UNIT_SNAPSHOT_RECORD_SIZE floats per unit-id
+	std::vector<float> records;
+	/// ids of the units in it
+	std::vector<int> unitIds;
+	/// full records and ids of the units in the snapshot being assembled
+	std::vector<float> current;
+	std::vector<int> currentIds;
+	/// what is written to the AI's buffer
+	std::vector<float> output;
+};
+
+static UnitSnapshotState AI_UNIT_SNAPSHOTS[MAX_AIS];
+
+
 static inline CAICallback* GetCallBack(int skirmishAIId) { return &AI_LEGACY_CALLBACKS[skirmishAIId].first; }
 static inline CAICheats* GetCheatCallBack(int skirmishAIId) { return &AI_LEGACY_CALLBACKS[skirmishAIId].second; }
 
@@ -3976,6 +3994,159 @@ EXPORT(int) skirmishAiCallback_getTeamUnits(int skirmishAIId, int* unitIds, int
 	return a;
 }
 
+static void FillUnitSnapshotRecord(int skirmishAIId, const CUnit* unit, float* record) {
+	const int allyTeam = teamHandler.AllyTeam(AI_TEAM_IDS[skirmishAIId]);
+	const int losStatus = unit->losStatus[allyTeam];
+
+	const UnitDef* unitDef = unit->unitDef;
+	const UnitDef* decoyDef = unitDef->decoyDef;
+
+	std::fill(record, record + UNIT_SNAPSHOT_RECORD_SIZE, -1.0f);
+
+	record[0] = unit->id;
+	record[3] = losStatus;
+
+	if (skirmishAiCallback_Cheats_isEnabled(skirmishAIId) || teamHandler.Ally(unit->allyteam, allyTeam)) {
+		const float3 pos = skirmishAiCallback_Cheats_isEnabled(skirmishAIId)? float3(unit->midPos): unit->GetErrorPos(allyTeam);
+
+		record[1] = unitDef->id;
+		record[2] = unit->team;
+		record[4] = unit->health;
+		record[5] = unit->maxHealth;
+
+		pos.copyInto(&record[6]);
+		unit->speed.copyInto(&record[9]);
+		return;
+	}
+
+	// same rules as CAICallback::GetUnit{Def,Team,Health,MaxHealth,Pos,Velocity}
+	constexpr unsigned short prevMask = (LOS_PREVLOS | LOS_CONTRADAR);
+
+	if ((losStatus & LOS_INLOS) != 0 || (losStatus & prevMask) == prevMask)
+		record[1] = ((decoyDef == nullptr)? unitDef: decoyDef)->id;
+
+	if ((losStatus & LOS_INLOS) != 0) {
+		const float scale = (decoyDef == nullptr)? 1.0f: (decoyDef->health / unitDef->health);
+
+		record[2] = unit->team;
+		record[4] = unit->health * scale;
+		record[5] = unit->maxHealth * scale;
+	}
+
+	if ((losStatus & (LOS_INLOS | LOS_INRADAR)) != 0) {
+		unit->GetErrorPos(allyTeam).copyInto(&record[6]);
+		unit->speed.copyInto(&record[9]);
+	} else {
+		ZeroVector.copyInto(&record[6]);
+		ZeroVector.copyInto(&record[9]);
+	}
+}
+
+static bool IsUnitSnapshotUnit(int skirmishAIId, const CUnit* unit, int unitFilter) {
+	const int allyTeam = teamHandler.AllyTeam(AI_TEAM_IDS[skirmishAIId]);
+	const bool allied = teamHandler.Ally(unit->allyteam, allyTeam);
+	const bool sensed = skirmishAiCallback_Cheats_isEnabled(skirmishAIId) || (unit->losStatus[allyTeam] & (LOS_INLOS | LOS_INRADAR)) != 0;
+
+	// same rules as get{Friendly,EnemyUnitsInRadarAndLos,Neutral}Units
+	if (unit->IsNeutral())
+		return ((unitFilter & UNIT_SNAPSHOT_NEUTRAL) != 0 && (allied || sensed));
+	if (allied)
+		return ((unitFilter & UNIT_SNAPSHOT_FRIENDLY) != 0);
+
+	return ((unitFilter & UNIT_SNAPSHOT_ENEMY) != 0 && sensed);
+}
+
+EXPORT(int) skirmishAiCallback_getUnitSnapshot(int skirmishAIId, int unitFilter, bool changedOnly, float* records, int recordsMaxSize) {
+	UnitSnapshotState& state = AI_UNIT_SNAPSHOTS[skirmishAIId];
+
+	std::vector<float>& output = state.output;
+	std::vector<float>& current = state.current;
+	std::vector<int>& currentIds = state.currentIds;
+
+	if (state.records.empty())
+		state.records.resize(unitHandler.MaxUnits() * UNIT_SNAPSHOT_RECORD_SIZE, -1.0f);
+
+	// a different filter makes the previous snapshot useless for deltas
+	changedOnly &= (unitFilter == state.unitFilter);
+
+	current.clear();
+	currentIds.clear();
+
+	output.clear();
+	output.resize(UNIT_SNAPSHOT_HEADER_SIZE, 0.0f);
+
+	for (const CUnit* u: unitHandler.GetActiveUnits()) {
+		if (!IsUnitSnapshotUnit(skirmishAIId, u, unitFilter))
+			continue;
+
+		current.resize(current.size() + UNIT_SNAPSHOT_RECORD_SIZE);
+		currentIds.push_back(u->id);
+
+		const float* record = &current[current.size() - UNIT_SNAPSHOT_RECORD_SIZE];
+		const float* prevRecord = &state.records[u->id * UNIT_SNAPSHOT_RECORD_SIZE];
+
+		FillUnitSnapshotRecord(skirmishAIId, u, &current[current.size() - UNIT_SNAPSHOT_RECORD_SIZE]);
+
+		if (changedOnly && std::equal(record, record + UNIT_SNAPSHOT_RECORD_SIZE, prevRecord))
+			continue;
+
+		output.insert(output.end(), record, record + UNIT_SNAPSHOT_RECORD_SIZE);
+	}
+
+	if (changedOnly) {
+		float record[UNIT_SNAPSHOT_RECORD_SIZE];
+
+		std::fill(record, record + UNIT_SNAPSHOT_RECORD_SIZE, -1.0f);
+
+		// units which dropped out since the previous snapshot (or died)
+		for (const int unitId: state.unitIds) {
+			const CUnit* u = unitHandler.GetUnit(unitId);
+
+			if (u != nullptr && IsUnitSnapshotUnit(skirmishAIId, u, unitFilter))
+				continue;
+
+			record[0] = unitId;
+			output.insert(output.end(), record, record + UNIT_SNAPSHOT_RECORD_SIZE);
+		}
+	}
+
+	output[0] = UNIT_SNAPSHOT_VERSION;
+	output[1] = gs->frameNum;
+	output[2] = (output.size() - UNIT_SNAPSHOT_HEADER_SIZE) / UNIT_SNAPSHOT_RECORD_SIZE;
+	output[3] = UNIT_SNAPSHOT_RECORD_SIZE;
+
+	if (records == nullptr)
+		return (output.size());
+
+	if (recordsMaxSize < int(output.size())) {
+		if (recordsMaxSize < UNIT_SNAPSHOT_HEADER_SIZE)
+			return 0;
+
+		// truncated snapshots are not remembered, the next delta repeats them
+		const int numFit = (recordsMaxSize - UNIT_SNAPSHOT_HEADER_SIZE) / UNIT_SNAPSHOT_RECORD_SIZE;
+		const int numOut = UNIT_SNAPSHOT_HEADER_SIZE + numFit * UNIT_SNAPSHOT_RECORD_SIZE;
+
+		output[2] = numFit;
+
+		std::copy(output.begin(), output.begin() + numOut, records);
+		return numOut;
+	}
+
+	std::copy(output.begin(), output.end(), records);
+
+	// remember the complete state for the next delta, not the delta itself
+	for (const int unitId: state.unitIds) {
+		state.records[unitId * UNIT_SNAPSHOT_RECORD_SIZE] = -1.0f;
+	}
+	for (size_t i = 0; i < currentIds.size(); i++) {
+		std::copy_n(&current[i * UNIT_SNAPSHOT_RECORD_SIZE], UNIT_SNAPSHOT_RECORD_SIZE, &state.records[currentIds[i] * UNIT_SNAPSHOT_RECORD_SIZE]);
+	}
+
+	state.unitFilter = unitFilter;
+	state.unitIds.swap(currentIds);
+	return (output.size());
+}
+
 
 //########### BEGINN Team
 EXPORT(bool) skirmishAiCallback_Team_hasAIController(int skirmishAIId, int teamId) {
@@ -5655,6 +5826,7 @@ static void skirmishAiCallback_init(SSkirmishAICallback* callback) {
 	callback->Unit_Weapon_isShieldEnabled = &skirmishAiCallback_Unit_Weapon_isShieldEnabled;
 	callback->Unit_Weapon_getShieldPower = &skirmishAiCallback_Unit_Weapon_getShieldPower;
 	callback->Debug_GraphDrawer_isEnabled = &skirmishAiCallback_Debug_GraphDrawer_isEnabled;
+	callback->getUnitSnapshot = &skirmishAiCallback_getUnitSnapshot;
 }
 
 SSkirmishAICallback* skirmishAiCallback_GetInstance(CSkirmishAIWrapper* ai)
@@ -5676,6 +5848,7 @@ void skirmishAiCallback_Release(const CSkirmishAIWrapper* ai) {
 
 	AI_CHEAT_FLAGS[ai->GetSkirmishAIID()] = {false, false};
 	AI_TEAM_IDS[ai->GetSkirmishAIID()] = -1;
+	AI_UNIT_SNAPSHOTS[ai->GetSkirmishAIID()] = {};
 }
 
 void skirmishAiCallback_BlockOrders(const CSkirmishAIWrapper* ai)
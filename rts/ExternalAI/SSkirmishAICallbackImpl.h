@@ -658,6 +658,8 @@ EXPORT(int              ) skirmishAiCallback_getNeutralUnitsIn(int skirmishAIId,
 
 EXPORT(int              ) skirmishAiCallback_getTeamUnits(int skirmishAIId, int* unitIds, int unitIds_sizeMax);
 
+EXPORT(int              ) skirmishAiCallback_getUnitSnapshot(int skirmishAIId, int unitFilter, bool changedOnly, float* records, int records_sizeMax);
+
 EXPORT(int              ) skirmishAiCallback_getSelectedUnits(int skirmishAIId, int* unitIds, int unitIds_sizeMax);
 
 EXPORT(int              ) skirmishAiCallback_Unit_getDef(int skirmishAIId, int unitId);
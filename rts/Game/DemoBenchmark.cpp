@@ -0,0 +1,151 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <cstdio>
+
+#include "DemoBenchmark.h"
+#include "GlobalUnsynced.h"
+#include "Sim/Units/UnitDef.h"
+#include "Sim/Units/UnitDefHandler.h"
+#include "Sim/Units/UnitDefProfiler.h"
+#include "System/TimeProfiler.h"
+#include "System/Log/ILog.h"
+#ifdef SYNCCHECK
+	#include "System/Sync/SyncChecker.h"
+#endif
+
+CDemoBenchmark demoBenchmark;
+
+constexpr const char* CDemoBenchmark::PHASE_NAMES[];
+
+
+void CDemoBenchmark::Init(const std::string& demo, int frames)
+{
+	demoFile = demo;
+	numFrames = std::max(frames, 0);
+	enabled = true;
+
+	frameRecords.clear();
+	frameRecords.reserve(numFrames);
+	phaseTotals.fill(spring_notime);
+
+	LOG("[DemoBenchmark::%s] replaying \"%s\" for %d frames", __func__, demoFile.c_str(), numFrames);
+}
+
+
+void CDemoBenchmark::Update(int frameNum)
+{
+	if (!enabled)
+		return;
+
+	if (frameRecords.empty()) {
+		// only special timers contribute while the profiler is disabled
+		profiler.SetEnabled(true);
+		startTime = spring_gettime();
+	}
+
+	FrameRecord fr;
+	fr.frameNum = frameNum;
+	#ifdef SYNCCHECK
+	fr.checksum = CSyncChecker::GetChecksum();
+	#else
+	fr.checksum = 0;
+	#endif
+
+	for (size_t i = 0; i < NUM_PHASES; i++) {
+		const spring_time phaseTotal = profiler.GetTimeRecord(PHASE_NAMES[i]).total;
+
+		fr.phaseTimes[i] = (phaseTotal - phaseTotals[i]).toMilliSecsf();
+		phaseTotals[i] = phaseTotal;
+	}
+
+	frameRecords.push_back(fr);
+
+	// server reports the total once it has sent the entire demo stream
+	const int demoFrames = numDemoFrames.load();
+	const int lastFrame = (numFrames > 0)? numFrames: demoFrames;
+
+	if (lastFrame <= 0 || (frameNum + 1) < lastFrame)
+		return;
+
+	Write();
+
+	enabled = false;
+	gu->globalQuit = true;
+}
+
+
+bool CDemoBenchmark::Write() const
+{
+	const char* fileName = "benchmark.json";
+	FILE* out = fopen(fileName, "wt");
+
+	if (out == nullptr) {
+		LOG_L(L_ERROR, "[DemoBenchmark::%s] could not open \"%s\"", __func__, fileName);
+		return false;
+	}
+
+	std::array<float, NUM_PHASES> sumTimes;
+	sumTimes.fill(0.0f);
+
+	fprintf(out, "{\n\t\"demo\": \"%s\",\n\t\"numFrames\": %u,\n\t\"wallTime\": %.3f,\n\t\"frames\": [\n", demoFile.c_str(), static_cast<unsigned>(frameRecords.size()), (spring_gettime() - startTime).toMilliSecsf());
+
+	for (size_t n = 0; n < frameRecords.size(); n++) {
+		const FrameRecord& fr = frameRecords[n];
+
+		fprintf(out, "\t\t{\"frame\": %d, \"checksum\": %u", fr.frameNum, fr.checksum);
+
+		for (size_t i = 0; i < NUM_PHASES; i++) {
+			fprintf(out, ", \"%s\": %.4f", PHASE_NAMES[i], fr.phaseTimes[i]);
+			sumTimes[i] += fr.phaseTimes[i];
+		}
+
+		fprintf(out, "}%s\n", (n + 1 < frameRecords.size())? ",": "");
+	}
+
+	fprintf(out, "\t],\n\t\"totals\": {");
+
+	for (size_t i = 0; i < NUM_PHASES; i++) {
+		fprintf(out, "%s\"%s\": %.3f", (i == 0)? "": ", ", PHASE_NAMES[i], sumTimes[i]);
+	}
+
+	fprintf(out, "}");
+
+	if (unitDefProfiler.IsEnabled()) {
+		// per-type sim cost over the whole run, types that never ran are skipped
+		const std::vector<CUnitDefProfiler::Counter>& totals = unitDefProfiler.GetTotals();
+
+		const char* sep = "";
+
+		fprintf(out, ",\n\t\"unitDefs\": {");
+
+		for (size_t defID = 1; defID < unitDefProfiler.NumUnitDefs(); defID++) {
+			const CUnitDefProfiler::Counter* counters = &totals[defID * CUnitDefProfiler::CAT_COUNT];
+
+			uint64_t numCalls = 0;
+
+			for (unsigned int cat = 0; cat < CUnitDefProfiler::CAT_COUNT; cat++) {
+				numCalls += counters[cat].calls;
+			}
+
+			if (numCalls == 0)
+				continue;
+
+			fprintf(out, "%s\n\t\t\"%s\": {", sep, unitDefHandler->GetUnitDefByID(defID)->name.c_str());
+
+			for (unsigned int cat = 0; cat < CUnitDefProfiler::CAT_COUNT; cat++) {
+				fprintf(out, "%s\"%s\": {\"time\": %.3f, \"calls\": %lu}", (cat == 0)? "": ", ", CUnitDefProfiler::GetCategoryName(cat), counters[cat].nanos * 1e-6, static_cast<unsigned long>(counters[cat].calls));
+			}
+
+			fprintf(out, "}");
+			sep = ",";
+		}
+
+		fprintf(out, "\n\t}");
+	}
+
+	fprintf(out, "\n}\n");
+	fclose(out);
+
+	LOG("[DemoBenchmark::%s] wrote %u frames to \"%s\"", __func__, static_cast<unsigned>(frameRecords.size()), fileName);
+	return true;
+}
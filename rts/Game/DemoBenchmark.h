@@ -0,0 +1,73 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _DEMO_BENCHMARK_H
+#define _DEMO_BENCHMARK_H
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "System/Misc/SpringTime.h"
+
+/**
+ * Replays a demo as fast as possible (see --benchmark-demo) and records
+ * per-frame timings of the main sim phases plus the sync checksum, which
+ * are written as JSON once the wanted number of frames has been reached
+ * or the demo ran out.
+ */
+class CDemoBenchmark {
+public:
+	static constexpr const char* PHASE_NAMES[] = {
+		"Sim",
+		"Sim::GameFrame",
+		"Sim::Unit",
+		"Sim::Projectiles",
+		"Sim::Path",
+		"Sim::Los",
+		"Sim::Script",
+	};
+
+	static constexpr size_t NUM_PHASES = sizeof(PHASE_NAMES) / sizeof(PHASE_NAMES[0]);
+
+	struct FrameRecord {
+		int frameNum;
+		unsigned int checksum;
+
+		std::array<float, NUM_PHASES> phaseTimes; // ms
+	};
+
+public:
+	void Init(const std::string& demo, int frames);
+
+	bool IsEnabled() const { return enabled; }
+
+	// number of frames the server should skip to; 0 means the entire demo
+	int GetNumFrames() const { return numFrames; }
+
+	// called by the (local) server thread when the demo stream has ended
+	void SetNumDemoFrames(int frames) { numDemoFrames.store(frames); }
+
+	// called after each SimFrame
+	void Update(int frameNum);
+
+private:
+	bool Write() const;
+
+private:
+	std::string demoFile;
+	std::vector<FrameRecord> frameRecords;
+
+	std::array<spring_time, NUM_PHASES> phaseTotals;
+
+	spring_time startTime;
+
+	std::atomic<int> numDemoFrames = {0};
+
+	int numFrames = 0;
+	bool enabled = false;
+};
+
+extern CDemoBenchmark demoBenchmark;
+
+#endif
@@ -8,6 +8,7 @@
 #include "ChatMessage.h"
 #include "CommandMessage.h"
 #include "ConsoleHistory.h"
+#include "DemoBenchmark.h"
 #include "GameHelper.h"
 #include "GameSetup.h"
 #include "GlobalUnsynced.h"
@@ -39,16 +40,19 @@
 #include "Rendering/CommandDrawer.h"
 #include "Rendering/LineDrawer.h"
 #include "Rendering/GlobalRendering.h"
+#include "Rendering/GPUProfiler.h"
 #include "Rendering/DebugDrawerAI.h"
 #include "Rendering/HUDDrawer.h"
 #include "Rendering/IconHandler.h"
 #include "Rendering/ModelsDataUploader.h"
+#include "Rendering/QualityGovernor.h"
 #include "Rendering/ShadowHandler.h"
 #include "Rendering/TeamHighlight.h"
 #include "Rendering/Units/UnitDrawer.h"
 #include "Rendering/UniformConstants.h"
 #include "Rendering/Map/InfoTexture/IInfoTextureHandler.h"
 #include "Rendering/Textures/NamedTextures.h"
+#include "Lua/LuaDefsCache.h"
 #include "Lua/LuaGaia.h"
 #include "Lua/LuaHandle.h"
 #include "Lua/LuaInputReceiver.h"
@@ -113,6 +117,7 @@
 #include "System/Sync/FPUCheck.h"
 #include "System/SafeUtil.h"
 #include "System/SpringExitCode.h"
+#include "System/SpringFormat.h"
 #include "System/SpringMath.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/LoadSave/LoadSaveHandler.h"
@@ -123,13 +128,16 @@
 #include "System/Sound/ISound.h"
 #include "System/Sound/ISoundChannels.h"
 #include "System/Sync/DumpState.h"
+#include "System/Sync/SyncedPrimitiveBase.h"
 #include "System/TimeProfiler.h"
 
 
 #undef CreateDirectory
 
 CONFIG(bool, GameEndOnConnectionLoss).defaultValue(true);
+CONFIG(int, DemoKeyframeInterval).defaultValue(0).minimumValue(0).description("Number of game-seconds between savestates written next to the recorded (or watched) demo as <demo>_f<frame>.ssf, from which that point of the game can be restored directly. Each savestate briefly stalls the game; 0 disables them.");
 // CONFIG(bool, LuaCollectGarbageOnSimFrame).defaultValue(true);
+CONFIG(float, LuaGarbageCollectionDrawFrameTime).defaultValue(0.0f).minimumValue(0.0f).description("If positive, unsynced Lua handles no longer collect garbage during simulation frames but at the end of each draw-frame, for at most the time left until this many milliseconds have passed since the frame started (but at least 0.5ms). Use the target frame time, e.g. 16.6 for 60Hz.");
 
 CONFIG(bool, WindowedEdgeMove).defaultValue(true).description("Sets whether moving the mouse cursor to the screen edge will move the camera across the map.");
 CONFIG(bool, FullscreenEdgeMove).defaultValue(true).description("see WindowedEdgeMove, just for fullscreen mode");
@@ -141,6 +149,8 @@ CONFIG(int, ShowPlayerInfo).defaultValue(1).headlessValue(0);
 CONFIG(float, GuiOpacity).defaultValue(0.8f).minimumValue(0.0f).maximumValue(1.0f).description("Sets the opacity of the built-in Spring UI. Generally has no effect on LuaUI widgets. Can be set in-game using shift+, to decrease and shift+. to increase.");
 CONFIG(std::string, InputTextGeo).defaultValue("");
 
+CONFIG(int, HeadlessStepFrames).defaultValue(0).minimumValue(0).description("With spring-headless as host, simulate this many frames per engine update as fast as possible instead of pacing the game at its wall-clock speed; the next batch is only created once the previous one was simulated. 0 disables stepping.");
+CONFIG(bool, HeadlessDemoSimOnly).defaultValue(false).description("When replaying a demo with spring-headless, do not load LuaUI and skip all per-frame unsynced updates (UI, sound, camera, world and Lua Update/Draw call-ins), so playback speed is only limited by the simulation. Synced state and checksums are unaffected.");
 CONFIG(int, SmoothTimeOffset).defaultValue(0).headlessValue(0).description("Enables frametimeoffset smoothing, 0 = off (old version), -1 = forced 0.5,  1-20 smooth, recommended = 2-3");
 
 CGame* game = nullptr;
@@ -186,11 +196,14 @@ CR_REG_METADATA(CGame, (
 	CR_MEMBER(gameID),
 
 	CR_IGNORED(skipping),
+	CR_IGNORED(simOnly),
+	CR_IGNORED(stepFrames),
 	CR_MEMBER(playing),
 	CR_IGNORED(paused),
 
 	CR_IGNORED(msgProcTimeLeft),
 	CR_IGNORED(consumeSpeedMult),
+	CR_IGNORED(serverFrameNum),
 
 /*
 	CR_IGNORED(skipStartFrame),
@@ -204,6 +217,8 @@ CR_REG_METADATA(CGame, (
 
 	CR_MEMBER(speedControl),
 	CR_MEMBER(luaGCControl),
+	CR_IGNORED(demoKeyframeInterval),
+	CR_IGNORED(luaGCDrawFrameTime),
 
 	CR_IGNORED(jobDispatcher),
 	CR_IGNORED(curKeyChain),
@@ -246,6 +261,12 @@ CGame::CGame(const std::string& mapFileName, const std::string& modFileName, ILo
 	showSpeed = configHandler->GetBool("ShowSpeed");
 
 	speedControl = configHandler->GetInt("SpeedControl");
+	simOnly = SpringVersion::IsHeadless() && gameSetup->hostDemo && configHandler->GetBool("HeadlessDemoSimOnly");
+	stepFrames = SpringVersion::IsHeadless()? configHandler->GetInt("HeadlessStepFrames"): 0;
+	demoKeyframeInterval = configHandler->GetInt("DemoKeyframeInterval") * GAME_SPEED;
+	luaGCDrawFrameTime = configHandler->GetFloat("LuaGarbageCollectionDrawFrameTime");
+
+	CLuaHandle::SetUnsyncedGCTimeBudget((luaGCDrawFrameTime > 0.0f)? 0.0f: -1.0f);
 
 	playerRoster.SetSortTypeByCode((PlayerRoster::SortType)configHandler->GetInt("ShowPlayerInfo"));
 
@@ -289,6 +310,8 @@ CGame::~CGame()
 
 	KillLua(true);
 	KillMisc();
+
+	CLuaHandle::SetUnsyncedGCTimeBudget(-1.0f);
 	KillRendering();
 	KillInterface();
 	KillSimulation();
@@ -519,8 +542,8 @@ void CGame::LoadDefs(LuaParser* defsParser)
 		defsParser->AddFunc("GetMapOptions", LuaSyncedRead::GetMapOptions);
 		defsParser->EndTable();
 
-		// run the parser
-		if (!defsParser->Execute())
+		// run the parser, or restore its result from an earlier run
+		if (!LuaDefsCache::Execute(defsParser))
 			throw content_error("Defs-Parser: " + defsParser->GetErrorLog());
 
 		const LuaTable& root = defsParser->GetRoot();
@@ -576,9 +599,12 @@ void CGame::PreLoadSimulation(LuaParser* defsParser)
 	loadscreen->SetLoadMessage("Creating Smooth Height Mesh");
 	smoothGround.Init(float3::maxxpos, float3::maxzpos, SQUARE_SIZE * 2, SQUARE_SIZE * 40);
 
+	loadscreen->SetLoadMessage("Analyzing Metal Map");
+	resourceHandler->GetResourceMapAnalyzer(resourceHandler->GetMetalId());
+
 	loadscreen->SetLoadMessage("Creating QuadField & CEGs");
 	moveDefHandler.Init(defsParser);
-	quadField.Init(int2(mapDims.mapx, mapDims.mapy), CQuadField::BASE_QUAD_SIZE);
+	quadField.Init(int2(mapDims.mapx, mapDims.mapy), CQuadField::CalcQuadSize(int2(mapDims.mapx, mapDims.mapy), modInfo.quadFieldQuadSizeInElmos));
 	damageArrayHandler.Init(defsParser);
 	explGenHandler.Init();
 }
@@ -613,6 +639,7 @@ void CGame::PostLoadSimulation(LuaParser* defsParser)
 	unitHandler.Init();
 	featureHandler.Init();
 	projectileHandler.Init();
+	qualityGovernor.Init();
 	CLosHandler::InitStatic();
 
 	readMap->InitHeightMapDigestVectors(losHandler->los.size);
@@ -782,7 +809,7 @@ void CGame::LoadLua(bool dryRun, bool onlyUnsynced)
 
 	LEAVE_SYNCED_CODE();
 
-	if (!dryRun) {
+	if (!dryRun && !simOnly) {
 		loadscreen->SetLoadMessage("Loading LuaUI");
 		CLuaUI::LoadFreeHandler();
 	}
@@ -871,6 +898,7 @@ void CGame::KillLua(bool dtor)
 	CLuaRules::FreeHandler();
 
 	CSplitLuaHandle::ClearGameParams();
+	LuaRulesParams::unitParamChanges.Clear(-1);
 	LEAVE_SYNCED_CODE();
 
 
@@ -904,6 +932,7 @@ void CGame::KillRendering()
 	icon::iconHandler.Kill();
 	spring::SafeDelete(geometricObjects);
 	worldDrawer.Kill();
+	gpuProfiler.Kill();
 	matrixUploader.Kill();
 	modelsUniformsUploader.Kill();
 }
@@ -1203,6 +1232,13 @@ bool CGame::Update()
 	if (playing && gameServer != nullptr && videoCapturing->AllowRecord())
 		gameServer->CreateNewFrame(false, true);
 
+	// headless stepping, the server creates no frames by itself then
+	if (playing && gameServer != nullptr && stepFrames > 0 && gs->frameNum >= gameServer->GetServerFrameNum()) {
+		for (int i = 0; i < stepFrames; i++) {
+			gameServer->CreateNewFrame(false, true);
+		}
+	}
+
 	ENTER_SYNCED_CODE();
 	SendClientProcUsage();
 	ClientReadNet(); // issues new SimFrame()s
@@ -1278,6 +1314,16 @@ bool CGame::UpdateUnsynced(const spring_time currentTime)
 		}
 	}
 
+	if (simOnly) {
+		// nothing is ever drawn, just keep the unsynced Lua heaps in check
+		if (spring_tomsecs(currentTime - skipLastDrawTime) >= 500.0f) {
+			skipLastDrawTime = currentTime;
+			CollectUnsyncedGarbage(0.0f);
+		}
+
+		return true;
+	}
+
 	if (skipping) {
 		// when fast-forwarding, maintain a draw-rate of 2Hz
 		if (spring_tomsecs(currentTime - skipLastDrawTime) < 500.0f)
@@ -1468,6 +1514,7 @@ bool CGame::Draw() {
 
 	SCOPED_SPECIAL_TIMER("Draw");
 	globalRendering->SetGLTimeStamp(CGlobalRendering::FRAME_REF_TIME_QUERY_IDX);
+	gpuProfiler.BeginFrame();
 
 	SetDrawMode(gameNormalDraw);
 
@@ -1480,6 +1527,8 @@ bool CGame::Draw() {
 	}
 
 	if (!globalRendering->active) {
+		// still collect while minimized, gc would otherwise wait for a drawn frame
+		CollectUnsyncedGarbage(0.0f);
 		spring_sleep(spring_msecs(10));
 
 		// return early if and only if less than 30K milliseconds have passed since last draw-frame
@@ -1566,13 +1615,29 @@ bool CGame::Draw() {
 	const spring_time currentTimePostDraw = spring_gettime();
 	const spring_time currentFrameDrawTime = currentTimePostDraw - currentTimePreDraw;
 	gu->avgDrawFrameTime = mix(gu->avgDrawFrameTime, currentFrameDrawTime.toMilliSecsf(), 0.05f);
+	qualityGovernor.Update(gu->avgDrawFrameTime);
 
 	eventHandler.DbgTimingInfo(TIMING_VIDEO, currentTimePreDraw, currentTimePostDraw);
 	globalRendering->SetGLTimeStamp(CGlobalRendering::FRAME_END_TIME_QUERY_IDX);
 
+	// spend the slack left before the buffer-swap on unsynced gc
+	CollectUnsyncedGarbage((currentTimePostDraw - currentTimePreUpdate).toMilliSecsf());
 	return true;
 }
 
+void CGame::CollectUnsyncedGarbage(float usedFrameTime)
+{
+	if (luaGCDrawFrameTime <= 0.0f)
+		return;
+
+	SCOPED_TIMER("Draw::CollectGarbage");
+
+	// unsynced handles share this budget and skip collection at any other time
+	CLuaHandle::SetUnsyncedGCTimeBudget(std::max(luaGCDrawFrameTime - usedFrameTime, 0.5f));
+	eventHandler.CollectGarbage(false);
+	CLuaHandle::SetUnsyncedGCTimeBudget(0.0f);
+}
+
 
 void CGame::DrawInputReceivers()
 {
@@ -1696,6 +1761,7 @@ void CGame::SimFrame() {
 	// note: starts at -1, first actual frame is 0
 	gs->frameNum += 1;
 	lastFrameTime = spring_gettime(); 
+	profiler.SetTraceFrame(gs->frameNum);
 	// This is not very ideal, as the timeoffset of each new draw frame is also calculated from this
 	// with a strange side effect: if the timeOffset was a high number, like 0.9, then this will force the next draw frame to have an offset of 0.0x
 	// What this means, is that in the case where we have frames to spare, and and over rendering, then the following can happen at 60hz:
@@ -1726,7 +1792,7 @@ void CGame::SimFrame() {
 	// stats are reliable when paused) but see LuaUser
 	spring_lua_alloc_update_stats((gs->frameNum % GAME_SPEED) == 0);
 
-	if (!skipping) {
+	if (!skipping && !simOnly) {
 		// everything here is unsynced and should ideally moved to Game::Update()
 		waitCommandsAI.Update();
 		geometricObjects->Update();
@@ -1750,6 +1816,7 @@ void CGame::SimFrame() {
 
 		{
 			SCOPED_TIMER("Sim::GameFrame");
+			SCOPED_SYNC_SUBSYSTEM(SUBSYS_LUA);
 
 			// keep garbage-collection rate tied to sim-speed
 			// (fixed 30Hz gc is not enough while catching up)
@@ -1762,10 +1829,26 @@ void CGame::SimFrame() {
 		helper->Update();
 		readMap->Update();
 		mapDamage->Update();
-		pathManager->Update();
-		unitHandler.Update();
-		projectileHandler.Update();
-		featureHandler.Update();
+		{
+			SCOPED_SYNC_SUBSYSTEM(SUBSYS_PATH);
+			pathManager->Update();
+		}
+		{
+			SCOPED_SYNC_SUBSYSTEM(SUBSYS_UNITS);
+			unitHandler.Update();
+		}
+		{
+			SCOPED_SYNC_SUBSYSTEM(SUBSYS_PATH);
+			pathManager->DispatchSearches();
+		}
+		{
+			SCOPED_SYNC_SUBSYSTEM(SUBSYS_PROJECTILES);
+			projectileHandler.Update();
+		}
+		{
+			SCOPED_SYNC_SUBSYSTEM(SUBSYS_FEATURES);
+			featureHandler.Update();
+		}
 		{
 			SCOPED_TIMER("Sim::Script");
 			unitScriptEngine->Tick(33);
@@ -1788,8 +1871,13 @@ void CGame::SimFrame() {
 
 	eventHandler.DbgTimingInfo(TIMING_SIM, lastFrameTime, lastSimFrameTime);
 
+	demoBenchmark.Update(gs->frameNum);
+
+	if (demoKeyframeInterval > 0 && gs->frameNum > 0 && (gs->frameNum % demoKeyframeInterval) == 0)
+		SaveDemoKeyframe();
+
 	#ifdef HEADLESS
-	{
+	if (!demoBenchmark.IsEnabled() && stepFrames == 0) {
 		const float msecMaxSimFrameTime = 1000.0f / (GAME_SPEED * gs->wantedSpeedFactor);
 		const float msecDifSimFrameTime = (lastSimFrameTime - lastFrameTime).toMilliSecsf();
 		// multiply by 0.5 to give unsynced code some execution time (50% of our sleep-budget)
@@ -1801,6 +1889,12 @@ void CGame::SimFrame() {
 	}
 	#endif
 
+	{
+		// the RNG state is not a synced primitive, feed it to the checker explicitly
+		SCOPED_SYNC_SUBSYSTEM(SUBSYS_RNG);
+		Sync::Assert(gsRNG.GetGenState(), "gsRNG");
+	}
+
 	// useful for desync-debugging (enter instead of -1 start & end frame of the range you want to debug)
 	DumpState(-1, -1, 1, false);
 
@@ -2100,6 +2194,27 @@ void CGame::Save(std::string&& fileName, std::string&& saveArgs)
 	globalSaveFileData.args = std::move(saveArgs);
 }
 
+void CGame::SaveDemoKeyframe()
+{
+	std::string demoName;
+
+	if (gameSetup->hostDemo) {
+		demoName = gameSetup->demoName;
+	} else if (clientNet->GetDemoRecorder()->IsValid()) {
+		demoName = clientNet->GetDemoRecorder()->GetName();
+	}
+
+	if (demoName.empty())
+		return;
+
+	// never replace a save the user asked for this frame
+	if (!globalSaveFileData.name.empty())
+		return;
+
+	// written at the end of the frame by SpringApp, like any other save
+	Save(FileSystem::GetDirectory(demoName) + FileSystem::GetBasename(demoName) + spring::format("_f%07d.ssf", gs->frameNum), "-y");
+}
+
 
 
 
@@ -101,6 +101,7 @@ public:
 	void ParseInputTextGeometry(const std::string& geo);
 
 	void Save(std::string&& fileName, std::string&& saveArgs);
+	void SaveDemoKeyframe();
 
 	void ResizeEvent() override;
 
@@ -116,6 +117,7 @@ private:
 	void DrawInputReceivers();
 	void DrawInputText();
 	void DrawInterfaceWidgets();
+	void CollectUnsyncedGarbage(float usedFrameTime);
 
 	/// Format and display a chat message received over network
 	void HandleChatMsg(const ChatMessage& msg);
@@ -135,7 +137,7 @@ private:
 	/// synced actions (received from server) go in here
 	void ActionReceived(const Action& action, int playerID);
 
-	uint32_t GetNumQueuedSimFrameMessages(uint32_t maxFrames) const;
+	uint32_t GetNumQueuedSimFrameMessages(uint32_t maxFrames);
 	float GetNetMessageProcessingTimeLimit() const;
 
 	void SendClientProcUsage();
@@ -182,6 +184,10 @@ public:
 	bool showSpeed = true;
 
 	bool skipping = false;
+	/// headless demo playback without any unsynced per-frame work, see HeadlessDemoSimOnly
+	bool simOnly = false;
+	/// frames requested from the local server per Update, see HeadlessStepFrames
+	int stepFrames = 0;
 	bool playing = false;
 	bool paused = false; // unsynced
 
@@ -191,6 +197,7 @@ public:
 	// to smooth out SimFrame calls
 	float msgProcTimeLeft = 0.0f;  ///< How many SimFrame() calls we still may do.
 	float consumeSpeedMult = 1.0f; ///< How fast we should eat NETMSG_NEWFRAMEs.
+	int serverFrameNum = -1; ///< Latest server frame seen in NETMSG_GAME_FRAME_PROGRESS (when joining late).
 
 
 	#if 0
@@ -212,6 +219,13 @@ public:
 	// 0 := 1/f rate, 1 := 30/s rate
 	int luaGCControl = 0;
 
+	// frames between keyframe savestates written next to the demo, 0 := none
+	int demoKeyframeInterval = 0;
+
+	// wanted draw-frame time in milliseconds; if non-zero, unsynced Lua
+	// garbage is only collected in whatever remains of it after Draw
+	float luaGCDrawFrameTime = 0.0f;
+
 private:
 	JobDispatcher jobDispatcher;
 
@@ -50,6 +50,9 @@ void CGameHelper::Init()
 		wdVec.clear();
 		wdVec.reserve(32);
 	}
+
+	enemyCandidateIndices.clear();
+	enemyCandidateIndices.resize(teamHandler.ActiveAllyTeams());
 }
 
 void CGameHelper::Update()
@@ -669,15 +672,18 @@ size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* av
 	targets.reserve(32);
 
 	const int tempNum = gs->GetTempNum();
+	const int numQuads = quadField.GetNumQuadsX() * quadField.GetNumQuadsZ();
 
-	for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) {
-		if (teamHandler.Ally(weaponOwner->allyteam, t))
-			continue;
+	// same traversal order as over the quadfield itself, which matters for sync (gsRNG, Lua)
+	const EnemyCandidateIndex& candidates = helper->GetEnemyCandidateIndex(weaponOwner->allyteam);
 
+	for (size_t e = 0; e < candidates.enemyAllyTeams.size(); ++e) {
 		for (const int qi: *qfQuery.quads) {
-			const std::vector<CUnit*>& allyTeamUnits = quadField.GetQuad(qi).teamUnits[t];
+			const unsigned int* offsets = &candidates.offsets[e * numQuads + qi];
+
+			for (unsigned int i = offsets[0]; i < offsets[1]; i++) {
+				CUnit* targetUnit = candidates.units[i];
 
-			for (CUnit* targetUnit: allyTeamUnits) {
 				if (targetUnit->tempNum == tempNum)
 					continue;
 
@@ -750,6 +756,65 @@ size_t CGameHelper::GenerateWeaponTargets(const CWeapon* weapon, const CUnit* av
 	return (targets.size());
 }
 
+const CGameHelper::EnemyCandidateIndex& CGameHelper::GetEnemyCandidateIndex(int allyTeam)
+{
+	EnemyCandidateIndex& index = enemyCandidateIndices[allyTeam];
+
+	// alliances can also change at any time
+	const auto IsEnemyListCurrent = [&]() {
+		size_t e = 0;
+
+		for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) {
+			if (teamHandler.Ally(allyTeam, t))
+				continue;
+			if (e == index.enemyAllyTeams.size() || index.enemyAllyTeams[e] != t)
+				return false;
+
+			e++;
+		}
+
+		return (e == index.enemyAllyTeams.size());
+	};
+
+	if (index.valid && index.unitsVersion == quadField.GetUnitsVersion() && index.losStatusVersion == CUnit::GetLosStatusVersion() && IsEnemyListCurrent())
+		return index;
+
+	const int numQuads = quadField.GetNumQuadsX() * quadField.GetNumQuadsZ();
+
+	index.enemyAllyTeams.clear();
+	index.offsets.clear();
+	index.units.clear();
+
+	for (int t = 0; t < teamHandler.ActiveAllyTeams(); ++t) {
+		if (teamHandler.Ally(allyTeam, t))
+			continue;
+
+		index.enemyAllyTeams.push_back(t);
+	}
+
+	index.offsets.reserve(index.enemyAllyTeams.size() * numQuads + 1);
+
+	for (const int t: index.enemyAllyTeams) {
+		for (int qi = 0; qi < numQuads; qi++) {
+			index.offsets.push_back(index.units.size());
+
+			for (CUnit* unit: quadField.GetQuad(qi).teamUnits[t]) {
+				if ((unit->losStatus[allyTeam] & (LOS_INLOS | LOS_INRADAR)) == 0)
+					continue;
+
+				index.units.push_back(unit);
+			}
+		}
+	}
+
+	index.offsets.push_back(index.units.size());
+
+	index.unitsVersion = quadField.GetUnitsVersion();
+	index.losStatusVersion = CUnit::GetLosStatusVersion();
+	index.valid = true;
+	return index;
+}
+
 
 
 CUnit* CGameHelper::GetClosestUnit(const float3& pos, float searchRadius)
@@ -970,15 +1035,39 @@ float3 CGameHelper::ClosestBuildPos(
 
 	const auto& offsets = GetSearchOffsetTable(maxRadius);
 
-	// no ranged loop, table can store more offsets than we are interested in checking
-	for (int i = 0, n = Square(maxRadius * 2); i < n; i++) {
+	std::vector<float3> buildPositions;
+	std::vector<BuildSquareStatus> buildStatuses;
+	std::vector<CFeature*> buildFeatures;
+
+	// candidates are tested in batches of increasing size, nearby positions
+	// are usually accepted early and should not pay for the whole table
+	for (int i = 0, n = Square(maxRadius * 2), batchBeg = 0, batchEnd = 0, batchSize = 32; i < n; i++) {
+		if (i == batchEnd) {
+			batchBeg = i;
+			batchSize = std::min(batchSize * 2, 4096);
+			batchEnd = std::min(i + batchSize, n);
+
+			buildPositions.clear();
+
+			// no ranged loop, table can store more offsets than we are interested in checking
+			for (int j = batchBeg; j < batchEnd; j++) {
+				BuildInfo bi(unitDef, {worldPos.x + offsets[j].dx * BUILD_SQUARE_SIZE, 0.0f, worldPos.z + offsets[j].dy * BUILD_SQUARE_SIZE}, buildFacing);
+				buildPositions.push_back(Pos2BuildPos(bi, false));
+			}
+
+			TestUnitBuildSquares(unitDef, buildFacing, buildPositions, allyTeam, synced, buildStatuses, &buildFeatures);
+		}
+
+		const int batchIdx = i - batchBeg;
+
 		const float wxpos = worldPos.x + offsets[i].dx * BUILD_SQUARE_SIZE;
 		const float wzpos = worldPos.z + offsets[i].dy * BUILD_SQUARE_SIZE;
 
-		BuildInfo bi(unitDef, {wxpos, 0.0f, wzpos}, buildFacing);
-		bi.pos = Pos2BuildPos(bi, false);
+		const BuildInfo bi(unitDef, buildPositions[batchIdx], buildFacing);
 
-		if (!TestUnitBuildSquare(bi, feature, allyTeam, synced) && (feature == nullptr || feature->allyteam != allyTeam))
+		feature = buildFeatures[batchIdx];
+
+		if (!buildStatuses[batchIdx] && (feature == nullptr || feature->allyteam != allyTeam))
 			continue;
 
 		const int xsqr  = static_cast<int>(wxpos / SQUARE_SIZE);
@@ -1114,6 +1203,29 @@ float CGameHelper::GetBuildHeight(const float3& pos, const UnitDef* unitdef, boo
 }
 
 
+CGameHelper::BuildSquareStatus CGameHelper::TestGeoThermalSquare(const float3& testPos, int xsize, int zsize)
+{
+	QuadFieldQuery qfQuery;
+	quadField.GetFeaturesExact(qfQuery, testPos, std::max(xsize, zsize) * 6);
+
+	const int mindx = xsize * (SQUARE_SIZE >> 1) - (SQUARE_SIZE >> 1);
+	const int mindz = zsize * (SQUARE_SIZE >> 1) - (SQUARE_SIZE >> 1);
+
+	// look for a nearby geothermal feature if we need one
+	for (const CFeature* f: *qfQuery.features) {
+		if (!f->def->geoThermal)
+			continue;
+
+		const float dx = math::fabs(f->pos.x - testPos.x);
+		const float dz = math::fabs(f->pos.z - testPos.z);
+
+		if (dx < mindx && dz < mindz)
+			return BUILDSQUARE_OPEN;
+	}
+
+	return BUILDSQUARE_BLOCKED;
+}
+
 CGameHelper::BuildSquareStatus CGameHelper::TestUnitBuildSquare(
 	const BuildInfo& buildInfo,
 	CFeature*& feature,
@@ -1147,29 +1259,8 @@ CGameHelper::BuildSquareStatus CGameHelper::TestUnitBuildSquare(
 
 	BuildSquareStatus testStatus = BUILDSQUARE_OPEN;
 
-	if (buildInfo.def->needGeo) {
-		testStatus = BUILDSQUARE_BLOCKED;
-
-		QuadFieldQuery qfQuery;
-		quadField.GetFeaturesExact(qfQuery, testPos, std::max(xsize, zsize) * 6);
-
-		const int mindx = xsize * (SQUARE_SIZE >> 1) - (SQUARE_SIZE >> 1);
-		const int mindz = zsize * (SQUARE_SIZE >> 1) - (SQUARE_SIZE >> 1);
-
-		// look for a nearby geothermal feature if we need one
-		for (const CFeature* f: *qfQuery.features) {
-			if (!f->def->geoThermal)
-				continue;
-
-			const float dx = math::fabs(f->pos.x - testPos.x);
-			const float dz = math::fabs(f->pos.z - testPos.z);
-
-			if (dx < mindx && dz < mindz) {
-				testStatus = BUILDSQUARE_OPEN;
-				break;
-			}
-		}
-	}
+	if (buildInfo.def->needGeo)
+		testStatus = TestGeoThermalSquare(testPos, xsize, zsize);
 
 	if (commands != nullptr) {
 		// this is only called in unsynced context (ShowUnitBuildSquare)
@@ -1243,6 +1334,188 @@ CGameHelper::BuildSquareStatus CGameHelper::TestUnitBuildSquare(
 	return testStatus;
 }
 
+namespace {
+	// per-square data shared by all candidates of a TestUnitBuildSquares batch;
+	// the summed-area tables answer "any bad square in this footprint" in O(1)
+	struct BuildSquareTable {
+	public:
+		void Init(const UnitDef* unitDef, const MoveDef* moveDef, const int2& mins, const int2& maxs, bool synced) {
+			origin = mins;
+			sizeX = maxs.x - mins.x;
+			sizeZ = maxs.y - mins.y;
+
+			heights.resize(sizeX * sizeZ);
+			slopes.resize(sizeX * sizeZ);
+			blockedSums.assign((sizeX + 1) * (sizeZ + 1), 0);
+			objectSums.assign((sizeX + 1) * (sizeZ + 1), 0);
+
+			for (int z = 0; z < sizeZ; z++) {
+				int rowBlocked = 0;
+				int rowObjects = 0;
+
+				for (int x = 0; x < sizeX; x++) {
+					const int sqx = origin.x + x;
+					const int sqz = origin.y + z;
+					const int idx = z * sizeX + x;
+
+					heights[idx] = CGround::GetApproximateHeightUnsafe(sqx, sqz, synced);
+					slopes[idx] = CGround::GetSlope(sqx * SQUARE_SIZE, sqz * SQUARE_SIZE, synced);
+
+					// passing the ground height as wanted height leaves the height-
+					// independent constraints, maxHeightDif is tested per candidate
+					bool blocked = false;
+					blocked |= !CGameHelper::CheckTerrainConstraints(unitDef, moveDef, heights[idx], heights[idx], slopes[idx]);
+					blocked |= !buildingMaskMap.TestTileMaskUnsafe(sqx >> 1, sqz >> 1, unitDef->buildingMask);
+
+					rowBlocked += blocked;
+					rowObjects += (groundBlockingObjectMap.GroundBlocked(sqx, sqz) != nullptr);
+
+					blockedSums[(z + 1) * (sizeX + 1) + (x + 1)] = blockedSums[z * (sizeX + 1) + (x + 1)] + rowBlocked;
+					objectSums[(z + 1) * (sizeX + 1) + (x + 1)] = objectSums[z * (sizeX + 1) + (x + 1)] + rowObjects;
+				}
+			}
+		}
+
+		// [x1, x2) x [z1, z2) in map squares
+		int GetSum(const std::vector<int>& sums, int x1, int z1, int x2, int z2) const {
+			x1 -= origin.x; x2 -= origin.x;
+			z1 -= origin.y; z2 -= origin.y;
+
+			const int w = sizeX + 1;
+			return (sums[z2 * w + x2] - sums[z1 * w + x2] - sums[z2 * w + x1] + sums[z1 * w + x1]);
+		}
+
+		float GetHeight(int x, int z) const { return heights[(z - origin.y) * sizeX + (x - origin.x)]; }
+		float GetSlope(int x, int z) const { return slopes[(z - origin.y) * sizeX + (x - origin.x)]; }
+
+	public:
+		int2 origin;
+		int sizeX = 0;
+		int sizeZ = 0;
+
+		std::vector<float> heights;
+		std::vector<float> slopes;
+
+		// squares failing a height-independent constraint, resp. occupied by any object
+		std::vector<int> blockedSums;
+		std::vector<int> objectSums;
+	};
+}
+
+void CGameHelper::TestUnitBuildSquares(
+	const UnitDef* unitDef,
+	int buildFacing,
+	const std::vector<float3>& buildPositions,
+	int allyteam,
+	bool synced,
+	std::vector<BuildSquareStatus>& statuses,
+	std::vector<CFeature*>* features
+) {
+	statuses.clear();
+	statuses.resize(buildPositions.size(), BUILDSQUARE_BLOCKED);
+
+	if (features != nullptr) {
+		features->clear();
+		features->resize(buildPositions.size(), nullptr);
+	}
+
+	if (buildPositions.empty())
+		return;
+
+	const BuildInfo refInfo(unitDef, ZeroVector, buildFacing);
+	/*const S3DModel* model =*/ unitDef->LoadModel();
+	const MoveDef* moveDef = (unitDef->pathType != -1U) ? moveDefHandler.GetMoveDefByPathType(unitDef->pathType) : nullptr;
+
+	const int xsize = refInfo.GetXSize();
+	const int zsize = refInfo.GetZSize();
+
+	struct FootPrint {
+		int x1, z1;
+		int x2, z2;
+	};
+
+	const auto GetFootPrint = [&](const float3& pos) {
+		const int x1 = int(pos.x / SQUARE_SIZE) - (xsize >> 1);
+		const int z1 = int(pos.z / SQUARE_SIZE) - (zsize >> 1);
+		return FootPrint{x1, z1, x1 + xsize, z1 + zsize};
+	};
+	const auto IsInMap = [&](const FootPrint& fp) {
+		// same test as TestUnitBuildSquare
+		if (static_cast<unsigned>(fp.x1) > mapDims.mapx || static_cast<unsigned>(fp.x2) > mapDims.mapx)
+			return false;
+		if (static_cast<unsigned>(fp.z1) > mapDims.mapy || static_cast<unsigned>(fp.z2) > mapDims.mapy)
+			return false;
+
+		return true;
+	};
+
+	int2 mins = {mapDims.mapx, mapDims.mapy};
+	int2 maxs = {0, 0};
+
+	for (const float3& pos: buildPositions) {
+		const FootPrint fp = GetFootPrint(pos);
+
+		if (!IsInMap(fp))
+			continue;
+
+		mins.x = std::min(mins.x, fp.x1);
+		mins.y = std::min(mins.y, fp.z1);
+		maxs.x = std::max(maxs.x, fp.x2);
+		maxs.y = std::max(maxs.y, fp.z2);
+	}
+
+	if (mins.x >= maxs.x || mins.y >= maxs.y)
+		return;
+
+	BuildSquareTable table;
+	table.Init(unitDef, moveDef, mins, maxs, synced);
+
+	for (size_t i = 0, n = buildPositions.size(); i < n; i++) {
+		const float3& pos = buildPositions[i];
+		const FootPrint fp = GetFootPrint(pos);
+
+		if (!IsInMap(fp))
+			continue;
+
+		// objects need the full per-square test (LOS, yardmaps, MoveDefs)
+		if (table.GetSum(table.objectSums, fp.x1, fp.z1, fp.x2, fp.z2) > 0) {
+			CFeature* feature = nullptr;
+
+			statuses[i] = TestUnitBuildSquare(BuildInfo(unitDef, pos, buildFacing), feature, allyteam, synced);
+
+			if (features != nullptr)
+				(*features)[i] = feature;
+
+			continue;
+		}
+
+		// no objects, so no feature can have been found before the blocked square
+		if (table.GetSum(table.blockedSums, fp.x1, fp.z1, fp.x2, fp.z2) > 0)
+			continue;
+
+		BuildSquareStatus status = BUILDSQUARE_OPEN;
+
+		if (unitDef->needGeo)
+			status = TestGeoThermalSquare(pos, xsize, zsize);
+
+		if (unitDef->IsImmobileUnit()) {
+			const float buildHeight = GetBuildHeight(pos, unitDef, synced);
+
+			for (int z = fp.z1; z < fp.z2 && status != BUILDSQUARE_BLOCKED; z++) {
+				for (int x = fp.x1; x < fp.x2; x++) {
+					if (CheckTerrainConstraints(unitDef, moveDef, buildHeight, table.GetHeight(x, z), table.GetSlope(x, z)))
+						continue;
+
+					status = BUILDSQUARE_BLOCKED;
+					break;
+				}
+			}
+		}
+
+		statuses[i] = status;
+	}
+}
+
 CGameHelper::BuildSquareStatus CGameHelper::TestBuildSquare(
 	const float3& pos,
 	const int2& xrange,
@@ -90,6 +90,9 @@ public:
 		const int2 yardpos
 	);
 
+	///< BLOCKED unless a geothermal feature lies within the footprint
+	static BuildSquareStatus TestGeoThermalSquare(const float3& testPos, int xsize, int zsize);
+
 	///< test a single mapsquare for build possibility
 	static BuildSquareStatus TestBuildSquare(
 		const float3& pos,
@@ -113,6 +116,17 @@ public:
 		std::vector<float3>* nobuildpos = nullptr,
 		const std::vector<Command>* commands = nullptr
 	);
+	///< test many (Pos2BuildPos'ed) positions for the same UnitDef and facing;
+	///< results match calling TestUnitBuildSquare for each position in turn
+	static void TestUnitBuildSquares(
+		const UnitDef* unitDef,
+		int buildFacing,
+		const std::vector<float3>& buildPositions,
+		int allyteam,
+		bool synced,
+		std::vector<BuildSquareStatus>& statuses,
+		std::vector<CFeature*>* features = nullptr
+	);
 	static float GetBuildHeight(const float3& pos, const UnitDef* unitdef, bool synced = true);
 	static Command GetBuildCommand(const float3& pos, const float3& dir);
 
@@ -191,9 +205,33 @@ private:
 		float3 impulse;
 	};
 
+	/**
+	 * Per-allyteam snapshot of the quadfield restricted to units of enemy
+	 * allyteams which are in LOS or radar, so GenerateWeaponTargets never
+	 * touches the (usually far more numerous) units it can not target.
+	 * Rebuilt lazily whenever any unit changes quads or visibility, which
+	 * in practice means once per frame for each allyteam with weapons that
+	 * are auto-targeting during that frame's slow-update slice.
+	 */
+	struct EnemyCandidateIndex {
+		// units of enemyAllyTeams[e] in quad q are units[offsets[e * numQuads + q] ... offsets[e * numQuads + q + 1]]
+		std::vector<unsigned int> offsets;
+		std::vector<CUnit*> units;
+		std::vector<int> enemyAllyTeams;
+
+		unsigned int unitsVersion = 0;
+		unsigned int losStatusVersion = 0;
+
+		bool valid = false;
+	};
+
+	const EnemyCandidateIndex& GetEnemyCandidateIndex(int allyTeam);
+
 	// note: size must be a power of two
 	std::array<std::vector<WaitingDamage>, 128> waitingDamages;
 
+	std::vector<EnemyCandidateIndex> enemyCandidateIndices;
+
 public:
 	std::vector<int> targetUnitIDs; // GetEnemyUnits{NoLosTest}
 	std::vector<std::pair<float, CUnit*>> targetPairs; // GenerateWeaponTargets
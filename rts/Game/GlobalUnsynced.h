@@ -50,6 +50,15 @@ public:
 	 * for reconnecting/simulation.
 	 */
 	static constexpr float reconnectSimDrawBalance = 0.15f;
+	/**
+	 * @brief simulation drawing balance while far behind the server
+	 *
+	 * Used instead of reconnectSimDrawBalance as long as a
+	 * (re)joining client trails the server by more than a
+	 * few seconds of game time, so that catching up is not
+	 * slowed down by rendering a game-state nobody watches.
+	 */
+	static constexpr float catchupSimDrawBalance = 0.04f;
 
 	/**
 	 * @brief simulation frames per second
@@ -16,6 +16,7 @@
 #include "Map/MapInfo.h"
 #include "Rendering/Fonts/glFont.h"
 #include "Rendering/GlobalRendering.h"
+#include "Rendering/Shaders/ShaderHandler.h"
 #include "Rendering/Textures/NamedTextures.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Path/IPathManager.h"
@@ -66,6 +67,9 @@ CLoadScreen::~CLoadScreen()
 	if (netHeartbeatThread.joinable())
 		netHeartbeatThread.join();
 
+	// drop whatever binaries no shader asked for while loading
+	shaderHandler->GetProgramBinaryCache().Kill();
+
 	if (!gu->globalQuit) {
 		activeController = game;
 
@@ -105,6 +109,10 @@ bool CLoadScreen::Init()
 	clientNet->KeepUpdating(true);
 
 	netHeartbeatThread = std::move(spring::thread(Threading::CreateNewThread(std::bind(&CNetProtocol::UpdateLoop, clientNet))));
+
+	// read cached program binaries while the game loads, most shaders are created near the end
+	shaderHandler->GetProgramBinaryCache().Prefetch();
+
 	game = new CGame(mapFileName, modFileName, saveFile);
 
 	if ((CglFont::threadSafety = mtLoading)) {
@@ -152,6 +160,20 @@ void CLoadScreen::Kill()
 	gameLoadThread.join();
 
 	CglFont::threadSafety = false;
+
+	if (loadPhases.empty())
+		return;
+
+	const spring_time loadEndTime = spring_gettime();
+
+	LOG("[LoadScreen::%s] loading took %.1fms", __func__, (loadEndTime - loadPhases[0].second).toMilliSecsf());
+
+	for (size_t i = 0, n = loadPhases.size(); i < n; i++) {
+		const spring_time phaseEndTime = (i + 1 < n)? loadPhases[i + 1].second: loadEndTime;
+		LOG("\t%8.1fms \"%s\"", (phaseEndTime - loadPhases[i].second).toMilliSecsf(), loadPhases[i].first.c_str());
+	}
+
+	loadPhases.clear();
 }
 
 
@@ -308,6 +330,10 @@ void CLoadScreen::SetLoadMessage(const std::string& text, bool replaceLast)
 
 	loadMessages.emplace_back(text, replaceLast);
 
+	// replacements are progress updates within the current phase
+	if (!replaceLast || loadPhases.empty())
+		loadPhases.emplace_back(text, spring_gettime());
+
 	LOG("[LoadScreen::%s] text=\"%s\"", __func__, text.c_str());
 	LOG_CLEANUP();
 
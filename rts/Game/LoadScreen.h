@@ -48,6 +48,8 @@ private:
 	ILoadSaveHandler* saveFile;
 
 	std::vector< std::pair<std::string, bool> > loadMessages;
+	// <message, start-time> of every loading phase, logged by Kill
+	std::vector< std::pair<std::string, spring_time> > loadPhases;
 
 	std::string mapFileName;
 	std::string modFileName;
@@ -49,6 +49,7 @@
 #include "System/Platform/errorhandler.h"
 #include "System/Platform/Misc.h"
 #include "System/Sync/SyncedPrimitiveBase.h"
+#include "System/Threading/ThreadPool.h"
 #include "lib/luasocket/src/restrictions.h"
 #ifdef SYNCDEBUG
 	#include "System/Sync/SyncDebugger.h"
@@ -61,6 +62,44 @@ CONFIG(bool, LoadBadSaves).defaultValue(false);
 static char mapChecksumMsgBuf[1024] = {0};
 static char modChecksumMsgBuf[1024] = {0};
 
+#ifdef THREADPOOL
+static std::shared_ptr<std::future<void>> checksumJob;
+#endif
+
+
+static void JoinArchiveChecksums()
+{
+	#ifdef THREADPOOL
+	if (checksumJob == nullptr)
+		return;
+
+	checksumJob->get();
+	checksumJob.reset();
+	#endif
+}
+
+// hashes the archives (and their dependencies) named by the setup-script on
+// a worker while the VFS is set up; the scanner keeps the results, so later
+// checksum queries only read them; must be joined before the first of those
+// or both sides would hash the same archives
+static void PrefetchArchiveChecksums(const std::vector<std::string>& archiveNames)
+{
+	JoinArchiveChecksums();
+
+	#ifdef THREADPOOL
+	checksumJob = ThreadPool::Enqueue([archiveNames]() {
+		for (const std::string& archiveName: archiveNames) {
+			try {
+				archiveScanner->GetArchiveCompleteChecksumBytes(archiveScanner->ArchiveFromName(archiveName));
+			} catch (const content_error& ex) {
+				// missing dependencies etc. are reported by the non-speculative query
+			}
+		}
+	});
+	#endif
+}
+
+
 CPreGame* pregame = nullptr;
 
 CPreGame::CPreGame(std::shared_ptr<ClientSetup> setup)
@@ -97,6 +136,8 @@ CPreGame::~CPreGame()
 	agui::gui->Clean();
 	#endif
 
+	JoinArchiveChecksums();
+
 	pregame = nullptr;
 }
 
@@ -242,6 +283,13 @@ void CPreGame::StartServer(const std::string& setupscript)
 	if (startGameSetup->mapName.empty())
 		throw content_error("No map selected in startscript");
 
+	// a generated map does not exist yet
+	if (startGameSetup->mapSeed != 0) {
+		PrefetchArchiveChecksums({startGameSetup->modName});
+	} else {
+		PrefetchArchiveChecksums({startGameSetup->mapName, startGameSetup->modName});
+	}
+
 	if (startGameSetup->mapSeed != 0) {
 		CSimpleMapGenerator gen(startGameSetup.get());
 		gen.Generate();
@@ -258,6 +306,8 @@ void CPreGame::StartServer(const std::string& setupscript)
 	startGameSetup->LoadStartPositions();
 
 	{
+		JoinArchiveChecksums();
+
 		const std::string& modArchive = archiveScanner->ArchiveFromName(startGameSetup->modName);
 		const std::string& mapArchive = archiveScanner->ArchiveFromName(startGameSetup->mapName);
 
@@ -518,6 +568,9 @@ void CPreGame::GameDataReceived(std::shared_ptr<const netcode::RawPacket> packet
 
 	if (CGameSetup::LoadReceivedScript(gameData->GetSetupText(), clientSetup->isHost)) {
 		assert(gameSetup->ScriptLoaded());
+		// overlap hashing with the remaining setup and VFS mounting
+		PrefetchArchiveChecksums({gameSetup->mapName, gameSetup->modName});
+
 		gu->LoadFromSetup(gameSetup);
 		gs->LoadFromSetup(gameSetup);
 		// do we really need to do this so early?
@@ -565,6 +618,8 @@ void CPreGame::GameDataReceived(std::shared_ptr<const netcode::RawPacket> packet
 		std::fill(asMapChecksum.begin(), asMapChecksum.end(), 0);
 		std::fill(asModChecksum.begin(), asModChecksum.end(), 0);
 
+		JoinArchiveChecksums();
+
 		try {
 			// gameSetup->MapFileName()
 			archiveScanner->CheckArchive(gameSetup->mapName, gdMapChecksum, asMapChecksum);
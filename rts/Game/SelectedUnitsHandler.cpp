@@ -38,7 +38,10 @@
 #include "System/FileSystem/SimpleParser.h"
 #include "System/Input/KeyInput.h"
 #include "System/Sound/ISound.h"
+#include "System/Sync/HsiehHash.h"
 #include "System/Sound/ISoundChannels.h"
+#include "System/UnorderedMap.hpp"
+#include "System/UnorderedSet.hpp"
 
 #include <SDL_mouse.h>
 #include <SDL_keycode.h>
@@ -59,6 +62,7 @@ void CSelectedUnitsHandler::Init(unsigned numPlayers)
 	buildIconsFirst = configHandler->GetBool("BuildIconsFirst");
 	autoAddBuiltUnitsToFactoryGroup = configHandler->GetBool("AutoAddBuiltUnitsToFactoryGroup");
 	autoAddBuiltUnitsToSelectedGroup = configHandler->GetBool("AutoAddBuiltUnitsToSelectedGroup");
+	statsTooltipFrame = -1;
 
 	netSelected.resize(numPlayers);
 }
@@ -93,13 +97,34 @@ CSelectedUnitsHandler::AvailableCommandsStruct CSelectedUnitsHandler::GetAvailab
 	spring::unordered_map<int, int> states;
 	std::vector<SCommandDescription> commands;
 
+	typedef std::vector<const SCommandDescription*> CmdDescList;
+
+	// descriptions are shared through the cache, so units of the same type
+	// mostly have identical lists; only the first occurrence of each needs
+	// to be merged since later ones can not add anything new
+	std::vector<const CmdDescList*> cmdDescLists;
+	spring::unordered_map<unsigned int, std::vector<size_t>> cmdDescListIndices;
+
 	for (const int unitID: selectedUnits) {
 		const CUnit* u = unitHandler.GetUnit(unitID);
 		const CCommandAI* cai = u->commandAI;
 		const CGroup* group = u->GetGroup();
 
-		for (const SCommandDescription* cmdDesc: cai->GetPossibleCommands()) {
-			states[cmdDesc->id] = cmdDesc->disabled ? 2 : 1;
+		const CmdDescList& cmdDescs = cai->GetPossibleCommands();
+		const unsigned int cmdDescsHash = HsiehHash(cmdDescs.data(), cmdDescs.size() * sizeof(cmdDescs[0]), 0);
+
+		std::vector<size_t>& hashIndices = cmdDescListIndices[cmdDescsHash];
+
+		const auto pred = [&](size_t i) { return (*cmdDescLists[i] == cmdDescs); };
+		const auto iter = std::find_if(hashIndices.begin(), hashIndices.end(), pred);
+
+		if (iter == hashIndices.end()) {
+			hashIndices.push_back(cmdDescLists.size());
+			cmdDescLists.push_back(&cmdDescs);
+
+			for (const SCommandDescription* cmdDesc: cmdDescs) {
+				states[cmdDesc->id] = cmdDesc->disabled ? 2 : 1;
+			}
 		}
 
 		if (cai->lastSelectedCommandPage < commandPage)
@@ -119,11 +144,8 @@ CSelectedUnitsHandler::AvailableCommandsStruct CSelectedUnitsHandler::GetAvailab
 	}
 
 	// load the first set (separating build and non-build commands)
-	for (const int unitID: selectedUnits) {
-		const CUnit* u = unitHandler.GetUnit(unitID);
-		const CCommandAI* cai = u->commandAI;
-
-		for (const SCommandDescription* cmdDesc: cai->GetPossibleCommands()) {
+	for (const CmdDescList* cmdDescs: cmdDescLists) {
+		for (const SCommandDescription* cmdDesc: *cmdDescs) {
 			if (buildIconsFirst) {
 				if (cmdDesc->id >= 0)
 					continue;
@@ -143,11 +165,8 @@ CSelectedUnitsHandler::AvailableCommandsStruct CSelectedUnitsHandler::GetAvailab
 	}
 
 	// load the second set (all those that have not already been included)
-	for (const int unitID: selectedUnits) {
-		const CUnit* u = unitHandler.GetUnit(unitID);
-		const CCommandAI* cai = u->commandAI;
-
-		for (const SCommandDescription* cmdDesc: cai->GetPossibleCommands()) {
+	for (const CmdDescList* cmdDescs: cmdDescLists) {
+		for (const SCommandDescription* cmdDesc: *cmdDescs) {
 			if (buildIconsFirst) {
 				if (cmdDesc->id < 0)
 					continue;
@@ -292,6 +311,8 @@ void CSelectedUnitsHandler::HandleUnitBoxSelection(const float4& planeRight, con
 	int minTeam = gu->myTeam;
 	int maxTeam = gu->myTeam;
 
+	const bool ctrlPressed = KeyInput::GetKeyModState(KMOD_CTRL);
+
 	// any team's units can be *selected*; whether they can
 	// be given orders depends on our ability to play god
 	if (gu->spectatingFullSelect || gs->godMode != 0) {
@@ -315,7 +336,7 @@ void CSelectedUnitsHandler::HandleUnitBoxSelection(const float4& planeRight, con
 			if (vec.dot4(planeBottom) >= 0.0f)
 				continue;
 
-			if (KeyInput::GetKeyModState(KMOD_CTRL) && (selectedUnits.find(u->id) != selectedUnits.end())) {
+			if (ctrlPressed && (selectedUnits.find(u->id) != selectedUnits.end())) {
 				RemoveUnit(u);
 				continue;
 			}
@@ -399,6 +420,7 @@ void CSelectedUnitsHandler::AddUnit(CUnit* unit)
 
 	selectionChanged = true;
 	possibleCommandsChanged = true;
+	statsTooltipFrame = -1;
 
 	const CGroup* g = unit->GetGroup();
 
@@ -416,6 +438,7 @@ void CSelectedUnitsHandler::RemoveUnit(CUnit* unit)
 
 	selectionChanged = true;
 	possibleCommandsChanged = true;
+	statsTooltipFrame = -1;
 	selectedGroup = -1;
 	unit->isSelected = false;
 }
@@ -439,6 +462,7 @@ void CSelectedUnitsHandler::ClearSelected()
 	selectedUnits.clear();
 	selectionChanged = true;
 	possibleCommandsChanged = true;
+	statsTooltipFrame = -1;
 	selectedGroup = -1;
 }
 
@@ -461,6 +485,7 @@ void CSelectedUnitsHandler::SelectGroup(int num)
 
 	selectionChanged = true;
 	possibleCommandsChanged = true;
+	statsTooltipFrame = -1;
 }
 
 
@@ -695,6 +720,7 @@ void CSelectedUnitsHandler::DependentDied(CObject* o)
 
 	selectionChanged = true;
 	possibleCommandsChanged = true;
+	statsTooltipFrame = -1;
 }
 
 
@@ -937,6 +963,11 @@ std::string CSelectedUnitsHandler::GetTooltip()
 	if (!custom.empty())
 		return custom;
 
+	// summing the stats of large selections every draw-frame is not cheap
+	// and they can only change by a sim-frame or by (de)selecting units
+	if (statsTooltipFrame == gs->frameNum)
+		return (s + statsTooltip);
+
 	{
 		#define NO_TEAM -32
 		#define MULTI_TEAM -64
@@ -955,7 +986,7 @@ std::string CSelectedUnitsHandler::GetTooltip()
 			}
 		}
 
-		s += CTooltipConsole::MakeUnitStatsString(stats);
+		statsTooltip = CTooltipConsole::MakeUnitStatsString(stats);
 
 		const char* ctrlName = "";
 
@@ -965,9 +996,10 @@ std::string CSelectedUnitsHandler::GetTooltip()
 			ctrlName = teamHandler.Team(ctrlTeam)->GetControllerName();
 		}
 
-		s += "\n\xff\xff\xff\xff";
-		s += ctrlName;
-		return s;
+		statsTooltip += "\n\xff\xff\xff\xff";
+		statsTooltip += ctrlName;
+		statsTooltipFrame = gs->frameNum;
+		return (s + statsTooltip);
 	}
 }
 
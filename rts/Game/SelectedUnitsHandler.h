@@ -9,7 +9,7 @@
 #include "Sim/Units/CommandAI/Command.h"
 #include "System/float4.h"
 #include "System/Object.h"
-#include "System/UnorderedSet.hpp"
+#include "System/SparseIDSet.h"
 
 class CUnit;
 class CFeature;
@@ -76,12 +76,16 @@ public:
 	bool selectionChanged = false;
 	bool possibleCommandsChanged = true;
 
-	spring::unordered_set<int> selectedUnits;
+	spring::SparseIDSet selectedUnits;
 	std::vector< std::vector<int> > netSelected;
 
 private:
-	// buffer for SendCommand unordered_set->vector conversion
+	// buffer for SendCommand set->vector conversion
 	std::vector<int16_t> selectedUnitIDs;
+
+	// GetTooltip's summed stats of all selected units, valid for one sim-frame
+	std::string statsTooltip;
+	int statsTooltipFrame = -1;
 };
 
 extern CSelectedUnitsHandler selectedUnitsHandler;
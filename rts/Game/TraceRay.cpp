@@ -27,6 +27,35 @@
 // Local/Helper functions
 //////////////////////////////////////////////////////////////////////
 
+/**
+ * helper for TraceRay
+ * @return false if the segment <pos, pos + dir * length> can not intersect the
+ *   collision volume of object <obj>, which is far cheaper to find out than by
+ *   building its transform and calling DetectHit; most objects in the quads on
+ *   a ray are not anywhere near it
+ */
+inline static bool TraceRayMayHit(
+	const float3& pos,
+	const float3& dir,
+	const float length,
+	const CSolidObject* obj
+) {
+	const CollisionVolume* cv = &obj->collisionVolume;
+
+	// piece volumes are not bounded by the object's own
+	if (cv->DefaultToPieceTree())
+		return true;
+
+	const float3 cvRelVec = cv->GetWorldSpacePos(obj) - pos;
+
+	// callers do not always pass normalized directions
+	const float  cvRelDst = Clamp(cvRelVec.dot(dir) / dir.SqLength(), 0.0f, length);
+	// small margin to stay conservative wrt. rounding in the exact tests
+	const float  cvRadius = cv->GetBoundingRadius() + 1.0f;
+
+	return ((cvRelVec - dir * cvRelDst).SqLength() <= (cvRadius * cvRadius));
+}
+
 /**
  * helper for TestCone
  * @return true if object <o> is in the firing cone, false otherwise
@@ -224,6 +253,8 @@ float TraceRay(
 					//   for collisions with projectiles so we can skip it here
 					if (!f->HasCollidableStateBit(CSolidObject::CSTATE_BIT_QUADMAPRAYS))
 						continue;
+					if (!TraceRayMayHit(pos, dir, traceLength, f))
+						continue;
 
 					if (CCollisionHandler::DetectHit(f, f->GetTransformMatrix(true), pos, pos + dir * traceLength, &cq, true)) {
 						const float len = cq.GetHitPosDist(pos, dir);
@@ -262,6 +293,9 @@ float TraceRay(
 
 					if (!doHitTest)
 						continue;
+					// traceLength shrinks with every hit, so this rejects more as the trace goes on
+					if (!TraceRayMayHit(pos, dir, traceLength, u))
+						continue;
 
 					if (CCollisionHandler::DetectHit(u, u->GetTransformMatrix(true), pos, pos + dir * traceLength, &cq, true)) {
 						const float len = cq.GetHitPosDist(pos, dir);
@@ -314,10 +348,20 @@ void TraceRayShields(
 	QuadFieldQuery qfQuery;
 	quadField.GetQuadsOnRay(qfQuery, start, dir, length);
 
+	// a shield is linked into every quad it covers; testing it once per quad
+	// on the ray also reported it (and had IncomingBeam called) repeatedly
+	static std::vector<const CPlasmaRepulser*> testedShields;
+	testedShields.clear();
+
 	for (const int quadIdx: *qfQuery.quads) {
 		const CQuadField::Quad& quad = quadField.GetQuad(quadIdx);
 
 		for (CPlasmaRepulser* r: quad.repulsers) {
+			if (std::find(testedShields.begin(), testedShields.end(), r) != testedShields.end())
+				continue;
+
+			testedShields.push_back(r);
+
 			if (!r->CanIntercept(emitter->weaponDef->interceptedByShieldType, emitter->owner->allyteam))
 				continue;
 
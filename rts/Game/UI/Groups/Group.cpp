@@ -6,7 +6,6 @@
 #include "Game/GlobalUnsynced.h"
 #include "Sim/Units/UnitHandler.h"
 #include "System/EventHandler.h"
-#include "System/creg/STL_Set.h"
 #include "System/float3.h"
 
 CR_BIND(CGroup, (0, 0))
@@ -8,7 +8,7 @@
 #include "Sim/Units/CommandAI/Command.h"
 #include "System/creg/creg_cond.h"
 #include "System/float3.h"
-#include "System/UnorderedSet.hpp"
+#include "System/SparseIDSet.h"
 
 class CUnit;
 class CFeature;
@@ -56,7 +56,7 @@ public:
 	int id = -1;
 	int ghIndex = -1;
 
-	spring::unordered_set<int> units;
+	spring::SparseIDSet units;
 };
 
 #endif // GROUP_H
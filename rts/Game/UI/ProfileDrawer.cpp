@@ -1,5 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <deque>
 
@@ -7,15 +9,20 @@
 #include "InputReceiver.h"
 #include "Game/GlobalUnsynced.h"
 #include "Lua/LuaAllocState.h"
+#include "Lua/LuaHandle.h"
 #include "Rendering/GL/myGL.h"
 #include "Rendering/Fonts/glFont.h"
 #include "Rendering/GlobalRendering.h"
 #include "Rendering/GlobalRenderingInfo.h"
 #include "Rendering/GL/RenderBuffers.h"
+#include "Rendering/GL/StateCache.h"
 #include "Sim/Features/FeatureMemPool.h"
 #include "Sim/Misc/GlobalConstants.h" // for GAME_SPEED
 #include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Path/IPathManager.h"
+#include "Sim/Units/UnitDef.h"
+#include "Sim/Units/UnitDefHandler.h"
+#include "Sim/Units/UnitDefProfiler.h"
 #include "Sim/Units/UnitMemPool.h"
 #include "Sim/Projectiles/ProjectileHandler.h"
 #include "Sim/Projectiles/ProjectileMemPool.h"
@@ -457,10 +464,10 @@ static void DrawInfoText(TypedRenderBuffer<VA_TYPE_C   >& rb)
 	// background
 
 	rb.SafeAppend({{             0.01f - 10.0f * globalRendering->pixelX, 0.02f - 10.0f * globalRendering->pixelY, 0.0f}, bgColor}); // tl
-	rb.SafeAppend({{             0.01f - 10.0f * globalRendering->pixelX, 0.17f + 20.0f * globalRendering->pixelY, 0.0f}, bgColor}); // bl
-	rb.SafeAppend({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.17f + 20.0f * globalRendering->pixelY, 0.0f}, bgColor}); // br
+	rb.SafeAppend({{             0.01f - 10.0f * globalRendering->pixelX, 0.19f + 20.0f * globalRendering->pixelY, 0.0f}, bgColor}); // bl
+	rb.SafeAppend({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.19f + 20.0f * globalRendering->pixelY, 0.0f}, bgColor}); // br
 
-	rb.SafeAppend({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.17f + 20.0f * globalRendering->pixelY, 0.0f}, bgColor}); // br
+	rb.SafeAppend({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.19f + 20.0f * globalRendering->pixelY, 0.0f}, bgColor}); // br
 	rb.SafeAppend({{MIN_X_COOR - 0.05f + 10.0f * globalRendering->pixelX, 0.02f - 10.0f * globalRendering->pixelY, 0.0f}, bgColor}); // tr
 	rb.SafeAppend({{             0.01f - 10.0f * globalRendering->pixelX, 0.02f - 10.0f * globalRendering->pixelY, 0.0f}, bgColor}); // tl
 
@@ -477,6 +484,8 @@ static void DrawInfoText(TypedRenderBuffer<VA_TYPE_C   >& rb)
 	constexpr const char* luaFmtStr = "[7] Lua-allocated memory: %.1fMB (%.1fK allocs : %.5u usecs : %.1u states)";
 	constexpr const char* gpuFmtStr = "[8] GPU-allocated memory: %.1fMB / %.1fMB";
 	constexpr const char* sopFmtStr = "[9] SOP-allocated memory: {U,F,P,W}={%.1f/%.1f, %.1f/%.1f, %.1f/%.1f, %.1f/%.1f}KB";
+	constexpr const char* lpfFmtStr = "[10] Lua-profile top: %s::%s (%.1fms, %.1fK allocs)";
+	constexpr const char* gscFmtStr = "[11] Lua GL-state calls: %u (%u redundant, filtered)";
 
 	const CProjectileHandler* ph = &projectileHandler;
 	const IPathManager* pm = pathManager;
@@ -546,9 +555,88 @@ static void DrawInfoText(TypedRenderBuffer<VA_TYPE_C   >& rb)
 		weaponMemPool.alloc_size() / 1024.0f,
 		weaponMemPool.freed_size() / 1024.0f
 	);
+
+	{
+		// [0] := unsynced, [1] := synced
+		extern const spring::unsynced_set<const luaContextData*>* LUAHANDLE_CONTEXTS[2];
+
+		const luaContextData* maxContext = nullptr;
+		const SLuaProfileState::Entry* maxEntry = nullptr;
+
+		for (const auto* contexts: LUAHANDLE_CONTEXTS) {
+			for (const luaContextData* lcd: *contexts) {
+				if (lcd->owner == nullptr)
+					continue;
+
+				for (const SLuaProfileState::Entry& e: lcd->profileState.GetEntries()) {
+					if (maxEntry != nullptr && e.runTime <= maxEntry->runTime)
+						continue;
+
+					maxContext = lcd;
+					maxEntry = &e;
+				}
+			}
+		}
+
+		if (maxEntry != nullptr)
+			font->glFormat(0.01f, 0.20f, 0.5f, DBG_FONT_FLAGS, lpfFmtStr, maxContext->owner->GetName().c_str(), maxEntry->name.c_str(), maxEntry->runTime * 0.001f, maxEntry->numAllocs / 1000.0f);
+	}
+
+	{
+		const GL::StateCache& stateCache = GL::StateCache::GetInstance();
+
+		font->glFormat(0.01f, 0.22f, 0.5f, DBG_FONT_FLAGS, gscFmtStr, stateCache.GetLastFrameCalls(), stateCache.GetLastFrameFiltered());
+	}
 }
 
 
+static void DrawUnitDefProfile()
+{
+	if (!unitDefProfiler.IsEnabled())
+		return;
+
+	constexpr size_t NUM_LINES = 5;
+	constexpr const char* udpFmtStr = "\t%s: %.1fms (U=%.1f S=%.1f W=%.1f M=%.1f C=%.1f L=%.1f)";
+
+	const std::vector<CUnitDefProfiler::Counter>& totals = unitDefProfiler.GetTotals();
+
+	// (summed time, unitDefID) of the most expensive types so far
+	std::array<std::pair<uint64_t, size_t>, NUM_LINES> topDefs;
+	topDefs.fill({0, 0});
+
+	for (size_t defID = 1; defID < unitDefProfiler.NumUnitDefs(); defID++) {
+		uint64_t sumNanos = 0;
+
+		for (size_t cat = 0; cat < CUnitDefProfiler::CAT_COUNT; cat++) {
+			sumNanos += totals[defID * CUnitDefProfiler::CAT_COUNT + cat].nanos;
+		}
+
+		if (sumNanos <= topDefs.back().first)
+			continue;
+
+		topDefs.back() = {sumNanos, defID};
+		std::sort(topDefs.begin(), topDefs.end(), [](const auto& a, const auto& b) { return (a.first > b.first); });
+	}
+
+	font->glFormat(0.01f, 0.50f, 0.5f, DBG_FONT_FLAGS, "UnitDef-profile top (cumulative, see Spring.GetUnitDefProfile)");
+
+	for (size_t i = 0; i < NUM_LINES && topDefs[i].first > 0; i++) {
+		const CUnitDefProfiler::Counter* counters = &totals[topDefs[i].second * CUnitDefProfiler::CAT_COUNT];
+		const UnitDef* unitDef = unitDefHandler->GetUnitDefByID(topDefs[i].second);
+
+		font->glFormat(0.01f, 0.48f - i * 0.02f, 0.5f, DBG_FONT_FLAGS, udpFmtStr,
+			unitDef->name.c_str(),
+			topDefs[i].first * 1e-6f,
+			counters[CUnitDefProfiler::CAT_UPDATE    ].nanos * 1e-6f,
+			counters[CUnitDefProfiler::CAT_SLOWUPDATE].nanos * 1e-6f,
+			counters[CUnitDefProfiler::CAT_WEAPONS   ].nanos * 1e-6f,
+			counters[CUnitDefProfiler::CAT_MOVETYPE  ].nanos * 1e-6f,
+			counters[CUnitDefProfiler::CAT_SCRIPT    ].nanos * 1e-6f,
+			counters[CUnitDefProfiler::CAT_LUA       ].nanos * 1e-6f
+		);
+	}
+}
+
 
 void ProfileDrawer::DrawScreen()
 {
@@ -570,6 +658,7 @@ void ProfileDrawer::DrawScreen()
 	DrawInfoText(rb);
 	DrawProfiler(rb);
 	DrawBufferStats({0.01f, 0.605f});
+	DrawUnitDefProfile();
 
 	shader.Disable();
 
@@ -84,14 +84,18 @@
 #include "Rendering/Textures/NamedTextures.h"
 #include "Rendering/Textures/S3OTextureHandler.h"
 
+#include "Sim/Features/FeatureMemPool.h"
 #include "Sim/MoveTypes/MoveDefHandler.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/Misc/ModInfo.h"
 #include "Sim/Projectiles/ProjectileHandler.h"
+#include "Sim/Projectiles/ProjectileMemPool.h"
 #include "Sim/Units/UnitDef.h"
 #include "Sim/Units/UnitDefHandler.h"
 #include "Sim/Units/UnitHandler.h"
+#include "Sim/Units/UnitMemPool.h"
 #include "Sim/Units/CommandAI/CommandDescription.h"
+#include "Sim/Weapons/WeaponMemPool.h"
 
 #include "System/EventHandler.h"
 #include "System/GlobalConfig.h"
@@ -100,6 +104,7 @@
 #include "System/Log/ILog.h"
 #include "System/Config/ConfigHandler.h"
 #include "System/FileSystem/SimpleParser.h"
+#include "System/Net/Connection.h"
 #include "System/Sound/ISound.h"
 #include "System/Sound/ISoundChannels.h"
 #include "System/Sync/DumpState.h"
@@ -1331,6 +1336,31 @@ public:
 	}
 };
 
+class ProfileActionExecutor : public IUnsyncedActionExecutor {
+public:
+	ProfileActionExecutor() : IUnsyncedActionExecutor(
+		"Profile",
+		"Capture a trace of all profiler timers for the next N frames (\"trace <frames>\") and write it as Chrome trace JSON"
+	) {
+	}
+
+	bool Execute(const UnsyncedAction& action) const final {
+		const std::vector<std::string>& args = CSimpleParser::Tokenize(action.GetArgs(), 0);
+
+		if (args.empty() || args[0] != "trace") {
+			LOG_L(L_WARNING, "[ProfileAction::%s] unknown argument \"%s\" (use \"trace <frames>\")", __func__, action.GetArgs().c_str());
+			return true;
+		}
+
+		// a second "/profile trace" ends a running capture early
+		if (profiler.StopTrace())
+			return true;
+
+		profiler.StartTrace((args.size() > 1)? atoi(args[1].c_str()): 300);
+		return true;
+	}
+};
+
 class DebugCubeMapActionExecutor : public IUnsyncedActionExecutor {
 public:
 	DebugCubeMapActionExecutor() : IUnsyncedActionExecutor("DebugCubeMap", "") {
@@ -1476,6 +1506,30 @@ public:
 	}
 };
 
+class NetStatsActionExecutor : public IUnsyncedActionExecutor {
+public:
+	NetStatsActionExecutor() : IUnsyncedActionExecutor(
+		"NetStats",
+		"Prints latency statistics of the link to the server; hosts also get those of every connected player"
+	) {
+	}
+
+	bool Execute(const UnsyncedAction& action) const final {
+		const netcode::CConnection* conn = clientNet->GetServerConnection();
+
+		// local (host) connections do not track timing
+		if (conn != nullptr && conn->GetTimingStats() != nullptr)
+			LOG("%s", conn->Statistics().c_str());
+
+		if (gameServer != nullptr) {
+			CommandMessage pckt(action.GetInnerAction(), gu->myPlayerNum);
+			clientNet->Send(pckt.Pack());
+		}
+
+		return true;
+	}
+};
+
 class NetMsgSmoothingActionExecutor : public IUnsyncedActionExecutor {
 public:
 	NetMsgSmoothingActionExecutor() : IUnsyncedActionExecutor(
@@ -3376,11 +3430,29 @@ public:
 };
 
 
+template<typename MemPool> static void PrintMemPoolInfo(const char* name, const MemPool& pool)
+{
+	// pages that were handed out at least once, and those among them which are free again
+	const size_t allocSize = pool.alloc_size();
+	const size_t freedSize = pool.freed_size();
+	const size_t liveSize = allocSize - freedSize;
+
+	LOG("\t%-11s pageSize=%uB pages={live=%u, free=%u} memory={live=%.2fMB, reserved=%.2fMB} fragmentation=%.1f%%",
+		name,
+		uint32_t(pool.PAGE_SIZE()),
+		uint32_t(liveSize / pool.PAGE_SIZE()),
+		uint32_t(freedSize / pool.PAGE_SIZE()),
+		liveSize / (1024.0f * 1024.0f),
+		allocSize / (1024.0f * 1024.0f),
+		(allocSize != 0)? (freedSize * 100.0f) / allocSize: 0.0f
+	);
+}
+
 class DebugInfoActionExecutor : public IUnsyncedActionExecutor {
 public:
 	DebugInfoActionExecutor() : IUnsyncedActionExecutor(
 		"DebugInfo",
-		"Print debug info to the chat/log-file about either sound, profiling, or command-descriptions"
+		"Print debug info to the chat/log-file about either sound, profiling, command-descriptions, or memory-pools"
 	) {
 	}
 
@@ -3397,8 +3469,15 @@ public:
 			case hashString("cmddescrs"): {
 				commandDescriptionCache.Dump(true);
 			} break;
+			case hashString("mempools"): {
+				LOG("[DbgInfoAction::%s] memory-pool occupancy", __func__);
+				PrintMemPoolInfo("units", unitMemPool);
+				PrintMemPoolInfo("weapons", weaponMemPool);
+				PrintMemPoolInfo("features", featureMemPool);
+				PrintMemPoolInfo("projectiles", projMemPool);
+			} break;
 			default: {
-				LOG_L(L_WARNING, "[DbgInfoAction::%s] unknown argument \"%s\" (use \"sound\", \"profiling\", or \"cmddescrs\")", __func__, args.c_str());
+				LOG_L(L_WARNING, "[DbgInfoAction::%s] unknown argument \"%s\" (use \"sound\", \"profiling\", \"cmddescrs\", or \"mempools\")", __func__, args.c_str());
 			} break;
 		}
 
@@ -3656,6 +3735,7 @@ void UnsyncedGameCommands::AddDefaultActionExecutors()
 	AddActionExecutor(AllocActionExecutor<TrackModeActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<PauseActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<DebugActionExecutor>());
+	AddActionExecutor(AllocActionExecutor<ProfileActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<DebugCubeMapActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<DebugGLActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<DebugGLErrorsActionExecutor>());
@@ -3669,6 +3749,7 @@ void UnsyncedGameCommands::AddDefaultActionExecutors()
 	// [devel] AddActionExecutor(AllocActionExecutor<DrawGrassActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<DynamicSkyActionExecutor>()); // [maint]
 	AddActionExecutor(AllocActionExecutor<NetPingActionExecutor>());
+	AddActionExecutor(AllocActionExecutor<NetStatsActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<NetMsgSmoothingActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<SpeedControlActionExecutor>());
 	AddActionExecutor(AllocActionExecutor<GameInfoActionExecutor>());
@@ -21,7 +21,6 @@
 #include "System/Object.h"
 #include "System/StringUtil.h"
 #include "System/creg/STL_Map.h"
-#include "System/creg/STL_Set.h"
 
 #include <cassert>
 
@@ -738,7 +737,7 @@ void CWaitCommandsAI::DeathWait::Update()
 	if (!deathUnits.empty())
 		return; // more must die
 
-	spring::unordered_set<int> unblockSet;
+	CUnitSet unblockSet;
 	std::vector<int> voidWaitUnitIDs;
 
 	for (const int unitID: waitUnits) {
@@ -927,7 +926,7 @@ void CWaitCommandsAI::SquadWait::Update()
 	}
 
 	if ((int)waitUnits.size() >= squadCount) {
-		spring::unordered_set<int> unblockSet;
+		CUnitSet unblockSet;
 		std::vector<int> voidWaitUnitIDs;
 
 		for (const int unitID: waitUnits) {
@@ -9,7 +9,7 @@
 #include "System/Object.h"
 #include "System/Misc/SpringTime.h"
 #include "System/UnorderedMap.hpp"
-#include "System/UnorderedSet.hpp"
+#include "System/SparseIDSet.h"
 
 class float3;
 class CObject;
@@ -26,7 +26,7 @@ class CWaitCommandsAI {
 	CR_DECLARE_SUB(GatherWait)
 
 	public:
-		typedef spring::unordered_set<int> CUnitSet;
+		typedef spring::SparseIDSet CUnitSet;
 
 		CWaitCommandsAI();
 		~CWaitCommandsAI();
@@ -0,0 +1,199 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+
+#include "LuaBytecodeCache.h"
+
+#include "LuaInclude.h"
+
+#include "Game/GameVersion.h"
+#include "System/Config/ConfigHandler.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/Log/ILog.h"
+#include "System/Sync/HsiehHash.h"
+#include "System/Threading/SpringThreading.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+CONFIG(bool, LuaBytecodeCache).defaultValue(true).description("If compiled Lua chunks should be stored in the cache directory and reused by later runs, skipping the parser for unchanged files.");
+
+
+static constexpr char BYTECODE_MAGIC[8] = {'S', 'P', 'R', 'L', 'U', 'A', 'B', 'C'};
+
+struct BytecodeHeader {
+	char magic[8];
+
+	uint64_t key;
+	uint32_t sourceSize;
+	uint32_t size;
+};
+
+// parallel LuaParser's can race on the same chunk
+static spring::mutex writeMutex;
+
+
+static uint32_t GetBuildHash()
+{
+	// bytecode is only portable between identical (Spring-patched) Lua builds
+	static const uint32_t buildHash = []() {
+		const std::string& version = SpringVersion::GetSync();
+		const uint32_t numberSize = sizeof(lua_Number);
+
+		uint32_t hash = 0;
+		hash = HsiehHash(LUA_RELEASE, sizeof(LUA_RELEASE) - 1, hash);
+		hash = HsiehHash(&numberSize, sizeof(numberSize), hash);
+		hash = HsiehHash(version.data(), version.size(), hash);
+		return hash;
+	}();
+
+	return buildHash;
+}
+
+static const std::string& GetCacheDir()
+{
+	// empty if disabled; resolved once, chunks can be loaded from multiple threads
+	static const std::string cacheDir = []() {
+		if (!configHandler->GetBool("LuaBytecodeCache"))
+			return std::string();
+
+		const std::string dir = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + "/lua/", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+
+		if (dir.empty())
+			return dir;
+
+		LOG("[LuaBytecodeCache] using \"%s\"", dir.c_str());
+		return FileSystem::EnsurePathSepAtEnd(dir);
+	}();
+
+	return cacheDir;
+}
+
+static std::string GetFileName(uint64_t key)
+{
+	char buf[32];
+	snprintf(buf, sizeof(buf), "%016" PRIx64 ".luac", key);
+	return (GetCacheDir() + buf);
+}
+
+
+static bool ReadBytecode(uint64_t key, size_t sourceSize, std::vector<char>& data)
+{
+	FILE* file = fopen(GetFileName(key).c_str(), "rb");
+
+	if (file == nullptr)
+		return false;
+
+	BytecodeHeader header;
+
+	bool ret = true;
+	ret = ret && (fread(&header, sizeof(header), 1, file) == 1);
+	ret = ret && (memcmp(header.magic, BYTECODE_MAGIC, sizeof(header.magic)) == 0);
+	ret = ret && (header.key == key && header.sourceSize == sourceSize && header.size > 0);
+
+	if (ret) {
+		data.resize(header.size);
+		ret = (fread(data.data(), header.size, 1, file) == 1);
+	}
+
+	fclose(file);
+	return ret;
+}
+
+static int BytecodeWriter(lua_State* L, const void* p, size_t sz, void* ud)
+{
+	std::vector<char>* data = static_cast<std::vector<char>*>(ud);
+	data->insert(data->end(), static_cast<const char*>(p), static_cast<const char*>(p) + sz);
+	return 0;
+}
+
+static void WriteBytecode(lua_State* L, uint64_t key, size_t sourceSize)
+{
+	std::vector<char> data;
+
+	if (lua_dump(L, BytecodeWriter, &data) != 0 || data.empty())
+		return;
+
+	BytecodeHeader header;
+	memcpy(header.magic, BYTECODE_MAGIC, sizeof(header.magic));
+
+	header.key = key;
+	header.sourceSize = sourceSize;
+	header.size = data.size();
+
+	const std::string fileName = GetFileName(key);
+	const std::string tempName = fileName + ".tmp";
+
+	std::lock_guard<spring::mutex> lck(writeMutex);
+
+	FILE* file = fopen(tempName.c_str(), "wb");
+
+	if (file == nullptr) {
+		LOG_L(L_WARNING, "[LuaBytecodeCache::%s] failed to open \"%s\" for writing", __func__, tempName.c_str());
+		return;
+	}
+
+	bool ret = true;
+	ret = ret && (fwrite(&header, sizeof(header), 1, file) == 1);
+	ret = ret && (fwrite(data.data(), data.size(), 1, file) == 1);
+
+	fclose(file);
+
+	// readers must never see a truncated chunk
+	if (!ret || std::rename(tempName.c_str(), fileName.c_str()) != 0)
+		std::remove(tempName.c_str());
+}
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+int LuaBytecodeCache::LoadBuffer(lua_State* L, const char* buf, size_t len, const char* name)
+{
+	// precompiled chunks (and empty ones) bypass the cache
+	if (len == 0 || buf[0] == LUA_SIGNATURE[0] || GetCacheDir().empty())
+		return (luaL_loadbuffer(L, buf, len, name));
+
+	// the chunk name ends up in the bytecode, so it is part of the key
+	const uint32_t sourceHash = HsiehHash(buf, len, GetBuildHash());
+	const uint32_t nameHash = HsiehHash(name, strlen(name), sourceHash);
+	const uint64_t key = (uint64_t(sourceHash) << 32) | nameHash;
+
+	std::vector<char> data;
+
+	if (ReadBytecode(key, len, data)) {
+		if (luaL_loadbuffer(L, data.data(), data.size(), name) == 0)
+			return 0;
+
+		LOG_L(L_WARNING, "[LuaBytecodeCache::%s] discarding stale chunk %016" PRIx64 " (%s): %s", __func__, key, name, lua_tostring(L, -1));
+
+		lua_pop(L, 1);
+		std::remove(GetFileName(key).c_str());
+	}
+
+	const int error = luaL_loadbuffer(L, buf, len, name);
+
+	if (error == 0)
+		WriteBytecode(L, key, len);
+
+	return error;
+}
+
+
+int LuaBytecodeCache::CallOutLoadString(lua_State* L)
+{
+	size_t len = 0;
+	const char* str = luaL_checklstring(L, 1, &len);
+	const char* chunkName = luaL_optstring(L, 2, str);
+
+	if (LoadBuffer(L, str, len, chunkName) == 0)
+		return 1;
+
+	lua_pushnil(L);
+	lua_insert(L, -2);
+	return 2; // nil, then the error message
+}
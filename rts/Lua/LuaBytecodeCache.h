@@ -0,0 +1,23 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef LUA_BYTECODE_CACHE_H
+#define LUA_BYTECODE_CACHE_H
+
+#include <cstddef>
+
+struct lua_State;
+
+// stores the bytecode of compiled chunks in the cache directory, so later
+// loads of identical source skip the parser; chunks are keyed by the hash
+// of their source, chunk name and engine build, which makes a cached chunk
+// interchangeable with a freshly parsed one (as required by synced code)
+class LuaBytecodeCache {
+	public:
+		// drop-in replacement for luaL_loadbuffer
+		static int LoadBuffer(lua_State* L, const char* buf, size_t len, const char* name);
+
+		// drop-in replacement for the base library's loadstring
+		static int CallOutLoadString(lua_State* L);
+};
+
+#endif /* LUA_BYTECODE_CACHE_H */
@@ -5,6 +5,7 @@
 
 #include "Lua/LuaAllocState.h"
 #include "Lua/LuaGarbageCollectCtrl.h"
+#include "Lua/LuaProfileState.h"
 #include "LuaMemPool.h"
 #if (!defined(UNITSYNC) && !defined(DEDICATED))
 #include "LuaShaders.h"
@@ -99,6 +100,7 @@ public:
 
 	SLuaAllocState allocState;
 	SLuaGarbageCollectCtrl gcCtrl;
+	SLuaProfileState profileState;
 
 #if (!defined(UNITSYNC) && !defined(DEDICATED))
 	// NOTE:
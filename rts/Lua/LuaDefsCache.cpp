@@ -0,0 +1,222 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+
+#include "LuaDefsCache.h"
+
+#include "LuaParser.h"
+
+#include "Game/GameSetup.h"
+#include "Game/GameVersion.h"
+#include "Sim/Misc/GlobalSynced.h" // gsRNG
+#include "System/Config/ConfigHandler.h"
+#include "System/FileSystem/ArchiveScanner.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/Log/ILog.h"
+#include "System/Sync/HsiehHash.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+CONFIG(int, DefsCache).defaultValue(1).minimumValue(0).maximumValue(2).description("If the evaluated game and map definitions should be stored in the cache directory and reused when the same game is loaded again. 0 := off, 1 := on, 2 := always evaluate them and report any difference to the cached tables.");
+
+
+static constexpr char DEFS_MAGIC[8] = {'S', 'P', 'R', 'D', 'E', 'F', 'S', 'C'};
+
+struct DefsHeader {
+	char magic[8];
+
+	uint64_t key;
+	uint32_t size;
+	uint32_t hash;
+};
+
+
+static std::string GetFileName(uint64_t key)
+{
+	const std::string dir = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + "/defs/", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+
+	if (dir.empty())
+		return dir;
+
+	char buf[32];
+	snprintf(buf, sizeof(buf), "%016" PRIx64 ".defs", key);
+	return (FileSystem::EnsurePathSepAtEnd(dir) + buf);
+}
+
+static uint64_t GetKey(LuaParser* defsParser)
+{
+	std::vector<uint8_t> data;
+	std::vector<uint8_t> blob;
+
+	const auto Append = [&](const void* p, size_t n) {
+		data.insert(data.end(), static_cast<const uint8_t*>(p), static_cast<const uint8_t*>(p) + n);
+		data.push_back(0);
+	};
+
+	const std::string& version = SpringVersion::GetSync();
+
+	Append(version.data(), version.size());
+
+	// complete checksums include all dependencies, i.e. every file the defs could read
+	for (const std::string* name: {&gameSetup->modName, &gameSetup->mapName}) {
+		const sha512::raw_digest& digest = archiveScanner->GetArchiveCompleteChecksumBytes(archiveScanner->ArchiveFromName(*name));
+
+		Append(digest.data(), digest.size());
+	}
+
+	for (const auto* options: {&CGameSetup::GetModOptions(), &CGameSetup::GetMapOptions()}) {
+		std::vector<std::pair<std::string, std::string>> sorted(options->begin(), options->end());
+		std::sort(sorted.begin(), sorted.end());
+
+		for (const auto& option: sorted) {
+			Append(option.first.data(), option.first.size());
+			Append(option.second.data(), option.second.size());
+		}
+
+		Append(nullptr, 0);
+	}
+
+	// constants taken from the game setup, map and modrules
+	for (const char* table: {"Game", "Engine"}) {
+		const bool ret = defsParser->SerializeGlobal(table, blob);
+
+		Append(blob.data(), blob.size());
+		Append(&ret, sizeof(ret));
+	}
+
+	const uint32_t hi = HsiehHash(data.data(), data.size(), 0);
+	const uint32_t lo = HsiehHash(data.data(), data.size(), hi);
+
+	return ((uint64_t(hi) << 32) | lo);
+}
+
+
+static bool ReadDefs(uint64_t key, std::vector<uint8_t>& blob)
+{
+	const std::string fileName = GetFileName(key);
+
+	if (fileName.empty())
+		return false;
+
+	FILE* file = fopen(fileName.c_str(), "rb");
+
+	if (file == nullptr)
+		return false;
+
+	DefsHeader header;
+
+	bool ret = true;
+	ret = ret && (fread(&header, sizeof(header), 1, file) == 1);
+	ret = ret && (memcmp(header.magic, DEFS_MAGIC, sizeof(header.magic)) == 0);
+	ret = ret && (header.key == key && header.size > 0);
+
+	if (ret) {
+		blob.resize(header.size);
+
+		ret = ret && (fread(blob.data(), blob.size(), 1, file) == 1);
+		ret = ret && (HsiehHash(blob.data(), blob.size(), 0) == header.hash);
+	}
+
+	fclose(file);
+
+	if (!ret)
+		blob.clear();
+
+	return ret;
+}
+
+static void WriteDefs(uint64_t key, const std::vector<uint8_t>& blob)
+{
+	const std::string fileName = GetFileName(key);
+
+	if (fileName.empty())
+		return;
+
+	const std::string tempName = fileName + ".tmp";
+
+	DefsHeader header;
+	memcpy(header.magic, DEFS_MAGIC, sizeof(header.magic));
+
+	header.key = key;
+	header.size = blob.size();
+	header.hash = HsiehHash(blob.data(), blob.size(), 0);
+
+	FILE* file = fopen(tempName.c_str(), "wb");
+
+	if (file == nullptr) {
+		LOG_L(L_WARNING, "[LuaDefsCache::%s] failed to open \"%s\" for writing", __func__, tempName.c_str());
+		return;
+	}
+
+	bool ret = true;
+	ret = ret && (fwrite(&header, sizeof(header), 1, file) == 1);
+	ret = ret && (fwrite(blob.data(), blob.size(), 1, file) == 1);
+
+	fclose(file);
+
+	// readers must never see a truncated file
+	if (!ret || std::rename(tempName.c_str(), fileName.c_str()) != 0)
+		std::remove(tempName.c_str());
+}
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+bool LuaDefsCache::Execute(LuaParser* defsParser)
+{
+	const int mode = configHandler->GetInt("DefsCache");
+
+	if (mode == 0)
+		return (defsParser->Execute());
+
+	const uint64_t key = GetKey(defsParser);
+
+	std::vector<uint8_t> cachedBlob;
+	std::vector<uint8_t> parsedBlob;
+
+	const bool haveCached = ReadDefs(key, cachedBlob);
+
+	if (haveCached && mode == 1) {
+		if (defsParser->ExecuteSerialized(cachedBlob)) {
+			LOG("[LuaDefsCache::%s] loaded definitions %016" PRIx64 " from cache", __func__, key);
+			return true;
+		}
+
+		LOG_L(L_WARNING, "[LuaDefsCache::%s] discarding invalid definitions %016" PRIx64, __func__, key);
+	}
+
+	const auto rngState = gsRNG.GetGenState();
+
+	if (!defsParser->Execute())
+		return false;
+
+	if (gsRNG.GetGenState() != rngState) {
+		LOG("[LuaDefsCache::%s] definitions use the synced RNG and can not be cached", __func__);
+		return true;
+	}
+
+	if (!defsParser->SerializeRoot(parsedBlob)) {
+		LOG("[LuaDefsCache::%s] definitions contain functions or metatables and can not be cached", __func__);
+		return true;
+	}
+
+	if (haveCached) {
+		if (cachedBlob == parsedBlob) {
+			LOG("[LuaDefsCache::%s] cached definitions %016" PRIx64 " are identical (%u bytes)", __func__, key, uint32_t(parsedBlob.size()));
+			return true;
+		}
+
+		LOG_L(L_WARNING, "[LuaDefsCache::%s] cached definitions %016" PRIx64 " differ from the evaluated ones (%u vs. %u bytes), replacing them", __func__, key, uint32_t(cachedBlob.size()), uint32_t(parsedBlob.size()));
+	}
+
+	WriteDefs(key, parsedBlob);
+	return true;
+}
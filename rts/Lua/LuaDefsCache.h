@@ -0,0 +1,19 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef LUA_DEFS_CACHE_H
+#define LUA_DEFS_CACHE_H
+
+class LuaParser;
+
+// stores the table returned by gamedata/defs.lua in the cache directory, so
+// later loads with the same archives, options and engine build skip running
+// the defs scripts; the key covers everything the defs environment exposes,
+// and defs which draw from the synced RNG are never cached (skipping them on
+// one client would leave its RNG in a different state than on the others)
+class LuaDefsCache {
+	public:
+		// drop-in replacement for defsParser->Execute(), called after SetupLua
+		static bool Execute(LuaParser* defsParser);
+};
+
+#endif /* LUA_DEFS_CACHE_H */
@@ -13,6 +13,7 @@
 #include "LuaRBOs.h"
 #include "LuaTextures.h"
 
+#include "Rendering/GL/StateCache.h"
 #include "System/Log/ILog.h"
 
 
@@ -67,6 +68,8 @@ inline void CheckDrawingEnabled(lua_State* L, const char* caller)
 		luaL_error(L, "%s(): OpenGL calls can only be used in Draw() "
 		              "call-ins, or while creating display lists", caller);
 	}
+
+	GL::StateCache::GetInstance().Invalidate();
 }
 
 
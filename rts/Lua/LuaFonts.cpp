@@ -12,6 +12,7 @@
 #include "LuaOpenGL.h"
 
 #include "Rendering/GL/myGL.h"
+#include "Rendering/GL/StateCache.h"
 #include "Rendering/Fonts/glFont.h"
 #include "System/Exceptions.h"
 
@@ -63,6 +64,9 @@ bool LuaFonts::CreateMetatable(lua_State* L)
 
 inline void CheckDrawingEnabled(lua_State* L, const char* caller)
 {
+	// font rendering sets its own shader and blending
+	GL::StateCache::GetInstance().Invalidate();
+
 	if (LuaOpenGL::IsDrawingEnabled(L))
 		return;
 
@@ -6,6 +6,7 @@
 #include "LuaRules.h"
 #include "LuaUI.h"
 
+#include "LuaBytecodeCache.h"
 #include "LuaCallInCheck.h"
 #include "LuaConfig.h"
 #include "LuaHashString.h"
@@ -62,6 +63,7 @@ static spring::unsynced_set<const luaContextData*>  UNSYNCED_LUAHANDLE_CONTEXTS;
 const  spring::unsynced_set<const luaContextData*>*          LUAHANDLE_CONTEXTS[2] = {&UNSYNCED_LUAHANDLE_CONTEXTS, &SYNCED_LUAHANDLE_CONTEXTS};
 
 bool CLuaHandle::devMode = false;
+float CLuaHandle::unsyncedGCTimeBudget = -1.0f;
 
 
 /******************************************************************************/
@@ -409,10 +411,19 @@ int CLuaHandle::RunCallInTraceback(
 		int error;
 	};
 
+	SLuaProfileState& profileState = GetLuaContextData(L)->profileState;
+
+	// attribute the callin to its own name unless the Lua side retags it
+	// (nested callins restore the tag of their caller on return)
+	const int prevProfileEntry = (hs != nullptr)? profileState.SetActiveEntry(profileState.GetEntryIndex(hs->GetHash(), hs->GetString())): -1;
+
 	// TODO: use closure so we do not need to copy args
 	ScopedLuaCall call(this, L, (hs != nullptr)? hs->GetString(): "LUS::?", inArgs, outArgs, errFuncIndex, popErrorFunc);
 	call.CheckFixStack(*ts);
 
+	if (hs != nullptr)
+		profileState.SetActiveEntry(prevProfileEntry);
+
 	return (call.GetError());
 }
 
@@ -450,7 +461,7 @@ bool CLuaHandle::LoadCode(lua_State* L, const string& code, const string& debug)
 
 	const LuaUtils::ScopedDebugTraceBack traceBack(L);
 
-	const int error = luaL_loadbuffer(L, code.c_str(), code.size(), debug.c_str());
+	const int error = LuaBytecodeCache::LoadBuffer(L, code.c_str(), code.size(), debug.c_str());
 
 	if (error != 0) {
 		LOG_L(L_ERROR, "[%s::%s] error=%i (%s) debug=%s msg=%s", name.c_str(), __func__, error, LuaErrorString(error), debug.c_str(), lua_tostring(L, -1));
@@ -1010,6 +1021,64 @@ void CLuaHandle::UnitDamaged(
 	RunCallInTraceback(L, cmdStr, argCount, 0, traceBack.GetErrFuncIdx(), false);
 }
 
+void CLuaHandle::UnitDamagedBatch(const std::vector<UnitDamagedEvent>& events)
+{
+	LUA_CALL_IN_CHECK(L);
+	luaL_checkstack(L, 14, __func__);
+
+	static const LuaHashString cmdStr(__func__);
+	const LuaUtils::ScopedDebugTraceBack traceBack(L);
+
+	unsigned int numEvents = 0;
+
+	for (const UnitDamagedEvent& e: events) {
+		numEvents += CanReadAllyTeam(e.unitAllyTeam);
+	}
+
+	if (numEvents == 0)
+		return;
+	if (!cmdStr.GetGlobalFunc(L))
+		return;
+
+	// same values as UnitDamaged, one array per argument; attacker
+	// entries are nil where UnitDamaged would not have passed them
+	const bool fullRead = GetHandleFullRead(L);
+	const int tableIdx = lua_gettop(L) + 2;
+
+	lua_pushnumber(L, numEvents);
+
+	for (int i = 0; i < 10; i++) {
+		lua_createtable(L, numEvents, 0);
+	}
+
+	for (unsigned int i = 0, n = 0; i < events.size(); i++) {
+		const UnitDamagedEvent& e = events[i];
+
+		if (!CanReadAllyTeam(e.unitAllyTeam))
+			continue;
+
+		n += 1;
+
+		lua_pushnumber(L, e.unitID       ); lua_rawseti(L, tableIdx + 0, n);
+		lua_pushnumber(L, e.unitDefID    ); lua_rawseti(L, tableIdx + 1, n);
+		lua_pushnumber(L, e.unitTeam     ); lua_rawseti(L, tableIdx + 2, n);
+		lua_pushnumber(L, e.damage       ); lua_rawseti(L, tableIdx + 3, n);
+		lua_pushboolean(L, e.paralyzer   ); lua_rawseti(L, tableIdx + 4, n);
+		lua_pushnumber(L, e.weaponDefID  ); lua_rawseti(L, tableIdx + 5, n);
+		lua_pushnumber(L, e.projectileID ); lua_rawseti(L, tableIdx + 6, n);
+
+		if (e.attackerID == -1 || !fullRead)
+			continue;
+
+		lua_pushnumber(L, e.attackerID   ); lua_rawseti(L, tableIdx + 7, n);
+		lua_pushnumber(L, e.attackerDefID); lua_rawseti(L, tableIdx + 8, n);
+		lua_pushnumber(L, e.attackerTeam ); lua_rawseti(L, tableIdx + 9, n);
+	}
+
+	// call the routine
+	RunCallInTraceback(L, cmdStr, 11, 0, traceBack.GetErrFuncIdx(), false);
+}
+
 void CLuaHandle::UnitStunned(
 	const CUnit* unit,
 	bool stunned)
@@ -2621,6 +2690,16 @@ void CLuaHandle::CollectGarbage(bool forced)
 	const float gcMemLoadMult = D.gcCtrl.baseMemLoadMult;
 	const float gcRunTimeMult = D.gcCtrl.baseRunTimeMult;
 
+	const bool budgetedPass = (unsyncedGCTimeBudget > 0.0f);
+
+	if (!forced) {
+		// synced gc stays tied to sim-frames, unsynced gc may be deferred
+		if (D.synced && budgetedPass)
+			return;
+		if (!D.synced && unsyncedGCTimeBudget == 0.0f)
+			return;
+	}
+
 	if (!forced && spring_lua_alloc_skip_gc(gcMemLoadMult))
 		return;
 
@@ -2641,7 +2720,14 @@ void CLuaHandle::CollectGarbage(bool forced)
 	// mean too much time is spent on it, must weigh the per-call period
 	const float gcSpeedFactor = Clamp(gs->speedFactor * (1 - gs->PreSimFrame()) * (1 - gs->paused), 1.0f, 50.0f);
 	const float gcBaseRunTime = smoothstep(10.0f, 100.0f, gcMemFootPrint / 1024);
-	const float gcLoopRunTime = Clamp((gcBaseRunTime * gcRunTimeMult) / gcSpeedFactor, D.gcCtrl.minLoopRunTime, D.gcCtrl.maxLoopRunTime);
+	const float gcClampRunTime = Clamp((gcBaseRunTime * gcRunTimeMult) / gcSpeedFactor, D.gcCtrl.minLoopRunTime, D.gcCtrl.maxLoopRunTime);
+	const float gcLoopRunTime = (!D.synced && budgetedPass)? std::min(gcClampRunTime, unsyncedGCTimeBudget): gcClampRunTime;
+
+	SLuaProfileState& profileState = D.profileState;
+
+	// charge gc time to its own entry in the handle's profile
+	static const LuaHashString gcProfileTag(__func__);
+	const int prevProfileEntry = profileState.SetActiveEntry(profileState.GetEntryIndex(gcProfileTag.GetHash(), gcProfileTag.GetString()));
 
 	const spring_time startTime = spring_gettime();
 	const spring_time   endTime = startTime + spring_msecs(gcLoopRunTime);
@@ -2672,6 +2758,12 @@ void CLuaHandle::CollectGarbage(bool forced)
 
 	const spring_time finishTime = spring_gettime();
 
+	profileState.SetActiveEntry(prevProfileEntry);
+
+	// later handles in this pass get whatever budget is left (min. 0.01ms)
+	if (!D.synced && budgetedPass)
+		unsyncedGCTimeBudget = std::max(unsyncedGCTimeBudget - (finishTime - startTime).toMilliSecsf(), 0.01f);
+
 	if (gcStepsPerIter > 1 && gcItersInBatch > 0) {
 		// runtime optimize number of steps to process in a batch
 		const float avgLoopIterTime = (finishTime - startTime).toMilliSecsf() / gcItersInBatch;
@@ -2705,6 +2797,7 @@ bool CLuaHandle::AddBasicCalls(lua_State* L)
 		HSTR_PUSH_CFUNC(L, "GetRegistry",     CallOutGetRegistry);
 		HSTR_PUSH_CFUNC(L, "GetCallInList",   CallOutGetCallInList);
 		HSTR_PUSH_CFUNC(L, "IsEngineMinVersion", CallOutIsEngineMinVersion);
+		HSTR_PUSH_CFUNC(L, "SetProfileTag",   CallOutSetProfileTag);
 		// special team constants
 		HSTR_PUSH_NUMBER(L, "NO_ACCESS_TEAM",  CEventClient::NoAccessTeam);
 		HSTR_PUSH_NUMBER(L, "ALL_ACCESS_TEAM", CEventClient::AllAccessTeam);
@@ -2717,10 +2810,26 @@ bool CLuaHandle::AddBasicCalls(lua_State* L)
 	LuaMathExtra::PushEntries(L);
 	lua_pop(L, 1);
 
+	// same as the base loadstring, but goes through the bytecode cache
+	LuaPushNamedCFunc(L, "loadstring", LuaBytecodeCache::CallOutLoadString);
 	return true;
 }
 
 
+int CLuaHandle::CallOutSetProfileTag(lua_State* L)
+{
+	size_t len = 0;
+	const char* tag = luaL_checklstring(L, 1, &len);
+
+	SLuaProfileState& profileState = GetLuaContextData(L)->profileState;
+
+	// time and allocations from here until the next retag or the end of the
+	// current callin are charged to <tag>, e.g. the gadget a handler calls
+	profileState.SetActiveEntry(profileState.GetEntryIndex(lua_calchash(tag, len), tag));
+	return 0;
+}
+
+
 int CLuaHandle::CallOutGetName(lua_State* L)
 {
 	lua_pushsstring(L, GetHandle(L)->GetName());
@@ -137,6 +137,7 @@ class CLuaHandle : public CEventClient
 			int projectileID,
 			bool paralyzer
 		) override;
+		void UnitDamagedBatch(const std::vector<UnitDamagedEvent>& events) override;
 		void UnitStunned(const CUnit* unit, bool stunned) override;
 		void UnitExperience(const CUnit* unit, float oldExperience) override;
 		void UnitHarvestStorageFull(const CUnit* unit) override;
@@ -341,6 +342,7 @@ class CLuaHandle : public CEventClient
 		static int CallOutGetCallInList(lua_State* L);
 		static int CallOutUpdateCallIn(lua_State* L);
 		static int CallOutIsEngineMinVersion(lua_State* L);
+		static int CallOutSetProfileTag(lua_State* L);
 
 	public: // static
 #if (!defined(UNITSYNC) && !defined(DEDICATED))
@@ -355,10 +357,17 @@ class CLuaHandle : public CEventClient
 		static void SetDevMode(bool value) { devMode = value; }
 		static bool GetDevMode() { return devMode; }
 
+		// <0 := unsynced handles collect whenever asked (default)
+		//  0 := unsynced handles skip all non-forced collections
+		// >0 := milliseconds the unsynced handles may spend collecting in
+		//       the current pass (together), synced handles skip this pass
+		static void SetUnsyncedGCTimeBudget(float value) { unsyncedGCTimeBudget = value; }
+
 		static void HandleLuaMsg(int playerID, int script, int mode, const std::vector<std::uint8_t>& msg);
 
 	protected: // static
 		static bool devMode; // allows real file access
+		static float unsyncedGCTimeBudget;
 
 		// FIXME: because CLuaUnitScript needs to access RunCallIn
 		friend class CLuaUnitScript;
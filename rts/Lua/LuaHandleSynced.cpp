@@ -6,6 +6,7 @@
 
 #include "LuaUtils.h"
 #include "LuaArchive.h"
+#include "LuaBytecodeCache.h"
 #include "LuaCallInCheck.h"
 #include "LuaConfig.h"
 #include "LuaConstGL.h"
@@ -1821,7 +1822,7 @@ int CSplitLuaHandle::LoadStringData(lua_State* L)
 	const char *str    = luaL_checklstring(L, 1, &len);
 	const char *chunkname = luaL_optstring(L, 2, str);
 
-	if (luaL_loadbuffer(L, str, len, chunkname) != 0) {
+	if (LuaBytecodeCache::LoadBuffer(L, str, len, chunkname) != 0) {
 		lua_pushnil(L);
 		lua_insert(L, -2);
 		return 2; // nil, then the error message
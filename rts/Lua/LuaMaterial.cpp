@@ -5,6 +5,7 @@
 
 #include "LuaHandle.h"
 #include "LuaOpenGL.h"
+#include "LuaShaders.h"
 
 #include "Game/Camera.h"
 #include "Game/GlobalUnsynced.h" // randVector
@@ -127,6 +128,10 @@ void LuaMatShader::Execute(const LuaMatShader& prev, bool deferredPass) const
 	static_assert(int(LUASHADER_ASS) == int(MODELTYPE_ASS  ), "");
 	static_assert(int(LUASHADER_GL ) == int(MODELTYPE_CNT), "");
 
+	// material uniforms bypass gl.Uniform, forget what it last set
+	if (type == LUASHADER_GL)
+		LuaShaders::InvalidateUniformValues();
+
 	if (type != prev.type) {
 		switch (prev.type) {
 			case LUASHADER_GL: {
@@ -383,6 +388,8 @@ void LuaMaterial::ExecuteInstanceUniforms(int objId, int objType, bool deferredP
 	if (objUniformsIt == objUniforms.end())
 		return;
 
+	LuaShaders::InvalidateUniformValues();
+
 	// apply custom per-object LuaMaterial uniforms (if any)
 	// can stop at first empty slot, Clear ensures contiguity
 	for (const LuaMatUniform& u: objUniformsIt->second) {
@@ -6,6 +6,12 @@
 #include "LuaInclude.h"
 #include "LuaUtils.h"
 
+#include "xsimd/xsimd.hpp"
+
+#include <array>
+#include <limits>
+#include <vector>
+
 static const lua_Number POWERS_OF_TEN[] = {1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f, 100000.0f, 1000000.0f, 10000000.0f};
 
 /******************************************************************************/
@@ -21,6 +27,12 @@ bool LuaMathExtra::PushEntries(lua_State* L)
 	LuaPushNamedCFunc(L, "round",  round);
 	LuaPushNamedCFunc(L, "erf",    erf);
 	LuaPushNamedCFunc(L, "smoothstep", smoothstep);
+
+	LuaPushNamedCFunc(L, "vdot",         vdot);
+	LuaPushNamedCFunc(L, "vnormalize",   vnormalize);
+	LuaPushNamedCFunc(L, "vdistance",    vdistance);
+	LuaPushNamedCFunc(L, "vnearest",     vnearest);
+	LuaPushNamedCFunc(L, "gridconvolve", gridconvolve);
 	return true;
 }
 
@@ -108,3 +120,317 @@ int LuaMathExtra::smoothstep(lua_State* L) {
 /******************************************************************************/
 /******************************************************************************/
 
+
+// the batched functions take vectors as flat arrays {x1, y1, [z1, [w1,]] x2, ...}
+// with <dims> (default 3) components each; they are converted to one padded
+// array per component, so every kernel runs on whole SIMD registers and the
+// same per-lane operation order yields the same results for any register width
+using SIMDVfloat = xsimd::simd_type<float>;
+
+static constexpr size_t SIMD_SIZE = SIMDVfloat::size;
+static constexpr int MAX_DIMS = 4;
+
+typedef std::array<std::vector<float>, MAX_DIMS> VectorArray;
+
+static size_t PaddedSize(size_t n) { return (n + SIMD_SIZE - 1) / SIMD_SIZE * SIMD_SIZE; }
+
+static int CheckDims(lua_State* L, int idx)
+{
+	const int dims = luaL_optint(L, idx, 3);
+
+	if (dims < 1 || dims > MAX_DIMS)
+		luaL_error(L, "[%s] dims must be in [1, %d]", __func__, MAX_DIMS);
+
+	return dims;
+}
+
+static size_t ReadVectors(lua_State* L, int idx, int dims, VectorArray& comps)
+{
+	luaL_checktype(L, idx, LUA_TTABLE);
+
+	const size_t len = lua_objlen(L, idx);
+	const size_t num = len / dims;
+
+	if ((len % dims) != 0)
+		luaL_error(L, "[%s] array length %d is not a multiple of %d", __func__, int(len), dims);
+
+	for (int c = 0; c < dims; c++) {
+		comps[c].clear();
+		comps[c].resize(PaddedSize(num), 0.0f);
+	}
+
+	for (size_t i = 0; i < num; i++) {
+		for (int c = 0; c < dims; c++) {
+			lua_rawgeti(L, idx, i * dims + c + 1);
+			comps[c][i] = lua_tonumber(L, -1);
+			lua_pop(L, 1);
+		}
+	}
+
+	return num;
+}
+
+static void PushArray(lua_State* L, const float* values, size_t num)
+{
+	lua_createtable(L, num, 0);
+
+	for (size_t i = 0; i < num; i++) {
+		lua_pushnumber(L, values[i]);
+		lua_rawseti(L, -2, i + 1);
+	}
+}
+
+
+int LuaMathExtra::vdot(lua_State* L) {
+	// math.vdot(a, b[, dims]) -> {a1 . b1, a2 . b2, ...}
+	const int dims = CheckDims(L, 3);
+
+	VectorArray a;
+	VectorArray b;
+
+	const size_t num = ReadVectors(L, 1, dims, a);
+
+	if (ReadVectors(L, 2, dims, b) != num)
+		luaL_error(L, "[%s] arrays differ in length", __func__);
+
+	std::vector<float> dots(PaddedSize(num));
+
+	for (size_t i = 0; i < dots.size(); i += SIMD_SIZE) {
+		SIMDVfloat dot(0.0f);
+
+		for (int c = 0; c < dims; c++) {
+			dot = dot + xsimd::load_unaligned(&a[c][i]) * xsimd::load_unaligned(&b[c][i]);
+		}
+
+		xsimd::store_unaligned(&dots[i], dot);
+	}
+
+	PushArray(L, dots.data(), num);
+	return 1;
+}
+
+int LuaMathExtra::vnormalize(lua_State* L) {
+	// math.vnormalize(a[, dims]) -> {a1 / |a1|, ...}, zero vectors stay zero
+	const int dims = CheckDims(L, 2);
+
+	VectorArray a;
+
+	const size_t num = ReadVectors(L, 1, dims, a);
+	const SIMDVfloat zero(0.0f);
+
+	std::vector<float> norms(num * dims);
+
+	for (size_t i = 0; i < PaddedSize(num); i += SIMD_SIZE) {
+		SIMDVfloat sqLen(0.0f);
+
+		for (int c = 0; c < dims; c++) {
+			const SIMDVfloat v = xsimd::load_unaligned(&a[c][i]);
+			sqLen = sqLen + v * v;
+		}
+
+		const SIMDVfloat len = xsimd::sqrt(sqLen);
+
+		for (int c = 0; c < dims; c++) {
+			xsimd::store_unaligned(&a[c][i], xsimd::select(len > zero, xsimd::load_unaligned(&a[c][i]) / len, zero));
+		}
+	}
+
+	// interleave the components again
+	for (size_t i = 0; i < num; i++) {
+		for (int c = 0; c < dims; c++) {
+			norms[i * dims + c] = a[c][i];
+		}
+	}
+
+	PushArray(L, norms.data(), num * dims);
+	return 1;
+}
+
+int LuaMathExtra::vdistance(lua_State* L) {
+	// math.vdistance(a, b[, dims]) -> {|a1 - b1|, ...}; b can also be a single vector
+	const int dims = CheckDims(L, 3);
+
+	VectorArray a;
+	VectorArray b;
+
+	const size_t numA = ReadVectors(L, 1, dims, a);
+	const size_t numB = ReadVectors(L, 2, dims, b);
+
+	if (numB != numA && numB != 1)
+		luaL_error(L, "[%s] arrays differ in length", __func__);
+
+	std::vector<float> dists(PaddedSize(numA));
+
+	for (size_t i = 0; i < dists.size(); i += SIMD_SIZE) {
+		SIMDVfloat sqDist(0.0f);
+
+		for (int c = 0; c < dims; c++) {
+			const SIMDVfloat vb = (numB == 1)? SIMDVfloat(b[c][0]): xsimd::load_unaligned(&b[c][i]);
+			const SIMDVfloat d = xsimd::load_unaligned(&a[c][i]) - vb;
+
+			sqDist = sqDist + d * d;
+		}
+
+		xsimd::store_unaligned(&dists[i], xsimd::sqrt(sqDist));
+	}
+
+	PushArray(L, dists.data(), numA);
+	return 1;
+}
+
+int LuaMathExtra::vnearest(lua_State* L) {
+	// math.vnearest(points, queries[, dims]) -> {index1, ...}, {distance1, ...}
+	// brute-force; ties resolve to the lowest index, no points yields index 0
+	const int dims = CheckDims(L, 3);
+
+	VectorArray points;
+	VectorArray queries;
+
+	const size_t numPoints = ReadVectors(L, 1, dims, points);
+	const size_t numQueries = ReadVectors(L, 2, dims, queries);
+
+	// indices are carried in float lanes
+	if (numPoints > (1 << 24))
+		luaL_error(L, "[%s] too many points", __func__);
+
+	const SIMDVfloat inf(std::numeric_limits<float>::infinity());
+	const SIMDVfloat maxIndex(numPoints);
+
+	std::vector<float> indices(numQueries, 0.0f);
+	std::vector<float> dists(numQueries, 0.0f);
+
+	alignas(64) float laneDists[SIMD_SIZE];
+	alignas(64) float laneIndices[SIMD_SIZE];
+	alignas(64) float laneOffsets[SIMD_SIZE];
+
+	for (size_t j = 0; j < SIMD_SIZE; j++) {
+		laneOffsets[j] = j;
+	}
+
+	for (size_t q = 0; q < numQueries; q++) {
+		SIMDVfloat minSqDist = inf;
+		SIMDVfloat minIndex(0.0f);
+		SIMDVfloat index = xsimd::load_aligned(&laneOffsets[0]);
+
+		for (size_t i = 0; i < PaddedSize(numPoints); i += SIMD_SIZE) {
+			SIMDVfloat sqDist(0.0f);
+
+			for (int c = 0; c < dims; c++) {
+				const SIMDVfloat d = xsimd::load_unaligned(&points[c][i]) - SIMDVfloat(queries[c][q]);
+				sqDist = sqDist + d * d;
+			}
+
+			// padding lanes never win
+			sqDist = xsimd::select(index < maxIndex, sqDist, inf);
+
+			minIndex = xsimd::select(sqDist < minSqDist, index, minIndex);
+			minSqDist = xsimd::min(sqDist, minSqDist);
+
+			index = index + SIMDVfloat(SIMD_SIZE);
+		}
+
+		xsimd::store_aligned(&laneDists[0], minSqDist);
+		xsimd::store_aligned(&laneIndices[0], minIndex);
+
+		float bestSqDist = std::numeric_limits<float>::infinity();
+		float bestIndex = -1.0f;
+
+		for (size_t j = 0; j < SIMD_SIZE; j++) {
+			if (laneDists[j] > bestSqDist)
+				continue;
+			if (laneDists[j] == bestSqDist && laneIndices[j] > bestIndex)
+				continue;
+
+			bestSqDist = laneDists[j];
+			bestIndex = laneIndices[j];
+		}
+
+		indices[q] = bestIndex + 1.0f;
+		dists[q] = (bestIndex >= 0.0f)? math::sqrt(bestSqDist): 0.0f;
+	}
+
+	PushArray(L, indices.data(), numQueries);
+	PushArray(L, dists.data(), numQueries);
+	return 2;
+}
+
+int LuaMathExtra::gridconvolve(lua_State* L) {
+	// math.gridconvolve(grid, width, height, kernel, kernelWidth, kernelHeight) -> grid
+	// both are flat row-major arrays, kernel sizes must be odd; edges are clamped
+	luaL_checktype(L, 1, LUA_TTABLE);
+	luaL_checktype(L, 4, LUA_TTABLE);
+
+	const int w = luaL_checkint(L, 2);
+	const int h = luaL_checkint(L, 3);
+	const int kw = luaL_checkint(L, 5);
+	const int kh = luaL_checkint(L, 6);
+
+	if (w <= 0 || h <= 0 || size_t(w) * h != lua_objlen(L, 1))
+		luaL_error(L, "[%s] grid size does not match %dx%d", __func__, w, h);
+	if (kw <= 0 || kh <= 0 || (kw & 1) == 0 || (kh & 1) == 0 || size_t(kw) * kh != lua_objlen(L, 4))
+		luaL_error(L, "[%s] kernel size does not match %dx%d (or is not odd)", __func__, kw, kh);
+
+	const int rx = kw >> 1;
+	const int ry = kh >> 1;
+
+	// source copy with the clamped border baked in, rows padded to whole registers
+	const size_t rowSize = PaddedSize(w) + kw - 1;
+
+	std::vector<float> src(rowSize * (h + kh - 1), 0.0f);
+	std::vector<float> dst(PaddedSize(w) * h);
+	std::vector<float> kernel(kw * kh);
+
+	for (int i = 0; i < kw * kh; i++) {
+		lua_rawgeti(L, 4, i + 1);
+		kernel[i] = lua_tonumber(L, -1);
+		lua_pop(L, 1);
+	}
+
+	for (int y = 0; y < h; y++) {
+		for (int x = 0; x < w; x++) {
+			lua_rawgeti(L, 1, y * w + x + 1);
+			src[(y + ry) * rowSize + (x + rx)] = lua_tonumber(L, -1);
+			lua_pop(L, 1);
+		}
+
+		for (int x = 0; x < rx; x++) {
+			src[(y + ry) * rowSize + x] = src[(y + ry) * rowSize + rx];
+			src[(y + ry) * rowSize + (w + rx + x)] = src[(y + ry) * rowSize + (w + rx - 1)];
+		}
+	}
+
+	for (int y = 0; y < ry; y++) {
+		std::copy_n(&src[ry * rowSize], rowSize, &src[y * rowSize]);
+		std::copy_n(&src[(h + ry - 1) * rowSize], rowSize, &src[(h + ry + y) * rowSize]);
+	}
+
+	for (int y = 0; y < h; y++) {
+		for (size_t x = 0; x < PaddedSize(w); x += SIMD_SIZE) {
+			SIMDVfloat sum(0.0f);
+
+			for (int ky = 0; ky < kh; ky++) {
+				const float* row = &src[(y + ky) * rowSize + x];
+
+				for (int kx = 0; kx < kw; kx++) {
+					sum = sum + xsimd::load_unaligned(&row[kx]) * SIMDVfloat(kernel[ky * kw + kx]);
+				}
+			}
+
+			xsimd::store_unaligned(&dst[y * PaddedSize(w) + x], sum);
+		}
+	}
+
+	lua_createtable(L, w * h, 0);
+
+	for (int y = 0; y < h; y++) {
+		for (int x = 0; x < w; x++) {
+			lua_pushnumber(L, dst[y * PaddedSize(w) + x]);
+			lua_rawseti(L, -2, y * w + x + 1);
+		}
+	}
+
+	return 1;
+}
+
+/******************************************************************************/
+/******************************************************************************/
@@ -18,6 +18,13 @@ class LuaMathExtra {
 		static int round(lua_State* L);
 		static int erf(lua_State* L);
 		static int smoothstep(lua_State* L);
+
+		// batched kernels over flat arrays of numbers
+		static int vdot(lua_State* L);
+		static int vnormalize(lua_State* L);
+		static int vdistance(lua_State* L);
+		static int vnearest(lua_State* L);
+		static int gridconvolve(lua_State* L);
 };
 
 #endif /* LUA_MATH_EXTRA_H */
@@ -78,11 +78,18 @@ void LuaMemPool::ReleasePtr(LuaMemPool* p, const CLuaHandle* o)
 {
 	gCount -= (o != nullptr);
 
+	// the releasing state has been closed, so once no other state uses
+	// the pool its chunks can all be freed at once instead of lingering
+	// until the next AcquirePtr
 	if (p == GetSharedPtr()) {
-		p->GetSharedCount() -= 1;
+		if ((p->GetSharedCount() -= 1) == 0)
+			p->DeleteBlocks();
+
 		return;
 	}
 
+	p->DeleteBlocks();
+
 	gMutex.lock();
 	gIndcs.push_back(p->GetGlobalIndex());
 	gMutex.unlock();
@@ -161,6 +168,14 @@ void LuaMemPool::DeleteBlocks()
 
 	allocBlocks.clear();
 	#endif
+	#else
+	// hand every chunk back to the OS, only safe once all allocations
+	// have been freed (i.e. after the owning state(s) were closed)
+	if (!LuaMemPool::enabled || poolImpl.numAllocs[PoolImpl::NUM_POOLS] != 0)
+		return;
+
+	poolImpl.Kill();
+	poolImpl.Init();
 	#endif
 }
 
@@ -224,13 +239,33 @@ void* LuaMemPool::Alloc(size_t size)
 
 void* LuaMemPool::Realloc(void* ptr, size_t nsize, size_t osize)
 {
+	#if (LMP_USE_CHUNK_TABLE == 0)
+	// growing or shrinking within the same size-class needs no new chunk;
+	// common for Lua strings and buffers, tables mostly double in size
+	if (ptr != nullptr && !AllocExternal(nsize) && !AllocExternal(osize)) {
+		const size_t nbytes = std::max(nsize, size_t(MIN_ALLOC_SIZE));
+		const size_t obytes = std::max(osize, size_t(MIN_ALLOC_SIZE));
+
+		const uint32_t poolIndex = PoolImpl::CalcPoolIndex(nbytes);
+
+		if (poolIndex == PoolImpl::CalcPoolIndex(obytes)) {
+			allocStats[STAT_NRA] += 1;
+			allocStats[STAT_NCB] += (nbytes - obytes);
+
+			poolImpl.allocSums[poolIndex] += (nbytes - obytes);
+			poolImpl.allocSums[PoolImpl::NUM_POOLS] += (nbytes - obytes);
+			return ptr;
+		}
+	}
+	#endif
+
 	void* ret = Alloc(nsize);
 
 	if (ptr == nullptr)
 		return ret;
 
+	// no need to clear ptr, pool pages are zero-filled when freed
 	std::memcpy(ret, ptr, std::min(nsize, osize));
-	std::memset(ptr, 0, osize);
 
 	Free(ptr, osize);
 	return ret;
@@ -17,6 +17,7 @@
 #include "LuaUnsyncedRead.h"
 #include "LuaVFS.h"
 #include "LuaVFSDownload.h"
+#include "LuaWorkers.h"
 #include "LuaZip.h"
 
 #include "System/EventHandler.h"
@@ -107,6 +108,7 @@ CLuaMenu::CLuaMenu()
 		!AddEntriesToTable(L, "Spring",    LoadUnsyncedCtrlFunctions)      ||
 		!AddEntriesToTable(L, "Spring",    LoadUnsyncedReadFunctions)      ||
 		!AddEntriesToTable(L, "Spring",    LoadLuaMenuFunctions)           ||
+		!AddEntriesToTable(L, "Spring",    LuaWorkers::PushEntries)        ||
 		!AddEntriesToTable(L, "Engine",    LuaConstEngine::PushEntries)    ||
 		!AddEntriesToTable(L, "Platform",  LuaConstPlatform::PushEntries)  ||
 		!AddEntriesToTable(L, "Script",    LuaScream::PushEntries)         ||
@@ -7,6 +7,8 @@
 #include "LuaUtils.h"
 #include "Map/MetalMap.h"
 #include "Map/ReadMap.h"
+#include "Sim/Misc/ResourceHandler.h"
+#include "Sim/Misc/ResourceMapAnalyzer.h"
 
 /******************************************************************************/
 /******************************************************************************/
@@ -16,6 +18,7 @@ bool LuaMetalMap::PushReadEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(GetMetalMapSize);
 	REGISTER_LUA_CFUNC(GetMetalAmount);
 	REGISTER_LUA_CFUNC(GetMetalExtraction);
+	REGISTER_LUA_CFUNC(GetMetalSpots);
 	return true;
 }
 
@@ -60,6 +63,23 @@ int LuaMetalMap::GetMetalExtraction(lua_State* L)
 	return 1;
 }
 
+int LuaMetalMap::GetMetalSpots(lua_State* L)
+{
+	// reanalyzed on demand if the metal map was changed since the last call
+	const std::vector<float3>& spots = resourceHandler->GetResourceMapAnalyzer(resourceHandler->GetMetalId())->GetSpots();
+
+	lua_createtable(L, spots.size(), 0);
+
+	for (size_t i = 0; i < spots.size(); i++) {
+		lua_createtable(L, 3, 0);
+		lua_pushnumber(L, spots[i].x); lua_rawseti(L, -2, 1);
+		lua_pushnumber(L, spots[i].y); lua_rawseti(L, -2, 2);
+		lua_pushnumber(L, spots[i].z); lua_rawseti(L, -2, 3);
+		lua_rawseti(L, -2, i + 1); // [i] = {x,metal,z}
+	}
+
+	return 1;
+}
 
 
 
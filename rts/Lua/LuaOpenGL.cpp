@@ -57,6 +57,7 @@
 #include "Rendering/Env/WaterRendering.h"
 #include "Rendering/Env/MapRendering.h"
 #include "Rendering/GL/glExtra.h"
+#include "Rendering/GL/StateCache.h"
 #include "Rendering/Models/3DModel.h"
 #include "Rendering/Shaders/Shader.h"
 #include "Rendering/Textures/Bitmap.h"
@@ -611,12 +612,16 @@ void LuaOpenGL::EnableCommon(DrawMode mode)
 	// FIXME  --  not needed by shadow or minimap   (use a WorldCommon ? )
 	//glEnable(GL_NORMALIZE);
 	glLightModeli(GL_LIGHT_MODEL_COLOR_CONTROL, GL_SEPARATE_SPECULAR_COLOR);
+
+	// only Lua touches GL until DisableCommon, except via calls which invalidate
+	GL::StateCache::GetInstance().Activate(true);
 }
 
 
 void LuaOpenGL::DisableCommon(DrawMode mode)
 {
 	assert(drawMode == mode);
+	GL::StateCache::GetInstance().Activate(false);
 	// FIXME  --  not needed by shadow or minimap
 	glLightModeli(GL_LIGHT_MODEL_COLOR_CONTROL, GL_SINGLE_COLOR);
 	drawMode = DRAW_NONE;
@@ -1102,6 +1107,14 @@ void LuaOpenGL::ResetMiniMapMatrices()
 
 
 inline void LuaOpenGL::CheckDrawingEnabled(lua_State* L, const char* caller)
+{
+	CheckCachedDrawingEnabled(L, caller);
+
+	// anything not restricted to cached state might change it behind our back
+	GL::StateCache::GetInstance().Invalidate();
+}
+
+inline void LuaOpenGL::CheckCachedDrawingEnabled(lua_State* L, const char* caller)
 {
 	if (!IsDrawingEnabled(L)) {
 		luaL_error(L, "%s(): OpenGL calls can only be used in Draw() "
@@ -2709,11 +2722,11 @@ int LuaOpenGL::ColorMask(lua_State* L)
 
 int LuaOpenGL::DepthMask(lua_State* L)
 {
-	CheckDrawingEnabled(L, __func__);
+	CheckCachedDrawingEnabled(L, __func__);
 	if (luaL_checkboolean(L, 1)) {
-		glDepthMask(GL_TRUE);
+		GL::StateCache::GetInstance().DepthMask(true);
 	} else {
-		glDepthMask(GL_FALSE);
+		GL::StateCache::GetInstance().DepthMask(false);
 	}
 	return 0;
 }
@@ -2721,7 +2734,9 @@ int LuaOpenGL::DepthMask(lua_State* L)
 
 int LuaOpenGL::DepthTest(lua_State* L)
 {
-	CheckDrawingEnabled(L, __func__);
+	CheckCachedDrawingEnabled(L, __func__);
+
+	GL::StateCache& stateCache = GL::StateCache::GetInstance();
 
 	const int args = lua_gettop(L); // number of arguments
 	if (args != 1) {
@@ -2730,14 +2745,14 @@ int LuaOpenGL::DepthTest(lua_State* L)
 
 	if (lua_isboolean(L, 1)) {
 		if (lua_toboolean(L, 1)) {
-			glEnable(GL_DEPTH_TEST);
+			stateCache.Enable(GL_DEPTH_TEST);
 		} else {
-			glDisable(GL_DEPTH_TEST);
+			stateCache.Disable(GL_DEPTH_TEST);
 		}
 	}
 	else if (lua_isnumber(L, 1)) {
-		glEnable(GL_DEPTH_TEST);
-		glDepthFunc((GLenum)lua_tonumber(L, 1));
+		stateCache.Enable(GL_DEPTH_TEST);
+		stateCache.DepthFunc((GLenum)lua_tonumber(L, 1));
 	}
 	else {
 		luaL_error(L, "Incorrect arguments to gl.DepthTest()");
@@ -2761,7 +2776,9 @@ int LuaOpenGL::DepthClamp(lua_State* L)
 
 int LuaOpenGL::Culling(lua_State* L)
 {
-	CheckDrawingEnabled(L, __func__);
+	CheckCachedDrawingEnabled(L, __func__);
+
+	GL::StateCache& stateCache = GL::StateCache::GetInstance();
 
 	const int args = lua_gettop(L); // number of arguments
 	if (args != 1) {
@@ -2770,14 +2787,14 @@ int LuaOpenGL::Culling(lua_State* L)
 
 	if (lua_isboolean(L, 1)) {
 		if (lua_toboolean(L, 1)) {
-			glEnable(GL_CULL_FACE);
+			stateCache.Enable(GL_CULL_FACE);
 		} else {
-			glDisable(GL_CULL_FACE);
+			stateCache.Disable(GL_CULL_FACE);
 		}
 	}
 	else if (lua_isnumber(L, 1)) {
-		glEnable(GL_CULL_FACE);
-		glCullFace((GLenum)lua_tonumber(L, 1));
+		stateCache.Enable(GL_CULL_FACE);
+		stateCache.CullFace((GLenum)lua_tonumber(L, 1));
 	}
 	else {
 		luaL_error(L, "Incorrect arguments to gl.Culling()");
@@ -2829,44 +2846,46 @@ int LuaOpenGL::Fog(lua_State* L)
 
 int LuaOpenGL::Blending(lua_State* L)
 {
-	CheckDrawingEnabled(L, __func__);
+	CheckCachedDrawingEnabled(L, __func__);
+
+	GL::StateCache& stateCache = GL::StateCache::GetInstance();
 
 	const int args = lua_gettop(L); // number of arguments
 	if (args == 1) {
 		if (lua_isboolean(L, 1)) {
 			if (lua_toboolean(L, 1)) {
-				glEnable(GL_BLEND);
+				stateCache.Enable(GL_BLEND);
 			} else {
-				glDisable(GL_BLEND);
+				stateCache.Disable(GL_BLEND);
 			}
 		}
 		else if (lua_israwstring(L, 1)) {
 			switch (hashString(lua_tostring(L, 1))) {
 				case hashString("add"): {
-					glBlendFunc(GL_ONE, GL_ONE);
-					glEnable(GL_BLEND);
+					stateCache.BlendFunc(GL_ONE, GL_ONE);
+					stateCache.Enable(GL_BLEND);
 				} break;
 				case hashString("alpha_add"): {
-					glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-					glEnable(GL_BLEND);
+					stateCache.BlendFunc(GL_SRC_ALPHA, GL_ONE);
+					stateCache.Enable(GL_BLEND);
 				} break;
 
 				case hashString("alpha"):
 				case hashString("reset"): {
-					glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-					glEnable(GL_BLEND);
+					stateCache.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+					stateCache.Enable(GL_BLEND);
 				} break;
 				case hashString("color"): {
-					glBlendFunc(GL_SRC_COLOR, GL_ONE_MINUS_SRC_COLOR);
-					glEnable(GL_BLEND);
+					stateCache.BlendFunc(GL_SRC_COLOR, GL_ONE_MINUS_SRC_COLOR);
+					stateCache.Enable(GL_BLEND);
 				} break;
 				case hashString("modulate"): {
-					glBlendFunc(GL_DST_COLOR, GL_ZERO);
-					glEnable(GL_BLEND);
+					stateCache.BlendFunc(GL_DST_COLOR, GL_ZERO);
+					stateCache.Enable(GL_BLEND);
 				} break;
 				case hashString("disable"): {
-					glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-					glDisable(GL_BLEND);
+					stateCache.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+					stateCache.Disable(GL_BLEND);
 				} break;
 				default: {
 				} break;
@@ -2879,8 +2898,8 @@ int LuaOpenGL::Blending(lua_State* L)
 	else if (args == 2) {
 		const GLenum src = (GLenum)luaL_checkint(L, 1);
 		const GLenum dst = (GLenum)luaL_checkint(L, 2);
-		glBlendFunc(src, dst);
-		glEnable(GL_BLEND);
+		stateCache.BlendFunc(src, dst);
+		stateCache.Enable(GL_BLEND);
 	}
 	else {
 		luaL_error(L, "Incorrect arguments to gl.Blending()");
@@ -2933,19 +2952,21 @@ int LuaOpenGL::BlendFuncSeparate(lua_State* L)
 
 int LuaOpenGL::AlphaTest(lua_State* L)
 {
-	CheckDrawingEnabled(L, __func__);
+	CheckCachedDrawingEnabled(L, __func__);
+
+	GL::StateCache& stateCache = GL::StateCache::GetInstance();
 	CondWarnDeprecatedGL(L, __func__);
 
 	const int args = lua_gettop(L); // number of arguments
 	if (args == 1) {
 		if (luaL_checkboolean(L, 1)) {
-			glEnable(GL_ALPHA_TEST);
+			stateCache.Enable(GL_ALPHA_TEST);
 		} else {
-			glDisable(GL_ALPHA_TEST);
+			stateCache.Disable(GL_ALPHA_TEST);
 		}
 	}
 	else if (args == 2) {
-		glEnable(GL_ALPHA_TEST);
+		stateCache.Enable(GL_ALPHA_TEST);
 		glAlphaFunc((GLenum)luaL_checkint(L, 1), (GLfloat)luaL_checkint(L, 2));
 	}
 	else {
@@ -4798,6 +4819,9 @@ int LuaOpenGL::CreateList(lua_State* L)
 	SetDrawingEnabled(L, true);
 
 	// build the list with the specified lua call/args
+	// lists must record every call, and compiling one does not execute them
+	const bool cacheActive = GL::StateCache::GetInstance().Activate(false);
+
 	glNewList(list, GL_COMPILE);
 	SMatrixStateData prevMSD = GetLuaContextData(L)->glMatrixTracker.PushMatrixState(true);
 	const int error = lua_pcall(L, (args - 1), 0, 0);
@@ -4805,6 +4829,8 @@ int LuaOpenGL::CreateList(lua_State* L)
 	GetLuaContextData(L)->glMatrixTracker.PopMatrixState(prevMSD, false);
 	glEndList();
 
+	GL::StateCache::GetInstance().Activate(cacheActive);
+
 	if (error != 0) {
 		glDeleteLists(list, 1);
 		LOG_L(L_ERROR, "gl.CreateList: error(%i) = %s",
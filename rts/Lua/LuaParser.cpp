@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <cstring>
 
 #include "lib/streflop/streflop_cond.h"
 
@@ -288,6 +289,313 @@ bool LuaParser::Execute()
 }
 
 
+/******************************************************************************/
+//
+//  Serialized tables
+//
+
+enum {
+	BLOB_FALSE    = 0,
+	BLOB_TRUE     = 1,
+	BLOB_NUMBER   = 2,
+	BLOB_STRING   = 3,
+	BLOB_TABLE    = 4, // followed by the entry count, then alternating keys and values
+	BLOB_TABLEREF = 5, // index of an earlier table; shared subtables stay shared, cycles work
+};
+
+static constexpr int MAX_BLOB_DEPTH = 256;
+
+struct BlobKey {
+	bool operator < (const BlobKey& k) const {
+		if (type != k.type)
+			return (type < k.type);
+		if (type != LUA_TSTRING)
+			return (num < k.num);
+
+		return (str < k.str);
+	}
+
+	int type;
+	lua_Number num;
+	std::string str;
+};
+
+struct BlobWriter {
+	void PutByte(std::uint8_t b) { blob.push_back(b); }
+
+	template<typename T> void Put(const T& v) {
+		const std::uint8_t* p = reinterpret_cast<const std::uint8_t*>(&v);
+		blob.insert(blob.end(), p, p + sizeof(T));
+	}
+
+	bool PutValue(lua_State* L, int index, int depth);
+	bool PutTable(lua_State* L, int index, int depth);
+
+	std::vector<std::uint8_t>& blob;
+	spring::unordered_map<const void*, std::uint32_t> tables;
+};
+
+struct BlobReader {
+	template<typename T> bool Get(T& v) {
+		if ((pos + sizeof(T)) > blob.size())
+			return false;
+
+		std::memcpy(&v, &blob[pos], sizeof(T));
+		pos += sizeof(T);
+		return true;
+	}
+
+	bool PushValue(lua_State* L, int depth);
+
+	const std::vector<std::uint8_t>& blob;
+	size_t pos;
+
+	// stack index of the id-to-table lookup for BLOB_TABLEREF
+	int tablesIdx;
+	std::uint32_t numTables;
+};
+
+
+bool BlobWriter::PutValue(lua_State* L, int index, int depth)
+{
+	switch (lua_type(L, index)) {
+		case LUA_TBOOLEAN: {
+			PutByte(lua_toboolean(L, index)? BLOB_TRUE: BLOB_FALSE);
+			return true;
+		} break;
+		case LUA_TNUMBER: {
+			PutByte(BLOB_NUMBER);
+			Put(lua_tonumber(L, index));
+			return true;
+		} break;
+		case LUA_TSTRING: {
+			size_t len = 0;
+			const char* str = lua_tolstring(L, index, &len);
+
+			PutByte(BLOB_STRING);
+			Put(std::uint32_t(len));
+			blob.insert(blob.end(), str, str + len);
+			return true;
+		} break;
+		case LUA_TTABLE: {
+			return (PutTable(L, index, depth + 1));
+		} break;
+		default: {
+		} break;
+	}
+
+	return false;
+}
+
+bool BlobWriter::PutTable(lua_State* L, int index, int depth)
+{
+	const void* ptr = lua_topointer(L, index);
+	const auto it = tables.find(ptr);
+
+	if (it != tables.end()) {
+		PutByte(BLOB_TABLEREF);
+		Put(it->second);
+		return true;
+	}
+
+	if (depth > MAX_BLOB_DEPTH || !lua_checkstack(L, 4))
+		return false;
+
+	if (lua_getmetatable(L, index)) {
+		lua_pop(L, 1);
+		return false;
+	}
+
+	std::vector<BlobKey> keys;
+
+	for (lua_pushnil(L); lua_next(L, index) != 0; lua_pop(L, 1)) {
+		switch (lua_type(L, -2)) {
+			case LUA_TBOOLEAN: { keys.push_back({LUA_TBOOLEAN, lua_Number(lua_toboolean(L, -2)), {}}); } break;
+			case LUA_TNUMBER : { keys.push_back({LUA_TNUMBER, lua_tonumber(L, -2), {}}); } break;
+			case LUA_TSTRING : {
+				size_t len = 0;
+				const char* str = lua_tolstring(L, -2, &len);
+
+				keys.push_back({LUA_TSTRING, 0, std::string(str, len)});
+			} break;
+			default: {
+				lua_pop(L, 2);
+				return false;
+			} break;
+		}
+	}
+
+	// lua_next order depends on the insertion history, sorting makes the blob canonical
+	std::sort(keys.begin(), keys.end());
+
+	const std::uint32_t tableID = tables.size();
+
+	tables.emplace(ptr, tableID);
+
+	PutByte(BLOB_TABLE);
+	Put(std::uint32_t(keys.size()));
+
+	for (const BlobKey& key: keys) {
+		switch (key.type) {
+			case LUA_TBOOLEAN: { lua_pushboolean(L, key.num != 0); } break;
+			case LUA_TNUMBER : { lua_pushnumber(L, key.num); } break;
+			default          : { lua_pushlstring(L, key.str.data(), key.str.size()); } break;
+		}
+
+		const int keyIdx = lua_gettop(L);
+
+		lua_pushvalue(L, keyIdx);
+		lua_rawget(L, index);
+
+		const bool ret = (PutValue(L, keyIdx, depth) && PutValue(L, keyIdx + 1, depth));
+
+		lua_pop(L, 2);
+
+		if (!ret)
+			return false;
+	}
+
+	return true;
+}
+
+
+bool BlobReader::PushValue(lua_State* L, int depth)
+{
+	std::uint8_t type = 0;
+
+	if (!Get(type) || !lua_checkstack(L, 4))
+		return false;
+
+	switch (type) {
+		case BLOB_FALSE:
+		case BLOB_TRUE: {
+			lua_pushboolean(L, type == BLOB_TRUE);
+			return true;
+		} break;
+		case BLOB_NUMBER: {
+			lua_Number num = 0;
+
+			if (!Get(num))
+				return false;
+
+			lua_pushnumber(L, num);
+			return true;
+		} break;
+		case BLOB_STRING: {
+			std::uint32_t len = 0;
+
+			if (!Get(len) || len > (blob.size() - pos))
+				return false;
+
+			lua_pushlstring(L, reinterpret_cast<const char*>(blob.data() + pos), len);
+			pos += len;
+			return true;
+		} break;
+		case BLOB_TABLEREF: {
+			std::uint32_t tableID = 0;
+
+			if (!Get(tableID) || tableID >= numTables)
+				return false;
+
+			lua_rawgeti(L, tablesIdx, tableID + 1);
+			return true;
+		} break;
+		case BLOB_TABLE: {
+			std::uint32_t numEntries = 0;
+
+			if (!Get(numEntries) || depth > MAX_BLOB_DEPTH)
+				return false;
+
+			lua_createtable(L, 0, std::min(numEntries, 1u << 16));
+			lua_pushvalue(L, -1);
+			lua_rawseti(L, tablesIdx, ++numTables);
+
+			for (std::uint32_t i = 0; i < numEntries; i++) {
+				if (!PushValue(L, depth + 1) || lua_isnil(L, -1))
+					return false;
+				// rawset would raise an error
+				if (lua_type(L, -1) == LUA_TNUMBER && math::isnan(lua_tonumber(L, -1)))
+					return false;
+				if (!PushValue(L, depth + 1))
+					return false;
+
+				lua_rawset(L, -3);
+			}
+
+			return true;
+		} break;
+		default: {
+		} break;
+	}
+
+	return false;
+}
+
+
+bool LuaParser::SerializeRoot(std::vector<std::uint8_t>& blob)
+{
+	if (!IsValid() || rootRef == LUA_NOREF)
+		return false;
+
+	BlobWriter writer{blob, {}};
+
+	blob.clear();
+	lua_rawgeti(L, LUA_REGISTRYINDEX, rootRef);
+
+	const bool ret = writer.PutValue(L, lua_gettop(L), 0);
+
+	lua_pop(L, 1);
+	return ret;
+}
+
+bool LuaParser::SerializeGlobal(const std::string& name, std::vector<std::uint8_t>& blob)
+{
+	if (!IsValid())
+		return false;
+
+	BlobWriter writer{blob, {}};
+
+	blob.clear();
+	lua_getfield(L, LUA_GLOBALSINDEX, name.c_str());
+
+	const bool ret = writer.PutValue(L, lua_gettop(L), 0);
+
+	lua_pop(L, 1);
+	return ret;
+}
+
+bool LuaParser::ExecuteSerialized(const std::vector<std::uint8_t>& blob)
+{
+	if (!IsValid()) {
+		errorLog = "could not initialize Lua library";
+		return false;
+	}
+
+	assert(rootRef == LUA_NOREF);
+	assert(initDepth == 0);
+
+	const int top = lua_gettop(L);
+
+	lua_newtable(L);
+
+	BlobReader reader{blob, 0, lua_gettop(L), 0};
+
+	// leave the parser as it was on failure, so Execute can still be called
+	if (!reader.PushValue(L, 0) || !lua_istable(L, -1) || reader.pos != blob.size()) {
+		lua_settop(L, top);
+
+		errorLog = "invalid serialized table";
+		return false;
+	}
+
+	initDepth = -1;
+	rootRef = luaL_ref(L, LUA_REGISTRYINDEX);
+	lua_settop(L, 0);
+
+	return (valid = true);
+}
+
+
 void LuaParser::AddTable(LuaTable* tbl) { spring::VectorInsertUnique(tables, tbl); }
 void LuaParser::RemoveTable(LuaTable* tbl) { spring::VectorErase(tables, tbl); }
 
@@ -735,6 +1043,151 @@ int LuaParser::DontMessWithMyCase(lua_State* L)
 }
 
 
+/******************************************************************************/
+/******************************************************************************/
+//
+//  Detached tables
+//
+
+// a value with the results of all lua_to* coercions the getters use
+struct LuaTableValue {
+	std::string str;
+	std::shared_ptr<const LuaTableData> table;
+
+	lua_Number number = 0;
+	int integer = 0;
+	int length = 0;
+	int type = LUA_TNIL;
+
+	bool isNumber = false;
+	bool isString = false;
+	bool boolean = false;
+};
+
+struct LuaTableData {
+	struct NumEntry {
+		lua_Number key;
+		int intKey; // lua_toint(key)
+		LuaTableValue value;
+	};
+	struct StrEntry {
+		std::string key;
+		LuaTableValue value;
+	};
+
+	const LuaTableValue* Find(lua_Number key) const {
+		const auto pred = [](const NumEntry& e, lua_Number k) { return (e.key < k); };
+		const auto iter = std::lower_bound(numEntries.begin(), numEntries.end(), key, pred);
+
+		if (iter == numEntries.end() || iter->key != key)
+			return nullptr;
+
+		return &iter->value;
+	}
+
+	const LuaTableValue* Find(const std::string& key) const {
+		const auto pred = [](const StrEntry& e, const std::string& k) { return (e.key < k); };
+		const auto iter = std::lower_bound(strEntries.begin(), strEntries.end(), key, pred);
+
+		if (iter == strEntries.end() || iter->key != key)
+			return nullptr;
+
+		return &iter->value;
+	}
+
+	// both sorted by key
+	std::vector<NumEntry> numEntries;
+	std::vector<StrEntry> strEntries;
+
+	int length = 0;
+	bool lowerCppKeys = false;
+};
+
+
+// maps Lua tables to their copies; null while a copy is still in progress
+typedef spring::unsynced_map<const void*, std::shared_ptr<const LuaTableData>> DetachedTables;
+
+static std::shared_ptr<const LuaTableData> DetachTable(lua_State* L, int table, bool lowerCppKeys, DetachedTables& tables);
+
+static bool DetachValue(lua_State* L, int index, bool lowerCppKeys, DetachedTables& tables, LuaTableValue& value)
+{
+	value.type = lua_type(L, index);
+	value.number = lua_tonumber(L, index);
+	value.integer = lua_toint(L, index);
+	value.isNumber = lua_isnumber(L, index);
+	value.isString = lua_isstring(L, index);
+	value.boolean = lua_toboolean(L, index);
+
+	if (value.type == LUA_TTABLE) {
+		value.length = lua_objlen(L, index);
+		return ((value.table = DetachTable(L, index, lowerCppKeys, tables)) != nullptr);
+	}
+
+	if (value.isString) {
+		// both convert numbers in-place, which would confuse lua_next
+		lua_pushvalue(L, index);
+		value.str = lua_tostring(L, -1);
+		value.length = lua_objlen(L, -1);
+		lua_pop(L, 1);
+	}
+
+	return true;
+}
+
+static std::shared_ptr<const LuaTableData> DetachTable(lua_State* L, int table, bool lowerCppKeys, DetachedTables& tables)
+{
+	const void* ptr = lua_topointer(L, table);
+	const auto iter = tables.find(ptr);
+
+	// shared subtables are only copied once, cycles can not be copied at all
+	if (iter != tables.end())
+		return iter->second;
+
+	tables[ptr] = nullptr;
+
+	// lua_gettable respects __index, lua_next does not
+	if (lua_getmetatable(L, table)) {
+		lua_pop(L, 1);
+		return nullptr;
+	}
+
+	if (!lua_checkstack(L, 4))
+		return nullptr;
+
+	std::shared_ptr<LuaTableData> data = std::make_shared<LuaTableData>();
+
+	data->length = lua_objlen(L, table);
+	data->lowerCppKeys = lowerCppKeys;
+
+	for (lua_pushnil(L); lua_next(L, table) != 0; lua_pop(L, 1)) {
+		LuaTableValue value;
+
+		if (!DetachValue(L, lua_gettop(L), lowerCppKeys, tables, value)) {
+			lua_pop(L, 2);
+			return nullptr;
+		}
+
+		if (lua_israwnumber(L, -2)) {
+			data->numEntries.push_back({lua_tonumber(L, -2), lua_toint(L, -2), std::move(value)});
+			continue;
+		}
+		if (lua_israwstring(L, -2)) {
+			size_t len = 0;
+			const char* key = lua_tolstring(L, -2, &len);
+
+			data->strEntries.push_back({std::string(key, len), std::move(value)});
+			continue;
+		}
+	}
+
+	std::sort(data->numEntries.begin(), data->numEntries.end(), [](const LuaTableData::NumEntry& a, const LuaTableData::NumEntry& b) { return (a.key < b.key); });
+	std::sort(data->strEntries.begin(), data->strEntries.end(), [](const LuaTableData::StrEntry& a, const LuaTableData::StrEntry& b) { return (a.key < b.key); });
+
+	tables[ptr] = data;
+	return data;
+}
+
+
 /******************************************************************************/
 /******************************************************************************/
 //
@@ -778,6 +1231,7 @@ LuaTable::LuaTable(const LuaTable& tbl)
 	parser = tbl.parser;
 	L      = tbl.L;
 	path   = tbl.path;
+	tableData = tbl.tableData;
 
 	if (parser != nullptr)
 		parser->AddTable(this);
@@ -814,6 +1268,7 @@ LuaTable& LuaTable::operator=(const LuaTable& tbl)
 
 	L    = tbl.L;
 	path = tbl.path;
+	tableData = tbl.tableData;
 
 	if (tbl.PushTable()) {
 		lua_pushvalue(L, -1); // copy
@@ -835,6 +1290,15 @@ LuaTable LuaTable::SubTable(int key) const
 	SNPRINTF(buf, 32, "[%i]", key);
 	subTable.path = path + buf;
 
+	if (tableData != nullptr) {
+		const LuaTableValue* value = FindValue(key);
+
+		if (value != nullptr)
+			subTable.tableData = value->table;
+
+		return subTable;
+	}
+
 	if (!PushTable())
 		return subTable;
 
@@ -857,11 +1321,21 @@ LuaTable LuaTable::SubTable(int key) const
 
 LuaTable LuaTable::SubTable(const std::string& mixedKey) const
 {
-	const std::string key = !((parser != nullptr)? parser->lowerCppKeys : true) ? mixedKey : StringToLower(mixedKey);
+	const bool lowerKeys = (tableData != nullptr)? tableData->lowerCppKeys: ((parser != nullptr)? parser->lowerCppKeys : true);
+	const std::string key = !lowerKeys ? mixedKey : StringToLower(mixedKey);
 
 	LuaTable subTable;
 	subTable.path = path + "." + key;
 
+	if (tableData != nullptr) {
+		const LuaTableValue* value = tableData->Find(key);
+
+		if (value != nullptr)
+			subTable.tableData = value->table;
+
+		return subTable;
+	}
+
 	if (!PushTable())
 		return subTable;
 
@@ -887,7 +1361,7 @@ LuaTable LuaTable::SubTableExpr(const std::string& expr) const
 	if (expr.empty())
 		return LuaTable(*this);
 
-	if (!isValid)
+	if (!isValid && tableData == nullptr)
 		return LuaTable();
 
 	std::string::size_type endPos;
@@ -1065,6 +1539,70 @@ bool LuaTable::PushValue(const std::string& mixedKey) const
 }
 
 
+LuaTable LuaTable::Detach() const
+{
+	if (tableData != nullptr || !PushTable())
+		return *this;
+
+	DetachedTables tables;
+	LuaTable detached;
+
+	if ((detached.tableData = DetachTable(L, lua_gettop(L), parser->lowerCppKeys, tables)) == nullptr)
+		return *this;
+
+	detached.path = path;
+	return detached;
+}
+
+
+const LuaTableValue* LuaTable::FindValue(int key) const
+{
+	return (tableData->Find(lua_Number(key)));
+}
+
+
+const LuaTableValue* LuaTable::FindValue(const std::string& mixedKey) const
+{
+	const std::string key = !tableData->lowerCppKeys ? mixedKey : StringToLower(mixedKey);
+
+	if (key.find('.') == std::string::npos)
+		return (tableData->Find(key));
+
+	// nested key, resolved exactly like PushValue does
+	const LuaTableData* table = tableData.get();
+	const LuaTableValue* value = nullptr;
+
+	size_t lastpos = 0;
+	size_t dotpos = key.find('.');
+
+	do {
+		const std::string subTableName = key.substr(lastpos, dotpos);
+		lastpos = dotpos + 1;
+		dotpos = key.find('.', lastpos);
+
+		if ((value = table->Find(subTableName)) == nullptr || value->table == nullptr)
+			return nullptr;
+
+		table = value->table.get();
+	} while (dotpos != std::string::npos);
+
+	const std::string keyname = key.substr(lastpos);
+
+	// try as string
+	if ((value = table->Find(keyname)) != nullptr)
+		return value;
+
+	// try as integer
+	bool failed;
+	int i = StringToInt(keyname, &failed);
+
+	if (failed)
+		return nullptr;
+
+	return (table->Find(lua_Number(i)));
+}
+
+
 /******************************************************************************/
 /******************************************************************************/
 //
@@ -1073,6 +1611,9 @@ bool LuaTable::PushValue(const std::string& mixedKey) const
 
 bool LuaTable::KeyExists(int key) const
 {
+	if (tableData != nullptr)
+		return (FindValue(key) != nullptr);
+
 	if (!PushValue(key))
 		return false;
 
@@ -1083,6 +1624,9 @@ bool LuaTable::KeyExists(int key) const
 
 bool LuaTable::KeyExists(const std::string& key) const
 {
+	if (tableData != nullptr)
+		return (FindValue(key) != nullptr);
+
 	if (!PushValue(key))
 		return false;
 
@@ -1097,39 +1641,49 @@ bool LuaTable::KeyExists(const std::string& key) const
 //  Value types
 //
 
+static LuaTable::DataType GetDataType(int type)
+{
+	switch (type) {
+		case LUA_TBOOLEAN: return LuaTable::BOOLEAN;
+		case LUA_TNUMBER:  return LuaTable::NUMBER;
+		case LUA_TSTRING:  return LuaTable::STRING;
+		case LUA_TTABLE:   return LuaTable::TABLE;
+		default:           return LuaTable::NIL;
+	}
+}
+
+
 LuaTable::DataType LuaTable::GetType(int key) const
 {
+	if (tableData != nullptr) {
+		const LuaTableValue* value = FindValue(key);
+		return ((value != nullptr)? GetDataType(value->type): NIL);
+	}
+
 	if (!PushValue(key))
 		return NIL;
 
 	const int type = lua_type(L, -1);
 	lua_pop(L, 1);
 
-	switch (type) {
-		case LUA_TBOOLEAN: return BOOLEAN;
-		case LUA_TNUMBER:  return NUMBER;
-		case LUA_TSTRING:  return STRING;
-		case LUA_TTABLE:   return TABLE;
-		default:           return NIL;
-	}
+	return (GetDataType(type));
 }
 
 
 LuaTable::DataType LuaTable::GetType(const std::string& key) const
 {
+	if (tableData != nullptr) {
+		const LuaTableValue* value = FindValue(key);
+		return ((value != nullptr)? GetDataType(value->type): NIL);
+	}
+
 	if (!PushValue(key))
 		return NIL;
 
 	const int type = lua_type(L, -1);
 	lua_pop(L, 1);
 
-	switch (type) {
-		case LUA_TBOOLEAN: return BOOLEAN;
-		case LUA_TNUMBER:  return NUMBER;
-		case LUA_TSTRING:  return STRING;
-		case LUA_TTABLE:   return TABLE;
-		default:           return NIL;
-	}
+	return (GetDataType(type));
 }
 
 
@@ -1141,6 +1695,9 @@ LuaTable::DataType LuaTable::GetType(const std::string& key) const
 
 int LuaTable::GetLength() const
 {
+	if (tableData != nullptr)
+		return tableData->length;
+
 	if (!PushTable())
 		return 0;
 
@@ -1150,6 +1707,11 @@ int LuaTable::GetLength() const
 
 int LuaTable::GetLength(int key) const
 {
+	if (tableData != nullptr) {
+		const LuaTableValue* value = FindValue(key);
+		return ((value != nullptr)? value->length: 0);
+	}
+
 	if (!PushValue(key))
 		return 0;
 
@@ -1161,6 +1723,11 @@ int LuaTable::GetLength(int key) const
 
 int LuaTable::GetLength(const std::string& key) const
 {
+	if (tableData != nullptr) {
+		const LuaTableValue* value = FindValue(key);
+		return ((value != nullptr)? value->length: 0);
+	}
+
 	if (!PushValue(key))
 		return 0;
 
@@ -1176,8 +1743,24 @@ int LuaTable::GetLength(const std::string& key) const
 //  Key list functions
 //
 
+template<typename P> static bool SortPairs(std::vector<P>& data)
+{
+	std::stable_sort(data.begin(), data.end(), [](const P& a, const P& b) { return (a.first < b.first); });
+	return true;
+}
+
+
 bool LuaTable::GetKeys(std::vector<int>& data) const
 {
+	if (tableData != nullptr) {
+		for (const auto& e: tableData->numEntries) {
+			data.push_back(e.intKey);
+		}
+
+		std::stable_sort(data.begin(), data.end());
+		return true;
+	}
+
 	if (!PushTable())
 		return false;
 
@@ -1195,6 +1778,15 @@ bool LuaTable::GetKeys(std::vector<int>& data) const
 
 bool LuaTable::GetKeys(std::vector<std::string>& data) const
 {
+	if (tableData != nullptr) {
+		for (const auto& e: tableData->strEntries) {
+			data.emplace_back(e.key.c_str());
+		}
+
+		std::stable_sort(data.begin(), data.end());
+		return true;
+	}
+
 	if (!PushTable())
 		return false;
 
@@ -1213,6 +1805,15 @@ bool LuaTable::GetKeys(std::vector<std::string>& data) const
 
 bool LuaTable::GetPairs(std::vector<std::pair<int, std::string>>& data) const
 {
+	if (tableData != nullptr) {
+		for (const auto& e: tableData->numEntries) {
+			if (e.value.isString)
+				data.emplace_back(e.intKey, e.value.str);
+		}
+
+		return (SortPairs(data));
+	}
+
 	if (!PushTable())
 		return false;
 
@@ -1232,15 +1833,20 @@ bool LuaTable::GetPairs(std::vector<std::pair<int, std::string>>& data) const
 		}
 	}
 
-	using T = std::remove_reference<decltype(data)>::type;
-	using P = T::value_type;
-
-	std::stable_sort(data.begin(), data.end(), [](const P& a, const P& b) { return (a.first < b.first); });
-	return true;
+	return (SortPairs(data));
 }
 
 bool LuaTable::GetPairs(std::vector<std::pair<std::string, float>>& data) const
 {
+	if (tableData != nullptr) {
+		for (const auto& e: tableData->strEntries) {
+			if (e.value.isNumber)
+				data.emplace_back(e.key.c_str(), e.value.number);
+		}
+
+		return (SortPairs(data));
+	}
+
 	if (!PushTable())
 		return false;
 
@@ -1253,15 +1859,26 @@ bool LuaTable::GetPairs(std::vector<std::pair<std::string, float>>& data) const
 		data.emplace_back(lua_tostring(L, -2), lua_tonumber(L, -1));
 	}
 
-	using T = std::remove_reference<decltype(data)>::type;
-	using P = T::value_type;
-
-	std::stable_sort(data.begin(), data.end(), [](const P& a, const P& b) { return (a.first < b.first); });
-	return true;
+	return (SortPairs(data));
 }
 
 bool LuaTable::GetPairs(std::vector<std::pair<std::string, std::string>>& data) const
 {
+	if (tableData != nullptr) {
+		for (const auto& e: tableData->strEntries) {
+			if (e.value.isString) {
+				data.emplace_back(e.key.c_str(), e.value.str);
+				continue;
+			}
+			if (e.value.type == LUA_TBOOLEAN) {
+				data.emplace_back(e.key.c_str(), e.value.boolean ? "1" : "0");
+				continue;
+			}
+		}
+
+		return (SortPairs(data));
+	}
+
 	if (!PushTable())
 		return false;
 
@@ -1281,11 +1898,7 @@ bool LuaTable::GetPairs(std::vector<std::pair<std::string, std::string>>& data)
 		}
 	}
 
-	using T = std::remove_reference<decltype(data)>::type;
-	using P = T::value_type;
-
-	std::stable_sort(data.begin(), data.end(), [](const P& a, const P& b) { return (a.first < b.first); });
-	return true;
+	return (SortPairs(data));
 }
 
 
@@ -1297,6 +1910,15 @@ bool LuaTable::GetPairs(std::vector<std::pair<std::string, std::string>>& data)
 
 bool LuaTable::GetMap(spring::unordered_map<int, float>& data) const
 {
+	if (tableData != nullptr) {
+		for (const auto& e: tableData->numEntries) {
+			if (e.value.isNumber)
+				data[e.intKey] = e.value.number;
+		}
+
+		return true;
+	}
+
 	if (!PushTable())
 		return false;
 
@@ -1314,6 +1936,15 @@ bool LuaTable::GetMap(spring::unordered_map<int, float>& data) const
 
 bool LuaTable::GetMap(spring::unordered_map<int, std::string>& data) const
 {
+	if (tableData != nullptr) {
+		for (const auto& e: tableData->numEntries) {
+			if (e.value.isString)
+				data[e.intKey] = e.value.str;
+		}
+
+		return true;
+	}
+
 	if (!PushTable())
 		return false;
 
@@ -1338,6 +1969,15 @@ bool LuaTable::GetMap(spring::unordered_map<int, std::string>& data) const
 
 bool LuaTable::GetMap(spring::unordered_map<std::string, float>& data) const
 {
+	if (tableData != nullptr) {
+		for (const auto& e: tableData->strEntries) {
+			if (e.value.isNumber)
+				data[e.key.c_str()] = e.value.number;
+		}
+
+		return true;
+	}
+
 	if (!PushTable())
 		return false;
 
@@ -1355,6 +1995,21 @@ bool LuaTable::GetMap(spring::unordered_map<std::string, float>& data) const
 
 bool LuaTable::GetMap(spring::unordered_map<std::string, std::string>& data) const
 {
+	if (tableData != nullptr) {
+		for (const auto& e: tableData->strEntries) {
+			if (e.value.isString) {
+				data[e.key.c_str()] = e.value.str;
+				continue;
+			}
+			if (e.value.type == LUA_TBOOLEAN) {
+				data[e.key.c_str()] = e.value.boolean ? "1" : "0";
+				continue;
+			}
+		}
+
+		return true;
+	}
+
 	if (!PushTable())
 		return false;
 
@@ -1463,6 +2118,125 @@ static bool ParseBoolean(lua_State* L, int index, bool& value)
 }
 
 
+// detached equivalents of the above, plus the coercions done by the getters
+static bool ParseTableFloat(const LuaTableData* table, int index, float& value)
+{
+	const LuaTableValue* v = table->Find(lua_Number(index));
+
+	value = (v != nullptr)? v->number: 0.0f;
+	return (value != 0.0f || (v != nullptr && (v->isNumber || v->isString)));
+}
+
+static bool ParseFloat3(const LuaTableValue& v, float3& value)
+{
+	if (v.type == LUA_TTABLE)
+		return (ParseTableFloat(v.table.get(), 1, value.x) && ParseTableFloat(v.table.get(), 2, value.y) && ParseTableFloat(v.table.get(), 3, value.z));
+
+	if (v.isString)
+		return (sscanf(v.str.c_str(), "%f %f %f", &value.x, &value.y, &value.z) == 3);
+
+	return false;
+}
+
+static bool ParseFloat4(const LuaTableValue& v, float4& value)
+{
+	if (v.type == LUA_TTABLE) {
+		return (ParseTableFloat(v.table.get(), 1, value.x) && ParseTableFloat(v.table.get(), 2, value.y) &&
+		        ParseTableFloat(v.table.get(), 3, value.z) && ParseTableFloat(v.table.get(), 4, value.w));
+	}
+
+	if (v.isString)
+		return (sscanf(v.str.c_str(), "%f %f %f %f", &value.x, &value.y, &value.z, &value.w) == 4);
+
+	return false;
+}
+
+static bool ParseBoolean(const LuaTableValue& v, bool& value)
+{
+	if (v.type == LUA_TBOOLEAN) {
+		value = v.boolean;
+		return true;
+	}
+	if (v.isNumber) {
+		value = (v.number != 0.0f);
+		return true;
+	}
+	if (v.isString) {
+		const std::string str = StringToLower(v.str);
+
+		if ((str == "1") || (str == "true")) {
+			value = true;
+			return true;
+		}
+		if ((str == "0") || (str == "false")) {
+			value = false;
+			return true;
+		}
+	}
+	return false;
+}
+
+
+static int GetValue(const LuaTableValue* v, int def)
+{
+	if (v == nullptr || (v->integer == 0 && !v->isNumber && !v->isString))
+		return def;
+
+	return v->integer;
+}
+
+static bool GetValue(const LuaTableValue* v, bool def)
+{
+	bool value;
+
+	if (v == nullptr || !ParseBoolean(*v, value))
+		return def;
+
+	return value;
+}
+
+static float GetValue(const LuaTableValue* v, float def)
+{
+	if (v == nullptr)
+		return def;
+
+	const float value = v->number;
+
+	if (value == 0.0f && !v->isNumber && !v->isString)
+		return def;
+
+	return value;
+}
+
+static float3 GetValue(const LuaTableValue* v, const float3& def)
+{
+	float3 value;
+
+	if (v == nullptr || !ParseFloat3(*v, value))
+		return def;
+
+	return value;
+}
+
+static float4 GetValue(const LuaTableValue* v, const float4& def)
+{
+	float4 value;
+
+	if (v == nullptr || !ParseFloat4(*v, value))
+		return def;
+
+	return value;
+}
+
+static std::string GetValue(const LuaTableValue* v, const std::string& def)
+{
+	if (v == nullptr || !v->isString)
+		return def;
+
+	return v->str;
+}
+
+
 /******************************************************************************/
 /******************************************************************************/
 //
@@ -1471,6 +2245,9 @@ static bool ParseBoolean(lua_State* L, int index, bool& value)
 
 int LuaTable::Get(const std::string& key, int def) const
 {
+	if (tableData != nullptr)
+		return (GetValue(FindValue(key), def));
+
 	if (!PushValue(key))
 		return def;
 
@@ -1486,6 +2263,9 @@ int LuaTable::Get(const std::string& key, int def) const
 
 bool LuaTable::Get(const std::string& key, bool def) const
 {
+	if (tableData != nullptr)
+		return (GetValue(FindValue(key), def));
+
 	if (!PushValue(key))
 		return def;
 
@@ -1501,6 +2281,9 @@ bool LuaTable::Get(const std::string& key, bool def) const
 
 float LuaTable::Get(const std::string& key, float def) const
 {
+	if (tableData != nullptr)
+		return (GetValue(FindValue(key), def));
+
 	if (!PushValue(key))
 		return def;
 
@@ -1517,6 +2300,9 @@ float LuaTable::Get(const std::string& key, float def) const
 
 float3 LuaTable::Get(const std::string& key, const float3& def) const
 {
+	if (tableData != nullptr)
+		return (GetValue(FindValue(key), def));
+
 	if (!PushValue(key))
 		return def;
 
@@ -1531,6 +2317,9 @@ float3 LuaTable::Get(const std::string& key, const float3& def) const
 
 float4 LuaTable::Get(const std::string& key, const float4& def) const
 {
+	if (tableData != nullptr)
+		return (GetValue(FindValue(key), def));
+
 	if (!PushValue(key))
 		return def;
 
@@ -1547,6 +2336,9 @@ float4 LuaTable::Get(const std::string& key, const float4& def) const
 
 std::string LuaTable::Get(const std::string& key, const std::string& def) const
 {
+	if (tableData != nullptr)
+		return (GetValue(FindValue(key), def));
+
 	if (!PushValue(key))
 		return def;
 
@@ -1568,6 +2360,9 @@ std::string LuaTable::Get(const std::string& key, const std::string& def) const
 
 int LuaTable::Get(int key, int def) const
 {
+	if (tableData != nullptr)
+		return (GetValue(FindValue(key), def));
+
 	if (!PushValue(key))
 		return def;
 
@@ -1583,6 +2378,9 @@ int LuaTable::Get(int key, int def) const
 
 bool LuaTable::Get(int key, bool def) const
 {
+	if (tableData != nullptr)
+		return (GetValue(FindValue(key), def));
+
 	if (!PushValue(key))
 		return def;
 
@@ -1598,6 +2396,9 @@ bool LuaTable::Get(int key, bool def) const
 
 float LuaTable::Get(int key, float def) const
 {
+	if (tableData != nullptr)
+		return (GetValue(FindValue(key), def));
+
 	if (!PushValue(key))
 		return def;
 
@@ -1614,6 +2415,9 @@ float LuaTable::Get(int key, float def) const
 
 float3 LuaTable::Get(int key, const float3& def) const
 {
+	if (tableData != nullptr)
+		return (GetValue(FindValue(key), def));
+
 	if (!PushValue(key))
 		return def;
 
@@ -1628,6 +2432,9 @@ float3 LuaTable::Get(int key, const float3& def) const
 
 float4 LuaTable::Get(int key, const float4& def) const
 {
+	if (tableData != nullptr)
+		return (GetValue(FindValue(key), def));
+
 	if (!PushValue(key)) {
 		return def;
 	}
@@ -1644,6 +2451,9 @@ float4 LuaTable::Get(int key, const float4& def) const
 
 std::string LuaTable::Get(int key, const std::string& def) const
 {
+	if (tableData != nullptr)
+		return (GetValue(FindValue(key), def));
+
 	if (!PushValue(key))
 		return def;
 
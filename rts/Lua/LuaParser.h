@@ -3,6 +3,8 @@
 #ifndef LUA_PARSER_H
 #define LUA_PARSER_H
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -15,6 +17,8 @@ class float3;
 struct float4;
 class LuaTable;
 class LuaParser;
+struct LuaTableData;
+struct LuaTableValue;
 struct lua_State;
 
 
@@ -33,7 +37,16 @@ public:
 	LuaTable SubTable(const std::string& key) const;
 	LuaTable SubTableExpr(const std::string& expr) const;
 
-	bool IsValid() const { return (parser != nullptr); }
+	/**
+	 * @return a copy of this table (and all of its subtables) that no longer
+	 *   refers to the parser's Lua state, so it can be read from any thread
+	 *   and outlive the parser; tables with metatables or cycles can not be
+	 *   copied faithfully, for those a regular reference is returned instead
+	 */
+	LuaTable Detach() const;
+
+	bool IsValid() const { return (parser != nullptr || tableData != nullptr); }
+	bool IsDetached() const { return (tableData != nullptr); }
 
 	const std::string& GetPath() const { return path; }
 
@@ -106,12 +119,18 @@ private:
 	bool PushValue(int key) const;
 	bool PushValue(const std::string& key) const;
 
+	const LuaTableValue* FindValue(int key) const;
+	const LuaTableValue* FindValue(const std::string& key) const;
+
 private:
 	std::string path;
 	mutable bool isValid;
 	LuaParser* parser;
 	lua_State* L;
 	int refnum;
+
+	// set iff detached, parser and L are null then
+	std::shared_ptr<const LuaTableData> tableData;
 };
 
 
@@ -132,6 +151,17 @@ public:
 	void SetupLua(bool isSyncedCtxt, bool isDefsParser);
 
 	bool Execute();
+	/**
+	 * For caching the result of Execute: write the root table (or a global
+	 * set up by SetupLua) as a self-contained blob with all keys in sorted
+	 * order, so equal tables always give equal blobs. Fails for values that
+	 * can not be restored, i.e. functions, userdata, metatables and keys
+	 * other than numbers, strings or booleans.
+	 */
+	bool SerializeRoot(std::vector<std::uint8_t>& blob);
+	bool SerializeGlobal(const std::string& name, std::vector<std::uint8_t>& blob);
+	// sets the root table from a blob instead of running any code
+	bool ExecuteSerialized(const std::vector<std::uint8_t>& blob);
 	bool IsValid() const { return (L != nullptr); } // true if nothing failed during Execute
 	bool NoTable() const { return (errorLog.find("no return table") == 0); } // parser is still valid if true
 
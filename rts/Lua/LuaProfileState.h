@@ -0,0 +1,80 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef SPRING_LUA_PROFILE_STATE_H
+#define SPRING_LUA_PROFILE_STATE_H
+
+#include <algorithm>
+#include <cinttypes>
+#include <string>
+#include <vector>
+
+#include "System/Misc/SpringTime.h"
+#include "System/UnorderedMap.hpp"
+
+// attributes run-time and allocations of a Lua state to tags; each callin
+// is tagged by its name and Lua code can switch to a finer-grained tag such
+// as the name of the gadget or widget it is about to call into
+struct SLuaProfileState {
+public:
+	struct Entry {
+		std::string name;
+
+		uint64_t runTime;    // usecs
+		uint64_t numAllocs;
+		uint64_t allocBytes; // growth only, frees are not subtracted
+	};
+
+	// tags are keyed by their Lua string-hash, collisions merge entries
+	int GetEntryIndex(uint32_t hash, const char* name) {
+		const auto iter = indices.find(hash);
+
+		if (iter != indices.end())
+			return iter->second;
+
+		indices[hash] = entries.size();
+		entries.push_back({name, 0, 0, 0});
+		return (entries.size() - 1);
+	}
+
+	// returns the index of the previously active entry (or -1)
+	int SetActiveEntry(int index) {
+		const spring_time curTime = spring_gettime();
+
+		if (activeEntry >= 0)
+			entries[activeEntry].runTime += (curTime - switchTime).toMicroSecsi();
+
+		switchTime = curTime;
+
+		std::swap(activeEntry, index);
+		return index;
+	}
+
+	void AddAlloc(size_t osize, size_t nsize) {
+		if (activeEntry < 0)
+			return;
+
+		entries[activeEntry].numAllocs += 1;
+		entries[activeEntry].allocBytes += ((nsize > osize)? (nsize - osize): 0);
+	}
+
+	void ResetEntries() {
+		for (Entry& e: entries) {
+			e.runTime = 0;
+			e.numAllocs = 0;
+			e.allocBytes = 0;
+		}
+	}
+
+	const std::vector<Entry>& GetEntries() const { return entries; }
+
+private:
+	std::vector<Entry> entries;
+	spring::unordered_map<uint32_t, int> indices;
+
+	int activeEntry = -1;
+
+	spring_time switchTime;
+};
+
+#endif
+
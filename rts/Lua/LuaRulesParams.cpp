@@ -2,6 +2,8 @@
 
 #include "LuaRulesParams.h"
 
+#include <algorithm>
+
 using namespace LuaRulesParams;
 
 CR_BIND(Param,)
@@ -10,3 +12,31 @@ CR_REG_METADATA(Param, (
 	CR_MEMBER(valueInt),
 	CR_MEMBER(valueString)
 ))
+
+
+ChangeLog LuaRulesParams::unitParamChanges;
+
+
+void ChangeLog::Add(int frame, int objectID, int los, const std::string& key)
+{
+	// forget whole frames, partially dropped ones could not be told apart
+	while (!changes.empty() && (changes.front().frame < (frame - MAX_LOGGED_FRAMES) || changes.size() >= MAX_LOGGED_CHANGES)) {
+		const int dropFrame = changes.front().frame;
+
+		while (!changes.empty() && changes.front().frame == dropFrame) {
+			changes.pop_front();
+		}
+
+		minFrame = std::max(minFrame, dropFrame);
+	}
+
+	changes.push_back({frame, objectID, los, key});
+}
+
+size_t ChangeLog::GetFirstChangeAfter(int sinceFrame) const
+{
+	const auto pred = [](int f, const Change& c) { return (f < c.frame); };
+	const auto iter = std::upper_bound(changes.begin(), changes.end(), sinceFrame, pred);
+
+	return (iter - changes.begin());
+}
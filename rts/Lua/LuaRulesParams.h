@@ -3,6 +3,7 @@
 #ifndef LUA_RULESPARAMS_H
 #define LUA_RULESPARAMS_H
 
+#include <deque>
 #include <string>
 
 #include "System/UnorderedMap.hpp"
@@ -36,6 +37,47 @@ namespace LuaRulesParams
 	};
 
 	typedef spring::unordered_map<std::string, Param> Params;
+
+
+	// remembers which params of which objects were set (or erased) during
+	// the last MAX_LOGGED_FRAMES sim-frames, so unsynced code can do work
+	// proportional to the number of changes instead of polling all objects
+	// not saved; after loading only changes made since then are known
+	class ChangeLog {
+	public:
+		struct Change {
+			int frame;
+			int objectID;
+			int los; // of the param when set, or when it was erased
+			std::string key;
+		};
+
+		static constexpr int MAX_LOGGED_FRAMES = 30 * 60;
+		static constexpr size_t MAX_LOGGED_CHANGES = 1 << 18;
+
+	public:
+		void Add(int frame, int objectID, int los, const std::string& key);
+		void Clear(int frame) {
+			changes.clear();
+			minFrame = frame;
+		}
+
+		// false if changes made after <sinceFrame> might have been dropped
+		bool HasChangesSince(int sinceFrame) const { return (sinceFrame >= minFrame); }
+
+		// index of the first change made after <sinceFrame>
+		size_t GetFirstChangeAfter(int sinceFrame) const;
+
+		const std::deque<Change>& GetChanges() const { return changes; }
+
+	private:
+		std::deque<Change> changes;
+
+		// every change made after this frame is (still) logged
+		int minFrame = -1;
+	};
+
+	extern ChangeLog unitParamChanges;
 }
 
 #endif // LUA_RULESPARAMS_H
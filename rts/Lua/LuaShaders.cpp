@@ -14,8 +14,11 @@
 #include "LuaMatrixImpl.h"
 
 #include "Game/Camera.h"
+#include "Rendering/GL/StateCache.h"
+#include "Rendering/Shaders/ShaderHandler.h"
 #include "System/Log/ILog.h"
 #include "System/StringUtil.h"
+#include "System/Sync/HsiehHash.h"
 #include "System/TypeToStr.h"
 #include "Rendering/Models/ModelsMemStorage.h"
 #include "Rendering/Models/ModelsMemStorageDefs.h"
@@ -389,6 +392,32 @@ namespace {
 	/******************************************************************************/
 	/******************************************************************************/
 
+	static uint64_t GetProgramBinaryKey(const std::vector<std::string>& defs, std::initializer_list<const std::vector<std::string>*> sources)
+	{
+		// two independently seeded hashes, Lua programs share the cache with engine shaders
+		uint32_t hashes[2] = {0x4c756121, 0x53686472};
+
+		const auto HashStrings = [&](const std::vector<std::string>& strs) {
+			const uint32_t numStrs = strs.size();
+
+			for (uint32_t& hash: hashes) {
+				hash = HsiehHash(&numStrs, sizeof(numStrs), hash);
+
+				for (const std::string& str: strs) {
+					hash = HsiehHash(str.data(), str.size() + 1, hash);
+				}
+			}
+		};
+
+		HashStrings(defs);
+
+		for (const std::vector<std::string>* srcs: sources) {
+			HashStrings(*srcs);
+		}
+
+		return ((uint64_t(hashes[0]) << 32) | hashes[1]);
+	}
+
 	static GLuint CompileObject(
 		lua_State* L,
 		const std::vector<std::string>& defs,
@@ -533,6 +562,29 @@ GLint LuaShaders::GetUniformLocation(LuaShaders::Program* p, const char* name)
 	return iter->second.location;
 }
 
+bool LuaShaders::IsUniformValueSet(LuaShaders::Program* p, GLint location, GLenum type, const void* data, size_t size)
+{
+	// values set while no program is known to be bound can not be tracked
+	if (p == nullptr || location < 0)
+		return false;
+
+	assert(size <= sizeof(UniformValue::data));
+
+	if (p->uniformValuesEpoch != uniformValuesEpoch) {
+		p->uniformValues.clear();
+		p->uniformValuesEpoch = uniformValuesEpoch;
+	}
+
+	UniformValue& value = p->uniformValues[location];
+
+	if (value.type == type && memcmp(value.data.data(), data, size) == 0)
+		return true;
+
+	value.type = type;
+	memcpy(value.data.data(), data, size);
+	return false;
+}
+
 int LuaShaders::CreateShader(lua_State* L)
 {
 	const int args = lua_gettop(L);
@@ -576,89 +628,101 @@ int LuaShaders::CreateShader(lua_State* L)
 	if (!graphicSrcEmpty && !computeSrcEmpty)
 		return 0;
 
-	bool success;
-	const GLuint vertObj = CompileObject(L, shdrDefs, vertSrcs, GL_VERTEX_SHADER, success);
+	CShaderHandler::ProgramBinaryCache& binaryCache = shaderHandler->GetProgramBinaryCache();
 
-	if (!success)
-		return 0;
+	// geometry shaders may take program parameters from the table, those are not part of the key
+	const uint64_t binaryKey = geomSrcs.empty()? GetProgramBinaryKey(shdrDefs, {&vertSrcs, &tcsSrcs, &tesSrcs, &fragSrcs, &compSrcs}): 0;
 
-	const GLuint tcsObj = CompileObject(L, shdrDefs,  tcsSrcs, GL_TESS_CONTROL_SHADER, success);
+	Program p(binaryCache.Load(binaryKey));
 
-	if (!success) {
-		glDeleteShader(vertObj);
-		return 0;
-	}
+	GLint linkStatus = GL_TRUE;
+	GLint validStatus;
 
-	const GLuint tesObj = CompileObject(L, shdrDefs,  tesSrcs,  GL_TESS_EVALUATION_SHADER, success);
+	const bool cachedBinary = (p.id != 0);
 
-	if (!success) {
-		glDeleteShader(vertObj);
-		glDeleteShader(tcsObj);
-		return 0;
-	}
-	const GLuint geomObj = CompileObject(L, shdrDefs, geomSrcs, GL_GEOMETRY_SHADER, success);
+	if (!cachedBinary) {
+		bool success;
+		const GLuint vertObj = CompileObject(L, shdrDefs, vertSrcs, GL_VERTEX_SHADER, success);
 
-	if (!success) {
-		glDeleteShader(vertObj);
-		glDeleteShader(tcsObj);
-		glDeleteShader(tesObj);
-		return 0;
-	}
+		if (!success)
+			return 0;
 
-	const GLuint fragObj = CompileObject(L, shdrDefs, fragSrcs, GL_FRAGMENT_SHADER, success);
+		const GLuint tcsObj = CompileObject(L, shdrDefs,  tcsSrcs, GL_TESS_CONTROL_SHADER, success);
 
-	if (!success) {
-		glDeleteShader(vertObj);
-		glDeleteShader(tcsObj);
-		glDeleteShader(tesObj);
-		glDeleteShader(geomObj);
-		return 0;
-	}
+		if (!success) {
+			glDeleteShader(vertObj);
+			return 0;
+		}
 
-	const GLuint compObj = CompileObject(L, shdrDefs, compSrcs, GL_COMPUTE_SHADER, success);
+		const GLuint tesObj = CompileObject(L, shdrDefs,  tesSrcs,  GL_TESS_EVALUATION_SHADER, success);
 
-	if (!success)
-		return 0;
+		if (!success) {
+			glDeleteShader(vertObj);
+			glDeleteShader(tcsObj);
+			return 0;
+		}
+		const GLuint geomObj = CompileObject(L, shdrDefs, geomSrcs, GL_GEOMETRY_SHADER, success);
 
-	const GLuint prog = glCreateProgram();
+		if (!success) {
+			glDeleteShader(vertObj);
+			glDeleteShader(tcsObj);
+			glDeleteShader(tesObj);
+			return 0;
+		}
 
-	Program p(prog);
+		const GLuint fragObj = CompileObject(L, shdrDefs, fragSrcs, GL_FRAGMENT_SHADER, success);
 
-	if (vertObj != 0) {
-		glAttachShader(prog, vertObj);
-		p.objects.emplace_back(vertObj, GL_VERTEX_SHADER);
-	}
+		if (!success) {
+			glDeleteShader(vertObj);
+			glDeleteShader(tcsObj);
+			glDeleteShader(tesObj);
+			glDeleteShader(geomObj);
+			return 0;
+		}
 
-	if (tcsObj != 0) {
-		glAttachShader(prog, tcsObj);
-		p.objects.emplace_back(tcsObj, GL_TESS_CONTROL_SHADER);
-	}
-	if (tesObj != 0) {
-		glAttachShader(prog, tesObj);
-		p.objects.emplace_back(tesObj, GL_TESS_EVALUATION_SHADER);
-	}
+		const GLuint compObj = CompileObject(L, shdrDefs, compSrcs, GL_COMPUTE_SHADER, success);
 
-	if (geomObj != 0) {
-		glAttachShader(prog, geomObj);
-		p.objects.emplace_back(geomObj, GL_GEOMETRY_SHADER);
-		ApplyGeometryParameters(L, 1, prog); // done before linking
-	}
+		if (!success)
+			return 0;
 
-	if (fragObj != 0) {
-		glAttachShader(prog, fragObj);
-		p.objects.emplace_back(fragObj, GL_FRAGMENT_SHADER);
-	}
+		p.id = glCreateProgram();
 
-	if (compObj != 0) {
-		glAttachShader(prog, compObj);
-		p.objects.emplace_back(compObj, GL_COMPUTE_SHADER);
-	}
+		if (vertObj != 0) {
+			glAttachShader(p.id, vertObj);
+			p.objects.emplace_back(vertObj, GL_VERTEX_SHADER);
+		}
 
-	GLint linkStatus;
-	GLint validStatus;
+		if (tcsObj != 0) {
+			glAttachShader(p.id, tcsObj);
+			p.objects.emplace_back(tcsObj, GL_TESS_CONTROL_SHADER);
+		}
+		if (tesObj != 0) {
+			glAttachShader(p.id, tesObj);
+			p.objects.emplace_back(tesObj, GL_TESS_EVALUATION_SHADER);
+		}
+
+		if (geomObj != 0) {
+			glAttachShader(p.id, geomObj);
+			p.objects.emplace_back(geomObj, GL_GEOMETRY_SHADER);
+			ApplyGeometryParameters(L, 1, p.id); // done before linking
+		}
+
+		if (fragObj != 0) {
+			glAttachShader(p.id, fragObj);
+			p.objects.emplace_back(fragObj, GL_FRAGMENT_SHADER);
+		}
+
+		if (compObj != 0) {
+			glAttachShader(p.id, compObj);
+			p.objects.emplace_back(compObj, GL_COMPUTE_SHADER);
+		}
+
+		binaryCache.PrepareLink(p.id);
+		glLinkProgram(p.id);
+		glGetProgramiv(p.id, GL_LINK_STATUS, &linkStatus);
+	}
 
-	glLinkProgram(prog);
-	glGetProgramiv(prog, GL_LINK_STATUS, &linkStatus);
+	const GLuint prog = p.id;
 
 	// Parse active uniforms and locations
 	GLint currentProgram = FillActiveUniforms(p);
@@ -686,6 +750,9 @@ int LuaShaders::CreateShader(lua_State* L)
 		return 0;
 	}
 
+	if (!cachedBinary)
+		binaryCache.Save(binaryKey, prog);
+
 	// note: index, not raw ID
 	lua_pushnumber(L, shaders.AddProgram(p));
 	return 1;
@@ -710,7 +777,7 @@ int LuaShaders::UseShader(lua_State* L)
 
 	const int progIdx = luaL_checkint(L, 1);
 	if (progIdx == 0) {
-		glUseProgram(0);
+		GL::StateCache::GetInstance().UseProgram(0);
 		activeProgram = nullptr;
 		lua_pushboolean(L, true);
 		return 1;
@@ -724,7 +791,7 @@ int LuaShaders::UseShader(lua_State* L)
 		lua_pushboolean(L, false);
 	} else {
 		activeProgram = prog;
-		glUseProgram(prog->id);
+		GL::StateCache::GetInstance().UseProgram(prog->id);
 		lua_pushboolean(L, true);
 	}
 	return 1;
@@ -749,13 +816,13 @@ int LuaShaders::ActiveShader(lua_State* L)
 	GLint currentProgram;
 	glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
 
-	glUseProgram(prog->id);
+	GL::StateCache::GetInstance().UseProgram(prog->id);
 	activeProgram = prog;
 	activeShaderDepth++;
 	const int error = lua_pcall(L, lua_gettop(L) - 2, 0, 0);
 	activeShaderDepth--;
 	activeProgram = nullptr;
-	glUseProgram(currentProgram);
+	GL::StateCache::GetInstance().UseProgram(currentProgram);
 
 	if (error != 0) {
 		LOG_L(L_ERROR, "gl.ActiveShader: error(%i) = %s", error, lua_tostring(L, -1));
@@ -909,22 +976,27 @@ int LuaShaders::Uniform(lua_State* L)
 	const GLuint location = (lua_type(L, 1) == LUA_TSTRING) ? GetUniformLocation(activeProgram, luaL_checkstring(L, 1)) : luaL_checkint(L, 1);
 	const int numValues = lua_gettop(L) - 1;
 
+	if (numValues < 1 || numValues > 4)
+		luaL_error(L, "Incorrect arguments to gl.Uniform()");
+
+	float v[4];
+
+	for (int i = 0; i < numValues; i++) {
+		v[i] = luaL_checkfloat(L, i + 2);
+	}
+
+	// materials commonly set the same values for every object
+	constexpr GLenum types[] = {GL_FLOAT, GL_FLOAT_VEC2, GL_FLOAT_VEC3, GL_FLOAT_VEC4};
+
+	if (IsUniformValueSet(activeProgram, location, types[numValues - 1], v, numValues * sizeof(v[0])))
+		return 0;
+
 	switch (numValues) {
-		case 1: {
-			glUniform1f(location, luaL_checkfloat(L, 2));
-		} break;
-		case 2: {
-			glUniform2f(location, luaL_checkfloat(L, 2), luaL_checkfloat(L, 3));
-		} break;
-		case 3: {
-			glUniform3f(location, luaL_checkfloat(L, 2), luaL_checkfloat(L, 3), luaL_checkfloat(L, 4));
-		} break;
-		case 4: {
-			glUniform4f(location, luaL_checkfloat(L, 2), luaL_checkfloat(L, 3), luaL_checkfloat(L, 4), luaL_checkfloat(L, 5));
-		} break;
-		default: {
-			luaL_error(L, "Incorrect arguments to gl.Uniform()");
-		} break;
+		case 1: { glUniform1f(location, v[0]                  ); } break;
+		case 2: { glUniform2f(location, v[0], v[1]            ); } break;
+		case 3: { glUniform3f(location, v[0], v[1], v[2]      ); } break;
+		case 4: { glUniform4f(location, v[0], v[1], v[2], v[3]); } break;
+		default: {} break;
 	}
 
 	return 0;
@@ -939,22 +1011,26 @@ int LuaShaders::UniformInt(lua_State* L)
 	const GLuint location = (lua_type(L, 1) == LUA_TSTRING) ? GetUniformLocation(activeProgram, luaL_checkstring(L, 1)) : luaL_checkint(L, 1);
 	const int numValues = lua_gettop(L) - 1;
 
+	if (numValues < 1 || numValues > 4)
+		luaL_error(L, "Incorrect arguments to gl.UniformInt()");
+
+	GLint v[4];
+
+	for (int i = 0; i < numValues; i++) {
+		v[i] = luaL_checkint(L, i + 2);
+	}
+
+	constexpr GLenum types[] = {GL_INT, GL_INT_VEC2, GL_INT_VEC3, GL_INT_VEC4};
+
+	if (IsUniformValueSet(activeProgram, location, types[numValues - 1], v, numValues * sizeof(v[0])))
+		return 0;
+
 	switch (numValues) {
-		case 1: {
-			glUniform1i(location, luaL_checkint(L, 2));
-		} break;
-		case 2: {
-			glUniform2i(location, luaL_checkint(L, 2), luaL_checkint(L, 3));
-		} break;
-		case 3: {
-			glUniform3i(location, luaL_checkint(L, 2), luaL_checkint(L, 3), luaL_checkint(L, 4));
-		} break;
-		case 4: {
-			glUniform4i(location, luaL_checkint(L, 2), luaL_checkint(L, 3), luaL_checkint(L, 4), luaL_checkint(L, 5));
-		} break;
-		default: {
-			luaL_error(L, "Incorrect arguments to gl.UniformInt()");
-		}
+		case 1: { glUniform1i(location, v[0]                  ); } break;
+		case 2: { glUniform2i(location, v[0], v[1]            ); } break;
+		case 3: { glUniform3i(location, v[0], v[1], v[2]      ); } break;
+		case 4: { glUniform4i(location, v[0], v[1], v[2], v[3]); } break;
+		default: {} break;
 	}
 
 	return 0;
@@ -991,6 +1067,10 @@ int LuaShaders::UniformArray(lua_State* L)
 	if (!lua_istable(L, 3))
 		return 0;
 
+	// arrays span multiple locations, not tracked
+	if (activeProgram != nullptr)
+		activeProgram->uniformValues.clear();
+
 	switch (luaL_checkint(L, 2)) {
 		case UNIFORM_TYPE_INT: {
 			#if 0
@@ -1044,7 +1124,8 @@ int LuaShaders::UniformMatrix(lua_State* L)
 			}
 
 			if (mat) {
-				glUniformMatrix4fv(location, 1, GL_FALSE, *mat);
+				if (!IsUniformValueSet(activeProgram, location, GL_FLOAT_MAT4, &mat->m[0], sizeof(mat->m)))
+					glUniformMatrix4fv(location, 1, GL_FALSE, *mat);
 			} else {
 				luaL_error(L, "Incorrect arguments to gl.UniformMatrix()");
 			}
@@ -1057,7 +1138,8 @@ int LuaShaders::UniformMatrix(lua_State* L)
 				array[i] = luaL_checkfloat(L, i + 2);
 			}
 
-			glUniformMatrix2fv(location, 1, GL_FALSE, array);
+			if (!IsUniformValueSet(activeProgram, location, GL_FLOAT_MAT2, array, sizeof(array)))
+				glUniformMatrix2fv(location, 1, GL_FALSE, array);
 			break;
 		}
 		case (3 * 3): {
@@ -1067,7 +1149,8 @@ int LuaShaders::UniformMatrix(lua_State* L)
 				array[i] = luaL_checkfloat(L, i + 2);
 			}
 
-			glUniformMatrix3fv(location, 1, GL_FALSE, array);
+			if (!IsUniformValueSet(activeProgram, location, GL_FLOAT_MAT3, array, sizeof(array)))
+				glUniformMatrix3fv(location, 1, GL_FALSE, array);
 			break;
 		}
 		case (4 * 4): {
@@ -1077,7 +1160,8 @@ int LuaShaders::UniformMatrix(lua_State* L)
 				array[i] = luaL_checkfloat(L, i + 2);
 			}
 
-			glUniformMatrix4fv(location, 1, GL_FALSE, array);
+			if (!IsUniformValueSet(activeProgram, location, GL_FLOAT_MAT4, array, sizeof(array)))
+				glUniformMatrix4fv(location, 1, GL_FALSE, array);
 			break;
 		}
 		default: {
@@ -3,6 +3,7 @@
 #ifndef LUA_SHADERS_H
 #define LUA_SHADERS_H
 
+#include <array>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -45,6 +46,10 @@ class LuaShaders {
 		struct ActiveUniformLocation {
 			GLint location = -1;
 		};
+		struct UniformValue {
+			GLenum type = 0;
+			std::array<GLint, 16> data;
+		};
 		struct Program {
 			Program(GLuint _id) : id(_id) {}
 
@@ -52,7 +57,14 @@ class LuaShaders {
 			std::vector<Object> objects;
 			std::unordered_map<std::string, ActiveUniform> activeUniforms;
 			std::unordered_map<std::string, ActiveUniformLocation> activeUniformLocations;
+
+			// last values set via gl.Uniform*, valid while uniformValuesEpoch matches
+			std::unordered_map<GLint, UniformValue> uniformValues;
+			uint32_t uniformValuesEpoch = 0;
 		};
+
+		/// called by code which sets uniforms of Lua programs directly (LuaMaterial)
+		static void InvalidateUniformValues() { uniformValuesEpoch += 1; }
 	private:
 		std::vector<Program> programs;
 		std::vector<uint32_t> unused; // references slots in programs
@@ -66,6 +78,7 @@ class LuaShaders {
 		// helper
 		static bool DeleteProgram(Program& p);
 		static GLint GetUniformLocation(Program* p, const char* name);
+		static bool IsUniformValueSet(Program* p, GLint location, GLenum type, const void* data, size_t size);
 	private:
 
 		// the call-outs
@@ -94,6 +107,7 @@ class LuaShaders {
 	private:
 		inline static Program* activeProgram = nullptr;
 		inline static int activeShaderDepth = 0;
+		inline static uint32_t uniformValuesEpoch = 1;
 };
 
 
@@ -146,6 +146,7 @@ bool LuaSyncedCtrl::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(SetFeatureRulesParam);
 
 	REGISTER_LUA_CFUNC(CreateUnit);
+	REGISTER_LUA_CFUNC(CreateUnits);
 	REGISTER_LUA_CFUNC(DestroyUnit);
 	REGISTER_LUA_CFUNC(TransferUnit);
 
@@ -1016,7 +1017,8 @@ int LuaSyncedCtrl::ShareTeamResource(lua_State* L)
 /******************************************************************************/
 
 void SetRulesParam(lua_State* L, const char* caller, int offset,
-				LuaRulesParams::Params& params)
+				LuaRulesParams::Params& params,
+				LuaRulesParams::ChangeLog* changeLog = nullptr, int objectID = -1)
 {
 	const int index = offset + 1;
 	const int valIndex = offset + 2;
@@ -1033,6 +1035,9 @@ void SetRulesParam(lua_State* L, const char* caller, int offset,
 	} else if (lua_isstring(L, valIndex)) {
 		param.valueString = lua_tostring(L, valIndex);
 	} else if (lua_isnoneornil(L, valIndex)) {
+		if (changeLog != nullptr)
+			changeLog->Add(gs->frameNum, objectID, param.los, key);
+
 		params.erase(key);
 		return; //no need to set los if param was erased
 	} else {
@@ -1067,6 +1072,9 @@ void SetRulesParam(lua_State* L, const char* caller, int offset,
 	} else {
 		param.los = luaL_optint(L, losIndex, param.los);
 	}
+
+	if (changeLog != nullptr)
+		changeLog->Add(gs->frameNum, objectID, param.los, key);
 }
 
 
@@ -1095,7 +1103,7 @@ int LuaSyncedCtrl::SetUnitRulesParam(lua_State* L)
 	if (unit == nullptr)
 		return 0;
 
-	SetRulesParam(L, __func__, 1, unit->modParams);
+	SetRulesParam(L, __func__, 1, unit->modParams, &LuaRulesParams::unitParamChanges, unit->id);
 	return 0;
 }
 
@@ -1320,6 +1328,99 @@ int LuaSyncedCtrl::CreateUnit(lua_State* L)
 }
 
 
+// CreateUnits(unitDef, {{x, y, z}, ...}, facing, teamID, build, flattenGround) -> {unitID, ...}
+// same as calling CreateUnit per position, but the per-def setup is only done once
+int LuaSyncedCtrl::CreateUnits(lua_State* L)
+{
+	CheckAllowGameChanges(L);
+
+	if (inCreateUnit >= MAX_CMD_RECURSION_DEPTH) {
+		luaL_error(L, "[%s()]: recursion is not permitted, max depth: %d", __func__, MAX_CMD_RECURSION_DEPTH);
+		return 0;
+	}
+
+	const UnitDef* unitDef = nullptr;
+
+	if (lua_israwstring(L, 1)) {
+		unitDef = unitDefHandler->GetUnitDefByName(lua_tostring(L, 1));
+	} else if (lua_israwnumber(L, 1)) {
+		unitDef = unitDefHandler->GetUnitDefByID(lua_toint(L, 1));
+	} else {
+		luaL_error(L, "[%s()] incorrect type for first argument", __func__);
+		return 0;
+	}
+
+	if (unitDef == nullptr) {
+		luaL_error(L, "[%s()]: bad unitDef", __func__);
+		return 0;
+	}
+
+	luaL_checktype(L, 2, LUA_TTABLE);
+
+	const int facing = LuaUtils::ParseFacing(L, __func__, 3);
+	const int teamID = luaL_optint(L, 4, CtrlTeam(L));
+
+	const bool beingBuilt = luaL_optboolean(L, 5, false);
+	const bool flattenGround = luaL_optboolean(L, 6, true);
+
+	if (!teamHandler.IsValidTeam(teamID)) {
+		luaL_error(L, "[%s()]: invalid team number (%d)", __func__, teamID);
+		return 0;
+	}
+	if (!FullCtrl(L) && (CtrlTeam(L) != teamID)) {
+		luaL_error(L, "[%s()]: not a controllable team (%d)", __func__, teamID);
+		return 0;
+	}
+
+	std::vector<float3> positions;
+	std::vector<CUnit*> units;
+
+	positions.reserve(lua_objlen(L, 2));
+
+	for (int i = 1, n = lua_objlen(L, 2); i <= n; i++) {
+		lua_rawgeti(L, 2, i);
+
+		float xyz[3];
+
+		if (LuaUtils::ParseFloatArray(L, -1, xyz, 3) != 3) {
+			luaL_error(L, "[%s()]: bad position at index %d, expected {x, y, z}", __func__, i);
+			return 0;
+		}
+
+		// CUnit::PreInit will clamp the position
+		positions.emplace_back(xyz[0], xyz[1], xyz[2]);
+		ASSERT_SYNCED(positions.back());
+		lua_pop(L, 1);
+	}
+
+	ASSERT_SYNCED(facing);
+
+	UnitLoadParams params;
+	params.unitDef = unitDef;
+	params.builder = nullptr;
+	params.pos     = ZeroVector;
+	params.speed   = ZeroVector;
+	params.unitID  = -1;
+	params.teamID  = teamID;
+	params.facing  = facing;
+	params.beingBuilt = beingBuilt;
+	params.flattenGround = flattenGround;
+
+	inCreateUnit++;
+	unitLoader->LoadUnits(params, positions, true, units);
+	inCreateUnit--;
+
+	lua_createtable(L, units.size(), 0);
+
+	for (size_t i = 0; i < units.size(); i++) {
+		lua_pushnumber(L, units[i]->id);
+		lua_rawseti(L, -2, i + 1);
+	}
+
+	return 1;
+}
+
+
 int LuaSyncedCtrl::DestroyUnit(lua_State* L)
 {
 	CheckAllowGameChanges(L); // FIXME -- recursion protection
@@ -61,6 +61,7 @@ class LuaSyncedCtrl
 		static int GiveOrderArrayToUnitArray(lua_State* L);
 
 		static int CreateUnit(lua_State* L);
+		static int CreateUnits(lua_State* L);
 		static int DestroyUnit(lua_State* L);
 		static int TransferUnit(lua_State* L);
 
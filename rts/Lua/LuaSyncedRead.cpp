@@ -207,6 +207,7 @@ bool LuaSyncedRead::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(GetUnitDirection);
 	REGISTER_LUA_CFUNC(GetUnitHeading);
 	REGISTER_LUA_CFUNC(GetUnitVelocity);
+	REGISTER_LUA_CFUNC(GetUnitsData);
 	REGISTER_LUA_CFUNC(GetUnitBuildFacing);
 	REGISTER_LUA_CFUNC(GetUnitIsBuilding);
 	REGISTER_LUA_CFUNC(GetUnitCurrentBuildPower);
@@ -256,6 +257,7 @@ bool LuaSyncedRead::PushEntries(lua_State* L)
 
 	REGISTER_LUA_CFUNC(GetUnitRulesParam);
 	REGISTER_LUA_CFUNC(GetUnitRulesParams);
+	REGISTER_LUA_CFUNC(GetUnitRulesParamsChanges);
 
 	REGISTER_LUA_CFUNC(GetCEGID);
 
@@ -2860,25 +2862,35 @@ int LuaSyncedRead::GetUnitNeutral(lua_State* L)
 }
 
 
+// returns the factor health values of <unit> are scaled by as seen from
+// the reading handle (negative if its damage is hidden from the reader)
+static float GetUnitHealthScale(lua_State* L, const CUnit* unit)
+{
+	const UnitDef* ud = unit->unitDef;
+
+	if (!LuaUtils::IsEnemyUnit(L, unit))
+		return 1.0f;
+	if (ud->hideDamage)
+		return -1.0f;
+	if (ud->decoyDef == nullptr)
+		return 1.0f;
+
+	return (ud->decoyDef->health / ud->health);
+}
+
 int LuaSyncedRead::GetUnitHealth(lua_State* L)
 {
 	const CUnit* unit = ParseInLosUnit(L, __func__, 1);
 	if (unit == nullptr)
 		return 0;
 
-	const UnitDef* ud = unit->unitDef;
-	const bool enemyUnit = LuaUtils::IsEnemyUnit(L, unit);
+	const float scale = GetUnitHealthScale(L, unit);
 
-	if (ud->hideDamage && enemyUnit) {
+	if (scale < 0.0f) {
 		lua_pushnil(L);
 		lua_pushnil(L);
 		lua_pushnil(L);
-	} else if (!enemyUnit || (ud->decoyDef == nullptr)) {
-		lua_pushnumber(L, unit->health);
-		lua_pushnumber(L, unit->maxHealth);
-		lua_pushnumber(L, unit->paralyzeDamage);
 	} else {
-		const float scale = (ud->decoyDef->health / ud->health);
 		lua_pushnumber(L, scale * unit->health);
 		lua_pushnumber(L, scale * unit->maxHealth);
 		lua_pushnumber(L, scale * unit->paralyzeDamage);
@@ -3045,6 +3057,124 @@ int LuaSyncedRead::GetUnitVelocity(lua_State* L)
 }
 
 
+// data, stride = Spring.GetUnitsData(unitIDs, fields[, data])
+//   fields is any sequence of 'p' (pos.xyz), 'm' (midPos.xyz), 'v' (speed.xyz),
+//   'h' (health, maxHealth), 't' (team) and 'd' (unitDefID); the values of the
+//   i-th unit start at data[(i - 1) * stride + 1] and are nil wherever the
+//   single-unit getters would not have returned them. Passing the table from
+//   the previous call in <data> reuses it (entries past #unitIDs * stride are
+//   left untouched) instead of creating a new one per call.
+int LuaSyncedRead::GetUnitsData(lua_State* L)
+{
+	luaL_checktype(L, 1, LUA_TTABLE);
+
+	const char* fields = luaL_checkstring(L, 2);
+	const int numUnits = lua_objlen(L, 1);
+
+	int stride = 0;
+
+	for (const char* f = fields; *f != 0; f++) {
+		switch (*f) {
+			case 'p': case 'm': case 'v': { stride += 3; } break;
+			case 'h':                     { stride += 2; } break;
+			case 't': case 'd':           { stride += 1; } break;
+			default: {
+				luaL_error(L, "[%s] unknown field '%c' in \"%s\"", __func__, *f, fields);
+			} break;
+		}
+	}
+
+	if (lua_istable(L, 3)) {
+		lua_pushvalue(L, 3);
+	} else {
+		lua_createtable(L, numUnits * stride, 0);
+	}
+
+	const int dataIdx = lua_gettop(L);
+	const int readAllyTeam = CLuaHandle::GetHandleReadAllyTeam(L);
+	const bool fullRead = CLuaHandle::GetHandleFullRead(L);
+
+	int n = 0;
+
+	const auto PushValue = [&](float v) { lua_pushnumber(L, v); lua_rawseti(L, dataIdx, ++n); };
+	const auto PushNils  = [&](int k) { for (int j = 0; j < k; j++) { lua_pushnil(L); lua_rawseti(L, dataIdx, ++n); } };
+
+	for (int i = 1; i <= numUnits; i++) {
+		lua_rawgeti(L, 1, i);
+
+		const CUnit* unit = lua_isnumber(L, -1)? unitHandler.GetUnit(lua_toint(L, -1)): nullptr;
+
+		lua_pop(L, 1);
+
+		if (unit == nullptr || !LuaUtils::IsUnitVisible(L, unit)) {
+			PushNils(stride);
+			continue;
+		}
+
+		const bool allyUnit = LuaUtils::IsAllyUnit(L, unit);
+		const bool inLosUnit = allyUnit || LuaUtils::IsUnitInLos(L, unit);
+
+		const float3 errorVec = allyUnit? ZeroVector: unit->GetLuaErrorVector(readAllyTeam, fullRead);
+
+		for (const char* f = fields; *f != 0; f++) {
+			switch (*f) {
+				case 'p': {
+					PushValue(unit->pos.x + errorVec.x);
+					PushValue(unit->pos.y + errorVec.y);
+					PushValue(unit->pos.z + errorVec.z);
+				} break;
+				case 'm': {
+					PushValue(unit->midPos.x + errorVec.x);
+					PushValue(unit->midPos.y + errorVec.y);
+					PushValue(unit->midPos.z + errorVec.z);
+				} break;
+				case 'v': {
+					if (!inLosUnit) {
+						PushNils(3);
+						break;
+					}
+
+					PushValue(unit->speed.x);
+					PushValue(unit->speed.y);
+					PushValue(unit->speed.z);
+				} break;
+				case 'h': {
+					const float scale = inLosUnit? GetUnitHealthScale(L, unit): -1.0f;
+
+					if (scale < 0.0f) {
+						PushNils(2);
+						break;
+					}
+
+					PushValue(scale * unit->health);
+					PushValue(scale * unit->maxHealth);
+				} break;
+				case 't': {
+					PushValue(unit->team);
+				} break;
+				case 'd': {
+					if (allyUnit) {
+						PushValue(unit->unitDef->id);
+						break;
+					}
+					if (!LuaUtils::IsUnitTyped(L, unit)) {
+						PushNils(1);
+						break;
+					}
+
+					PushValue(LuaUtils::EffectiveUnitDef(L, unit)->id);
+				} break;
+				default: {
+				} break;
+			}
+		}
+	}
+
+	lua_pushnumber(L, stride);
+	return 2;
+}
+
+
 int LuaSyncedRead::GetUnitBuildFacing(lua_State* L)
 {
 	const CUnit* unit = ParseInLosUnit(L, __func__, 1);
@@ -4471,6 +4601,48 @@ int LuaSyncedRead::GetUnitRulesParams(lua_State* L)
 }
 
 
+// returns {[unitID] = {[key] = true, ...}, ...} for all readable params set or
+// erased after <sinceFrame>, or nil if the log no longer reaches back that far
+int LuaSyncedRead::GetUnitRulesParamsChanges(lua_State* L)
+{
+	const LuaRulesParams::ChangeLog& changeLog = LuaRulesParams::unitParamChanges;
+	const auto& changes = changeLog.GetChanges();
+
+	const int sinceFrame = luaL_checkint(L, 1);
+
+	if (!changeLog.HasChangesSince(sinceFrame) || game == nullptr)
+		return 0;
+
+	lua_createtable(L, 0, 0);
+
+	for (size_t i = changeLog.GetFirstChangeAfter(sinceFrame), n = changes.size(); i < n; i++) {
+		const LuaRulesParams::ChangeLog::Change& change = changes[i];
+		const CUnit* unit = unitHandler.GetUnit(change.objectID);
+
+		if (unit == nullptr)
+			continue;
+		if ((change.los & GetUnitRulesParamLosMask(L, unit)) == 0)
+			continue;
+
+		lua_rawgeti(L, -1, change.objectID);
+
+		if (!lua_istable(L, -1)) {
+			lua_pop(L, 1);
+			lua_createtable(L, 0, 1);
+			lua_pushvalue(L, -1);
+			lua_rawseti(L, -3, change.objectID);
+		}
+
+		lua_pushsstring(L, change.key);
+		lua_pushboolean(L, true);
+		lua_rawset(L, -3);
+		lua_pop(L, 1);
+	}
+
+	return 1;
+}
+
+
 int LuaSyncedRead::GetUnitRulesParam(lua_State* L)
 {
 	const CUnit* unit = ParseUnit(L, __func__, 1);
@@ -25,6 +25,7 @@
 #include "LuaUtils.h"
 #include "LuaVFS.h"
 #include "LuaVFSDownload.h"
+#include "LuaWorkers.h"
 #include "LuaIO.h"
 #include "LuaZip.h"
 #include "Game/Camera.h"
@@ -150,6 +151,7 @@ CLuaUI::CLuaUI()
 	    !AddEntriesToTable(L, "Spring",      LuaUnsyncedCtrl::PushEntries)      ||
 	    !AddEntriesToTable(L, "Spring",      LuaUnsyncedRead::PushEntries)      ||
 	    !AddEntriesToTable(L, "Spring",      LuaUICommand::PushEntries)         ||
+	    !AddEntriesToTable(L, "Spring",      LuaWorkers::PushEntries)           ||
 	    !AddEntriesToTable(L, "gl",          LuaOpenGL::PushEntries)            ||
 	    !AddEntriesToTable(L, "GL",          LuaConstGL::PushEntries)           ||
 	    !AddEntriesToTable(L, "Engine",      LuaConstEngine::PushEntries)       ||
@@ -56,6 +56,7 @@
 #include "Sim/Units/Unit.h"
 #include "Sim/Units/UnitHandler.h"
 #include "Sim/Units/UnitDefHandler.h"
+#include "Sim/Units/UnitDefProfiler.h"
 #include "Sim/Units/CommandAI/CommandDescription.h"
 #include "Game/UI/Groups/Group.h"
 #include "Game/UI/Groups/GroupHandler.h"
@@ -100,6 +101,8 @@ bool LuaUnsyncedRead::PushEntries(lua_State* L)
 	REGISTER_LUA_CFUNC(GetProfilerRecordNames);
 
 	REGISTER_LUA_CFUNC(GetLuaMemUsage);
+	REGISTER_LUA_CFUNC(GetLuaProfile);
+	REGISTER_LUA_CFUNC(GetUnitDefProfile);
 	REGISTER_LUA_CFUNC(GetVidMemUsage);
 
 	REGISTER_LUA_CFUNC(GetDrawFrame);
@@ -482,6 +485,73 @@ int LuaUnsyncedRead::GetLuaMemUsage(lua_State* L)
 	return 8;
 }
 
+int LuaUnsyncedRead::GetLuaProfile(lua_State* L)
+{
+	// entries of the calling state only, keyed by callin name or profile-tag
+	SLuaProfileState& profileState = GetLuaContextData(L)->profileState;
+
+	const auto& entries = profileState.GetEntries();
+
+	lua_createtable(L, 0, entries.size());
+
+	for (const SLuaProfileState::Entry& e: entries) {
+		lua_pushsstring(L, e.name);
+		lua_createtable(L, 0, 3); {
+			HSTR_PUSH_NUMBER(L, "time"  , e.runTime * 0.001f); // msecs
+			HSTR_PUSH_NUMBER(L, "allocs", e.numAllocs);
+			HSTR_PUSH_NUMBER(L, "kbytes", e.allocBytes / 1024.0f);
+		}
+		lua_rawset(L, -3);
+	}
+
+	if (luaL_optboolean(L, 1, false))
+		profileState.ResetEntries();
+
+	return 1;
+}
+
+int LuaUnsyncedRead::GetUnitDefProfile(lua_State* L)
+{
+	// only collected with ProfileUnitDefs=1, keyed by unitDefID then category
+	if (!unitDefProfiler.IsEnabled())
+		return 0;
+
+	const std::vector<CUnitDefProfiler::Counter>& totals = unitDefProfiler.GetTotals();
+
+	lua_createtable(L, unitDefProfiler.NumUnitDefs(), 0);
+
+	for (size_t defID = 1; defID < unitDefProfiler.NumUnitDefs(); defID++) {
+		const CUnitDefProfiler::Counter* counters = &totals[defID * CUnitDefProfiler::CAT_COUNT];
+
+		uint64_t numCalls = 0;
+
+		for (unsigned int cat = 0; cat < CUnitDefProfiler::CAT_COUNT; cat++) {
+			numCalls += counters[cat].calls;
+		}
+
+		if (numCalls == 0)
+			continue;
+
+		lua_createtable(L, 0, CUnitDefProfiler::CAT_COUNT);
+
+		for (unsigned int cat = 0; cat < CUnitDefProfiler::CAT_COUNT; cat++) {
+			lua_pushstring(L, CUnitDefProfiler::GetCategoryName(cat));
+			lua_createtable(L, 0, 2); {
+				HSTR_PUSH_NUMBER(L, "time" , counters[cat].nanos * 1e-6); // msecs
+				HSTR_PUSH_NUMBER(L, "calls", counters[cat].calls);
+			}
+			lua_rawset(L, -3);
+		}
+
+		lua_rawseti(L, -2, defID);
+	}
+
+	if (luaL_optboolean(L, 1, false))
+		unitDefProfiler.Reset();
+
+	return 1;
+}
+
 int LuaUnsyncedRead::GetVidMemUsage(lua_State* L)
 {
 	int2 vidMemInfo;
@@ -909,6 +979,26 @@ public:
 		objectLists.reserve(64);
 
 		objectCount = 0;
+
+		if ((++markNum) == 0) {
+			std::fill(objectMarks.begin(), objectMarks.end(), 0);
+			markNum = 1;
+		}
+	}
+
+	// unsynced replacement for CWorldObject::tempNum, which belongs to the sim
+	// @return false if <o> was already marked since the last ResetState
+	bool MarkObject(const T* o) {
+		assert(o->id >= 0);
+
+		if (size_t(o->id) >= objectMarks.size())
+			objectMarks.resize(o->id + 1, 0);
+
+		if (objectMarks[o->id] == markNum)
+			return false;
+
+		objectMarks[o->id] = markNum;
+		return true;
 	}
 
 	unsigned int GetQuadCount() const { return (objectLists.size()); }
@@ -929,7 +1019,11 @@ protected:
 	// its size equals the number of visible quads
 	ObjectVector objectLists;
 
+	// objects can be in several quads
+	std::vector<unsigned int> objectMarks;
+
 	unsigned int objectCount;
+	unsigned int markNum = 0;
 };
 
 
@@ -1009,21 +1103,16 @@ int LuaUnsyncedRead::GetVisibleUnits(lua_State* L)
 	static CVisUnitQuadDrawer unitQuadIter;
 
 	unitQuadIter.ResetState();
-	readMap->GridVisibility(nullptr, &unitQuadIter, 1e9, CQuadField::BASE_QUAD_SIZE / SQUARE_SIZE);
+	readMap->GridVisibility(nullptr, &unitQuadIter, 1e9, quadField.GetQuadSizeX() / SQUARE_SIZE);
 
-	// Even though we're in unsynced it's ok to use gs->tempNum since its exact value
-	// doesn't matter
-	const int tempNum = gs->GetTempNum();
 	lua_createtable(L, unitQuadIter.GetObjectCount(), 0);
 
 	unsigned int count = 0;
 	for (auto visUnitList: unitQuadIter.GetObjectLists()) {
 		for (CUnit* u: *visUnitList) {
-			if (u->tempNum == tempNum)
+			if (!unitQuadIter.MarkObject(u))
 				continue;
 
-			u->tempNum = tempNum;
-
 			if (u->noDraw)
 				continue;
 
@@ -1088,21 +1177,16 @@ int LuaUnsyncedRead::GetVisibleFeatures(lua_State* L)
 	static CVisFeatureQuadDrawer featureQuadIter;
 
 	featureQuadIter.ResetState();
-	readMap->GridVisibility(nullptr, &featureQuadIter, 1e9, CQuadField::BASE_QUAD_SIZE / SQUARE_SIZE);
+	readMap->GridVisibility(nullptr, &featureQuadIter, 1e9, quadField.GetQuadSizeX() / SQUARE_SIZE);
 
-	// Even though we're in unsynced it's ok to use gs->tempNum since its exact value
-	// doesn't matter
-	const int tempNum = gs->GetTempNum();
 	lua_createtable(L, featureQuadIter.GetObjectCount(), 0);
 
 	unsigned int count = 0;
 	for (auto visFeatureList: featureQuadIter.GetObjectLists()) {
 		for (CFeature* f: *visFeatureList) {
-			if (f->tempNum == tempNum)
+			if (!featureQuadIter.MarkObject(f))
 				continue;
 
-			f->tempNum = tempNum;
-
 			if (f->noDraw)
 				continue;
 
@@ -1151,21 +1235,16 @@ int LuaUnsyncedRead::GetVisibleProjectiles(lua_State* L)
 
 
 	projQuadIter.ResetState();
-	readMap->GridVisibility(nullptr, &projQuadIter, 1e9, CQuadField::BASE_QUAD_SIZE / SQUARE_SIZE);
+	readMap->GridVisibility(nullptr, &projQuadIter, 1e9, quadField.GetQuadSizeX() / SQUARE_SIZE);
 
-	// Even though we're in unsynced it's ok to use gs->tempNum since its exact value
-	// doesn't matter
-	const int tempNum = gs->GetTempNum();
 	lua_createtable(L, projQuadIter.GetObjectCount(), 0);
 
 	unsigned int count = 0;
 	for (auto visProjectileList: projQuadIter.GetObjectLists()) {
 		for (CProjectile* p: *visProjectileList) {
-			if (p->tempNum == tempNum)
+			if (!projQuadIter.MarkObject(p))
 				continue;
 
-			p->tempNum = tempNum;
-
 
 			if (allyTeamID >= 0 && !losHandler->InLos(p, allyTeamID))
 				continue;
@@ -1316,7 +1395,7 @@ int LuaUnsyncedRead::GetUnitsInScreenRectangle(lua_State* L)
 	static CVisUnitQuadDrawer unitQuadIter;
 
 	unitQuadIter.ResetState();
-	readMap->GridVisibility(nullptr, &unitQuadIter, 1e9, CQuadField::BASE_QUAD_SIZE / SQUARE_SIZE);
+	readMap->GridVisibility(nullptr, &unitQuadIter, 1e9, quadField.GetQuadSizeX() / SQUARE_SIZE);
 
 	const int readTeam = CLuaHandle::GetHandleReadTeam(L);
 	const int readATeam = CLuaHandle::GetHandleReadAllyTeam(L);
@@ -1357,9 +1436,6 @@ int LuaUnsyncedRead::GetUnitsInScreenRectangle(lua_State* L)
 	} break;
 	}
 
-	// Even though we're in unsynced it's ok to use gs->tempNum since its exact value
-// doesn't matter
-	const int tempNum = gs->GetTempNum();
 	lua_createtable(L, unitQuadIter.GetObjectCount(), 0);
 
 	uint32_t count = 0;
@@ -1368,11 +1444,9 @@ int LuaUnsyncedRead::GetUnitsInScreenRectangle(lua_State* L)
 			if (disqualifierFunc(unit))
 				continue;
 
-			if (unit->tempNum == tempNum)
+			if (!unitQuadIter.MarkObject(unit))
 				continue;
 
-			unit->tempNum = tempNum;
-
 			const float3 winPos = camera->CalcWindowCoordinates(unit->drawPos);
 
 			if (winPos.x > r || winPos.x < l)
@@ -23,6 +23,8 @@ class LuaUnsyncedRead {
 		static int GetProfilerRecordNames(lua_State* L);
 
 		static int GetLuaMemUsage(lua_State* L);
+		static int GetLuaProfile(lua_State* L);
+		static int GetUnitDefProfile(lua_State* L);
 		static int GetVidMemUsage(lua_State* L);
 
 		static int GetDrawFrame(lua_State* L);
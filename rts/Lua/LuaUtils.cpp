@@ -31,7 +31,7 @@
 
 
 static const int maxDepth = 16;
-int LuaUtils::exportedDataSize = 0;
+std::atomic<int> LuaUtils::exportedDataSize = {0};
 
 
 /******************************************************************************/
@@ -3,6 +3,7 @@
 #ifndef LUA_UTILS_H
 #define LUA_UTILS_H
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -85,7 +86,7 @@ class LuaUtils {
 
 	public:
 		// Backups lua data into a c++ vector and restores it from it
-		static int exportedDataSize; //< performance stat
+		static std::atomic<int> exportedDataSize; //< performance stat, Lua workers back up data concurrently
 		static int Backup(std::vector<DataDump> &backup, lua_State* src, int count);
 		static int Restore(const std::vector<DataDump> &backup, lua_State* dst);
 
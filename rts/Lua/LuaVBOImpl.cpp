@@ -487,12 +487,22 @@ size_t LuaVBOImpl::Upload(const sol::stack_table& luaTblData, sol::optional<int>
 		LuaUtils::SolLuaError("[LuaVBOImpl::%s] Invalid luaStartIndex [%u] is greater than luaFinishIndex [%u]", __func__, luaStartIndex, luaFinishIndex);
 	}
 
-	std::vector<lua_Number> dataVec;
+	// reused across calls, widgets upload large tables every frame
+	static std::vector<lua_Number> dataVec;
+	dataVec.clear();
 	dataVec.resize(luaFinishIndex - luaStartIndex + 1);
 
-	constexpr auto defaultValue = static_cast<lua_Number>(0);
-	for (auto k = 0; k < dataVec.size(); ++k) {
-		dataVec[k] = luaTblData.raw_get_or<lua_Number>(luaStartIndex + k, defaultValue);
+	// read through the raw API, going through sol per element dominates the upload time
+	lua_State* L = luaTblData.lua_state();
+	const int tblIndex = luaTblData.stack_index();
+
+	for (size_t k = 0; k < dataVec.size(); ++k) {
+		lua_rawgeti(L, tblIndex, luaStartIndex + k);
+
+		if (lua_type(L, -1) == LUA_TNUMBER)
+			dataVec[k] = lua_tonumber(L, -1);
+
+		lua_pop(L, 1);
 	}
 
 	return UploadImpl<lua_Number>(dataVec, elemOffset, attribIdx);
@@ -826,6 +836,12 @@ size_t LuaVBOImpl::UploadImpl(const std::vector<TIn>& dataVec, uint32_t elemOffs
 
 	const auto uploadToGPU = [this, buffDataWithOffset, bufferOffsetInBytes, mappedBufferSizeInBytes](int bytesWritten) -> int {
 		vbo->Bind();
+
+		// when everything is replaced, let the driver hand out fresh storage
+		// instead of waiting for draws still reading the previous contents
+		if (freqUpdated && vboOwner && bufferOffsetInBytes == 0 && uint32_t(bytesWritten) == bufferSizeInBytes)
+			vbo->Invalidate();
+
 #if 1
 		vbo->SetBufferSubData(bufferOffsetInBytes, bytesWritten, buffDataWithOffset);
 #else
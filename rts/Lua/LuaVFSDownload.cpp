@@ -5,6 +5,8 @@
 #include "System/EventHandler.h"
 #include "System/Platform/Threading.h" // Is{Main,GameLoad}Thread
 #include "System/Threading/SpringThreading.h"
+#include "System/Config/ConfigHandler.h"
+#include "System/Misc/SpringTime.h"
 #include "System/FileSystem/ArchiveScanner.h"
 #include "System/FileSystem/DataDirLocater.h"
 #include "../tools/pr-downloader/src/pr-downloader.h"
@@ -12,9 +14,13 @@
 #include "LuaInclude.h"
 #include "LuaUtils.h"
 
+#include <atomic>
 #include <deque>
 #include <memory>
 
+CONFIG(int, DownloadRetries).defaultValue(3).minimumValue(0).maximumValue(10)
+	.description("Number of times a failed archive download is restarted before it is reported as failed. Rapid pool files that were completely downloaded are kept, so a restart only fetches the missing ones.");
+
 
 struct DLEvent {
 	DLEvent(int _id): id(_id) {}
@@ -77,6 +83,7 @@ public:
 	void Pump();
 	void Push(const DownloadItem& downloadItem);
 	void Join();
+	void Abort();
 
 	bool Remove(int id);
 
@@ -85,7 +92,7 @@ private:
 	spring::mutex mutex;
 	spring::thread thread;
 
-	bool breakLoop = false;
+	std::atomic<bool> breakLoop = {false};
 };
 
 
@@ -113,7 +120,7 @@ static void UpdateProgress(int done, int size) { QueueDownloadProgress(currentDo
 
 
 
-static int StartDownloadJob(int id, const std::string& filename, DownloadEnum::Category cat)
+static int StartDownloadJob(int id, const std::string& filename, DownloadEnum::Category cat, bool isRetry)
 {
 	currentDownloadID = id;
 
@@ -146,7 +153,8 @@ static int StartDownloadJob(int id, const std::string& filename, DownloadEnum::C
 		return 2;
 	}
 
-	QueueDownloadStarted(id);
+	if (!isRetry)
+		QueueDownloadStarted(id);
 
 	// FIXME:
 	//   many functions in ArchiveScanner do not lock, and are called at
@@ -162,6 +170,23 @@ static int StartDownloadJob(int id, const std::string& filename, DownloadEnum::C
 
 
 
+static bool WaitForRetry(int attempt, const std::atomic<bool>& breakLoop)
+{
+	// back off a little longer each time, a flaky mirror or link usually recovers within seconds
+	const spring_time retryTime = spring_gettime() + spring_secs(2 * attempt);
+
+	while (spring_gettime() < retryTime) {
+		if (breakLoop)
+			return false;
+
+		spring_sleep(spring_msecs(100));
+	}
+
+	return (!breakLoop);
+}
+
+
+
 void DownloadQueue::Join()
 {
 	breakLoop = true;
@@ -186,7 +211,19 @@ void DownloadQueue::Pump()
 		const std::string& filename = downloadItem.filename;
 
 		if (!filename.empty()) {
-			const int result = StartDownloadJob(downloadItem.id, filename, downloadItem.cat);
+			const int numRetries = configHandler->GetInt("DownloadRetries");
+
+			int result = StartDownloadJob(downloadItem.id, filename, downloadItem.cat, false);
+
+			// 2 means nothing was found, no point in asking again
+			for (int attempt = 1; result != 0 && result != 2 && attempt <= numRetries; attempt++) {
+				LOG_L(L_WARNING, "[DownloadQueue::%s] download of \"%s\" failed (%d), retry %d/%d", __func__, filename.c_str(), result, attempt, numRetries);
+
+				if (!WaitForRetry(attempt, breakLoop))
+					break;
+
+				result = StartDownloadJob(downloadItem.id, filename, downloadItem.cat, true);
+			}
 
 			if (result == 0) {
 				QueueDownloadFinished(downloadItem.id);
@@ -225,6 +262,14 @@ void DownloadQueue::Push(const DownloadItem& downloadItem)
 	queue.push_back(downloadItem);
 }
 
+void DownloadQueue::Abort()
+{
+	// set before aborting, so the failing job is not retried
+	breakLoop = true;
+	SetAbortDownloads(true);
+	Join();
+}
+
 bool DownloadQueue::Remove(int id)
 {
 	std::unique_lock<spring::mutex> lck(mutex);
@@ -234,9 +279,8 @@ bool DownloadQueue::Remove(int id)
 			continue;
 
 		if (it == queue.begin()) {
-			SetAbortDownloads(true);
 			lck.unlock();
-			Join();
+			Abort();
 			lck.lock();
 			SetAbortDownloads(false);
 
@@ -277,10 +321,8 @@ void LuaVFSDownload::Free(bool stopDownloads)
 {
 	eventHandler.RemoveClient(luaVFSDownload);
 
-	if (stopDownloads) {
-		SetAbortDownloads(true);
-		downloadQueue.Join();
-	}
+	if (stopDownloads)
+		downloadQueue.Abort();
 }
 
 
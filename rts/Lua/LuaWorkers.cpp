@@ -0,0 +1,329 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+
+#include "LuaWorkers.h"
+
+#include "LuaContextData.h"
+#include "LuaInclude.h"
+#include "LuaHashString.h"
+#include "LuaUtils.h"
+
+#include "System/MainDefines.h"
+#include "System/Platform/Threading.h"
+#include "System/Threading/SpringThreading.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+
+class CLuaWorker {
+public:
+	typedef std::vector<LuaUtils::DataDump> Message;
+
+	// beyond this the receiving side is clearly not keeping up
+	static constexpr size_t MAX_QUEUED_MESSAGES = 1 << 16;
+
+public:
+	CLuaWorker(const std::string& _name, const std::string& _code)
+		: name(_name)
+		, code(_code)
+		// never the shared pool, that is owned by the main thread
+		, D(false, false)
+	{
+		thread = std::move(spring::thread(&CLuaWorker::Run, this));
+	}
+
+	~CLuaWorker() { Join(); }
+
+	void Join() {
+		{
+			std::lock_guard<spring::mutex> lck(mutex);
+			breakLoop = true;
+		}
+
+		cond.notify_one();
+
+		if (thread.joinable())
+			thread.join();
+	}
+
+	bool PushInput(Message&& msg) {
+		{
+			std::lock_guard<spring::mutex> lck(mutex);
+
+			if (breakLoop || inputs.size() >= MAX_QUEUED_MESSAGES)
+				return false;
+
+			inputs.emplace_back(std::move(msg));
+		}
+
+		cond.notify_one();
+		return true;
+	}
+
+	bool PopOutput(Message& msg) {
+		std::lock_guard<spring::mutex> lck(mutex);
+
+		if (outputs.empty())
+			return false;
+
+		msg = std::move(outputs.front());
+		outputs.pop_front();
+		return true;
+	}
+
+	std::string GetError() {
+		std::lock_guard<spring::mutex> lck(mutex);
+		return error;
+	}
+
+private:
+	bool Setup();
+	bool CallRecv(const Message& msg);
+	void SetError(const char* msg);
+
+	__FORCE_ALIGN_STACK__
+	void Run();
+
+	static int SendToMain(lua_State* L);
+
+private:
+	std::string name;
+	std::string code;
+	std::string error;
+
+	std::deque<Message> inputs;
+	std::deque<Message> outputs;
+
+	spring::thread thread;
+	spring::mutex mutex;
+	spring::condition_variable cond;
+
+	// only touched by the worker thread
+	luaContextData D;
+	lua_State* L = nullptr;
+
+	bool breakLoop = false;
+};
+
+
+bool CLuaWorker::Setup()
+{
+	if ((L = LUA_OPEN(&D)) == nullptr) {
+		SetError("could not create Lua state");
+		return false;
+	}
+
+	// NOTE: math.random shares the unsynced RNG, just as
+	// LuaParser's do when defs are being parsed in parallel
+	LUA_OPEN_LIB(L, luaopen_base);
+	LUA_OPEN_LIB(L, luaopen_math);
+	LUA_OPEN_LIB(L, luaopen_table);
+	LUA_OPEN_LIB(L, luaopen_string);
+
+	// the VFS is not thread-safe, code has to be passed in as a string
+	lua_pushnil(L); lua_setglobal(L, "dofile");
+	lua_pushnil(L); lua_setglobal(L, "loadfile");
+	lua_pushnil(L); lua_setglobal(L, "loadlib");
+	lua_pushnil(L); lua_setglobal(L, "require");
+
+	lua_pushlightuserdata(L, this);
+	lua_pushcclosure(L, SendToMain, 1);
+	lua_setglobal(L, "SendToMain");
+
+	if (luaL_loadbuffer(L, code.c_str(), code.size(), name.c_str()) != 0 || lua_pcall(L, 0, 0, 0) != 0) {
+		SetError(lua_tostring(L, -1));
+		return false;
+	}
+
+	return true;
+}
+
+bool CLuaWorker::CallRecv(const Message& msg)
+{
+	lua_settop(L, 0);
+	lua_getglobal(L, "RecvFromMain");
+
+	// no receiver, nothing to do
+	if (!lua_isfunction(L, -1))
+		return true;
+
+	if (lua_pcall(L, LuaUtils::Restore(msg, L), 0, 0) == 0)
+		return true;
+
+	SetError(lua_tostring(L, -1));
+	return false;
+}
+
+void CLuaWorker::SetError(const char* msg)
+{
+	std::lock_guard<spring::mutex> lck(mutex);
+	error = (msg != nullptr)? msg: "unknown error";
+	breakLoop = true;
+}
+
+
+void CLuaWorker::Run()
+{
+	Threading::SetThreadName("lua-worker");
+
+	std::deque<Message> msgs;
+
+	for (bool running = Setup(); running; msgs.clear()) {
+		{
+			std::unique_lock<spring::mutex> lck(mutex);
+			cond.wait(lck, [&]() { return (breakLoop || !inputs.empty()); });
+
+			if (breakLoop)
+				break;
+
+			std::swap(msgs, inputs);
+		}
+
+		for (const Message& msg: msgs) {
+			if (!(running = CallRecv(msg)))
+				break;
+		}
+	}
+
+	if (L != nullptr)
+		LUA_CLOSE(&L);
+}
+
+
+int CLuaWorker::SendToMain(lua_State* L)
+{
+	CLuaWorker* worker = static_cast<CLuaWorker*>(lua_touserdata(L, lua_upvalueindex(1)));
+	Message msg;
+
+	LuaUtils::Backup(msg, L, lua_gettop(L));
+
+	std::lock_guard<spring::mutex> lck(worker->mutex);
+
+	if (worker->outputs.size() >= MAX_QUEUED_MESSAGES) {
+		lua_pushboolean(L, false);
+		return 1;
+	}
+
+	worker->outputs.emplace_back(std::move(msg));
+	lua_pushboolean(L, true);
+	return 1;
+}
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+bool LuaWorkers::PushEntries(lua_State* L)
+{
+	CreateMetatable(L);
+
+	REGISTER_LUA_CFUNC(CreateLuaWorker);
+	return true;
+}
+
+
+bool LuaWorkers::CreateMetatable(lua_State* L)
+{
+	luaL_newmetatable(L, "LuaWorker");
+
+	HSTR_PUSH_CFUNC(L, "__gc", meta_gc);
+	LuaPushNamedString(L, "__metatable", "protected metatable");
+
+	// methods are looked up in the metatable itself
+	lua_pushliteral(L, "__index");
+	lua_pushvalue(L, -2);
+	lua_rawset(L, -3);
+
+		// push userdata callouts
+		REGISTER_LUA_CFUNC(Send);
+		REGISTER_LUA_CFUNC(Receive);
+		REGISTER_LUA_CFUNC(GetError);
+		REGISTER_LUA_CFUNC(Close);
+
+	lua_pop(L, 1);
+	return true;
+}
+
+
+/******************************************************************************/
+/******************************************************************************/
+
+static CLuaWorker* toworker(lua_State* L, int idx)
+{
+	CLuaWorker** worker = static_cast<CLuaWorker**>(luaL_checkudata(L, idx, "LuaWorker"));
+
+	if (*worker == nullptr)
+		luaL_error(L, "attempt to use a closed worker");
+
+	return *worker;
+}
+
+
+int LuaWorkers::meta_gc(lua_State* L)
+{
+	CLuaWorker** worker = static_cast<CLuaWorker**>(luaL_checkudata(L, 1, "LuaWorker"));
+
+	delete *worker;
+	*worker = nullptr;
+	return 0;
+}
+
+
+int LuaWorkers::CreateLuaWorker(lua_State* L)
+{
+	const std::string code = luaL_checksstring(L, 1);
+	const std::string name = luaL_optsstring(L, 2, "LuaWorker");
+
+	CLuaWorker** worker = static_cast<CLuaWorker**>(lua_newuserdata(L, sizeof(CLuaWorker*)));
+
+	*worker = new CLuaWorker(name, code);
+
+	luaL_getmetatable(L, "LuaWorker");
+	lua_setmetatable(L, -2);
+	return 1;
+}
+
+
+int LuaWorkers::Send(lua_State* L)
+{
+	CLuaWorker* worker = toworker(L, 1);
+	CLuaWorker::Message msg;
+
+	LuaUtils::Backup(msg, L, lua_gettop(L) - 1);
+
+	lua_pushboolean(L, worker->PushInput(std::move(msg)));
+	return 1;
+}
+
+int LuaWorkers::Receive(lua_State* L)
+{
+	CLuaWorker* worker = toworker(L, 1);
+	CLuaWorker::Message msg;
+
+	if (!worker->PopOutput(msg)) {
+		lua_pushboolean(L, false);
+		return 1;
+	}
+
+	lua_pushboolean(L, true);
+	return (1 + LuaUtils::Restore(msg, L));
+}
+
+int LuaWorkers::GetError(lua_State* L)
+{
+	const std::string error = toworker(L, 1)->GetError();
+
+	if (error.empty())
+		return 0;
+
+	lua_pushsstring(L, error);
+	return 1;
+}
+
+int LuaWorkers::Close(lua_State* L)
+{
+	// joins the worker thread, pending replies are lost
+	return (meta_gc(L));
+}
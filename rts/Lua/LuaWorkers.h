@@ -0,0 +1,32 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef LUA_WORKERS_H
+#define LUA_WORKERS_H
+
+struct lua_State;
+
+// Lua code that needs no engine access (layouting, planning, statistics)
+// can be moved into a worker; each worker owns a bare lua_State which is
+// run by its own thread, and exchanges copies of plain data (nil, bool,
+// number, string, table) with the handle that created it
+class LuaWorkers {
+	public:
+		static bool PushEntries(lua_State* L);
+
+	private: // helpers
+		static bool CreateMetatable(lua_State* L);
+
+	private: // metatable methods
+		static int meta_gc(lua_State* L);
+
+	private: // call-outs
+		static int CreateLuaWorker(lua_State* L);
+
+	private: // userdata call-outs
+		static int Send(lua_State* L);
+		static int Receive(lua_State* L);
+		static int GetError(lua_State* L);
+		static int Close(lua_State* L);
+};
+
+#endif /* LUA_WORKERS_H */
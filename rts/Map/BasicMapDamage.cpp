@@ -51,6 +51,7 @@ void CBasicMapDamage::Init()
 	explosionSquaresPool.resize(4 * 1024 * 1024);
 	explosionUpdateQueue.clear();
 	explosionUpdateQueue.reserve(64);
+	recalcRects.clear();
 
 	std::fill(explosionSquaresPool.begin(), explosionSquaresPool.end(), 0.0f);
 }
@@ -225,15 +226,20 @@ void CBasicMapDamage::RecalcArea(int x1, int x2, int y1, int y2)
 	if (updRect.GetArea() <= 0)
 		return;
 
-	readMap->UpdateHeightMapSynced(updRect);
-	featureHandler.TerrainChanged(x1, y1, x2, y2);
+	RecalcRect(updRect);
+}
+
+void CBasicMapDamage::RecalcRect(const SRectangle& rect)
+{
+	readMap->UpdateHeightMapSynced(rect);
+	featureHandler.TerrainChanged(rect.x1, rect.z1, rect.x2, rect.z2);
 	{
 		SCOPED_TIMER("Sim::BasicMapDamage::Los");
-		losHandler->UpdateHeightMapSynced(updRect);
+		losHandler->UpdateHeightMapSynced(rect);
 	}
 	{
 		SCOPED_TIMER("Sim::BasicMapDamage::Path");
-		pathManager->TerrainChange(x1, y1, x2, y2, TERRAINCHANGE_DAMAGE_RECALCULATION);
+		pathManager->TerrainChange(rect.x1, rect.z1, rect.x2, rect.z2, TERRAINCHANGE_DAMAGE_RECALCULATION);
 	}
 }
 
@@ -277,9 +283,23 @@ void CBasicMapDamage::Update()
 		if (e.ttl != 0)
 			continue;
 
-		RecalcArea(e.x1 - 1, e.x2 + 1, e.y1 - 1, e.y2 + 1);
+		recalcRects.push_back({
+			std::max(e.x1 - 1, 0), std::max(e.y1 - 1, 0),
+			std::min(e.x2 + 1, mapDims.mapx), std::min(e.y2 + 1, mapDims.mapy)
+		});
+	}
+
+	// overlapping craters (e.g. from artillery fire) share one recalculation
+	if (readMap->GetHeightMapUpdated()) {
+		recalcRects.Process();
+
+		for (const SRectangle& rect: recalcRects) {
+			RecalcRect(rect);
+		}
 	}
 
+	recalcRects.clear();
+
 
 	// pop explosions that are no longer being processed
 	while (explUpdateQueueIdx < explosionUpdateQueue.size()) {
@@ -13,6 +13,7 @@ CR_REG_METADATA(CMetalMap,(
 	CR_MEMBER(metalScale),
 	CR_MEMBER(sizeX),
 	CR_MEMBER(sizeZ),
+	CR_MEMBER(distributionVersion),
 
 	CR_IGNORED(texturePalette),
 	CR_MEMBER(distributionMap),
@@ -30,6 +31,8 @@ void CMetalMap::Init(const unsigned char* map, int _sizeX, int _sizeZ, float _me
 	sizeX = _sizeX;
 	sizeZ = _sizeZ;
 
+	distributionVersion = 0;
+
 	extractionMap.clear();
 	extractionMap.resize(sizeX * sizeZ, 0.0f);
 	distributionMap.clear();
@@ -84,6 +87,7 @@ void CMetalMap::SetMetalAmount(int x, int z, float m)
 	z = Clamp(z, 0, sizeZ - 1);
 
 	distributionMap[(z * sizeX) + x] = (metalScale == 0.0f) ? 0 : Clamp((int)(m / metalScale), 0, 255);
+	distributionVersion += 1;
 
 	eventHandler.MetalMapChanged(x, z);
 }
@@ -49,6 +49,9 @@ public:
 
 	int GetMetalExtraction(int x, int z) const;
 
+	/** Incremented by every SetMetalAmount call, lets consumers detect stale derived data. */
+	unsigned int GetDistributionVersion() const { return distributionVersion; }
+
 	int GetSizeX() const { return sizeX; }
 	int GetSizeZ() const { return sizeZ; }
 
@@ -64,6 +67,8 @@ private:
 
 	float metalScale = 0.0f;
 
+	unsigned int distributionVersion = 0;
+
 	int sizeX = 0;
 	int sizeZ = 0;
 };
@@ -65,6 +65,7 @@ CR_REG_METADATA(CReadMap, (
 	CR_IGNORED(currHeightBounds),
 	CR_IGNORED(boundingRadius),
 	CR_IGNORED(mapChecksum),
+	CR_IGNORED(numUnsyncedHeightMapUpdates),
 
 	CR_IGNORED(heightMapSyncedPtr),
 	CR_IGNORED(heightMapUnsyncedPtr),
@@ -452,6 +453,7 @@ void CReadMap::UpdateDraw(bool firstCall)
 	// TODO: quadtree or whatever
 	for (size_t i = 0, n = std::min(MAX_UHM_RECTS_PER_FRAME, unsyncedHeightMapUpdates.size()); i < n; i++) {
 		UpdateHeightMapUnsynced(*(unsyncedHeightMapUpdates.begin() + i));
+		numUnsyncedHeightMapUpdates++;
 	}
 
 	for (size_t i = 0, n = std::min(MAX_UHM_RECTS_PER_FRAME, unsyncedHeightMapUpdates.size()); i < n; i++) {
@@ -477,10 +479,10 @@ void CReadMap::UpdateHeightMapSynced(const SRectangle& hgtMapRect, bool initiali
 	const SRectangle centerRect = {std::max(mins.x, 0), std::max(mins.y, 0),  std::min(maxs.x, mapDims.mapxm1),  std::min(maxs.y, mapDims.mapym1)};
 	const SRectangle cornerRect = {std::max(mins.x, 0), std::max(mins.y, 0),  std::min(maxs.x, mapDims.mapx  ),  std::min(maxs.y, mapDims.mapy  )};
 
-	UpdateCenterHeightmap(centerRect, initialize);
+	// one pass over the corner heightmap for both
+	UpdateCenterHeightmapAndFaceNormals(centerRect, initialize);
 	UpdateMipHeightmaps(centerRect, initialize);
-	UpdateFaceNormals(centerRect, initialize);
-	UpdateSlopemap(centerRect, initialize); // must happen after UpdateFaceNormals()!
+	UpdateSlopemap(centerRect, initialize); // must happen after UpdateCenterHeightmapAndFaceNormals()!
 
 	#ifdef USE_UNSYNCED_HEIGHTMAP
 	// push the unsynced update; initial one without LOS check
@@ -716,24 +718,38 @@ void CReadMap::UpdateHeightBounds()
 	currHeightBounds.y = tempHeightBounds.y;
 }
 
-void CReadMap::UpdateCenterHeightmap(const SRectangle& rect, bool initialize)
+void CReadMap::UpdateCenterHeightmapRow(int y, int x1, int x2)
 {
-	const float* heightmapSynced = GetCornerHeightMapSynced();
+	using SIMDVfloat = xsimd::simd_type<float>;
 
-	for (int y = rect.z1; y <= rect.z2; y++) {
-		for (int x = rect.x1; x <= rect.x2; x++) {
-			const int idxTL = (y    ) * mapDims.mapxp1 + x;
-			const int idxTR = (y    ) * mapDims.mapxp1 + x + 1;
-			const int idxBL = (y + 1) * mapDims.mapxp1 + x;
-			const int idxBR = (y + 1) * mapDims.mapxp1 + x + 1;
-
-			const float height =
-				heightmapSynced[idxTL] +
-				heightmapSynced[idxTR] +
-				heightmapSynced[idxBL] +
-				heightmapSynced[idxBR];
-			centerHeightMap[y * mapDims.mapx + x] = height * 0.25f;
-		}
+	constexpr int simdSize = SIMDVfloat::size;
+
+	const float* rowT = &(GetCornerHeightMapSynced())[(y    ) * mapDims.mapxp1];
+	const float* rowB = &(GetCornerHeightMapSynced())[(y + 1) * mapDims.mapxp1];
+
+	float* centerRow = &centerHeightMap[y * mapDims.mapx];
+
+	const SIMDVfloat quarter(0.25f);
+
+	int x = x1;
+
+	// same order of operations as the scalar remainder, results are bit-identical
+	for (; (x + simdSize - 1) <= x2; x += simdSize) {
+		const SIMDVfloat hTL = xsimd::load_unaligned(rowT + x    );
+		const SIMDVfloat hTR = xsimd::load_unaligned(rowT + x + 1);
+		const SIMDVfloat hBL = xsimd::load_unaligned(rowB + x    );
+		const SIMDVfloat hBR = xsimd::load_unaligned(rowB + x + 1);
+
+		xsimd::store_unaligned(centerRow + x, (hTL + hTR + hBL + hBR) * quarter);
+	}
+
+	for (; x <= x2; x++) {
+		const float height =
+			rowT[x    ] +
+			rowT[x + 1] +
+			rowB[x    ] +
+			rowB[x + 1];
+		centerRow[x] = height * 0.25f;
 	}
 }
 
@@ -765,10 +781,11 @@ void CReadMap::UpdateMipHeightmaps(const SRectangle& rect, bool initialize)
 }
 
 
-void CReadMap::UpdateFaceNormals(const SRectangle& rect, bool initialize)
+void CReadMap::UpdateCenterHeightmapAndFaceNormals(const SRectangle& rect, bool initialize)
 {
 	const float* heightmapSynced = GetCornerHeightMapSynced();
 
+	// normals are updated for a one-square border around <rect>
 	const int z1 = std::max(             0, rect.z1 - 1);
 	const int x1 = std::max(             0, rect.x1 - 1);
 	const int z2 = std::min(mapDims.mapym1, rect.z2 + 1);
@@ -778,6 +795,10 @@ void CReadMap::UpdateFaceNormals(const SRectangle& rect, bool initialize)
 		float3 fnTL;
 		float3 fnBR;
 
+		// both read the same two heightmap rows, still in cache for the normals
+		if (y >= rect.z1 && y <= rect.z2)
+			UpdateCenterHeightmapRow(y, rect.x1, rect.x2);
+
 		for (int x = x1; x <= x2; x++) {
 			const int idxTL = (y    ) * mapDims.mapxp1 + x; // TL
 			const int idxBL = (y + 1) * mapDims.mapxp1 + x; // BL
@@ -842,7 +863,7 @@ void CReadMap::UpdateSlopemap(const SRectangle& rect, bool initialize)
 	const int sy = std::max(0,                 (rect.z1 / 2) - 1);
 	const int ey = std::min(mapDims.hmapy - 1, (rect.z2 / 2) + 1);
 
-	for (int y = sy; y <= ey; y++) {
+	for_mt(sy, ey + 1, [&](const int y) {
 		for (int x = sx; x <= ex; x++) {
 			const int idx0 = (y*2    ) * (mapDims.mapx) + x*2;
 			const int idx1 = (y*2 + 1) * (mapDims.mapx) + x*2;
@@ -873,7 +894,7 @@ void CReadMap::UpdateSlopemap(const SRectangle& rect, bool initialize)
 
 			slopeMap[y * mapDims.hmapx + x] = 1.0f - slope;
 		}
-	}
+	});
 }
 
 
@@ -210,13 +210,15 @@ public:
 	void UpdateHeightBounds();
 
 	bool GetHeightMapUpdated() const { return hmUpdated; }
+	/// number of UHM rectangles applied so far; changes whenever the drawn terrain does
+	unsigned int GetNumUnsyncedHeightMapUpdates() const { return numUnsyncedHeightMapUpdates; }
 private:
 	void InitHeightBounds();
 	void UpdateHeightBounds(int syncFrame);
 
-	void UpdateCenterHeightmap(const SRectangle& rect, bool initialize);
+	void UpdateCenterHeightmapRow(int y, int x1, int x2);
 	void UpdateMipHeightmaps(const SRectangle& rect, bool initialize);
-	void UpdateFaceNormals(const SRectangle& rect, bool initialize);
+	void UpdateCenterHeightmapAndFaceNormals(const SRectangle& rect, bool initialize);
 	void UpdateSlopemap(const SRectangle& rect, bool initialize);
 
 	inline void HeightMapUpdateLOSCheck(const SRectangle& hgtMapRect);
@@ -277,6 +279,7 @@ private:
 #endif
 
 	unsigned int mapChecksum = 0;
+	unsigned int numUnsyncedHeightMapUpdates = 0;
 
 	bool processingHeightBounds = false;
 	bool hmUpdated = false;
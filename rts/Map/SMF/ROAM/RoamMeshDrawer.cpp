@@ -227,8 +227,26 @@ void CRoamMeshDrawer::Update()
 		// Check if a retessellation is needed
 		//SCOPED_TIMER("ROAM::ComputeVariance");
 
+		// a variance tree only depends on its own patch's vertices, so (after
+		// large heightmap changes) recompute those of visible dirty patches in
+		// parallel and mark them for tessellation afterwards
+		std::vector<int> dirtyPatches;
+
 		for (int i = 0; i < numPatches; ++i) {
-			//FIXME multithread? don't retessellate on small heightmap changes?
+			if (patches[i].IsVisible(cam) && patches[i].IsDirty())
+				dirtyPatches.push_back(i);
+		}
+
+		for_mt(0, dirtyPatches.size(), [&patches, &dirtyPatches](const int j) {
+			patches[ dirtyPatches[j] ].ComputeVariance();
+		});
+
+		for (const int i: dirtyPatches) {
+			patchesToTesselate[i] = true;
+		}
+
+		for (int i = 0; i < numPatches; ++i) {
+			//FIXME don't retessellate on small heightmap changes?
 			Patch& p = patches[i];
 
 			const bool isVisibleNow = p.IsVisible(cam);
@@ -265,12 +283,7 @@ void CRoamMeshDrawer::Update()
 			// second case, a patch entered visibility:
 			if (isVisibleNow) {
 				numPatchesVisible++;
-				// if it was dirty(had heightmap change) then recompute variances.
-				if (p.IsDirty()) {
-					p.ComputeVariance();
-					// here we can do incremental retesselation?
-					patchesToTesselate[i] = true;
-				}
+				// if it was dirty (had heightmap change) its variances were recomputed above
 
 			#if TESSELATION_DEBUG
 				if (!wasVisible)
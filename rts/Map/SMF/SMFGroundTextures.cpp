@@ -1,6 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <cstdio>
@@ -281,6 +282,8 @@ bool CSMFGroundTextures::RecompressTilesIfNeeded()
 	rg_etc1::etc1_pack_params pack_params;
 	pack_params.m_quality = rg_etc1::cLowQuality; // must be low, all others take _ages_ to process
 
+	ThreadPool::ScopedTaskPriority stp(ThreadPool::PRIORITY_LOW);
+
 	for_mt(0, tiles.size() / 8, [&](const int i) {
 		squish::u8 rgba[64]; // 4x4 pixels * 4 * 1byte channels = 64byte
 		squish::Decompress(rgba, &tiles[i * 8], squish::kDxt1);
@@ -390,11 +393,40 @@ void CSMFGroundTextures::DrawUpdate()
 			if (stretchFactors[y * smfMap->numBigTexX + x] > 16000 && wantedLevel > 0)
 				wantedLevel--;
 
-			if (square->GetMipLevel() != wantedLevel) {
+			if (square->GetMipLevel() == wantedLevel)
+				continue;
+
+			// lowering detail is cheap and frees memory, do it right away
+			if (square->GetMipLevel() < wantedLevel) {
 				LoadSquareTexture(x, y, wantedLevel);
+				continue;
 			}
+
+			loadRequests.push_back({x, y, wantedLevel, dist});
 		}
 	}
+
+	if (loadRequests.empty())
+		return;
+
+	// uploads are synchronous, so a camera jump that raises the detail of many
+	// squares at once is spread over a few frames; closest squares go first and
+	// at least one request is served per frame
+	constexpr int MAX_UPLOAD_BYTES_PER_FRAME = 4 * 1024 * 1024;
+
+	std::sort(loadRequests.begin(), loadRequests.end(), [](const SquareLoadRequest& a, const SquareLoadRequest& b) {
+		return (a.dist < b.dist);
+	});
+
+	for (int i = 0, n = loadRequests.size(), numBytes = 0; i < n && numBytes < MAX_UPLOAD_BYTES_PER_FRAME; i++) {
+		const SquareLoadRequest& req = loadRequests[i];
+		const int mipSqSize = smfMap->bigTexSize >> req.level;
+
+		LoadSquareTexture(req.x, req.y, req.level);
+		numBytes += ((mipSqSize * mipSqSize) / 2);
+	}
+
+	loadRequests.clear();
 }
 
 
@@ -72,6 +72,16 @@ private:
 	static std::vector<float> heightMinima;
 	static std::vector<float> stretchFactors;
 
+	struct SquareLoadRequest {
+		int x;
+		int y;
+		int level;
+		float dist;
+	};
+
+	// detail increases wanted this frame, uploaded nearest-first
+	std::vector<SquareLoadRequest> loadRequests;
+
 	// use Pixel Buffer Objects for async. uploading (DMA)
 	PBO pbo;
 
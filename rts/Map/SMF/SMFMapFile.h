@@ -17,9 +17,11 @@ class CSMFMapFile
 public:
 	CSMFMapFile(                              ): ifs("", "") {                    } // defer Open
 	CSMFMapFile(const std::string& mapFileName): ifs("", "") { Open(mapFileName); } // unitsync
+	CSMFMapFile(const std::string& mapFileName, const CFileView& mapFileView): ifs("", "") { Open(mapFileName, mapFileView); } // unitsync, outside the VFS
 	~CSMFMapFile() { Close(); }
 
 	void Open(const std::string& mapFileName);
+	void Open(const std::string& mapFileName, const CFileView& mapFileView);
 	void Close();
 
 	void ReadMinimap(void* data);
@@ -49,6 +51,7 @@ public:
 	static void ReadMapTileFileHeader(TileFileHeader& head, CFileHandler& file);
 
 private:
+	void ReadHeader(const std::string& mapFileName);
 	bool ReadGrassMap(void* data);
 	void ReadMapHeader(SMFHeader& head, CFileHandler& file);
 	void ReadMapFeatureHeader(MapFeatureHeader& head, CFileHandler& file);
@@ -1,6 +1,8 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <algorithm>
 #include <cstring> // mem{set,cpy}
+#include <future>
 
 #include "SMFReadMap.h"
 #include "SMFGroundTextures.h"
@@ -48,6 +50,16 @@ std::vector<unsigned char> CSMFReadMap::waterHeightColors;
 static std::vector<float> normalPixels;
 static std::vector<unsigned char> shadingPixels;
 
+struct PreloadedBitmap {
+	std::string name;
+	CBitmap bitmap;
+	bool loaded = false;
+};
+
+// filled on a worker while the heightmap is being processed
+static std::vector<PreloadedBitmap> preloadedBitmaps;
+static std::future<void> bitmapPreloader;
+
 
 
 CSMFReadMap::CSMFReadMap(const std::string& mapName): CEventClient("[CSMFReadMap]", 271950, false)
@@ -74,6 +86,7 @@ CSMFReadMap::CSMFReadMap(const std::string& mapName): CEventClient("[CSMFReadMap
 	// Detail Normal Splatting requires at least one splatDetailNormalTexture and a distribution texture
 	haveSplatNormalDistribTexture &= !mapInfo->smf.splatDistrTexName.empty();
 
+	PreloadBitmaps();
 	ParseHeader();
 	LoadHeightMap();
 	CReadMap::Initialize();
@@ -90,10 +103,84 @@ CSMFReadMap::CSMFReadMap(const std::string& mapName): CEventClient("[CSMFReadMap
 	CreateShadingTex();
 	CreateNormalTex();
 
+	// anything not picked up by the Create* functions
+	preloadedBitmaps.clear();
 	mapFile.ReadFeatureInfo();
 }
 
 
+void CSMFReadMap::PreloadBitmaps()
+{
+	// a previous load might have been aborted before it waited
+	if (bitmapPreloader.valid())
+		bitmapPreloader.wait();
+
+	const auto& smf = mapInfo->smf;
+
+	std::vector<std::string> names;
+	names.reserve(16);
+	names.push_back(smf.minimapTexName);
+
+	if (haveSpecularTexture) {
+		names.push_back(smf.specularTexName);
+		names.push_back(smf.skyReflectModTexName);
+		names.push_back(smf.blendNormalsTexName);
+		names.push_back(smf.lightEmissionTexName);
+		names.push_back(smf.parallaxHeightTexName);
+	}
+
+	if (haveSplatDetailDistribTexture) {
+		names.push_back(smf.splatDetailTexName);
+		names.push_back(smf.splatDistrTexName);
+
+		if (haveSplatNormalDistribTexture) {
+			const size_t numNormalTexNames = std::min(smf.splatDetailNormalTexNames.size(), size_t(NUM_SPLAT_DETAIL_NORMALS));
+			names.insert(names.end(), smf.splatDetailNormalTexNames.begin(), smf.splatDetailNormalTexNames.begin() + numNormalTexNames);
+		}
+	}
+
+	names.push_back(smf.grassShadingTexName);
+	names.push_back(smf.detailTexName);
+
+	preloadedBitmaps.clear();
+	preloadedBitmaps.reserve(names.size());
+
+	for (std::string& name: names) {
+		if (name.empty())
+			continue;
+
+		preloadedBitmaps.emplace_back();
+		preloadedBitmaps.back().name = std::move(name);
+	}
+
+	// decoding is serialized by CBitmap, so one worker is as fast as several;
+	// the gain comes from overlapping it with the heightmap and normals setup
+	bitmapPreloader = std::async(std::launch::async, []() {
+		for (PreloadedBitmap& pb: preloadedBitmaps) {
+			pb.loaded = pb.bitmap.Load(pb.name);
+		}
+	});
+}
+
+bool CSMFReadMap::LoadBitmap(CBitmap& bitmap, const std::string& name)
+{
+	if (bitmapPreloader.valid())
+		bitmapPreloader.get();
+
+	const auto pred = [&](const PreloadedBitmap& pb) { return (pb.name == name); };
+	const auto iter = std::find_if(preloadedBitmaps.begin(), preloadedBitmaps.end(), pred);
+
+	if (iter == preloadedBitmaps.end())
+		return (bitmap.Load(name));
+
+	const bool loaded = iter->loaded;
+
+	bitmap = std::move(iter->bitmap);
+	preloadedBitmaps.erase(iter);
+	return loaded;
+}
+
+
 
 void CSMFReadMap::ParseHeader()
 {
@@ -148,7 +235,7 @@ void CSMFReadMap::LoadMinimap()
 {
 	CBitmap minimapTexBM;
 
-	if (minimapTexBM.Load(mapInfo->smf.minimapTexName)) {
+	if (LoadBitmap(minimapTexBM, mapInfo->smf.minimapTexName)) {
 		minimapTex.SetRawTexID(minimapTexBM.CreateTexture());
 		minimapTex.SetRawSize(int2(minimapTexBM.xsize, minimapTexBM.ysize));
 		return;
@@ -200,7 +287,7 @@ void CSMFReadMap::CreateSpecularTex()
 		CBitmap specularTexBM;
 
 		// maps wants specular lighting, but no moderation
-		if (!specularTexBM.Load(mapInfo->smf.specularTexName))
+		if (!LoadBitmap(specularTexBM, mapInfo->smf.specularTexName))
 			specularTexBM.AllocDummy(SColor(255, 255, 255, 255));
 
 		specularTex.SetRawTexID(specularTexBM.CreateTexture());
@@ -211,7 +298,7 @@ void CSMFReadMap::CreateSpecularTex()
 		CBitmap skyReflectModTexBM;
 
 		// no default 1x1 textures for these
-		if (skyReflectModTexBM.Load(mapInfo->smf.skyReflectModTexName)) {
+		if (LoadBitmap(skyReflectModTexBM, mapInfo->smf.skyReflectModTexName)) {
 			skyReflectModTex.SetRawTexID(skyReflectModTexBM.CreateTexture());
 			skyReflectModTex.SetRawSize(int2(skyReflectModTexBM.xsize, skyReflectModTexBM.ysize));
 		}
@@ -220,7 +307,7 @@ void CSMFReadMap::CreateSpecularTex()
 	{
 		CBitmap blendNormalsTexBM;
 
-		if (blendNormalsTexBM.Load(mapInfo->smf.blendNormalsTexName)) {
+		if (LoadBitmap(blendNormalsTexBM, mapInfo->smf.blendNormalsTexName)) {
 			blendNormalsTex.SetRawTexID(blendNormalsTexBM.CreateTexture());
 			blendNormalsTex.SetRawSize(int2(blendNormalsTexBM.xsize, blendNormalsTexBM.ysize));
 		}
@@ -229,7 +316,7 @@ void CSMFReadMap::CreateSpecularTex()
 	{
 		CBitmap lightEmissionTexBM;
 
-		if (lightEmissionTexBM.Load(mapInfo->smf.lightEmissionTexName)) {
+		if (LoadBitmap(lightEmissionTexBM, mapInfo->smf.lightEmissionTexName)) {
 			lightEmissionTex.SetRawTexID(lightEmissionTexBM.CreateTexture());
 			lightEmissionTex.SetRawSize(int2(lightEmissionTexBM.xsize, lightEmissionTexBM.ysize));
 		}
@@ -238,7 +325,7 @@ void CSMFReadMap::CreateSpecularTex()
 	{
 		CBitmap parallaxHeightTexBM;
 
-		if (parallaxHeightTexBM.Load(mapInfo->smf.parallaxHeightTexName)) {
+		if (LoadBitmap(parallaxHeightTexBM, mapInfo->smf.parallaxHeightTexName)) {
 			parallaxHeightTex.SetRawTexID(parallaxHeightTexBM.CreateTexture());
 			parallaxHeightTex.SetRawSize(int2(parallaxHeightTexBM.xsize, parallaxHeightTexBM.ysize));
 		}
@@ -256,7 +343,7 @@ void CSMFReadMap::CreateSplatDetailTextures()
 		// if a map supplies an intensity- AND a distribution-texture for
 		// detail-splat blending, the regular detail-texture is not used
 		// default detail-texture should be all-grey
-		if (!splatDetailTexBM.Load(mapInfo->smf.splatDetailTexName))
+		if (!LoadBitmap(splatDetailTexBM, mapInfo->smf.splatDetailTexName))
 			splatDetailTexBM.AllocDummy(SColor(127, 127, 127, 127));
 
 		splatDetailTex.SetRawTexID(splatDetailTexBM.CreateTexture(texAnisotropyLevels[true], 0.0f, true));
@@ -266,7 +353,7 @@ void CSMFReadMap::CreateSplatDetailTextures()
 	{
 		CBitmap splatDistrTexBM;
 
-		if (!splatDistrTexBM.Load(mapInfo->smf.splatDistrTexName))
+		if (!LoadBitmap(splatDistrTexBM, mapInfo->smf.splatDistrTexName))
 			splatDistrTexBM.AllocDummy(SColor(255, 0, 0, 0));
 
 		splatDistrTex.SetRawTexID(splatDistrTexBM.CreateTexture(texAnisotropyLevels[true], 0.0f, true));
@@ -283,7 +370,7 @@ void CSMFReadMap::CreateSplatDetailTextures()
 
 		CBitmap splatDetailNormalTextureBM;
 
-		if (!splatDetailNormalTextureBM.Load(mapInfo->smf.splatDetailNormalTexNames[i])) {
+		if (!LoadBitmap(splatDetailNormalTextureBM, mapInfo->smf.splatDetailNormalTexNames[i])) {
 			splatDetailNormalTextureBM.Alloc(1, 1, 4);
 			splatDetailNormalTextureBM.GetRawMem()[0] = 127; // RGB is packed standard normal map
 			splatDetailNormalTextureBM.GetRawMem()[1] = 127;
@@ -305,7 +392,7 @@ void CSMFReadMap::CreateGrassTex()
 
 	CBitmap grassShadingTexBM;
 
-	if (!grassShadingTexBM.Load(mapInfo->smf.grassShadingTexName))
+	if (!LoadBitmap(grassShadingTexBM, mapInfo->smf.grassShadingTexName))
 		return;
 
 	// override minimap
@@ -318,7 +405,7 @@ void CSMFReadMap::CreateDetailTex()
 {
 	CBitmap detailTexBM;
 
-	if (!detailTexBM.Load(mapInfo->smf.detailTexName))
+	if (!LoadBitmap(detailTexBM, mapInfo->smf.detailTexName))
 		detailTexBM.AllocDummy();
 
 	detailTex.SetRawTexID(detailTexBM.CreateTexture(texAnisotropyLevels[false], 0.0f, true));
@@ -617,15 +704,14 @@ void CSMFReadMap::UpdateNormalTexture(const SRectangle& update)
 	// Note, it doesn't make sense to use a PBO here.
 	// Cause the upstreamed float32s need to be transformed to float16s, which seems to happen on the CPU!
 
+	// every pixel is overwritten below, no need to clear the buffer first
 #if (SSMF_UNCOMPRESSED_NORMALS == 1)
-	normalPixels.clear();
-	normalPixels.resize(xsize * zsize * 4, 0.0f);
+	normalPixels.resize(xsize * zsize * 4);
 #else
-	normalPixels.clear();
-	normalPixels.resize(xsize * zsize * 2, 0.0f);
+	normalPixels.resize(xsize * zsize * 2);
 #endif
 
-	for (int z = minz; z <= maxz; z++) {
+	for_mt(minz, maxz + 1, [&](const int z) {
 		for (int x = minx; x <= maxx; x++) {
 			const float3& vertNormal = vvn[z * mapDims.mapxp1 + x];
 
@@ -642,7 +728,7 @@ void CSMFReadMap::UpdateNormalTexture(const SRectangle& update)
 			normalPixels[((z - minz) * xsize + (x - minx)) * 2 + 1] = vertNormal.z;
 		#endif
 		}
-	}
+	});
 
 	glBindTexture(GL_TEXTURE_2D, normalsTex.GetID());
 #if (SSMF_UNCOMPRESSED_NORMALS == 1)
@@ -671,8 +757,8 @@ void CSMFReadMap::UpdateShadingTexture(const SRectangle& update)
 		const int ysize = (y2 - y1) + 1; // x1 <= xi <= x2  (not!  x1 <= xi < x2)
 
 		//TODO switch to PBO?
-		shadingPixels.clear();
-		shadingPixels.resize(xsize * ysize * 4, 0.0f);
+		// UpdateShadingTexPart writes all four channels of every pixel
+		shadingPixels.resize(xsize * ysize * 4);
 
 		for_mt(0, ysize, [&](const int y) {
 			const int idx1 = (y + y1) * mapDims.mapx + x1;
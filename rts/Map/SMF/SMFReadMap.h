@@ -11,6 +11,7 @@
 #include "System/type2.h"
 
 
+class CBitmap;
 class CSMFGroundDrawer;
 
 class CSMFReadMap : public CReadMap, public CEventClient
@@ -149,6 +150,7 @@ public:
 
 private:
 	void ParseHeader();
+	void PreloadBitmaps();
 	void LoadHeightMap();
 	void LoadMinimap();
 	void InitializeWaterHeightColors();
@@ -159,6 +161,9 @@ private:
 	void CreateShadingTex();
 	void CreateNormalTex();
 
+	/// takes a bitmap decoded by PreloadBitmaps, or loads it
+	bool LoadBitmap(CBitmap& bitmap, const std::string& name);
+
 	void UpdateVertexNormalsUnsynced(const SRectangle& update);
 	void UpdateFaceNormalsUnsynced(const SRectangle& update);
 	void UpdateNormalTexture(const SRectangle& update);
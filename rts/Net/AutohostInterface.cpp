@@ -3,10 +3,14 @@
 #include "AutohostInterface.h"
 
 #include "Net/Protocol/BaseNetProtocol.h"
+#include "System/Config/ConfigHandler.h"
 #include "System/Log/ILog.h"
 #include "System/Net/Socket.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <limits>
 #include <vector>
 #include <cinttypes>
 
@@ -20,6 +24,10 @@ LOG_REGISTER_SECTION_GLOBAL(LOG_SECTION_AUTOHOST_INTERFACE)
 #endif
 #define LOG_SECTION_CURRENT LOG_SECTION_AUTOHOST_INTERFACE
 
+CONFIG(std::string, AutohostEventFilter).defaultValue("").description("List of event IDs (see AutohostInterface.cpp, e.g. 13 for chat) which are not sent to the autohost, separated by spaces or commas.");
+CONFIG(bool, AutohostBatchEvents).defaultValue(false).description("Pack all autohost events of one server update into a single SERVER_BATCH datagram instead of sending one datagram per event.");
+CONFIG(bool, AutohostStatusEvents).defaultValue(false).description("Periodically send a GAME_STATUS event (frame, speed and cpu usage and ping of all in-game players) to the autohost.");
+
 
 namespace {
 
@@ -48,6 +56,15 @@ enum EVENT
 	/// Server gave out a warning (string warningmessage)
 	SERVER_WARNING = 5,
 
+	/**
+	 * @brief Several events sent in one datagram (only if AutohostBatchEvents is set)
+	 *
+	 * (uint8_t version, {uint16_t size, uint8_t[size] event}[X])
+	 * (X = events until the end of the packet; each embedded event is
+	 * formatted exactly as it would have been on its own)
+	 */
+	SERVER_BATCH = 6,
+
 	/// Player has joined the game (uchar playernumber, string name)
 	PLAYER_JOINED = 10,
 
@@ -87,6 +104,26 @@ enum EVENT
 	 */
 	GAME_LUAMSG = 20,
 
+	/**
+	 * @brief Periodic summary of the game (only if AutohostStatusEvents is set)
+	 *
+	 * (uint32_t frame, float speedfactor, uchar numplayers,
+	 * {uchar playernumber, uchar cpuusage (percent), uint16_t ping (ms)}[numplayers])
+	 */
+	GAME_STATUS = 21,
+
+	/**
+	 * @brief Periodic link latency summary (only if AutohostStatusEvents is set)
+	 *
+	 * (uint32_t frame, uchar numplayers, {uchar playernumber,
+	 * uint16_t rtt p50, uint16_t rtt p95, uint16_t queued p95, uint16_t jitter p95 (all ms),
+	 * uint16_t resent chunks (per mille), uint16_t out-of-order chunks}[numplayers])
+	 *
+	 * Only players connected over the network are included; percentiles are
+	 * the upper bounds of power-of-two buckets, counters saturate at 0xFFFF.
+	 */
+	NET_STATUS = 22,
+
 	/**
 	 * @brief team statistics
 	 * @see CTeam::Statistics for a reference of how to read them
@@ -94,6 +131,9 @@ enum EVENT
 	 */
 	GAME_TEAMSTAT = NETMSG_TEAMSTAT, // should be 60
 };
+
+constexpr std::uint8_t BATCH_VERSION = 1;
+constexpr size_t MAX_BATCH_SIZE = 8192;
 }
 
 using namespace asio;
@@ -101,7 +141,32 @@ using namespace asio;
 AutohostInterface::AutohostInterface(const std::string& remoteIP, int remotePort, const std::string& localIP, int localPort)
 		: autohost(netcode::netservice)
 		, initialized(false)
+		, batchEvents(configHandler->GetBool("AutohostBatchEvents"))
+		, sendGameStatus(configHandler->GetBool("AutohostStatusEvents"))
 {
+	const std::string filter = configHandler->GetString("AutohostEventFilter");
+
+	filteredEvents.fill(false);
+
+	for (const char* str = filter.c_str(); *str != 0; ) {
+		char* end = nullptr;
+		const long event = std::strtol(str, &end, 10);
+
+		if (end == str) {
+			// skip separators
+			str += 1;
+			continue;
+		}
+
+		if (event >= 0 && event < long(filteredEvents.size()))
+			filteredEvents[event] = true;
+
+		str = end;
+	}
+
+	sendNetStatus = sendGameStatus && !filteredEvents[NET_STATUS];
+	sendGameStatus &= !filteredEvents[GAME_STATUS];
+
 	std::string errorMsg = AutohostInterface::TryBindSocket(autohost, remoteIP, remotePort, localIP, localPort);
 
 	if (errorMsg.empty()) {
@@ -183,6 +248,7 @@ void AutohostInterface::SendQuit()
 	uchar msg = SERVER_QUIT;
 
 	Send(asio::buffer(&msg, sizeof(uchar)));
+	Flush();
 }
 
 void AutohostInterface::SendStartPlaying(const unsigned char* gameID, const std::string& demoName)
@@ -276,6 +342,67 @@ void AutohostInterface::SendPlayerDefeated(uchar playerNum)
 	Send(asio::buffer(&msg, 2 * sizeof(uchar)));
 }
 
+void AutohostInterface::SendGameStatus(int frameNum, float speedFactor, const std::vector<PlayerStatus>& playerStats)
+{
+	if (!sendGameStatus || !autohost.is_open())
+		return;
+
+	const std::uint32_t frame = frameNum;
+	const uchar numPlayers = std::min(playerStats.size(), size_t(std::numeric_limits<uchar>::max()));
+
+	std::vector<std::uint8_t> buffer(1 + sizeof(frame) + sizeof(speedFactor) + 1 + numPlayers * 4);
+	unsigned int pos = 0;
+
+	buffer[pos++] = GAME_STATUS;
+
+	memcpy(&buffer[pos], &frame, sizeof(frame));
+	pos += sizeof(frame);
+	memcpy(&buffer[pos], &speedFactor, sizeof(speedFactor));
+	pos += sizeof(speedFactor);
+
+	buffer[pos++] = numPlayers;
+
+	for (unsigned int i = 0; i < numPlayers; i++) {
+		buffer[pos++] = playerStats[i].playerNum;
+		buffer[pos++] = playerStats[i].cpuUsage;
+
+		memcpy(&buffer[pos], &playerStats[i].ping, sizeof(std::uint16_t));
+		pos += sizeof(std::uint16_t);
+	}
+
+	assert(pos == buffer.size());
+	Send(asio::buffer(buffer));
+}
+
+void AutohostInterface::SendNetStatus(int frameNum, const std::vector<PlayerNetStatus>& playerStats)
+{
+	if (!sendNetStatus || !autohost.is_open())
+		return;
+
+	const std::uint32_t frame = frameNum;
+	const uchar numPlayers = std::min(playerStats.size(), size_t(std::numeric_limits<uchar>::max()));
+
+	std::vector<std::uint8_t> buffer(1 + sizeof(frame) + 1 + numPlayers * (1 + sizeof(PlayerNetStatus::values)));
+	unsigned int pos = 0;
+
+	buffer[pos++] = NET_STATUS;
+
+	memcpy(&buffer[pos], &frame, sizeof(frame));
+	pos += sizeof(frame);
+
+	buffer[pos++] = numPlayers;
+
+	for (unsigned int i = 0; i < numPlayers; i++) {
+		buffer[pos++] = playerStats[i].playerNum;
+
+		memcpy(&buffer[pos], &playerStats[i].values[0], sizeof(PlayerNetStatus::values));
+		pos += sizeof(PlayerNetStatus::values);
+	}
+
+	assert(pos == buffer.size());
+	Send(asio::buffer(buffer));
+}
+
 void AutohostInterface::Message(const std::string& message)
 {
 	if (autohost.is_open()) {
@@ -336,7 +463,44 @@ std::string AutohostInterface::GetChatMessage()
 	return "";
 }
 
+void AutohostInterface::Flush()
+{
+	if (batchBuffer.empty())
+		return;
+
+	SendRaw(asio::buffer(batchBuffer));
+	batchBuffer.clear();
+}
+
 void AutohostInterface::Send(asio::mutable_buffers_1 buffer)
+{
+	const std::uint8_t* data = asio::buffer_cast<const std::uint8_t*>(buffer);
+	const std::size_t size = asio::buffer_size(buffer);
+
+	if (size == 0 || filteredEvents[data[0]])
+		return;
+
+	// oversized events (e.g. large Lua messages) always go out on their own
+	if (!batchEvents || size > (MAX_BATCH_SIZE - 4)) {
+		SendRaw(buffer);
+		return;
+	}
+
+	if ((batchBuffer.size() + 2 + size) > MAX_BATCH_SIZE)
+		Flush();
+
+	if (batchBuffer.empty()) {
+		batchBuffer.push_back(SERVER_BATCH);
+		batchBuffer.push_back(BATCH_VERSION);
+	}
+
+	const std::uint16_t eventSize = size;
+
+	batchBuffer.insert(batchBuffer.end(), reinterpret_cast<const std::uint8_t*>(&eventSize), reinterpret_cast<const std::uint8_t*>(&eventSize) + sizeof(eventSize));
+	batchBuffer.insert(batchBuffer.end(), data, data + size);
+}
+
+void AutohostInterface::SendRaw(asio::mutable_buffers_1 buffer)
 {
 	if (autohost.is_open()) {
 		try {
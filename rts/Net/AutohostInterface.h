@@ -3,19 +3,39 @@
 #ifndef AUTOHOST_INTERFACE_H
 #define AUTOHOST_INTERFACE_H
 
+#include <array>
 #include <string>
+#include <vector>
 #include <cinttypes>
 #include <asio/ip/udp.hpp>
 
 /**
  * API for engine <-> autohost (or similar) communication, using UDP over
  * loopback.
+ *
+ * By default every event goes out as its own datagram. AutohostEventFilter
+ * drops events the autohost is not interested in, AutohostBatchEvents packs
+ * all events of one server update into a single (versioned) batch datagram
+ * which is sent by Flush(), and AutohostStatusEvents enables compact
+ * periodic GAME_STATUS and NET_STATUS events summarizing all in-game players.
  */
 class AutohostInterface
 {
 public:
 	typedef unsigned char uchar;
 
+	struct PlayerStatus {
+		uchar playerNum;
+		uchar cpuUsage; ///< in percent
+		std::uint16_t ping; ///< in milliseconds
+	};
+
+	struct PlayerNetStatus {
+		uchar playerNum;
+		/// rtt p50, rtt p95, queued p95, jitter p95, resent per mille, out-of-order
+		std::uint16_t values[6];
+	};
+
 	/**
 	 * @brief Connects to a port on localhost
 	 * @param remoteIP IP of the autohost to connect to
@@ -43,12 +63,21 @@ public:
 	void SendPlayerChat(uchar playerNum, uchar destination, const std::string& msg);
 	void SendPlayerDefeated(uchar playerNum);
 
+	bool WantGameStatus() const { return sendGameStatus; }
+	void SendGameStatus(int frameNum, float speedFactor, const std::vector<PlayerStatus>& playerStats);
+
+	bool WantNetStatus() const { return sendNetStatus; }
+	void SendNetStatus(int frameNum, const std::vector<PlayerNetStatus>& playerStats);
+
 	void Message(const std::string& message);
 	void Warning(const std::string& message);
 
 	void SendLuaMsg(const std::uint8_t* msg, size_t msgSize);
 	void Send(const std::uint8_t* msg, size_t msgSize);
 
+	/// sends out all batched events, no-op unless AutohostBatchEvents is set
+	void Flush();
+
 	/**
 	 * @brief Receive a chat message from the autohost
 	 * There should be only 1 message per UDP-Packet, and it will use the hosts
@@ -58,6 +87,7 @@ public:
 
 private:
 	void Send(asio::mutable_buffers_1 sendBuffer);
+	void SendRaw(asio::mutable_buffers_1 sendBuffer);
 
 	/**
 	 * Tries to bind a socket for communication with a UDP server.
@@ -77,6 +107,13 @@ private:
 
 	asio::ip::udp::socket autohost;
 	bool initialized;
+
+	bool batchEvents;
+	bool sendGameStatus;
+	bool sendNetStatus;
+
+	std::array<bool, 256> filteredEvents;
+	std::vector<std::uint8_t> batchBuffer;
 };
 
 #endif // AUTOHOST_INTERFACE_H
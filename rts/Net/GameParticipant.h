@@ -8,6 +8,7 @@
 #include "Game/Players/PlayerBase.h"
 #include "Game/Players/PlayerStatistics.h"
 #include "System/Net/LoopbackConnection.h"
+#include "System/SmallVectorMap.h"
 #include "System/UnorderedMap.hpp"
 
 namespace netcode
@@ -58,7 +59,7 @@ public:
 	};
 
 	std::shared_ptr<netcode::CConnection> clientLink;
-	spring::unordered_map<uint8_t, ClientLinkData> aiClientLinks;
+	spring::SmallVectorMap<uint8_t, ClientLinkData> aiClientLinks;
 
 	#ifdef SYNCCHECK
 	spring::unordered_map<int, unsigned int> syncResponse; // syncResponse[frameNum] = checksum
@@ -4,6 +4,7 @@
 #include "System/Net/UDPConnection.h"
 
 #include <functional>
+#include <limits>
 
 #if defined DEDICATED || defined DEBUG
 	#include <iostream>
@@ -21,8 +22,10 @@
 #include "Game/Action.h"
 #include "Game/ChatMessage.h"
 #include "Game/CommandMessage.h"
+#include "Game/GameVersion.h"
 #include "Game/GlobalUnsynced.h" // for syncdebug
 #ifndef DEDICATED
+#include "Game/DemoBenchmark.h"
 #include "Game/IVideoCapturing.h"
 #endif
 #include "Game/Players/Player.h"
@@ -39,6 +42,7 @@
 #include "System/CRC.h"
 #include "System/GlobalConfig.h"
 #include "System/MsgStrings.h"
+#include "System/SafeUtil.h"
 #include "System/SpringMath.h"
 #include "System/SpringExitCode.h"
 #include "System/SpringFormat.h"
@@ -55,6 +59,7 @@
 #include "System/Log/ILog.h"
 #include "System/Platform/errorhandler.h"
 #include "System/Platform/Threading.h"
+#include "System/Sync/SyncChecker.h"
 #include "System/Threading/SpringThreading.h"
 
 #ifndef DEDICATED
@@ -72,6 +77,7 @@ CONFIG(int, SpeedControl).defaultValue(1).minimumValue(1).maximumValue(2)
 	.description("Sets how server adjusts speed according to player's load (CPU), 1: use average, 2: use highest");
 CONFIG(bool, AllowSpectatorJoin).defaultValue(true).dedicatedValue(false).description("allow any unauthenticated clients to join as spectator with any name, name will be prefixed with ~");
 CONFIG(bool, WhiteListAdditionalPlayers).defaultValue(true);
+CONFIG(int, SpectatorNetworkChunksPerSec).defaultValue(30).minimumValue(1).maximumValue(30).description("Maximum number of UDP chunks per second sent to each spectator. Lower values bundle more data per packet, cutting per-packet overhead on servers with many spectators at the cost of spectator latency.");
 CONFIG(bool, ServerRecordDemos).defaultValue(false).dedicatedValue(true);
 CONFIG(bool, ServerLogInfoMessages).defaultValue(false);
 CONFIG(bool, ServerLogDebugMessages).defaultValue(false);
@@ -120,7 +126,7 @@ decltype(CGameServer::commandBlacklist) CGameServer::commandBlacklist{
 	"nopause", "nohelp", "cheat", "godmode", "globallos",
 	"nocost", "forcestart", "nospectatorchat", "nospecdraw",
 	"skip", "reloadcob", "reloadcegs", "devlua", "editdefs",
-	"singlestep", "spec", "specbynum"
+	"singlestep", "spec", "specbynum", "netstats"
 };
 
 
@@ -163,6 +169,7 @@ void CGameServer::Initialize()
 	whiteListAdditionalPlayers = configHandler->GetBool("WhiteListAdditionalPlayers");
 	logInfoMessages = configHandler->GetBool("ServerLogInfoMessages");
 	logDebugMessages = configHandler->GetBool("ServerLogDebugMessages");
+	specChunksPerSec = configHandler->GetInt("SpectatorNetworkChunksPerSec");
 
 	rng.Seed((myGameData->GetSetupText()).length());
 
@@ -359,6 +366,10 @@ void CGameServer::AddLocalClient(const std::string& myName, const std::string& m
 	assert(!HasLocalClient());
 
 	localClientNumber = BindConnection(std::shared_ptr<netcode::CConnection>(new netcode::CLocalConnection()), myName, "", myVersion, myPlatform, true);
+
+#ifndef DEDICATED
+	stepFrames = SpringVersion::IsHeadless() && (configHandler->GetInt("HeadlessStepFrames") > 0);
+#endif
 }
 
 void CGameServer::AddAutohostInterface(const std::string& autohostIP, const int autohostPort)
@@ -535,6 +546,11 @@ bool CGameServer::SendDemoData(int targetFrameNum)
 		demoReader.reset();
 		Message(DemoEnd);
 
+		#ifndef DEDICATED
+		if (demoBenchmark.IsEnabled())
+			demoBenchmark.SetNumDemoFrames(serverFrameNum);
+		#endif
+
 		ret = false;
 	}
 
@@ -745,6 +761,17 @@ void CGameServer::CheckSync()
 
 					PrivateMessage(p.first, spring::format(SyncError, players[p.first].name.c_str(), outstandingSyncFrame, p.second, correctChecksum));
 				}
+
+				// ask everyone for their subsystem checksums of this frame to narrow the desync down
+				if (haveCorrectChecksum) {
+					syncTreeReference.clear();
+					syncTreeResponses.clear();
+
+					syncTreeFrame = outstandingSyncFrame;
+					syncTreeChecksum = correctChecksum;
+
+					Broadcast(CBaseNetProtocol::Get().SendSyncTreeRequest(outstandingSyncFrame));
+				}
 			}
 		}
 
@@ -772,6 +799,49 @@ void CGameServer::CheckSync()
 #endif
 }
 
+void CGameServer::CheckSyncTree(int playerNum, const std::vector<uint32_t>& subsysChecksums)
+{
+#ifdef SYNCCHECK
+	const auto ReportSubsystems = [&](int desyncedPlayerNum, const std::vector<uint32_t>& checksums) {
+		std::string subsysNames;
+
+		for (unsigned int i = 0; i < CSyncChecker::SUBSYS_COUNT; i++) {
+			if (checksums[i] == syncTreeReference[i])
+				continue;
+
+			if (!subsysNames.empty())
+				subsysNames += ", ";
+
+			subsysNames += CSyncChecker::GetSubsystemName(i);
+		}
+
+		Message(spring::format(SyncTreeError, players[desyncedPlayerNum].name.c_str(), syncTreeFrame, subsysNames.c_str()));
+	};
+
+	if (CSyncChecker::CombineChecksums(subsysChecksums.data()) != syncTreeChecksum) {
+		if (syncTreeReference.empty()) {
+			syncTreeResponses.emplace_back(playerNum, subsysChecksums);
+			return;
+		}
+
+		ReportSubsystems(playerNum, subsysChecksums);
+		return;
+	}
+
+	if (!syncTreeReference.empty())
+		return;
+
+	syncTreeReference = subsysChecksums;
+
+	for (const auto& response: syncTreeResponses) {
+		ReportSubsystems(response.first, response.second);
+	}
+
+	syncTreeResponses.clear();
+#endif
+}
+
+
 
 float CGameServer::GetDemoTime() const {
 	if (!gameHasStarted) return gameTime;
@@ -856,8 +926,40 @@ void CGameServer::Update()
 		if ((quitServer = (quitServer || !hasPlayers)))
 			Message(NoClientsExit);
 	}
+
+	if (hostif != nullptr)
+		hostif->Flush();
+}
+
+
+
+spring_time CGameServer::GetNextFrameTime() const
+{
+	const float framesPerMSec = GAME_SPEED * 0.001f * internalSpeed;
+
+	if (framesPerMSec <= 0.0f)
+		return (lastNewFrameTick + spring_msecs(loopSleepTime));
+
+	// CreateNewFrame rounds up, a frame is due once frameTimeLeft turns positive
+	return (lastNewFrameTick + spring_time::fromMicroSecs((std::max(0.0f, -frameTimeLeft) / framesPerMSec) * 1000.0f));
 }
 
+void CGameServer::CreateDueFrames()
+{
+	// all other cases are handled by Update
+	if (!gameHasStarted || PreSimFrame() || isPaused || demoReader != nullptr)
+		return;
+	if (spring_gettime() < GetNextFrameTime())
+		return;
+
+	CreateNewFrame(true, false);
+
+	// do not wait for the end of the burst to send them out
+	for (GameParticipant& p: players) {
+		if (p.clientLink != nullptr)
+			p.clientLink->Flush();
+	}
+}
 
 
 void CGameServer::LagProtection()
@@ -867,6 +969,9 @@ void CGameServer::LagProtection()
 	cpu.reserve(players.size());
 	ping.reserve(players.size());
 
+	std::vector<AutohostInterface::PlayerStatus> hostifStatus;
+	std::vector<AutohostInterface::PlayerNetStatus> hostifNetStatus;
+
 	// detect reference cpu usage ( highest )
 	float refCpuUsage = 0.0f;
 	for (GameParticipant& player: players) {
@@ -875,6 +980,26 @@ void CGameServer::LagProtection()
 			const int curPing = ((serverFrameNum - player.lastFrameResponse) * 1000) / (GAME_SPEED * internalSpeed);
 			Broadcast(CBaseNetProtocol::Get().SendPlayerInfo(player.id, player.cpuUsage, curPing));
 
+			if (hostif != nullptr && hostif->WantGameStatus())
+				hostifStatus.push_back({uint8_t(player.id), uint8_t(Clamp(player.cpuUsage, 0.0f, 1.0f) * 100.0f), uint16_t(Clamp(curPing, 0, 0xFFFF))});
+
+			if (hostif != nullptr && hostif->WantNetStatus() && player.clientLink != nullptr) {
+				const netcode::NetTimingStats* stats = player.clientLink->GetTimingStats();
+
+				if (stats != nullptr) {
+					const auto clamp16 = [](unsigned int v) { return uint16_t(std::min(v, 0xFFFFu)); };
+
+					hostifNetStatus.push_back({uint8_t(player.id), {
+						clamp16(stats->roundTrip.GetPercentile(0.5f)),
+						clamp16(stats->roundTrip.GetPercentile(0.95f)),
+						clamp16(stats->outgoingQueue.GetPercentile(0.95f)),
+						clamp16(stats->frameJitter.GetPercentile(0.95f)),
+						clamp16(unsigned(spring::SafeDivide(stats->resentChunks * 1000.0f, stats->sentChunks * 1.0f))),
+						clamp16(stats->outOfOrderChunks),
+					}});
+				}
+			}
+
 			const float playerCpuUsage = player.cpuUsage;
 			const float correctedCpu   = Clamp(playerCpuUsage, 0.0f, 1.0f);
 
@@ -890,6 +1015,11 @@ void CGameServer::LagProtection()
 		}
 	}
 
+	if (!hostifStatus.empty())
+		hostif->SendGameStatus(serverFrameNum, internalSpeed, hostifStatus);
+	if (!hostifNetStatus.empty())
+		hostif->SendNetStatus(serverFrameNum, hostifNetStatus);
+
 	// calculate median values
 	medianCpu = 0.0f;
 	medianPing = 0;
@@ -1199,6 +1329,7 @@ void CGameServer::ProcessPacket(const unsigned playerNum, std::shared_ptr<const
 			break;
 
 		case NETMSG_SELECT:
+		case NETMSG_SELECT_DELTA:
 			try {
 				netcode::UnpackPacket pckt(packet, 3);
 				unsigned char playerNum;
@@ -1348,6 +1479,44 @@ void CGameServer::ProcessPacket(const unsigned playerNum, std::shared_ptr<const
 #endif
 		} break;
 
+		case NETMSG_SYNCTREE_RESPONSE: {
+#ifdef SYNCCHECK
+			try {
+				netcode::UnpackPacket pckt(packet, 1);
+
+				uint8_t packetSize; pckt >> packetSize;
+				uint8_t  playerNum; pckt >> playerNum;
+				int32_t   frameNum; pckt >> frameNum;
+				uint32_t  checkSum; pckt >> checkSum;
+
+				if (playerNum != a) {
+					Message(spring::format(WrongPlayer, msgCode, a, (unsigned)playerNum));
+					break;
+				}
+
+				// stale answer to an earlier request
+				if (frameNum != syncTreeFrame)
+					break;
+
+				const unsigned int numChecksums = (packetSize - (sizeof(uint8_t) * 3 + sizeof(frameNum) + sizeof(checkSum))) / sizeof(uint32_t);
+
+				if (numChecksums != CSyncChecker::SUBSYS_COUNT)
+					throw netcode::UnpackPacketException("Invalid number of subsystem checksums");
+
+				std::vector<uint32_t> subsysChecksums(numChecksums);
+				pckt >> subsysChecksums;
+
+				// reply must be consistent with the checksum this player sent in its sync-response
+				if (CSyncChecker::CombineChecksums(subsysChecksums.data()) != checkSum)
+					throw netcode::UnpackPacketException("Subsystem checksums do not match checksum");
+
+				CheckSyncTree(a, subsysChecksums);
+			} catch (const netcode::UnpackPacketException& ex) {
+				Message(spring::format("[GameServer::%s][NETMSG_SYNCTREE_RESPONSE] exception \"%s\" from player \"%s\"", __func__, ex.what(), players[a].name.c_str()));
+			}
+#endif
+		} break;
+
 		case NETMSG_SHARE:
 			if (inbuf[1] != a) {
 				Message(spring::format(WrongPlayer, msgCode, a, (unsigned)inbuf[1]));
@@ -1919,7 +2088,7 @@ void CGameServer::ServerReadNet()
 		std::shared_ptr<netcode::CConnection>& playerLink = player.clientLink;
 		std::shared_ptr<const RawPacket> packet;
 
-		spring::unordered_map<uint8_t, GameParticipant::ClientLinkData>& aiClientLinks = player.aiClientLinks;
+		spring::SmallVectorMap<uint8_t, GameParticipant::ClientLinkData>& aiClientLinks = player.aiClientLinks;
 		std::array<uint8_t, MAX_AIS + 1> aiClientNumbers;
 
 		// if no link, player is not connected
@@ -1962,7 +2131,7 @@ void CGameServer::ServerReadNet()
 		}
 
 
-		// copy client AI id's; ProcessPacket() can cause aiClientLinks to be rehashed during iteration below
+		// copy client AI id's; ProcessPacket() can cause aiClientLinks to be modified during iteration below
 		aiClientNumbers.fill(0);
 
 		for (const auto& pair: aiClientLinks) {
@@ -2015,6 +2184,8 @@ void CGameServer::ServerReadNet()
 
 				// non-droppable packets may be processed more than once, but this does no harm
 				ProcessPacket(player.id, aiPacket);
+				// a large burst (e.g. of LUAMSG's) must not hold back frames for everyone
+				CreateDueFrames();
 
 				if (globalConfig.linkIncomingPeakBandwidth > 0 && droppablePacket) {
 					bandwidthUsage += std::max((unsigned)linkMinPacketSize, aiPacket->length);
@@ -2155,6 +2326,12 @@ void CGameServer::StartGame(bool forced)
 		// the client told us to start a demo
 		// no need to send startPos and startplaying since its in the demo
 		Message(DemoStart);
+
+		#ifndef DEDICATED
+		// benchmarking; push the (entire) demo to the client at once
+		if (demoBenchmark.IsEnabled())
+			SkipTo((demoBenchmark.GetNumFrames() > 0)? demoBenchmark.GetNumFrames(): std::numeric_limits<int>::max());
+		#endif
 		return;
 	}
 
@@ -2497,6 +2674,34 @@ void CGameServer::PushAction(const Action& action, bool fromAutoHost)
 			}
 		} break;
 
+		case hashString("netstats"): {
+			// shown to the host and forwarded to the autohost
+			unsigned int numLinks = 0;
+
+			for (const GameParticipant& p: players) {
+				if (p.clientLink == nullptr)
+					continue;
+
+				const netcode::NetTimingStats* stats = p.clientLink->GetTimingStats();
+
+				if (stats == nullptr)
+					continue;
+
+				Message(spring::format(NetStatsLine, p.name.c_str(), p.id,
+					stats->roundTrip.GetPercentile(0.5f), stats->roundTrip.GetPercentile(0.95f),
+					stats->unackedTime.GetPercentile(0.95f), stats->outgoingQueue.GetPercentile(0.95f),
+					stats->frameJitter.GetPercentile(0.95f),
+					spring::SafeDivide(stats->resentChunks * 100.0f, stats->sentChunks * 1.0f),
+					stats->outOfOrderChunks, stats->duplicateChunks
+				), false);
+
+				numLinks += 1;
+			}
+
+			if (numLinks == 0)
+				Message(NetStatsNone, false);
+		} break;
+
 		case hashString("kill"): {
 			LOG("Server killed!");
 			quitServer = true;
@@ -2548,10 +2753,11 @@ void CGameServer::CreateNewFrame(bool fromServerThread, bool fixedFrameTime)
 
 	CheckSync();
 #ifndef DEDICATED
-	const bool vidRecording = videoCapturing->AllowRecord();
+	const bool vidRecording = videoCapturing->AllowRecord() || stepFrames;
 #else
 	const bool vidRecording = false;
 #endif
+	// both leave frame pacing to the local client
 	const bool normalFrame = !isPaused && !vidRecording;
 	const bool videoFrame = !isPaused && fixedFrameTime;
 	const bool singleStep = fixedFrameTime && !vidRecording;
@@ -2676,8 +2882,14 @@ void CGameServer::UpdateLoop()
 		Threading::SetThreadName("netcode");
 		Threading::SetAffinity(~0);
 
+		spring_time wakeTime = spring_gettime() + spring_msecs(loopSleepTime);
+
 		while (!quitServer) {
-			spring_msecs(loopSleepTime).sleep(true);
+			// wake up early if the next frame is due before the regular interval ends
+			spring_time sleepTime = wakeTime - spring_gettime();
+
+			if (sleepTime > spring_notime)
+				sleepTime.sleep(true);
 
 			if (udpListener != nullptr)
 				udpListener->Update();
@@ -2685,6 +2897,11 @@ void CGameServer::UpdateLoop()
 			std::lock_guard<spring::recursive_mutex> scoped_lock(gameServerMutex);
 			ServerReadNet();
 			Update();
+
+			wakeTime = spring_gettime() + spring_msecs(loopSleepTime);
+
+			if (gameHasStarted && !isPaused && demoReader == nullptr)
+				wakeTime = std::min(wakeTime, GetNextFrameTime());
 		}
 
 		if (hostif != nullptr)
@@ -2971,6 +3188,10 @@ unsigned CGameServer::BindConnection(
 
 		Message(spring::format(" -> Connection reestablished (id %i)", newPlayerNumber));
 		newPlayer.clientLink->SetLossFactor(netloss);
+
+		if (newPlayer.spectator)
+			newPlayer.clientLink->SetChunksPerSec(specChunksPerSec);
+
 		newPlayer.clientLink->Flush(!gameHasStarted);
 		return newPlayerNumber;
 	}
@@ -3002,6 +3223,11 @@ unsigned CGameServer::BindConnection(
 	// new connection established
 	Message(spring::format(" -> Connection established (given id %i)", newPlayerNumber));
 	clientLink->SetLossFactor(netloss);
+
+	// spectators tolerate latency, fewer but larger packets relieve the host uplink
+	if (newPlayer.spectator)
+		clientLink->SetChunksPerSec(specChunksPerSec);
+
 	clientLink->Flush(!gameHasStarted);
 	return newPlayerNumber;
 }
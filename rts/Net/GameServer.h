@@ -93,6 +93,7 @@ public:
 	void SetReloading(const bool arg) { reloadingServer = arg; }
 
 	bool PreSimFrame() const { return (serverFrameNum == -1); }
+	int GetServerFrameNum() const { return serverFrameNum; }
 	bool HasStarted() const { return gameHasStarted; }
 	bool HasGameID() const { return generatedGameID; }
 	bool HasLocalClient() const { return (localClientNumber != -1u); }
@@ -161,11 +162,17 @@ private:
 	void Update();
 	void ProcessPacket(const unsigned playerNum, std::shared_ptr<const netcode::RawPacket> packet);
 	void CheckSync();
+	void CheckSyncTree(int playerNum, const std::vector<uint32_t>& subsysChecksums);
 	void HandleConnectionAttempts();
 	void ServerReadNet();
 
 	void LagProtection();
 
+	/// when CreateNewFrame will have the next (non-fixed time) frame to emit
+	spring_time GetNextFrameTime() const;
+	/// emit frames that became due while a long burst of packets is processed
+	void CreateDueFrames();
+
 	/** @brief Generate a unique game identifier and send it to all clients. */
 	void GenerateAndSendGameID();
 
@@ -226,6 +233,14 @@ private:
 	/////////////////// sync stuff ///////////////////
 #ifdef SYNCCHECK
 	std::set<int> outstandingSyncFrames;
+
+	/// subsystem checksums of a player that had the correct checksum for syncTreeFrame
+	std::vector<uint32_t> syncTreeReference;
+	/// subsystem checksums of desynced players received before the reference
+	std::vector< std::pair<int, std::vector<uint32_t>> > syncTreeResponses;
+
+	int syncTreeFrame = -1;
+	unsigned int syncTreeChecksum = 0;
 #endif
 
 	/////////////////// game status variables ///////////////////
@@ -249,6 +264,7 @@ private:
 	int medianPing = 0;
 	int curSpeedCtrl = 0;
 	int loopSleepTime = 0;
+	int specChunksPerSec = 30;
 
 
 	int serverFrameNum = -1;
@@ -280,9 +296,12 @@ private:
 	bool logInfoMessages = false;
 	bool logDebugMessages = false;
 
+	/// frames are only created on request of the headless host, see HeadlessStepFrames
+	bool stepFrames = false;
+
 
 	/// If the server receives a command, it will forward it to clients if it is not in this set
-	static std::array<std::string, 25> commandBlacklist;
+	static std::array<std::string, 26> commandBlacklist;
 
 	std::unique_ptr<netcode::UDPListener> udpListener;
 	std::unique_ptr<CDemoReader> demoReader;
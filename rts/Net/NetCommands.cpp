@@ -1,5 +1,6 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <array>
 #include <cinttypes>
 
 #include "Game/Game.h"
@@ -44,6 +45,18 @@ LOG_REGISTER_SECTION_GLOBAL(LOG_SECTION_NET)
 
 static spring::unordered_map<int32_t, uint32_t> localSyncChecksums;
 
+#ifdef SYNCCHECK
+// per-subsystem checksums of the most recent frames, sent to the server on request
+// (it only asks once the top-level checksum of some frame has been found to differ)
+struct SyncTreeEntry {
+	int32_t frameNum = -1;
+	uint32_t checksum = 0;
+	uint32_t subsysChecksums[CSyncChecker::SUBSYS_COUNT];
+};
+
+static std::array<SyncTreeEntry, 1024> syncTreeHistory;
+#endif
+
 
 void CGame::AddTraffic(int playerID, int packetCode, int length)
 {
@@ -88,7 +101,7 @@ void CGame::SendClientProcUsage()
 }
 
 
-uint32_t CGame::GetNumQueuedSimFrameMessages(uint32_t maxFrames) const
+uint32_t CGame::GetNumQueuedSimFrameMessages(uint32_t maxFrames)
 {
 	// read ahead to find number of NETMSG_XXXFRAMES we still have to process
 	// this number is effectively a measure of current user network conditions
@@ -113,7 +126,7 @@ uint32_t CGame::GetNumQueuedSimFrameMessages(uint32_t maxFrames) const
 				// it's meant to indicate current game progress for clients fast-forwarding to current point the game
 				// NOTE: this event should be unsynced, since its time reference frame is not related to the current
 				// progress of the game from the client's point of view
-				eventHandler.GameProgress(*reinterpret_cast<int32_t*>(packet->data + 1));
+				eventHandler.GameProgress(serverFrameNum = *reinterpret_cast<int32_t*>(packet->data + 1));
 				clientNet->DeleteBufferPacketAt(packetPeekIndex);
 			} break;
 
@@ -219,8 +232,14 @@ float CGame::GetNetMessageProcessingTimeLimit() const
 	//  -> try to spend minimum 20% of the time in drawing
 	//  -> use remaining 80% for reconnecting
 	// (maxSimFPS / minDrawFPS) is desired number of simframes per drawframe
-	const float maxSimFPS    = (1.0f - CGlobalUnsynced::reconnectSimDrawBalance) * 1000.0f / std::max(0.01f, gu->avgSimFrameTime);
-	const float minDrawFPS   =         CGlobalUnsynced::reconnectSimDrawBalance  * 1000.0f / std::max(0.01f, gu->avgDrawFrameTime);
+	// while still more than CATCHUP_MIN_FRAMES behind the server, drawing is
+	// cut back further since nothing worth watching happens until we are live
+	constexpr int CATCHUP_MIN_FRAMES = GAME_SPEED * 10;
+
+	const bool  catchingUp   = ((serverFrameNum - gs->frameNum) > CATCHUP_MIN_FRAMES);
+	const float simDrawBal   = catchingUp? CGlobalUnsynced::catchupSimDrawBalance: CGlobalUnsynced::reconnectSimDrawBalance;
+	const float maxSimFPS    = (1.0f - simDrawBal) * 1000.0f / std::max(0.01f, gu->avgSimFrameTime);
+	const float minDrawFPS   =         simDrawBal  * 1000.0f / std::max(0.01f, gu->avgDrawFrameTime);
 	const float simDrawRatio = maxSimFPS / minDrawFPS;
 
 	return Clamp(simDrawRatio * gu->avgSimFrameTime, 5.0f, 1000.0f / CGlobalUnsynced::minDrawFPS);
@@ -567,6 +586,14 @@ void CGame::ClientReadNet()
 				ASSERT_SYNCED(CSyncChecker::GetChecksum());
 				clientNet->Send(CBaseNetProtocol::Get().SendSyncResponse(gu->myPlayerNum, gs->frameNum, CSyncChecker::GetChecksum()));
 
+				{
+					SyncTreeEntry& entry = syncTreeHistory[gs->frameNum % syncTreeHistory.size()];
+
+					entry.frameNum = gs->frameNum;
+					entry.checksum = CSyncChecker::GetChecksum();
+					std::copy(CSyncChecker::GetSubsystemChecksums(), CSyncChecker::GetSubsystemChecksums() + CSyncChecker::SUBSYS_COUNT, entry.subsysChecksums);
+				}
+
 				// buffer all checksums, so we can check sync later between demo & local
 				if (haveServerDemo)
 					localSyncChecksums[gs->frameNum] = CSyncChecker::GetChecksum();
@@ -613,6 +640,26 @@ void CGame::ClientReadNet()
 			} break;
 
 
+			case NETMSG_SYNCTREE_REQUEST: {
+#if (defined(SYNCCHECK))
+				// demo servers replay the requests of the original game
+				if (haveServerDemo)
+					break;
+
+				const int32_t frameNum = *reinterpret_cast<const int32_t*>(&inbuf[1]);
+				const SyncTreeEntry& entry = syncTreeHistory[std::max(frameNum, 0) % syncTreeHistory.size()];
+
+				if (entry.frameNum != frameNum) {
+					LOG_L(L_WARNING, "[Game::%s] no subsystem checksums left for frame %d", __func__, frameNum);
+					break;
+				}
+
+				const std::vector<uint32_t> checksums(entry.subsysChecksums, entry.subsysChecksums + CSyncChecker::SUBSYS_COUNT);
+
+				clientNet->Send(CBaseNetProtocol::Get().SendSyncTreeResponse(gu->myPlayerNum, frameNum, entry.checksum, checksums));
+#endif
+			} break;
+
 			case NETMSG_COMMAND: {
 				try {
 					netcode::UnpackPacket pckt(packet, 1);
@@ -688,6 +735,58 @@ void CGame::ClientReadNet()
 				}
 			} break;
 
+			case NETMSG_SELECT_DELTA: {
+				try {
+					netcode::UnpackPacket pckt(packet, 1);
+					std::vector<int32_t> selectedUnitIDs;
+
+					uint16_t packetSize; pckt >> packetSize;
+					uint8_t playerNum; pckt >> playerNum;
+
+					if (!playerHandler.IsValidPlayer(playerNum))
+						throw netcode::UnpackPacketException("Invalid player number");
+
+					const CPlayer* netPlayer = playerHandler.Player(playerNum);
+					const CUnit* unit = nullptr;
+
+					int32_t unitID = -1;
+					uint32_t delta = 0;
+					uint32_t shift = 0;
+
+					selectedUnitIDs.reserve(packetSize - 4);
+
+					for (uint32_t a = 4; a < packetSize; ++a) {
+						uint8_t deltaByte; pckt >> deltaByte;
+
+						delta |= ((deltaByte & 0x7F) << shift);
+						shift += 7;
+
+						if ((deltaByte & 0x80) != 0) {
+							if (shift > 14)
+								throw netcode::UnpackPacketException("Invalid unitID delta");
+
+							continue;
+						}
+
+						unitID += (delta + 1);
+						delta = 0;
+						shift = 0;
+
+						// same checks as for NETMSG_SELECT
+						if ((unit = unitHandler.GetUnit(unitID)) == nullptr)
+							continue;
+
+						if (netPlayer->CanControlTeam(unit->team))
+							selectedUnitIDs.push_back(unitID);
+					}
+
+					selectedUnitsHandler.NetSelect(selectedUnitIDs, playerNum);
+					AddTraffic(playerNum, packetCode, dataLength);
+				} catch (const netcode::UnpackPacketException& ex) {
+					LOG_L(L_ERROR, "[Game::%s][NETMSG_SELECT_DELTA] exception \"%s\"", __func__, ex.what());
+				}
+			} break;
+
 			case NETMSG_AICOMMAND:
 			case NETMSG_AICOMMAND_TRACKED: {
 				try {
@@ -7,6 +7,7 @@
 #include "System/Net/RawPacket.h"
 #include "System/Net/PackPacket.h"
 #include "System/Net/ProtocolDef.h"
+#include <algorithm>
 #include <cinttypes>
 
 using netcode::PackPacket;
@@ -97,8 +98,42 @@ PacketType CBaseNetProtocol::SendPathCheckSum(uint8_t playerNum, uint32_t checks
 
 PacketType CBaseNetProtocol::SendSelect(uint8_t playerNum, const std::vector<int16_t>& selectedUnitIDs)
 {
-	const uint32_t payloadSize = sizeof(playerNum) + (selectedUnitIDs.size() * sizeof(int16_t));
+	// selection order carries no meaning, sorted IDs are mostly small deltas
+	std::vector<int16_t> sortedUnitIDs = selectedUnitIDs;
+	std::vector<uint8_t> deltaBytes;
+
+	std::sort(sortedUnitIDs.begin(), sortedUnitIDs.end());
+	deltaBytes.reserve(sortedUnitIDs.size() * sizeof(int16_t));
+
+	bool deltaCoded = true;
+
+	for (size_t i = 0; i < sortedUnitIDs.size(); i++) {
+		// negative or duplicate IDs can not be encoded (and should not be sent)
+		if (sortedUnitIDs[i] < 0 || (i > 0 && sortedUnitIDs[i] == sortedUnitIDs[i - 1])) {
+			deltaCoded = false;
+			break;
+		}
+
+		uint32_t delta = (i == 0)? sortedUnitIDs[i]: (sortedUnitIDs[i] - sortedUnitIDs[i - 1] - 1);
+
+		for (; delta >= 0x80; delta >>= 7) {
+			deltaBytes.push_back(uint8_t(delta & 0x7F) | 0x80);
+		}
+
+		deltaBytes.push_back(uint8_t(delta));
+	}
+
 	const uint32_t headerSize = sizeof(uint8_t) + sizeof(uint16_t);
+
+	if (deltaCoded && deltaBytes.size() < (selectedUnitIDs.size() * sizeof(int16_t))) {
+		const uint32_t packetSize = headerSize + sizeof(playerNum) + deltaBytes.size();
+
+		PackPacket* packet = new PackPacket(packetSize, NETMSG_SELECT_DELTA);
+		*packet << static_cast<uint16_t>(packetSize) << playerNum << deltaBytes;
+		return PacketType(packet);
+	}
+
+	const uint32_t payloadSize = sizeof(playerNum) + (selectedUnitIDs.size() * sizeof(int16_t));
 	const uint32_t packetSize = headerSize + payloadSize;
 
 	PackPacket* packet = new PackPacket(packetSize, NETMSG_SELECT);
@@ -383,6 +418,25 @@ PacketType CBaseNetProtocol::SendSyncResponse(uint8_t playerNum, int32_t frameNu
 	return PacketType(packet);
 }
 
+PacketType CBaseNetProtocol::SendSyncTreeRequest(int32_t frameNum)
+{
+	PackPacket* packet = new PackPacket(sizeof(uint8_t) + sizeof(frameNum), NETMSG_SYNCTREE_REQUEST);
+	*packet << frameNum;
+	return PacketType(packet);
+}
+
+PacketType CBaseNetProtocol::SendSyncTreeResponse(uint8_t playerNum, int32_t frameNum, uint32_t checksum, const std::vector<uint32_t>& subsysChecksums)
+{
+	const uint32_t packetSize = sizeof(uint8_t) * 2 + sizeof(playerNum) + sizeof(frameNum) + sizeof(checksum) + subsysChecksums.size() * sizeof(uint32_t);
+
+	if (packetSize >= (1 << (sizeof(uint8_t) * 8)))
+		throw netcode::PackPacketException("[BaseNetProto::SendSyncTreeResponse] maximum packet-size exceeded");
+
+	PackPacket* packet = new PackPacket(packetSize, NETMSG_SYNCTREE_RESPONSE);
+	*packet << static_cast<uint8_t>(packetSize) << playerNum << frameNum << checksum << subsysChecksums;
+	return PacketType(packet);
+}
+
 PacketType CBaseNetProtocol::SendSystemMessage(uint8_t playerNum, std::string message)
 {
 	if (message.size() > 65000) {
@@ -625,6 +679,9 @@ CBaseNetProtocol::CBaseNetProtocol()
 	proto->AddType(NETMSG_PATH_CHECKSUM, 1 + 1 + sizeof(uint32_t));
 	proto->AddType(NETMSG_COMMAND, -2);
 	proto->AddType(NETMSG_SELECT, -2);
+	proto->AddType(NETMSG_SELECT_DELTA, -2);
+	proto->AddType(NETMSG_SYNCTREE_REQUEST, 5);
+	proto->AddType(NETMSG_SYNCTREE_RESPONSE, -1);
 	proto->AddType(NETMSG_PAUSE, 3);
 
 	proto->AddType(NETMSG_AICOMMAND, -2);
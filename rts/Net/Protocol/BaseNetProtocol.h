@@ -51,6 +51,7 @@ public:
 	PacketType SendRandSeed(uint32_t randSeed);
 	PacketType SendGameID(const uint8_t* buf);
 	PacketType SendPathCheckSum(uint8_t playerNum, uint32_t checksum);
+	/// sends NETMSG_SELECT or the smaller NETMSG_SELECT_DELTA, whichever fits the IDs better
 	PacketType SendSelect(uint8_t playerNum, const std::vector<int16_t>& selectedUnitIDs);
 	PacketType SendPause(uint8_t playerNum, uint8_t bPaused);
 
@@ -74,6 +75,8 @@ public:
 	PacketType SendMapDrawLine(uint8_t playerNum, int16_t x1, int16_t z1, int16_t x2, int16_t z2, bool);
 	PacketType SendMapDrawPoint(uint8_t playerNum, int16_t x, int16_t z, const std::string& label, bool);
 	PacketType SendSyncResponse(uint8_t playerNum, int32_t frameNum, uint32_t checksum);
+	PacketType SendSyncTreeRequest(int32_t frameNum);
+	PacketType SendSyncTreeResponse(uint8_t playerNum, int32_t frameNum, uint32_t checksum, const std::vector<uint32_t>& subsysChecksums);
 	PacketType SendSystemMessage(uint8_t playerNum, std::string message);
 	PacketType SendStartPos(uint8_t playerNum, uint8_t teamNum, uint8_t readyState, float x, float y, float z);
 	PacketType SendPlayerInfo(uint8_t playerNum, float cpuUsage, int32_t ping);
@@ -93,6 +93,11 @@ enum NETMSG {
 
 	NETMSG_PING = 78, // uint8_t playerNum, uint8_t pingTag, float localTime
 
+	NETMSG_SELECT_DELTA = 79, // uint8_t playerNum; std::vector<uint8_t> selectedUnitIDs # ascending, first ID and then (ID - previousID - 1) as 7-bit varints #
+
+	NETMSG_SYNCTREE_REQUEST  = 80, // int32_t frameNum # sent by server when the sync-responses for frameNum mismatch #
+	NETMSG_SYNCTREE_RESPONSE = 81, // uint8_t messageSize, playerNum; int32_t frameNum; uint32_t checksum; std::vector<uint32_t> subsystemChecksums
+
 	NETMSG_LAST //max types of netmessages, internal only
 };
 
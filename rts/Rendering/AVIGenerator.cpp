@@ -134,6 +134,11 @@ CAVIGenerator::~CAVIGenerator()
 
 	spring::SafeDelete(readBuf);
 	ReleaseAVICompressionEngine();
+
+	for (VBO& pbo: readbackPBOs) {
+		pbo.Release();
+	}
+
 	LOG("Finished writing avi file %s", fileName.c_str());
 
 	// Just checking that all allocated ressources have been released.
@@ -386,7 +391,37 @@ bool CAVIGenerator::readOpenglPixelDataThreaded()
 		}
 	}
 
-	glReadPixels(0, 0, bitmapInfo.biWidth, bitmapInfo.biHeight, GL_BGR_EXT, GL_UNSIGNED_BYTE, readBuf);
+	if (!VBO::IsSupported(GL_PIXEL_PACK_BUFFER)) {
+		glReadPixels(0, 0, bitmapInfo.biWidth, bitmapInfo.biHeight, GL_BGR_EXT, GL_UNSIGNED_BYTE, readBuf);
+		return true;
+	}
+
+	// start the transfer of this frame into one PBO and copy out the previous
+	// frame from the other, by now the latter has (usually) finished so there
+	// is no pipeline stall as with a glReadPixels into client memory
+	VBO& curPBO = readbackPBOs[(numReadbacks    ) & 1];
+	VBO& prvPBO = readbackPBOs[(numReadbacks + 1) & 1];
+
+	curPBO.Bind();
+
+	if (curPBO.GetSize() != bitmapInfo.biSizeImage)
+		curPBO.New(bitmapInfo.biSizeImage, GL_STREAM_READ);
+
+	glReadPixels(0, 0, bitmapInfo.biWidth, bitmapInfo.biHeight, GL_BGR_EXT, GL_UNSIGNED_BYTE, curPBO.GetPtr());
+	curPBO.Unbind();
+
+	if ((numReadbacks++) == 0) {
+		// nothing to hand over yet
+		std::lock_guard<spring::mutex> lock(AVIMutex);
+		freeImageBuffers.push_front(readBuf);
+		readBuf = nullptr;
+		return true;
+	}
+
+	prvPBO.Bind();
+	memcpy(readBuf, prvPBO.MapBuffer(GL_READ_ONLY), bitmapInfo.biSizeImage);
+	prvPBO.UnmapBuffer();
+	prvPBO.Unbind();
 	return true;
 }
 
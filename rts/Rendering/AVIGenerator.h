@@ -5,6 +5,7 @@
 
 #ifdef _WIN32
 
+#include "Rendering/GL/VBO.h"
 #include "System/Threading/SpringThreading.h"
 #include "System/Misc/NonCopyable.h"
 
@@ -66,6 +67,10 @@ private:
 
 	unsigned char* readBuf;
 
+	/// frames are read back asynchronously, each one is fetched a frame later
+	VBO readbackPBOs[2] = {VBO(GL_PIXEL_PACK_BUFFER), VBO(GL_PIXEL_PACK_BUFFER)};
+	unsigned int numReadbacks = 0;
+
 
 	/// frame counter
 	long m_lFrame;
@@ -341,12 +341,9 @@ inline void CModelDrawerBase<TDrawerData, TDrawer>::DrawImpl(bool drawReflection
 
 	assert((CCameraHandler::GetActiveCamera())->GetCamType() != CCamera::CAMTYPE_SHADOW);
 
-	// first do the deferred pass; conditional because
-	// most of the water renderers use their own FBO's
-	if (drawDeferred && !drawReflection && !drawRefraction)
-		LuaObjectDrawer::DrawDeferredPass(lot);
-
-	// now do the regular forward pass
+	// the deferred pass for units and features has already been
+	// done by WorldDrawer (most of the water renderers use their
+	// own FBO's, so there is none for reflections or refractions)
 	if (drawForward)
 		DrawOpaquePass(false, drawReflection, drawRefraction);
 
@@ -1,3 +1,4 @@
 #include "ModelDrawerData.h"
 
-CONFIG(int, UnitLodDist).defaultValue(1000).headlessValue(0);
\ No newline at end of file
+CONFIG(int, UnitLodDist).defaultValue(1000).headlessValue(0);
+CONFIG(int, FarTextureMinPixelSize).defaultValue(0).headlessValue(0).minimumValue(0).description("Units and features whose on-screen size in pixels drops below this value are drawn as far-texture impostors even within UnitLodDist. 0 disables the screen-size check.");
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "System/EventClient.h"
 #include "System/EventHandler.h"
 #include "System/ContainerUtil.h"
+#include "System/SpringMath.h"
 #include "System/Config/ConfigHandler.h"
 #include "System/Threading/ThreadPool.h"
 #include "Rendering/GlobalRendering.h"
@@ -29,6 +30,8 @@ public:
 	{
 		if (modelDrawDist == 0.0f)
 			SetModelDrawDist(static_cast<float>(configHandler->GetInt("UnitLodDist")));
+
+		farTexMinPixelSize = static_cast<float>(configHandler->GetInt("FarTextureMinPixelSize"));
 	};
 	virtual ~CModelDrawerDataConcept() {
 		eventHandler.RemoveClient(this);
@@ -42,9 +45,35 @@ public:
 	static void SetModelDrawDist(float dist) {
 		modelDrawDist    = dist;
 	}
+
+	/// true if an object should be drawn as far-texture impostor rather than as model,
+	/// either because it is beyond modelDrawDist or covers too few pixels on screen
+	static bool UseFarTexture(const CCamera* cam, float sqrCamDist, float drawRadius) {
+		if (sqrCamDist >= Square(drawRadius + modelDrawDist))
+			return true;
+		if (farTexMinPixelSize <= 0.0f)
+			return false;
+
+		// projected diameter in pixels is radius * viewSizeY / (dist * tanHalfFov)
+		const float sqrPixelSize = Square(drawRadius * globalRendering->viewSizeY);
+		const float sqrMinPixelSize = Square(farTexMinPixelSize * cam->GetTanHalfFov()) * sqrCamDist;
+
+		return (sqrPixelSize < sqrMinPixelSize);
+	}
+protected:
+	// bit per CAMTYPE_* (below CAMTYPE_ENVMAP) whose pass will draw models this frame
+	static uint32_t GetDrawCamTypeBits() {
+		uint32_t bits = 1u << CCamera::CAMTYPE_PLAYER;
+
+		bits |= (water->CanDrawReflectionPass() << CCamera::CAMTYPE_UWREFL);
+		bits |= (((shadowHandler.shadowGenBits & CShadowHandler::SHADOWGEN_BIT_MODEL) != 0) << CCamera::CAMTYPE_SHADOW);
+
+		return bits;
+	}
 public:
 	// lenghts & distances
 	static float inline modelDrawDist    = 0.0f;
+	static float inline farTexMinPixelSize = 0.0f;
 protected:
 	static constexpr int MT_CHUNK_OR_MIN_CHUNK_SIZE_SMMA = -128;
 	static constexpr int MT_CHUNK_OR_MIN_CHUNK_SIZE_UPDT = -256;
@@ -93,6 +122,9 @@ protected:
 	std::vector<T*> unsortedObjects;
 	std::unordered_map<T*, ScopedMatricesMemAlloc> matricesMemAllocs;
 
+	// evaluated once per UpdateCommon instead of once per object and camera
+	uint32_t drawCamTypeBits = 0;
+
 	bool& mtModelDrawer;
 };
 
@@ -197,7 +229,11 @@ inline void CModelDrawerDataBase<T>::UpdateObjectSMMA(const T* o)
 template<typename T>
 inline void CModelDrawerDataBase<T>::UpdateObjectUniforms(const T* o)
 {
-	auto& uni = modelsUniformsStorage.GetObjUniformsArray(o);
+	const size_t offset = modelsUniformsStorage.GetObjOffset(o);
+
+	// written back through SetObjUniforms, which skips the upload of
+	// unchanged objects (most buildings, most of the time)
+	ModelUniformData uni = modelsUniformsStorage.GetObjUniforms(offset);
 	uni.drawFlag = o->drawFlag;
 
 	if (gu->spectatingFullView || o->IsInLosForAllyTeam(gu->myAllyTeam)) {
@@ -206,11 +242,15 @@ inline void CModelDrawerDataBase<T>::UpdateObjectUniforms(const T* o)
 		uni.maxHealth = o->maxHealth;
 		uni.health = o->health;
 	}
+
+	modelsUniformsStorage.SetObjUniforms(offset, uni);
 }
 
 template<typename T>
 inline void CModelDrawerDataBase<T>::UpdateCommon()
 {
+	drawCamTypeBits = GetDrawCamTypeBits();
+
 	const auto updateBody = [this](int k) {
 		T* o = unsortedObjects[k];
 		o->previousDrawFlag = o->drawFlag;
@@ -223,6 +263,8 @@ inline void CModelDrawerDataBase<T>::UpdateCommon()
 	};
 
 	if (mtModelDrawer) {
+		ThreadPool::ScopedTaskPriority stp(ThreadPool::PRIORITY_LOW);
+
 		for_mt_chunk(0, unsortedObjects.size(), [&updateBody](int k) {
 			updateBody(k);
 		}, CModelDrawerDataConcept::MT_CHUNK_OR_MIN_CHUNK_SIZE_SMMA);
@@ -42,6 +42,7 @@ using std::min;
 using std::max;
 
 CONFIG(int, BumpWaterTexSizeReflection).defaultValue(512).headlessValue(32).minimumValue(32).description("Sets the size of the framebuffer texture used to store the reflection in Bumpmapped water.");
+CONFIG(int, BumpWaterReflectionUpdateRate).defaultValue(1).minimumValue(1).maximumValue(8).description("Re-render the Bumpmapped water reflection only every N-th frame while the camera does not move.\n1:=every frame");
 CONFIG(int, BumpWaterReflection).defaultValue(1).headlessValue(0).minimumValue(0).maximumValue(2).description("Determines the amount of objects reflected in Bumpmapped water.\n0:=off, 1:=fast (skip terrain), 2:=full");
 CONFIG(int, BumpWaterRefraction).defaultValue(1).headlessValue(0).minimumValue(0).maximumValue(1).description("Determines the method of refraction with Bumpmapped water.\n0:=off, 1:=screencopy, 2:=own rendering cycle (disabled)");
 CONFIG(float, BumpWaterAnisotropy).defaultValue(0.0f).minimumValue(0.0f);
@@ -169,6 +170,7 @@ CBumpWater::CBumpWater()
 	// LOAD USER CONFIGS
 	reflTexSize  = next_power_of_2(configHandler->GetInt("BumpWaterTexSizeReflection"));
 	reflection   = configHandler->GetInt("BumpWaterReflection");
+	reflUpdateRate = configHandler->GetInt("BumpWaterReflectionUpdateRate");
 	refraction   = configHandler->GetInt("BumpWaterRefraction");
 	anisotropy   = configHandler->GetFloat("BumpWaterAnisotropy");
 	depthCopy    = configHandler->GetBool("BumpWaterUseDepthTexture");
@@ -730,7 +732,7 @@ void CBumpWater::UpdateWater(CGame* game)
 
 	glPushAttrib(GL_FOG_BIT);
 	if (refraction > 1) DrawRefraction(game);
-	if (reflection > 0) DrawReflection(game);
+	if (reflection > 0 && NeedReflectionUpdate()) DrawReflection(game);
 	if (reflection || refraction) {
 		FBO::Unbind();
 		glViewport(globalRendering->viewPosX, 0, globalRendering->viewSizeX, globalRendering->viewSizeY);
@@ -1196,6 +1198,27 @@ void CBumpWater::DrawRefraction(CGame* game)
 }
 
 
+bool CBumpWater::NeedReflectionUpdate()
+{
+	// the reflected scene changes slowly compared to the view from a moving
+	// camera, so a stale texture is only noticeable while the latter is static
+	const bool camChanged =
+		(!camera->GetPos().same(reflCamPos)) ||
+		(!camera->GetDir().same(reflCamDir)) ||
+		(camera->GetVFOV() != reflCamFOV);
+
+	if (!camChanged && (globalRendering->drawFrame - reflDrawFrame) < reflUpdateRate)
+		return false;
+
+	reflCamPos = camera->GetPos();
+	reflCamDir = camera->GetDir();
+	reflCamFOV = camera->GetVFOV();
+
+	reflDrawFrame = globalRendering->drawFrame;
+	return true;
+}
+
+
 void CBumpWater::DrawReflection(CGame* game)
 {
 	reflectFBO.Bind();
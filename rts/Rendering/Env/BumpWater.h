@@ -33,6 +33,7 @@ public:
 	void UpdateWater(CGame* game);
 	void OcclusionQuery();
 	void DrawReflection(CGame* game);
+	bool NeedReflectionUpdate();
 	void DrawRefraction(CGame* game);
 	void Draw();
 	int GetID() const { return WATER_RENDERER_BUMPMAPPED; }
@@ -75,6 +76,7 @@ private:
 	char  reflection;   ///< 0:=off, 1:=don't render the terrain, 2:=render everything+terrain
 	char  refraction;   ///< 0:=off, 1:=screencopy, 2:=own rendering cycle
 	int   reflTexSize;
+	unsigned int reflUpdateRate; ///< reflection is re-rendered at most every N-th draw-frame while the camera is static
 	bool  depthCopy;    ///< uses a screen depth copy, which allows a nicer interpolation between deep sea and shallow water
 	float anisotropy;
 	char  depthBits;    ///< depthBits for reflection/refraction RBO
@@ -116,6 +118,12 @@ private:
 	std::array<GLuint, 26> uniforms; ///< see useUniforms
 
 	bool wasVisibleLastFrame;
+
+	//! camera and frame the reflection texture was last rendered with
+	float3 reflCamPos;
+	float3 reflCamDir;
+	float  reflCamFOV = 0.0f;
+	unsigned int reflDrawFrame = 0;
 	GLuint occlusionQuery;
 	GLuint occlusionQueryResult;
 
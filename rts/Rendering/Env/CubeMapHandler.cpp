@@ -21,6 +21,12 @@ CONFIG(bool, CubeTexGenerateMipMaps).defaultValue(false);
 
 CubeMapHandler cubeMapHandler;
 
+// a new cycle of reflection faces is only drawn if the camera moved this far,
+// the sky or sun changed, the terrain was deformed, or after MAX_CYCLE_AGE
+// frames (for animated clouds and Lua-driven sky changes)
+static constexpr float REFLECTION_CAM_DIST = 128.0f;
+static constexpr unsigned int MAX_CYCLE_AGE = 300;
+
 
 bool CubeMapHandler::Init() {
 	envReflectionTexID = 0;
@@ -37,6 +43,10 @@ bool CubeMapHandler::Init() {
 
 	currReflectionFace = 0;
 	specularTexIter = 0;
+	specularRowsLeft = 0;
+
+	reflectionCycleFrame = 0;
+	reflectionDirty = true;
 
 	mapSkyReflections = (!mapInfo->smf.skyReflectModTexName.empty());
 	generateMipMaps = configHandler->GetBool("CubeTexGenerateMipMaps");
@@ -131,6 +141,19 @@ void CubeMapHandler::UpdateReflectionTexture()
 	if (!unitDrawer->UseAdvShading() && !readMap->GetGroundDrawer()->UseAdvShading())
 		return;
 
+	reflectionDirty |= readMap->GetHeightMapUpdated();
+
+	if (currReflectionFace == 0) {
+		const ReflectionState state = GetReflectionState();
+
+		if (!reflectionDirty && state.Equals(reflectionState) && (globalRendering->drawFrame - reflectionCycleFrame) < MAX_CYCLE_AGE)
+			return;
+
+		reflectionState = state;
+		reflectionCycleFrame = globalRendering->drawFrame;
+		reflectionDirty = false;
+	}
+
 	// NOTE:
 	//   we unbind later in WorldDrawer::GenerateIBLTextures() to save render
 	//   context switches (which are one of the slowest OpenGL operations!)
@@ -176,6 +199,27 @@ void CubeMapHandler::UpdateReflectionTexture()
 	}
 }
 
+CubeMapHandler::ReflectionState CubeMapHandler::GetReflectionState() const
+{
+	ReflectionState state;
+	state.camPos = CCameraHandler::GetCamera(CCamera::CAMTYPE_PLAYER)->GetPos();
+	state.sunDir = sky->GetLight()->GetLightDir();
+	state.fogColor = sky->fogColor;
+	state.skyColor = sky->skyColor;
+	state.cloudColor = sky->cloudColor;
+	state.cloudDensity = sky->GetCloudDensity();
+	return state;
+}
+
+bool CubeMapHandler::ReflectionState::Equals(const ReflectionState& s) const
+{
+	if (camPos.SqDistance(s.camPos) > Square(REFLECTION_CAM_DIST))
+		return false;
+
+	return (sunDir == s.sunDir && fogColor == s.fogColor && skyColor == s.skyColor && cloudColor == s.cloudColor && cloudDensity == s.cloudDensity);
+}
+
+
 void CubeMapHandler::CreateReflectionFace(unsigned int glFace, bool skyOnly)
 {
 	reflectionCubeFBO.AttachTexture((skyOnly? skyReflectionTexID: envReflectionTexID), glFace);
@@ -238,11 +282,21 @@ void CubeMapHandler::CreateReflectionFace(unsigned int glFace, bool skyOnly)
 }
 
 
-void CubeMapHandler::UpdateSpecularTexture()
+void CubeMapHandler::UpdateSpecularTexture(bool lightChanged)
 {
 	if (!unitDrawer->UseAdvShading())
 		return;
 
+	// rows keep being refreshed for one full pass after the light stopped
+	// changing, otherwise those not reached by then would stay out of date
+	if (lightChanged)
+		specularRowsLeft = specTexSize * 3;
+
+	if (specularRowsLeft == 0)
+		return;
+
+	specularRowsLeft -= 1;
+
 	glBindTexture(GL_TEXTURE_CUBE_MAP, specularTexID);
 
 	int specularTexRow = specularTexIter / 3; //FIXME WTF
@@ -13,7 +13,8 @@ public:
 	void Free();
 
 	void UpdateReflectionTexture();
-	void UpdateSpecularTexture();
+	// <lightChanged> restarts a full pass over the specular rows
+	void UpdateSpecularTexture(bool lightChanged);
 
 	unsigned int GetEnvReflectionTextureID() const { return envReflectionTexID; }
 	unsigned int GetSkyReflectionTextureID() const { return skyReflectionTexID; }
@@ -22,6 +23,20 @@ public:
 	unsigned int GetSpecularTextureSize() const { return specTexSize; }
 
 private:
+	// everything the reflection faces depend on besides the terrain
+	struct ReflectionState {
+		bool Equals(const ReflectionState& s) const;
+
+		float3 camPos;
+		float4 sunDir;
+		float4 fogColor;
+		float3 skyColor;
+		float3 cloudColor;
+		float cloudDensity;
+	};
+
+	ReflectionState GetReflectionState() const;
+
 	void CreateReflectionFace(unsigned int, bool);
 	void CreateSpecularFacePart(unsigned int, unsigned int, const float3&, const float3&, const float3&, unsigned int, unsigned char*);
 	void CreateSpecularFace(unsigned int, unsigned int, const float3&, const float3&, const float3&);
@@ -36,6 +51,12 @@ private:
 
 	unsigned int currReflectionFace;
 	unsigned int specularTexIter;
+	unsigned int specularRowsLeft;
+
+	// drawFrame at which the last reflection cycle started
+	unsigned int reflectionCycleFrame;
+
+	bool reflectionDirty;
 
 	bool mapSkyReflections;
 	bool generateMipMaps;
@@ -45,6 +66,8 @@ private:
 
 	FBO reflectionCubeFBO;
 
+	ReflectionState reflectionState;
+
 	/*
 	GL_TEXTURE_CUBE_MAP_POSITIVE_X
 	GL_TEXTURE_CUBE_MAP_NEGATIVE_X
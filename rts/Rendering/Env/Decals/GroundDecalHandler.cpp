@@ -375,7 +375,16 @@ inline void CGroundDecalHandler::DrawGroundScar(CGroundDecalHandler::Scar& scar)
 			px1 = px2;
 		}
 	} else {
-		if (groundScarAlphaFade) {
+		// alpha only changes per sim-frame and heights only when the terrain
+		// is deformed, no need to rewrite the VA on every draw-frame between
+		const bool refreshVA =
+			(scar.lastFade != gs->frameNum) ||
+			(scar.lastHgtMapUpdate != readMap->GetNumUnsyncedHeightMapUpdates());
+
+		if (groundScarAlphaFade && refreshVA) {
+			scar.lastFade = gs->frameNum;
+			scar.lastHgtMapUpdate = readMap->GetNumUnsyncedHeightMapUpdates();
+
 			if ((scar.creationTime + 10) > gs->frameNum) {
 				color[3] = (int) (scar.startAlpha * (gs->frameNum - scar.creationTime) * 0.1f);
 			} else {
@@ -173,6 +173,8 @@ public:
 
 			lastTest = s.lastTest;
 			lastDraw = s.lastDraw;
+			lastFade = s.lastFade;
+			lastHgtMapUpdate = s.lastHgtMapUpdate;
 
 			pos = s.pos;
 
@@ -199,6 +201,8 @@ public:
 			lifeTime = 0;
 			lastTest = 0;
 			lastDraw = -1;
+			lastFade = -1;
+			lastHgtMapUpdate = 0;
 
 			pos = ZeroVector;
 
@@ -224,6 +228,9 @@ public:
 		int lifeTime;
 		int lastTest;
 		int lastDraw;
+		// sim-frame and heightmap-update count the VA was last refreshed at
+		int lastFade;
+		unsigned int lastHgtMapUpdate;
 
 		float3 pos;
 
@@ -438,6 +438,8 @@ void CGrassDrawer::DrawFarBillboards(const std::vector<GrassStruct*>& inviewFarG
 	if (updateBillboards) {
 		updateBillboards = false;
 
+		ThreadPool::ScopedTaskPriority stp(ThreadPool::PRIORITY_LOW);
+
 		for_mt(0, inviewFarGrass.size(), [&](const int i) {
 			GrassStruct& g = *inviewFarGrass[i];
 
@@ -489,6 +491,8 @@ void CGrassDrawer::DrawNearBillboards(const std::vector<InviewNearGrass>& inview
 	if (farnearVA.drawIndex() == 0) {
 		auto* va_tn = farnearVA.GetTypedVertexArray<VA_TYPE_TN>(inviewNearGrass.size() * numTurfs * 4);
 
+		ThreadPool::ScopedTaskPriority stp(ThreadPool::PRIORITY_LOW);
+
 		for_mt(0, inviewNearGrass.size(), [&](const int i) {
 			const InviewNearGrass& gi = inviewNearGrass[i];
 			DrawBillboard(gi.x, gi.y, gi.dist, &va_tn[i * numTurfs * 4]);
@@ -1078,9 +1082,19 @@ unsigned char CGrassDrawer::GetGrass(const float3& pos)
 
 void CGrassDrawer::UnsyncedHeightMapUpdate(const SRectangle& rect)
 {
-	for (int z = rect.z1; z <= rect.z2; ++z) {
-		for (int x = rect.x1; x <= rect.x2; ++x) {
-			ResetPos(float3(x, 0.f, z));
+	if (grassOff)
+		return;
+
+	// rect is given in heightmap squares (inclusive, may touch map{x,y}); reset
+	// each grass block it overlaps once rather than once per covered square
+	const int bx1 = Clamp(rect.x1 / blockMapSize, 0, blocksX - 1);
+	const int bz1 = Clamp(rect.z1 / blockMapSize, 0, blocksY - 1);
+	const int bx2 = Clamp(rect.x2 / blockMapSize, 0, blocksX - 1);
+	const int bz2 = Clamp(rect.z2 / blockMapSize, 0, blocksY - 1);
+
+	for (int bz = bz1; bz <= bz2; ++bz) {
+		for (int bx = bx1; bx <= bx2; ++bx) {
+			ResetPos(bx, bz);
 		}
 	}
 }
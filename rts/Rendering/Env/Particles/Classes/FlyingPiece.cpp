@@ -83,8 +83,9 @@ bool FlyingPiece::Update()
 	pos        = pos0 + (speed * dragFactors.x) + UpVector * (mapInfo->map.gravity * dragFactors.y);
 	drawRadius = pieceRadius + EXPLOSION_SPEED * dragFactors.x + 10.f;
 
-	// check visibility (if all particles are underground -> kill)
-	if ((age % GAME_SPEED) == 0)
+	// check visibility (if all particles are underground -> kill), but only
+	// once per second since it needs the full matrix of every splitter part
+	if ((age % GAME_SPEED) != 0)
 		return true;
 
 	for (auto& cp: splitterParts) {
@@ -178,8 +179,6 @@ CMatrix44f FlyingPiece::GetMatrixOf(const SplitterData& cp, const float3 dragFac
 
 void FlyingPiece::CheckDrawStateChange(const FlyingPiece* prev) const
 {
-	ScopedModelDrawerImpl<CUnitDrawer> legacy(true, false);
-
 	if (prev == nullptr) {
 		CUnitDrawer::SetTeamColor(team);
 
@@ -26,6 +26,7 @@ public:
 	);
 
 	bool Update();
+	/// caller is expected to have selected the legacy unit-drawer implementation
 	void Draw(const FlyingPiece* prev) const;
 	void EndDraw() const;
 	unsigned GetDrawCallCount() const { return splitterParts.size(); }
@@ -2,6 +2,8 @@
 
 #include "SimpleParticleSystem.h"
 
+#include <algorithm>
+
 #include "GenericParticleProjectile.h"
 #include "Game/Camera.h"
 #include "Game/GlobalUnsynced.h"
@@ -85,12 +87,12 @@ CSimpleParticleSystem::CSimpleParticleSystem()
 
 void CSimpleParticleSystem::Draw(CVertexArray* va)
 {
-	va->EnlargeArrays(numParticles * 4, 0, VA_SIZE_TC);
+	va->EnlargeArrays(particles.size() * 4, 0, VA_SIZE_TC);
 
 	std::array<float3, 4> bounds;
 
 	if (directional) {
-		for (int i = 0; i < numParticles; i++) {
+		for (size_t i = 0; i < particles.size(); i++) {
 			const Particle* p = &particles[i];
 
 			if (p->life >= 1.0f)
@@ -144,7 +146,7 @@ void CSimpleParticleSystem::Draw(CVertexArray* va)
 	}
 
 	// !directional
-	for (int i = 0; i < numParticles; i++) {
+	for (size_t i = 0; i < particles.size(); i++) {
 		const Particle* p = &particles[i];
 
 		if (p->life >= 1.0f)
@@ -178,21 +180,21 @@ void CSimpleParticleSystem::Draw(CVertexArray* va)
 
 void CSimpleParticleSystem::Update()
 {
-	deleteMe = true;
-
 	for (auto& p: particles) {
-		if (p.life < 1.0f) {
-			p.pos    += p.speed;
-			p.speed  += gravity;
-			p.speed  *= airdrag;
-			p.rotVal += p.rotVel;
-			p.rotVel += rotParams.y; //rot accel
-			p.life   += p.decayrate;
-			p.size    = p.size * sizeMod + sizeGrowth;
-
-			deleteMe = false;
-		}
+		p.pos    += p.speed;
+		p.speed  += gravity;
+		p.speed  *= airdrag;
+		p.rotVal += p.rotVel;
+		p.rotVel += rotParams.y; //rot accel
+		p.life   += p.decayrate;
+		p.size    = p.size * sizeMod + sizeGrowth;
 	}
+
+	// dead particles are never drawn and never come back, drop them (order-preserving)
+	// s.t. neither Update nor Draw keeps iterating over them for the rest of our life
+	particles.erase(std::remove_if(particles.begin(), particles.end(), [](const Particle& p) { return (p.life >= 1.0f); }), particles.end());
+
+	deleteMe = particles.empty();
 }
 
 void CSimpleParticleSystem::Init(const CUnit* owner, const float3& offset)
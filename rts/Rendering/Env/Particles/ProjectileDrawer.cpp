@@ -293,6 +293,7 @@ void CProjectileDrawer::Kill() {
 	renderProjectiles.clear();
 	sortedProjectiles[0].clear();
 	sortedProjectiles[1].clear();
+	projectileSortKeys.clear();
 
 	perlinFB.Kill();
 
@@ -591,6 +592,30 @@ void CProjectileDrawer::DrawProjectileNow(CProjectile* pro, bool drawReflection,
 }
 
 
+void CProjectileDrawer::SortProjectiles(std::vector<CProjectile*>& projectiles)
+{
+	projectileSortKeys.clear();
+	projectileSortKeys.reserve(projectiles.size());
+
+	for (CProjectile* p: projectiles) {
+		projectileSortKeys.push_back({p->drawOrder * wantDrawOrder, p->GetSortDist(), p});
+	}
+
+	std::sort(projectileSortKeys.begin(), projectileSortKeys.end(), [](const ProjectileSortKey& a, const ProjectileSortKey& b) {
+		if (a.drawOrder != b.drawOrder)
+			return (a.drawOrder < b.drawOrder);
+
+		if (a.sortDist != b.sortDist) // strict ordering required
+			return (a.sortDist > b.sortDist);
+
+		return (a.proj > b.proj);
+	});
+
+	for (size_t i = 0, n = projectileSortKeys.size(); i < n; i++) {
+		projectiles[i] = projectileSortKeys[i].proj;
+	}
+}
+
 
 void CProjectileDrawer::DrawProjectilesShadow(int modelType)
 {
@@ -690,6 +715,9 @@ void CProjectileDrawer::DrawFlyingPieces(int modelType)
 	glPushAttrib(GL_POLYGON_BIT);
 	glDisable(GL_CULL_FACE);
 
+	// selected once for the whole container rather than per piece
+	ScopedModelDrawerImpl<CUnitDrawer> legacy(true, false);
+
 	const FlyingPiece* last = nullptr;
 
 	for (const FlyingPiece& fp: container) {
@@ -743,7 +771,7 @@ void CProjectileDrawer::Draw(bool drawReflection, bool drawRefraction) {
 		DrawProjectilesSet(renderProjectiles, drawReflection, drawRefraction);
 
 		// empty if !drawSorted
-		std::sort(sortedProjectiles[1].begin(), sortedProjectiles[1].end(), sortingPredicate);
+		SortProjectiles(sortedProjectiles[1]);
 
 		fxVA = GetVertexArray();
 		fxVA->Initialize();
@@ -910,13 +938,9 @@ void CProjectileDrawer::DrawGroundFlashes()
 	glEnable(GL_POLYGON_OFFSET_FILL);
 	glFogfv(GL_FOG_COLOR, black);
 
-	gfVA = GetVertexArray();
-	gfVA->Initialize();
-	gfVA->EnlargeArrays(8 * gfc.size(), 0, VA_SIZE_TC);
-
-
-	bool depthTest = true;
-	bool depthMask = false;
+	for (auto& bucket: visibleGroundFlashes) {
+		bucket.clear();
+	}
 
 	for (CGroundFlash* gf: gfc) {
 		const bool inLos = gf->alwaysVisible || gu->spectatingFullView || losHandler->InAirLos(gf, gu->myAllyTeam);
@@ -926,30 +950,11 @@ void CProjectileDrawer::DrawGroundFlashes()
 		if (!camera->InView(gf->pos, gf->size))
 			continue;
 
-		bool depthTestWanted = wantSoften > 0 ? false : gf->depthTest;
-
-		if (depthTest != depthTestWanted) {
-			gfVA->DrawArrayTC(GL_QUADS);
-			gfVA->Initialize();
+		const bool depthTestWanted = wantSoften > 0 ? false : gf->depthTest;
 
-			if ((depthTest = depthTestWanted)) {
-				glEnable(GL_DEPTH_TEST);
-			} else {
-				glDisable(GL_DEPTH_TEST);
-			}
-		}
-		if (depthMask != gf->depthMask) {
-			gfVA->DrawArrayTC(GL_QUADS);
-			gfVA->Initialize();
-
-			if ((depthMask = gf->depthMask)) {
-				glDepthMask(GL_TRUE);
-			} else {
-				glDepthMask(GL_FALSE);
-			}
-		}
-
-		gf->Draw(gfVA);
+		// swap-erase in the update shuffles the container, so interleaved states
+		// would otherwise force a flush per flash
+		visibleGroundFlashes[depthTestWanted * 2 + gf->depthMask].push_back(gf);
 	}
 
 	if (wantSoften > 0) {
@@ -960,7 +965,31 @@ void CProjectileDrawer::DrawGroundFlashes()
 		fxShader->SetUniform("softenThreshold", -CProjectileDrawer::softenThreshold[1]);
 	}
 
-	gfVA->DrawArrayTC(GL_QUADS);
+	gfVA = GetVertexArray();
+
+	for (size_t i = 0; i < visibleGroundFlashes.size(); i++) {
+		const auto& bucket = visibleGroundFlashes[i];
+
+		if (bucket.empty())
+			continue;
+
+		if ((i & 2) != 0) {
+			glEnable(GL_DEPTH_TEST);
+		} else {
+			glDisable(GL_DEPTH_TEST);
+		}
+
+		glDepthMask((i & 1) != 0);
+
+		gfVA->Initialize();
+		gfVA->EnlargeArrays(8 * bucket.size(), 0, VA_SIZE_TC);
+
+		for (CGroundFlash* gf: bucket) {
+			gf->Draw(gfVA);
+		}
+
+		gfVA->DrawArrayTC(GL_QUADS);
+	}
 
 	if (wantSoften > 0) {
 		fxShader->Disable();
@@ -138,6 +138,7 @@ private:
 
 	static bool CanDrawProjectile(const CProjectile* pro, const CSolidObject* owner);
 	void DrawProjectileNow(CProjectile* projectile, bool drawReflection, bool drawRefraction);
+	void SortProjectiles(std::vector<CProjectile*>& projectiles);
 
 	static void DrawProjectileShadow(CProjectile* projectile);
 	static bool DrawProjectileModel(const CProjectile* projectile);
@@ -173,16 +174,18 @@ private:
 	/// used to render particle effects in back-to-front order
 	std::vector<CProjectile*> sortedProjectiles[2];
 
-	std::function<bool(const CProjectile*, const CProjectile*)> sortingPredicate = [this](const CProjectile* p1, const CProjectile* p2)
-	{
-		if (wantDrawOrder && p1->drawOrder != p2->drawOrder)
-			return (p1->drawOrder < p2->drawOrder);
-
-		if (p1->GetSortDist() != p2->GetSortDist()) // strict ordering required
-			return (p1->GetSortDist() > p2->GetSortDist());
-
-		return (p1 > p2);
+	/// sort keys copied out of sortedProjectiles[1], s.t. comparisons
+	/// do not need to chase (cache-cold) projectile pointers
+	struct ProjectileSortKey {
+		int drawOrder;
+		float sortDist;
+		CProjectile* proj;
 	};
+	std::vector<ProjectileSortKey> projectileSortKeys;
+
+	/// visible ground-flashes bucketed by {depthTest, depthMask} state;
+	/// blending is additive so each bucket can be drawn in a single batch
+	std::array<std::vector<CGroundFlash*>, 4> visibleGroundFlashes;
 
 	bool drawSorted = true;
 
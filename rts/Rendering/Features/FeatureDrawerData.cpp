@@ -98,9 +98,69 @@ void CFeatureDrawerData::Update()
 			UpdateDrawPos(f);
 	}
 
+	UpdateTileCamBits();
 	UpdateCommon();
 }
 
+void CFeatureDrawerData::UpdateTileCamBits()
+{
+	// not worth it for a handful of features
+	if (unsortedObjects.size() < MIN_TILED_FEATURES) {
+		tileCamBits.clear();
+		return;
+	}
+
+	numTilesX = (mapDims.mapx * SQUARE_SIZE + TILE_SIZE - 1) / TILE_SIZE;
+	numTilesZ = (mapDims.mapy * SQUARE_SIZE + TILE_SIZE - 1) / TILE_SIZE;
+
+	// full-height columns; the heightmap bounds only change through deformation
+	tileMinY = readMap->GetCurrMinHeight() - TILE_MARGIN;
+	tileMaxY = readMap->GetCurrMaxHeight() + TILE_MARGIN;
+
+	tileCamBits.resize(numTilesX * numTilesZ);
+
+	const uint32_t camTypeBits = GetDrawCamTypeBits();
+
+	for (int tz = 0; tz < numTilesZ; tz++) {
+		for (int tx = 0; tx < numTilesX; tx++) {
+			const float3 mins = {tx * TILE_SIZE - TILE_MARGIN, tileMinY, tz * TILE_SIZE - TILE_MARGIN};
+			const float3 maxs = {(tx + 1) * TILE_SIZE + TILE_MARGIN, tileMaxY, (tz + 1) * TILE_SIZE + TILE_MARGIN};
+
+			uint8_t bits = 0;
+
+			for (uint32_t camType = CCamera::CAMTYPE_PLAYER; camType < CCamera::CAMTYPE_ENVMAP; ++camType) {
+				if ((camTypeBits & (1u << camType)) == 0)
+					continue;
+
+				bits |= (CCameraHandler::GetCamera(camType)->InView(mins, maxs) << camType);
+			}
+
+			tileCamBits[tz * numTilesX + tx] = bits;
+		}
+	}
+}
+
+uint32_t CFeatureDrawerData::GetTileCamBits(const CFeature* f) const
+{
+	if (tileCamBits.empty())
+		return ~0u;
+
+	const float3& pos = f->drawMidPos;
+	const float radius = f->GetDrawRadius();
+
+	// anything not contained in its tile's bounds takes the exact path
+	if (radius > TILE_MARGIN || (pos.y - radius) < tileMinY || (pos.y + radius) > tileMaxY)
+		return ~0u;
+
+	const int tx = static_cast<int>(pos.x / TILE_SIZE);
+	const int tz = static_cast<int>(pos.z / TILE_SIZE);
+
+	if (pos.x < 0.0f || pos.z < 0.0f || tx >= numTilesX || tz >= numTilesZ)
+		return ~0u;
+
+	return tileCamBits[tz * numTilesX + tx];
+}
+
 bool CFeatureDrawerData::IsAlpha(const CFeature* co) const
 {
 	return (co->drawAlpha < 1.0f);
@@ -111,24 +171,16 @@ void CFeatureDrawerData::UpdateObjectDrawFlags(CSolidObject* o) const
 	CFeature* f = static_cast<CFeature*>(o);
 	f->ResetDrawFlag();
 
-	for (uint32_t camType = CCamera::CAMTYPE_PLAYER; camType < CCamera::CAMTYPE_ENVMAP; ++camType) {
-		if (camType == CCamera::CAMTYPE_UWREFL && !water->CanDrawReflectionPass())
-			continue;
+	// per-object checks, independent of the camera; the matrix update below must still run
+	const bool canDraw = !f->noDraw && !f->IsInVoid() && (f->IsInLosForAllyTeam(gu->myAllyTeam) || gu->spectatingFullView);
+	const uint32_t camTypeBits = (drawCamTypeBits * canDraw) & GetTileCamBits(f);
 
-		if (camType == CCamera::CAMTYPE_SHADOW && ((shadowHandler.shadowGenBits & CShadowHandler::SHADOWGEN_BIT_MODEL) == 0))
+	for (uint32_t camType = CCamera::CAMTYPE_PLAYER; camType < CCamera::CAMTYPE_ENVMAP; ++camType) {
+		if ((camTypeBits & (1u << camType)) == 0)
 			continue;
 
 		const CCamera* cam = CCameraHandler::GetCamera(camType);
 
-		if (f->noDraw)
-			continue;
-
-		if (f->IsInVoid())
-			continue;
-
-		if (!f->IsInLosForAllyTeam(gu->myAllyTeam) && !gu->spectatingFullView)
-			continue;
-
 		if (!cam->InView(f->drawMidPos, f->GetDrawRadius()))
 			continue;
 
@@ -137,7 +189,8 @@ void CFeatureDrawerData::UpdateObjectDrawFlags(CSolidObject* o) const
 			case CCamera::CAMTYPE_PLAYER: {
 				const float sqrCamDist = (f->drawPos - cam->GetPos()).SqLength();
 				const float farTexDist = Square(f->GetDrawRadius() + CModelDrawerDataConcept::modelDrawDist);
-				if (sqrCamDist >= farTexDist) {
+				// fading features are only swapped for impostors beyond the draw distance
+				if (sqrCamDist >= farTexDist || (!f->alphaFade && UseFarTexture(cam, sqrCamDist, f->GetDrawRadius()))) {
 					// note: it looks pretty bad to first alpha-fade and then
 					// draw a fully *opaque* fartex, so restrict impostors to
 					// non-fading features
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
+
 #include "System/float3.h"
 #include "Rendering/Common/ModelDrawerData.h"
 
@@ -30,6 +33,25 @@ protected:
 	void UpdateObjectDrawFlags(CSolidObject* o) const override;
 private:
 	static void UpdateDrawPos(CFeature* f);
+
+	void UpdateTileCamBits();
+	uint32_t GetTileCamBits(const CFeature* f) const;
+private:
+	// coarse culling for maps with many (tree) features: the map is cut into
+	// square tiles and each frame every camera is tested once per tile; the
+	// per-feature camera tests are skipped for cameras that can not see the
+	// tile, provided the feature's sphere fits the tile's (grown) bounds
+	static constexpr int TILE_SIZE = 512;
+	static constexpr float TILE_MARGIN = 96.0f;
+	static constexpr size_t MIN_TILED_FEATURES = 512;
+
+	std::vector<uint8_t> tileCamBits;
+
+	int numTilesX = 0;
+	int numTilesZ = 0;
+
+	float tileMinY = 0.0f;
+	float tileMaxY = 0.0f;
 public:
 	float featureDrawDistance;
 	float featureFadeDistance;
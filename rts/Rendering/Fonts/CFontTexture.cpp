@@ -663,10 +663,19 @@ void CFontTexture::LoadBlock(char32_t start, char32_t end)
 
 			assert(glyphIdx < atlasGlyphs.size());
 
-			if (texpos[2] != 0)
+			if (texpos[2] != 0) {
 				atlasUpdate.CopySubImage(atlasGlyphs[glyphIdx], texpos.x, texpos.y);
-			if (texpos2[2] != 0)
+
+				dirtyMinY = std::min(dirtyMinY, int(texpos[1]));
+				dirtyMaxY = std::max(dirtyMaxY, int(texpos[3]));
+			}
+			if (texpos2[2] != 0) {
 				atlasUpdateShadow.CopySubImage(atlasGlyphs[glyphIdx], texpos2.x + outlineSize, texpos2.y + outlineSize);
+
+				// blurring can bleed a little beyond the shadow's own rect
+				dirtyMinY = std::min(dirtyMinY, int(texpos2[1]) - outlineSize);
+				dirtyMaxY = std::max(dirtyMaxY, int(texpos2[3]) + outlineSize);
+			}
 		}
 
 		atlasAlloc.clear();
@@ -870,11 +879,25 @@ void CFontTexture::UpdateTexture()
 		atlasUpdateShadow = {};
 	}
 
+	// the atlas only grows and existing glyphs never move, so unless it was
+	// resized only the rows the new glyphs went into have to be re-uploaded
+	const bool fullUpload = (glTexWidth != texWidth || glTexHeight != texHeight);
+
+	const int minY = std::max(dirtyMinY, 0);
+	const int maxY = std::min(dirtyMaxY, texHeight);
+
+	dirtyMinY = std::numeric_limits<int>::max();
+	dirtyMaxY = 0;
 
 	glPushAttrib(GL_PIXEL_MODE_BIT | GL_TEXTURE_BIT);
 		// update texture atlas
 		glBindTexture(GL_TEXTURE_2D, texture);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, texWidth, texHeight, 0, GL_ALPHA, GL_UNSIGNED_BYTE, atlasUpdate.GetRawMem());
+
+		if (fullUpload) {
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, glTexWidth = texWidth, glTexHeight = texHeight, 0, GL_ALPHA, GL_UNSIGNED_BYTE, atlasUpdate.GetRawMem());
+		} else if (minY < maxY) {
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, minY, texWidth, maxY - minY, GL_ALPHA, GL_UNSIGNED_BYTE, atlasUpdate.GetRawMem() + minY * texWidth);
+		}
 
 		// update texture space dlist (this affects already compiled dlists too!)
 		glNewList(textureSpaceMatrix, GL_COMPILE);
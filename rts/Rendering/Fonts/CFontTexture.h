@@ -3,6 +3,7 @@
 #ifndef _CFONTTEXTURE_H
 #define _CFONTTEXTURE_H
 
+#include <limits>
 #include <string>
 #include <memory>
 
@@ -138,6 +139,11 @@ private:
 	int curTextureUpdate = 0;
 #ifndef HEADLESS
 	int lastTextureUpdate = 0;
+	// size of the GL texture, and the atlas rows changed since it was last uploaded
+	int glTexWidth = 0;
+	int glTexHeight = 0;
+	int dirtyMinY = std::numeric_limits<int>::max();
+	int dirtyMaxY = 0;
 	FT_Face face;
 #endif
 
@@ -123,23 +123,27 @@ void GL::LightHandler::Update(Shader::IProgramObject* shader) {
 	for (GL::Light& light: lights) {
 		const unsigned int lightID = light.GetID();
 
+		if (light.GetTTL() != 0 && light.GetAbsoluteTime() != gs->frameNum) {
+			light.SetRelativeTime(light.GetRelativeTime() + 1);
+			light.SetAbsoluteTime(gs->frameNum);
+			light.DecayColors();
+			light.ClampColors();
+
+			// mark light as dead before doing any tracking work for it
+			if (light.GetRelativeTime() > light.GetTTL())
+				light.SetTTL(0);
+		}
+
 		// dead light, ignore (but kill its contribution)
+		// note: glLight* state does not depend on GL_LIGHTi being enabled,
+		// shaders read gl_LightSource directly so no glEnable is required
 		if (light.GetTTL() == 0) {
-			glEnable(lightID);
 			glLightfv(lightID, GL_AMBIENT,  &ZeroVector4.x);
 			glLightfv(lightID, GL_DIFFUSE,  &ZeroVector4.x);
 			glLightfv(lightID, GL_SPECULAR, &ZeroVector4.x);
-			glDisable(lightID);
 			continue;
 		}
 
-		if (light.GetAbsoluteTime() != gs->frameNum) {
-			light.SetRelativeTime(light.GetRelativeTime() + 1);
-			light.SetAbsoluteTime(gs->frameNum);
-			light.DecayColors();
-			light.ClampColors();
-		}
-
 		// rescale by max (not sum!), otherwise 1) the intensity would
 		// change if any light is added or removed when all have equal
 		// weight and 2) a non-uniform set would cause a reduction for
@@ -182,15 +186,8 @@ void GL::LightHandler::Update(Shader::IProgramObject* shader) {
 			}
 		}
 
-		if (light.GetRelativeTime() > light.GetTTL()) {
-			// mark light as dead
-			light.SetTTL(0);
-			continue;
-		}
-
 		// communicate properties via the FFP to save uniforms
 		// note: we want MV to be identity here
-		glEnable(lightID);
 		glLightfv(lightID, GL_POSITION, &lightPos.x);
 
 		if (gu->spectatingFullView || light.IgnoreLOS() || losHandler->InLos(lightPos, gu->myAllyTeam)) {
@@ -215,7 +212,6 @@ void GL::LightHandler::Update(Shader::IProgramObject* shader) {
 		glLightf(lightID, GL_LINEAR_ATTENUATION,    light.GetAttenuation().y);
 		glLightf(lightID, GL_QUADRATIC_ATTENUATION, light.GetAttenuation().z);
 		#endif
-		glDisable(lightID);
 	}
 }
 
@@ -0,0 +1,37 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "StateCache.h"
+
+GL::StateCache& GL::StateCache::GetInstance()
+{
+	static StateCache cache;
+	return cache;
+}
+
+void GL::StateCache::SetCap(GLenum cap, bool b)
+{
+	uint8_t* state = nullptr;
+
+	switch (cap) {
+		case GL_BLEND       : { state = &caps[CAP_BLEND       ]; } break;
+		case GL_DEPTH_TEST  : { state = &caps[CAP_DEPTH_TEST  ]; } break;
+		case GL_CULL_FACE   : { state = &caps[CAP_CULL_FACE   ]; } break;
+		case GL_ALPHA_TEST  : { state = &caps[CAP_ALPHA_TEST  ]; } break;
+		case GL_SCISSOR_TEST: { state = &caps[CAP_SCISSOR_TEST]; } break;
+		case GL_STENCIL_TEST: { state = &caps[CAP_STENCIL_TEST]; } break;
+		default: {} break;
+	}
+
+	// untracked capabilities are always forwarded
+	if (state != nullptr && Filter(*state == uint8_t(b)))
+		return;
+
+	if (b) {
+		glEnable(cap);
+	} else {
+		glDisable(cap);
+	}
+
+	if (state != nullptr)
+		*state = b;
+}
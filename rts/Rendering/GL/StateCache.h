@@ -0,0 +1,140 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef GL_STATE_CACHE_H
+#define GL_STATE_CACHE_H
+
+#include <array>
+#include <cstdint>
+
+#include "Rendering/GL/myGL.h"
+
+namespace GL {
+	/**
+	 * Shadow copy of the most frequently toggled GL state, used to drop calls
+	 * which would not change anything.
+	 *
+	 * Most of the engine sets state directly, so the copy can only be trusted
+	 * while nothing else touches GL: callers Activate() it for such a stretch
+	 * (e.g. a Lua draw call-in) and Invalidate() it whenever control passes to
+	 * code that does not go through here. An invalidated entry is unknown and
+	 * the next request for it always reaches the driver. While inactive every
+	 * request is forwarded unconditionally and nothing is recorded.
+	 */
+	class StateCache {
+	public:
+		StateCache() { Invalidate(); }
+
+		static StateCache& GetInstance();
+
+		/// @return the previous activation state
+		bool Activate(bool b) {
+			const bool wasActive = active;
+
+			active = b;
+			Invalidate();
+			return wasActive;
+		}
+		bool IsActive() const { return active; }
+
+		void Invalidate() {
+			caps.fill(STATE_UNKNOWN);
+
+			blendFunc = {GL_INVALID_ENUM, GL_INVALID_ENUM};
+			depthFunc = GL_INVALID_ENUM;
+			cullFace = GL_INVALID_ENUM;
+			depthMask = STATE_UNKNOWN;
+			program = ~0u;
+		}
+
+		void Enable(GLenum cap) { SetCap(cap, true); }
+		void Disable(GLenum cap) { SetCap(cap, false); }
+		void SetCap(GLenum cap, bool b);
+
+		void BlendFunc(GLenum src, GLenum dst) {
+			if (Filter(src == blendFunc[0] && dst == blendFunc[1]))
+				return;
+
+			glBlendFunc(src, dst);
+			blendFunc = {src, dst};
+		}
+		void DepthFunc(GLenum func) {
+			if (Filter(func == depthFunc))
+				return;
+
+			glDepthFunc(func);
+			depthFunc = func;
+		}
+		void CullFace(GLenum mode) {
+			if (Filter(mode == cullFace))
+				return;
+
+			glCullFace(mode);
+			cullFace = mode;
+		}
+		void DepthMask(bool b) {
+			if (Filter(depthMask == uint8_t(b)))
+				return;
+
+			glDepthMask(b);
+			depthMask = b;
+		}
+		void UseProgram(GLuint id) {
+			if (Filter(id == program))
+				return;
+
+			glUseProgram(id);
+			program = id;
+		}
+
+		/// called once per frame, moves the running counts to the GetLastFrame* values
+		void EndFrame() {
+			numLastFrameCalls = numCalls;
+			numLastFrameFiltered = numFiltered;
+			numCalls = 0;
+			numFiltered = 0;
+		}
+
+		uint32_t GetLastFrameCalls() const { return numLastFrameCalls; }
+		uint32_t GetLastFrameFiltered() const { return numLastFrameFiltered; }
+
+	private:
+		bool Filter(bool redundant) {
+			if (!active)
+				return false;
+
+			numCalls += 1;
+			numFiltered += redundant;
+			return redundant;
+		}
+
+	private:
+		enum {
+			CAP_BLEND,
+			CAP_DEPTH_TEST,
+			CAP_CULL_FACE,
+			CAP_ALPHA_TEST,
+			CAP_SCISSOR_TEST,
+			CAP_STENCIL_TEST,
+			CAP_COUNT
+		};
+
+		static constexpr uint8_t STATE_UNKNOWN = 2;
+
+		bool active = false;
+
+		std::array<uint8_t, CAP_COUNT> caps;
+		std::array<GLenum, 2> blendFunc;
+
+		GLenum depthFunc;
+		GLenum cullFace;
+		uint8_t depthMask;
+		GLuint program;
+
+		uint32_t numCalls = 0;
+		uint32_t numFiltered = 0;
+		uint32_t numLastFrameCalls = 0;
+		uint32_t numLastFrameFiltered = 0;
+	};
+}
+
+#endif // GL_STATE_CACHE_H
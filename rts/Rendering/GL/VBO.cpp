@@ -42,6 +42,7 @@ bool VBO::IsSupported(GLenum target) {
 	static bool isUBOSupported  = (GLEW_ARB_uniform_buffer_object);
 	static bool isSSBOSupported = (GLEW_ARB_shader_storage_buffer_object);
 	static bool isCopyBuffSupported = (GLEW_ARB_copy_buffer);
+	static bool isDrawIndirectSupported = (GLEW_ARB_multi_draw_indirect);
 
 	switch (target) {
 	case GL_PIXEL_PACK_BUFFER:
@@ -57,6 +58,8 @@ bool VBO::IsSupported(GLenum target) {
 	case GL_COPY_WRITE_BUFFER:
 	case GL_COPY_READ_BUFFER:
 		return isCopyBuffSupported;
+	case GL_DRAW_INDIRECT_BUFFER:
+		return isDrawIndirectSupported;
 	default: {
 		LOG_L(L_ERROR, "[VBO:%s]: wrong target [%u] is specified", __func__, target);
 		return false;
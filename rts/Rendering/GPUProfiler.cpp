@@ -0,0 +1,141 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "GPUProfiler.h"
+#include "Rendering/GL/myGL.h"
+#include "System/Misc/SpringTime.h"
+
+CGPUProfiler gpuProfiler;
+
+
+void CGPUProfiler::Kill()
+{
+	if (haveQueries) {
+		for (FrameSlot& slot: frameSlots) {
+			glDeleteQueries(slot.queries.size(), slot.queries.data());
+		}
+	}
+
+	for (FrameSlot& slot: frameSlots) {
+		slot = {};
+	}
+
+	numDroppedFrames = 0;
+	curFrameIdx = 0;
+
+	active = false;
+	haveQueries = false;
+}
+
+
+void CGPUProfiler::BeginFrame()
+{
+	active = (GLEW_ARB_timer_query && (profiler.IsEnabled() || profiler.IsTracing()));
+
+	if (haveQueries) {
+		// oldest slot first, results become available in submission order
+		// so the remaining ones can not be ready if this one is not yet
+		for (unsigned int n = 1; n < NUM_FRAMES; n++) {
+			FrameSlot& slot = frameSlots[(curFrameIdx + n) % NUM_FRAMES];
+
+			if (!slot.pending)
+				continue;
+			if (!ReadBackFrame(slot))
+				break;
+		}
+	}
+
+	if (!active)
+		return;
+
+	if (!haveQueries) {
+		for (FrameSlot& slot: frameSlots) {
+			glGenQueries(slot.queries.size(), slot.queries.data());
+		}
+
+		haveQueries = true;
+	}
+
+	curFrameIdx = (curFrameIdx + 1) % NUM_FRAMES;
+
+	FrameSlot& slot = frameSlots[curFrameIdx];
+
+	numDroppedFrames += slot.pending;
+
+	slot.numSpans = 0;
+	slot.numOpenSpans = 0;
+	slot.lastQuery = -1;
+	slot.pending = false;
+
+	// unlike a timestamp query this returns the GPU time right away, so
+	// it can be paired with the CPU clock without waiting for the GPU
+	GLint64 gpuTime = 0;
+	glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+
+	slot.clockOffset = spring_gettime().toNanoSecsi() - gpuTime;
+}
+
+
+int CGPUProfiler::BeginSpan(unsigned nameHash)
+{
+	if (!active)
+		return -1;
+
+	FrameSlot& slot = frameSlots[curFrameIdx];
+
+	if (slot.numSpans >= MAX_SPANS)
+		return -1;
+
+	const int spanIdx = slot.numSpans++;
+
+	slot.nameHashes[spanIdx] = nameHash;
+	slot.lastQuery = spanIdx * 2;
+	slot.numOpenSpans += 1;
+	slot.pending = true;
+
+	glQueryCounter(slot.queries[spanIdx * 2], GL_TIMESTAMP);
+	return spanIdx;
+}
+
+void CGPUProfiler::EndSpan(int frameIdx, int spanIdx)
+{
+	FrameSlot& slot = frameSlots[frameIdx];
+
+	// slot was reused while the span was open
+	if (unsigned(spanIdx) >= slot.numSpans || slot.numOpenSpans == 0)
+		return;
+
+	slot.lastQuery = spanIdx * 2 + 1;
+	slot.numOpenSpans -= 1;
+
+	glQueryCounter(slot.queries[spanIdx * 2 + 1], GL_TIMESTAMP);
+}
+
+
+bool CGPUProfiler::ReadBackFrame(FrameSlot& slot)
+{
+	if (slot.numOpenSpans > 0)
+		return false;
+
+	GLint available = 0;
+	glGetQueryObjectiv(slot.queries[slot.lastQuery], GL_QUERY_RESULT_AVAILABLE, &available);
+
+	if (!available)
+		return false;
+
+	for (unsigned int i = 0; i < slot.numSpans; i++) {
+		GLuint64 t0 = 0;
+		GLuint64 t1 = 0;
+
+		glGetQueryObjectui64v(slot.queries[i * 2    ], GL_QUERY_RESULT, &t0);
+		glGetQueryObjectui64v(slot.queries[i * 2 + 1], GL_QUERY_RESULT, &t1);
+
+		const spring_time startTime = spring_time::fromNanoSecs(static_cast<int64_t>(t0) + slot.clockOffset);
+		const spring_time deltaTime = spring_time::fromNanoSecs(static_cast<int64_t>(t1 - t0));
+
+		profiler.AddTraceEvent(slot.nameHashes[i], startTime, deltaTime, CTimeProfiler::GPU_TRACE_THREAD);
+		profiler.AddTime(slot.nameHashes[i], startTime, deltaTime);
+	}
+
+	slot.pending = false;
+	return true;
+}
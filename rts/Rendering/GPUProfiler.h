@@ -0,0 +1,103 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef GPU_PROFILER_H
+#define GPU_PROFILER_H
+
+#include <array>
+#include <cstdint>
+
+#include "System/TimeProfiler.h"
+
+// GPU counterpart of SCOPED_TIMER; spans show up as "GPU::<name>" next to
+// the CPU timers in the profile drawer and on their own row in traces
+#define SCOPED_GPU_TIMER(name) static TimerNameRegistrar __gtnr("GPU::" name); CGPUProfiler::Scope __gpuTimer(hashString("GPU::" name));
+
+/**
+ * Measures the GPU time of render passes with GL_TIMESTAMP queries.
+ *
+ * Queries are issued into a ring of NUM_FRAMES per-frame slots and only
+ * read back once the driver reports them available, usually two or three
+ * draw-frames later, so measuring never stalls the pipeline; a slot that
+ * is still pending when its turn comes again is dropped. GPU timestamps
+ * are mapped onto the CPU clock through an offset sampled when its frame
+ * began. Queries are only issued while the CPU profiler is enabled or a
+ * trace is being captured.
+ */
+class CGPUProfiler {
+public:
+	struct Scope {
+	public:
+		Scope(unsigned nameHash);
+		~Scope();
+
+	private:
+		int spanIdx;
+		int frameIdx;
+	};
+
+public:
+	void Kill();
+
+	/// called at the start of each draw-frame, reads back finished frames
+	void BeginFrame();
+
+	int BeginSpan(unsigned nameHash);
+	void EndSpan(int frameIdx, int spanIdx);
+
+	bool IsActive() const { return active; }
+	int GetFrameIndex() const { return curFrameIdx; }
+
+	unsigned int GetNumDroppedFrames() const { return numDroppedFrames; }
+
+private:
+	static constexpr unsigned int NUM_FRAMES = 4;
+	static constexpr unsigned int MAX_SPANS = 128;
+
+	struct FrameSlot {
+		std::array<unsigned, MAX_SPANS> nameHashes;
+
+		// GL query names, [2 * i] := span begin, [2 * i + 1] := span end
+		std::array<uint32_t, MAX_SPANS * 2> queries;
+
+		// CPU minus GPU clock, in nanoseconds
+		int64_t clockOffset = 0;
+
+		unsigned int numSpans = 0;
+		unsigned int numOpenSpans = 0;
+		// index of the query issued last, completes after all others
+		int lastQuery = -1;
+
+		bool pending = false;
+	};
+
+	bool ReadBackFrame(FrameSlot& slot);
+
+private:
+	std::array<FrameSlot, NUM_FRAMES> frameSlots;
+
+	unsigned int numDroppedFrames = 0;
+
+	int curFrameIdx = 0;
+
+	bool active = false;
+	bool haveQueries = false;
+};
+
+extern CGPUProfiler gpuProfiler;
+
+
+inline CGPUProfiler::Scope::Scope(unsigned nameHash)
+	: spanIdx(gpuProfiler.BeginSpan(nameHash))
+	, frameIdx(gpuProfiler.GetFrameIndex())
+{
+}
+
+inline CGPUProfiler::Scope::~Scope()
+{
+	if (spanIdx < 0)
+		return;
+
+	gpuProfiler.EndSpan(frameIdx, spanIdx);
+}
+
+#endif // GPU_PROFILER_H
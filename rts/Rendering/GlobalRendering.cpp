@@ -9,6 +9,7 @@
 #include "Rendering/VerticalSync.h"
 #include "Rendering/GL/StreamBuffer.h"
 #include "Rendering/GL/RenderBuffers.h"
+#include "Rendering/GL/StateCache.h"
 #include "Rendering/GL/myGL.h"
 #include "Rendering/GL/FBO.h"
 #include "Rendering/UniformConstants.h"
@@ -18,6 +19,7 @@
 #include "System/type2.h"
 #include "System/TimeProfiler.h"
 #include "System/SafeUtil.h"
+#include "System/SpringMath.h"
 #include "System/StringUtil.h"
 #include "System/StringHash.h"
 #include "System/Matrix44f.h"
@@ -48,6 +50,7 @@ CONFIG(int, ForceDisableGL4).defaultValue(0).safemodeValue(1).minimumValue(0).ma
 
 CONFIG(int, ForceCoreContext).defaultValue(0).minimumValue(0).maximumValue(1);
 CONFIG(int, ForceSwapBuffers).defaultValue(1).minimumValue(0).maximumValue(1);
+CONFIG(int, LowLatencyFrameRate).defaultValue(0).headlessValue(0).minimumValue(0).description("If greater than 0, waits before starting each frame so that it finishes just in time for a display running at this rate (usually its refresh rate, with VSync enabled), which lowers input latency whenever frames take less time than the refresh interval. 0 disables frame pacing.");
 CONFIG(int, AtiHacks).defaultValue(-1).headlessValue(0).minimumValue(-1).maximumValue(1).description("Enables graphics drivers workarounds for users with AMD video cards.\n -1:=runtime detect, 0:=off, 1:=on");
 
 // enabled in safemode, far more likely the gpu runs out of memory than this extension causes crashes!
@@ -111,6 +114,8 @@ CR_REG_METADATA(CGlobalRendering, (
 	CR_MEMBER(lastFrameTime),
 	CR_MEMBER(lastFrameStart),
 	CR_MEMBER(lastSwapBuffersEnd),
+	CR_IGNORED(pacedFrameStart),
+	CR_IGNORED(pacedFrameCost),
 	CR_MEMBER(weightedSpeedFactor),
 	CR_MEMBER(drawFrame),
 	CR_MEMBER(FPS),
@@ -204,6 +209,8 @@ CGlobalRendering::CGlobalRendering()
 	, lastFrameTime(0.0f)
 	, lastFrameStart(spring_notime)
 	, lastSwapBuffersEnd(spring_notime)
+	, pacedFrameStart(spring_notime)
+	, pacedFrameCost(0.0f)
 	, weightedSpeedFactor(0.0f)
 	, drawFrame(1)
 	, FPS(1.0f)
@@ -632,7 +639,14 @@ void CGlobalRendering::SwapBuffers(bool allowSwapBuffers, bool clearErrors)
 
 	const spring_time pre = spring_now();
 
+	if (pacedFrameStart != spring_notime) {
+		// rise immediately but decay slowly, a late frame costs more than a slightly early one
+		const float frameCost = (pre - pacedFrameStart).toMilliSecsf();
+		pacedFrameCost = std::max(frameCost, mix(pacedFrameCost, frameCost, 0.05f));
+	}
+
 	RenderBuffer::SwapStandardRenderBuffers();
+	GL::StateCache::GetInstance().EndFrame();
 	//CglFont::SwapRenderBuffers();
 	IStreamBufferConcept::PutBufferLocks();
 	SDL_GL_SwapWindow(sdlWindows[0]);
@@ -640,6 +654,30 @@ void CGlobalRendering::SwapBuffers(bool allowSwapBuffers, bool clearErrors)
 	globalRendering->lastSwapBuffersEnd = spring_now();
 }
 
+void CGlobalRendering::PaceFrame()
+{
+	const int targetRate = configHandler->GetInt("LowLatencyFrameRate");
+
+	if (targetRate <= 0 || lastSwapBuffersEnd == spring_notime) {
+		pacedFrameStart = spring_notime;
+		return;
+	}
+
+	{
+		SCOPED_TIMER("Misc::PaceFrame");
+
+		// wake up a little early, sleeps are only about millisecond-accurate
+		const float frameTime = 1000.0f / targetRate;
+		const float idleTime = (spring_now() - lastSwapBuffersEnd).toMilliSecsf();
+		const float waitTime = frameTime - pacedFrameCost - idleTime - 1.5f;
+
+		if (waitTime > 0.0f)
+			spring_sleep(spring_msecs(waitTime));
+	}
+
+	pacedFrameStart = spring_now();
+}
+
 void CGlobalRendering::SetGLTimeStamp(uint32_t queryIdx) const
 {
 	if (!GLEW_ARB_timer_query)
@@ -51,6 +51,12 @@ public:
 	void PostInit();
 
 	void SwapBuffers(bool allowSwapBuffers, bool clearErrors);
+	/**
+	 * Delays the start of the next frame (and with it input sampling) such
+	 * that the frame's predicted work ends just before the next swap, see
+	 * LowLatencyFrameRate. Called by the main loop before handling events.
+	 */
+	void PaceFrame();
 
 	void SetGLTimeStamp(uint32_t queryIdx) const;
 	uint64_t CalcGLDeltaTime(uint32_t queryIdx0, uint32_t queryIdx1) const;
@@ -127,6 +133,10 @@ public:
 
 	spring_time lastSwapBuffersEnd;
 
+	/// end of the last PaceFrame call, and predicted work time (in MILLIseconds) until the following swap
+	spring_time pacedFrameStart;
+	float pacedFrameCost;
+
 	/// 0.001f * gu->simFPS, used for rendering
 	float weightedSpeedFactor;
 
@@ -21,9 +21,10 @@ CLineDrawer::CLineDrawer()
 	, lastPos(ZeroVector)
 	, lastColor(NULL)
 	, stippleTimer(0.0f)
+	, curBatch(&lines)
+	, stripPos(ZeroVector)
+	, stripColor(NULL)
 {
-	lines.reserve(32);
-	stippled.reserve(32);
 }
 
 
@@ -51,7 +52,7 @@ void CLineDrawer::SetupLineStipple()
 
 void CLineDrawer::DrawAll()
 {
-	if (lines.empty() && stippled.empty())
+	if (lines.verts.empty() && stippled.verts.empty())
 		return;
 	
 	glEnableClientState(GL_VERTEX_ARRAY);
@@ -62,25 +63,17 @@ void CLineDrawer::DrawAll()
 	glDisable(GL_DEPTH_TEST);
 	glDisable(GL_LINE_STIPPLE);
 
-	for (int i = 0; i<lines.size(); ++i) {
-		int size = lines[i].colors.size();
-		if(size > 0) {
-			glColorPointer(4, GL_FLOAT, 0, &lines[i].colors[0]);
-			glVertexPointer(3, GL_FLOAT, 0, &lines[i].verts[0]);
-			glDrawArrays(lines[i].type, 0, size/4);
-		}
+	if (!lines.verts.empty()) {
+		glColorPointer(4, GL_FLOAT, 0, lines.colors.data());
+		glVertexPointer(3, GL_FLOAT, 0, lines.verts.data());
+		glDrawArrays(GL_LINES, 0, lines.verts.size() / 3);
 	}
 
-	if (!stippled.empty()) {
+	if (!stippled.verts.empty()) {
 		glEnable(GL_LINE_STIPPLE);
-		for (int i = 0; i<stippled.size(); ++i) {
-			int size = stippled[i].colors.size();
-			if(size > 0) {
-				glColorPointer(4, GL_FLOAT, 0, &stippled[i].colors[0]);
-				glVertexPointer(3, GL_FLOAT, 0, &stippled[i].verts[0]);
-				glDrawArrays(stippled[i].type, 0, size/4);
-			}
-		}
+		glColorPointer(4, GL_FLOAT, 0, stippled.colors.data());
+		glVertexPointer(3, GL_FLOAT, 0, stippled.verts.data());
+		glDrawArrays(GL_LINES, 0, stippled.verts.size() / 3);
 		glDisable(GL_LINE_STIPPLE);
 	}
 
@@ -88,6 +81,6 @@ void CLineDrawer::DrawAll()
 	glDisableClientState(GL_VERTEX_ARRAY);
 	glPopAttrib();
 
-	lines.clear();
-	stippled.clear();
+	lines.Clear();
+	stippled.Clear();
 }
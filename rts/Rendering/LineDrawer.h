@@ -45,15 +45,34 @@ class CLineDrawer {
 		
 		float stippleTimer;
 
-		// queue all lines and draw them in one go later
-		struct LinePair {
-			GLenum type;
+		// queue all lines and draw them in one go later; strips are
+		// split into segments s.t. each batch needs only one GL_LINES
+		// draw call and the buffers keep their capacity across frames
+		struct LineBatch {
 			std::vector<GLfloat> verts;
 			std::vector<GLfloat> colors;
+
+			void AddVertex(const float3& pos, const float* color) {
+				verts.insert(verts.end(), {pos.x, pos.y, pos.z});
+				colors.insert(colors.end(), {color[0], color[1], color[2], color[3]});
+			}
+			void AddVertex(const float3& pos, const float* color, float alpha) {
+				verts.insert(verts.end(), {pos.x, pos.y, pos.z});
+				colors.insert(colors.end(), {color[0], color[1], color[2], alpha});
+			}
+			void Clear() {
+				verts.clear();
+				colors.clear();
+			}
 		};
 
-		std::vector<LinePair> lines;
-		std::vector<LinePair> stippled;
+		LineBatch lines;
+		LineBatch stippled;
+		LineBatch* curBatch;
+
+		// last vertex of the current strip (if !useColorRestarts)
+		float3 stripPos;
+		const float* stripColor;
 };
 
 
@@ -90,28 +109,10 @@ inline void CLineDrawer::Break(const float3& endPos, const float* color)
 
 inline void CLineDrawer::Restart()
 {
-	LinePair *ptr;
-	if (lineStipple) {
-		stippled.push_back(LinePair());
-		ptr = &stippled.back();
-	} else {
-		lines.push_back(LinePair());
-		ptr = &lines.back();
-	}
-	LinePair& p = *ptr;
-
-	if (!useColorRestarts)	 {
-		p.type = GL_LINE_STRIP;
-		p.colors.push_back(lastColor[0]);
-		p.colors.push_back(lastColor[1]);
-		p.colors.push_back(lastColor[2]);
-		p.colors.push_back(lastColor[3]);
-		p.verts.push_back(lastPos[0]);
-		p.verts.push_back(lastPos[1]);
-		p.verts.push_back(lastPos[2]);
-	} else {
-		p.type = GL_LINES;
-	}
+	curBatch = lineStipple? &stippled: &lines;
+
+	stripPos = lastPos;
+	stripColor = lastColor;
 }
 
 
@@ -140,45 +141,22 @@ inline void CLineDrawer::StartPath(const float3& pos, const float* color)
 
 inline void CLineDrawer::DrawLine(const float3& endPos, const float* color)
 {
-	LinePair *ptr;
-	if (lineStipple) {
-		ptr = &stippled.back();
-	} else {
-		ptr = &lines.back();
-	}
-	LinePair& p = *ptr;
+	LineBatch& batch = *curBatch;
 
 	if (!useColorRestarts) {
-		p.colors.push_back(color[0]);
-		p.colors.push_back(color[1]);
-		p.colors.push_back(color[2]);
-		p.colors.push_back(color[3]);
-		p.verts.push_back(endPos.x);
-		p.verts.push_back(endPos.y);
-		p.verts.push_back(endPos.z);
+		batch.AddVertex(stripPos, stripColor);
+		batch.AddVertex(endPos, color);
+
+		stripPos = endPos;
+		stripColor = color;
 	} else {
 		if (useRestartColor) {
-			p.colors.push_back(restartColor[0]);
-			p.colors.push_back(restartColor[1]);
-			p.colors.push_back(restartColor[2]);
-			p.colors.push_back(restartColor[3]);
+			batch.AddVertex(lastPos, restartColor);
 		} else {
-			p.colors.push_back(color[0]);
-			p.colors.push_back(color[1]);
-			p.colors.push_back(color[2]);
-			p.colors.push_back(color[3] * restartAlpha);
+			batch.AddVertex(lastPos, color, color[3] * restartAlpha);
 		}
-		p.verts.push_back(lastPos.x);
-		p.verts.push_back(lastPos.y);
-		p.verts.push_back(lastPos.z);
-
-		p.colors.push_back(color[0]);
-		p.colors.push_back(color[1]);
-		p.colors.push_back(color[2]);
-		p.colors.push_back(color[3]);
-		p.verts.push_back(endPos.x);
-		p.verts.push_back(endPos.y);
-		p.verts.push_back(endPos.z);
+
+		batch.AddVertex(endPos, color);
 	}
 
 	lastPos = endPos;
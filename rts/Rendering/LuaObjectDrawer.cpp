@@ -22,6 +22,9 @@
 #include "System/EventHandler.h"
 #include "System/SafeUtil.h"
 
+#include <algorithm>
+#include <iterator>
+
 
 // optimisation for team-color, but potentially breaks
 // the alpha-pass and matrices can not be bucket-sorted
@@ -102,7 +105,6 @@ static DECL_ARRAY(   UnitDrawFunc,    unitDrawFuncs, 2) = {nullptr, nullptr};
 static DECL_ARRAY(FeatureDrawFunc, featureDrawFuncs, 2) = {nullptr, nullptr};
 
 static DECL_ARRAY(bool, notifyEventFlags, LUAOBJ_LAST) = {false, false};
-static DECL_ARRAY(bool, bufferClearFlags, LUAOBJ_LAST) = { true,  true};
 
 static constexpr DECL_ARRAY(LuaMatType, opaqueMats, 2) = {LUAMAT_OPAQUE, LUAMAT_OPAQUE_REFLECT};
 static constexpr DECL_ARRAY(LuaMatType,  alphaMats, 2) = {LUAMAT_ALPHA, LUAMAT_ALPHA_REFLECT};
@@ -110,7 +112,9 @@ static constexpr DECL_ARRAY(LuaMatType,  alphaMats, 2) = {LUAMAT_ALPHA, LUAMAT_A
 static constexpr DECL_ARRAY(LuaMatShader::Pass, shaderPasses, 2) = {LuaMatShader::LUASHADER_PASS_FWD, LuaMatShader::LUASHADER_PASS_DFR};
 
 #ifdef USE_OBJECT_RENDERING_BUCKETS
-static DECL_ARRAY(std::vector<const CSolidObject*>, objectBuckets, MAX_TEAMS);
+// counting-sort scratch space, reused by every bin and pass
+static DECL_ARRAY(unsigned int, teamObjectCounts, MAX_TEAMS + 1);
+static std::vector<CSolidObject*> teamSortedObjects;
 #endif
 
 
@@ -284,15 +288,7 @@ void LuaObjectDrawer::Update(bool init)
 		drawDeferredEnabled &= (geomBuffer->Update(init));
 
 		notifyEventFlags[LUAOBJ_UNIT   ] = !unitDrawer->DrawForward() || configHandler->GetBool("AllowDrawModelPostDeferredEvents");
-		bufferClearFlags[LUAOBJ_UNIT   ] =  unitDrawer->DrawDeferred();
 		notifyEventFlags[LUAOBJ_FEATURE] = !featureDrawer->DrawForward() || configHandler->GetBool("AllowDrawModelPostDeferredEvents");
-		bufferClearFlags[LUAOBJ_FEATURE] =  featureDrawer->DrawDeferred();
-
-		// if both object types are going to be drawn deferred, only
-		// reset buffer for the first s.t. just a single shading pass
-		// is needed (in Lua)
-		if (bufferClearFlags[LUAOBJ_UNIT] && bufferClearFlags[LUAOBJ_FEATURE])
-			bufferClearFlags[LUAOBJ_FEATURE] = bufferClearAllowed;
 	}
 }
 
@@ -356,6 +352,12 @@ void LuaObjectDrawer::DrawMaterialBins(LuaObjType objType, LuaMatType matType, b
 
 	for (const auto& bin: bins) {
 		assert(matType == bin->type);
+
+		// bins stay alive as long as any object references their material,
+		// most are empty in a given pass and so not worth a state change
+		if (bin->GetObjects(objType).empty() && !bin->HasDrawCall())
+			continue;
+
 		DrawMaterialBin(bin, prevMat, objType, matType, deferredPass, inAlphaBin);
 		prevMat = bin;
 	}
@@ -395,26 +397,38 @@ void LuaObjectDrawer::DrawMaterialBin(
 	binObjTeam = -1;
 
 	#ifdef USE_OBJECT_RENDERING_BUCKETS
-	int minObjTeam = MAX_TEAMS;
-	int maxObjTeam = 0;
+	const std::vector<CSolidObject*>* drawObjects = &objects;
 
-	for (const CSolidObject* obj: objects) {
-		objectBuckets[obj->team].push_back(obj);
+	std::fill(std::begin(teamObjectCounts), std::end(teamObjectCounts), 0);
+
+	bool teamSorted = true;
 
-		minObjTeam = std::min(minObjTeam, obj->team);
-		maxObjTeam = std::max(maxObjTeam, obj->team);
+	for (size_t i = 0, n = objects.size(); i < n; i++) {
+		teamObjectCounts[objects[i]->team + 1] += 1;
+		teamSorted &= (i == 0 || objects[i - 1]->team <= objects[i]->team);
 	}
 
-	for (int objTeam = minObjTeam; objTeam <= maxObjTeam; objTeam++) {
-		for (const CSolidObject* obj: objectBuckets[objTeam]) {
-			const LuaObjectMaterialData* matData = obj->GetLuaMaterialData();
-			const LuaObjectLODMaterial* lodMat = matData->GetLuaLODMaterial(matType);
+	// objects are added in the same order every pass, which for most
+	// bins (one team, or units of one model) is already team-ordered
+	if (!teamSorted) {
+		for (int objTeam = 1; objTeam <= MAX_TEAMS; objTeam++) {
+			teamObjectCounts[objTeam] += teamObjectCounts[objTeam - 1];
+		}
+
+		teamSortedObjects.resize(objects.size());
 
-			DrawBinObject(obj, objType, lodMat, currBin,  deferredPass, alphaMatBin, true, false);
+		for (CSolidObject* obj: objects) {
+			teamSortedObjects[teamObjectCounts[obj->team]++] = obj;
 		}
 
-		objectBuckets[objTeam].clear();
-		objectBuckets[objTeam].reserve(128);
+		drawObjects = &teamSortedObjects;
+	}
+
+	for (const CSolidObject* obj: *drawObjects) {
+		const LuaObjectMaterialData* matData = obj->GetLuaMaterialData();
+		const LuaObjectLODMaterial* lodMat = matData->GetLuaLODMaterial(matType);
+
+		DrawBinObject(obj, objType, lodMat, currBin,  deferredPass, alphaMatBin, true, false);
 	}
 
 	#else
@@ -477,7 +491,7 @@ void LuaObjectDrawer::DrawBinObject(
 }
 
 
-void LuaObjectDrawer::DrawDeferredPass(LuaObjType objType)
+void LuaObjectDrawer::DrawDeferredPass()
 {
 	if (!drawDeferredEnabled)
 		return;
@@ -488,50 +502,71 @@ void LuaObjectDrawer::DrawDeferredPass(LuaObjType objType)
 	// bail early if the FFP state *is going to be* selected by
 	// SetupOpaqueDrawing, and also if our shader-path happens
 	// to be ARB instead (saves an FBO bind)
-	if (!(CUnitDrawer::CanDrawDeferred()))
+	const bool drawUnits    = CUnitDrawer::DrawDeferred()    && CUnitDrawer::CanDrawDeferred();
+	const bool drawFeatures = CFeatureDrawer::DrawDeferred() && CFeatureDrawer::CanDrawDeferred();
+
+	if (!drawUnits && !drawFeatures)
 		return;
 
+	// units and features are written into the same buffer during
+	// one bind and one clear, so Lua needs only a single shading
+	// pass; unless the feature pass was configured to reset the
+	// buffer, in which case the unit contents must be consumed
+	// (by the *PostDeferred event) before it
+	const bool splitPasses = (drawUnits && drawFeatures && bufferClearAllowed);
+
 	// note: should also set this during the map pass (in SMFGD)
 	game->SetDrawMode(CGame::gameDeferredDraw);
-	geomBuffer->Bind();
-	geomBuffer->SetDepthRange(1.0f, 0.0f);
+	BeginDeferredPass();
 
-	// reset the buffer (since we do not perform a single pass
-	// writing both units and features into it at the same time)
-	// this however forces Lua to execute two shading passes and
-	// listen to the *PostDeferred events, so not ideal
-	// geomBuffer->Clear();
+	if (drawUnits)
+		unitDrawer->DrawOpaquePass(true, false, false);
 
-	if (bufferClearFlags[objType])
-		geomBuffer->Clear();
-
-	switch (objType) {
-		case LUAOBJ_UNIT: {
-			unitDrawer->DrawOpaquePass(true, false, false);
-		} break;
-		case LUAOBJ_FEATURE: {
-			featureDrawer->DrawOpaquePass(true, false, false);
-		} break;
-		default: {
-			assert(false);
-		} break;
+	if (splitPasses) {
+		EndDeferredPass();
+		NotifyDeferredPass(LUAOBJ_UNIT);
+		BeginDeferredPass();
 	}
 
-	geomBuffer->SetDepthRange(0.0f, 1.0f);
-	geomBuffer->UnBind();
+	if (drawFeatures)
+		featureDrawer->DrawOpaquePass(true, false, false);
+
+	EndDeferredPass();
 	game->SetDrawMode(CGame::gameNormalDraw);
 
 	#if 0
 	geomBuffer->DrawDebug(geomBuffer->GetBufferTexture(GL::GeometryBuffer::ATTACHMENT_NORMTEX));
 	#endif
 
-	if (notifyEventFlags[objType]) {
-		// at this point the buffer has been filled (all standard
-		// models and custom Lua material bins have been rendered
-		// into it) and unbound, notify scripts
-		assert(eventFuncs[objType] != nullptr);
-		CALL_FUNC_NA(&eventHandler, eventFuncs[objType]);
-	}
+	if (drawUnits && !splitPasses)
+		NotifyDeferredPass(LUAOBJ_UNIT);
+	if (drawFeatures)
+		NotifyDeferredPass(LUAOBJ_FEATURE);
+}
+
+void LuaObjectDrawer::BeginDeferredPass()
+{
+	geomBuffer->Bind();
+	geomBuffer->SetDepthRange(1.0f, 0.0f);
+	geomBuffer->Clear();
+}
+
+void LuaObjectDrawer::EndDeferredPass()
+{
+	geomBuffer->SetDepthRange(0.0f, 1.0f);
+	geomBuffer->UnBind();
+}
+
+void LuaObjectDrawer::NotifyDeferredPass(LuaObjType objType)
+{
+	if (!notifyEventFlags[objType])
+		return;
+
+	// at this point the buffer has been filled (all standard
+	// models and custom Lua material bins have been rendered
+	// into it) and unbound, notify scripts
+	assert(eventFuncs[objType] != nullptr);
+	CALL_FUNC_NA(&eventHandler, eventFuncs[objType]);
 }
 
 
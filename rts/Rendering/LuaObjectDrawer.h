@@ -23,7 +23,7 @@ class LuaMatShader;
 class LuaObjectDrawer {
 public:
 	static bool InDrawPass() { return inDrawPass; }
-	static void DrawDeferredPass(LuaObjType objType);
+	static void DrawDeferredPass();
 
 	static bool DrawSingleObjectCommon(const CSolidObject* obj, LuaObjType objType, bool applyTrans);
 	static bool DrawSingleObject(const CSolidObject* obj, LuaObjType objType);
@@ -70,6 +70,10 @@ public:
 	static GL::GeometryBuffer* GetGeometryBuffer() { return geomBuffer; }
 
 private:
+	static void BeginDeferredPass();
+	static void EndDeferredPass();
+	static void NotifyDeferredPass(LuaObjType objType);
+
 	static void DrawMaterialBins(LuaObjType objType, LuaMatType matType, bool deferredPass);
 	static void DrawMaterialBin(
 		const LuaMatBin* currBin,
@@ -104,7 +108,8 @@ private:
 	// whether deferred object drawing is allowed by user
 	static bool drawDeferredAllowed;
 
-	// whether the deferred feature pass clears the GB
+	// whether the deferred feature pass clears the GB again
+	// (forces a separate bind and shading pass for features)
 	static bool bufferClearAllowed;
 
 	// team of last object visited in DrawMaterialBin
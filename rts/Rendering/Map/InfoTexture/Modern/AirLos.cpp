@@ -8,12 +8,14 @@
 #include "Sim/Misc/LosHandler.h"
 #include "System/Exceptions.h"
 #include "System/Log/ILog.h"
+#include "System/Threading/ThreadPool.h"
 
 
 
 CAirLosTexture::CAirLosTexture()
 : CPboInfoTexture("airlos")
 , uploadTex(0)
+, fullView(false)
 {
 	texSize = losHandler->airLos.size;
 	texChannels = 1;
@@ -102,11 +104,11 @@ void CAirLosTexture::UpdateCPU()
 
 	if (!losHandler->GetGlobalLOS(gu->myAllyTeam)) {
 		const unsigned short* myAirLos = &losHandler->airLos.losMaps[gu->myAllyTeam].front();
-		for (int y = 0; y < texSize.y; ++y) {
+		for_mt(0, texSize.y, [&](const int y) {
 			for (int x = 0; x < texSize.x; ++x) {
 				infoTexMem[y * texSize.x + x] = (myAirLos[y * texSize.x + x] != 0) ? 255 : 0;
 			}
-		}
+		});
 	} else {
 		memset(infoTexMem, 255, texSize.x * texSize.y);
 	}
@@ -122,10 +124,18 @@ void CAirLosTexture::UpdateCPU()
 
 void CAirLosTexture::Update()
 {
+	const bool globalLOS = losHandler->GetGlobalLOS(gu->myAllyTeam);
+
+	// nothing changes while the view stays at full LOS
+	if (globalLOS && fullView)
+		return;
+
+	fullView = globalLOS;
+
 	if (!fbo.IsValid() || !shader->IsValid() || uploadTex == 0)
 		return UpdateCPU();
 
-	if (losHandler->GetGlobalLOS(gu->myAllyTeam)) {
+	if (globalLOS) {
 		fbo.Bind();
 		glViewport(0,0, texSize.x, texSize.y);
 		glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
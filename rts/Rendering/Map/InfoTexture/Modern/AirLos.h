@@ -20,7 +20,7 @@ public:
 
 public:
 	void Update() override;
-	bool IsUpdateNeeded() override { return true; }
+	bool IsUpdateNeeded() override { return IsInUse(); }
 
 private:
 	void UpdateCPU();
@@ -29,6 +29,9 @@ private:
 	FBO fbo;
 	GLuint uploadTex;
 	Shader::IProgramObject* shader;
+
+	// texture holds the constant full-view image
+	bool fullView;
 };
 
 #endif // _AIRLOS_TEXTURE_H
@@ -11,6 +11,7 @@
 #include "System/Exceptions.h"
 #include "System/Config/ConfigHandler.h"
 #include "System/Log/ILog.h"
+#include "System/Threading/ThreadPool.h"
 
 
 // currently defined in HeightLinePalette.cpp
@@ -113,14 +114,14 @@ void CHeightTexture::UpdateCPU()
 	infoTexPBO.New(texSize.x * texSize.y * texChannels, GL_STREAM_DRAW);
 	auto infoTexMem = reinterpret_cast<SColor*>(infoTexPBO.MapBuffer());
 
-	for (int y = 0; y < texSize.y; ++y) {
+	for_mt(0, texSize.y, [&](const int y) {
 		for (int x = 0; x < texSize.x; ++x) {
 			const int idx = y * texSize.x + x;
 			const float height = heightMap[idx];
 			const unsigned int value = ((unsigned int)(height * 8.0f)) % 255;
 			infoTexMem[idx] = extraTexPal[value];
 		}
-	}
+	});
 
 	infoTexPBO.UnmapBuffer();
 	glBindTexture(GL_TEXTURE_2D, texture);
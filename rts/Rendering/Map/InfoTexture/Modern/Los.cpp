@@ -8,12 +8,14 @@
 #include "Sim/Misc/LosHandler.h"
 #include "System/Exceptions.h"
 #include "System/Log/ILog.h"
+#include "System/Threading/ThreadPool.h"
 
 
 
 CLosTexture::CLosTexture()
 : CPboInfoTexture("los")
 , uploadTex(0)
+, fullView(false)
 {
 	texSize = losHandler->los.size;
 	texChannels = 1;
@@ -104,11 +106,11 @@ void CLosTexture::UpdateCPU()
 
 	if (!losHandler->GetGlobalLOS(gu->myAllyTeam)) {
 		const unsigned short* myLos = &losHandler->los.losMaps[gu->myAllyTeam].front();
-		for (int y = 0; y < texSize.y; ++y) {
+		for_mt(0, texSize.y, [&](const int y) {
 			for (int x = 0; x < texSize.x; ++x) {
 				infoTexMem[y * texSize.x + x] = (myLos[y * texSize.x + x] != 0) ? 255 : 0;
 			}
-		}
+		});
 	} else {
 		memset(infoTexMem, 255, texSize.x * texSize.y);
 	}
@@ -124,10 +126,18 @@ void CLosTexture::UpdateCPU()
 
 void CLosTexture::Update()
 {
+	const bool globalLOS = losHandler->GetGlobalLOS(gu->myAllyTeam);
+
+	// nothing changes while the view stays at full LOS
+	if (globalLOS && fullView)
+		return;
+
+	fullView = globalLOS;
+
 	if (!fbo.IsValid() || !shader->IsValid() || uploadTex == 0)
 		return UpdateCPU();
 
-	if (losHandler->GetGlobalLOS(gu->myAllyTeam)) {
+	if (globalLOS) {
 		fbo.Bind();
 		glViewport(0,0, texSize.x, texSize.y);
 		glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
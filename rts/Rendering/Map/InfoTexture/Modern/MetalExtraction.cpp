@@ -85,6 +85,13 @@ CMetalExtractionTexture::CMetalExtractionTexture()
 
 bool CMetalExtractionTexture::IsUpdateNeeded()
 {
+	// also samples the los texture, so this would keep that one busy too;
+	// restart the count such that the first use is not a second behind
+	if (!IsInUse()) {
+		updateN = 0;
+		return false;
+	}
+
 	// update only once per second
 	return (updateN++ % GAME_SPEED == 0);
 }
@@ -29,7 +29,6 @@ CPathTexture::CPathTexture()
 , lastSelectedPathType(0)
 , forcedPathType(-1)
 , forcedUnitDef(-1)
-, lastUsage(spring_gettime())
 {
 	texSize = int2(mapDims.hmapx, mapDims.hmapy);
 	texChannels = 4;
@@ -125,13 +124,6 @@ const UnitDef* CPathTexture::GetCurrentBuildCmdUnitDef()
 }
 
 
-GLuint CPathTexture::GetTexture()
-{
-	lastUsage = spring_gettime();
-	return texture;
-}
-
-
 bool CPathTexture::ShowMoveDef(const int pathType)
 {
 	forcedUnitDef  = -1;
@@ -153,7 +145,7 @@ bool CPathTexture::ShowUnitDef(const int udefid)
 bool CPathTexture::IsUpdateNeeded()
 {
 	// don't update when not rendered/used
-	if ((spring_gettime() - lastUsage).toSecsi() > 2) {
+	if (!IsInUse()) {
 		forcedUnitDef = forcedPathType = -1;
 		return false;
 	}
@@ -225,27 +217,30 @@ void CPathTexture::Update()
 	if (ud != nullptr) {
 		// CGameHelper::TestUnitBuildSquare accesses QuadField which is not re-entrant
 		// for_mt(start, updateProcess, [&](const int y) {
+		buildPositions.clear();
+
 		for (int y = start; y < updateProcess; y++) {
 			for (int x = 0; x < texSize.x; ++x) {
-				const float3 pos = float3(x << 1, 0.0f, y << 1) * SQUARE_SIZE;
-				const int idx = y * texSize.x + x;
+				BuildInfo bi(ud, float3(x << 1, 0.0f, y << 1) * SQUARE_SIZE, guihandler->buildFacing);
+				buildPositions.push_back(CGameHelper::Pos2BuildPos(bi, false));
+			}
+		}
 
-				BuildSquareStatus status = FREE;
-				BuildInfo bi(ud, pos, guihandler->buildFacing);
-				bi.pos = CGameHelper::Pos2BuildPos(bi, false);
+		// one batch per update, neighbouring footprints share most squares
+		CGameHelper::TestUnitBuildSquares(ud, guihandler->buildFacing, buildPositions, gu->myAllyTeam, false, buildStatuses, &buildFeatures);
 
-				CFeature* f = nullptr;
+		for (size_t i = 0; i < buildPositions.size(); i++) {
+			BuildSquareStatus status = FREE;
 
-				if (CGameHelper::TestUnitBuildSquare(bi, f, gu->myAllyTeam, false)) {
-					if (f != nullptr) {
-						status = OBJECTBLOCKED;
-					}
-				} else {
-					status = TERRAINBLOCKED;
+			if (buildStatuses[i]) {
+				if (buildFeatures[i] != nullptr) {
+					status = OBJECTBLOCKED;
 				}
-
-				infoTexMem[idx - offset] = GetBuildColor(status);
+			} else {
+				status = TERRAINBLOCKED;
 			}
+
+			infoTexMem[i] = GetBuildColor(status);
 		}
 	} else if (md != nullptr) {
 		for_mt(start, updateProcess, [&](const int y) {
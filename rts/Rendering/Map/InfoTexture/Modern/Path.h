@@ -4,6 +4,7 @@
 #define _PATH_TEXTURE_H
 
 #include "PboInfoTexture.h"
+#include "Game/GameHelper.h"
 #include "Rendering/GL/FBO.h"
 #include "System/Misc/SpringTime.h"
 
@@ -21,8 +22,6 @@ public:
 	void Update() override;
 	bool IsUpdateNeeded() override;
 
-	GLuint GetTexture() override;
-
 	bool ShowMoveDef(const int pathType);
 	bool ShowUnitDef(const int udefid);
 
@@ -37,8 +36,12 @@ private:
 	unsigned int lastSelectedPathType;
 	int forcedPathType;
 	int forcedUnitDef;
-	spring_time lastUsage;
 	FBO fbo;
+
+	// scratch for CGameHelper::TestUnitBuildSquares
+	std::vector<float3> buildPositions;
+	std::vector<CGameHelper::BuildSquareStatus> buildStatuses;
+	std::vector<CFeature*> buildFeatures;
 };
 
 #endif // _PATH_TEXTURE_H
@@ -8,6 +8,7 @@ CPboInfoTexture::CPboInfoTexture(const std::string& _name)
 	name        = _name;
 	texChannels = 0;
 	texture     = 0;
+	lastUsage   = spring_gettime();
 }
 
 
@@ -5,6 +5,7 @@
 
 #include "Rendering/Map/InfoTexture/InfoTexture.h"
 #include "Rendering/GL/PBO.h"
+#include "System/Misc/SpringTime.h"
 
 
 
@@ -19,8 +20,15 @@ public:
 	virtual void Update() = 0;
 	virtual bool IsUpdateNeeded() = 0;
 
+	GLuint GetTexture() override { lastUsage = spring_gettime(); return texture; }
+
+protected:
+	// false if nothing sampled the texture in the last few seconds
+	bool IsInUse() const { return ((spring_gettime() - lastUsage).toSecsi() <= 2); }
+
 protected:
 	PBO infoTexPBO;
+	spring_time lastUsage;
 };
 
 #endif // _PBO_INFO_TEXTURE_H
@@ -10,6 +10,7 @@
 #include "Sim/Misc/ModInfo.h"
 #include "System/Exceptions.h"
 #include "System/Log/ILog.h"
+#include "System/Threading/ThreadPool.h"
 
 
 
@@ -17,6 +18,7 @@ CRadarTexture::CRadarTexture()
 : CPboInfoTexture("radar")
 , uploadTexRadar(0)
 , uploadTexJammer(0)
+, fullView(false)
 {
 	texSize = losHandler->radar.size;
 	texChannels = 2;
@@ -131,13 +133,13 @@ void CRadarTexture::UpdateCPU()
 
 		const unsigned short* myRadar  = &losHandler->radar.losMaps[gu->myAllyTeam].front();
 		const unsigned short* myJammer = &losHandler->jammer.losMaps[jammerAllyTeam].front();
-		for (int y = 0; y < texSize.y; ++y) {
+		for_mt(0, texSize.y, [&](const int y) {
 			for (int x = 0; x < texSize.x; ++x) {
 				const int idx = y * texSize.x + x;
 				infoTexMem[idx * 2 + 0] = ( myRadar[idx] != 0) ? 255 : 0;
 				infoTexMem[idx * 2 + 1] = (myJammer[idx] != 0 && myLos[idx] != 0) ? 255 : 0;
 			}
-		}
+		});
 	} else {
 		for (int y = 0; y < texSize.y; ++y) {
 			for (int x = 0; x < texSize.x; ++x) {
@@ -158,10 +160,18 @@ void CRadarTexture::UpdateCPU()
 
 void CRadarTexture::Update()
 {
+	const bool globalLOS = losHandler->GetGlobalLOS(gu->myAllyTeam);
+
+	// nothing changes while the view stays at full LOS
+	if (globalLOS && fullView)
+		return;
+
+	fullView = globalLOS;
+
 	if (!fbo.IsValid() || !shader->IsValid() || uploadTexRadar == 0 || uploadTexJammer == 0)
 		return UpdateCPU();
 
-	if (losHandler->GetGlobalLOS(gu->myAllyTeam)) {
+	if (globalLOS) {
 		fbo.Bind();
 		glViewport(0,0, texSize.x, texSize.y);
 		glClearColor(1.0f, 0.0f, 0.0f, 0.0f);
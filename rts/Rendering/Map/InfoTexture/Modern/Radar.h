@@ -21,7 +21,7 @@ public:
 
 public:
 	void Update() override;
-	bool IsUpdateNeeded() override { return true; }
+	bool IsUpdateNeeded() override { return IsInUse(); }
 
 private:
 	void UpdateCPU();
@@ -31,6 +31,9 @@ private:
 	GLuint uploadTexRadar;
 	GLuint uploadTexJammer;
 	Shader::IProgramObject* shader;
+
+	// texture holds the constant full-view image
+	bool fullView;
 };
 
 #endif // _RADAR_TEXTURE_H
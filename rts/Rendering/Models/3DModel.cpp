@@ -307,6 +307,16 @@ void S3DModelPiece::MeshOptimize()
 	}
 }
 
+void S3DModelPiece::OptimizeVertexCache()
+{
+	if (!HasGeometryData() || (indices.size() % 3) != 0)
+		return;
+
+	// only reorders triangles, vertex order is left alone since emit-points
+	// and similar are looked up by vertex index
+	meshopt_optimizeVertexCache(indices.data(), indices.data(), indices.size(), vertices.size());
+}
+
 void S3DModelPiece::BindVertexAttribVBOs() const
 {
 	assert(model);
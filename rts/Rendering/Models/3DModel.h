@@ -144,6 +144,7 @@ struct S3DModelPiece {
 	void UploadToVBO();
 
 	void MeshOptimize();
+	void OptimizeVertexCache();
 
 	void BindVertexAttribVBOs() const;
 	void UnbindVertexAttribVBOs() const;
@@ -555,6 +556,13 @@ struct LocalModel
 	bool HasPiece(unsigned int i) const { return (i < pieces.size()); }
 	bool Initialized() const { return (!pieces.empty()); }
 
+	// recomputes the matrices of all dirty pieces in one top-down pass
+	// rather than on first access through GetModelSpaceMatrix
+	void UpdatePieceMatrices() const {
+		if (Initialized())
+			pieces[0].UpdateChildMatricesRec(false);
+	}
+
 	const LocalModelPiece* GetPiece(unsigned int i)  const { assert(HasPiece(i)); return &pieces[i]; }
 	      LocalModelPiece* GetPiece(unsigned int i)        { assert(HasPiece(i)); return &pieces[i]; }
 
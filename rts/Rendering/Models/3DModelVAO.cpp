@@ -50,6 +50,7 @@ void S3DModelVAO::DisableAttribs() const
 
 S3DModelVAO::S3DModelVAO()
 	: batchedBaseInstance{ 0u }
+	, batchedBaseCommand{ 0u }
 	, immediateBaseInstance{ 0u }
 {
 	std::vector<SVertexData> vertData; vertData.reserve(2 << 21);
@@ -130,6 +131,13 @@ S3DModelVAO::S3DModelVAO()
 		indxVBO.Unbind();
 		instVBO.Unbind();
 	}
+	{
+		// not part of the VAO state, bound only around the batched draws
+		indrVBO = VBO{ GL_DRAW_INDIRECT_BUFFER, false };
+		indrVBO.Bind();
+		indrVBO.New(S3DModelVAO::INDIRECT_BUFFER_NUM_CMDS * sizeof(SDrawElementsIndirectCommand), GL_STREAM_DRAW);
+		indrVBO.Unbind();
+	}
 }
 
 void S3DModelVAO::Init()
@@ -208,46 +216,80 @@ bool S3DModelVAO::AddToSubmission(const UnitDef* unitDef, uint8_t teamID)
 }
 
 
+void S3DModelVAO::SubmitBatch(GLenum mode, const std::vector<SDrawElementsIndirectCommand>& cmds, const std::vector<SInstanceData>& instData)
+{
+	if (cmds.empty())
+		return;
+
+	assert(batchedBaseInstance + instData.size() <= INSTANCE_BUFFER_NUM_BATCHED);
+	assert(batchedBaseCommand + cmds.size() <= INDIRECT_BUFFER_NUM_CMDS);
+
+	instVBO.Bind();
+	instVBO.SetBufferSubData(instData, batchedBaseInstance);
+	instVBO.Unbind();
+
+	if (!indrVBO.IsSupported()) {
+		glMultiDrawElementsIndirect(mode, GL_UNSIGNED_INT, cmds.data(), cmds.size(), sizeof(SDrawElementsIndirectCommand));
+	} else {
+		indrVBO.Bind();
+		indrVBO.SetBufferSubData(cmds, batchedBaseCommand);
+		glMultiDrawElementsIndirect(mode, GL_UNSIGNED_INT, reinterpret_cast<const void*>(batchedBaseCommand * sizeof(SDrawElementsIndirectCommand)), cmds.size(), sizeof(SDrawElementsIndirectCommand));
+		// other callers (Lua VAO's, SubmitImmediately) pass commands from client memory
+		indrVBO.Unbind();
+	}
+
+	batchedBaseInstance += instData.size();
+	batchedBaseCommand += cmds.size();
+}
+
 void S3DModelVAO::Submit(GLenum mode, bool bindUnbind)
 {
 	static std::vector<SDrawElementsIndirectCommand> submitCmds;
 	submitCmds.clear();
 
-	batchedBaseInstance = 0u;
-
 	static std::vector<SInstanceData> allRenderModelData;
 	allRenderModelData.reserve(INSTANCE_BUFFER_NUM_BATCHED);
 	allRenderModelData.clear();
 
+	if (modelDataToInstance.empty())
+		return;
+
+	if (bindUnbind)
+		Bind();
+
 	for (const auto& [indxCount, renderModelData] : modelDataToInstance) {
-		if (allRenderModelData.size() + renderModelData.size() >= INSTANCE_BUFFER_NUM_BATCHED)
+		// more instances than the whole batched region can ever hold, should not happen
+		if (renderModelData.size() > INSTANCE_BUFFER_NUM_BATCHED)
 			continue;
 
+		const bool instBufferFull = (batchedBaseInstance + allRenderModelData.size() + renderModelData.size() > INSTANCE_BUFFER_NUM_BATCHED);
+		const bool indrBufferFull = (batchedBaseCommand + submitCmds.size() + 1 > INDIRECT_BUFFER_NUM_CMDS);
+
+		if (instBufferFull || indrBufferFull) {
+			// draw what has been gathered so far, then restart at the front of both buffers
+			SubmitBatch(mode, submitCmds, allRenderModelData);
+
+			submitCmds.clear();
+			allRenderModelData.clear();
+
+			batchedBaseInstance = 0u;
+			batchedBaseCommand = 0u;
+		}
+
 		SDrawElementsIndirectCommand scmd{
 			indxCount.count,
 			static_cast<uint32_t>(renderModelData.size()),
 			indxCount.index,
 			0u,
-			batchedBaseInstance
+			batchedBaseInstance + static_cast<uint32_t>(allRenderModelData.size())
 		};
 
 		submitCmds.emplace_back(scmd);
 
 		allRenderModelData.insert(allRenderModelData.end(), renderModelData.cbegin(), renderModelData.cend());
-		batchedBaseInstance += renderModelData.size();
 	}
 
-	if (submitCmds.empty())
-		return;
-
-	instVBO.Bind();
-	instVBO.SetBufferSubData(allRenderModelData);
-	instVBO.Unbind();
-
-	if (bindUnbind)
-		Bind();
-
-	glMultiDrawElementsIndirect(mode, GL_UNSIGNED_INT, submitCmds.data(), submitCmds.size(), sizeof(SDrawElementsIndirectCommand));
+	SubmitBatch(mode, submitCmds, allRenderModelData);
 
 	if (bindUnbind)
 		Unbind();
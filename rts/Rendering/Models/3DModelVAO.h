@@ -42,6 +42,7 @@ public:
 	static constexpr size_t INSTANCE_BUFFER_NUM_BATCHED = 2 << 15;
 	static constexpr size_t INSTANCE_BUFFER_NUM_IMMEDIATE = 2 << 10;
 	static constexpr size_t INSTANCE_BUFFER_NUM_ELEMS = INSTANCE_BUFFER_NUM_BATCHED + INSTANCE_BUFFER_NUM_IMMEDIATE;
+	static constexpr size_t INDIRECT_BUFFER_NUM_CMDS = 2 << 12;
 public:
 	S3DModelVAO();
 
@@ -84,18 +85,24 @@ private:
 		uint8_t teamID,
 		uint8_t drawFlags
 	);
+	void SubmitBatch(GLenum mode, const std::vector<SDrawElementsIndirectCommand>& cmds, const std::vector<SInstanceData>& instData);
+
 	void EnableAttribs(bool inst) const;
 	void DisableAttribs() const;
 private:
 	inline static S3DModelVAO* instance = nullptr;
 private:
+	// both advance across Submit calls and wrap around, so consecutive batches
+	// within a frame never overwrite buffer regions the GPU may still be reading
 	uint32_t batchedBaseInstance;
+	uint32_t batchedBaseCommand;
 	uint32_t immediateBaseInstance; //note relative index
 
 	VBO vertVBO;
 	VBO indxVBO;
 
 	VBO instVBO;
+	VBO indrVBO;
 	VAO vao;
 
 	std::unordered_map<SIndexAndCount, std::vector<SInstanceData>, SIndexAndCount> modelDataToInstance;
@@ -15,6 +15,7 @@
 #include "System/Exceptions.h"
 #include "System/MainDefines.h" // SNPRINTF
 #include "System/SafeUtil.h"
+#include "System/Platform/Watchdog.h"
 #include "System/Threading/ThreadPool.h"
 #include "lib/assimp/include/assimp/Importer.hpp"
 
@@ -224,6 +225,41 @@ void CModelLoader::PreloadModel(const std::string& modelName)
 	});
 }
 
+void CModelLoader::PreloadModels(const std::vector<std::string>& modelNames)
+{
+	assert(Threading::IsMainThread());
+
+	std::vector<std::string> names;
+	names.reserve(modelNames.size());
+
+	{
+		std::lock_guard<spring::mutex> lock(mutex);
+
+		for (const std::string& modelName: modelNames) {
+			if (modelName.empty())
+				continue;
+
+			const std::string& lcName = StringToLower(modelName);
+
+			if (cache.find(lcName) != cache.end())
+				continue;
+
+			names.push_back(lcName);
+		}
+	}
+
+	// many defs share a model (e.g. wrecks and weapon projectiles)
+	std::sort(names.begin(), names.end());
+	names.erase(std::unique(names.begin(), names.end()), names.end());
+
+	// parsing and texture decoding need no GL context; the final
+	// upload is done by LoadModel once called on the main thread
+	for_mt(0, names.size(), [&](const int i) {
+		LoadModel(names[i], true);
+		Watchdog::ClearTimer(WDT_LOAD);
+	});
+}
+
 void CModelLoader::LogErrors()
 {
 	assert(Threading::IsMainThread());
@@ -358,6 +394,11 @@ S3DModel CModelLoader::ParseModel(const std::string& name, const std::string& pa
 
 	try {
 		model = std::move(parser->Load(path));
+
+		// done here since parsing can run on (multiple) preloading threads
+		for (S3DModelPiece* piece: model.pieceObjects) {
+			piece->OptimizeVertexCache();
+		}
 	} catch (const content_error& ex) {
 		{
 			std::lock_guard<spring::mutex> lock(mutex);
@@ -32,6 +32,8 @@ public:
 
 	bool IsValid() const { return (!formats.empty()); }
 	void PreloadModel(const std::string& name);
+	// parses (without GL work) all models not yet loaded, in parallel
+	void PreloadModels(const std::vector<std::string>& names);
 	void LogErrors();
 
 	const std::vector<S3DModel>& GetModelsVec() const { return models; }
@@ -1,10 +1,28 @@
 #include "ModelPreloader.h"
+#include "IModelParser.h"
 
 #include "Sim/Units/UnitDefHandler.h"
 #include "Sim/Features/FeatureDefHandler.h"
 #include "Sim/Weapons/WeaponDefHandler.h"
 #include "System/Misc/UnfreezeSpring.h"
 
+void ModelPreloader::PreloadModels()
+{
+	std::vector<std::string> modelNames;
+
+	for (const auto& def : unitDefHandler->GetUnitDefsVec()) {
+		modelNames.push_back(def.modelName);
+	}
+	for (const auto& def : featureDefHandler->GetFeatureDefsVec()) {
+		modelNames.push_back(def.modelName);
+	}
+	for (const auto& def : weaponDefHandler->GetWeaponDefsVec()) {
+		modelNames.push_back(def.visuals.modelName);
+	}
+
+	modelLoader.PreloadModels(modelNames);
+}
+
 void ModelPreloader::LoadUnitDefs()
 {
 	for (const auto& def : unitDefHandler->GetUnitDefsVec()) {
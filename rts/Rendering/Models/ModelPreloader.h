@@ -7,15 +7,28 @@
 class ModelPreloader {
 public:
 	static void Load() {
-		if (!globalRendering->haveGL4 || !enabled)
+		if (!enabled)
+			return;
+
+		// headless builds resolve every def's model up front as well, so the
+		// sim never writes to the (otherwise read-only) def layer mid-game
+		#ifndef HEADLESS
+		if (!globalRendering->haveGL4)
 			return;
+		#endif
 
 		// map features are loaded earlier in featureHandler.LoadFeaturesFromMap(); - not a big deal
-		// Functions below cannot be multithreaded because modelLoader.LoadModel() deal with OpenGL functions
+		// parsing and texture decoding is done in parallel first, leaving only the OpenGL work
+		// (which cannot be multithreaded) to modelLoader.LoadModel() calls in the functions below
+		PreloadModels();
+
 		LoadUnitDefs();
 		LoadFeatureDefs();
 		LoadWeaponDefs();
 
+		if (!globalRendering->haveGL4)
+			return;
+
 		// after that point we should've loaded all models, it's time to dispatch VBO/EBO/VAO creation
 		S3DModelVAO::Init(); //TODO figure out where to put S3DModelVAO::Kill();
 	}
@@ -28,6 +41,7 @@ public:
 private:
 	static constexpr bool enabled = true;
 private:
+	static void PreloadModels();
 	static void LoadUnitDefs();
 	static void LoadFeatureDefs();
 	static void LoadWeaponDefs();
@@ -1,4 +1,7 @@
 #include "ModelsMemStorage.h"
+
+#include <cstring>
+
 #include "Sim/Objects/WorldObject.h"
 
 MatricesMemStorage matricesMemStorage;
@@ -8,12 +11,16 @@ ModelsUniformsStorage::ModelsUniformsStorage()
 {
 	storage[0] = dummy;
 	objectsMap.emplace(nullptr, 0);
+	dirtyMap.resize(storage.GetData().size(), BUFFERING);
 }
 
 size_t ModelsUniformsStorage::AddObjects(const CWorldObject* o)
 {
 	const size_t idx = storage.Add(ModelUniformData());
 	objectsMap[const_cast<CWorldObject*>(o)] = idx;
+
+	dirtyMap.resize(storage.GetData().size(), BUFFERING);
+	dirtyMap[idx] = BUFFERING;
 	return idx;
 }
 
@@ -39,8 +46,26 @@ size_t ModelsUniformsStorage::GetObjOffset(const CWorldObject* o)
 ModelUniformData& ModelsUniformsStorage::GetObjUniformsArray(const CWorldObject* o)
 {
 	size_t offset = GetObjOffset(o);
+	dirtyMap[offset] = BUFFERING;
 	return storage[offset];
 }
+
+void ModelsUniformsStorage::SetObjUniforms(size_t offset, const ModelUniformData& uni)
+{
+	// called from the drawer's worker threads, must not resize
+	ModelUniformData& cur = storage.GetData()[offset];
+
+	if (std::memcmp(&cur, &uni, sizeof(uni)) == 0)
+		return;
+
+	cur = uni;
+	dirtyMap[offset] = BUFFERING;
+}
+
+void ModelsUniformsStorage::SetAllDirty()
+{
+	std::fill(dirtyMap.begin(), dirtyMap.end(), BUFFERING);
+}
 /*
 void MatricesMemStorage::SetDirty(bool d)
 {
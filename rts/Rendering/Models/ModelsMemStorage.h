@@ -121,6 +121,10 @@ public:
 	size_t GetObjOffset(const CWorldObject* o);
 	ModelUniformData& GetObjUniformsArray(const CWorldObject* o);
 
+	const ModelUniformData& GetObjUniforms(size_t offset) const { return storage.GetData()[offset]; }
+	/// only marks the object dirty if anything changed
+	void SetObjUniforms(size_t offset, const ModelUniformData& uni);
+
 	size_t AddObjects(const SolidObjectDef* o) { return INVALID_INDEX; }
 	void   DelObjects(const SolidObjectDef* o) {}
 	size_t GetObjOffset(const SolidObjectDef* o) { return INVALID_INDEX; }
@@ -133,13 +137,20 @@ public:
 
 	size_t Size() const { return storage.GetData().size(); }
 	const std::vector<ModelUniformData>& GetData() const { return storage.GetData(); }
+
+	const std::vector<uint8_t>& GetDirtyMap() const { return dirtyMap; }
+	      std::vector<uint8_t>& GetDirtyMap()       { return dirtyMap; }
+	void SetAllDirty();
 public:
 	static constexpr size_t INVALID_INDEX = 0;
+	// same meaning as MatricesMemStorage::BUFFERING
+	static constexpr uint8_t BUFFERING = 3u;
 private:
 	inline static ModelUniformData dummy = {0};
 
 	std::unordered_map<CWorldObject*, size_t> objectsMap;
 	spring::FreeListMap<ModelUniformData> storage;
+	std::vector<uint8_t> dirtyMap;
 };
 
 extern ModelsUniformsStorage modelsUniformsStorage;
\ No newline at end of file
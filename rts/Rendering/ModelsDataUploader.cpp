@@ -1,7 +1,9 @@
 #include "ModelsDataUploader.h"
 
+#include <algorithm>
 #include <limits>
 #include <cassert>
+#include <cstring>
 
 #include "System/float4.h"
 #include "System/Matrix44f.h"
@@ -31,6 +33,62 @@
 
 ////////////////////////////////////////////////////////////////////
 
+template<typename T>
+static bool CanUploadRanges(const IStreamBuffer<T>* ssbo)
+{
+	switch (ssbo->GetBufferImplementation()) {
+		case IStreamBufferConcept::Types::SB_PERSISTENTMAP: return true;
+		case IStreamBufferConcept::Types::SB_BUFFERSUBDATA: return true;
+		default: break;
+	}
+
+	// the others orphan or respecify the whole buffer
+	return false;
+}
+
+/*
+ * Copies the elements whose dirty-count is non-zero and decrements it; the
+ * count starts at the number of buffer segments so each segment receives the
+ * change once. Runs separated by short clean gaps are merged since copying
+ * ~1KB of unchanged data costs less than another Map (fence wait) and Unmap
+ * (flush or glBufferSubData).
+ */
+template<typename T>
+static void UploadDirtyRanges(IStreamBuffer<T>* ssbo, const T* clientPtr, std::vector<uint8_t>& dirtyMap, uint32_t elemCount)
+{
+	constexpr size_t MAX_MERGE_GAP = std::max(size_t(1), 1024 / sizeof(T));
+
+	const auto dirtyPred = [](uint8_t m) -> bool { return m > 0u; };
+
+	const auto stt = dirtyMap.begin();
+	const auto fin = dirtyMap.begin() + std::min(size_t(elemCount), dirtyMap.size());
+
+	for (auto beg = std::find_if(stt, fin, dirtyPred); beg != fin; ) {
+		auto end = std::find_if_not(beg, fin, dirtyPred);
+		auto nxt = std::find_if(end, fin, dirtyPred);
+
+		while (nxt != fin && static_cast<size_t>(std::distance(end, nxt)) <= MAX_MERGE_GAP) {
+			end = std::find_if_not(nxt, fin, dirtyPred);
+			nxt = std::find_if(end, fin, dirtyPred);
+		}
+
+		const uint32_t offs = static_cast<uint32_t>(std::distance(stt, beg));
+		const uint32_t size = static_cast<uint32_t>(std::distance(beg, end));
+
+		T* mappedPtr = ssbo->Map(clientPtr, offs, size);
+
+		if (!ssbo->HasClientPtr())
+			memcpy(mappedPtr, clientPtr + offs, size * sizeof(T));
+
+		ssbo->Unmap();
+
+		// make it less dirty, clean elements inside merged gaps stay at zero
+		std::transform(beg, end, beg, [](uint8_t v) { return (v - (v > 0u)); });
+
+		beg = nxt;
+	}
+}
+
 
 template<typename T, typename Derived>
 inline bool TypedStorageBufferUploader<T, Derived>::Supported()
@@ -157,31 +215,8 @@ void MatrixUploader::UpdateDerived()
 	const CMatrix44f* clientPtr = matricesMemStorage.GetData().data();
 
 	constexpr bool ENABLE_UPLOAD_OPTIMIZATION = true;
-	if (ssbo->GetBufferImplementation() == IStreamBufferConcept::Types::SB_PERSISTENTMAP && ENABLE_UPLOAD_OPTIMIZATION) {
-		const auto stt = matricesMemStorage.GetDirtyMap().begin();
-		const auto fin = matricesMemStorage.GetDirtyMap().end();
-
-		auto beg = matricesMemStorage.GetDirtyMap().begin();
-		auto end = matricesMemStorage.GetDirtyMap().begin();
-
-		static const auto dirtyPred = [](uint8_t m) -> bool { return m > 0u; };
-		while (beg != fin) {
-			beg = std::find_if    (beg, fin, dirtyPred);
-			end = std::find_if_not(beg, fin, dirtyPred);
-
-			if (beg != fin) {
-				const uint32_t offs = static_cast<uint32_t>(std::distance(stt, beg));
-				const uint32_t size = static_cast<uint32_t>(std::distance(beg, end));
-
-				CMatrix44f* mappedPtr = ssbo->Map(clientPtr, offs, size);
-				memcpy(mappedPtr, clientPtr + offs, size * sizeof(CMatrix44f));
-				ssbo->Unmap();
-
-				std::transform(beg, end, beg, [](uint8_t v) { return (v - 1); }); //make it less dirty
-			}
-
-			beg = end; //rewind
-		}
+	if (CanUploadRanges(ssbo.get()) && ENABLE_UPLOAD_OPTIMIZATION) {
+		UploadDirtyRanges(ssbo.get(), clientPtr, matricesMemStorage.GetDirtyMap(), storageElemCount);
 	}
 	else {
 		const CMatrix44f* clientPtr = matricesMemStorage.GetData().data();
@@ -287,7 +322,7 @@ void ModelsUniformsUploader::InitDerived()
 	if (!Supported())
 		return;
 
-	InitImpl(MATUNI_SSBO_BINDING_IDX, ELEM_COUNT0, ELEM_COUNTI, IStreamBufferConcept::Types::SB_BUFFERSUBDATA, true, 3);
+	InitImpl(MATUNI_SSBO_BINDING_IDX, ELEM_COUNT0, ELEM_COUNTI, IStreamBufferConcept::Types::SB_BUFFERSUBDATA, true, ModelsUniformsStorage::BUFFERING);
 }
 
 void ModelsUniformsUploader::KillDerived()
@@ -313,16 +348,23 @@ void ModelsUniformsUploader::UpdateDerived()
 		const uint32_t newElemCount = AlignUp(storageElemCount, elemCountIncr);
 		LOG_L(L_DEBUG, "[%s::%s] sizing SSBO %s. New elements count = %u, elemCount = %u, storageElemCount = %u", className, __func__, "up", newElemCount, elemCount, storageElemCount);
 		ssbo->Resize(newElemCount);
+
+		modelsUniformsStorage.SetAllDirty(); //Resize doesn't copy the data
 	}
 
 	//update on the GPU
 	const ModelUniformData* clientPtr = modelsUniformsStorage.GetData().data();
-	ModelUniformData* mappedPtr = ssbo->Map(clientPtr, 0, storageElemCount);
 
-	if (!ssbo->HasClientPtr())
-		memcpy(mappedPtr, clientPtr, storageElemCount * sizeof(ModelUniformData));
+	if (CanUploadRanges(ssbo.get())) {
+		UploadDirtyRanges(ssbo.get(), clientPtr, modelsUniformsStorage.GetDirtyMap(), storageElemCount);
+	} else {
+		ModelUniformData* mappedPtr = ssbo->Map(clientPtr, 0, storageElemCount);
 
-	ssbo->Unmap();
+		if (!ssbo->HasClientPtr())
+			memcpy(mappedPtr, clientPtr, storageElemCount * sizeof(ModelUniformData));
+
+		ssbo->Unmap();
+	}
 	ssbo->BindBufferRange(bindingIdx);
 	ssbo->SwapBuffer();
 }
@@ -0,0 +1,98 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "QualityGovernor.h"
+#include "Rendering/Env/GrassDrawer.h"
+#include "Sim/Projectiles/ProjectileHandler.h"
+#include "System/Config/ConfigHandler.h"
+#include "System/Log/ILog.h"
+#include "System/SpringMath.h"
+
+CONFIG(float, QualityGovernorFrameTime).defaultValue(0.0f).headlessValue(0.0f).minimumValue(0.0f).description("Target draw-frame time in milliseconds; if greater than 0, particle limits and grass detail are lowered during a game whenever drawing takes longer (and raised again up to MaxParticles, MaxNanoParticles and GrassDetail when it is faster). 0 disables the governor.");
+CONFIG(int, QualityGovernorMinParticles).defaultValue(1000).minimumValue(0).description("Lowest MaxParticles value the quality governor may use, MaxNanoParticles is scaled proportionally.");
+CONFIG(int, QualityGovernorMinGrassDetail).defaultValue(1).minimumValue(1).description("Lowest GrassDetail value the quality governor may use.");
+
+static constexpr float UPDATE_INTERVAL = 500.0f;
+static constexpr float GRASS_CHANGE_INTERVAL = 5000.0f;
+
+CQualityGovernor qualityGovernor;
+
+
+void CQualityGovernor::Init()
+{
+	targetFrameTime = configHandler->GetFloat("QualityGovernorFrameTime");
+	particleQuality = 1.0f;
+	grassDetail = configHandler->GetInt("GrassDetail");
+
+	lastUpdateTime = spring_gettime();
+	lastGrassChangeTime = lastUpdateTime;
+
+	if (!IsEnabled())
+		return;
+
+	LOG("[QualityGovernor::%s] targeting %.2fms per draw-frame", __func__, targetFrameTime);
+}
+
+void CQualityGovernor::Update(float drawFrameTime)
+{
+	if (!IsEnabled())
+		return;
+
+	const spring_time now = spring_gettime();
+
+	if ((now - lastUpdateTime).toMilliSecsf() < UPDATE_INTERVAL)
+		return;
+
+	lastUpdateTime = now;
+
+	const float load = drawFrameTime / targetFrameTime;
+
+	// back off proportionally to the overshoot, recover slowly to avoid oscillating
+	if (load > 1.1f) {
+		particleQuality = std::max(0.0f, particleQuality - std::min(0.25f, load - 1.0f));
+	} else if (load < 0.8f) {
+		particleQuality = std::min(1.0f, particleQuality + 0.05f);
+	}
+
+	ApplyParticleQuality();
+
+	if (grassDrawer == nullptr)
+		return;
+	if ((now - lastGrassChangeTime).toMilliSecsf() < GRASS_CHANGE_INTERVAL)
+		return;
+
+	const int minGrassDetail = configHandler->GetInt("QualityGovernorMinGrassDetail");
+	const int maxGrassDetail = configHandler->GetInt("GrassDetail");
+
+	// grass is only touched once the particle budget is exhausted (or fully restored)
+	if (load > 1.1f && particleQuality == 0.0f) {
+		ApplyGrassDetail(std::max(std::min(grassDetail, maxGrassDetail) - 1, minGrassDetail));
+	} else if (load < 0.7f && particleQuality == 1.0f) {
+		ApplyGrassDetail(std::min(grassDetail + 1, maxGrassDetail));
+	}
+}
+
+
+void CQualityGovernor::ApplyParticleQuality() const
+{
+	const int maxParticles = configHandler->GetInt("MaxParticles");
+	const int maxNanoParticles = configHandler->GetInt("MaxNanoParticles");
+	const int minParticles = std::min(configHandler->GetInt("QualityGovernorMinParticles"), maxParticles);
+
+	const float particles = mix(float(minParticles), float(maxParticles), particleQuality);
+	const float fraction = particles / std::max(1, maxParticles);
+
+	projectileHandler.SetMaxParticles(particles);
+	projectileHandler.SetMaxNanoParticles(maxNanoParticles * fraction);
+}
+
+void CQualityGovernor::ApplyGrassDetail(int detail)
+{
+	// never enable grass that was disabled by the user
+	if (detail == grassDetail || detail <= 0)
+		return;
+
+	LOG("[QualityGovernor::%s] changing grass detail from %d to %d", __func__, grassDetail, detail);
+
+	grassDrawer->ChangeDetail(grassDetail = detail);
+	lastGrassChangeTime = spring_gettime();
+}
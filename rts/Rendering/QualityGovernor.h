@@ -0,0 +1,45 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef QUALITY_GOVERNOR_H
+#define QUALITY_GOVERNOR_H
+
+#include "System/Misc/SpringTime.h"
+
+/**
+ * Trades particle and grass detail for draw-frame time during a game.
+ *
+ * Once per interval the smoothed draw time is compared to the configured
+ * target; particle caps are scaled between QualityGovernorMinParticles and
+ * the user's MaxParticles (and MaxNanoParticles), and if that alone does not
+ * suffice grass detail steps down to QualityGovernorMinGrassDetail. Grass
+ * changes rebuild the grass geometry, so they are rate-limited and need a
+ * larger margin than the particle caps. Nothing is ever raised above the
+ * values in the user's config.
+ */
+class CQualityGovernor
+{
+public:
+	void Init();
+	void Update(float drawFrameTime);
+
+	bool IsEnabled() const { return (targetFrameTime > 0.0f); }
+
+private:
+	void ApplyParticleQuality() const;
+	void ApplyGrassDetail(int detail);
+
+private:
+	float targetFrameTime = 0.0f;
+
+	// [0, 1]; fraction of the configured particle caps above the minimum
+	float particleQuality = 1.0f;
+
+	int grassDetail = 0;
+
+	spring_time lastUpdateTime;
+	spring_time lastGrassChangeTime;
+};
+
+extern CQualityGovernor qualityGovernor;
+
+#endif
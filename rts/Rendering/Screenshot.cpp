@@ -52,9 +52,10 @@ void TakeScreenshot(std::string type, unsigned quality)
 
 	glReadPixels(0, 0, args.x, args.y, GL_RGBA, GL_UNSIGNED_BYTE, &args.pixelbuf[0]);
 
+	// hand the buffer over, copying a full-screen image stalls the frame as well
 	ThreadPool::Enqueue([](const FunctionArgs& args) {
 		CBitmap bmp(&args.pixelbuf[0], args.x, args.y);
 		bmp.ReverseYAxis();
 		bmp.Save(args.filename, args.quality, true, true);
-	}, args);
+	}, std::move(args));
 }
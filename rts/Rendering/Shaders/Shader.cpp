@@ -556,7 +556,26 @@ namespace Shader {
 			}
 		}
 
-		// recompile if not found in cache (id 0)
+		CShaderHandler::ProgramBinaryCache& binaryCache = shaderHandler->GetProgramBinaryCache();
+
+		uint64_t binaryKey = curSrcHash;
+
+		{
+			// attribute bindings are baked into the binary as well
+			uint32_t attribHash = 0;
+
+			for (const auto& [name, index] : attribLocations) {
+				attribHash ^= HsiehHash(&index, sizeof(index), HsiehHash(name.data(), name.size(), 0));
+			}
+
+			binaryKey = (binaryKey << 32) | attribHash;
+		}
+
+		// next try the binaries stored by previous runs
+		if (objID == 0)
+			objID = binaryCache.Load(binaryKey);
+
+		// recompile if not found in either cache (id 0)
 		if (objID == 0) {
 			objID = glCreateProgram();
 
@@ -581,6 +600,7 @@ namespace Shader {
 				glBindAttribLocation(objID, index, name.c_str());
 			}
 
+			binaryCache.PrepareLink(objID);
 			glLinkProgram(objID);
 
 			valid = glslIsValid(objID);
@@ -588,6 +608,8 @@ namespace Shader {
 
 			if (!IsValid()) {
 				LOG_L(L_WARNING, "[GLSL-PO::%s] program-object name: %s, link-log:\n%s\n", __FUNCTION__, name.c_str(), log.c_str());
+			} else {
+				binaryCache.Save(binaryKey, objID);
 			}
 
 			#ifdef _DEBUG
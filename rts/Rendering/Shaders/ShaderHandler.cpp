@@ -5,10 +5,22 @@
 #include "Rendering/Shaders/ShaderHandler.h"
 #include "Rendering/Shaders/Shader.h"
 #include "Rendering/GlobalRendering.h"
+#include "Rendering/GlobalRenderingInfo.h"
+#include "System/Config/ConfigHandler.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
 #include "System/Log/ILog.h"
+#include "System/Platform/Threading.h"
 #include "System/StringUtil.h"
+#include "System/Sync/HsiehHash.h"
 
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+CONFIG(bool, UseShaderBinaryCache).defaultValue(true).description("If linked shader programs should be stored in the cache directory and reused by later runs with the same driver.");
 
 
 // not extern'ed, so static
@@ -175,3 +187,201 @@ Shader::IShaderObject* CShaderHandler::CreateShaderObject(const std::string& soN
 
 	return so;
 }
+
+
+
+struct ProgramBinaryHeader {
+	char magic[8];
+	uint32_t driverHash;
+	uint32_t format;
+	uint64_t key;
+	uint32_t size;
+	uint32_t padding;
+};
+
+static constexpr char PROGRAM_BINARY_MAGIC[8] = {'s', 'p', 'r', 'g', 'l', 'b', 'i', 'n'};
+
+
+bool CShaderHandler::ProgramBinaryCache::IsEnabled() {
+	if (enabled >= 0)
+		return (enabled != 0);
+
+	GLint numFormats = 0;
+
+	if (GLEW_ARB_get_program_binary)
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+
+	// some drivers advertise the extension but do not support a single format
+	if ((enabled = (configHandler->GetBool("UseShaderBinaryCache") && numFormats > 0)) == 0)
+		return false;
+
+	const char* driverStrs[] = {globalRenderingInfo.glVendor, globalRenderingInfo.glRenderer, globalRenderingInfo.glVersion};
+
+	for (const char* str: driverStrs) {
+		driverHash = HsiehHash(str, (str != nullptr)? strlen(str): 0, driverHash);
+	}
+
+	cacheDir = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + "/shaders/" + IntToString(driverHash, "%08x") + "/", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+	cacheDir = FileSystem::EnsurePathSepAtEnd(cacheDir);
+
+	LOG("[SH::%s] using program binary cache \"%s\"", __func__, cacheDir.c_str());
+	return true;
+}
+
+std::string CShaderHandler::ProgramBinaryCache::GetFileName(uint64_t key) const {
+	char buf[32];
+	snprintf(buf, sizeof(buf), "%016" PRIx64 ".bin", key);
+	return (cacheDir + buf);
+}
+
+bool CShaderHandler::ProgramBinaryCache::ReadBinary(uint64_t key, std::vector<std::uint8_t>& data) const {
+	FILE* file = fopen(GetFileName(key).c_str(), "rb");
+
+	if (file == nullptr)
+		return false;
+
+	ProgramBinaryHeader header;
+
+	bool ret = true;
+	ret = ret && (fread(&header, sizeof(header), 1, file) == 1);
+	ret = ret && (memcmp(header.magic, PROGRAM_BINARY_MAGIC, sizeof(header.magic)) == 0);
+	ret = ret && (header.driverHash == driverHash && header.key == key);
+
+	if (ret) {
+		// keep the header in front, the format is needed by Load
+		data.resize(sizeof(header) + header.size);
+		memcpy(data.data(), &header, sizeof(header));
+
+		ret = (fread(data.data() + sizeof(header), header.size, 1, file) == 1);
+	}
+
+	fclose(file);
+	return ret;
+}
+
+void CShaderHandler::ProgramBinaryCache::Prefetch() {
+	if (!IsEnabled() || prefetchThread.joinable())
+		return;
+
+	prefetchThread = std::move(spring::thread([this]() {
+		Threading::SetThreadName("shaderprefetch");
+
+		std::vector<std::string> files;
+		FileSystemAbstraction::FindFiles(files, cacheDir, "", "^[0-9a-f]{16}\\.bin$", 0);
+
+		for (const std::string& file: files) {
+			const uint64_t key = std::strtoull(FileSystem::GetBasename(file).c_str(), nullptr, 16);
+
+			std::vector<std::uint8_t> data;
+
+			if (!ReadBinary(key, data))
+				continue;
+
+			std::lock_guard<spring::mutex> lock(prefetchMutex);
+			prefetched.emplace(key, std::move(data));
+		}
+	}));
+}
+
+void CShaderHandler::ProgramBinaryCache::Kill() {
+	if (prefetchThread.joinable())
+		prefetchThread.join();
+
+	prefetched.clear();
+}
+
+
+GLuint CShaderHandler::ProgramBinaryCache::Load(uint64_t key) {
+	if (key == 0 || !IsEnabled())
+		return 0;
+
+	std::vector<std::uint8_t> data;
+
+	{
+		std::lock_guard<spring::mutex> lock(prefetchMutex);
+
+		const auto it = prefetched.find(key);
+
+		if (it != prefetched.end()) {
+			data = std::move(it->second);
+			prefetched.erase(it);
+		}
+	}
+
+	// not (yet) prefetched, or a binary saved during this run
+	if (data.empty() && !ReadBinary(key, data))
+		return 0;
+
+	const ProgramBinaryHeader* header = reinterpret_cast<const ProgramBinaryHeader*>(data.data());
+	const GLuint progID = glCreateProgram();
+
+	GLint linkStatus = GL_FALSE;
+
+	glProgramBinary(progID, header->format, data.data() + sizeof(*header), header->size);
+	glGetProgramiv(progID, GL_LINK_STATUS, &linkStatus);
+
+	if (linkStatus == GL_TRUE)
+		return progID;
+
+	// driver rejected the binary (e.g. after an update that kept the version string)
+	LOG_L(L_WARNING, "[SH::%s] discarding stale program binary %016" PRIx64, __func__, key);
+
+	glDeleteProgram(progID);
+	std::remove(GetFileName(key).c_str());
+	return 0;
+}
+
+void CShaderHandler::ProgramBinaryCache::PrepareLink(GLuint progID) const {
+	if (enabled <= 0)
+		return;
+
+	glProgramParameteri(progID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void CShaderHandler::ProgramBinaryCache::Save(uint64_t key, GLuint progID) {
+	if (key == 0 || !IsEnabled())
+		return;
+
+	GLint binarySize = 0;
+	glGetProgramiv(progID, GL_PROGRAM_BINARY_LENGTH, &binarySize);
+
+	if (binarySize <= 0)
+		return;
+
+	std::vector<std::uint8_t> binary(binarySize);
+
+	ProgramBinaryHeader header;
+	memcpy(header.magic, PROGRAM_BINARY_MAGIC, sizeof(header.magic));
+
+	GLsizei binaryLength = 0;
+	GLenum binaryFormat = 0;
+
+	glGetProgramBinary(progID, binarySize, &binaryLength, &binaryFormat, binary.data());
+
+	if (binaryLength <= 0)
+		return;
+
+	header.driverHash = driverHash;
+	header.format = binaryFormat;
+	header.key = key;
+	header.size = binaryLength;
+	header.padding = 0;
+
+	const std::string fileName = GetFileName(key);
+	FILE* file = fopen(fileName.c_str(), "wb");
+
+	if (file == nullptr) {
+		LOG_L(L_WARNING, "[SH::%s] failed to open \"%s\" for writing", __func__, fileName.c_str());
+		return;
+	}
+
+	bool ret = true;
+	ret = ret && (fwrite(&header, sizeof(header), 1, file) == 1);
+	ret = ret && (fwrite(binary.data(), binaryLength, 1, file) == 1);
+
+	fclose(file);
+
+	// never leave a truncated binary behind
+	if (!ret)
+		std::remove(fileName.c_str());
+}
@@ -3,10 +3,13 @@
 #ifndef SPRING_SHADERHANDLER_HDR
 #define SPRING_SHADERHANDLER_HDR
 
+#include <cinttypes>
 #include <string>
+#include <vector>
 
 #include "Rendering/GL/myGL.h" //GLuint
 #include "System/UnorderedMap.hpp"
+#include "System/Threading/SpringThreading.h"
 
 namespace Shader {
 	struct IProgramObject;
@@ -72,14 +75,57 @@ public:
 		spring::unsynced_map<size_t, GLuint> cache;
 	};
 
+	/**
+	 * @brief persistent cache of linked program binaries
+	 *
+	 * Binaries are stored per driver (vendor, renderer and version string)
+	 * under the cache-dir and keyed by a hash of everything that went into
+	 * linking the program. Prefetch reads all binaries of the current driver
+	 * from disk in a background thread, so Load only has to hand them to GL.
+	 */
+	struct ProgramBinaryCache {
+	public:
+		~ProgramBinaryCache() { Kill(); }
+
+		void Prefetch();
+		void Kill();
+
+		/// @return a linked program created from the cached binary for key, or 0
+		GLuint Load(uint64_t key);
+		/// must be called before linking a program whose binary will be saved
+		void PrepareLink(GLuint progID) const;
+		void Save(uint64_t key, GLuint progID);
+
+		bool IsEnabled();
+
+	private:
+		bool ReadBinary(uint64_t key, std::vector<std::uint8_t>& data) const;
+		std::string GetFileName(uint64_t key) const;
+
+	private:
+		spring::unsynced_map<uint64_t, std::vector<std::uint8_t>> prefetched;
+		spring::mutex prefetchMutex;
+		spring::thread prefetchThread;
+
+		std::string cacheDir;
+		uint32_t driverHash = 0;
+
+		// -1: not yet initialized, 0: disabled, 1: enabled
+		int enabled = -1;
+	};
+
 	const ShaderCache& GetShaderCache() const { return shaderCache; }
 	      ShaderCache& GetShaderCache()       { return shaderCache; }
 
+	ProgramBinaryCache& GetProgramBinaryCache() { return binaryCache; }
+
 private:
 	// all created programs, by name
 	ProgramTable programObjects;
 	// all (re)loaded program ID's, by hash
 	ShaderCache shaderCache;
+	// linked program binaries from previous runs
+	ProgramBinaryCache binaryCache;
 };
 
 #define shaderHandler (CShaderHandler::GetInstance(1))
@@ -32,6 +32,7 @@
 CONFIG(int, Shadows).defaultValue(2).headlessValue(-1).minimumValue(-1).safemodeValue(-1).description("Sets whether shadows are rendered.\n-1:=forceoff, 0:=off, 1:=full, 2:=fast (skip terrain)"); //FIXME document bitmask
 CONFIG(int, ShadowMapSize).defaultValue(CShadowHandler::DEF_SHADOWMAP_SIZE).minimumValue(32).description("Sets the resolution of shadows. Higher numbers increase quality at the cost of performance.");
 CONFIG(int, ShadowProjectionMode).defaultValue(CShadowHandler::SHADOWPROMODE_CAM_CENTER);
+CONFIG(bool, ShadowStaticCasterCache).defaultValue(true).description("Keep a copy of the terrain shadow depth and reuse it while the shadow projection and the heightmap do not change.");
 
 CShadowHandler shadowHandler;
 
@@ -74,6 +75,9 @@ void CShadowHandler::Init()
 	shadowTexture = 0;
 	dummyColorTexture = 0;
 
+	useStaticCasterCache = false;
+	haveStaticCasterCache = false;
+
 	if (!tmpFirstInit && !shadowsSupported)
 		return;
 
@@ -135,6 +139,8 @@ void CShadowHandler::Init()
 
 	LoadProjectionMatrix(CCameraHandler::GetCamera(CCamera::CAMTYPE_SHADOW));
 	LoadShadowGenShaders();
+
+	useStaticCasterCache = InitStaticCasterCache();
 }
 
 void CShadowHandler::Kill()
@@ -164,8 +170,20 @@ void CShadowHandler::FreeTextures() {
 
 	shadowMapFBO.Kill();
 
-	glDeleteTextures(1, &shadowTexture    ); shadowTexture     = 0;
-	glDeleteTextures(1, &dummyColorTexture); dummyColorTexture = 0;
+	if (staticCasterFBO.IsValid()) {
+		staticCasterFBO.Bind();
+		staticCasterFBO.DetachAll();
+		staticCasterFBO.Unbind();
+	}
+
+	staticCasterFBO.Kill();
+
+	glDeleteTextures(1, &shadowTexture      ); shadowTexture       = 0;
+	glDeleteTextures(1, &dummyColorTexture  ); dummyColorTexture   = 0;
+	glDeleteTextures(1, &staticCasterTexture); staticCasterTexture = 0;
+
+	useStaticCasterCache = false;
+	haveStaticCasterCache = false;
 }
 
 
@@ -406,6 +424,113 @@ bool CShadowHandler::WorkaroundUnsupportedFboRenderTargets()
 }
 
 
+bool CShadowHandler::InitStaticCasterCache()
+{
+	if ((shadowGenBits & SHADOWGEN_BIT_MAP) == 0)
+		return false;
+
+	if (!configHandler->GetBool("ShadowStaticCasterCache"))
+		return false;
+
+	if (!GLEW_EXT_framebuffer_blit)
+		return false;
+
+	// blitting depth requires identical formats, the workaround path may have picked another one
+	GLint depthFormat = 0;
+
+	glBindTexture(GL_TEXTURE_2D, shadowTexture);
+	glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &depthFormat);
+
+	staticCasterFBO.Init(false);
+
+	if (!staticCasterFBO.IsValid())
+		return false;
+
+	glGenTextures(1, &staticCasterTexture);
+	glBindTexture(GL_TEXTURE_2D, staticCasterTexture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, depthFormat, shadowMapSize, shadowMapSize, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	staticCasterFBO.Bind();
+	staticCasterFBO.AttachTexture(staticCasterTexture, GL_TEXTURE_2D, GL_DEPTH_ATTACHMENT_EXT);
+
+	glDrawBuffer(GL_NONE);
+	glReadBuffer(GL_NONE);
+
+	const bool status = staticCasterFBO.CheckStatus("SHADOW-STATIC");
+
+	staticCasterFBO.Unbind();
+	return status;
+}
+
+bool CShadowHandler::StaticCasterCacheValid() const
+{
+	if (!haveStaticCasterCache)
+		return false;
+
+	if (staticCasterNumHgtMapUpdates != readMap->GetNumUnsyncedHeightMapUpdates())
+		return false;
+
+	// covers sun-direction changes and (in CAM_CENTER mode) player-camera movement
+	if (staticCasterViewMatrix != viewMatrix[SHADOWMAT_TYPE_DRAWING])
+		return false;
+	if (staticCasterProjMatrix != projMatrix[SHADOWMAT_TYPE_DRAWING])
+		return false;
+
+	return (staticCasterTexProjCenter == shadowTexProjCenter);
+}
+
+void CShadowHandler::DrawStaticShadowCasters()
+{
+	if ((shadowGenBits & SHADOWGEN_BIT_MAP) == 0)
+		return;
+
+	// nothing to draw or restore, and the cache must not outlive the toggle
+	if (!globalRendering->drawGround) {
+		haveStaticCasterCache = false;
+		return;
+	}
+
+	const auto BlitDepth = [this](GLuint srcFBO, GLuint dstFBO) {
+		glBindFramebufferEXT(GL_READ_FRAMEBUFFER_EXT, srcFBO);
+		glBindFramebufferEXT(GL_DRAW_FRAMEBUFFER_EXT, dstFBO);
+		glBlitFramebufferEXT(0, 0, shadowMapSize, shadowMapSize, 0, 0, shadowMapSize, shadowMapSize, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+		glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, shadowMapFBO.fboId);
+	};
+
+	if (useStaticCasterCache && StaticCasterCacheValid()) {
+		BlitDepth(staticCasterFBO.fboId, shadowMapFBO.fboId);
+		return;
+	}
+
+	// cull front-faces during the terrain shadow pass: sun direction
+	// can be set so oblique that geometry back-faces are visible (eg.
+	// from hills near map edges) from its POV
+	//
+	// not the best idea, causes acne when projecting the shadow-map
+	// (rasterizing back-faces writes different depth values) and is
+	// no longer required since border geometry will fully hide them
+	// (could just disable culling of terrain faces entirely, but we
+	// also want to prevent overdraw in low-angle passes)
+	// glCullFace(GL_FRONT);
+	readMap->GetGroundDrawer()->DrawShadowPass();
+
+	if (!useStaticCasterCache)
+		return;
+
+	// the depth-buffer holds only the map at this point
+	BlitDepth(shadowMapFBO.fboId, staticCasterFBO.fboId);
+
+	staticCasterNumHgtMapUpdates = readMap->GetNumUnsyncedHeightMapUpdates();
+	staticCasterViewMatrix = viewMatrix[SHADOWMAT_TYPE_DRAWING];
+	staticCasterProjMatrix = projMatrix[SHADOWMAT_TYPE_DRAWING];
+	staticCasterTexProjCenter = shadowTexProjCenter;
+
+	haveStaticCasterCache = true;
+}
+
 void CShadowHandler::DrawShadowPasses()
 {
 	inShadowPass = true;
@@ -414,6 +539,9 @@ void CShadowHandler::DrawShadowPasses()
 		glEnable(GL_CULL_FACE);
 		glCullFace(GL_BACK);
 
+			// static casters go first s.t. their depth can be cached or restored on its own
+			DrawStaticShadowCasters();
+
 			eventHandler.DrawWorldShadow();
 
 			if ((shadowGenBits & SHADOWGEN_BIT_TREE) != 0) {
@@ -428,23 +556,6 @@ void CShadowHandler::DrawShadowPasses()
 				featureDrawer->DrawShadowPass();
 			}
 
-		// cull front-faces during the terrain shadow pass: sun direction
-		// can be set so oblique that geometry back-faces are visible (eg.
-		// from hills near map edges) from its POV
-		//
-		// not the best idea, causes acne when projecting the shadow-map
-		// (rasterizing back-faces writes different depth values) and is
-		// no longer required since border geometry will fully hide them
-		// (could just disable culling of terrain faces entirely, but we
-		// also want to prevent overdraw in low-angle passes)
-		// glCullFace(GL_FRONT);
-
-		// Restore GL_BACK culling, because Lua shadow materials might
-		// have changed culling at their own discretion
-		glCullFace(GL_BACK);
-			if ((shadowGenBits & SHADOWGEN_BIT_MAP) != 0)
-				readMap->GetGroundDrawer()->DrawShadowPass();
-
 	glPopAttrib();
 
 	inShadowPass = false;
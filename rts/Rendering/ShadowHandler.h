@@ -17,7 +17,7 @@ class CCamera;
 class CShadowHandler
 {
 public:
-	CShadowHandler(): shadowMapFBO(true) {}
+	CShadowHandler(): shadowMapFBO(true), staticCasterFBO(true) {}
 
 	void Init();
 	void Kill();
@@ -90,8 +90,11 @@ private:
 
 	bool InitDepthTarget();
 	bool WorkaroundUnsupportedFboRenderTargets();
+	bool InitStaticCasterCache();
 
 	void DrawShadowPasses();
+	void DrawStaticShadowCasters();
+	bool StaticCasterCacheValid() const;
 	void LoadProjectionMatrix(const CCamera* shadowCam);
 	void LoadShadowGenShaders();
 
@@ -139,6 +142,21 @@ private:
 	CMatrix44f viewMatrix[2];
 
 	FBO shadowMapFBO;
+
+	// depth-only copy of the terrain (static caster) layer, blitted
+	// back instead of redrawing the map while the shadow projection
+	// and the heightmap stay the same
+	FBO staticCasterFBO;
+
+	unsigned int staticCasterTexture = 0;
+	unsigned int staticCasterNumHgtMapUpdates = 0;
+
+	bool useStaticCasterCache = false;
+	bool haveStaticCasterCache = false;
+
+	CMatrix44f staticCasterViewMatrix;
+	CMatrix44f staticCasterProjMatrix;
+	float4 staticCasterTexProjCenter;
 };
 
 extern CShadowHandler shadowHandler;
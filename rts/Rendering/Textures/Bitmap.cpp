@@ -780,21 +780,30 @@ CBitmap TBitmapAction<T, ch>::CreateRescaled(int newx, int newy)
 	const float dx = static_cast<float>(bmp->xsize) / static_cast<float>(newx);
 	const float dy = static_cast<float>(bmp->ysize) / static_cast<float>(newy);
 
-	float cy = 0;
-	for (int y = 0; y < newy; ++y) {
-		const int sy = (int)cy;
-		cy += dy;
-		int ey = (int)cy;
-		if (ey == sy)
-			ey = sy + 1;
-
-		float cx = 0;
+	// source spans per destination row and column, accumulated exactly as
+	// before so that parallel rows give the same result as a serial pass
+	std::vector<int2> ySpans(newy);
+	std::vector<int2> xSpans(newx);
+
+	const auto calcSpans = [](std::vector<int2>& spans, float d) {
+		float c = 0;
+		for (int2& span: spans) {
+			span.x = (int)c;
+			c += d;
+			span.y = std::max((int)c, span.x + 1);
+		}
+	};
+
+	calcSpans(ySpans, dy);
+	calcSpans(xSpans, dx);
+
+	for_mt(0, newy, [&](const int y) {
+		const int sy = ySpans[y].x;
+		const int ey = ySpans[y].y;
+
 		for (int x = 0; x < newx; ++x) {
-			const int sx = (int)cx;
-			cx += dx;
-			int ex = (int)cx;
-			if (ex == sx)
-				ex = sx + 1;
+			const int sx = xSpans[x].x;
+			const int ex = xSpans[x].y;
 
 			std::array<AccumChanType, ch> rgba = {0};
 
@@ -821,7 +830,7 @@ CBitmap TBitmapAction<T, ch>::CreateRescaled(int newx, int newy)
 				}
 			}
 		}
-	}
+	});
 
 	return dst;
 }
@@ -1818,20 +1827,15 @@ void CBitmap::ReverseYAxis()
 	const auto dts = GetDataTypeSize();
 	const auto memSize = xsize * channels * dts;
 
-	uint8_t* tmp = texMemPool.Alloc(memSize);
 	uint8_t* mem = GetRawMem();
 
+	// swap lines in place, no need for a scratch line from the (locked) pool
 	for (int y = 0; y < (ysize / 2); ++y) {
 		const int pixelL = (((y            ) * xsize) + 0) * channels * dts;
 		const int pixelH = (((ysize - 1 - y) * xsize) + 0) * channels * dts;
 
-		// copy the whole line
-		std::copy(mem + pixelH, mem + pixelH + memSize, tmp         );
-		std::copy(mem + pixelL, mem + pixelL + memSize, mem + pixelH);
-		std::copy(tmp, tmp + memSize, mem + pixelL);
+		std::swap_ranges(mem + pixelL, mem + pixelL + memSize, mem + pixelH);
 	}
-
-	texMemPool.Free(tmp, memSize);
 #endif
 }
 
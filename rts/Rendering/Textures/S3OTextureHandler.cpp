@@ -10,6 +10,7 @@
 #include "Rendering/Units/UnitDrawer.h"
 #include "Rendering/Models/3DModel.h"
 #include "Rendering/Textures/Bitmap.h"
+#include "Rendering/Textures/TextureCompressor.h"
 #include "System/StringUtil.h"
 #include "System/Exceptions.h"
 #include "System/Log/ILog.h"
@@ -47,6 +48,8 @@ void CS3OTextureHandler::Init()
 	// dummies
 	textures.emplace_back();
 	textures.emplace_back();
+
+	TextureCompressor::Init();
 }
 
 void CS3OTextureHandler::Kill()
@@ -60,6 +63,9 @@ void CS3OTextureHandler::Kill()
 	textureCache.clear();
 	textureTable.clear();
 	bitmapCache.clear();
+	compressedCache.clear();
+
+	TextureCompressor::Kill();
 }
 
 void CS3OTextureHandler::Reload()
@@ -79,7 +85,14 @@ void CS3OTextureHandler::Reload()
 			if (texData.invertAxis)
 				bitmap.ReverseYAxis();
 
-			uint32_t newTexId = bitmap.CreateTexture(0.0f, 0.0f, true, texData.texID);
+			TextureCompressor::CompressedTexture compTex;
+
+			uint32_t newTexId = 0;
+			if (TextureCompressor::Compress(bitmap, compTex)) {
+				newTexId = TextureCompressor::CreateTexture(compTex, texData.texID);
+			} else {
+				newTexId = bitmap.CreateTexture(0.0f, 0.0f, true, texData.texID);
+			}
 			assert(newTexId == texData.texID);
 		}
 	}
@@ -89,10 +102,66 @@ void CS3OTextureHandler::Reload()
 
 void CS3OTextureHandler::PreloadTexture(S3DModel* model, bool invertAxis, bool invertAlpha)
 {
-	cacheMutex.lock();
-	LoadAndCacheTexture(model, 0, invertAxis, invertAlpha, true);
-	LoadAndCacheTexture(model, 1, invertAxis,       false, true); // never invert alpha for tex2
-	cacheMutex.unlock();
+	PreloadBitmap(model, 0, invertAxis, invertAlpha);
+	PreloadBitmap(model, 1, invertAxis,       false); // never invert alpha for tex2
+}
+
+void CS3OTextureHandler::PreloadBitmap(const S3DModel* model, unsigned int texNum, bool invertAxis, bool invertAlpha)
+{
+	const std::string& textureName = model->texs[texNum];
+
+	{
+		std::lock_guard<spring::mutex> lck(cacheMutex);
+
+		// already (pre)loaded as part of another model
+		if (textureCache.find(textureName) != textureCache.end())
+			return;
+	}
+
+	// read and decode without holding the lock, such that models
+	// preloaded in parallel do not wait on each others' textures
+	CBitmap bitmap;
+
+	if (!bitmap.Load(textureName) && !bitmap.Load("unittextures/" + textureName)) {
+		if (texNum == 0)
+			LOG_L(L_WARNING, "[%s] could not load primary texture \"%s\" from model \"%s\"", __func__, textureName.c_str(), model->name.c_str());
+
+		// file not found (or headless build), set a single pixel so model is visible
+		bitmap.AllocDummy(SColor(255 * (texNum == 0), 0, 0, 255 * (1 - invertAlpha)));
+	}
+
+	if (invertAxis)
+		bitmap.ReverseYAxis();
+	if (invertAlpha)
+		bitmap.InvertAlpha();
+
+	// the model preloader runs this on pool threads, so encoding a
+	// texture (or reading it from the cache) costs no main-thread time
+	TextureCompressor::CompressedTexture compTex;
+
+	const bool compress = TextureCompressor::Compress(bitmap, compTex);
+
+	std::lock_guard<spring::mutex> lck(cacheMutex);
+
+	// another model using the same texture might have won the race
+	if (textureCache.find(textureName) != textureCache.end())
+		return;
+
+	// save main params such that data is stored correctly for Reload()
+	textureCache[textureName] = {
+		0,
+		static_cast<uint32_t>(bitmap.xsize),
+		static_cast<uint32_t>(bitmap.ysize),
+		invertAxis,
+		invertAlpha
+	};
+
+	// don't generate a texture yet, just save the bitmap for LoadTexture
+	if (compress) {
+		compressedCache.emplace(textureName, std::move(compTex));
+	} else {
+		bitmapCache.emplace(textureName, std::move(bitmap));
+	}
 }
 
 
@@ -100,8 +169,8 @@ void CS3OTextureHandler::LoadTexture(S3DModel* model)
 {
 	cacheMutex.lock();
 
-	const unsigned int tex1ID = LoadAndCacheTexture(model, 0, false, false, false);
-	const unsigned int tex2ID = LoadAndCacheTexture(model, 1, false, false, false);
+	const unsigned int tex1ID = LoadAndCacheTexture(model, 0);
+	const unsigned int tex2ID = LoadAndCacheTexture(model, 1);
 
 	const auto texTableIter = textureTable.find(TEX_MAT_UID(tex1ID, tex2ID));
 
@@ -116,76 +185,43 @@ void CS3OTextureHandler::LoadTexture(S3DModel* model)
 	cacheMutex.unlock();
 }
 
-unsigned int CS3OTextureHandler::LoadAndCacheTexture(
-	const S3DModel* model,
-	unsigned int texNum,
-	bool invertAxis,
-	bool invertAlpha,
-	bool preloadCall
-) {
-	CBitmap* bitmap = nullptr;
-
+unsigned int CS3OTextureHandler::LoadAndCacheTexture(const S3DModel* model, unsigned int texNum)
+{
 	const auto& textureName = model->texs[texNum];
 	const auto textureIt = textureCache.find(textureName);
 
-	if (textureIt != textureCache.end() && textureIt->second.texID > 0)
-		return textureIt->second.texID;
-
-	const auto bitmapIt = bitmapCache.find(textureName);
-
-	if (bitmapIt != bitmapCache.end()) {
-		// bitmap was previously preloaded but not yet loaded
-		// if !preloading, we will now turn the bitmap into a
-		// texture and cache it
-		bitmap = &(bitmapIt->second);
-	} else {
-		// bitmap was not yet preloaded, meaning we are the
-		// first to (all non-3DO model textures are always
-		// preloaded)
-		assert(preloadCall);
+	// all non-3DO model textures are always preloaded
+	assert(textureIt != textureCache.end());
 
-		auto pair = bitmapCache.emplace(textureName, {});
-		auto iter = pair.first;
+	if (textureIt == textureCache.end())
+		return 0;
 
-		bitmap = &(iter->second);
+	if (textureIt->second.texID > 0)
+		return textureIt->second.texID;
 
-		if (!bitmap->Load(textureName) && !bitmap->Load("unittextures/" + textureName)) {
-			if (texNum == 0)
-				LOG_L(L_WARNING, "[%s] could not load primary texture \"%s\" from model \"%s\"", __func__, textureName.c_str(), model->name.c_str());
+	const auto compressedIt = compressedCache.find(textureName);
 
-			// file not found (or headless build), set a single pixel so model is visible
-			bitmap->AllocDummy(SColor(255 * (texNum == 0), 0, 0, 255 * (1 - invertAlpha)));
-		}
+	if (compressedIt != compressedCache.end()) {
+		const unsigned int texID = TextureCompressor::CreateTexture(compressedIt->second);
 
-		if (invertAxis)
-			bitmap->ReverseYAxis();
-		if (invertAlpha)
-			bitmap->InvertAlpha();
+		textureIt->second.texID = texID;
+		compressedCache.erase(compressedIt);
+		return texID;
 	}
 
-	const unsigned int texID = preloadCall ? 0 : bitmap->CreateMipMapTexture();
+	const auto bitmapIt = bitmapCache.find(textureName);
 
-	if (textureIt != textureCache.end()) {
-		assert(!preloadCall);
-		textureIt->second.texID = texID;
-	}
-	else {
-		//save main params from the preloadCall pass, such that data is stored correctly for Reload()
-		assert( preloadCall);
-		textureCache[textureName] = {
-			texID,
-			static_cast<uint32_t>(bitmap->xsize),
-			static_cast<uint32_t>(bitmap->ysize),
-			invertAxis,
-			invertAlpha
-		};
-	}
+	// bitmap was previously preloaded but not yet loaded;
+	// we will now turn the bitmap into a texture and cache it
+	assert(bitmapIt != bitmapCache.end());
 
-	// don't generate a texture yet, just save the bitmap for later
-	if (preloadCall)
+	if (bitmapIt == bitmapCache.end())
 		return 0;
 
-	bitmapCache.erase(textureName);
+	const unsigned int texID = bitmapIt->second.CreateMipMapTexture();
+
+	textureIt->second.texID = texID;
+	bitmapCache.erase(bitmapIt);
 	return texID;
 }
 
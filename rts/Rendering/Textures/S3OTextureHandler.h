@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "Bitmap.h"
+#include "TextureCompressor.h"
 #include "System/Threading/SpringThreading.h"
 #include "System/UnorderedMap.hpp"
 
@@ -53,23 +54,20 @@ public:
 	}
 
 private:
-	unsigned int LoadAndCacheTexture(
-		const S3DModel* model,
-		unsigned int texNum,
-		bool invertAxis,
-		bool invertAlpha,
-		bool preloadCall
-	);
+	unsigned int LoadAndCacheTexture(const S3DModel* model, unsigned int texNum);
+	void PreloadBitmap(const S3DModel* model, unsigned int texNum, bool invertAxis, bool invertAlpha);
 	unsigned int InsertTextureMat(const S3DModel* model);
 
 private:
 	typedef spring::unsynced_map<std::string, CachedS3OTex> TextureCache;
 	typedef spring::unsynced_map<std::string, CBitmap> BitmapCache;
+	typedef spring::unsynced_map<std::string, TextureCompressor::CompressedTexture> CompressedCache;
 	typedef spring::unsynced_map<std::uint64_t, unsigned int> TextureTable;
 
 	TextureCache textureCache; // stores individual primary- and secondary-textures by name
 	TextureTable textureTable; // stores (primary, secondary) texture-pairs by unique ident
 	BitmapCache bitmapCache;
+	CompressedCache compressedCache; // preloaded textures that were compressed instead
 
 	spring::mutex cacheMutex;
 
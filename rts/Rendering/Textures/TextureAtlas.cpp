@@ -14,6 +14,7 @@
 #include "System/StringUtil.h"
 #include "System/Exceptions.h"
 #include "System/SafeUtil.h"
+#include "System/Threading/ThreadPool.h"
 
 #include <cstring>
 
@@ -164,18 +165,29 @@ bool CTextureAtlas::CreateTexture()
 		// make spacing between textures black transparent to avoid ugly lines with linear filtering
 		std::memset(data, 0, atlasSize.x * atlasSize.y * 4);
 
-		for (const MemTex& memTex: memTextures) {
+		std::vector<int2> texPositions(memTextures.size());
+
+		for (size_t i = 0; i < memTextures.size(); i++) {
+			const MemTex& memTex = memTextures[i];
+
 			const float4 texCoords = atlasAllocator->GetTexCoords(memTex.names[0]);
 			const float4 absCoords = atlasAllocator->GetEntry(memTex.names[0]);
 
-			const int xpos = absCoords.x;
-			const int ypos = absCoords.y;
+			texPositions[i] = int2(absCoords.x, absCoords.y);
 
 			AtlasedTexture tex(texCoords);
 
 			for (const auto& name: memTex.names) {
 				textures[name] = std::move(tex); //make sure textures[name] gets only its guts replaced, so all pointers remain valid
 			}
+		}
+
+		// sub-textures do not overlap, so each can be copied by a different thread
+		for_mt(0, memTextures.size(), [&](const int i) {
+			const MemTex& memTex = memTextures[i];
+
+			const int xpos = texPositions[i].x;
+			const int ypos = texPositions[i].y;
 
 			for (int y = 0; y < memTex.ysize; ++y) {
 				int* dst = ((int*)           data  ) + xpos + (ypos + y) * atlasSize.x;
@@ -183,7 +195,7 @@ bool CTextureAtlas::CreateTexture()
 
 				memcpy(dst, src, memTex.xsize * 4);
 			}
-		}
+		});
 
 		if (debug) {
 			CBitmap tex(data, atlasSize.x, atlasSize.y);
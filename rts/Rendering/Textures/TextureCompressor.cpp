@@ -0,0 +1,322 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "TextureCompressor.h"
+
+#include "Rendering/GL/myGL.h"
+#include "Rendering/GlobalRendering.h"
+#include "Rendering/Textures/Bitmap.h"
+#include "System/Config/ConfigHandler.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/Log/ILog.h"
+#include "System/Sync/HsiehHash.h"
+#include "System/Threading/SpringThreading.h"
+#include "System/bitops.h"
+
+#if defined(USE_LIBSQUISH) && !defined(HEADLESS)
+	#include "lib/squish/squish.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+CONFIG(int, CompressModelTextures).defaultValue(0).minimumValue(0).maximumValue(2)
+	.description("Compress uncompressed unit and feature textures to DXT1/DXT5 when loading them, to reduce video memory usage. 0 := off, 1 := fast encoder, 2 := high quality encoder (slow, but results are cached).");
+
+
+namespace TextureCompressor
+{
+	static constexpr char CACHE_MAGIC[8] = {'S', 'P', 'R', 'T', 'E', 'X', 'B', 'C'};
+	static constexpr uint32_t CACHE_VERSION = 1;
+
+	// smaller textures are not worth their cache files
+	static constexpr int MIN_TEXTURE_SIZE = 64;
+
+	struct CacheHeader {
+		char magic[8];
+
+		uint64_t key;
+		int32_t xsize;
+		int32_t ysize;
+		uint32_t glFormat;
+		uint32_t numLevels;
+		uint32_t dataSize;
+	};
+
+	static spring::mutex writeMutex;
+	static std::string cacheDir;
+
+	static std::atomic<uint32_t> numTextures = {0};
+	static std::atomic<uint64_t> numRawBytes = {0};
+	static std::atomic<uint64_t> numCompressedBytes = {0};
+
+	static int quality = 0;
+	static bool haveNPOT = false;
+
+
+#if defined(USE_LIBSQUISH) && !defined(HEADLESS)
+	static std::string GetFileName(uint64_t key)
+	{
+		char buf[32];
+		snprintf(buf, sizeof(buf), "%016" PRIx64 ".s3tc", key);
+		return (cacheDir + buf);
+	}
+
+	static bool ReadCache(uint64_t key, int32_t xsize, int32_t ysize, CompressedTexture& tex)
+	{
+		if (cacheDir.empty())
+			return false;
+
+		FILE* file = fopen(GetFileName(key).c_str(), "rb");
+
+		if (file == nullptr)
+			return false;
+
+		CacheHeader header;
+
+		bool ret = true;
+		ret = ret && (fread(&header, sizeof(header), 1, file) == 1);
+		ret = ret && (memcmp(header.magic, CACHE_MAGIC, sizeof(header.magic)) == 0);
+		ret = ret && (header.key == key && header.xsize == xsize && header.ysize == ysize);
+		ret = ret && (header.numLevels > 0 && header.numLevels <= 32 && header.dataSize > 0);
+
+		if (ret) {
+			tex.glFormat = header.glFormat;
+			tex.xsize = header.xsize;
+			tex.ysize = header.ysize;
+			tex.levelOffsets.resize(header.numLevels + 1);
+			tex.data.resize(header.dataSize);
+
+			ret = ret && (fread(tex.levelOffsets.data(), tex.levelOffsets.size() * sizeof(uint32_t), 1, file) == 1);
+			ret = ret && (fread(tex.data.data(), tex.data.size(), 1, file) == 1);
+			ret = ret && (tex.levelOffsets.front() == 0 && tex.levelOffsets.back() == header.dataSize);
+		}
+
+		fclose(file);
+
+		if (!ret)
+			tex = {};
+
+		return ret;
+	}
+
+	static void WriteCache(uint64_t key, const CompressedTexture& tex)
+	{
+		if (cacheDir.empty())
+			return;
+
+		CacheHeader header;
+		memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+
+		header.key = key;
+		header.xsize = tex.xsize;
+		header.ysize = tex.ysize;
+		header.glFormat = tex.glFormat;
+		header.numLevels = tex.GetNumLevels();
+		header.dataSize = tex.data.size();
+
+		const std::string fileName = GetFileName(key);
+		const std::string tempName = fileName + ".tmp";
+
+		// two models can share a texture under different names
+		std::lock_guard<spring::mutex> lck(writeMutex);
+
+		FILE* file = fopen(tempName.c_str(), "wb");
+
+		if (file == nullptr) {
+			LOG_L(L_WARNING, "[TextureCompressor::%s] failed to open \"%s\" for writing", __func__, tempName.c_str());
+			return;
+		}
+
+		bool ret = true;
+		ret = ret && (fwrite(&header, sizeof(header), 1, file) == 1);
+		ret = ret && (fwrite(tex.levelOffsets.data(), tex.levelOffsets.size() * sizeof(uint32_t), 1, file) == 1);
+		ret = ret && (fwrite(tex.data.data(), tex.data.size(), 1, file) == 1);
+
+		fclose(file);
+
+		// readers must never see a truncated file
+		if (!ret || std::rename(tempName.c_str(), fileName.c_str()) != 0)
+			std::remove(tempName.c_str());
+	}
+
+
+	static void DownSample(const std::vector<uint8_t>& src, int srcX, int srcY, std::vector<uint8_t>& dst, int dstX, int dstY)
+	{
+		dst.resize(dstX * dstY * 4);
+
+		// 2x2 box filter, odd edges are clamped
+		for (int y = 0; y < dstY; y++) {
+			const int y0 = std::min(y * 2    , srcY - 1);
+			const int y1 = std::min(y * 2 + 1, srcY - 1);
+
+			for (int x = 0; x < dstX; x++) {
+				const int x0 = std::min(x * 2    , srcX - 1);
+				const int x1 = std::min(x * 2 + 1, srcX - 1);
+
+				const uint8_t* p00 = &src[(y0 * srcX + x0) * 4];
+				const uint8_t* p01 = &src[(y0 * srcX + x1) * 4];
+				const uint8_t* p10 = &src[(y1 * srcX + x0) * 4];
+				const uint8_t* p11 = &src[(y1 * srcX + x1) * 4];
+
+				for (int c = 0; c < 4; c++) {
+					dst[(y * dstX + x) * 4 + c] = (p00[c] + p01[c] + p10[c] + p11[c] + 2) >> 2;
+				}
+			}
+		}
+	}
+
+	static void Encode(const CBitmap& bitmap, bool opaque, CompressedTexture& tex)
+	{
+		const int flags = (opaque? squish::kDxt1: squish::kDxt5) | ((quality > 1)? squish::kColourClusterFit: squish::kColourRangeFit);
+
+		tex.glFormat = opaque? GL_COMPRESSED_RGB_S3TC_DXT1_EXT: GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		tex.xsize = bitmap.xsize;
+		tex.ysize = bitmap.ysize;
+		tex.levelOffsets.assign(1, 0);
+		tex.data.clear();
+
+		std::vector<uint8_t> level(bitmap.GetRawMem(), bitmap.GetRawMem() + bitmap.GetMemSize());
+		std::vector<uint8_t> nextLevel;
+
+		for (int sizeX = tex.xsize, sizeY = tex.ysize; ; ) {
+			const size_t offset = tex.data.size();
+
+			tex.data.resize(offset + squish::GetStorageRequirements(sizeX, sizeY, flags));
+			squish::CompressImage(level.data(), sizeX, sizeY, &tex.data[offset], flags);
+			tex.levelOffsets.push_back(tex.data.size());
+
+			if (sizeX == 1 && sizeY == 1)
+				break;
+
+			const int nextX = std::max(sizeX >> 1, 1);
+			const int nextY = std::max(sizeY >> 1, 1);
+
+			DownSample(level, sizeX, sizeY, nextLevel, nextX, nextY);
+			level.swap(nextLevel);
+
+			sizeX = nextX;
+			sizeY = nextY;
+		}
+	}
+#endif
+
+
+	bool Init()
+	{
+		quality = configHandler->GetInt("CompressModelTextures");
+		haveNPOT = globalRendering->supportNonPowerOfTwoTex;
+
+		#if defined(USE_LIBSQUISH) && !defined(HEADLESS)
+		if (quality > 0 && !GLEW_EXT_texture_compression_s3tc) {
+			LOG_L(L_WARNING, "[TextureCompressor::%s] S3TC not supported, model textures are not compressed", __func__);
+			quality = 0;
+		}
+		#else
+		quality = 0;
+		#endif
+
+		if (quality == 0)
+			return false;
+
+		cacheDir = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + "/textures/", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+
+		if (!cacheDir.empty())
+			cacheDir = FileSystem::EnsurePathSepAtEnd(cacheDir);
+
+		return true;
+	}
+
+	void Kill()
+	{
+		if (numTextures == 0)
+			return;
+
+		LOG("[TextureCompressor::%s] compressed %u textures, %.1fMB instead of %.1fMB", __func__,
+			numTextures.load(), numCompressedBytes / (1024.0f * 1024.0f), numRawBytes / (1024.0f * 1024.0f));
+
+		numTextures = 0;
+		numRawBytes = 0;
+		numCompressedBytes = 0;
+	}
+
+	bool IsEnabled() { return (quality > 0); }
+
+
+	bool Compress(const CBitmap& bitmap, CompressedTexture& tex)
+	{
+		if (quality == 0)
+			return false;
+
+		#if defined(USE_LIBSQUISH) && !defined(HEADLESS)
+		if (bitmap.compressed || bitmap.channels != 4 || bitmap.dataType != GL_UNSIGNED_BYTE)
+			return false;
+		if (bitmap.xsize < MIN_TEXTURE_SIZE || bitmap.ysize < MIN_TEXTURE_SIZE)
+			return false;
+		// CBitmap::CreateTexture would rescale these
+		if (!haveNPOT && (uint32_t(bitmap.xsize) != next_power_of_2(bitmap.xsize) || uint32_t(bitmap.ysize) != next_power_of_2(bitmap.ysize)))
+			return false;
+
+		const uint8_t* mem = bitmap.GetRawMem();
+		const size_t memSize = bitmap.GetMemSize();
+
+		bool opaque = true;
+
+		for (size_t i = 3; i < memSize && opaque; i += 4) {
+			opaque = (mem[i] == 0xFF);
+		}
+
+		const int32_t params[] = {bitmap.xsize, bitmap.ysize, quality, opaque, int32_t(CACHE_VERSION)};
+		const uint32_t dataHash = HsiehHash(mem, memSize, 0);
+		const uint32_t paramHash = HsiehHash(params, sizeof(params), dataHash);
+		const uint64_t key = (uint64_t(dataHash) << 32) | paramHash;
+
+		if (!ReadCache(key, bitmap.xsize, bitmap.ysize, tex)) {
+			Encode(bitmap, opaque, tex);
+			WriteCache(key, tex);
+		}
+
+		numTextures += 1;
+		numRawBytes += (memSize * 4) / 3;
+		numCompressedBytes += tex.data.size();
+		return true;
+		#else
+		return false;
+		#endif
+	}
+
+
+	unsigned int CreateTexture(const CompressedTexture& tex, unsigned int texID)
+	{
+		if (tex.Empty())
+			return 0;
+
+		if (texID == 0)
+			glGenTextures(1, &texID);
+
+		glBindTexture(GL_TEXTURE_2D, texID);
+
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, tex.GetNumLevels() - 1);
+
+		for (unsigned int level = 0; level < tex.GetNumLevels(); level++) {
+			const uint32_t offset = tex.levelOffsets[level];
+			const uint32_t size = tex.levelOffsets[level + 1] - offset;
+
+			const int sizeX = std::max(tex.xsize >> level, 1);
+			const int sizeY = std::max(tex.ysize >> level, 1);
+
+			glCompressedTexImage2D(GL_TEXTURE_2D, level, tex.glFormat, sizeX, sizeY, 0, size, &tex.data[offset]);
+		}
+
+		return texID;
+	}
+}
@@ -0,0 +1,50 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _TEXTURE_COMPRESSOR_H
+#define _TEXTURE_COMPRESSOR_H
+
+#include <cstdint>
+#include <vector>
+
+class CBitmap;
+
+/**
+ * Optional load-time S3TC compression of RGBA8 model textures.
+ *
+ * A full mip chain is box-filtered on the CPU and every level is encoded
+ * as DXT1 (BC1) if all texels are opaque, as DXT5 (BC3) otherwise, which
+ * cuts the texture memory to an eighth or a quarter. Encoding is slow, so
+ * results are stored under CacheDir/textures/, keyed by a hash of the
+ * source texels, and only computed once per machine.
+ *
+ * Compress may be called from the model preloading threads, everything
+ * else must be called from the GL thread.
+ */
+namespace TextureCompressor
+{
+	struct CompressedTexture {
+		bool Empty() const { return data.empty(); }
+		unsigned int GetNumLevels() const { return (levelOffsets.size() - 1); }
+
+		uint32_t glFormat = 0;
+		int32_t xsize = 0;
+		int32_t ysize = 0;
+
+		// level i occupies data[levelOffsets[i] .. levelOffsets[i + 1]]
+		std::vector<uint32_t> levelOffsets;
+		std::vector<uint8_t> data;
+	};
+
+	// returns false if disabled (CompressModelTextures=0) or unsupported
+	bool Init();
+	void Kill();
+
+	bool IsEnabled();
+
+	// false if the bitmap is not suited (not RGBA8, too small, ...)
+	bool Compress(const CBitmap& bitmap, CompressedTexture& tex);
+
+	unsigned int CreateTexture(const CompressedTexture& tex, unsigned int texID = 0);
+}
+
+#endif // _TEXTURE_COMPRESSOR_H
@@ -359,14 +359,26 @@ void CUnitDrawerLegacy::DrawUnitMiniMapIcons() const
 			);
 		}
 
-		rb.Submit(GL_TRIANGLES);
+		// without per-icon textures all quads can go into a single batch
+		if (minimap->UseUnitIcons())
+			rb.Submit(GL_TRIANGLES);
 	}
 
+	if (!minimap->UseUnitIcons())
+		rb.Submit(GL_TRIANGLES);
+
 	sh.SetUniform("alphaCtrl", 0.0f, 0.0f, 0.0f, 1.0f);
 	sh.Disable();
 	glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+struct IconQuad {
+	std::array<VA_TYPE_TC, 4> verts;
+	bool valid;
+};
+
+static std::vector<IconQuad> iconQuads;
+
 void CUnitDrawerLegacy::DrawUnitIcons() const
 {
 #if 0
@@ -399,14 +411,16 @@ void CUnitDrawerLegacy::DrawUnitIcons() const
 
 		icon->BindTexture();
 
-		for (const CUnit* cu : units)
-		{
-			CUnit* unit = const_cast<CUnit*>(cu);
+		// billboards are built in parallel, only appending them is serial
+		iconQuads.clear();
+		iconQuads.resize(units.size());
 
-			if (!unit->GetIsIcon())
-				continue;
-			if (!unit->drawIcon)
-				continue;
+		const auto makeQuad = [icon = icon, &units](const int i) {
+			CUnit* unit = const_cast<CUnit*>(units[i]);
+			IconQuad& quad = iconQuads[i];
+
+			if ((quad.valid = (unit->GetIsIcon() && unit->drawIcon)) == false)
+				return;
 
 			// drawMidPos is auto-calculated now; can wobble on its own as pieces move
 			float3 pos = (!gu->spectatingFullView) ?
@@ -445,12 +459,24 @@ void CUnitDrawerLegacy::DrawUnitIcons() const
 			const float3 tl = vn + dy; // top-left
 			const float3 tr = vp + dy; // top-right
 
-			rb.AddQuadTriangles(
-				{ tl, 0.0f, 0.0f, color },
-				{ tr, 1.0f, 0.0f, color },
-				{ br, 1.0f, 1.0f, color },
-				{ bl, 0.0f, 1.0f, color }
-			);
+			quad.verts[0] = { tl, 0.0f, 0.0f, color };
+			quad.verts[1] = { tr, 1.0f, 0.0f, color };
+			quad.verts[2] = { br, 1.0f, 1.0f, color };
+			quad.verts[3] = { bl, 0.0f, 1.0f, color };
+		};
+
+		if (mtModelDrawer) {
+			for_mt_chunk(0, units.size(), makeQuad, -256); // at least 256 icons per thread
+		} else {
+			for (size_t i = 0; i < units.size(); i++)
+				makeQuad(i);
+		}
+
+		for (IconQuad& quad: iconQuads) {
+			if (!quad.valid)
+				continue;
+
+			rb.AddQuadTriangles(std::move(quad.verts[0]), std::move(quad.verts[1]), std::move(quad.verts[2]), std::move(quad.verts[3]));
 		}
 		rb.Submit(GL_TRIANGLES);
 	}
@@ -114,6 +114,8 @@ void CUnitDrawerData::Update()
 	};
 
 	if (mtModelDrawer) {
+		ThreadPool::ScopedTaskPriority stp(ThreadPool::PRIORITY_LOW);
+
 		for_mt_chunk(0, unsortedObjects.size(), [this, &updateBody](const int k) {
 			CUnit* unit = unsortedObjects[k];
 			updateBody(unit);
@@ -140,27 +142,39 @@ void CUnitDrawerData::Update()
 
 void CUnitDrawerData::UpdateGhostedBuildings()
 {
+	// the LOS checks are independent per allyteam and run in parallel, ghosts
+	// seen again are moved past the returned boundary; releasing them touches
+	// the (shared) refcounts, decals and mem-pool and is done serially below
+	static std::vector<std::array<size_t, MODELTYPE_CNT>> numHiddenGhosts;
+
+	numHiddenGhosts.resize(deadGhostBuildings.size());
+
+	for_mt(0, deadGhostBuildings.size(), [&](const int allyTeam) {
+		for (int modelType = MODELTYPE_3DO; modelType < MODELTYPE_CNT; modelType++) {
+			auto& dgb = deadGhostBuildings[allyTeam][modelType];
+			const auto iter = std::partition(dgb.begin(), dgb.end(), [allyTeam](const GhostSolidObject* gso) {
+				return !losHandler->InLos(gso->pos, allyTeam);
+			});
+
+			numHiddenGhosts[allyTeam][modelType] = iter - dgb.begin();
+		}
+	});
+
 	for (int allyTeam = 0; allyTeam < deadGhostBuildings.size(); ++allyTeam) {
 		for (int modelType = MODELTYPE_3DO; modelType < MODELTYPE_CNT; modelType++) {
 			auto& dgb = deadGhostBuildings[allyTeam][modelType];
 
-			for (int i = 0; i < dgb.size(); /*no-op*/) {
+			for (size_t i = numHiddenGhosts[allyTeam][modelType]; i < dgb.size(); i++) {
 				GhostSolidObject* gso = dgb[i];
 
-				if (!losHandler->InLos(gso->pos, allyTeam)) {
-					++i;
-					continue;
-				}
-
 				// obtained LOS on the ghost of a dead building
 				if (!gso->DecRef()) {
 					groundDecals->GhostDestroyed(gso);
 					ghostMemPool.free(gso);
 				}
-
-				dgb[i] = dgb.back();
-				dgb.pop_back();
 			}
+
+			dgb.resize(numHiddenGhosts[allyTeam][modelType]);
 		}
 	}
 }
@@ -310,27 +324,24 @@ void CUnitDrawerData::UpdateObjectDrawFlags(CSolidObject* o) const
 		u->SetIsIcon(isIcon);
 	}
 
-	for (uint32_t camType = CCamera::CAMTYPE_PLAYER; camType < CCamera::CAMTYPE_ENVMAP; ++camType) {
-		if (camType == CCamera::CAMTYPE_UWREFL && !water->CanDrawReflectionPass())
-			continue;
-
-		if (camType == CCamera::CAMTYPE_SHADOW && ((shadowHandler.shadowGenBits & CShadowHandler::SHADOWGEN_BIT_MODEL) == 0))
-			continue;
+	if (u->noDraw)
+		return;
 
-		const CCamera* cam = CCameraHandler::GetCamera(camType);
+	// unit will be drawn as icon instead
+	if (u->GetIsIcon())
+		return;
 
-		if (u->noDraw)
-			continue;
+	if (u->IsInVoid())
+		return;
 
-		// unit will be drawn as icon instead
-		if (u->GetIsIcon())
-			continue;
+	if (!(u->losStatus[gu->myAllyTeam] & LOS_INLOS) && !gu->spectatingFullView)
+		return;
 
-		if (u->IsInVoid())
+	for (uint32_t camType = CCamera::CAMTYPE_PLAYER; camType < CCamera::CAMTYPE_ENVMAP; ++camType) {
+		if ((drawCamTypeBits & (1u << camType)) == 0)
 			continue;
 
-		if (!(u->losStatus[gu->myAllyTeam] & LOS_INLOS) && !gu->spectatingFullView)
-			continue;
+		const CCamera* cam = CCameraHandler::GetCamera(camType);
 
 		if (!cam->InView(u->drawMidPos, u->GetDrawRadius()))
 			continue;
@@ -339,8 +350,7 @@ void CUnitDrawerData::UpdateObjectDrawFlags(CSolidObject* o) const
 		{
 			case CCamera::CAMTYPE_PLAYER: {
 				const float sqrCamDist = (u->drawPos - cam->GetPos()).SqLength();
-				const float farTexDist = Square(u->GetDrawRadius() + CModelDrawerDataConcept::modelDrawDist);
-				if (sqrCamDist >= farTexDist) {
+				if (UseFarTexture(cam, sqrCamDist, u->GetDrawRadius())) {
 					u->SetDrawFlag(DrawFlags::SO_FARTEX_FLAG);
 					continue;
 				}
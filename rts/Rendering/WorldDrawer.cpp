@@ -13,6 +13,7 @@
 #include "Rendering/CommandDrawer.h"
 #include "Rendering/DebugColVolDrawer.h"
 #include "Rendering/FarTextureHandler.h"
+#include "Rendering/GPUProfiler.h"
 #include "Rendering/LineDrawer.h"
 #include "Rendering/LuaObjectDrawer.h"
 #include "Rendering/Features/FeatureDrawer.h"
@@ -208,6 +209,7 @@ void CWorldDrawer::GenerateIBLTextures() const
 
 	if (shadowHandler.ShadowsLoaded()) {
 		SCOPED_TIMER("Draw::World::CreateShadows");
+		SCOPED_GPU_TIMER("Draw::World::CreateShadows");
 
 		game->SetDrawMode(CGame::gameShadowDraw);
 		shadowHandler.CreateShadows();
@@ -216,14 +218,18 @@ void CWorldDrawer::GenerateIBLTextures() const
 
 	{
 		SCOPED_TIMER("Draw::World::UpdateReflTex");
+		SCOPED_GPU_TIMER("Draw::World::UpdateReflTex");
 		cubeMapHandler.UpdateReflectionTexture();
 	}
 
-	if (sky->GetLight()->Update()) {
-		{
-			SCOPED_TIMER("Draw::World::UpdateSpecTex");
-			cubeMapHandler.UpdateSpecularTexture();
-		}
+	const bool lightChanged = sky->GetLight()->Update();
+
+	{
+		SCOPED_TIMER("Draw::World::UpdateSpecTex");
+		cubeMapHandler.UpdateSpecularTexture(lightChanged);
+	}
+
+	if (lightChanged) {
 		{
 			SCOPED_TIMER("Draw::World::UpdateSkyTex");
 			sky->UpdateSkyTexture();
@@ -259,6 +265,7 @@ void CWorldDrawer::ResetMVPMatrices() const
 void CWorldDrawer::Draw() const
 {
 	SCOPED_TIMER("Draw::World");
+	SCOPED_GPU_TIMER("Draw::World");
 
 	glClearColor(sky->fogColor[0], sky->fogColor[1], sky->fogColor[2], 0.0f);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
@@ -277,6 +284,7 @@ void CWorldDrawer::Draw() const
 
 	{
 		SCOPED_TIMER("Draw::World::Projectiles");
+		SCOPED_GPU_TIMER("Draw::World::Projectiles");
 		projectileDrawer->Draw(false);
 	}
 
@@ -301,15 +309,18 @@ void CWorldDrawer::DrawOpaqueObjects() const
 	if (globalRendering->drawGround) {
 		{
 			SCOPED_TIMER("Draw::World::Terrain");
+			SCOPED_GPU_TIMER("Draw::World::Terrain");
 			gd->Draw(DrawPass::Normal);
 		}
 		{
 			SCOPED_TIMER("Draw::World::Decals");
+			SCOPED_GPU_TIMER("Draw::World::Decals");
 			groundDecals->Draw();
 			projectileDrawer->DrawGroundFlashes();
 		}
 		{
 			SCOPED_TIMER("Draw::World::Foliage");
+			SCOPED_GPU_TIMER("Draw::World::Foliage");
 			grassDrawer->Draw();
 		}
 		smoothHeightMeshDrawer->Draw(1.0f);
@@ -325,6 +336,8 @@ void CWorldDrawer::DrawOpaqueObjects() const
 
 	{
 		SCOPED_TIMER("Draw::World::Models::Opaque");
+		SCOPED_GPU_TIMER("Draw::World::Models::Opaque");
+		LuaObjectDrawer::DrawDeferredPass();
 		unitDrawer->Draw(false);
 		featureDrawer->Draw(false);
 
@@ -344,6 +357,7 @@ void CWorldDrawer::DrawAlphaObjects() const
 
 	{
 		SCOPED_TIMER("Draw::World::Models::Alpha");
+		SCOPED_GPU_TIMER("Draw::World::Models::Alpha");
 		// clip in model-space
 		glPushMatrix();
 		glLoadIdentity();
@@ -361,6 +375,7 @@ void CWorldDrawer::DrawAlphaObjects() const
 	// draw water (in-between)
 	if (globalRendering->drawWater && !mapRendering->voidWater) {
 		SCOPED_TIMER("Draw::World::Water");
+		SCOPED_GPU_TIMER("Draw::World::Water");
 
 		water->UpdateWater(game);
 		water->Draw();
@@ -368,6 +383,7 @@ void CWorldDrawer::DrawAlphaObjects() const
 
 	{
 		SCOPED_TIMER("Draw::World::Models::Alpha");
+		SCOPED_GPU_TIMER("Draw::World::Models::Alpha");
 		glPushMatrix();
 		glLoadIdentity();
 		glClipPlane(GL_CLIP_PLANE3, abovePlaneEq);
@@ -34,6 +34,7 @@ CR_BIND_DERIVED_POOL(CFeature, CSolidObject, , featureMemPool.allocMem, featureM
 CR_REG_METADATA(CFeature, (
 	CR_MEMBER(isRepairingBeforeResurrect),
 	CR_MEMBER(inUpdateQue),
+	CR_MEMBER(atRest),
 	CR_MEMBER(deleteMe),
 	CR_MEMBER(alphaFade),
 
@@ -52,6 +53,7 @@ CR_REG_METADATA(CFeature, (
 	CR_MEMBER(def),
 	CR_MEMBER(udef),
 	CR_MEMBER(moveCtrl),
+	CR_MEMBER(restPos),
 
 	CR_MEMBER(solidOnTop),
 	CR_MEMBER(transMatrix),
@@ -547,6 +549,18 @@ bool CFeature::UpdateVelocity(
 
 bool CFeature::UpdatePosition()
 {
+	// nothing below would change if we came to rest here last time and were
+	// not moved since (anything else that can set us in motion, including a
+	// terrain change, goes through SetFeatureUpdateable which clears atRest)
+	// so only refresh the state the full update would end with; this keeps
+	// burning or smoking wrecks and geothermal vents cheap while they remain
+	// in the update-queue
+	if (atRest && pos.same(restPos) && speed.same(ZeroVector)) {
+		UpdateTransformAndPhysState();
+		Block();
+		return false;
+	}
+
 	const float3 oldPos = pos;
 	// const float4 oldSpd = speed;
 
@@ -583,6 +597,7 @@ bool CFeature::UpdatePosition()
 	// use an exact comparison for the y-component (gravity is small)
 	if (!pos.equals(oldPos, float3(float3::cmp_eps(), 0.0f, float3::cmp_eps()))) {
 		eventHandler.FeatureMoved(this, oldPos);
+		atRest = false;
 		return true;
 	}
 
@@ -591,6 +606,9 @@ bool CFeature::UpdatePosition()
 	// nullify the vector to prevent visual extrapolation jitter
 	SetVelocityAndSpeed(mix({ZeroVector, 0.0f}, speed * moveCtrl.velocityMask, moveCtrl.enabled));
 
+	atRest = !moveCtrl.enabled;
+	restPos = pos;
+
 	return (moveCtrl.enabled);
 }
 
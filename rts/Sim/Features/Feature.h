@@ -115,6 +115,8 @@ public:
 	 */
 	bool isRepairingBeforeResurrect = false;
 	bool inUpdateQue = false;
+	// set when the last UpdatePosition call found us at <restPos>
+	bool atRest = false;
 	bool deleteMe = false;
 	bool alphaFade = true; // unsynced
 
@@ -132,6 +134,8 @@ public:
 
 	MoveCtrl moveCtrl;
 
+	float3 restPos;
+
 	const FeatureDef* def = nullptr;
 	const UnitDef* udef = nullptr; /// type of unit this feature should be resurrected to
 
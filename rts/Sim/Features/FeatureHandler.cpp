@@ -9,7 +9,6 @@
 #include "Map/ReadMap.h"
 #include "Sim/Misc/QuadField.h"
 #include "Sim/Units/CommandAI/BuilderCAI.h"
-#include "System/creg/STL_Set.h"
 #include "System/EventHandler.h"
 #include "System/TimeProfiler.h"
 
@@ -33,7 +32,7 @@ CFeatureHandler featureHandler;
 
 void CFeatureHandler::Init() {
 	features.resize(MAX_FEATURES, nullptr);
-	activeFeatureIDs.reserve(MAX_FEATURES); // internal table size must be constant
+	activeFeatureIDs.reserve(MAX_FEATURES);
 	featureMemPool.reserve(128);
 
 	idPool.Clear();
@@ -242,6 +241,9 @@ bool CFeatureHandler::UpdateFeature(CFeature* feature)
 
 void CFeatureHandler::SetFeatureUpdateable(CFeature* feature)
 {
+	// force a full position update, the feature might no longer be resting
+	feature->atRest = false;
+
 	if (feature->inUpdateQue) {
 		assert(std::find(updateFeatures.begin(), updateFeatures.end(), feature) != updateFeatures.end());
 		return;
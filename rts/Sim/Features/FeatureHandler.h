@@ -8,7 +8,7 @@
 #include "System/float3.h"
 #include "System/Misc/NonCopyable.h"
 #include "System/creg/creg_cond.h"
-#include "System/UnorderedSet.hpp"
+#include "System/SparseIDSet.h"
 #include "Sim/Misc/GlobalConstants.h"
 #include "Sim/Misc/SimObjectIDPool.h"
 
@@ -65,7 +65,7 @@ public:
 	void SetFeatureUpdateable(CFeature* feature);
 	void TerrainChanged(int x1, int y1, int x2, int y2);
 
-	const spring::unordered_set<int>& GetActiveFeatureIDs() const { return activeFeatureIDs; }
+	const spring::SparseIDSet& GetActiveFeatureIDs() const { return activeFeatureIDs; }
 
 private:
 	bool CanAddFeature(int id) const {
@@ -84,7 +84,7 @@ private:
 private:
 	SimObjectIDPool idPool;
 
-	spring::unordered_set<int> activeFeatureIDs;
+	spring::SparseIDSet activeFeatureIDs;
 	std::vector<int> deletedFeatureIDs;
 	std::vector<CFeature*> features;
 	std::vector<CFeature*> updateFeatures;
@@ -1,5 +1,6 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include "xsimd/xsimd.hpp"
 #include "CollisionHandler.h"
 #include "CollisionVolume.h"
 #include "Map/ReadMap.h" // mapDims
@@ -8,6 +9,7 @@
 #include "Sim/Misc/GlobalConstants.h"
 #include "Sim/Objects/SolidObject.h"
 #include "System/Matrix44f.h"
+#include "System/SpringMath.h"
 #include "System/Log/ILog.h"
 
 unsigned int CCollisionHandler::numDiscTests = 0;
@@ -21,6 +23,71 @@ void CCollisionHandler::PrintStats()
 }
 
 
+void CCollisionHandler::TestBoundingSpheres(
+	const float3 p0,
+	const float3 p1,
+	const float* cx,
+	const float* cy,
+	const float* cz,
+	const float* rad,
+	unsigned char* mayHit,
+	size_t n
+) {
+	// added to every radius so that float rounding differences between this
+	// and the exact (matrix-transformed) tests can never reject a real hit
+	constexpr float margin = 1.0f;
+
+	const float3 d = p1 - p0;
+	const float dd = d.dot(d);
+	// degenerate (zero-length) segments are tested as a point
+	const float ddInv = (dd > 0.0f)? (1.0f / dd): 0.0f;
+
+	const auto ScalarTest = [&](size_t i) {
+		const float3 e = float3{cx[i], cy[i], cz[i]} - p0;
+		const float3 q = e - d * std::min(std::max(e.dot(d) * ddInv, 0.0f), 1.0f);
+		mayHit[i] = ((q.SqLength() - Square(rad[i] + margin)) <= 0.0f);
+	};
+
+	using SIMDVfloat = xsimd::simd_type<float>;
+
+	// size is adjusted based on SIMD extensions supported
+	constexpr size_t simdSize = SIMDVfloat::size;
+	const size_t vecSize = n - n % simdSize;
+
+	const SIMDVfloat px(p0.x), py(p0.y), pz(p0.z);
+	const SIMDVfloat dx( d.x), dy( d.y), dz( d.z);
+	const SIMDVfloat sdi(ddInv);
+	const SIMDVfloat smg(margin);
+	const SIMDVfloat zero(0.0f);
+	const SIMDVfloat one(1.0f);
+
+	alignas(64) float diff[simdSize];
+
+	for (size_t i = 0; i < vecSize; i += simdSize) {
+		const SIMDVfloat ex = xsimd::load_unaligned(&cx[i]) - px;
+		const SIMDVfloat ey = xsimd::load_unaligned(&cy[i]) - py;
+		const SIMDVfloat ez = xsimd::load_unaligned(&cz[i]) - pz;
+		const SIMDVfloat rm = xsimd::load_unaligned(&rad[i]) + smg;
+
+		// same operation order as the scalar path, no fused multiply-adds
+		const SIMDVfloat t = xsimd::min(xsimd::max((ex * dx + ey * dy + ez * dz) * sdi, zero), one);
+		const SIMDVfloat qx = ex - dx * t;
+		const SIMDVfloat qy = ey - dy * t;
+		const SIMDVfloat qz = ez - dz * t;
+
+		xsimd::store_aligned(&diff[0], (qx * qx + qy * qy + qz * qz) - rm * rm);
+
+		for (size_t j = 0; j < simdSize; ++j) {
+			mayHit[i + j] = (diff[j] <= 0.0f);
+		}
+	}
+
+	for (size_t i = vecSize; i < n; ++i) {
+		ScalarTest(i);
+	}
+}
+
+
 
 bool CCollisionHandler::DetectHit(
 	const CSolidObject* o,
@@ -121,6 +121,24 @@ class CCollisionHandler {
 			CollisionQuery* cq = nullptr
 		);
 
+		/**
+		 * Batched conservative broad-phase for DetectHit: for each of the <n>
+		 * bounding spheres (given as SoA arrays of world-space centers and
+		 * radii) sets mayHit[i] to 0 iff segment p0-p1 can not possibly touch
+		 * it, so the exact tests can be skipped without changing any results.
+		 * Vectorized; the outcome does not depend on SIMD width.
+		 */
+		static void TestBoundingSpheres(
+			const float3 p0,
+			const float3 p1,
+			const float* cx,
+			const float* cy,
+			const float* cz,
+			const float* rad,
+			unsigned char* mayHit,
+			size_t n
+		);
+
 	private:
 		// HITTEST_DISC helpers for DetectHit
 		static bool Collision(
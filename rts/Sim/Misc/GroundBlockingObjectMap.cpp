@@ -22,11 +22,41 @@ CR_BIND(CGroundBlockingObjectMap, )
 CR_REG_METADATA(CGroundBlockingObjectMap, (
 	CR_MEMBER(arrCells),
 	CR_MEMBER(vecCells),
-	CR_MEMBER(vecIndcs)
+	CR_MEMBER(vecIndcs),
+	CR_IGNORED(occupiedBits),
+	CR_IGNORED(numRowWords),
+	CR_POSTLOAD(PostLoad)
 ))
 
 
 
+void CGroundBlockingObjectMap::Init(unsigned int numSquares)
+{
+	arrCells.resize(numSquares);
+	vecCells.reserve(32);
+	vecIndcs.reserve(32);
+
+	// add dummy
+	if (vecCells.empty())
+		vecCells.emplace_back();
+
+	numRowWords = (mapDims.mapx + 63) / 64;
+	occupiedBits.clear();
+	occupiedBits.resize(numRowWords * mapDims.mapy, 0);
+}
+
+void CGroundBlockingObjectMap::PostLoad()
+{
+	numRowWords = (mapDims.mapx + 63) / 64;
+	occupiedBits.clear();
+	occupiedBits.resize(numRowWords * mapDims.mapy, 0);
+
+	for (unsigned int i = 0; i < arrCells.size(); i++) {
+		SetOccupiedBit(i, !arrCells[i].Empty());
+	}
+}
+
+
 void CGroundBlockingObjectMap::AddGroundBlockingObject(CSolidObject* object)
 {
 	if (object->GetBlockMap() != nullptr) {
@@ -125,6 +155,37 @@ CSolidObject* CGroundBlockingObjectMap::GroundBlocked(const float3& pos) const {
 }
 
 
+bool CGroundBlockingObjectMap::RowSamplesEmptyUnsafe(int z, int xmin, int xmax, int xstep) const
+{
+	assert(xstep == 1 || xstep == 2);
+
+	if (xmin > xmax)
+		return true;
+
+	// word bit-positions have the same parity as their squares
+	const uint64_t stepMask = (xstep == 1)? ~uint64_t(0): ((xmin & 1)? 0xAAAAAAAAAAAAAAAAull: 0x5555555555555555ull);
+	const uint64_t* rowWords = &occupiedBits[z * numRowWords];
+
+	const int wmin = xmin >> 6;
+	const int wmax = xmax >> 6;
+
+	for (int w = wmin; w <= wmax; w++) {
+		uint64_t mask = stepMask;
+
+		// clip to [xmin, xmax] in the first and last word
+		if (w == wmin)
+			mask &= (~uint64_t(0) << (xmin & 63));
+		if (w == wmax)
+			mask &= (~uint64_t(0) >> (63 - (xmax & 63)));
+
+		if ((rowWords[w] & mask) != 0)
+			return false;
+	}
+
+	return true;
+}
+
+
 bool CGroundBlockingObjectMap::GroundBlocked(int x, int z, const CSolidObject* ignoreObj) const
 {
 	if (static_cast<unsigned int>(x) >= mapDims.mapx || static_cast<unsigned int>(z) >= mapDims.mapy)
@@ -225,12 +286,24 @@ unsigned int CGroundBlockingObjectMap::CalcChecksum() const
 
 
 
+void CGroundBlockingObjectMap::SetOccupiedBit(unsigned int sqr, bool set) {
+	const unsigned int x = sqr % mapDims.mapx;
+	const unsigned int z = sqr / mapDims.mapx;
+	const uint64_t bit = uint64_t(1) << (x & 63);
+
+	uint64_t& word = occupiedBits[z * numRowWords + (x >> 6)];
+	word = set? (word | bit): (word & ~bit);
+}
+
 bool CGroundBlockingObjectMap::CellInsertUnique(unsigned int sqr, CSolidObject* o) {
 	ArrCell& ac = GetArrCell(sqr);
 	VecCell* vc = nullptr;
 
 	if (ac.Contains(o))
 		return false;
+
+	SetOccupiedBit(sqr, true);
+
 	if (ac.Insert(o))
 		return true;
 
@@ -254,6 +327,8 @@ bool CGroundBlockingObjectMap::CellErase(unsigned int sqr, CSolidObject* o) {
 	VecCell* vc = nullptr;
 
 	if (ac.Erase(o)) {
+		if (ac.Empty())
+			SetOccupiedBit(sqr, false);
 		if (ac.GetVecIndx() == 0)
 			return true;
 
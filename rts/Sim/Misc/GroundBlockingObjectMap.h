@@ -3,7 +3,9 @@
 #ifndef GROUNDBLOCKINGOBJECTMAP_H
 #define GROUNDBLOCKINGOBJECTMAP_H
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <vector>
 
 #include "Sim/Objects/SolidObject.h"
@@ -97,15 +99,7 @@ public:
 	};
 
 
-	void Init(unsigned int numSquares) {
-		arrCells.resize(numSquares);
-		vecCells.reserve(32);
-		vecIndcs.reserve(32);
-
-		// add dummy
-		if (vecCells.empty())
-			vecCells.emplace_back();
-	}
+	void Init(unsigned int numSquares);
 	void Kill() {
 		// reuse inner vectors when reloading
 		// vecCells.clear();
@@ -117,8 +111,11 @@ public:
 		}
 
 		vecIndcs.clear();
+		std::fill(occupiedBits.begin(), occupiedBits.end(), 0);
 	}
 
+	void PostLoad();
+
 	unsigned int CalcChecksum() const;
 
 	void AddGroundBlockingObject(CSolidObject* object);
@@ -147,6 +144,16 @@ public:
 	}
 
 
+	// cheaper than fetching the cell when most squares are empty
+	bool IsOccupiedUnsafe(int x, int z) const {
+		return ((occupiedBits[z * numRowWords + (x >> 6)] >> (x & 63)) & 1);
+	}
+
+	// true if no object is on any of the squares xmin, xmin + xstep, ... <= xmax
+	// in row z (where xstep is 1 or 2); tests 64 squares per word at a time
+	bool RowSamplesEmptyUnsafe(int z, int xmin, int xmax, int xstep) const;
+
+
 	bool GroundBlocked(int x, int z, const CSolidObject* ignoreObj) const;
 	bool GroundBlocked(const float3& pos, const CSolidObject* ignoreObj) const;
 
@@ -179,6 +186,7 @@ private:
 	const VecCell& GetVecCell(unsigned int mapSquare) const { return vecCells[ arrCells[mapSquare].GetVecIndx() ]; }
 	      VecCell& GetVecCell(unsigned int mapSquare)       { return vecCells[ arrCells[mapSquare].GetVecIndx() ]; }
 
+	void SetOccupiedBit(unsigned int sqr, bool set);
 	bool CellInsertUnique(unsigned int sqr, CSolidObject* o);
 	bool CellErase(unsigned int sqr, CSolidObject* o);
 
@@ -186,6 +194,12 @@ private:
 	std::vector<ArrCell> arrCells;
 	std::vector<VecCell> vecCells;
 	std::vector<uint32_t> vecIndcs;
+
+	// one bit per square, set iff its cell is not empty; not saved, rebuilt
+	// from the cells after loading
+	std::vector<uint64_t> occupiedBits;
+
+	unsigned int numRowWords = 0;
 };
 
 extern CGroundBlockingObjectMap groundBlockingObjectMap;
@@ -122,6 +122,8 @@ void ILosType::Kill()
 	losAdd.clear();
 	losDeleted.clear();
 	losRecalc.clear();
+	losDelta.clear();
+	losDeltaSquares.clear();
 
 	// mark as invalid
 	size = {0, 0};
@@ -508,6 +510,8 @@ void ILosType::Update()
 	if (algoType == LOS_ALGO_RAYCAST) {
 		losRecalc.clear();
 		losRecalc.reserve(losUpdate.size());
+		losDelta.clear();
+		losDelta.reserve(losUpdate.size());
 	}
 
 	// filter the updates into their subparts
@@ -524,9 +528,14 @@ void ILosType::Update()
 				losAdd.push_back(li);
 			} break;
 			case SLosInstance::TLosStatus::RECALC: {
-				losRemove.push_back(li);
-				if (algoType == LOS_ALGO_RAYCAST) losRecalc.push_back(li);
-				losAdd.push_back(li);
+				if (algoType == LOS_ALGO_RAYCAST) {
+					// sight is swapped in-place, see below
+					losRecalc.push_back(li);
+					losDelta.push_back(li);
+				} else {
+					losRemove.push_back(li);
+					losAdd.push_back(li);
+				}
 			} break;
 			case SLosInstance::TLosStatus::REMOVE: {
 				losRemove.push_back(li);
@@ -554,6 +563,15 @@ void ILosType::Update()
 
 	// raycast terrain
 	if (algoType == LOS_ALGO_RAYCAST)  {
+		// keep the squares that recalculated instances currently add, they
+		// are only replaced by the difference to the new set of squares
+		if (losDeltaSquares.size() < losDelta.size())
+			losDeltaSquares.resize(losDelta.size());
+
+		for (size_t i = 0; i < losDelta.size(); ++i) {
+			std::swap(losDelta[i]->squares, losDeltaSquares[i]);
+		}
+
 		for_mt(0, losRecalc.size(), [&](const int idx) {
 			auto li = losRecalc[idx];
 			assert(li->refCount > 0);
@@ -568,6 +586,14 @@ void ILosType::Update()
 		LosAdd(li);
 	}
 
+	// swap sight
+	for (size_t i = 0; i < losDelta.size(); ++i) {
+		SLosInstance* li = losDelta[i];
+
+		assert(li->refCount > 0);
+		losMaps[li->allyteam].UpdateRaycast(li, losDeltaSquares[i]);
+	}
+
 	// delete / move to cache unused instances
 	if (algoType == LOS_ALGO_RAYCAST) {
 		while (!losCache.empty() && ((losCache.size() + losDeleted.size()) > CACHE_SIZE)) {
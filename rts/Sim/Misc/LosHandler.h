@@ -61,7 +61,7 @@ public:
 
 	// working data
 	int refCount;
-	struct RLE { int start; unsigned length; };
+	using RLE = SLosRLE;
 	static constexpr RLE EMPTY_RLE = RLE{0,0};
 	std::vector<RLE> squares;
 
@@ -191,6 +191,10 @@ private:
 	std::vector<SLosInstance*> losAdd;
 	std::vector<SLosInstance*> losDeleted;
 	std::vector<SLosInstance*> losRecalc;
+	std::vector<SLosInstance*> losDelta;
+
+	// previous squares of each instance in losDelta (buffers are recycled)
+	std::vector<std::vector<SLosInstance::RLE>> losDeltaSquares;
 
 	static constexpr int CACHE_SIZE = 4096;
 };
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <limits>
 
 #include "LosMap.h"
 #include "LosHandler.h"
@@ -467,6 +468,100 @@ void CLosMap::AddRaycast(SLosInstance* instance, int amount)
 }
 
 
+void CLosMap::UpdateRaycast(SLosInstance* instance, const std::vector<SLosRLE>& prevSquares)
+{
+	const auto& currSquares = instance->squares;
+
+	// an EMPTY_RLE entry marks an instance that sees nothing
+	const size_t numPrev = (prevSquares.empty() || prevSquares[0].length == SLosInstance::EMPTY_RLE.length)? 0: prevSquares.size();
+	const size_t numCurr = (currSquares.empty() || currSquares[0].length == SLosInstance::EMPTY_RLE.length)? 0: currSquares.size();
+
+#ifdef USE_UNSYNCED_HEIGHTMAP
+	const bool visibleInstanceSquares = (instance->allyteam >= 0 && (instance->allyteam == gu->myAllyTeam || gu->spectatingFullView));
+	const bool updateUnsyncedHeightMap = sendReadmapEvents && visibleInstanceSquares;
+#endif
+
+	const auto AddRange = [&](int idxBeg, int idxEnd, int amount) {
+		for (int idx = idxBeg; idx < idxEnd; ++idx) {
+			losmap[idx] += amount;
+
+		#ifdef USE_UNSYNCED_HEIGHTMAP
+			// inform ReadMap when squares enter LoS
+			if (amount < 0 || !updateUnsyncedHeightMap || losmap[idx] != amount)
+				continue;
+
+			const int2 lm = IdxToCoord(idx, size.x);
+			const int2 p1 = (lm             ) * LOS2HEIGHT;
+			const int2 p2 = (lm + int2(1, 1)) * LOS2HEIGHT;
+			const int2 p3 = {std::min(p2.x, mapDims.mapxm1), std::min(p2.y, mapDims.mapym1)};
+
+			readMap->UpdateLOS(SRectangle(p1.x, p1.y,  p3.x, p3.y));
+		#endif
+		}
+	};
+
+	// both run-lists are sorted by start index and non-overlapping; sweep
+	// them in lockstep and only touch squares that are in exactly one list
+	// (a terrain change inside the radius usually flips just a few squares)
+	constexpr int END = std::numeric_limits<int>::max();
+
+	size_t pi = 0;
+	size_t ci = 0;
+
+	int pBeg = (numPrev > 0)? prevSquares[0].start: END, pEnd = (numPrev > 0)? (pBeg + prevSquares[0].length): END;
+	int cBeg = (numCurr > 0)? currSquares[0].start: END, cEnd = (numCurr > 0)? (cBeg + currSquares[0].length): END;
+
+	const auto NextPrev = [&]() {
+		if ((++pi) < numPrev) {
+			pEnd = (pBeg = prevSquares[pi].start) + prevSquares[pi].length;
+		} else {
+			pBeg = pEnd = END;
+		}
+	};
+	const auto NextCurr = [&]() {
+		if ((++ci) < numCurr) {
+			cEnd = (cBeg = currSquares[ci].start) + currSquares[ci].length;
+		} else {
+			cBeg = cEnd = END;
+		}
+	};
+
+	while (pBeg != END || cBeg != END) {
+		if (pBeg < cBeg) {
+			// squares no longer visible
+			const int e = std::min(pEnd, cBeg);
+
+			AddRange(pBeg, e, -1);
+
+			if ((pBeg = e) == pEnd)
+				NextPrev();
+
+			continue;
+		}
+
+		if (cBeg < pBeg) {
+			// squares that became visible
+			const int e = std::min(cEnd, pBeg);
+
+			AddRange(cBeg, e, 1);
+
+			if ((cBeg = e) == cEnd)
+				NextCurr();
+
+			continue;
+		}
+
+		// common range, no change
+		const int e = std::min(pEnd, cEnd);
+
+		if ((pBeg = e) == pEnd)
+			NextPrev();
+		if ((cBeg = e) == cEnd)
+			NextCurr();
+	}
+}
+
+
 void CLosMap::PrepareRaycast(SLosInstance* instance) const
 {
 	if (!instance->squares.empty())
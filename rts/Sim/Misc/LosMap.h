@@ -12,6 +12,9 @@
 
 struct SLosInstance;
 
+/// run of consecutive (by index) squares seen by an SLosInstance
+struct SLosRLE { int start; unsigned length; };
+
 
 /// map containing counts of how many units have Line Of Sight (LOS) to each square
 class CLosMap
@@ -43,6 +46,10 @@ public:
 	/// arbitrary area, for losMap, non-circular radar maps, ...
 	void PrepareRaycast(SLosInstance* instance) const;
 
+	/// replaces an instance's previously added squares by its (recalculated) current ones,
+	/// only touching squares that actually changed visibility
+	void UpdateRaycast(SLosInstance* instance, const std::vector<SLosRLE>& prevSquares);
+
 public:
 	int At(int2 p) const {
 		p.x = Clamp(p.x, 0, size.x - 1);
@@ -99,6 +99,15 @@ void CModInfo::ResetState()
 		pfUpdateRate     = 0.007f;
 
 		allowTake = true;
+
+		mtUnitUpdate = false;
+		mtProjectileQuadUpdate = false;
+		qtpfsAsyncSearches = false;
+		mtCobUpdate = false;
+		mtScriptAnimUpdate = false;
+		mtAirCollisionChecks = false;
+
+		quadFieldQuadSizeInElmos = 0;
 	}
 }
 
@@ -138,6 +147,15 @@ void CModInfo::Init(const std::string& modFileName)
 		pfUpdateRate = system.GetFloat("pathFinderUpdateRate", pfUpdateRate);
 
 		allowTake = system.GetBool("allowTake", allowTake);
+
+		mtUnitUpdate = system.GetBool("multiThreadedUnitUpdate", mtUnitUpdate);
+		mtProjectileQuadUpdate = system.GetBool("multiThreadedProjectileQuadUpdate", mtProjectileQuadUpdate);
+		qtpfsAsyncSearches = system.GetBool("qtpfsAsyncSearches", qtpfsAsyncSearches);
+		mtCobUpdate = system.GetBool("multiThreadedCobUpdate", mtCobUpdate);
+		mtScriptAnimUpdate = system.GetBool("multiThreadedScriptAnimUpdate", mtScriptAnimUpdate);
+		mtAirCollisionChecks = system.GetBool("multiThreadedAirCollisionChecks", mtAirCollisionChecks);
+
+		quadFieldQuadSizeInElmos = std::max(0, system.GetInt("quadFieldQuadSizeInElmos", quadFieldQuadSizeInElmos));
 	}
 
 	{
@@ -169,6 +169,22 @@ public:
 	float pfUpdateRate;
 
 	bool allowTake;
+
+	/// split CUnitHandler::UpdateUnits into a parallel compute and a serial commit phase
+	bool mtUnitUpdate;
+	/// defer synced projectile quadfield moves to a batched parallel pass
+	bool mtProjectileQuadUpdate;
+	/// run QTPFS searches on a pool thread while the rest of the sim frame executes
+	bool qtpfsAsyncSearches;
+	/// tick COB threads which can not reach beyond their own unit in parallel
+	bool mtCobUpdate;
+	/// advance unit-script piece animations in parallel before notifying listeners
+	bool mtScriptAnimUpdate;
+	/// run the aircraft collision-avoidance searches of a frame in parallel before the move-type updates
+	bool mtAirCollisionChecks;
+
+	/// edge length of the quadfield cells, 0 lets the engine choose from the map size
+	int quadFieldQuadSizeInElmos;
 };
 
 extern CModInfo modInfo;
@@ -30,7 +30,9 @@ CR_REG_METADATA(CQuadField, (
 	CR_IGNORED(tempFeatures),
 	CR_IGNORED(tempProjectiles),
 	CR_IGNORED(tempSolids),
-	CR_IGNORED(tempQuads)
+	CR_IGNORED(tempQuads),
+	CR_IGNORED(unitsVersion),
+	CR_IGNORED(featuresVersion)
 ))
 
 CR_BIND(CQuadField::Quad, )
@@ -106,6 +108,28 @@ void CQuadField::Quad::PostLoad()
 #endif
 }
 
+int CQuadField::CalcQuadSize(int2 mapDims, int quadSize)
+{
+	const int mapSizeX = mapDims.x * SQUARE_SIZE;
+	const int mapSizeZ = mapDims.y * SQUARE_SIZE;
+
+	int size = Clamp((quadSize > 0)? quadSize: int(BASE_QUAD_SIZE), SQUARE_SIZE, int(MAX_QUAD_SIZE));
+
+	// round down to a power of two
+	while ((size & (size - 1)) != 0)
+		size &= (size - 1);
+
+	if (quadSize <= 0) {
+		while (size < int(MAX_QUAD_SIZE) && (mapSizeX / size) * (mapSizeZ / size) > int(MAX_AUTO_QUADS))
+			size <<= 1;
+	}
+
+	while (size > SQUARE_SIZE && ((mapSizeX % size) != 0 || (mapSizeZ % size) != 0))
+		size >>= 1;
+
+	return size;
+}
+
 void CQuadField::Init(int2 mapDims, int quadSize)
 {
 	quadSizeX = quadSize;
@@ -144,6 +168,9 @@ void CQuadField::Kill()
 	tempProjectiles.ReleaseAll();
 	tempSolids.ReleaseAll();
 	tempQuads.ReleaseAll();
+
+	unitsVersion += 1;
+	featuresVersion += 1;
 }
 
 
@@ -162,7 +189,6 @@ int CQuadField::WorldPosToQuadFieldIdx(const float3 p) const
 }
 
 
-#ifndef UNIT_TEST
 void CQuadField::GetQuads(QuadFieldQuery& qfq, float3 pos, float radius)
 {
 	pos.AssertNaNs();
@@ -215,7 +241,6 @@ void CQuadField::GetQuadsRectangle(QuadFieldQuery& qfq, const float3& mins, cons
 
 	return;
 }
-#endif // UNIT_TEST
 
 
 /// note: this function got an UnitTest, check the tests/ folder!
@@ -270,7 +295,7 @@ void CQuadField::GetQuadsOnRay(QuadFieldQuery& qfq, const float3& start, const f
 	const int startZ = Clamp<int>(startZuc, 0, numQuadsZ - 1);
 	const int finalZ = Clamp<int>(finalZuc, 0, numQuadsZ - 1);
 
-	assert(finalZ < quadSizeZ);
+	assert(finalZ < numQuadsZ);
 
 	const float invDirZ = 1.0f / dir.z;
 
@@ -324,6 +349,8 @@ bool CQuadField::InsertUnitIf(CUnit* unit, const float3& wpos)
 
 	spring::VectorInsertUnique(baseQuads[wposQuadIdx].units, unit, false);
 	spring::VectorInsertUnique(baseQuads[wposQuadIdx].teamUnits[unit->allyteam], unit, false);
+
+	unitsVersion += 1;
 	return true;
 }
 
@@ -354,6 +381,8 @@ bool CQuadField::RemoveUnitIf(CUnit* unit, const float3& wpos)
 
 	spring::VectorErase(baseQuads[wposQuadIdx].units, unit);
 	spring::VectorErase(baseQuads[wposQuadIdx].teamUnits[unit->allyteam], unit);
+
+	unitsVersion += 1;
 	return true;
 }
 #endif
@@ -383,6 +412,7 @@ void CQuadField::MovedUnit(CUnit* unit)
 	}
 
 	unit->quads = std::move(*qfQuery.quads);
+	unitsVersion += 1;
 }
 
 void CQuadField::RemoveUnit(CUnit* unit)
@@ -393,6 +423,7 @@ void CQuadField::RemoveUnit(CUnit* unit)
 	}
 
 	unit->quads.clear();
+	unitsVersion += 1;
 
 	#ifdef DEBUG_QUADFIELD
 	for (const Quad& q: baseQuads) {
@@ -456,6 +487,8 @@ void CQuadField::AddFeature(CFeature* feature)
 	for (const int qi: *qfQuery.quads) {
 		spring::VectorInsertUnique(baseQuads[qi].features, feature, false);
 	}
+
+	featuresVersion += 1;
 }
 
 void CQuadField::RemoveFeature(CFeature* feature)
@@ -467,6 +500,8 @@ void CQuadField::RemoveFeature(CFeature* feature)
 		spring::VectorErase(baseQuads[qi].features, feature);
 	}
 
+	featuresVersion += 1;
+
 	#ifdef DEBUG_QUADFIELD
 	for (const Quad& q: baseQuads) {
 		for (CFeature* f: q.features) {
@@ -480,17 +515,22 @@ void CQuadField::RemoveFeature(CFeature* feature)
 
 void CQuadField::MovedProjectile(CProjectile* p)
 {
-	if (!p->synced)
+	if (!ProjectileChangedQuad(p))
 		return;
+
+	RemoveProjectile(p);
+	AddProjectile(p);
+}
+
+bool CQuadField::ProjectileChangedQuad(const CProjectile* p) const
+{
+	if (!p->synced)
+		return false;
 	// hit-scan projectiles do NOT move!
 	if (p->hitscan)
-		return;
+		return false;
 
-	const int newQuad = WorldPosToQuadFieldIdx(p->pos);
-	if (newQuad != p->quads.back()) {
-		RemoveProjectile(p);
-		AddProjectile(p);
-	}
+	return (WorldPosToQuadFieldIdx(p->pos) != p->quads.back());
 }
 
 void CQuadField::AddProjectile(CProjectile* p)
@@ -558,11 +598,6 @@ void CQuadField::GetUnitsExact(QuadFieldQuery& qfq, const float3& pos, float rad
 
 	for (const int qi: *qfQuery.quads) {
 		for (CUnit* u: baseQuads[qi].units) {
-			if (u->tempNum == tempNum)
-				continue;
-
-			u->tempNum = tempNum;
-
 			const float totRad       = radius + u->radius;
 			const float totRadSq     = totRad * totRad;
 			const float posUnitDstSq = spherical?
@@ -572,6 +607,12 @@ void CQuadField::GetUnitsExact(QuadFieldQuery& qfq, const float3& pos, float rad
 			if (posUnitDstSq >= totRadSq)
 				continue;
 
+			// mark only accepted units so the (many) rejected ones are never
+			// written to; the tests do not depend on the quad being visited
+			if (u->tempNum == tempNum)
+				continue;
+
+			u->tempNum = tempNum;
 			qfq.units->push_back(u);
 		}
 	}
@@ -589,17 +630,16 @@ void CQuadField::GetUnitsExact(QuadFieldQuery& qfq, const float3& mins, const fl
 	for (const int qi: *qfQuery.quads) {
 		for (CUnit* unit: baseQuads[qi].units) {
 
-			if (unit->tempNum == tempNum)
-				continue;
-
-			unit->tempNum = tempNum;
-
 			const float3& pos = unit->pos;
 			if (pos.x < mins.x || pos.x > maxs.x)
 				continue;
 			if (pos.z < mins.z || pos.z > maxs.z)
 				continue;
 
+			if (unit->tempNum == tempNum)
+				continue;
+
+			unit->tempNum = tempNum;
 			qfq.units->push_back(unit);
 		}
 	}
@@ -617,11 +657,6 @@ void CQuadField::GetFeaturesExact(QuadFieldQuery& qfq, const float3& pos, float
 
 	for (const int qi: *qfQuery.quads) {
 		for (CFeature* f: baseQuads[qi].features) {
-			if (f->tempNum == tempNum)
-				continue;
-
-			f->tempNum = tempNum;
-
 			const float totRad       = radius + f->radius;
 			const float totRadSq     = totRad * totRad;
 			const float posDstSq = spherical?
@@ -631,6 +666,10 @@ void CQuadField::GetFeaturesExact(QuadFieldQuery& qfq, const float3& pos, float
 			if (posDstSq >= totRadSq)
 				continue;
 
+			if (f->tempNum == tempNum)
+				continue;
+
+			f->tempNum = tempNum;
 			qfq.features->push_back(f);
 		}
 	}
@@ -647,17 +686,16 @@ void CQuadField::GetFeaturesExact(QuadFieldQuery& qfq, const float3& mins, const
 
 	for (const int qi: *qfQuery.quads) {
 		for (CFeature* feature: baseQuads[qi].features) {
-			if (feature->tempNum == tempNum)
-				continue;
-
-			feature->tempNum = tempNum;
-
 			const float3& pos = feature->pos;
 			if (pos.x < mins.x || pos.x > maxs.x)
 				continue;
 			if (pos.z < mins.z || pos.z > maxs.z)
 				continue;
 
+			if (feature->tempNum == tempNum)
+				continue;
+
+			feature->tempNum = tempNum;
 			qfq.features->push_back(feature);
 		}
 	}
@@ -676,14 +714,13 @@ void CQuadField::GetProjectilesExact(QuadFieldQuery& qfq, const float3& pos, flo
 
 	for (const int qi: *qfQuery.quads) {
 		for (CProjectile* p: baseQuads[qi].projectiles) {
-			if (p->tempNum == tempNum)
+			if (pos.SqDistance(p->pos) >= Square(radius + p->radius))
 				continue;
 
-			p->tempNum = tempNum;
-
-			if (pos.SqDistance(p->pos) >= Square(radius + p->radius))
+			if (p->tempNum == tempNum)
 				continue;
 
+			p->tempNum = tempNum;
 			qfq.projectiles->push_back(p);
 		}
 	}
@@ -700,17 +737,16 @@ void CQuadField::GetProjectilesExact(QuadFieldQuery& qfq, const float3& mins, co
 
 	for (const int qi: *qfQuery.quads) {
 		for (CProjectile* p: baseQuads[qi].projectiles) {
-			if (p->tempNum == tempNum)
-				continue;
-
-			p->tempNum = tempNum;
-
 			const float3& pos = p->pos;
 			if (pos.x < mins.x || pos.x > maxs.x)
 				continue;
 			if (pos.z < mins.z || pos.z > maxs.z)
 				continue;
 
+			if (p->tempNum == tempNum)
+				continue;
+
+			p->tempNum = tempNum;
 			qfq.projectiles->push_back(p);
 		}
 	}
@@ -734,11 +770,6 @@ void CQuadField::GetSolidsExact(
 
 	for (const int qi: *qfQuery.quads) {
 		for (CUnit* u: baseQuads[qi].units) {
-			if (u->tempNum == tempNum)
-				continue;
-
-			u->tempNum = tempNum;
-
 			if (!u->HasPhysicalStateBit(physicalStateBits))
 				continue;
 			if (!u->HasCollidableStateBit(collisionStateBits))
@@ -746,15 +777,14 @@ void CQuadField::GetSolidsExact(
 			if ((pos - u->pos).SqLength() >= Square(radius + u->radius))
 				continue;
 
+			if (u->tempNum == tempNum)
+				continue;
+
+			u->tempNum = tempNum;
 			qfq.solids->push_back(u);
 		}
 
 		for (CFeature* f: baseQuads[qi].features) {
-			if (f->tempNum == tempNum)
-				continue;
-
-			f->tempNum = tempNum;
-
 			if (!f->HasPhysicalStateBit(physicalStateBits))
 				continue;
 			if (!f->HasCollidableStateBit(collisionStateBits))
@@ -762,6 +792,10 @@ void CQuadField::GetSolidsExact(
 			if ((pos - f->pos).SqLength() >= Square(radius + f->radius))
 				continue;
 
+			if (f->tempNum == tempNum)
+				continue;
+
+			f->tempNum = tempNum;
 			qfq.solids->push_back(f);
 		}
 	}
@@ -89,6 +89,13 @@ public:
 	static void Resize(int quadSize);
 	*/
 
+	/**
+	 * @return the cell size to use for a map of <mapDims> heightmap squares,
+	 *   given a requested size of <quadSize> elmos (0 picks the default); the
+	 *   result is a power of two that divides the map in both dimensions
+	 */
+	static int CalcQuadSize(int2 mapDims, int quadSize);
+
 	void Init(int2 mapDims, int quadSize);
 	void Kill();
 
@@ -161,6 +168,8 @@ public:
 	void RemoveFeature(CFeature* feature);
 
 	void MovedProjectile(CProjectile* projectile);
+	/// read-only part of MovedProjectile, can be called concurrently
+	bool ProjectileChangedQuad(const CProjectile* projectile) const;
 	void AddProjectile(CProjectile* projectile);
 	void RemoveProjectile(CProjectile* projectile);
 
@@ -223,6 +232,11 @@ public:
 	}
 
 
+	/// changes whenever any unit is added to or removed from any quad
+	unsigned int GetUnitsVersion() const { return unitsVersion; }
+	/// changes whenever any feature is added to or removed from the quadfield
+	unsigned int GetFeaturesVersion() const { return featuresVersion; }
+
 	int GetNumQuadsX() const { return numQuadsX; }
 	int GetNumQuadsZ() const { return numQuadsZ; }
 
@@ -230,6 +244,9 @@ public:
 	int GetQuadSizeZ() const { return quadSizeZ; }
 
 	constexpr static unsigned int BASE_QUAD_SIZE = 128;
+	constexpr static unsigned int  MAX_QUAD_SIZE = 1024;
+	// default cells grow on huge maps until there are at most this many
+	constexpr static unsigned int MAX_AUTO_QUADS = 256 * 256;
 
 private:
 	int2 WorldPosToQuadField(const float3 p) const;
@@ -252,6 +269,9 @@ private:
 
 	int quadSizeX;
 	int quadSizeZ;
+
+	unsigned int unitsVersion = 0;
+	unsigned int featuresVersion = 0;
 };
 
 extern CQuadField quadField;
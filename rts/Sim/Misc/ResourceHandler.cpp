@@ -93,6 +93,14 @@ const unsigned char* CResourceHandler::GetResourceMap(int resourceId) const
 	return nullptr;
 }
 
+unsigned int CResourceHandler::GetResourceMapVersion(int resourceId) const
+{
+	if (resourceId == GetMetalId())
+		return (metalMap.GetDistributionVersion());
+
+	return 0;
+}
+
 size_t CResourceHandler::GetResourceMapSize(int resourceId) const
 {
 	if (resourceId == GetMetalId())
@@ -124,7 +132,8 @@ const CResourceMapAnalyzer* CResourceHandler::GetResourceMapAnalyzer(int resourc
 
 	CResourceMapAnalyzer* rma = &resourceMapAnalyzers[resourceId];
 
-	if (rma->GetNumSpots() < 0)
+	// reanalyze lazily once the map was changed, e.g. by Lua
+	if (rma->GetNumSpots() < 0 || rma->GetResourceMapVersion() != GetResourceMapVersion(resourceId))
 		rma->Init();
 
 	return rma;
@@ -71,6 +71,12 @@ public:
 	 * Returns a resource map by index.
 	 */
 	const unsigned char* GetResourceMap(int resourceId) const;
+	/**
+	 * @brief	resource map version
+	 * @param	resourceId index of the resource whichs map version to fetch
+	 * @return	a counter which changes whenever the resource map is modified
+	 */
+	unsigned int GetResourceMapVersion(int resourceId) const;
 	/**
 	 * @brief	resource map size
 	 * @param	resourceId index of the resource whichs map size to fetch
@@ -22,7 +22,9 @@ using std::fclose;
 #include "System/FileSystem/FileQueryFlags.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/Log/ILog.h"
+#include "System/Threading/ThreadPool.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 static constexpr float3 ERRORVECTOR(-1, 0, 0);
@@ -32,6 +34,8 @@ CResourceMapAnalyzer::CResourceMapAnalyzer(int resourceId)
 	: resourceId(resourceId)
 	, numSpotsFound(-1)
 
+	, resourceMapVersion(0)
+
 	, extractorRadius(-1.0f)
 	, averageIncome(0.0f)
 
@@ -130,6 +134,21 @@ void CResourceMapAnalyzer::Init() {
 
 	tempAverage.resize(totalCells);
 
+	// start over if the map changed since the last analysis
+	vectoredSpots.clear();
+
+	numSpotsFound = -1;
+	resourceMapVersion = resourceHandler->GetResourceMapVersion(resourceId);
+
+	maxResource = 0;
+	stopMe = false;
+
+	// the cache only describes the map as loaded
+	if (resourceMapVersion != 0) {
+		GetResourcePoints();
+		return;
+	}
+
 	// if there's no available load file, create one and save it
 	if (!LoadResourceMap()) {
 		GetResourcePoints();
@@ -142,6 +161,43 @@ float CResourceMapAnalyzer::GetAverageIncome() const {
 }
 
 
+void CResourceMapAnalyzer::CalcRowResources(int y, const std::vector<int>& xend) {
+	int rowResources = 0;
+
+	// first spot of each row needs full calculation
+	for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
+		if (sy >= 0 && sy < mapHeight) {
+			for (int sx = -xend[a]; sx <= xend[a]; sx++) {
+				if (sx >= 0 && sx < mapWidth) {
+					// get the resources from all pixels around the extractor radius
+					rowResources += rexArrayA[sy * mapWidth + sx];
+				}
+			}
+		}
+	}
+
+	tempAverage[y * mapWidth] = rowResources;
+
+	// the others only add and remove the leading and trailing columns
+	for (int x = 1; x < mapWidth; x++) {
+		for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
+			if (sy >= 0 && sy < mapHeight) {
+				const int addX = x + xend[a];
+				const int remX = x - xend[a] - 1;
+
+				if (addX < mapWidth) {
+					rowResources += rexArrayA[sy * mapWidth + addX];
+				}
+				if (remX >= 0) {
+					rowResources -= rexArrayA[sy * mapWidth + remX];
+				}
+			}
+		}
+
+		tempAverage[y * mapWidth + x] = rowResources;
+	}
+}
+
 void CResourceMapAnalyzer::GetResourcePoints() {
 	std::vector<int> xend(doubleRadius + 1);
 
@@ -170,79 +226,15 @@ void CResourceMapAnalyzer::GetResourcePoints() {
 		return;
 
 	// Now work out how much resources each spot can make
-	// by adding up the resources from nearby spots
-	for (int y = 0; y < mapHeight; y++) {
-		for (int x = 0; x < mapWidth; x++) {
-			totalResources = 0;
-
-			// first spot needs full calculation
-			if (x == 0 && y == 0)
-				for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
-					if (sy >= 0 && sy < mapHeight){
-						for (int sx = x - xend[a]; sx <= x + xend[a]; sx++) {
-							if (sx >= 0 && sx < mapWidth) {
-								// get the resources from all pixels around the extractor radius
-								totalResources += rexArrayA[sy * mapWidth + sx];
-							}
-						}
-					}
-				}
-
-			// quick calc test
-			if (x > 0) {
-				totalResources = tempAverage[y * mapWidth + x - 1];
-				for (int sy = y - xtractorRadius, a = 0;  sy <= y + xtractorRadius;  sy++, a++) {
-					if (sy >= 0 && sy < mapHeight) {
-						const int addX = x + xend[a];
-						const int remX = x - xend[a] - 1;
-
-						if (addX < mapWidth) {
-							totalResources += rexArrayA[sy * mapWidth + addX];
-						}
-						if (remX >= 0) {
-							totalResources -= rexArrayA[sy * mapWidth + remX];
-						}
-					}
-				}
-			} else if (y > 0) {
-				// x == 0 here
-				totalResources = tempAverage[(y - 1) * mapWidth];
-				// remove the top half
-				int a = xtractorRadius;
-
-				for (int sx = 0; sx <= xtractorRadius;  sx++, a++) {
-					if (sx < mapWidth) {
-						const int remY = y - xend[a] - 1;
-
-						if (remY >= 0) {
-							totalResources -= rexArrayA[remY * mapWidth + sx];
-						}
-					}
-				}
-
-				// add the bottom half
-				a = xtractorRadius;
-
-				for (int sx = 0; sx <= xtractorRadius;  sx++, a++) {
-					if (sx < mapWidth) {
-						const int addY = y + xend[a];
-
-						if (addY < mapHeight) {
-							totalResources += rexArrayA[addY * mapWidth + sx];
-						}
-					}
-				}
-			}
-
-			// set that spot's resource making ability
-			// (divide by cells to values are small)
-			tempAverage[y * mapWidth + x] = totalResources;
+	// by adding up the resources from nearby spots; rows
+	// are independent so they can be summed in parallel
+	for_mt(0, mapHeight, [&](const int y) {
+		CalcRowResources(y, xend);
+	});
 
-			if (maxResource < totalResources) {
-				// find the spot with the highest resource value to set as the map's max
-				maxResource = totalResources;
-			}
-		}
+	for (int i = 0; i < totalCells; i++) {
+		// find the spot with the highest resource value to set as the map's max
+		maxResource = std::max(maxResource, tempAverage[i]);
 	}
 
 	// make a list for the distribution of values
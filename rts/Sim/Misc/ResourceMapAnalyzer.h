@@ -31,8 +31,11 @@ public:
 
 	// equal to vectoredSpots.size() after Init, otherwise -1
 	int GetNumSpots() const { return numSpotsFound; }
+	// version of the resource map the spots were computed from
+	unsigned int GetResourceMapVersion() const { return resourceMapVersion; }
 
 private:
+	void CalcRowResources(int y, const std::vector<int>& xend);
 	void GetResourcePoints();
 	void SaveResourceMap();
 	bool LoadResourceMap();
@@ -42,6 +45,8 @@ private:
 	int resourceId;
 	int numSpotsFound;
 
+	unsigned int resourceMapVersion;
+
 	float extractorRadius;
 	float averageIncome;
 
@@ -145,26 +145,40 @@ inline static void FindRadialMaximum(
 	int winSize,
 	float resolution,
 	const std::vector<float>& colsMaxima,
-	      std::vector<float>& mesh
+	      std::vector<float>& mesh,
+	      std::vector<int>& windowCols
 ) {
 	const float cury = y * resolution;
 
-	for (int x = 0; x < maxx; ++x) {
-		float maxRowHeight = -std::numeric_limits<float>::max();
+	// sliding-window maximum over the column maxima; <windowCols> holds the
+	// indices of a strictly decreasing run of maxima, its front is the max
+	size_t head = 0;
+	size_t tail = 0;
+
+	int nextx = 0;
 
+	for (int x = 0; x < maxx; ++x) {
 		// find current maximum within radius smoothRadius
 		// (in every column stack) along the current row
 		const int startx = std::max(x - winSize, 0);
 		const int endx = std::min(maxx - 1, x + winSize);
 
-		for (int i = startx; i <= endx; ++i) {
-			assert(i >= 0);
-			assert(i <= maxx);
-			assert(CGround::GetHeightReal(i * resolution, cury) <= colsMaxima[i]);
+		for (; nextx <= endx; ++nextx) {
+			assert(CGround::GetHeightReal(nextx * resolution, cury) <= colsMaxima[nextx]);
+
+			while (tail > head && colsMaxima[windowCols[tail - 1]] <= colsMaxima[nextx])
+				tail--;
 
-			maxRowHeight = std::max(colsMaxima[i], maxRowHeight);
+			windowCols[tail++] = nextx;
 		}
 
+		while (windowCols[head] < startx)
+			head++;
+
+		assert(tail > head);
+
+		const float maxRowHeight = colsMaxima[windowCols[head]];
+
 #ifndef NDEBUG
 		const float curx = x * resolution;
 		assert(maxRowHeight <= readMap->GetCurrMaxHeight());
@@ -405,11 +419,13 @@ void SmoothHeightMesh::MakeSmoothMesh()
 	maximaRows.clear();
 	maximaRows.resize(maxx + 1, -1);
 
+	std::vector<int> windowCols(maxx + 1, 0);
+
 	FindMaximumColumnHeights(maxx, maxy, winSize, resolution, colsMaxima, maximaRows);
 
 	for (int y = 0; y <= maxy; ++y) {
 		AdvanceMaximaRows(y, maxx, resolution, colsMaxima, maximaRows);
-		FindRadialMaximum(y, maxx, winSize, resolution, colsMaxima, mesh);
+		FindRadialMaximum(y, maxx, winSize, resolution, colsMaxima, mesh, windowCols);
 		FixRemainingMaxima(y, maxx, maxy, winSize, resolution, colsMaxima, maximaRows);
 
 #ifdef _DEBUG
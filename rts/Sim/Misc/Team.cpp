@@ -302,7 +302,7 @@ void CTeam::ResetResourceState()
 	resPrevReceived.energy = resReceived.energy; resReceived.energy = 0.0f;
 }
 
-void CTeam::SlowUpdate()
+void CTeam::SlowUpdate(const std::vector<int>& allyTeamMembers)
 {
 	TeamStatistics& currentStats = GetCurrentStats();
 
@@ -312,16 +312,14 @@ void CTeam::SlowUpdate()
 	// calculate the total amount of resources that all
 	// (allied) teams can collectively receive through
 	// sharing
-	for (int a = 0; a < teamHandler.ActiveTeams(); ++a) {
-		CTeam* team = teamHandler.Team(a);
+	for (const int a: allyTeamMembers) {
+		const CTeam* team = teamHandler.Team(a);
 
-		if ((a != teamNum) && (teamHandler.AllyTeam(teamNum) == teamHandler.AllyTeam(a))) {
-			if (team->isDead)
-				continue;
+		if (a == teamNum || team->isDead)
+			continue;
 
-			eShare += std::max(0.0f, (team->resStorage.energy * 0.99f) - team->res.energy);
-			mShare += std::max(0.0f, (team->resStorage.metal  * 0.99f) - team->res.metal);
-		}
+		eShare += std::max(0.0f, (team->resStorage.energy * 0.99f) - team->res.energy);
+		mShare += std::max(0.0f, (team->resStorage.metal  * 0.99f) - team->res.metal);
 	}
 
 	currentStats.metalProduced  += resPrevIncome.metal;
@@ -343,27 +341,26 @@ void CTeam::SlowUpdate()
 	if (mShare > 0.0f) { dm = std::min(1.0f, mExcess / mShare); }
 
 	// now evenly distribute our excess resources among allied teams
-	for (int a = 0; a < teamHandler.ActiveTeams(); ++a) {
-		if ((a != teamNum) && (teamHandler.AllyTeam(teamNum) == teamHandler.AllyTeam(a))) {
-			CTeam* team = teamHandler.Team(a);
-			if (team->isDead)
-				continue;
-
-			//due to precision errors mdif/edif sometimes can be slightly >= than res. If team has no metal income
-			//this causes units with zero fire resources requirements to be unable to fire
-			//when CTeam::HaveResources() is evaluated, thus clamp edif / mdif on both sides
-
-			const float edif = std::clamp(((team->resStorage.energy * 0.99f) - team->res.energy) * de, 0.0f, res.energy);
-			const float mdif = std::clamp(((team->resStorage.metal  * 0.99f) - team->res.metal ) * dm, 0.0f, res.metal );
-
-			res.energy     -= edif; team->res.energy         += edif;
-			resSent.energy += edif; team->resReceived.energy += edif;
-			res.metal      -= mdif; team->res.metal          += mdif;
-			resSent.metal  += mdif; team->resReceived.metal  += mdif;
-
-			currentStats.energySent += edif; team->GetCurrentStats().energyReceived += edif;
-			currentStats.metalSent  += mdif; team->GetCurrentStats().metalReceived  += mdif;
-		}
+	for (const int a: allyTeamMembers) {
+		CTeam* team = teamHandler.Team(a);
+
+		if (a == teamNum || team->isDead)
+			continue;
+
+		//due to precision errors mdif/edif sometimes can be slightly >= than res. If team has no metal income
+		//this causes units with zero fire resources requirements to be unable to fire
+		//when CTeam::HaveResources() is evaluated, thus clamp edif / mdif on both sides
+
+		const float edif = std::clamp(((team->resStorage.energy * 0.99f) - team->res.energy) * de, 0.0f, res.energy);
+		const float mdif = std::clamp(((team->resStorage.metal  * 0.99f) - team->res.metal ) * dm, 0.0f, res.metal );
+
+		res.energy     -= edif; team->res.energy         += edif;
+		resSent.energy += edif; team->resReceived.energy += edif;
+		res.metal      -= mdif; team->res.metal          += mdif;
+		resSent.metal  += mdif; team->resReceived.metal  += mdif;
+
+		currentStats.energySent += edif; team->GetCurrentStats().energyReceived += edif;
+		currentStats.metalSent  += mdif; team->GetCurrentStats().metalReceived  += mdif;
 	}
 
 	// clamp resource levels to storage capacity
@@ -23,7 +23,8 @@ public:
 	CTeam();
 
 	void ResetResourceState();
-	void SlowUpdate();
+	/// @param allyTeamMembers all teams (including this one) in our allyteam, in ascending order
+	void SlowUpdate(const std::vector<int>& allyTeamMembers);
 
 	bool HaveResources(const SResourcePack& amount) const;
 	void AddResources(SResourcePack res, bool useIncomeMultiplier = true);
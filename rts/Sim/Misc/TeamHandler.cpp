@@ -15,7 +15,8 @@ CR_REG_METADATA(CTeamHandler, (
 	CR_MEMBER(gaiaTeamID),
 	CR_MEMBER(gaiaAllyTeamID),
 	CR_MEMBER(teams),
-	CR_MEMBER(allyTeams)
+	CR_MEMBER(allyTeams),
+	CR_IGNORED(allyTeamMembers)
 ))
 
 
@@ -114,11 +115,24 @@ void CTeamHandler::GameFrame(int frameNum)
 	if ((frameNum % TEAM_SLOWUPDATE_RATE) != 0)
 		return;
 
+	// resources are only shared within an allyteam; grouping the teams
+	// up front saves every team a scan over all others (which dominates
+	// in large FFA games) while keeping the order the teams are visited
+	allyTeamMembers.resize(allyTeams.size());
+
+	for (std::vector<int>& members: allyTeamMembers) {
+		members.clear();
+	}
+
+	for (int a = 0; a < ActiveTeams(); ++a) {
+		allyTeamMembers[AllyTeam(a)].push_back(a);
+	}
+
 	for (int a = 0; a < ActiveTeams(); ++a) {
 		teams[a].ResetResourceState();
 	}
 	for (int a = 0; a < ActiveTeams(); ++a) {
-		teams[a].SlowUpdate();
+		teams[a].SlowUpdate(allyTeamMembers[AllyTeam(a)]);
 	}
 }
 
@@ -164,6 +164,9 @@ private:
 	 */
 	std::vector<CTeam> teams;
 	std::vector< ::AllyTeam > allyTeams;
+
+	// teams of each allyteam in ascending order, rebuilt by GameFrame
+	std::vector< std::vector<int> > allyTeamMembers;
 };
 
 extern CTeamHandler teamHandler;
@@ -5,6 +5,7 @@
 #include "Game/GlobalUnsynced.h"
 #include "Map/Ground.h"
 #include "Map/MapInfo.h"
+#include "Map/ReadMap.h"
 #include "Rendering/Env/Particles/Classes/SmokeProjectile.h"
 #include "Sim/Misc/QuadField.h"
 #include "Sim/Misc/SmoothHeightMesh.h"
@@ -14,6 +15,7 @@
 #include "Sim/Units/UnitDef.h"
 #include "Sim/Units/CommandAI/CommandAI.h"
 #include "System/SpringMath.h"
+#include "System/Threading/ThreadPool.h"
 
 CR_BIND_DERIVED_INTERFACE(AAirMoveType, AMoveType)
 
@@ -40,12 +42,152 @@ CR_REG_METADATA(AAirMoveType, (
 	CR_MEMBER(floatOnWater),
 
 	CR_MEMBER(lastCollidee),
+	CR_IGNORED(precomputedCollidee),
+	CR_IGNORED(precomputedCollisionState),
+	CR_IGNORED(precomputedFrame),
 
 	CR_MEMBER(crashExpGenID)
 ))
 
 
 
+static constexpr float COLLISION_CHECK_OFFSET = 121.0f;
+static constexpr float COLLISION_CHECK_RADIUS = 200.0f;
+
+
+namespace {
+	// all units bucketed by position, only built and read by PrecomputeCollisionChecks
+	struct CollisionGrid {
+	public:
+		void Build(const std::vector<CUnit*>& units) {
+			numCellsX = (mapDims.mapx * SQUARE_SIZE) / CELL_SIZE + 1;
+			numCellsZ = (mapDims.mapy * SQUARE_SIZE) / CELL_SIZE + 1;
+			maxUnitRadius = 0.0f;
+
+			cellStarts.clear();
+			cellStarts.resize(numCellsX * numCellsZ + 1, 0);
+			cellUnits.resize(units.size());
+			unitCells.resize(units.size());
+
+			// counting sort, units keep their relative order within a cell
+			for (size_t i = 0; i < units.size(); i++) {
+				const CUnit* u = units[i];
+
+				unitCells[i] = CellZ(u->pos.z) * numCellsX + CellX(u->pos.x);
+				cellStarts[unitCells[i] + 1] += 1;
+				maxUnitRadius = std::max(maxUnitRadius, u->radius);
+			}
+			for (size_t i = 1; i < cellStarts.size(); i++) {
+				cellStarts[i] += cellStarts[i - 1];
+			}
+
+			cellFills.assign(cellStarts.begin(), cellStarts.end() - 1);
+
+			for (size_t i = 0; i < units.size(); i++) {
+				cellUnits[cellFills[unitCells[i]]++] = units[i];
+			}
+		}
+
+		// visits units in the same order in every run, same test as CQuadField::GetUnitsExact
+		template<typename Visitor> void ForEachUnit(const float3& pos, float radius, const Visitor& visitor) const {
+			const float searchRadius = radius + maxUnitRadius;
+
+			const int minX = CellX(pos.x - searchRadius);
+			const int maxX = CellX(pos.x + searchRadius);
+			const int minZ = CellZ(pos.z - searchRadius);
+			const int maxZ = CellZ(pos.z + searchRadius);
+
+			for (int z = minZ; z <= maxZ; z++) {
+				for (int x = minX; x <= maxX; x++) {
+					const int cell = z * numCellsX + x;
+
+					for (int i = cellStarts[cell]; i < cellStarts[cell + 1]; i++) {
+						CUnit* u = cellUnits[i];
+
+						if (pos.SqDistance(u->pos) >= Square(radius + u->radius))
+							continue;
+
+						visitor(u);
+					}
+				}
+			}
+		}
+
+	private:
+		int CellX(float x) const { return Clamp(int(x / CELL_SIZE), 0, numCellsX - 1); }
+		int CellZ(float z) const { return Clamp(int(z / CELL_SIZE), 0, numCellsZ - 1); }
+
+	private:
+		static constexpr int CELL_SIZE = 256;
+
+		int numCellsX = 0;
+		int numCellsZ = 0;
+
+		float maxUnitRadius = 0.0f;
+
+		std::vector<int> cellStarts;
+		std::vector<int> cellFills;
+		std::vector<int> unitCells;
+		std::vector<CUnit*> cellUnits;
+	};
+
+	CollisionGrid collisionGrid;
+	std::vector<AAirMoveType*> collisionCheckers;
+}
+
+template<typename UnitRange>
+static AAirMoveType::CollisionState FindCollidee(const CUnit* owner, const UnitRange& forEachUnit, CUnit*& collidee)
+{
+	const SyncedFloat3& pos = owner->midPos;
+	const SyncedFloat3& forward = owner->frontdir;
+
+	float dist = COLLISION_CHECK_RADIUS;
+
+	collidee = nullptr;
+
+	// find closest potential collidee
+	forEachUnit([&](CUnit* unit) {
+		if (unit == owner || !unit->unitDef->canfly)
+			return;
+
+		const SyncedFloat3& op = unit->midPos;
+		const float3 dif = op - pos;
+		const float3 forwardDif = forward * (forward.dot(dif));
+
+		if (forwardDif.SqLength() >= (dist * dist))
+			return;
+
+		const float3 ortoDif = dif - forwardDif;
+		const float frontLength = forwardDif.Length();
+		// note: radii are multiplied by two
+		const float minOrtoDif = (unit->radius + owner->radius) * 2.0f + frontLength * 0.1f + 10.0f;
+
+		if (ortoDif.SqLength() < (minOrtoDif * minOrtoDif)) {
+			dist = frontLength;
+			collidee = unit;
+		}
+	});
+
+	if (collidee != nullptr)
+		return AAirMoveType::COLLISION_DIRECT;
+
+	forEachUnit([&](CUnit* u) {
+		if (u == owner)
+			return;
+
+		if ((u->midPos - pos).SqLength() > Square((owner->radius + u->radius) * 2.0f))
+			return;
+
+		collidee = u;
+	});
+
+	if (collidee != nullptr)
+		return AAirMoveType::COLLISION_NEARBY;
+
+	return AAirMoveType::COLLISION_NOUNIT;
+}
+
+
 static inline float AAMTGetGroundHeightAW(float x, float z) { return CGround::GetHeightAboveWater(x, z); }
 static inline float AAMTGetGroundHeight  (float x, float z) { return CGround::GetHeightReal      (x, z); }
 static inline float AAMTGetSmoothGroundHeightAW(float x, float z) { return smoothGround.GetHeightAboveWater(x, z); }
@@ -220,68 +362,77 @@ void AAirMoveType::UpdateLanding()
 }
 
 
-void AAirMoveType::CheckForCollision()
+void AAirMoveType::PrecomputeCollisionChecks(const std::vector<CUnit*>& units)
 {
-	if (!collide)
-		return;
-
-	const SyncedFloat3& pos = owner->midPos;
-	const SyncedFloat3& forward = owner->frontdir;
+	collisionCheckers.clear();
 
-	float dist = 200.0f;
+	// same conditions as the CheckForCollision call-sites, but without
+	// knowing whether the current state actually reaches them
+	for (CUnit* unit: units) {
+		if (!unit->unitDef->canfly || unit->UsingScriptMoveType())
+			continue;
+		if (((gs->frameNum + unit->id) & 3) != 0)
+			continue;
 
-	QuadFieldQuery qfQuery;
-	quadField.GetUnitsExact(qfQuery, pos + forward * 121.0f, dist);
+		AAirMoveType* amt = static_cast<AAirMoveType*>(unit->moveType);
 
-	if (lastCollidee != nullptr) {
-		DeleteDeathDependence(lastCollidee, DEPENDENCE_LASTCOLWARN);
+		if (!amt->collide)
+			continue;
 
-		lastCollidee = nullptr;
-		collisionState = COLLISION_NOUNIT;
+		collisionCheckers.push_back(amt);
 	}
 
-	// find closest potential collidee
-	for (CUnit* unit: *qfQuery.units) {
-		if (unit == owner || !unit->unitDef->canfly)
-			continue;
+	if (collisionCheckers.empty())
+		return;
 
-		const SyncedFloat3& op = unit->midPos;
-		const float3 dif = op - pos;
-		const float3 forwardDif = forward * (forward.dot(dif));
+	collisionGrid.Build(units);
 
-		if (forwardDif.SqLength() >= (dist * dist))
-			continue;
+	for_mt(0, collisionCheckers.size(), [](const int i) {
+		AAirMoveType* amt = collisionCheckers[i];
 
-		const float3 ortoDif = dif - forwardDif;
-		const float frontLength = forwardDif.Length();
-		// note: radii are multiplied by two
-		const float minOrtoDif = (unit->radius + owner->radius) * 2.0f + frontLength * 0.1f + 10.0f;
+		const CUnit* owner = amt->owner;
+		const float3 pos = owner->midPos + owner->frontdir * COLLISION_CHECK_OFFSET;
+		const auto forEachUnit = [&](const auto& visitor) { collisionGrid.ForEachUnit(pos, COLLISION_CHECK_RADIUS, visitor); };
 
-		if (ortoDif.SqLength() < (minOrtoDif * minOrtoDif)) {
-			dist = frontLength;
-			lastCollidee = const_cast<CUnit*>(unit);
-		}
-	}
+		amt->precomputedCollisionState = FindCollidee(owner, forEachUnit, amt->precomputedCollidee);
+		amt->precomputedFrame = gs->frameNum;
+	});
+}
 
-	if (lastCollidee != nullptr) {
-		collisionState = COLLISION_DIRECT;
-		AddDeathDependence(lastCollidee, DEPENDENCE_LASTCOLWARN);
+void AAirMoveType::CheckForCollision()
+{
+	if (!collide)
 		return;
-	}
 
-	for (CUnit* u: *qfQuery.units) {
-		if (u == owner)
-			continue;
+	CUnit* collidee = nullptr;
+	CollisionState state = COLLISION_NOUNIT;
 
-		if ((u->midPos - pos).SqLength() > Square((owner->radius + u->radius) * 2.0f))
-			continue;
+	if (precomputedFrame == gs->frameNum) {
+		collidee = precomputedCollidee;
+		state = precomputedCollisionState;
+	} else {
+		QuadFieldQuery qfQuery;
+		quadField.GetUnitsExact(qfQuery, owner->midPos + owner->frontdir * COLLISION_CHECK_OFFSET, COLLISION_CHECK_RADIUS);
 
-		lastCollidee = u;
+		const auto forEachUnit = [&](const auto& visitor) {
+			for (CUnit* unit: *qfQuery.units) {
+				visitor(unit);
+			}
+		};
+
+		state = FindCollidee(owner, forEachUnit, collidee);
 	}
 
 	if (lastCollidee != nullptr) {
-		collisionState = COLLISION_NEARBY;
-		AddDeathDependence(lastCollidee, DEPENDENCE_LASTCOLWARN);
-		return;
+		DeleteDeathDependence(lastCollidee, DEPENDENCE_LASTCOLWARN);
+
+		lastCollidee = nullptr;
+		collisionState = COLLISION_NOUNIT;
 	}
+
+	if ((lastCollidee = collidee) == nullptr)
+		return;
+
+	collisionState = state;
+	AddDeathDependence(lastCollidee, DEPENDENCE_LASTCOLWARN);
 }
@@ -5,6 +5,8 @@
 
 #include "MoveType.h"
 
+#include <vector>
+
 /**
  * Supposed to be an abstract class.
  * Do not create an instance of this class.
@@ -60,6 +62,13 @@ public:
 
 	void DependentDied(CObject* o);
 
+	/**
+	 * Runs the CheckForCollision searches due this frame for all air units
+	 * in parallel against a grid of the units' current positions, so the
+	 * (serial) move-type updates only have to pick up the results.
+	 */
+	static void PrecomputeCollisionChecks(const std::vector<CUnit*>& units);
+
 protected:
 	void CheckForCollision();
 
@@ -93,6 +102,11 @@ protected:
 	/// unit found to be dangerously close to our path
 	CUnit* lastCollidee = nullptr;
 
+	/// result of PrecomputeCollisionChecks, valid during precomputedFrame
+	CUnit* precomputedCollidee = nullptr;
+	CollisionState precomputedCollisionState = COLLISION_NOUNIT;
+	int precomputedFrame = -1;
+
 	unsigned int crashExpGenID = -1u;
 };
 
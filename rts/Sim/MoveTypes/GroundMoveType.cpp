@@ -1667,6 +1667,15 @@ void CGroundMoveType::ReRequestPath(PathRequestType requestType) {
 	}
 	#endif
 
+	// a repair only stands in for a full re-request if every
+	// full re-request merged into this one allows it
+	if ((wantRepath & requestType & PATH_REQUEST_UPDATE_FULLPATH) != 0) {
+		const PathRequestType repairBit = (wantRepath & requestType & PATH_REQUEST_UPDATE_REPAIR);
+
+		wantRepath  = (wantRepath  & ~PATH_REQUEST_UPDATE_REPAIR) | repairBit;
+		requestType = (requestType & ~PATH_REQUEST_UPDATE_REPAIR) | repairBit;
+	}
+
 	if (wantRepath == PATH_REQUEST_NONE){
 		wantRepath = requestType;
 		return;
@@ -1699,8 +1708,17 @@ void CGroundMoveType::ReRequestPath(PathRequestType requestType) {
 	#endif
 }
 
-void CGroundMoveType::DoReRequestPath() {
+void CGroundMoveType::DoReRequestPath(bool allowRepair) {
 	//LOG("%s activated", __func__);
+	// the goal is unchanged, usually only the part of the path near us was invalidated
+	if (allowRepair && pathID != 0 && pathManager->RepairPath(owner, pathID)) {
+		earlyCurrWayPoint = pathManager->NextWayPoint(owner, pathID, 0,        owner->pos, std::max(WAYPOINT_RADIUS, currentSpeed * 1.05f), true);
+		earlyNextWayPoint = pathManager->NextWayPoint(owner, pathID, 0, earlyCurrWayPoint, std::max(WAYPOINT_RADIUS, currentSpeed * 1.05f), true);
+
+		pathController.SetTempGoalPosition(pathID, earlyCurrWayPoint);
+		return;
+	}
+
 	StopEngine(false);
 	StartEngine(false);
 }
@@ -1958,7 +1976,7 @@ void CGroundMoveType::SetNextWayPoint()
 	// this can happen if we crushed a non-blocking feature
 	// and it spawned another feature which we cannot crush
 	// (eg.) --> repath
-	ReRequestPath(PATH_REQUEST_TIMING_DELAYED|PATH_REQUEST_UPDATE_FULLPATH);
+	ReRequestPath(PATH_REQUEST_TIMING_DELAYED|PATH_REQUEST_UPDATE_FULLPATH|PATH_REQUEST_UPDATE_REPAIR);
 	#ifdef PATHING_DEBUG
 	if (DEBUG_DRAWING_ENABLED) {
 		bool printMoveInfo = (selectedUnitsHandler.selectedUnits.size() == 1)
@@ -2106,6 +2124,12 @@ void CGroundMoveType::Fail(bool callScript)
 
 
 
+// NOTE:
+//   collisions are resolved Gauss-Seidel style; every push moves both parties
+//   immediately, which changes the neighbors and separation vectors seen by all
+//   units updated later in the same frame (and can call Lua or kill units), so
+//   the result depends on the unit update order and can not be reproduced by a
+//   parallel gather-then-apply pass
 void CGroundMoveType::HandleObjectCollisions()
 {
 	SCOPED_TIMER("Sim::Unit::MoveType::Collisions");
@@ -2141,7 +2165,7 @@ void CGroundMoveType::HandleObjectCollisions()
 		if (!HandleStaticObjectCollision(owner, owner, owner->moveDef,  colliderFootPrintRadius, 0.0f,  ZeroVector, true, false, true))
 			return;
 
-		ReRequestPath(PATH_REQUEST_TIMING_DELAYED|PATH_REQUEST_UPDATE_FULLPATH);
+		ReRequestPath(PATH_REQUEST_TIMING_DELAYED|PATH_REQUEST_UPDATE_FULLPATH|PATH_REQUEST_UPDATE_REPAIR);
 	}
 }
 
@@ -2463,7 +2487,7 @@ void CGroundMoveType::HandleUnitCollisions(
 			const bool checkYardMap = ((pushCollider || pushCollidee) || collideeUD->IsFactoryUnit());
 
 			if (HandleStaticObjectCollision(collider, collidee, colliderMD,  colliderParams.y, collideeParams.y,  separationVect, allowNewPath, checkYardMap, false))
-				ReRequestPath(PATH_REQUEST_TIMING_DELAYED|PATH_REQUEST_UPDATE_FULLPATH);
+				ReRequestPath(PATH_REQUEST_TIMING_DELAYED|PATH_REQUEST_UPDATE_FULLPATH|PATH_REQUEST_UPDATE_REPAIR);
 
 			continue;
 		}
@@ -2569,7 +2593,7 @@ void CGroundMoveType::HandleFeatureCollisions(
 
 		if (!collidee->IsMoving()) {
 			if (HandleStaticObjectCollision(collider, collidee, colliderMD,  colliderParams.y, collideeParams.y,  separationVect, (!atEndOfPath && !atGoal), true, false))
-				ReRequestPath(PATH_REQUEST_TIMING_DELAYED|PATH_REQUEST_UPDATE_FULLPATH);
+				ReRequestPath(PATH_REQUEST_TIMING_DELAYED|PATH_REQUEST_UPDATE_FULLPATH|PATH_REQUEST_UPDATE_REPAIR);
 
 			continue;
 		}
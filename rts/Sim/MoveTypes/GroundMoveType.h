@@ -99,7 +99,7 @@ public:
 		PathRequestType curRepath = wantRepath;
 		wantRepath = PATH_REQUEST_NONE;
 
-		if (curRepath & PATH_REQUEST_UPDATE_FULLPATH) { DoReRequestPath(); }
+		if (curRepath & PATH_REQUEST_UPDATE_FULLPATH) { DoReRequestPath((curRepath & PATH_REQUEST_UPDATE_REPAIR) != 0); }
 		else if (curRepath & PATH_REQUEST_UPDATE_EXISTING) { DoSetNextWaypoint(); }
 	}
 	void SyncWaypoints() {
@@ -128,7 +128,7 @@ private:
 	bool CanSetNextWayPoint();
 	void DoSetNextWaypoint();
 	void ReRequestPath(PathRequestType requestType);
-	void DoReRequestPath();
+	void DoReRequestPath(bool allowRepair);
 
 	void StartEngine(bool callScript);
 	void StopEngine(bool callScript, bool hardStop = false);
@@ -1,5 +1,9 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <algorithm>
+#include <vector>
+
+#include "xsimd/xsimd.hpp"
 #include "MoveMath.h"
 
 #include "Map/Ground.h"
@@ -10,6 +14,7 @@
 #include "Sim/MoveTypes/MoveType.h"
 #include "Sim/Objects/SolidObject.h"
 #include "Sim/Units/Unit.h"
+#include "System/SpringMath.h"
 #include "System/Platform/Threading.h"
 
 bool CMoveMath::noHoverWaterMove = false;
@@ -105,6 +110,246 @@ float CMoveMath::GetPosSpeedMod(const MoveDef& moveDef, unsigned xSquare, unsign
 	return 0.0f;
 }
 
+/*
+ * Evaluates GetPosSpeedMod for <n> consecutive half-resolution map cells.
+ * Lanes are computed with the same operations (and in the same order) as
+ * {Ground,Hover,Ship}SpeedMod and MoveDef::GetDepthMod so the results are
+ * bit-identical to the per-square path; inputs must be padded to a whole
+ * number of SIMD vectors.
+ */
+static void CalcCellSpeedMods(
+	const MoveDef& moveDef,
+	const float* heights,
+	const float* slopes,
+	const float* ttSpeeds,
+	float* speedMods,
+	size_t n
+) {
+	using SIMDVfloat = xsimd::simd_type<float>;
+
+	constexpr size_t simdSize = SIMDVfloat::size;
+
+	const SIMDVfloat zero(0.0f);
+	const SIMDVfloat one(1.0f);
+
+	const SIMDVfloat maxSlope(moveDef.maxSlope);
+	const SIMDVfloat slopeMod(moveDef.slopeMod);
+	const SIMDVfloat depth(moveDef.depth);
+
+	assert((n % simdSize) == 0);
+
+	switch (moveDef.speedModClass) {
+		case MoveDef::Tank: // fall-through
+		case MoveDef::KBot: {
+			const SIMDVfloat waterDamageCost(CMoveMath::waterDamageCost);
+			const SIMDVfloat minDepthModHeight(-moveDef.depthModParams[MoveDef::DEPTHMOD_MIN_HEIGHT]);
+			const SIMDVfloat maxDepthModHeight(-moveDef.depthModParams[MoveDef::DEPTHMOD_MAX_HEIGHT]);
+			const SIMDVfloat a(moveDef.depthModParams[MoveDef::DEPTHMOD_QUA_COEFF]);
+			const SIMDVfloat b(moveDef.depthModParams[MoveDef::DEPTHMOD_LIN_COEFF]);
+			const SIMDVfloat c(moveDef.depthModParams[MoveDef::DEPTHMOD_CON_COEFF]);
+			const SIMDVfloat minScale(0.01f);
+			const SIMDVfloat maxScale(moveDef.depthModParams[MoveDef::DEPTHMOD_MAX_SCALE]);
+
+			for (size_t i = 0; i < n; i += simdSize) {
+				const SIMDVfloat height = xsimd::load_unaligned(&heights[i]);
+				const SIMDVfloat slope  = xsimd::load_unaligned(&slopes[i]);
+				const SIMDVfloat sqrDepth = -height;
+
+				const SIMDVfloat scale = xsimd::min(maxScale, xsimd::max(minScale, (a * sqrDepth * sqrDepth + b * sqrDepth + c)));
+				const SIMDVfloat depthMod = xsimd::select(height > minDepthModHeight, one, xsimd::select(height < maxDepthModHeight, zero, one / scale));
+
+				SIMDVfloat speedMod = one / (one + slope * slopeMod);
+				speedMod *= xsimd::select(height < zero, waterDamageCost, one);
+				speedMod *= depthMod;
+				speedMod = xsimd::select((slope > maxSlope) | (sqrDepth > depth), zero, speedMod);
+
+				xsimd::store_unaligned(&speedMods[i], speedMod * xsimd::load_unaligned(&ttSpeeds[i]));
+			}
+		} break;
+
+		case MoveDef::Hover: {
+			const SIMDVfloat waterSpeedMod(1.0f * !CMoveMath::noHoverWaterMove);
+
+			for (size_t i = 0; i < n; i += simdSize) {
+				const SIMDVfloat height = xsimd::load_unaligned(&heights[i]);
+				const SIMDVfloat slope  = xsimd::load_unaligned(&slopes[i]);
+
+				const SIMDVfloat landSpeedMod = xsimd::select(slope > maxSlope, zero, one / (one + slope * slopeMod));
+				const SIMDVfloat speedMod = xsimd::select(height < zero, waterSpeedMod, landSpeedMod);
+
+				xsimd::store_unaligned(&speedMods[i], speedMod * xsimd::load_unaligned(&ttSpeeds[i]));
+			}
+		} break;
+
+		case MoveDef::Ship: {
+			for (size_t i = 0; i < n; i += simdSize) {
+				const SIMDVfloat height = xsimd::load_unaligned(&heights[i]);
+				const SIMDVfloat speedMod = xsimd::select((-height) < depth, zero, one);
+
+				xsimd::store_unaligned(&speedMods[i], speedMod * xsimd::load_unaligned(&ttSpeeds[i]));
+			}
+		} break;
+
+		default: {
+			std::fill(speedMods, speedMods + n, 0.0f);
+		} break;
+	}
+}
+
+void CMoveMath::GetPosSpeedMods(const MoveDef& moveDef, int xmin, int xmax, int zmin, int zmax, float* speedMods)
+{
+	constexpr size_t simdSize = xsimd::simd_type<float>::size;
+
+	// per-thread scratch-buffers, one half-resolution row each
+	static thread_local std::vector<float> cellHeights;
+	static thread_local std::vector<float> cellSlopes;
+	static thread_local std::vector<float> cellTTSpeeds;
+	static thread_local std::vector<float> cellSpeedMods;
+
+	const int numCols = xmax - xmin;
+
+	// squares outside the map are never accessible
+	const int xbeg = Clamp(xmin, 0, mapDims.mapx);
+	const int xend = Clamp(xmax, 0, mapDims.mapx);
+
+	if (numCols <= 0)
+		return;
+
+	const int hxbeg = xbeg >> 1;
+	const int hxend = (xend + 1) >> 1;
+
+	const size_t numCells = std::max(hxend - hxbeg, 0);
+	const size_t numPadded = numCells + (simdSize - numCells % simdSize) % simdSize;
+
+	cellHeights.resize(numPadded, 0.0f);
+	cellSlopes.resize(numPadded, 0.0f);
+	cellTTSpeeds.resize(numPadded, 0.0f);
+	cellSpeedMods.resize(numPadded, 0.0f);
+
+	const float* heightMap = readMap->GetMIPHeightMapSynced(1);
+	const float* slopeMap = readMap->GetSlopeMapSynced();
+	const uint8_t* typeMap = readMap->GetTypeMapSynced();
+
+	for (int z = zmin; z < zmax; z++) {
+		float* rowSpeedMods = &speedMods[(z - zmin) * numCols];
+
+		std::fill(rowSpeedMods, rowSpeedMods + numCols, 0.0f);
+
+		if (z < 0 || z >= mapDims.mapy || numCells == 0)
+			continue;
+
+		const int rowOffset = (z >> 1) * mapDims.hmapx;
+
+		for (size_t i = 0; i < numCells; i++) {
+			const int square = rowOffset + hxbeg + i;
+			const CMapInfo::TerrainType& tt = mapInfo->terrainTypes[typeMap[square]];
+
+			cellHeights[i] = heightMap[square];
+			cellSlopes[i] = slopeMap[square];
+
+			switch (moveDef.speedModClass) {
+				case MoveDef::Tank:  { cellTTSpeeds[i] = tt.tankSpeed ; } break;
+				case MoveDef::KBot:  { cellTTSpeeds[i] = tt.kbotSpeed ; } break;
+				case MoveDef::Hover: { cellTTSpeeds[i] = tt.hoverSpeed; } break;
+				case MoveDef::Ship:  { cellTTSpeeds[i] = tt.shipSpeed ; } break;
+				default: {} break;
+			}
+		}
+
+		CalcCellSpeedMods(moveDef, cellHeights.data(), cellSlopes.data(), cellTTSpeeds.data(), cellSpeedMods.data(), numPadded);
+
+		for (int x = xbeg; x < xend; x++) {
+			rowSpeedMods[x - xmin] = cellSpeedMods[(x >> 1) - hxbeg];
+		}
+	}
+}
+
+void CMoveMath::GetBlockedStructures(const MoveDef& moveDef, int xmin, int xmax, int zmin, int zmax, uint8_t* blocked)
+{
+	// per-thread scratch-buffers
+	static thread_local std::vector<int> cellCounts;
+	static thread_local std::vector<int> rowCounts;
+
+	const int numCols = xmax - xmin;
+	const int numRows = zmax - zmin;
+
+	if (numCols <= 0 || numRows <= 0)
+		return;
+
+	// squares referenced by any of the footprints
+	const int exmin = std::max(xmin     - moveDef.xsizeh,                0);
+	const int ezmin = std::max(zmin     - moveDef.zsizeh,                0);
+	const int exmax = std::min(xmax - 1 + moveDef.xsizeh, mapDims.mapx - 1);
+	const int ezmax = std::min(zmax - 1 + moveDef.zsizeh, mapDims.mapy - 1);
+
+	std::fill(blocked, blocked + numCols * numRows, 0);
+
+	if (exmin > exmax || ezmin > ezmax)
+		return;
+
+	const int numExtCols = exmax - exmin + 1;
+	const int numExtRows = ezmax - ezmin + 1;
+
+	cellCounts.resize(numExtCols);
+	rowCounts.resize(numExtRows * numCols);
+
+	// number of structure-blocked squares among s, s+2, ..., e of a
+	// sequence whose stride-2 prefix-sums are stored in <counts>
+	const auto CountSamples = [](const int* counts, int stride, int base, int s, int e) {
+		const int l = e - ((e - s) & 1);
+		return (counts[(l - base) * stride] - ((s - 2 >= base)? counts[(s - 2 - base) * stride]: 0));
+	};
+
+	// footprints sample every FOOTPRINT_{X,Z}STEP'th square starting from their
+	// (clamped) lower corner, as in IsBlockedNoSpeedModCheck; the x- and z-samples
+	// are independent, so reduce the rows first and the columns afterwards
+	for (int ez = ezmin; ez <= ezmax; ez++) {
+		const int zOffset = ez * mapDims.mapx;
+
+		for (int ex = exmin; ex <= exmax; ex++) {
+			int structure = 0;
+
+			if (groundBlockingObjectMap.IsOccupiedUnsafe(ex, ez)) {
+				const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zOffset + ex);
+
+				for (size_t i = 0, n = cell.size(); i < n && structure == 0; i++) {
+					structure = ((ObjectBlockType(moveDef, cell[i], nullptr) & BLOCK_STRUCTURE) != 0);
+				}
+			}
+
+			cellCounts[ex - exmin] = structure + ((ex - 2 >= exmin)? cellCounts[ex - 2 - exmin]: 0);
+		}
+
+		int* rowCountsRow = &rowCounts[(ez - ezmin) * numCols];
+
+		for (int x = xmin; x < xmax; x++) {
+			const int s = std::max(x - moveDef.xsizeh,                0);
+			const int e = std::min(x + moveDef.xsizeh, mapDims.mapx - 1);
+
+			// running column-sums are built in place below
+			rowCountsRow[x - xmin] = (s <= e && CountSamples(cellCounts.data(), 1, exmin, s, e) > 0);
+		}
+	}
+
+	for (int ez = ezmin + 2; ez <= ezmax; ez++) {
+		for (int i = 0; i < numCols; i++) {
+			rowCounts[(ez - ezmin) * numCols + i] += rowCounts[(ez - 2 - ezmin) * numCols + i];
+		}
+	}
+
+	for (int z = zmin; z < zmax; z++) {
+		const int s = std::max(z - moveDef.zsizeh,                0);
+		const int e = std::min(z + moveDef.zsizeh, mapDims.mapy - 1);
+
+		if (s > e)
+			continue;
+
+		for (int i = 0; i < numCols; i++) {
+			blocked[(z - zmin) * numCols + i] = (CountSamples(&rowCounts[i], numCols, ezmin, s, e) > 0);
+		}
+	}
+}
+
 /* Check if a given square-position is accessable by the MoveDef footprint. */
 CMoveMath::BlockType CMoveMath::IsBlockedNoSpeedModCheck(const MoveDef& moveDef, int xSquare, int zSquare, const CSolidObject* collider)
 {
@@ -120,7 +365,14 @@ CMoveMath::BlockType CMoveMath::IsBlockedNoSpeedModCheck(const MoveDef& moveDef,
 	for (int z = zmin; z <= zmax; z += FOOTPRINT_ZSTEP) {
 		const int zOffset = z * mapDims.mapx;
 
+		// most footprint rows touch no object at all
+		if (groundBlockingObjectMap.RowSamplesEmptyUnsafe(z, xmin, xmax, FOOTPRINT_XSTEP))
+			continue;
+
 		for (int x = xmin; x <= xmax; x += FOOTPRINT_XSTEP) {
+			if (!groundBlockingObjectMap.IsOccupiedUnsafe(x, z))
+				continue;
+
 			const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zOffset + x);
 
 			for (size_t i = 0, n = cell.size(); i < n; i++) {
@@ -158,11 +410,16 @@ CMoveMath::BlockType CMoveMath::IsBlockedNoSpeedModCheckDiff(const MoveDef& move
 	for (int z = zmin; z <= zmax; z += FOOTPRINT_ZSTEP) {
 		const int zOffset = z * mapDims.mapx;
 
+		if (groundBlockingObjectMap.RowSamplesEmptyUnsafe(z, xmin, xmax, FOOTPRINT_XSTEP))
+			continue;
+
 		for (int x = xmin; x <= xmax; x += FOOTPRINT_XSTEP) {
 
 			if (		z <= prev_zmax && z >= prev_zmin
 			 		&& 	x <= prev_xmax && x >= prev_xmin)
 				continue;
+			if (!groundBlockingObjectMap.IsOccupiedUnsafe(x, z))
+				continue;
 
 			const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zOffset + x);
 
@@ -299,6 +556,9 @@ CMoveMath::BlockType CMoveMath::SquareIsBlocked(const MoveDef& moveDef, int xSqu
 
 	BlockType r = BLOCK_NONE;
 
+	if (!groundBlockingObjectMap.IsOccupiedUnsafe(xSquare, zSquare))
+		return r;
+
 	const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zSquare * mapDims.mapx + xSquare);
 
 	for (size_t i = 0, n = cell.size(); i < n; i++) {
@@ -323,7 +583,13 @@ CMoveMath::BlockType CMoveMath::RangeIsBlocked(const MoveDef& moveDef, int xmin,
 	for (int z = zmin; z <= zmax; z += FOOTPRINT_ZSTEP) {
 		const int zOffset = z * mapDims.mapx;
 
+		if (groundBlockingObjectMap.RowSamplesEmptyUnsafe(z, xmin, xmax, FOOTPRINT_XSTEP))
+			continue;
+
 		for (int x = xmin; x <= xmax; x += FOOTPRINT_XSTEP) {
+			if (!groundBlockingObjectMap.IsOccupiedUnsafe(x, z))
+				continue;
+
 			const CGroundBlockingObjectMap::BlockingMapCell& cell = groundBlockingObjectMap.GetCellUnsafeConst(zOffset + x);
 
 			for (size_t i = 0, n = cell.size(); i < n; i++) {
@@ -49,6 +49,13 @@ public:
 		return (GetPosSpeedMod(moveDef, pos.x / SQUARE_SIZE, pos.z / SQUARE_SIZE, moveDir));
 	}
 
+	// bulk variants for the squares [xmin, xmax) x [zmin, zmax), results are
+	// stored row-major; equivalent to calling GetPosSpeedMod / (collider-less)
+	// IsBlockedStructure for each square, but vectorized resp. without redoing
+	// the footprint squares shared between neighbors
+	static void GetPosSpeedMods(const MoveDef& moveDef, int xmin, int xmax, int zmin, int zmax, float* speedMods);
+	static void GetBlockedStructures(const MoveDef& moveDef, int xmin, int xmax, int zmin, int zmax, uint8_t* blocked);
+
 	// tells whether a position is blocked (inaccessable for a given object's MoveDef)
 	static inline BlockType IsBlocked(const MoveDef& moveDef, const float3& pos, const CSolidObject* collider);
 	static inline BlockType IsBlocked(const MoveDef& moveDef, int xSquare, int zSquare, const CSolidObject* collider);
@@ -24,6 +24,9 @@ const int PATH_REQUEST_UPDATE_EXISTING  = (1<<2);
 const int PATH_REQUEST_UPDATE_FULLPATH  = (1<<3);
 const int PATH_REQUEST_UPDATE_BITMASK   = (PATH_REQUEST_UPDATE_EXISTING|PATH_REQUEST_UPDATE_FULLPATH);
 
+// modifies UPDATE_FULLPATH: repairing the current path (IPathManager::RepairPath) is enough
+const int PATH_REQUEST_UPDATE_REPAIR    = (1<<4);
+
 class AMoveType : public CObject
 {
 	CR_DECLARE(AMoveType)
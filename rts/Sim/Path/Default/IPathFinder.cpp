@@ -15,7 +15,7 @@ void IPathFinder::InitStatic() { pathFinderInstances.reserve(8); }
 void IPathFinder::KillStatic() { pathFinderInstances.clear  ( ); }
 
 
-void IPathFinder::Init(unsigned int _BLOCK_SIZE)
+void IPathFinder::Init(unsigned int _BLOCK_SIZE, bool keepGCosts)
 {
 	{
 		BLOCK_SIZE = _BLOCK_SIZE;
@@ -46,7 +46,7 @@ void IPathFinder::Init(unsigned int _BLOCK_SIZE)
 		pathFinderInstances.push_back(this);
 	}
 
-	AllocStateBuffer();
+	AllocStateBuffer(keepGCosts);
 	ResetSearch();
 }
 
@@ -58,13 +58,13 @@ void IPathFinder::Kill()
 }
 
 
-void IPathFinder::AllocStateBuffer()
+void IPathFinder::AllocStateBuffer(bool keepGCosts)
 {
 	if (instanceIndex >= nodeStateBuffers.size())
 		nodeStateBuffers.emplace_back();
 
 	nodeStateBuffers[instanceIndex].Clear();
-	nodeStateBuffers[instanceIndex].Resize(nbrOfBlocks, int2(mapDims.mapx, mapDims.mapy));
+	nodeStateBuffers[instanceIndex].Resize(nbrOfBlocks, int2(mapDims.mapx, mapDims.mapy), keepGCosts);
 
 	// steal memory, returned in dtor
 	blockStates = std::move(nodeStateBuffers[instanceIndex]);
@@ -183,7 +183,7 @@ IPath::SearchResult IPathFinder::InitSearch(const MoveDef& moveDef, const CPathF
 	blockStates.nodeMask[mStartBlockIdx] &= PATHOPT_OBSOLETE;
 	blockStates.nodeMask[mStartBlockIdx] |= PATHOPT_OPEN;
 	blockStates.fCost[mStartBlockIdx] = 0.0f;
-	blockStates.gCost[mStartBlockIdx] = 0.0f;
+	blockStates.SetGCost(mStartBlockIdx, 0.0f);
 	blockStates.SetMaxCost(NODE_COST_F, 0.0f);
 	blockStates.SetMaxCost(NODE_COST_G, 0.0f);
 
@@ -19,7 +19,8 @@ class IPathFinder {
 public:
 	virtual ~IPathFinder() {}
 
-	void Init(unsigned int BLOCK_SIZE);
+	/// <keepGCosts> is false for instances whose node-states are never drawn
+	void Init(unsigned int BLOCK_SIZE, bool keepGCosts = true);
 	void Kill();
 
 	static void InitStatic();
@@ -73,7 +74,7 @@ public:
 protected:
 	IPath::SearchResult InitSearch(const MoveDef&, const CPathFinderDef&, const CSolidObject* owner);
 
-	void AllocStateBuffer();
+	void AllocStateBuffer(bool keepGCosts);
 	/// Clear things up from last search.
 	void ResetSearch();
 
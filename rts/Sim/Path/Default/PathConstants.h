@@ -32,6 +32,13 @@ static constexpr unsigned int MEDRES_PE_BLOCKSIZE = 16;
 static constexpr unsigned int LOWRES_PE_BLOCKSIZE = 32;
 
 static constexpr unsigned int SQUARES_TO_UPDATE = 1000;
+
+// synced PE searches toward the same goal-block and path-type within one frame
+// after which the remaining ones (e.g. the rest of a group that was given the
+// same move order) are answered from a shared flow-field, see CPathEstimator
+static constexpr unsigned int FLOWFIELD_MIN_REQUESTS = 8;
+static constexpr unsigned int FLOWFIELD_MAX_LIFETIME = GAME_SPEED;
+static constexpr unsigned int FLOWFIELD_MAX_COUNT = 8;
 static constexpr unsigned int MAX_SEARCHED_NODES_ON_REFINE = 2000;
 
 static constexpr unsigned int PATH_HEATMAP_XSCALE =  1; // wrt. mapDims.hmapx
@@ -113,15 +113,24 @@ struct PathNodeStateBuffer {
 
 	unsigned int GetSize() const { return fCost.size(); }
 
-	void Resize(const int2& bufRes, const int2& mapRes) {
+	/// g-costs are only read by the path-cost debug overlay, instances which are
+	/// never drawn can leave them out (4 of the 9 bytes per node)
+	void Resize(const int2& bufRes, const int2& mapRes, bool withGCosts = true) {
 		ps = mapRes / bufRes;
 		br = bufRes;
 		mr = mapRes;
 
 		fCost.resize(br.x * br.y, PATHCOST_INFINITY);
-		gCost.resize(br.x * br.y, PATHCOST_INFINITY);
 		nodeMask.resize(br.x * br.y, 0);
 
+		if (withGCosts) {
+			gCost.resize(br.x * br.y, PATHCOST_INFINITY);
+		} else {
+			// buffers are recycled across reloads, release the memory
+			gCost.clear();
+			gCost.shrink_to_fit();
+		}
+
 		// created on-demand
 		// extraCosts[ true].resize(br.x * br.y, 0.0f);
 		// extraCosts[false].resize(br.x * br.y, 0.0f);
@@ -160,9 +169,17 @@ struct PathNodeStateBuffer {
 	void ClearSquare(int idx) {
 		// assert(idx >= 0 && idx < fCost.size());
 		fCost[idx] = PATHCOST_INFINITY;
-		gCost[idx] = PATHCOST_INFINITY;
 		// clear all bits except PATHOPT_OBSOLETE
 		nodeMask[idx] &= PATHOPT_OBSOLETE;
+
+		SetGCost(idx, PATHCOST_INFINITY);
+	}
+
+	void SetGCost(unsigned int idx, float cost) {
+		if (gCost.empty())
+			return;
+
+		gCost[idx] = cost;
 	}
 
 
@@ -223,6 +240,7 @@ struct PathNodeStateBuffer {
 
 public:
 	std::vector<float> fCost;
+	/// empty unless requested by Resize, write via SetGCost
 	std::vector<float> gCost;
 
 	/// bitmask of PATHOPT_{OPEN, ..., OBSOLETE} flags
@@ -2,9 +2,6 @@
 
 #include "System/Platform/Win/win32.h"
 
-#include "zlib.h"
-#include "minizip/zip.h"
-
 #include "PathEstimator.h"
 #include "PathFinder.h"
 #include "PathFinderDef.h"
@@ -13,24 +10,26 @@
 #include "PathMemPool.h"
 #include "Game/GlobalUnsynced.h"
 #include "Game/LoadScreen.h"
+#include "Sim/Misc/GlobalSynced.h"
 #include "Sim/Misc/GroundBlockingObjectMap.h"
 #include "Sim/Misc/ModInfo.h"
 #include "Sim/MoveTypes/MoveDefHandler.h"
 #include "Sim/MoveTypes/MoveMath/MoveMath.h"
 #include "Net/Protocol/NetProtocol.h"
+#include "Sim/Path/PathCacheFile.h"
 #include "System/Threading/ThreadPool.h" // for_mt
 #include "System/TimeProfiler.h"
 #include "System/Config/ConfigHandler.h"
-#include "System/FileSystem/Archives/IArchive.h"
-#include "System/FileSystem/ArchiveLoader.h"
-#include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileSystem.h"
-#include "System/FileSystem/FileQueryFlags.h"
 #include "System/Platform/Threading.h"
 #include "System/SafeUtil.h"
 #include "System/StringUtil.h"
 #include "System/Sync/SHA512.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <queue>
+
 #define ENABLE_NETLOG_CHECKSUM 1
 
 CONFIG(int, PathingThreadCount).defaultValue(0).safemodeValue(1).minimumValue(0);
@@ -45,7 +44,7 @@ static const std::string GetPathCacheDir() {
 }
 
 static const std::string GetCacheFileName(const std::string& fileHashCode, const std::string& peFileName, const std::string& mapFileName) {
-	return (GetPathCacheDir() + mapFileName + "." + peFileName + "-" + fileHashCode + ".zip");
+	return (GetPathCacheDir() + mapFileName + "." + peFileName + "-" + fileHashCode + ".pcf");
 }
 
 
@@ -118,9 +117,13 @@ void CPathEstimator::Init(IPathFinder* pf, unsigned int BLOCK_SIZE, const std::s
 		for_mt(0, moveDefHandler.GetNumMoveDefs(), [&](unsigned int i) {
 			const MoveDef* md = moveDefHandler.GetMoveDefByPathType(i);
 
+			std::vector<float> rowSpeedMods(mapDims.mapx);
+
 			for (int y = 0; y < mapDims.mapy; y++) {
+				CMoveMath::GetPosSpeedMods(*md, 0, mapDims.mapx, y, y + 1, rowSpeedMods.data());
+
 				for (int x = 0; x < mapDims.mapx; x++) {
-					childPE->maxSpeedMods[i] = std::max(childPE->maxSpeedMods[i], CMoveMath::GetPosSpeedMod(*md, x, y));
+					childPE->maxSpeedMods[i] = std::max(childPE->maxSpeedMods[i], rowSpeedMods[x]);
 				}
 			}
 		});
@@ -141,6 +144,12 @@ void CPathEstimator::Kill()
 {
 	pcMemPool.free(pathCache[0]);
 	pcMemPool.free(pathCache[1]);
+
+	goalFlowFields.clear();
+	goalRequestCounts.clear();
+	flowPathBlocks.clear();
+
+	goalRequestFrame = -1;
 }
 
 
@@ -165,7 +174,7 @@ void CPathEstimator::InitEstimator(const std::string& peFileName, const std::str
 	if (!ReadFile(peFileName, mapFileName)) {
 		// start extra threads if applicable, but always keep the total
 		// memory-footprint made by CPathFinder instances within bounds
-		const unsigned int minMemFootPrint = sizeof(CPathFinder) + parentPathFinder->GetMemFootPrint();
+		const unsigned int minMemFootPrint = sizeof(CPathFinder) + pathFinders[0]->GetMemFootPrint();
 		const unsigned int maxMemFootPrint = configHandler->GetInt("MaxPathCostsMemoryFootPrint") * 1024 * 1024;
 		const unsigned int numExtraThreads = Clamp(int(maxMemFootPrint / minMemFootPrint) - 1, 0, int(numThreads) - 1);
 		const unsigned int reqMemFootPrint = minMemFootPrint * (numExtraThreads + 1);
@@ -331,6 +340,13 @@ int2 CPathEstimator::FindBlockPosOffset(const MoveDef& moveDef, unsigned int blo
 		}
 	}*/
 
+	// speedmods of the whole block are evaluated in one (vectorized) pass,
+	// structure-blocking is still only tested for the candidate squares
+	static thread_local std::vector<float> blockSpeedMods;
+
+	blockSpeedMods.resize(BLOCK_SIZE * BLOCK_SIZE);
+	CMoveMath::GetPosSpeedMods(moveDef, lowerX, lowerX + BLOCK_SIZE, lowerZ, lowerZ + BLOCK_SIZE, blockSpeedMods.data());
+
 	// same as above, but with squares sorted by their baseCost
 	// s.t. we can exit early when a square exceeds our current
 	// best (from testing, on avg. 40% of blocks can be skipped)
@@ -339,7 +355,7 @@ int2 CPathEstimator::FindBlockPosOffset(const MoveDef& moveDef, unsigned int blo
 			break;
 
 		const int2 blockPos(lowerX + ob.offset.x, lowerZ + ob.offset.y);
-		const float speedMod = CMoveMath::GetPosSpeedMod(moveDef, blockPos.x, blockPos.y);
+		const float speedMod = blockSpeedMods[ob.offset.y * BLOCK_SIZE + ob.offset.x];
 
 		//assert((blockArea / (0.001f + speedMod) >= 0.0f);
 		const float cost = ob.cost + (blockArea / (0.001f + speedMod));
@@ -640,6 +656,15 @@ IPath::SearchResult CPathEstimator::DoSearch(const MoveDef& moveDef, const CPath
 	const int2 goalSqrOffset = peDef.GoalSquareOffset(BLOCK_SIZE);
 	const float maxSpeedMod = maxSpeedMods[moveDef.pathType];
 
+	// groups ordered to one position issue many searches toward the same goal,
+	// answer those from a single expansion rather than one A* pass per unit
+	if (peDef.synced && peDef.needPath && !peDef.skipSubSearches) {
+		const GoalFlowField* flowField = GetGoalFlowField(moveDef, peDef);
+
+		if (flowField != nullptr && TraceGoalFlowField(moveDef, peDef, owner, *flowField))
+			return IPath::Ok;
+	}
+
 	while (!openBlocks.empty() && (openBlockBuffer.GetSize() < maxBlocksToBeSearched)) {
 		// get the open block with lowest cost
 		const PathNode* ob = openBlocks.top();
@@ -708,6 +733,169 @@ IPath::SearchResult CPathEstimator::DoSearch(const MoveDef& moveDef, const CPath
 }
 
 
+const CPathEstimator::GoalFlowField* CPathEstimator::GetGoalFlowField(const MoveDef& moveDef, const CPathFinderDef& peDef)
+{
+	const int2 goalBlockPos = {int(peDef.goalSquareX / BLOCK_SIZE), int(peDef.goalSquareZ / BLOCK_SIZE)};
+	const unsigned int goalBlockIdx = BlockPosToIdx(goalBlockPos);
+
+	const auto IsExpired = [&](const GoalFlowField& ff) { return ((ff.frameNum + int(FLOWFIELD_MAX_LIFETIME)) < gs->frameNum); };
+	const auto IsMatched = [&](const GoalFlowField& ff) { return (ff.goalBlockIdx == goalBlockIdx && ff.pathType == moveDef.pathType); };
+
+	// vertex costs keep changing, so fields are not reused for long
+	goalFlowFields.erase(std::remove_if(goalFlowFields.begin(), goalFlowFields.end(), IsExpired), goalFlowFields.end());
+
+	const auto iter = std::find_if(goalFlowFields.begin(), goalFlowFields.end(), IsMatched);
+
+	if (iter != goalFlowFields.end())
+		return &(*iter);
+
+	if (goalRequestFrame != gs->frameNum) {
+		goalRequestCounts.clear();
+		goalRequestFrame = gs->frameNum;
+	}
+
+	const auto pred = [&](const GoalRequestCount& rc) { return (rc.goalBlockIdx == goalBlockIdx && rc.pathType == moveDef.pathType); };
+	const auto rcit = std::find_if(goalRequestCounts.begin(), goalRequestCounts.end(), pred);
+
+	// a single sparse A* search is cheaper than expanding the whole grid
+	if (rcit == goalRequestCounts.end()) {
+		goalRequestCounts.push_back({goalBlockIdx, moveDef.pathType, 1});
+		return nullptr;
+	}
+	if ((rcit->count += 1) < FLOWFIELD_MIN_REQUESTS)
+		return nullptr;
+
+	if (goalFlowFields.size() >= FLOWFIELD_MAX_COUNT)
+		goalFlowFields.erase(goalFlowFields.begin());
+
+	goalFlowFields.emplace_back();
+	goalFlowFields.back().goalBlockIdx = goalBlockIdx;
+	goalFlowFields.back().pathType = moveDef.pathType;
+	goalFlowFields.back().frameNum = gs->frameNum;
+
+	CalcGoalFlowField(moveDef, goalFlowFields.back());
+	return &goalFlowFields.back();
+}
+
+void CPathEstimator::CalcGoalFlowField(const MoveDef& moveDef, GoalFlowField& flowField) const
+{
+	typedef std::pair<float, unsigned int> OpenBlock;
+
+	const unsigned int numBlocks = nbrOfBlocks.x * nbrOfBlocks.y;
+	const unsigned int vertexBaseIdx = moveDef.pathType * numBlocks * PATH_DIRECTION_VERTICES;
+
+	flowField.costs.clear();
+	flowField.costs.resize(numBlocks, PATHCOST_INFINITY);
+	flowField.dirs.clear();
+	flowField.dirs.resize(numBlocks, PATH_DIRECTIONS);
+
+	// (cost, index) pairs give a total order, ties are resolved the same way everywhere
+	std::priority_queue<OpenBlock, std::vector<OpenBlock>, std::greater<OpenBlock> > openQueue;
+
+	flowField.costs[flowField.goalBlockIdx] = 0.0f;
+	openQueue.emplace(0.0f, flowField.goalBlockIdx);
+
+	while (!openQueue.empty()) {
+		const OpenBlock ob = openQueue.top();
+		openQueue.pop();
+
+		if (ob.first > flowField.costs[ob.second])
+			continue;
+
+		const int2 blockPos = BlockIdxToPos(ob.second);
+		const int2 blockSqr = blockStates.peNodeOffsets[moveDef.pathType][ob.second];
+
+		// same cost A* assigns to entering this block (vertex plus extra)
+		const float extraCost = blockStates.GetNodeExtraCost(blockSqr.x, blockSqr.y, true);
+
+		for (unsigned int pathDir = PATHDIR_LEFT; pathDir < PATH_DIRECTIONS; pathDir++) {
+			const int2 nbrBlockPos = blockPos + PE_DIRECTION_VECTORS[pathDir];
+
+			if (static_cast<unsigned int>(nbrBlockPos.x) >= nbrOfBlocks.x)
+				continue;
+			if (static_cast<unsigned int>(nbrBlockPos.y) >= nbrOfBlocks.y)
+				continue;
+
+			// vertex costs are bi-directional, so this is also the cost from nbr to us
+			const float vertexCost = vertexCosts[vertexBaseIdx + ob.second * PATH_DIRECTION_VERTICES + GetBlockVertexOffset(pathDir, nbrOfBlocks.x)];
+
+			if (vertexCost >= PATHCOST_INFINITY)
+				continue;
+
+			const unsigned int nbrBlockIdx = BlockPosToIdx(nbrBlockPos);
+			const float nbrBlockCost = ob.first + vertexCost + extraCost;
+
+			if (nbrBlockCost >= flowField.costs[nbrBlockIdx])
+				continue;
+
+			flowField.costs[nbrBlockIdx] = nbrBlockCost;
+			flowField.dirs[nbrBlockIdx] = (pathDir + (PATH_DIRECTIONS >> 1)) % PATH_DIRECTIONS;
+
+			openQueue.emplace(nbrBlockCost, nbrBlockIdx);
+		}
+	}
+}
+
+bool CPathEstimator::TraceGoalFlowField(const MoveDef& moveDef, const CPathFinderDef& peDef, const CSolidObject* owner, const GoalFlowField& flowField)
+{
+	const int2 goalSqrOffset = peDef.GoalSquareOffset(BLOCK_SIZE);
+
+	flowPathBlocks.clear();
+	flowPathBlocks.push_back(mStartBlockIdx);
+
+	// the field ignores the sub-searches and constraints of a regular search,
+	// those are tested along the traced blocks and any failure falls back to
+	// DoSearch (which finds the blockStates as InitSearch left them)
+	while (true) {
+		const unsigned int blockIdx = flowPathBlocks.back();
+		const unsigned int pathDir = flowField.dirs[blockIdx];
+
+		// same goal-test as DoSearch
+		const int2 bSquare = blockStates.peNodeOffsets[moveDef.pathType][blockIdx];
+		const int2 gSquare = BlockIdxToPos(blockIdx) * BLOCK_SIZE + goalSqrOffset;
+
+		if (peDef.IsGoal(bSquare.x, bSquare.y))
+			break;
+		if (peDef.IsGoal(gSquare.x, gSquare.y) && DoBlockSearch(owner, moveDef, bSquare, gSquare) == IPath::Ok)
+			break;
+
+		// goal-block reached without reaching the goal, or start not connected
+		if (pathDir >= PATH_DIRECTIONS)
+			return false;
+
+		const unsigned int nextBlockIdx = BlockPosToIdx(BlockIdxToPos(blockIdx) + PE_DIRECTION_VECTORS[pathDir]);
+		const int2 nextSquare = blockStates.peNodeOffsets[moveDef.pathType][nextBlockIdx];
+
+		if (!peDef.WithinConstraints(nextSquare))
+			return false;
+
+		// the first step has to be reachable from the actual start position
+		if (blockIdx == mStartBlockIdx && DoBlockSearch(owner, moveDef, peDef.wsStartPos, SquareToFloat3(nextSquare)) != IPath::Ok)
+			return false;
+
+		flowPathBlocks.push_back(nextBlockIdx);
+	}
+
+	for (size_t i = 1, n = flowPathBlocks.size(); i < n; i++) {
+		const unsigned int blockIdx = flowPathBlocks[i];
+		const unsigned int pathOpt = PathDir2PathOpt(flowField.dirs[flowPathBlocks[i - 1]]);
+
+		blockStates.nodeMask[blockIdx] &= ~PATHOPT_CARDINALS;
+		blockStates.nodeMask[blockIdx] |= pathOpt;
+
+		dirtyBlocks.push_back(blockIdx);
+	}
+
+	mGoalBlockIdx = flowPathBlocks.back();
+	mGoalHeuristic = 0.0f;
+
+	// start might be a goal-block which the field does not connect to
+	blockStates.fCost[mGoalBlockIdx] = (mGoalBlockIdx != mStartBlockIdx)? (flowField.costs[mStartBlockIdx] - flowField.costs[mGoalBlockIdx]): 0.0f;
+	blockStates.SetGCost(mGoalBlockIdx, blockStates.fCost[mGoalBlockIdx]);
+	return true;
+}
+
+
 /**
  * Test the accessability of a block and its value,
  * possibly also add it to the open-blocks pqueue.
@@ -879,7 +1067,7 @@ bool CPathEstimator::TestBlock(
 
 	// mark this block as open
 	blockStates.fCost[testBlockIdx] = fCost;
-	blockStates.gCost[testBlockIdx] = gCost;
+	blockStates.SetGCost(testBlockIdx, gCost);
 	blockStates.nodeMask[testBlockIdx] |= (PathDir2PathOpt(pathDir) | PATHOPT_OPEN);
 
 	dirtyBlocks.push_back(testBlockIdx);
@@ -961,61 +1149,11 @@ bool CPathEstimator::ReadFile(const std::string& peFileName, const std::string&
 
 	LOG("[PathEstimator::%s] hash=%s file=\"%s\" (exists=%d)", __func__, hashHexString.c_str(), cacheFileName.c_str(), FileSystem::FileExists(cacheFileName));
 
-	if (!FileSystem::FileExists(cacheFileName))
-		return false;
-
-	std::unique_ptr<IArchive> upfile(archiveLoader.OpenArchive(dataDirsAccess.LocateFile(cacheFileName), "sdz"));
-
-	if (upfile == nullptr || !upfile->IsOpen()) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
-
 	char calcMsg[512];
 	sprintf(calcMsg, "Reading Estimate PathCosts [%d]", BLOCK_SIZE);
 	loadscreen->SetLoadMessage(calcMsg);
 
-	const unsigned fid = upfile->FindFile("pathinfo");
-	if (fid >= upfile->NumFiles()) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
-
-	std::vector<std::uint8_t> buffer;
-
-	if (!upfile->GetFile(fid, buffer) || buffer.size() < 4) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
-
-	const unsigned int filehash = *(reinterpret_cast<unsigned int*>(&buffer[0]));
-	const unsigned int blockSize = blockStates.GetSize() * sizeof(short2);
-	unsigned int pos = sizeof(unsigned);
-
-	if (filehash != fileHashCode) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
-
-	if (buffer.size() < (pos + blockSize * moveDefHandler.GetNumMoveDefs())) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
-
-	// read center-offset data
-	for (int pathType = 0; pathType < moveDefHandler.GetNumMoveDefs(); ++pathType) {
-		std::memcpy(&blockStates.peNodeOffsets[pathType][0], &buffer[pos], blockSize);
-		pos += blockSize;
-	}
-
-	// read vertex-cost data
-	if (buffer.size() < (pos + vertexCosts.size() * sizeof(float))) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
-
-	std::memcpy(&vertexCosts[0], &buffer[pos], vertexCosts.size() * sizeof(float));
-	return true;
+	return (PathCacheFile::Read(cacheFileName, fileHashCode, GetCacheFileSections()));
 }
 
 
@@ -1024,48 +1162,27 @@ bool CPathEstimator::ReadFile(const std::string& peFileName, const std::string&
  */
 bool CPathEstimator::WriteFile(const std::string& peFileName, const std::string& mapFileName)
 {
-	// we need this directory to exist
-	if (!FileSystem::CreateDirectory(GetPathCacheDir()))
-		return false;
-
 	const std::string hashHexString = IntToString(fileHashCode, "%x");
 	const std::string cacheFileName = GetCacheFileName(hashHexString, peFileName, mapFileName);
 
 	LOG("[PathEstimator::%s] hash=%s file=\"%s\" (exists=%d)", __func__, hashHexString.c_str(), cacheFileName.c_str(), FileSystem::FileExists(cacheFileName));
 
-	// open file for writing in a suitable location
-	zipFile file = zipOpen(dataDirsAccess.LocateFile(cacheFileName, FileQueryFlags::WRITE).c_str(), APPEND_STATUS_CREATE);
-
-	if (file == nullptr)
-		return false;
-
-	zipOpenNewFileInZip(file, "pathinfo", nullptr, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, Z_BEST_COMPRESSION);
-
-	// write hash-code (NOTE: this also affects the CRC!)
-	zipWriteInFileInZip(file, (const void*) &fileHashCode, 4);
-
-	// write center-offsets
-	for (int pathType = 0; pathType < moveDefHandler.GetNumMoveDefs(); ++pathType) {
-		zipWriteInFileInZip(file, (const void*) &blockStates.peNodeOffsets[pathType][0], blockStates.peNodeOffsets[pathType].size() * sizeof(short2));
-	}
-
-	// write vertex-costs
-	zipWriteInFileInZip(file, vertexCosts.data(), vertexCosts.size() * sizeof(float));
-
-	zipCloseFileInZip(file);
-	zipClose(file, nullptr);
+	return (PathCacheFile::Write(cacheFileName, fileHashCode, GetCacheFileSections()));
+}
 
 
-	// get the CRC over the written path data
-	std::unique_ptr<IArchive> upfile(archiveLoader.OpenArchive(dataDirsAccess.LocateFile(cacheFileName), "sdz"));
+std::vector<PathCacheFile::Section> CPathEstimator::GetCacheFileSections()
+{
+	std::vector<PathCacheFile::Section> sections;
+	sections.reserve(blockStates.peNodeOffsets.size() + 1);
 
-	if (upfile == nullptr || !upfile->IsOpen()) {
-		FileSystem::Remove(cacheFileName);
-		return false;
+	// center-offsets per pathType, then vertex-costs
+	for (auto& pathTypeOffsets: blockStates.peNodeOffsets) {
+		sections.push_back({pathTypeOffsets.data(), pathTypeOffsets.size() * sizeof(short2)});
 	}
 
-	assert(upfile->FindFile("pathinfo") < upfile->NumFiles());
-  return true;
+	sections.push_back({vertexCosts.data(), vertexCosts.size() * sizeof(float)});
+	return sections;
 }
 
 
@@ -13,6 +13,7 @@
 #include "IPathFinder.h"
 #include "PathConstants.h"
 #include "PathDataTypes.h"
+#include "Sim/Path/PathCacheFile.h"
 #include "System/float3.h"
 #include "System/Threading/SpringThreading.h"
 
@@ -121,10 +122,17 @@ private:
 
 	bool ReadFile(const std::string& peFileName, const std::string& mapFileName);
 	bool WriteFile(const std::string& peFileName, const std::string& mapFileName);
+	std::vector<PathCacheFile::Section> GetCacheFileSections();
 
 	std::uint32_t CalcChecksum() const;
 	std::uint32_t CalcHash(const char* caller) const;
 
+	struct GoalFlowField;
+
+	const GoalFlowField* GetGoalFlowField(const MoveDef& moveDef, const CPathFinderDef& peDef);
+	void CalcGoalFlowField(const MoveDef& moveDef, GoalFlowField& flowField) const;
+	bool TraceGoalFlowField(const MoveDef& moveDef, const CPathFinderDef& peDef, const CSolidObject* owner, const GoalFlowField& flowField);
+
 private:
 	friend class CPathManager;
 	friend class CDefaultPathDrawer;
@@ -167,6 +175,29 @@ private:
 
 	std::vector<SingleBlock> consumedBlocks;
 	std::vector<SOffsetBlock> offsetBlocksSortedByCost;
+
+	/// Dijkstra-expansion over the vertex costs from one goal-block, shared
+	/// by all synced searches toward it for FLOWFIELD_MAX_LIFETIME frames
+	struct GoalFlowField {
+		unsigned int goalBlockIdx;
+		int pathType;
+		int frameNum;
+
+		/// cost to the goal-block and direction of the first step, per block
+		std::vector<float> costs;
+		std::vector<std::uint8_t> dirs;
+	};
+	struct GoalRequestCount {
+		unsigned int goalBlockIdx;
+		int pathType;
+		unsigned int count;
+	};
+
+	std::vector<GoalFlowField> goalFlowFields;
+	std::vector<GoalRequestCount> goalRequestCounts;
+	std::vector<unsigned int> flowPathBlocks;
+
+	int goalRequestFrame = -1;
 };
 
 #endif
@@ -119,7 +119,8 @@ void CPathFinder::InitStatic() {
 
 void CPathFinder::Init(bool threadSafe)
 {
-	IPathFinder::Init(1);
+	// thread-safe instances only serve as PE cost-precalculation helpers
+	IPathFinder::Init(1, !threadSafe);
 
 	blockCheckFunc = blockCheckFuncs[threadSafe];
 	dummyCacheItem = CPathCache::CacheItem{IPath::Error, {}, {-1, -1}, {-1, -1}, -1.0f, -1};
@@ -463,7 +464,7 @@ bool CPathFinder::TestBlock(
 	blockStates.SetMaxCost(NODE_COST_G, std::max(blockStates.GetMaxCost(NODE_COST_G), gCost));
 
 	blockStates.fCost[sqrIdx] = os->fCost;
-	blockStates.gCost[sqrIdx] = os->gCost;
+	blockStates.SetGCost(sqrIdx, os->gCost);
 	blockStates.nodeMask[sqrIdx] |= (PATHOPT_OPEN | pathOptDir);
 
 	dirtyBlocks.push_back(sqrIdx);
@@ -429,7 +429,7 @@ unsigned int CPathManager::RequestPath(
 
 
 // converts part of a med-res path into a max-res path
-void CPathManager::MedRes2MaxRes(MultiPath& multiPath, const float3& startPos, const CSolidObject* owner, bool synced) const
+IPath::SearchResult CPathManager::MedRes2MaxRes(MultiPath& multiPath, const float3& startPos, const CSolidObject* owner, bool synced) const
 {
 	assert(IsFinalized());
 
@@ -438,7 +438,7 @@ void CPathManager::MedRes2MaxRes(MultiPath& multiPath, const float3& startPos, c
 	IPath::Path& lowResPath = multiPath.lowResPath;
 
 	if (medResPath.path.empty())
-		return;
+		return IPath::Error;
 
 	medResPath.path.pop_back();
 
@@ -468,10 +468,11 @@ void CPathManager::MedRes2MaxRes(MultiPath& multiPath, const float3& startPos, c
 	if (result == IPath::CantGetCloser || result == IPath::Error) {
 		maxResPath.pathGoal = goalPos;
 	}
+	return result;
 }
 
 // converts part of a low-res path into a med-res path
-void CPathManager::LowRes2MedRes(MultiPath& multiPath, const float3& startPos, const CSolidObject* owner, bool synced) const
+IPath::SearchResult CPathManager::LowRes2MedRes(MultiPath& multiPath, const float3& startPos, const CSolidObject* owner, bool synced) const
 {
 	assert(IsFinalized());
 
@@ -479,7 +480,7 @@ void CPathManager::LowRes2MedRes(MultiPath& multiPath, const float3& startPos, c
 	IPath::Path& lowResPath = multiPath.lowResPath;
 
 	if (lowResPath.path.empty())
-		return;
+		return IPath::Error;
 
 	lowResPath.path.pop_back();
 
@@ -507,6 +508,7 @@ void CPathManager::LowRes2MedRes(MultiPath& multiPath, const float3& startPos, c
 	if (result == IPath::CantGetCloser || result == IPath::Error) {
 		medResPath.pathGoal = goalPos;
 	}
+	return result;
 }
 
 
@@ -613,6 +615,57 @@ float3 CPathManager::NextWayPoint(
 }
 
 
+bool CPathManager::RepairPath(const CSolidObject* owner, unsigned int pathID)
+{
+	SCOPED_TIMER("Misc::Path::RepairPath");
+
+	if (!IsFinalized())
+		return false;
+
+	MultiPath* multiPath = GetMultiPath(pathID);
+
+	if (multiPath == nullptr || owner == nullptr)
+		return false;
+	// never reached the goal to begin with, nothing worth keeping
+	if (multiPath->searchResult != IPath::Ok)
+		return false;
+
+	IPath::Path& maxResPath = multiPath->maxResPath;
+	IPath::Path& medResPath = multiPath->medResPath;
+	IPath::Path& lowResPath = multiPath->lowResPath;
+
+	const float3 startPos = owner->pos.cClampInBounds();
+	const bool synced = multiPath->peDef.synced;
+
+	IPath::SearchResult result = IPath::Ok;
+
+	if (multiPath->caller != nullptr)
+		multiPath->caller->UnBlock();
+
+	// the refinement functions drop the waypoint last reached (the start of
+	// the current segment), which stands in for the caller's position here;
+	// a structure on any remaining coarse waypoint makes its search fail
+	if (medResPath.path.empty() && !lowResPath.path.empty()) {
+		lowResPath.path.push_back(startPos);
+		result = LowRes2MedRes(*multiPath, startPos, owner, synced);
+	} else {
+		medResPath.path.push_back(startPos);
+	}
+
+	if (result == IPath::Ok)
+		result = MedRes2MaxRes(*multiPath, startPos, owner, synced);
+
+	if (multiPath->caller != nullptr)
+		multiPath->caller->Block();
+
+	if (result != IPath::Ok)
+		return false;
+
+	FinalizePath(multiPath, startPos, multiPath->finalGoal, false);
+	return true;
+}
+
+
 // Tells estimators about changes in or on the map.
 void CPathManager::TerrainChange(unsigned int x1, unsigned int z1, unsigned int x2, unsigned int z2, unsigned int /*type*/) {
 	if (!IsFinalized())
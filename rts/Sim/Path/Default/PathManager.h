@@ -85,6 +85,7 @@ public:
 	void RemoveCacheFiles() override;
 	void Update() override;
 	void UpdatePath(const CSolidObject*, unsigned int) override;
+	bool RepairPath(const CSolidObject* owner, unsigned int pathID) override;
 	void DeletePath(unsigned int pathID) override {
 		if (pathID == 0)
 			return;
@@ -182,8 +183,8 @@ private:
 
 	static void FinalizePath(MultiPath* path, const float3 startPos, const float3 goalPos, const bool cantGetCloser);
 
-	void LowRes2MedRes(MultiPath& path, const float3& startPos, const CSolidObject* owner, bool synced) const;
-	void MedRes2MaxRes(MultiPath& path, const float3& startPos, const CSolidObject* owner, bool synced) const;
+	IPath::SearchResult LowRes2MedRes(MultiPath& path, const float3& startPos, const CSolidObject* owner, bool synced) const;
+	IPath::SearchResult MedRes2MaxRes(MultiPath& path, const float3& startPos, const CSolidObject* owner, bool synced) const;
 
 	bool IsFinalized() const { return (maxResPF != nullptr); }
 
@@ -35,8 +35,26 @@ public:
 
 	virtual void RemoveCacheFiles() {}
 	virtual void Update() {}
+	/**
+	 * Called once units have updated; path managers that execute their
+	 * queued searches asynchronously (QTPFS) start them here, Update of
+	 * the next frame joins them.
+	 */
+	virtual void DispatchSearches() {}
 	virtual void UpdatePath(const CSolidObject* owner, unsigned int pathID) {}
 
+	/**
+	 * Searches the part of a path near its user again after the path was
+	 * invalidated (eg. by a structure placed on it), keeping any remaining
+	 * lower-resolution waypoints instead of requesting an entirely new one.
+	 * @param pathID
+	 *     The path-id returned by RequestPath.
+	 * @return
+	 *     false if the path could not be repaired, it should be deleted and
+	 *     requested again in that case
+	 */
+	virtual bool RepairPath(const CSolidObject* owner, unsigned int pathID) { return false; }
+
 	/**
 	 * When a path is no longer used, call this function to release it from
 	 * memory.
@@ -0,0 +1,161 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "PathCacheFile.h"
+
+#include "System/FileSystem/Archives/FileView.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/Log/ILog.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <zlib.h>
+
+namespace PathCacheFile {
+	struct Header {
+		char magic[8];
+
+		std::uint32_t version;
+		std::uint32_t hashCode;
+		std::uint32_t dataCRC;
+		std::uint32_t numSections;
+		// followed by numSections uint64 sizes, then the data
+	};
+
+	static constexpr char MAGIC[8] = {'S', 'P', 'R', 'I', 'N', 'G', 'P', 'C'};
+
+
+	static std::uint32_t CalcCRC(std::uint32_t crc, const void* data, size_t size)
+	{
+		const Bytef* bytes = reinterpret_cast<const Bytef*>(data);
+
+		// crc32 takes 32-bit lengths
+		for (size_t n = 0; size > 0; bytes += n, size -= n) {
+			crc = ::crc32(crc, bytes, n = std::min(size, size_t(1) << 30));
+		}
+
+		return crc;
+	}
+
+	static size_t GetDataOffset(size_t numSections) { return (sizeof(Header) + numSections * sizeof(std::uint64_t)); }
+
+
+	bool Read(const std::string& fileName, std::uint32_t hashCode, const std::vector<Section>& sections)
+	{
+		const std::string filePath = dataDirsAccess.LocateFile(fileName);
+
+		if (!FileSystem::FileExists(filePath))
+			return false;
+
+		const CFileView view = CFileView::MapFile(filePath);
+		const size_t dataOffset = GetDataOffset(sections.size());
+
+		if (!view.IsValid() || view.size() < dataOffset) {
+			LOG_L(L_WARNING, "[PathCacheFile::%s] file \"%s\" is truncated", __func__, filePath.c_str());
+			return false;
+		}
+
+		Header header;
+		std::memcpy(&header, view.data(), sizeof(header));
+
+		if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != FORMAT_VERSION) {
+			LOG_L(L_WARNING, "[PathCacheFile::%s] file \"%s\" has an unknown format", __func__, filePath.c_str());
+			return false;
+		}
+		if (header.hashCode != hashCode || header.numSections != sections.size()) {
+			LOG_L(L_WARNING, "[PathCacheFile::%s] file \"%s\" is stale (hash=%x, expected %x)", __func__, filePath.c_str(), header.hashCode, hashCode);
+			return false;
+		}
+
+		size_t dataSize = 0;
+
+		for (size_t i = 0; i < sections.size(); i++) {
+			std::uint64_t sectionSize = 0;
+			std::memcpy(&sectionSize, view.data() + sizeof(Header) + i * sizeof(sectionSize), sizeof(sectionSize));
+
+			if (sectionSize != sections[i].size) {
+				LOG_L(L_WARNING, "[PathCacheFile::%s] file \"%s\" has a mismatching section %u", __func__, filePath.c_str(), unsigned(i));
+				return false;
+			}
+
+			dataSize += sectionSize;
+		}
+
+		if (view.size() != (dataOffset + dataSize)) {
+			LOG_L(L_WARNING, "[PathCacheFile::%s] file \"%s\" is truncated", __func__, filePath.c_str());
+			return false;
+		}
+
+		// verify before touching the destination, which stays intact on failure
+		const std::uint32_t dataCRC = CalcCRC(::crc32(0L, Z_NULL, 0), view.data() + dataOffset, dataSize);
+
+		if (dataCRC != header.dataCRC) {
+			LOG_L(L_WARNING, "[PathCacheFile::%s] file \"%s\" is corrupt", __func__, filePath.c_str());
+			return false;
+		}
+
+		for (size_t i = 0, pos = dataOffset; i < sections.size(); pos += sections[i++].size) {
+			std::memcpy(sections[i].data, view.data() + pos, sections[i].size);
+		}
+
+		return true;
+	}
+
+
+	bool Write(const std::string& fileName, std::uint32_t hashCode, const std::vector<Section>& sections)
+	{
+		if (!FileSystem::CreateDirectory(FileSystem::GetDirectory(fileName)))
+			return false;
+
+		const std::string filePath = dataDirsAccess.LocateFile(fileName, FileQueryFlags::WRITE);
+		// other processes might read (or write) the same cache concurrently
+		const std::string tempPath = filePath + ".tmp";
+
+		Header header;
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+
+		header.version = FORMAT_VERSION;
+		header.hashCode = hashCode;
+		header.dataCRC = ::crc32(0L, Z_NULL, 0);
+		header.numSections = sections.size();
+
+		for (const Section& s: sections) {
+			header.dataCRC = CalcCRC(header.dataCRC, s.data, s.size);
+		}
+
+		FILE* file = fopen(tempPath.c_str(), "wb");
+
+		if (file == nullptr)
+			return false;
+
+		bool ret = (fwrite(&header, sizeof(header), 1, file) == 1);
+
+		for (const Section& s: sections) {
+			const std::uint64_t sectionSize = s.size;
+			ret &= (fwrite(&sectionSize, sizeof(sectionSize), 1, file) == 1);
+		}
+		for (const Section& s: sections) {
+			ret &= (s.size == 0 || fwrite(s.data, s.size, 1, file) == 1);
+		}
+
+		ret &= (fclose(file) != EOF);
+
+		if (ret) {
+			#ifdef _WIN32
+			// rename does not replace existing files here
+			std::remove(filePath.c_str());
+			#endif
+			ret = (std::rename(tempPath.c_str(), filePath.c_str()) == 0);
+		}
+
+		if (!ret) {
+			LOG_L(L_WARNING, "[PathCacheFile::%s] could not write \"%s\"", __func__, filePath.c_str());
+			std::remove(tempPath.c_str());
+		}
+
+		return ret;
+	}
+};
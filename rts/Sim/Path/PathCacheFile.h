@@ -0,0 +1,38 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef PATH_CACHE_FILE_H
+#define PATH_CACHE_FILE_H
+
+#include <cinttypes>
+#include <string>
+#include <vector>
+
+/**
+ * Uncompressed on-disk format of the path-estimator caches.
+ *
+ * A file is a fixed header followed by the raw bytes of each section, so
+ * reading one is a mapping plus a memcpy per section with no parsing. The
+ * header records the format version, the estimator's hash-code (derived
+ * from the map and movedef checksums) and every section's size, and holds
+ * a CRC32 of the payload; a file which does not match in all of these is
+ * rejected, which also makes caches safe to distribute with maps (any
+ * data-directory's cache/paths/ is searched, not only the writable one).
+ */
+namespace PathCacheFile {
+	static constexpr std::uint32_t FORMAT_VERSION = 1;
+
+	struct Section {
+		void* data;
+		size_t size;
+	};
+
+	/**
+	 * Fills <sections> from <fileName> (relative to the data-dirs).
+	 * @return false if the file is missing or does not match <hashCode>
+	 *   and the section sizes, nothing is modified in that case
+	 */
+	bool Read(const std::string& fileName, std::uint32_t hashCode, const std::vector<Section>& sections);
+	bool Write(const std::string& fileName, std::uint32_t hashCode, const std::vector<Section>& sections);
+};
+
+#endif
@@ -1,6 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 #include <limits>
+#include <vector>
 
 #include "NodeLayer.hpp"
 #include "PathManager.hpp"
@@ -17,6 +18,51 @@ float        QTPFS::NodeLayer::MIN_SPEEDMOD_VALUE;
 float        QTPFS::NodeLayer::MAX_SPEEDMOD_VALUE;
 
 
+// snapshot the terrain-state of rows [zmin, zmax) within <r>, bulk-evaluated
+// per band instead of per square; footprint centers are clamped s.t. map edges
+// are not tesselated when the footprint would extend across them in IsBlocked*
+static void GetSquareStates(
+	const SRectangle& r,
+	const MoveDef* md,
+	int zmin,
+	int zmax,
+	std::vector<float>& speedMods,
+	std::vector<  int>& blockBits
+) {
+	static thread_local std::vector<uint8_t> blockedCenters;
+
+	const int numCols = r.GetWidth();
+	const int numRows = zmax - zmin;
+
+	speedMods.resize(numCols * numRows);
+	blockBits.resize(numCols * numRows);
+
+	if (numCols <= 0 || numRows <= 0)
+		return;
+
+	// clamping is monotonic, so all centers lie within these (half-open) ranges
+	const int cxmin = Clamp(r.x1    , md->xsizeh, r.x2 - md->xsizeh - 1);
+	const int czmin = Clamp(zmin    , md->zsizeh, r.z2 - md->zsizeh - 1);
+	const int cxmax = Clamp(r.x2 - 1, md->xsizeh, r.x2 - md->xsizeh - 1) + 1;
+	const int czmax = Clamp(zmax - 1, md->zsizeh, r.z2 - md->zsizeh - 1) + 1;
+
+	blockedCenters.resize((cxmax - cxmin) * (czmax - czmin));
+
+	CMoveMath::GetPosSpeedMods(*md, r.x1, r.x2, zmin, zmax, speedMods.data());
+	CMoveMath::GetBlockedStructures(*md, cxmin, cxmax, czmin, czmax, blockedCenters.data());
+
+	for (int hmz = zmin; hmz < zmax; hmz++) {
+		const int chmz = Clamp(hmz, md->zsizeh, r.z2 - md->zsizeh - 1);
+
+		for (int hmx = r.x1; hmx < r.x2; hmx++) {
+			const int chmx = Clamp(hmx, md->xsizeh, r.x2 - md->xsizeh - 1);
+
+			blockBits[(hmz - zmin) * numCols + (hmx - r.x1)] = CMoveMath::BLOCK_STRUCTURE * blockedCenters[(chmz - czmin) * (cxmax - cxmin) + (chmx - cxmin)];
+		}
+	}
+}
+
+
 
 void QTPFS::NodeLayer::InitStatic() {
 	NUM_SPEEDMOD_BINS  = std::max(  1u, mapInfo->pfs.qtpfs_constants.numSpeedModBins);
@@ -82,23 +128,10 @@ void QTPFS::NodeLayer::QueueUpdate(const SRectangle& r, const MoveDef* md) {
 	// the first update MUST have a non-zero counter
 	// since all nodes are at 0 after initialization
 	layerUpdate.rectangle = r;
-	layerUpdate.speedMods.resize(r.GetArea());
-	layerUpdate.blockBits.resize(r.GetArea());
 	layerUpdate.counter = ++updateCounter;
 
 	// make a snapshot of the terrain-state within <r>
-	for (unsigned int hmz = r.z1; hmz < r.z2; hmz++) {
-		for (unsigned int hmx = r.x1; hmx < r.x2; hmx++) {
-			const unsigned int recIdx = (hmz - r.z1) * r.GetWidth() + (hmx - r.x1);
-
-			const unsigned int chmx = Clamp(int(hmx), md->xsizeh, r.x2 - md->xsizeh - 1);
-			const unsigned int chmz = Clamp(int(hmz), md->zsizeh, r.z2 - md->zsizeh - 1);
-
-			layerUpdate.speedMods[recIdx] = CMoveMath::GetPosSpeedMod(*md, hmx, hmz);
-			layerUpdate.blockBits[recIdx] = CMoveMath::IsBlockedNoSpeedModCheck(*md, chmx, chmz, nullptr);
-			// layerUpdate.blockBits[recIdx] = CMoveMath::SquareIsBlocked(*md, hmx, hmz, nullptr);
-		}
-	}
+	GetSquareStates(r, md, r.z1, r.z2, layerUpdate.speedMods, layerUpdate.blockBits);
 }
 
 bool QTPFS::NodeLayer::ExecQueuedUpdate() {
@@ -134,18 +167,36 @@ bool QTPFS::NodeLayer::Update(
 		avgRelSpeedMod = 0.0f;
 	}
 
+	// without a snapshot, terrain-state is evaluated in bands of rows
+	// to bound the size of the scratch-buffers for global updates
+	constexpr unsigned int BAND_SIZE = 64;
+
+	static thread_local std::vector<float> bandSpeedMods;
+	static thread_local std::vector<  int> bandBlockBits;
+
 	// divide speed-modifiers into bins
 	for (unsigned int hmz = r.z1; hmz < r.z2; hmz++) {
+		const float* rowSpeedMods = nullptr;
+		const   int* rowBlockBits = nullptr;
+
+		if (luSpeedMods == nullptr) {
+			const unsigned int bandRow = (hmz - r.z1) % BAND_SIZE;
+
+			if (bandRow == 0)
+				GetSquareStates(r, md, hmz, std::min(hmz + BAND_SIZE, unsigned(r.z2)), bandSpeedMods, bandBlockBits);
+
+			rowSpeedMods = &bandSpeedMods[bandRow * r.GetWidth()];
+			rowBlockBits = &bandBlockBits[bandRow * r.GetWidth()];
+		} else {
+			rowSpeedMods = &(*luSpeedMods)[(hmz - r.z1) * r.GetWidth()];
+			rowBlockBits = &(*luBlockBits)[(hmz - r.z1) * r.GetWidth()];
+		}
+
 		for (unsigned int hmx = r.x1; hmx < r.x2; hmx++) {
 			const unsigned int sqrIdx = hmz * xsize + hmx;
-			const unsigned int recIdx = (hmz - r.z1) * r.GetWidth() + (hmx - r.x1);
-
-			// don't tesselate map edges when footprint extends across them in IsBlocked*
-			const unsigned int chmx = Clamp(int(hmx), md->xsizeh, r.x2 - md->xsizeh - 1);
-			const unsigned int chmz = Clamp(int(hmz), md->zsizeh, r.z2 - md->zsizeh - 1);
 
-			const float minSpeedMod = (luSpeedMods == nullptr)? CMoveMath::GetPosSpeedMod(*md, hmx, hmz): (*luSpeedMods)[recIdx];
-			const   int maxBlockBit = (luBlockBits == nullptr)? CMoveMath::IsBlockedNoSpeedModCheck(*md, chmx, chmz, nullptr): (*luBlockBits)[recIdx];
+			const float minSpeedMod = rowSpeedMods[hmx - r.x1];
+			const   int maxBlockBit = rowBlockBits[hmx - r.x1];
 			// NOTE:
 			//   movetype code checks ONLY the *CENTER* square of a unit's footprint
 			//   to get the current speedmod affecting it, and the default pathfinder
@@ -14,6 +14,7 @@
 #include "Game/LoadScreen.h"
 #include "Map/MapInfo.h"
 #include "Sim/Misc/GlobalSynced.h"
+#include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Sim/MoveTypes/MoveDefHandler.h"
 #include "Sim/MoveTypes/MoveMath/MoveMath.h"
@@ -123,6 +124,8 @@ QTPFS::PathManager::PathManager() {
 }
 
 QTPFS::PathManager::~PathManager() {
+	JoinSearches();
+
 	for (unsigned int layerNum = 0; layerNum < nodeLayers.size(); layerNum++) {
 		nodeTrees[layerNum]->Merge(nodeLayers[layerNum]);
 		nodeLayers[layerNum].Clear();
@@ -196,6 +199,9 @@ void QTPFS::PathManager::Load() {
 	pathCaches.resize(moveDefHandler.GetNumMoveDefs());
 	pathSearches.resize(moveDefHandler.GetNumMoveDefs());
 
+	minPathTypeUpdate = 0;
+	maxPathTypeUpdate = std::min(static_cast<unsigned int>(nodeLayers.size()), LAYERS_PER_UPDATE);
+
 	// add one extra element for object-less requests
 	numCurrExecutedSearches.resize(teamHandler.ActiveTeams() + 1, 0);
 	numPrevExecutedSearches.resize(teamHandler.ActiveTeams() + 1, 0);
@@ -642,6 +648,9 @@ void QTPFS::PathManager::TerrainChange(unsigned int x1, unsigned int z1,  unsign
 	if (!IsFinalized())
 		return;
 
+	// layer-update queues and numTerrainChanges are read by pending searches
+	JoinSearches();
+
 	// if type is TERRAINCHANGE_OBJECT_INSERTED or TERRAINCHANGE_OBJECT_INSERTED_YM,
 	// this rectangle covers the yardmap of a CSolidObject* and will be tesselated to
 	// maximum depth automatically
@@ -666,6 +675,12 @@ void QTPFS::PathManager::TerrainChange(unsigned int x1, unsigned int z1,  unsign
 void QTPFS::PathManager::Update() {
 	SCOPED_TIMER("Sim::Path");
 
+	if (modInfo.qtpfsAsyncSearches) {
+		// searches dispatched last frame must be done before units read their paths
+		JoinSearches();
+		return;
+	}
+
 	#ifdef QTPFS_ENABLE_THREADED_UPDATE
 	streflop::streflop_init<streflop::Simple>();
 
@@ -683,6 +698,39 @@ void QTPFS::PathManager::Update() {
 	#endif
 }
 
+void QTPFS::PathManager::DispatchSearches() {
+	if (!modInfo.qtpfsAsyncSearches)
+		return;
+
+	SCOPED_TIMER("Sim::Path");
+
+	// requests made between Update and here (i.e. by units) are
+	// now pending; these execute while the rest of the sim frame
+	// runs and become visible to units one frame later, the only
+	// other readers and writers of their state join them first
+	//
+	// NOTE: dead-path searches read owner positions, so queue them here
+	JoinSearches();
+	QueueDeadPathSearches();
+
+	#ifdef THREADPOOL
+	asyncSearches = ThreadPool::Enqueue([this]() {
+		streflop::streflop_init<streflop::Simple>();
+		ExecuteQueuedSearches();
+	});
+	#else
+	ExecuteQueuedSearches();
+	#endif
+}
+
+void QTPFS::PathManager::JoinSearches() const {
+	if (asyncSearches == nullptr)
+		return;
+
+	asyncSearches->get();
+	asyncSearches.reset();
+}
+
 __FORCE_ALIGN_STACK__
 void QTPFS::PathManager::ThreadUpdate() {
 	#ifdef QTPFS_ENABLE_THREADED_UPDATE
@@ -699,53 +747,63 @@ void QTPFS::PathManager::ThreadUpdate() {
 			break;
 	#endif
 
-		// NOTE:
-		//     for a mod with N move-types, any unit will be waiting
-		//     (N / LAYERS_PER_UPDATE) sim-frames before its request
-		//     executes at a minimum
-		const unsigned int layersPerUpdateTmp = LAYERS_PER_UPDATE;
-		const unsigned int numPathTypeUpdates = std::min(static_cast<unsigned int>(nodeLayers.size()), layersPerUpdateTmp);
-
-		// NOTE: thread-safe (only ONE thread ever accesses these)
-		static unsigned int minPathTypeUpdate = 0;
-		static unsigned int maxPathTypeUpdate = numPathTypeUpdates;
+		QueueDeadPathSearches();
+		ExecuteQueuedSearches();
 
-		sharedPaths.clear();
+	#ifdef QTPFS_ENABLE_THREADED_UPDATE
+		// tell Update we are finished with this iteration
+		condThreadUpdated.notify_one();
+	}
+	#endif
+}
 
-		for (unsigned int pathTypeUpdate = minPathTypeUpdate; pathTypeUpdate < maxPathTypeUpdate; pathTypeUpdate++) {
-			#ifndef QTPFS_IGNORE_DEAD_PATHS
-			QueueDeadPathSearches(pathTypeUpdate);
-			#endif
 
-			#ifdef QTPFS_STAGGERED_LAYER_UPDATES
-			// NOTE: *must* be called between QueueDeadPathSearches and ExecuteQueuedSearches
-			ExecQueuedNodeLayerUpdates(pathTypeUpdate, !pathSearches[pathTypeUpdate].empty());
-			#endif
 
-			ExecuteQueuedSearches(pathTypeUpdate);
-		}
+void QTPFS::PathManager::QueueDeadPathSearches() {
+	#ifndef QTPFS_IGNORE_DEAD_PATHS
+	for (unsigned int pathTypeUpdate = minPathTypeUpdate; pathTypeUpdate < maxPathTypeUpdate; pathTypeUpdate++) {
+		QueueDeadPathSearches(pathTypeUpdate);
+	}
+	#endif
+}
 
-		std::copy(numCurrExecutedSearches.begin(), numCurrExecutedSearches.end(), numPrevExecutedSearches.begin());
+void QTPFS::PathManager::ExecuteQueuedSearches() {
+	// NOTE:
+	//     for a mod with N move-types, any unit will be waiting
+	//     (N / LAYERS_PER_UPDATE) sim-frames before its request
+	//     executes at a minimum
+	const unsigned int layersPerUpdateTmp = LAYERS_PER_UPDATE;
+	const unsigned int numPathTypeUpdates = std::min(static_cast<unsigned int>(nodeLayers.size()), layersPerUpdateTmp);
 
-		minPathTypeUpdate = (minPathTypeUpdate + numPathTypeUpdates);
-		maxPathTypeUpdate = (minPathTypeUpdate + numPathTypeUpdates);
+	sharedPaths.clear();
 
-		if (minPathTypeUpdate >= nodeLayers.size()) {
-			minPathTypeUpdate = 0;
-			maxPathTypeUpdate = numPathTypeUpdates;
-		}
-		if (maxPathTypeUpdate >= nodeLayers.size()) {
-			maxPathTypeUpdate = nodeLayers.size();
-		}
+	#ifdef QTPFS_STAGGERED_LAYER_UPDATES
+	// NOTE: *must* be called between QueueDeadPathSearches and ExecuteQueuedSearches
+	// layers (and their trees and path-caches) are independent of each other and
+	// updates replay terrain snapshots taken by TerrainChange, so the re-tesselation
+	// of all layers due this frame can run in parallel (as it does at load-time)
+	for_mt(minPathTypeUpdate, maxPathTypeUpdate, [this](const int layerNum) {
+		ExecQueuedNodeLayerUpdates(layerNum, !pathSearches[layerNum].empty());
+	});
+	#endif
 
-	#ifdef QTPFS_ENABLE_THREADED_UPDATE
-		// tell Update we are finished with this iteration
-		condThreadUpdated.notify_one();
+	for (unsigned int pathTypeUpdate = minPathTypeUpdate; pathTypeUpdate < maxPathTypeUpdate; pathTypeUpdate++) {
+		ExecuteQueuedSearches(pathTypeUpdate);
 	}
-	#endif
-}
 
+	std::copy(numCurrExecutedSearches.begin(), numCurrExecutedSearches.end(), numPrevExecutedSearches.begin());
 
+	minPathTypeUpdate = (minPathTypeUpdate + numPathTypeUpdates);
+	maxPathTypeUpdate = (minPathTypeUpdate + numPathTypeUpdates);
+
+	if (minPathTypeUpdate >= nodeLayers.size()) {
+		minPathTypeUpdate = 0;
+		maxPathTypeUpdate = numPathTypeUpdates;
+	}
+	if (maxPathTypeUpdate >= nodeLayers.size()) {
+		maxPathTypeUpdate = nodeLayers.size();
+	}
+}
 
 void QTPFS::PathManager::ExecuteQueuedSearches(unsigned int pathType) {
 	NodeLayer& nodeLayer = nodeLayers[pathType];
@@ -942,6 +1000,8 @@ unsigned int QTPFS::PathManager::QueueSearch(
 
 
 void QTPFS::PathManager::UpdatePath(const CSolidObject* owner, unsigned int pathID) {
+	JoinSearches();
+
 	const PathTypeMapIt pathTypeIt = pathTypes.find(pathID);
 
 	if (pathTypeIt != pathTypes.end()) {
@@ -955,6 +1015,8 @@ void QTPFS::PathManager::UpdatePath(const CSolidObject* owner, unsigned int path
 }
 
 void QTPFS::PathManager::DeletePath(unsigned int pathID) {
+	JoinSearches();
+
 	const PathTypeMapIt pathTypeIt = pathTypes.find(pathID);
 	const PathTraceMapIt pathTraceIt = pathTraces.find(pathID);
 
@@ -985,12 +1047,16 @@ unsigned int QTPFS::PathManager::RequestPath(
 	if (!IsFinalized())
 		return 0;
 
+	JoinSearches();
+
 	return (QueueSearch(nullptr, object, moveDef, sourcePoint, targetPoint, radius, synced));
 }
 
 
 
 bool QTPFS::PathManager::PathUpdated(unsigned int pathID) {
+	JoinSearches();
+
 	const PathTypeMapIt pathTypeIt = pathTypes.find(pathID);
 
 	if (pathTypeIt == pathTypes.end())
@@ -1022,6 +1088,8 @@ float3 QTPFS::PathManager::NextWayPoint(
 	// in misc since it is called from many points
 	SCOPED_TIMER("Misc::Path::NextWayPoint");
 
+	JoinSearches();
+
 	const PathTypeMap::const_iterator pathTypeIt = pathTypes.find(pathID);
 	const float3 noPathPoint = -XZVector;
 
@@ -1123,6 +1191,8 @@ void QTPFS::PathManager::GetPathWayPoints(
 	std::vector<float3>& points,
 	std::vector<int>& starts
 ) const {
+	JoinSearches();
+
 	const PathTypeMap::const_iterator pathTypeIt = pathTypes.find(pathID);
 
 	if (!IsFinalized())
@@ -1148,6 +1218,8 @@ void QTPFS::PathManager::GetPathWayPoints(
 int2 QTPFS::PathManager::GetNumQueuedUpdates() const {
 	int2 data;
 
+	JoinSearches();
+
 	#ifdef QTPFS_STAGGERED_LAYER_UPDATES
 	if (IsFinalized()) {
 		for (unsigned int layerNum = 0; layerNum < nodeLayers.size(); layerNum++) {
@@ -3,6 +3,8 @@
 #ifndef QTPFS_PATHMANAGER_HDR
 #define QTPFS_PATHMANAGER_HDR
 
+#include <future>
+#include <memory>
 #include <vector>
 
 #include "Sim/Path/IPathManager.h"
@@ -41,6 +43,7 @@ namespace QTPFS {
 
 		void TerrainChange(unsigned int x1, unsigned int z1,  unsigned int x2, unsigned int z2, unsigned int type) override;
 		void Update() override;
+		void DispatchSearches() override;
 		void UpdatePath(const CSolidObject* owner, unsigned int pathID) override;
 		void DeletePath(unsigned int pathID) override;
 
@@ -71,12 +74,13 @@ namespace QTPFS {
 		int2 GetNumQueuedUpdates() const override;
 
 
-		const NodeLayer& GetNodeLayer(unsigned int pathType) const { return nodeLayers[pathType]; }
-		const QTNode* GetNodeTree(unsigned int pathType) const { return nodeTrees[pathType]; }
-		const PathCache& GetPathCache(unsigned int pathType) const { return pathCaches[pathType]; }
+		// drawer accessors, these must not race with asynchronous searches
+		const NodeLayer& GetNodeLayer(unsigned int pathType) const { JoinSearches(); return nodeLayers[pathType]; }
+		const QTNode* GetNodeTree(unsigned int pathType) const { JoinSearches(); return nodeTrees[pathType]; }
+		const PathCache& GetPathCache(unsigned int pathType) const { JoinSearches(); return pathCaches[pathType]; }
 
-		const spring::unordered_map<unsigned int, unsigned int>& GetPathTypes() const { return pathTypes; }
-		const spring::unordered_map<unsigned int, PathSearchTrace::Execution*>& GetPathTraces() const { return pathTraces; }
+		const spring::unordered_map<unsigned int, unsigned int>& GetPathTypes() const { JoinSearches(); return pathTypes; }
+		const spring::unordered_map<unsigned int, PathSearchTrace::Execution*>& GetPathTraces() const { JoinSearches(); return pathTraces; }
 
 	private:
 		void ThreadUpdate();
@@ -121,9 +125,14 @@ namespace QTPFS {
 		void ExecQueuedNodeLayerUpdates(unsigned int layerNum, bool flushQueue);
 		#endif
 
+		void ExecuteQueuedSearches();
 		void ExecuteQueuedSearches(unsigned int pathType);
+		void QueueDeadPathSearches();
 		void QueueDeadPathSearches(unsigned int pathType);
 
+		// waits for the searches started by DispatchSearches
+		void JoinSearches() const;
+
 		unsigned int QueueSearch(
 			const IPath* oldPath,
 			const CSolidObject* object,
@@ -162,9 +171,18 @@ namespace QTPFS {
 		std::vector<unsigned int> numCurrExecutedSearches;
 		std::vector<unsigned int> numPrevExecutedSearches;
 
+		// searches handed to the pool by DispatchSearches (if the
+		// system.qtpfsAsyncSearches modrule is enabled); joined by
+		// the next Update or any earlier call touching their state
+		mutable std::shared_ptr< std::future<void> > asyncSearches;
+
 		static unsigned int LAYERS_PER_UPDATE;
 		static unsigned int MAX_TEAM_SEARCHES;
 
+		// range of layers whose searches the next update executes
+		unsigned int minPathTypeUpdate;
+		unsigned int maxPathTypeUpdate;
+
 		unsigned int searchStateOffset;
 		unsigned int numTerrainChanges;
 		unsigned int numPathRequests;
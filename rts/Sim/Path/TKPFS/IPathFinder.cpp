@@ -23,7 +23,7 @@ void IPathFinder::InitStatic() { pathFinderInstances.reserve(8); }
 void IPathFinder::KillStatic() { pathFinderInstances.clear  ( ); }
 
 
-void IPathFinder::Init(unsigned int _BLOCK_SIZE)
+void IPathFinder::Init(unsigned int _BLOCK_SIZE, bool keepGCosts)
 {
 	{
 		BLOCK_SIZE = _BLOCK_SIZE;
@@ -54,7 +54,7 @@ void IPathFinder::Init(unsigned int _BLOCK_SIZE)
 		pathFinderInstances.push_back(this);
 	}
 
-	AllocStateBuffer();
+	AllocStateBuffer(keepGCosts);
 	ResetSearch();
 }
 
@@ -66,13 +66,13 @@ void IPathFinder::Kill()
 }
 
 
-void IPathFinder::AllocStateBuffer()
+void IPathFinder::AllocStateBuffer(bool keepGCosts)
 {
 	if (instanceIndex >= nodeStateBuffers.size())
 		nodeStateBuffers.emplace_back();
 
 	nodeStateBuffers[instanceIndex].Clear();
-	nodeStateBuffers[instanceIndex].Resize(nbrOfBlocks, int2(mapDims.mapx, mapDims.mapy));
+	nodeStateBuffers[instanceIndex].Resize(nbrOfBlocks, int2(mapDims.mapx, mapDims.mapy), keepGCosts);
 
 	// steal memory, returned in dtor
 	blockStates = std::move(nodeStateBuffers[instanceIndex]);
@@ -149,6 +149,25 @@ IPath::SearchResult IPathFinder::GetPath(
 		return ci.result;
 	}
 
+	// while the MT request phase runs, identical searches are done only once
+	CSharedPathCache* sharedCache = TKPFS::PathingSystemActive? GetSharedCache(pfDef.synced): nullptr;
+
+	const int requestIdx = TKPFS::GetPathRequestIndex();
+
+	if (sharedCache != nullptr && requestIdx >= 0) {
+		if (sharedCache->Claim(requestIdx, mStartBlock, goalBlock, pfDef.sqGoalRadius, moveDef.pathType)) {
+			const IPath::SearchResult result = InitSearch(moveDef, pfDef, owner);
+
+			if (result == IPath::Ok || result == IPath::GoalOutOfRange)
+				FinishSearch(moveDef, pfDef, path);
+
+			sharedCache->Publish(requestIdx, path, result, mStartBlock, goalBlock, pfDef.sqGoalRadius, moveDef.pathType);
+		}
+
+		// our own result only counts if no lower request wants the same search
+		return (sharedCache->Wait(TKPFS::GetPathRequestOrder(), path, mStartBlock, goalBlock, pfDef.sqGoalRadius, moveDef.pathType));
+	}
+
 	// start up a new search
 	const IPath::SearchResult result = InitSearch(moveDef, pfDef, owner);
 
@@ -264,7 +283,7 @@ IPath::SearchResult IPathFinder::InitSearch(const MoveDef& moveDef, const CPathF
 	blockStates.nodeMask[mStartBlockIdx] &= PATHOPT_OBSOLETE;
 	blockStates.nodeMask[mStartBlockIdx] |= PATHOPT_OPEN;
 	blockStates.fCost[mStartBlockIdx] = 0.0f;
-	blockStates.gCost[mStartBlockIdx] = 0.0f;
+	blockStates.SetGCost(mStartBlockIdx, 0.0f);
 	blockStates.SetMaxCost(NODE_COST_F, 0.0f);
 	blockStates.SetMaxCost(NODE_COST_G, 0.0f);
 
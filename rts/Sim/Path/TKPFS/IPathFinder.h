@@ -20,7 +20,8 @@ class IPathFinder {
 public:
 	virtual ~IPathFinder() {}
 
-	void Init(unsigned int BLOCK_SIZE);
+	/// <keepGCosts> is false for instances whose node-states are never drawn
+	void Init(unsigned int BLOCK_SIZE, bool keepGCosts = true);
 	void Kill();
 
 	static void InitStatic();
@@ -74,7 +75,7 @@ public:
 protected:
 	IPath::SearchResult InitSearch(const MoveDef&, const CPathFinderDef&, const CSolidObject* owner);
 
-	void AllocStateBuffer();
+	void AllocStateBuffer(bool keepGCosts);
 	/// Clear things up from last search.
 	void ResetSearch();
 
@@ -123,6 +124,9 @@ protected:
 		const bool synced
 	) = 0;
 
+	// searches shared between worker threads during the MT request phase
+	virtual CSharedPathCache* GetSharedCache(const bool synced) const { return nullptr; }
+
 public:
 	// if larger than 1, this IPF is an estimator
 	unsigned int BLOCK_SIZE = 0;
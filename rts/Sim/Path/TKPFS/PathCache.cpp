@@ -1,6 +1,7 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
 #include <algorithm>
+#include <cassert>
 
 #include "PathCache.h"
 #include "Sim/Misc/GlobalConstants.h"
@@ -203,4 +204,156 @@ bool CPathCache::HashCollision(
 	return hashColl;
 }
 
-}
\ No newline at end of file
+
+
+void CPathRequestOrder::Reset(int numReqs)
+{
+	if (numReqs > maxRequests)
+		finished.reset(new std::atomic<bool>[maxRequests = numReqs]);
+
+	for (int i = 0; i < numReqs; i++) {
+		finished[i].store(false, std::memory_order_relaxed);
+	}
+
+	numRequests = numReqs;
+	lowWaterMark.store(0, std::memory_order_release);
+}
+
+bool CPathRequestOrder::AllFinishedBefore(int requestIdx)
+{
+	assert(requestIdx <= numRequests);
+
+	int mark = lowWaterMark.load(std::memory_order_acquire);
+
+	while (mark < requestIdx) {
+		if (!finished[mark].load(std::memory_order_acquire))
+			return false;
+
+		// on failure another thread advanced the mark and <mark> is reloaded
+		if (lowWaterMark.compare_exchange_weak(mark, mark + 1))
+			mark += 1;
+	}
+
+	return true;
+}
+
+
+void CSharedPathCache::Clear()
+{
+	for (Shard& shard: shards) {
+		const std::lock_guard<spring::mutex> lock(shard.mutex);
+		shard.items.clear();
+	}
+}
+
+CSharedPathCache::SharedItem* CSharedPathCache::FindItem(
+	Shard& shard,
+	std::uint64_t hash,
+	const int2 strtBlock,
+	const int2 goalBlock,
+	float goalRadius,
+	int pathType
+) {
+	const auto iter = shard.items.find(hash);
+
+	if (iter == shard.items.end())
+		return nullptr;
+
+	for (SharedItem& item: iter->second) {
+		const CPathCache::CacheItem& ci = item.cacheItem;
+
+		if (ci.strtBlock != strtBlock || ci.goalBlock != goalBlock)
+			continue;
+		if (ci.goalRadius != goalRadius || ci.pathType != pathType)
+			continue;
+
+		return &item;
+	}
+
+	return nullptr;
+}
+
+bool CSharedPathCache::Claim(
+	const int requestIdx,
+	const int2 strtBlock,
+	const int2 goalBlock,
+	float goalRadius,
+	int pathType
+) {
+	const std::uint64_t hash = pathCache->GetHash(strtBlock, goalBlock, goalRadius, pathType);
+	Shard& shard = GetShard(hash);
+
+	const std::lock_guard<spring::mutex> lock(shard.mutex);
+	SharedItem* item = FindItem(shard, hash, strtBlock, goalBlock, goalRadius, pathType);
+
+	if (item == nullptr) {
+		shard.items[hash].push_back({{IPath::Error, {}, strtBlock, goalBlock, goalRadius, pathType}, requestIdx, -1});
+		return true;
+	}
+
+	// a higher request got here first; take over so its result is discarded
+	if (requestIdx < item->ownerIdx) {
+		item->ownerIdx = requestIdx;
+		return true;
+	}
+
+	return false;
+}
+
+void CSharedPathCache::Publish(
+	const int requestIdx,
+	const IPath::Path& path,
+	const IPath::SearchResult result,
+	const int2 strtBlock,
+	const int2 goalBlock,
+	float goalRadius,
+	int pathType
+) {
+	const std::uint64_t hash = pathCache->GetHash(strtBlock, goalBlock, goalRadius, pathType);
+	Shard& shard = GetShard(hash);
+
+	const std::lock_guard<spring::mutex> lock(shard.mutex);
+	SharedItem* item = FindItem(shard, hash, strtBlock, goalBlock, goalRadius, pathType);
+
+	assert(item != nullptr);
+
+	if (item->ownerIdx != requestIdx)
+		return;
+
+	item->cacheItem.result = result;
+	item->cacheItem.path = path;
+	item->resultIdx = requestIdx;
+}
+
+IPath::SearchResult CSharedPathCache::Wait(
+	CPathRequestOrder& requestOrder,
+	IPath::Path& path,
+	const int2 strtBlock,
+	const int2 goalBlock,
+	float goalRadius,
+	int pathType
+) {
+	const std::uint64_t hash = pathCache->GetHash(strtBlock, goalBlock, goalRadius, pathType);
+	Shard& shard = GetShard(hash);
+
+	// cannot deadlock, owners never have a higher index than their waiters
+	// and all lower indices were picked up by some thread before this one
+	while (true) {
+		{
+			const std::lock_guard<spring::mutex> lock(shard.mutex);
+			const SharedItem* item = FindItem(shard, hash, strtBlock, goalBlock, goalRadius, pathType);
+
+			assert(item != nullptr);
+
+			// until every lower request completed, one of them might still claim the search
+			if (item->resultIdx == item->ownerIdx && requestOrder.AllFinishedBefore(item->ownerIdx)) {
+				path = item->cacheItem.path;
+				return item->cacheItem.result;
+			}
+		}
+
+		spring::this_thread::yield();
+	}
+}
+
+}
@@ -3,12 +3,17 @@
 #ifndef TKPFS_PATHCACHE_H
 #define TKPFS_PATHCACHE_H
 
+#include <array>
+#include <atomic>
 #include <deque>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "Sim/Path/Default/IPath.h"
 #include "System/type2.h"
 #include "System/UnorderedMap.hpp"
+#include "System/Threading/SpringThreading.h"
 
 namespace TKPFS {
 
@@ -44,9 +49,6 @@ public:
 		int pathType
 	);
 
-private:
-	void RemoveFrontQueItem();
-
 	std::uint64_t GetHash(
 		const int2 strtBlk,
 		const int2 goalBlk,
@@ -54,6 +56,9 @@ private:
 		std::int32_t pathType
 	) const;
 
+private:
+	void RemoveFrontQueItem();
+
 	bool HashCollision(
 		const CacheItem& ci,
 		const int2 strtBlk,
@@ -91,6 +96,111 @@ private:
 	std::uint32_t numHashCollisions;
 };
 
+
+/**
+ * Tracks which requests of the multi-threaded path request phase (see
+ * CUnitHandler::MultiThreadPathRequests) have completed. Requests are
+ * identified by their for_mt index, which workers pick up in ascending
+ * order.
+ */
+class CPathRequestOrder
+{
+public:
+	void Reset(int numRequests);
+	void SetFinished(int requestIdx) { finished[requestIdx].store(true, std::memory_order_release); }
+
+	// true once every request with an index below <requestIdx> has completed
+	bool AllFinishedBefore(int requestIdx);
+
+private:
+	std::unique_ptr<std::atomic<bool>[]> finished;
+	std::atomic<int> lowWaterMark = {0};
+
+	int numRequests = 0;
+	int maxRequests = 0;
+};
+
+
+/**
+ * Cache shared by all worker threads during the multi-threaded request
+ * phase, so identical searches issued by (e.g.) a group of units moving
+ * to the same point are only done once. Searches are not pure functions
+ * of the cache key (they also depend on the exact start position and the
+ * owner), hence every request receives the result computed by the lowest
+ * request index asking for the same key; this makes the outcome of the
+ * phase independent of thread count and timing.
+ */
+class CSharedPathCache
+{
+public:
+	CSharedPathCache(const CPathCache* cache): pathCache(cache) {}
+
+	void Clear();
+
+	// returns true if the caller has to run the search and Publish it
+	bool Claim(
+		const int requestIdx,
+		const int2 strtBlock,
+		const int2 goalBlock,
+		float goalRadius,
+		int pathType
+	);
+
+	void Publish(
+		const int requestIdx,
+		const IPath::Path& path,
+		const IPath::SearchResult result,
+		const int2 strtBlock,
+		const int2 goalBlock,
+		float goalRadius,
+		int pathType
+	);
+
+	// blocks until the result of the lowest claiming request is final
+	IPath::SearchResult Wait(
+		CPathRequestOrder& requestOrder,
+		IPath::Path& path,
+		const int2 strtBlock,
+		const int2 goalBlock,
+		float goalRadius,
+		int pathType
+	);
+
+private:
+	struct SharedItem {
+		CPathCache::CacheItem cacheItem;
+
+		int ownerIdx; // lowest request that claimed the search
+		int resultIdx; // request whose result is stored, -1 if none yet
+	};
+
+	struct Shard {
+		spring::mutex mutex;
+
+		// hash collisions (non-integer radii) share a slot
+		spring::unordered_map<std::uint64_t, std::vector<SharedItem>> items;
+	};
+
+	static constexpr int NUM_SHARDS = 32;
+
+	Shard& GetShard(std::uint64_t hash) { return shards[hash % NUM_SHARDS]; }
+
+	SharedItem* FindItem(
+		Shard& shard,
+		std::uint64_t hash,
+		const int2 strtBlock,
+		const int2 goalBlock,
+		float goalRadius,
+		int pathType
+	);
+
+private:
+	std::array<Shard, NUM_SHARDS> shards;
+
+	// only used for hashing
+	const CPathCache* pathCache;
+};
+
 }
 
 #endif
@@ -78,6 +78,12 @@ void CPathEstimator::AddCache(const IPath::Path* path, const IPath::SearchResult
 }
 
 
+CSharedPathCache* CPathEstimator::GetSharedCache(const bool synced) const
+{
+	return pathingState->GetSharedCache(synced);
+}
+
+
 IPath::SearchResult CPathEstimator::DoBlockSearch(
 	const CSolidObject* owner,
 	const MoveDef& moveDef,
@@ -436,7 +442,7 @@ bool CPathEstimator::TestBlock(
 
 	// mark this block as open
 	blockStates.fCost[testBlockIdx] = fCost;
-	blockStates.gCost[testBlockIdx] = gCost;
+	blockStates.SetGCost(testBlockIdx, gCost);
 	blockStates.nodeMask[testBlockIdx] |= (PathDir2PathOpt(pathDir) | PATHOPT_OPEN);
 
 	// if (debugLoggingActive == ThreadPool::GetThreadNum()){
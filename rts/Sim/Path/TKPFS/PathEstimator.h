@@ -95,6 +95,8 @@ protected: // IPathFinder impl
 		const bool synced
 	) override;
 
+	CSharedPathCache* GetSharedCache(const bool synced) const override;
+
 private:
 	void InitEstimator();
 	void InitBlocks();
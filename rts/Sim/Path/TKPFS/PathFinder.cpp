@@ -121,9 +121,9 @@ void CPathFinder::InitStatic() {
 }
 
 
-void CPathFinder::Init(bool threadSafe)
+void CPathFinder::Init(bool threadSafe, bool keepGCosts)
 {
-	IPathFinder::Init(1);
+	IPathFinder::Init(1, keepGCosts);
 
 	blockCheckFunc = blockCheckFuncs[threadSafe];
 	dummyCacheItem = CPathCache::CacheItem{IPath::Error, {}, {-1, -1}, {-1, -1}, -1.0f, -1};
@@ -483,7 +483,7 @@ bool CPathFinder::TestBlock(
 	blockStates.SetMaxCost(NODE_COST_G, std::max(blockStates.GetMaxCost(NODE_COST_G), gCost));
 
 	blockStates.fCost[sqrIdx] = os->fCost;
-	blockStates.gCost[sqrIdx] = os->gCost;
+	blockStates.SetGCost(sqrIdx, os->gCost);
 	blockStates.nodeMask[sqrIdx] |= (PATHOPT_OPEN | pathOptDir);
 
 	dirtyBlocks.push_back(sqrIdx);
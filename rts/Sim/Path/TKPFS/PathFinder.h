@@ -24,7 +24,7 @@ public:
 	CPathFinder() = default; // defer Init
 	CPathFinder(bool threadSafe) { Init(threadSafe); }
 
-	void Init(bool threadSafe);
+	void Init(bool threadSafe, bool keepGCosts = true);
 	void Kill() { IPathFinder::Kill(); }
 
 	typedef CMoveMath::BlockType (*BlockCheckFunc)(const MoveDef&, int, int, const CSolidObject*);
@@ -15,4 +15,20 @@ extern bool PathingSystemActive;
 
 #endif
 
-#endif
\ No newline at end of file
+namespace TKPFS {
+
+class CPathRequestOrder;
+
+// multi-threaded request phase bookkeeping, see CSharedPathCache
+void BeginPathRequests(int numRequests);
+void SetPathRequestIndex(int requestIdx);
+void FinishPathRequest(int requestIdx);
+
+// index of the request being processed by the calling thread, -1 if none
+int GetPathRequestIndex();
+
+CPathRequestOrder& GetPathRequestOrder();
+
+}
+
+#endif
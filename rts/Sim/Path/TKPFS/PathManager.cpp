@@ -14,6 +14,7 @@
 #include "Sim/Objects/SolidObject.h"
 #include "Sim/MoveTypes/MoveDefHandler.h"
 #include "System/Log/ILog.h"
+#include "System/MainDefines.h"
 #include "System/TimeProfiler.h"
 #include "System/Threading/ThreadPool.h"
 
@@ -48,6 +49,29 @@ enum {
 
 static PathingState pathingStates[PATH_ESTIMATOR_LEVELS];
 
+static CPathRequestOrder pathRequestOrder;
+static _threadlocal int pathRequestIdx = -1;
+
+void BeginPathRequests(int numRequests)
+{
+	pathRequestOrder.Reset(numRequests);
+
+	for (PathingState& ps: pathingStates) {
+		ps.ClearSharedCache();
+	}
+}
+
+void SetPathRequestIndex(int requestIdx) { pathRequestIdx = requestIdx; }
+void FinishPathRequest(int requestIdx)
+{
+	pathRequestOrder.SetFinished(requestIdx);
+	pathRequestIdx = -1;
+}
+
+int GetPathRequestIndex() { return pathRequestIdx; }
+
+CPathRequestOrder& GetPathRequestOrder() { return pathRequestOrder; }
+
 const CPathFinder* CPathManager::GetMaxResPF() const { return &maxResPFs[0]; }
 const CPathEstimator* CPathManager::GetMedResPE() const { return &medResPEs[0]; }
 const CPathEstimator* CPathManager::GetLowResPE() const { return &lowResPEs[0]; }
@@ -183,7 +207,8 @@ std::int64_t CPathManager::Finalize()
 		std::vector<IPathFinder*> medResList(pathFinderGroups);
 
 		for (int i = 0; i<pathFinderGroups; ++i){
-			maxResPFs[i].Init(true);
+			// one max-res instance per thread, the drawer only shows the first
+			maxResPFs[i].Init(true, i == 0);
 			medResPEs[i].Init(&maxResPFs[i], MEDRES_PE_BLOCKSIZE, &pathingStates[PATH_MED_RES]);
 			lowResPEs[i].Init(&medResPEs[i], LOWRES_PE_BLOCKSIZE, &pathingStates[PATH_LOW_RES]);
 			maxResList[i] = &maxResPFs[i];
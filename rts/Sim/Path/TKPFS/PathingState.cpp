@@ -2,9 +2,6 @@
 
 #include "PathingState.h"
 
-#include "zlib.h"
-#include "minizip/zip.h"
-
 #include "Game/GlobalUnsynced.h"
 #include "Game/LoadScreen.h"
 #include "Net/Protocol/NetProtocol.h"
@@ -17,17 +14,15 @@
 #include "PathConstants.h"
 #include "Sim/Path/Default/PathFinderDef.h"
 #include "Sim/Path/Default/PathLog.h"
+#include "Sim/Path/PathCacheFile.h"
 #include "Sim/Path/TKPFS/PathGlobal.h"
 #include "PathMemPool.h"
 
 #include "System/Config/ConfigHandler.h"
-#include "System/FileSystem/Archives/IArchive.h"
-#include "System/FileSystem/ArchiveLoader.h"
-#include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileSystem.h"
-#include "System/FileSystem/FileQueryFlags.h"
 #include "System/Platform/Threading.h"
 #include "System/StringUtil.h"
+#include "System/Sync/SHA512.hpp"
 #include "System/Threading/ThreadPool.h" // for_mt
 
 #define ENABLE_NETLOG_CHECKSUM 1
@@ -49,7 +44,7 @@ static const std::string GetPathCacheDir() {
 }
 
 static const std::string GetCacheFileName(const std::string& fileHashCode, const std::string& peFileName, const std::string& mapFileName) {
-	return (GetPathCacheDir() + mapFileName + "." + peFileName + "-" + fileHashCode + ".zip");
+	return (GetPathCacheDir() + mapFileName + "." + peFileName + "-" + fileHashCode + ".pcf");
 }
 
 void PathingState::KillStatic() { pathingStates = 0; }
@@ -58,6 +53,8 @@ PathingState::PathingState()
 {
 	pathCache[0] = nullptr;
 	pathCache[1] = nullptr;
+	sharedPathCache[0] = nullptr;
+	sharedPathCache[1] = nullptr;
 }
 
 void PathingState::Init(std::vector<IPathFinder*> pathFinderlist, PathingState* parentState, unsigned int _BLOCK_SIZE, const std::string& peFileName, const std::string& mapFileName)
@@ -145,9 +142,13 @@ void PathingState::Init(std::vector<IPathFinder*> pathFinderlist, PathingState*
 		for_mt(0, moveDefHandler.GetNumMoveDefs(), [&](unsigned int i) {
 			const MoveDef* md = moveDefHandler.GetMoveDefByPathType(i);
 
+			std::vector<float> rowSpeedMods(mapDims.mapx);
+
 			for (int y = 0; y < mapDims.mapy; y++) {
+				CMoveMath::GetPosSpeedMods(*md, 0, mapDims.mapx, y, y + 1, rowSpeedMods.data());
+
 				for (int x = 0; x < mapDims.mapx; x++) {
-					childPE->maxSpeedMods[i] = std::max(childPE->maxSpeedMods[i], CMoveMath::GetPosSpeedMod(*md, x, y));
+					childPE->maxSpeedMods[i] = std::max(childPE->maxSpeedMods[i], rowSpeedMods[x]);
 				}
 			}
 		});
@@ -171,6 +172,11 @@ void PathingState::Terminate()
 	if (pathCache[1] != nullptr)
 		pcMemPool.free(pathCache[1]);
 
+	delete sharedPathCache[0];
+	delete sharedPathCache[1];
+	sharedPathCache[0] = nullptr;
+	sharedPathCache[1] = nullptr;
+
 	//LOG("Pathing unporcessed updatedBlocks is %llu", updatedBlocks.size());
 
 	// Clear out lingering unprocessed map changes
@@ -249,6 +255,9 @@ void PathingState::InitEstimator(const std::string& peFileName, const std::strin
 
 	pathCache[0] = pcMemPool.alloc<CPathCache>(mapDimensionsInBlocks.x, mapDimensionsInBlocks.y);
 	pathCache[1] = pcMemPool.alloc<CPathCache>(mapDimensionsInBlocks.x, mapDimensionsInBlocks.y);
+
+	sharedPathCache[0] = new CSharedPathCache(pathCache[0]);
+	sharedPathCache[1] = new CSharedPathCache(pathCache[1]);
 }
 
 void PathingState::InitBlocks()
@@ -338,6 +347,13 @@ int2 PathingState::FindBlockPosOffset(const MoveDef& moveDef, unsigned int block
 		}
 	}*/
 
+	// speedmods of the whole block are evaluated in one (vectorized) pass,
+	// structure-blocking is still only tested for the candidate squares
+	static thread_local std::vector<float> blockSpeedMods;
+
+	blockSpeedMods.resize(BLOCK_SIZE * BLOCK_SIZE);
+	CMoveMath::GetPosSpeedMods(moveDef, lowerX, lowerX + BLOCK_SIZE, lowerZ, lowerZ + BLOCK_SIZE, blockSpeedMods.data());
+
 	// same as above, but with squares sorted by their baseCost
 	// s.t. we can exit early when a square exceeds our current
 	// best (from testing, on avg. 40% of blocks can be skipped)
@@ -346,7 +362,7 @@ int2 PathingState::FindBlockPosOffset(const MoveDef& moveDef, unsigned int block
 			break;
 
 		const int2 blockPos(lowerX + ob.offset.x, lowerZ + ob.offset.y);
-		const float speedMod = CMoveMath::GetPosSpeedMod(moveDef, blockPos.x, blockPos.y);
+		const float speedMod = blockSpeedMods[ob.offset.y * BLOCK_SIZE + ob.offset.x];
 
 		//assert((blockArea / (0.001f + speedMod) >= 0.0f);
 		const float cost = ob.cost + (blockArea / (0.001f + speedMod));
@@ -510,61 +526,11 @@ bool PathingState::ReadFile(const std::string& peFileName, const std::string& ma
 
 	LOG("[PathEstimator::%s] hash=%s file=\"%s\" (exists=%d)", __func__, hashHexString.c_str(), cacheFileName.c_str(), FileSystem::FileExists(cacheFileName));
 
-	if (!FileSystem::FileExists(cacheFileName))
-		return false;
-
-	std::unique_ptr<IArchive> upfile(archiveLoader.OpenArchive(dataDirsAccess.LocateFile(cacheFileName), "sdz"));
-
-	if (upfile == nullptr || !upfile->IsOpen()) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
-
 	char calcMsg[512];
 	sprintf(calcMsg, "Reading Estimate PathCosts [%d]", BLOCK_SIZE);
 	loadscreen->SetLoadMessage(calcMsg);
 
-	const unsigned fid = upfile->FindFile("pathinfo");
-	if (fid >= upfile->NumFiles()) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
-
-	std::vector<std::uint8_t> buffer;
-
-	if (!upfile->GetFile(fid, buffer) || buffer.size() < 4) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
-
-	const unsigned int filehash = *(reinterpret_cast<unsigned int*>(&buffer[0]));
-	const unsigned int blockSize = blockStates.GetSize() * sizeof(short2);
-	unsigned int pos = sizeof(unsigned);
-
-	if (filehash != fileHashCode) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
-
-	if (buffer.size() < (pos + blockSize * moveDefHandler.GetNumMoveDefs())) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
-
-	// read center-offset data
-	for (int pathType = 0; pathType < moveDefHandler.GetNumMoveDefs(); ++pathType) {
-		std::memcpy(&blockStates.peNodeOffsets[pathType][0], &buffer[pos], blockSize);
-		pos += blockSize;
-	}
-
-	// read vertex-cost data
-	if (buffer.size() < (pos + vertexCosts.size() * sizeof(float))) {
-		FileSystem::Remove(cacheFileName);
-		return false;
-	}
-
-	std::memcpy(&vertexCosts[0], &buffer[pos], vertexCosts.size() * sizeof(float));
-	return true;
+	return (PathCacheFile::Read(cacheFileName, fileHashCode, GetCacheFileSections()));
 }
 
 
@@ -573,48 +539,27 @@ bool PathingState::ReadFile(const std::string& peFileName, const std::string& ma
  */
 bool PathingState::WriteFile(const std::string& peFileName, const std::string& mapFileName)
 {
-	// we need this directory to exist
-	if (!FileSystem::CreateDirectory(GetPathCacheDir()))
-		return false;
-
 	const std::string hashHexString = IntToString(fileHashCode, "%x");
 	const std::string cacheFileName = GetCacheFileName(hashHexString, peFileName, mapFileName);
 
 	LOG("[PathEstimator::%s] hash=%s file=\"%s\" (exists=%d)", __func__, hashHexString.c_str(), cacheFileName.c_str(), FileSystem::FileExists(cacheFileName));
 
-	// open file for writing in a suitable location
-	zipFile file = zipOpen(dataDirsAccess.LocateFile(cacheFileName, FileQueryFlags::WRITE).c_str(), APPEND_STATUS_CREATE);
-
-	if (file == nullptr)
-		return false;
-
-	zipOpenNewFileInZip(file, "pathinfo", nullptr, nullptr, 0, nullptr, 0, nullptr, Z_DEFLATED, Z_BEST_COMPRESSION);
-
-	// write hash-code (NOTE: this also affects the CRC!)
-	zipWriteInFileInZip(file, (const void*) &fileHashCode, 4);
-
-	// write center-offsets
-	for (int pathType = 0; pathType < moveDefHandler.GetNumMoveDefs(); ++pathType) {
-		zipWriteInFileInZip(file, (const void*) &blockStates.peNodeOffsets[pathType][0], blockStates.peNodeOffsets[pathType].size() * sizeof(short2));
-	}
-
-	// write vertex-costs
-	zipWriteInFileInZip(file, vertexCosts.data(), vertexCosts.size() * sizeof(float));
-
-	zipCloseFileInZip(file);
-	zipClose(file, nullptr);
+	return (PathCacheFile::Write(cacheFileName, fileHashCode, GetCacheFileSections()));
+}
 
 
-	// get the CRC over the written path data
-	std::unique_ptr<IArchive> upfile(archiveLoader.OpenArchive(dataDirsAccess.LocateFile(cacheFileName), "sdz"));
+std::vector<PathCacheFile::Section> PathingState::GetCacheFileSections()
+{
+	std::vector<PathCacheFile::Section> sections;
+	sections.reserve(blockStates.peNodeOffsets.size() + 1);
 
-	if (upfile == nullptr || !upfile->IsOpen()) {
-		FileSystem::Remove(cacheFileName);
-		return false;
+	// center-offsets per pathType, then vertex-costs
+	for (auto& pathTypeOffsets: blockStates.peNodeOffsets) {
+		sections.push_back({pathTypeOffsets.data(), pathTypeOffsets.size() * sizeof(short2)});
 	}
 
-	assert(upfile->FindFile("pathinfo") < upfile->NumFiles());
-	return true;
+	sections.push_back({vertexCosts.data(), vertexCosts.size() * sizeof(float)});
+	return sections;
 }
 
 
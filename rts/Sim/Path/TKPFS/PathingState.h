@@ -9,6 +9,7 @@
 
 #include "IPathFinder.h"
 #include "Sim/Path/Default/PathDataTypes.h"
+#include "Sim/Path/PathCacheFile.h"
 #include "System/Threading/SpringThreading.h"
 
 #include "Sim/Path/TKPFS/PathEstimator.h"
@@ -101,6 +102,16 @@ public:
 		const bool synced
 	);
 
+	// only valid during the multi-threaded request phase
+	CSharedPathCache* GetSharedCache(const bool synced) const { return sharedPathCache[synced]; }
+
+	void ClearSharedCache() {
+		if (sharedPathCache[0] != nullptr)
+			sharedPathCache[0]->Clear();
+		if (sharedPathCache[1] != nullptr)
+			sharedPathCache[1]->Clear();
+	}
+
 	void AddPathForCurrentFrame(
 		const IPath::Path* path,
 		const IPath::SearchResult result,
@@ -140,6 +151,7 @@ private:
 
 	bool ReadFile(const std::string& peFileName, const std::string& mapFileName);
 	bool WriteFile(const std::string& peFileName, const std::string& mapFileName);
+	std::vector<PathCacheFile::Section> GetCacheFileSections();
 
 private:
 	friend class TKPFS::CPathEstimator;
@@ -166,6 +178,7 @@ private:
     PathingState* nextPathState = nullptr;
 
     CPathCache* pathCache[2]; // [0] = !synced, [1] = synced
+    CSharedPathCache* sharedPathCache[2];
 
     unsigned int mapBlockCount = 0;
     int2 mapDimensionsInBlocks = {0, 0};
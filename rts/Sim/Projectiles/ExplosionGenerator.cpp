@@ -716,6 +716,61 @@ void CCustomExplosionGenerator::ExecuteExplosionCode(const char* code, float dam
 
 
 
+// true if <code> only depends on per-explosion inputs (damage, dir); collects the written members
+bool CCustomExplosionGenerator::IsInvariantExplosionCode(const std::string& code, std::vector< std::pair<std::uint16_t, std::uint8_t> >& fields)
+{
+	std::vector< std::pair<std::uint16_t, std::uint8_t> > codeFields;
+
+	for (size_t i = 0; i < code.size(); ) {
+		const char op = code[i++];
+
+		switch (op) {
+			case OP_STOREI:
+			case OP_STOREF: {
+				std::uint16_t offset = 0;
+				std::memcpy(&offset, &code[i + 1], sizeof(offset));
+
+				codeFields.emplace_back(offset, code[i]);
+				i += 3;
+			} break;
+			case OP_STOREP: {
+				std::uint16_t offset = 0;
+				std::memcpy(&offset, &code[i], sizeof(offset));
+
+				codeFields.emplace_back(offset, sizeof(void*));
+				i += 2;
+			} break;
+			case OP_DIR: {
+				std::uint16_t offset = 0;
+				std::memcpy(&offset, &code[i], sizeof(offset));
+
+				codeFields.emplace_back(offset, sizeof(float3));
+				i += 2;
+			} break;
+			case OP_LOADP: {
+				i += sizeof(void*);
+			} break;
+
+			case OP_ADD:
+			case OP_DAMAGE:
+			case OP_SAWTOOTH:
+			case OP_DISCRETE:
+			case OP_SINE:
+			case OP_POW: {
+				i += 4;
+			} break;
+
+			// per-projectile values, or the scratch buffer shared between members
+			default: {
+				return false;
+			} break;
+		}
+	}
+
+	fields.insert(fields.end(), codeFields.begin(), codeFields.end());
+	return true;
+}
+
 void CCustomExplosionGenerator::ParseExplosionCode(
 	CCustomExplosionGenerator::ProjectileSpawnInfo* psi,
 	const string& script,
@@ -891,6 +946,8 @@ bool CCustomExplosionGenerator::Load(CExplosionGeneratorHandler* handler, const
 		psi.count = std::max(0, spawnTable.GetInt("count", 1));
 
 		std::string code;
+		std::string invariantCode;
+		std::string memberCode;
 		spring::unordered_map<string, string> props;
 
 		spawnTable.SubTable("properties").GetMap(props);
@@ -899,15 +956,24 @@ bool CCustomExplosionGenerator::Load(CExplosionGeneratorHandler* handler, const
 			SExpGenSpawnableMemberInfo memberInfo = {0, 0, 0, STRING_HASH(std::move(StringToLower(propIt.first))), SExpGenSpawnableMemberInfo::TYPE_INT, nullptr};
 
 			if (CExpGenSpawnable::GetSpawnableMemberInfo(className, memberInfo)) {
-				ParseExplosionCode(&psi, propIt.second, memberInfo, code);
+				memberCode.clear();
+				ParseExplosionCode(&psi, propIt.second, memberInfo, memberCode);
+
+				// members without random or index terms are only evaluated once per explosion
+				if (IsInvariantExplosionCode(memberCode, psi.invariantFields)) {
+					invariantCode += memberCode;
+				} else {
+					code += memberCode;
+				}
 			} else {
 				LOG_L(L_WARNING, "[CCEG::%s] unknown field %s::%s in spawn-table \"%s\" for CEG \"%s\"", __func__, tag, propIt.first.c_str(), spawnName.c_str(), className.c_str());
 			}
 		}
 
 		code += (char)OP_END;
-		psi.code.resize(code.size());
-		copy(code.begin(), code.end(), psi.code.begin());
+		invariantCode += (char)OP_END;
+		psi.code.assign(code.begin(), code.end());
+		psi.invariantCode.assign(invariantCode.begin(), invariantCode.end());
 
 		expGenParams.projectiles.push_back(psi);
 	}
@@ -981,11 +1047,27 @@ bool CCustomExplosionGenerator::Explosion(
 		if (projectileHandler.GetParticleSaturation() > 1.0f)
 			break;
 
-		for (unsigned int c = 0; c < psi.count; c++) {
+		if (psi.count == 0)
+			continue;
+
+		// the first projectile receives the invariant members, all others copy them
+		// and it is initialized last since Init might modify the copied members
+		CExpGenSpawnable* first = CExpGenSpawnable::CreateSpawnable(psi.spawnableID);
+		ExecuteExplosionCode(&psi.invariantCode[0], damage, (char*) first, 0, dir);
+
+		for (unsigned int c = 1; c < psi.count; c++) {
 			CExpGenSpawnable* projectile = CExpGenSpawnable::CreateSpawnable(psi.spawnableID);
+
+			for (const auto& field: psi.invariantFields) {
+				std::memcpy(reinterpret_cast<char*>(projectile) + field.first, reinterpret_cast<const char*>(first) + field.first, field.second);
+			}
+
 			ExecuteExplosionCode(&psi.code[0], damage, (char*) projectile, c, dir);
 			projectile->Init(owner, pos);
 		}
+
+		ExecuteExplosionCode(&psi.code[0], damage, (char*) first, 0, dir);
+		first->Init(owner, pos);
 	}
 
 	if (groundExplosion && (groundFlash.ttl > 0) && (groundFlash.flashSize > 1))
@@ -152,6 +152,11 @@ protected:
 
 		/// parsed explosion script code
 		std::vector<char> code;
+
+		/// code of members that are the same for every projectile of one explosion
+		std::vector<char> invariantCode;
+		/// (offset, size) of the members written by invariantCode
+		std::vector< std::pair<std::uint16_t, std::uint8_t> > invariantFields;
 	};
 
 	struct ExpGenParams {
@@ -219,6 +224,7 @@ public:
 private:
 	void ParseExplosionCode(ProjectileSpawnInfo* psi, const std::string& script, SExpGenSpawnableMemberInfo& memberInfo, std::string& code);
 	void ExecuteExplosionCode(const char* code, float damage, char* instance, int spawnIndex, const float3& dir);
+	static bool IsInvariantExplosionCode(const std::string& code, std::vector< std::pair<std::uint16_t, std::uint8_t> >& fields);
 
 protected:
 	ExpGenParams expGenParams;
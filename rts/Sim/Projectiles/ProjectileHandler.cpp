@@ -15,6 +15,7 @@
 #include "Sim/Misc/CollisionHandler.h"
 #include "Sim/Misc/CollisionVolume.h"
 #include "Sim/Misc/GlobalSynced.h"
+#include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/QuadField.h"
 #include "Sim/Misc/TeamHandler.h"
 #include "Rendering/Env/Particles/Classes/FlyingPiece.h"
@@ -225,16 +226,46 @@ void CProjectileHandler::UpdateProjectilesImpl()
 
 	// WARNING: same as above but for p->Update()
 	if constexpr (synced) {
-		for (size_t i = 0; i < pc.size(); ++i) {
-			CProjectile* p = pc[i];
-			assert(p != nullptr);
+		if (modInfo.mtProjectileQuadUpdate) {
+			for (size_t i = 0; i < pc.size(); ++i) {
+				CProjectile* p = pc[i];
+				assert(p != nullptr);
+
+				MAPPOS_SANITY_CHECK(p->pos);
+				p->Update();
+				MAPPOS_SANITY_CHECK(p->pos);
+			}
 
-			MAPPOS_SANITY_CHECK(p->pos);
+			// quad-changes are determined in parallel, then committed in
+			// container order so quad projectile-lists stay deterministic
+			// NOTE: Update can append new projectiles to <pc> (which add
+			// themselves to the quadfield), the size has to be re-read
+			movedProjectileQuads.clear();
+			movedProjectileQuads.resize(pc.size(), 0);
 
-			p->Update();
-			quadField.MovedProjectile(p);
+			for_mt_chunk(0, pc.size(), [&](const int i) {
+				movedProjectileQuads[i] = quadField.ProjectileChangedQuad(pc[i]);
+			});
 
-			MAPPOS_SANITY_CHECK(p->pos);
+			for (size_t i = 0, n = movedProjectileQuads.size(); i < n; ++i) {
+				if (!movedProjectileQuads[i])
+					continue;
+
+				quadField.RemoveProjectile(pc[i]);
+				quadField.AddProjectile(pc[i]);
+			}
+		} else {
+			for (size_t i = 0; i < pc.size(); ++i) {
+				CProjectile* p = pc[i];
+				assert(p != nullptr);
+
+				MAPPOS_SANITY_CHECK(p->pos);
+
+				p->Update();
+				quadField.MovedProjectile(p);
+
+				MAPPOS_SANITY_CHECK(p->pos);
+			}
 		}
 	}
 	else {
@@ -361,11 +392,16 @@ void CProjectileHandler::Update()
 		// flying pieces; sort these every now and then
 		for (int modelType = 0; modelType < MODELTYPE_CNT; ++modelType) {
 			auto& fpc = flyingPieces[modelType];
+			const size_t numPieces = fpc.size();
 
 			UPDATE_REF_CONTAINER(fpc);
 
+			// removals swap in the tail element, so order only breaks if something died
+			resortFlyingPieces[modelType] |= (fpc.size() != numPieces);
+
 			if (resortFlyingPieces[modelType]) {
 				std::stable_sort(fpc.begin(), fpc.end());
+				resortFlyingPieces[modelType] = false;
 			}
 		}
 	}
@@ -487,6 +523,54 @@ static bool CheckProjectileCollisionFlags(const CProjectile* p, const CUnit* u)
 }
 
 
+// SoA scratch-buffers for the batched bounding-sphere pre-pass
+static std::vector<float> colCandCX;
+static std::vector<float> colCandCY;
+static std::vector<float> colCandCZ;
+static std::vector<float> colCandRad;
+static std::vector<unsigned char> colCandMayHit;
+
+template<typename T>
+static void FilterCollisionCandidates(std::vector<T*>& objects, const float3 ppos0, const float3 ppos1)
+{
+	const size_t n = objects.size();
+
+	// nothing to gain for tiny batches
+	if (n < 4)
+		return;
+
+	colCandCX.resize(n);
+	colCandCY.resize(n);
+	colCandCZ.resize(n);
+	colCandRad.resize(n);
+	colCandMayHit.resize(n);
+
+	for (size_t i = 0; i < n; ++i) {
+		const T* o = objects[i];
+		const CollisionVolume& cv = o->collisionVolume;
+		const float3 cp = cv.GetWorldSpacePos(o);
+
+		colCandCX[i] = cp.x;
+		colCandCY[i] = cp.y;
+		colCandCZ[i] = cp.z;
+		// piece-tree tests are not bounded by the volume; never reject those
+		colCandRad[i] = mix(cv.GetBoundingRadius(), 1e15f, cv.DefaultToPieceTree());
+	}
+
+	CCollisionHandler::TestBoundingSpheres(ppos0, ppos1, colCandCX.data(), colCandCY.data(), colCandCZ.data(), colCandRad.data(), colCandMayHit.data(), n);
+
+	// stable compaction, the hit-tests take the first colliding object
+	size_t k = 0;
+
+	for (size_t i = 0; i < n; ++i) {
+		objects[k] = objects[i];
+		k += colCandMayHit[i];
+	}
+
+	objects.resize(k);
+}
+
+
 void CProjectileHandler::CheckUnitCollisions(
 	CProjectile* p,
 	std::vector<CUnit*>& tempUnits,
@@ -606,6 +690,19 @@ void CProjectileHandler::CheckShieldCollisions(
 		const float3 rppos0 = ppos0 + rpvec * repulser->GetDeltaDist();
 		const float3 cvpos  = repulser->weaponMuzzlePos - repulser->owner->relMidPos;
 
+		{
+			// cheap segment-vs-sphere rejection, DetectHit inverts a matrix per
+			// shield; the margin keeps this conservative wrt. its precision
+			const float3 segVec = ppos1 - rppos0;
+			const float3 cenVec = repulser->weaponMuzzlePos - rppos0;
+
+			const float segLenSq = segVec.SqLength();
+			const float segCoeff = (segLenSq > 0.0f)? Clamp(cenVec.dot(segVec) / segLenSq, 0.0f, 1.0f): 0.0f;
+
+			if ((cenVec - segVec * segCoeff).SqLength() > Square(repulser->GetRadius() + 1.0f))
+				continue;
+		}
+
 		// shield volumes are always spherical, transform directly
 		// (CollisionHandler will cancel out the relmidpos offset)
 		if (!CCollisionHandler::DetectHit(repulser->owner, &repulser->collisionVolume, CMatrix44f{cvpos}, rppos0, ppos1, &cq))
@@ -635,7 +732,13 @@ void CProjectileHandler::CheckUnitFeatureCollisions(ProjectileContainer& pc)
 		const float3 ppos1 = p->pos + p->speed;
 		// const float3 ppos1 = p->pos + p->dir * (p->speed.w + p->radius);
 
-		quadField.GetUnitsAndFeaturesColVol(p->pos, p->speed.w + p->radius, tempUnits, tempFeatures, &tempRepulsers);
+		// only gather shields for projectiles which can be intercepted by one
+		const bool shieldable = (p->weapon && static_cast<const CWeaponProjectile*>(p)->GetWeaponDef()->interceptedByShieldType != 0);
+
+		quadField.GetUnitsAndFeaturesColVol(p->pos, p->speed.w + p->radius, tempUnits, tempFeatures, shieldable? &tempRepulsers: nullptr);
+
+		FilterCollisionCandidates(tempUnits, ppos0, ppos1);
+		FilterCollisionCandidates(tempFeatures, ppos0, ppos1);
 
 		CheckShieldCollisions(p, tempRepulsers, ppos0, ppos1); tempRepulsers.clear();
 		CheckUnitCollisions(p, tempUnits, ppos0, ppos1); tempUnits.clear();
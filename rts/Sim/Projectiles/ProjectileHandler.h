@@ -4,6 +4,7 @@
 #define PROJECTILE_HANDLER_H
 
 #include <array>
+#include <cstdint>
 #include <vector>
 
 #include "Rendering/Models/3DModel.h"
@@ -120,6 +121,10 @@ private:
 	// [0] := ID ==> projectile* map for living unsynced projectiles
 	// [1] := ID ==> projectile* map for living   synced projectiles
 	std::vector<CProjectile*> projectileMaps[2];
+
+	// scratch-buffer for deferred synced quadfield updates, one entry
+	// per projectile in projectileContainers[true]; non-zero if moved
+	std::vector<uint8_t> movedProjectileQuads;
 };
 
 
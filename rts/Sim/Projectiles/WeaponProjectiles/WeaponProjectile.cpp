@@ -32,6 +32,7 @@ CR_REG_METADATA(CWeaponProjectile,(
 	CR_MEMBER(bounced),
 	CR_MEMBER(weaponDef),
 	CR_MEMBER(target),
+	CR_IGNORED(interceptTarget),
 	CR_MEMBER(targetPos),
 	CR_MEMBER(startPos),
 	CR_MEMBER(bounceHitPos),
@@ -122,6 +123,8 @@ CWeaponProjectile::CWeaponProjectile(const ProjectileParams& params)
 			po->SetBeingIntercepted(po->IsBeingIntercepted() || weaponDef->interceptSolo);
 			AddDeathDependence(po, DEPENDENCE_INTERCEPTTARGET);
 		}
+
+		interceptTarget = po;
 	}
 
 	if (params.model != nullptr) {
@@ -271,10 +274,7 @@ void CWeaponProjectile::Update()
 
 void CWeaponProjectile::UpdateInterception()
 {
-	if (target == nullptr)
-		return;
-
-	CWeaponProjectile* po = dynamic_cast<CWeaponProjectile*>(target);
+	CWeaponProjectile* po = interceptTarget;
 
 	if (po == nullptr)
 		return;
@@ -377,6 +377,7 @@ void CWeaponProjectile::DependentDied(CObject* o)
 		return;
 
 	target = nullptr;
+	interceptTarget = nullptr;
 }
 
 
@@ -384,4 +385,5 @@ void CWeaponProjectile::PostLoad()
 {
 	assert(weaponDef != nullptr);
 	model = weaponDef->LoadModel();
+	interceptTarget = dynamic_cast<CWeaponProjectile*>(target);
 }
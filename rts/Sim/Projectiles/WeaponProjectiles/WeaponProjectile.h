@@ -51,6 +51,7 @@ public:
 			targetPos = newTarget->pos;
 
 		target = newTarget;
+		interceptTarget = dynamic_cast<CWeaponProjectile*>(newTarget);
 	}
 
 	const CWorldObject* GetTargetObject() const { return target; }
@@ -83,6 +84,8 @@ protected:
 	const WeaponDef* weaponDef;
 
 	CWorldObject* target;
+	/// target if it is a projectile, saves UpdateInterception a cast per frame
+	CWeaponProjectile* interceptTarget = nullptr;
 
 	unsigned int weaponNum;
 
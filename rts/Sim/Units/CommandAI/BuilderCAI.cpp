@@ -1,5 +1,6 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <array>
 #include <cassert>
 
 #include "BuilderCAI.h"
@@ -60,6 +61,47 @@ spring::unordered_set<int> CBuilderCAI::resurrecters;
 std::vector<int> CBuilderCAI::removees;
 
 
+// area reclaim and resurrect searches by many builders around one point
+// (e.g. a group given the same area command) all see the same features;
+// the result of each query is shared until the frame ends or any feature
+// enters or leaves the quadfield, so this never changes what builders see
+struct AreaFeatureQuery {
+	float3 pos;
+	float radius = -1.0f;
+
+	int frameNum = -1;
+	unsigned int featuresVersion = 0;
+
+	std::vector<CFeature*> features;
+};
+
+static std::array<AreaFeatureQuery, 8> areaFeatureQueries;
+static unsigned int areaFeatureQueryIdx = 0;
+
+static const std::vector<CFeature*>& GetAreaFeatures(const float3& pos, float radius)
+{
+	for (const AreaFeatureQuery& q: areaFeatureQueries) {
+		if (q.frameNum != gs->frameNum || q.featuresVersion != quadField.GetFeaturesVersion())
+			continue;
+		if (q.radius != radius || !q.pos.same(pos))
+			continue;
+
+		return q.features;
+	}
+
+	AreaFeatureQuery& q = areaFeatureQueries[(areaFeatureQueryIdx++) % areaFeatureQueries.size()];
+	QuadFieldQuery qfQuery;
+	quadField.GetFeaturesExact(qfQuery, pos, radius, false);
+
+	q.pos = pos;
+	q.radius = radius;
+	q.frameNum = gs->frameNum;
+	q.featuresVersion = quadField.GetFeaturesVersion();
+	q.features.assign(qfQuery.features->begin(), qfQuery.features->end());
+	return q.features;
+}
+
+
 static std::string GetUnitDefBuildOptionToolTip(const UnitDef* ud, bool disabled) {
 	std::string tooltip;
 
@@ -228,6 +270,12 @@ void CBuilderCAI::InitStatic()
 	spring::clear_unordered_set(reclaimers);
 	spring::clear_unordered_set(featureReclaimers);
 	spring::clear_unordered_set(resurrecters);
+
+	for (AreaFeatureQuery& q: areaFeatureQueries) {
+		q = {};
+	}
+
+	areaFeatureQueryIdx = 0;
 }
 
 void CBuilderCAI::PostLoad()
@@ -1553,11 +1601,9 @@ int CBuilderCAI::FindReclaimTarget(const float3& pos, float radius, unsigned cha
 	if ((!best || !stationary) && !recEnemyOnly) {
 		best = nullptr;
 		const CTeam* team = teamHandler.Team(owner->team);
-		QuadFieldQuery qfQuery;
-		quadField.GetFeaturesExact(qfQuery, pos, radius, false);
 		bool metal = false;
 
-		for (const CFeature* f: *qfQuery.features) {
+		for (const CFeature* f: GetAreaFeatures(pos, radius)) {
 			if (!f->def->reclaimable)
 				continue;
 			if (!recSpecial && !f->def->autoreclaim)
@@ -1629,13 +1675,10 @@ bool CBuilderCAI::FindResurrectableFeatureAndResurrect(
 	unsigned char options,
 	bool freshOnly
 ) {
-	QuadFieldQuery qfQuery;
-	quadField.GetFeaturesExact(qfQuery, pos, radius, false);
-
 	const CFeature* best = nullptr;
 	float bestDist = 1.0e30f;
 
-	for (const CFeature* f: *qfQuery.features) {
+	for (const CFeature* f: GetAreaFeatures(pos, radius)) {
 		if (f->udef == nullptr)
 			continue;
 
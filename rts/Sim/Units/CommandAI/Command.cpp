@@ -20,10 +20,30 @@ CR_REG_METADATA(Command, (
 ))
 
 Command::~Command() {
-	if (!IsPooledCommand())
+	ReleaseParams();
+}
+
+
+void Command::FromRawCommand(const RawCommand& rc) {
+	ReleaseParams();
+
+	pageIndex = rc.pageIndex;
+	numParams = rc.numParams;
+
+	memcpy(&id[0], &rc.id[0], sizeof(id));
+	memset(&params[0], 0, sizeof(params));
+
+	SetFlags(rc.timeOut, rc.tag, rc.options);
+
+	if (IsPooledCommand()) {
+		// actual params should still be in pool, original command exists on AI side
+		assert(numParams > MAX_COMMAND_PARAMS);
+		cmdParamsPool.SharePage(pageIndex);
 		return;
+	}
 
-	cmdParamsPool.ReleasePage(pageIndex);
+	assert(numParams <= MAX_COMMAND_PARAMS);
+	memcpy(&params[0], &rc.params[0], rc.numParams);
 }
 
 
@@ -50,6 +70,13 @@ float Command::GetParam(unsigned int idx) const {
 
 
 bool Command::SetParam(unsigned int idx, float param) {
+	if (idx >= numParams)
+		return false;
+
+	// copy-on-write, other commands might still share this page
+	if (IsPooledCommand())
+		pageIndex = cmdParamsPool.DetachPage(pageIndex);
+
 	float* ptr = const_cast<float*>(GetParams(idx));
 
 	if (ptr != nullptr)
@@ -77,24 +104,33 @@ bool Command::PushParam(float param) {
 		assert(IsPooledCommand());
 	}
 
+	pageIndex = cmdParamsPool.DetachPage(pageIndex);
+
 	// add new parameter
 	numParams = cmdParamsPool.Push(pageIndex, param);
 	return true;
 }
 
 void Command::CopyParams(const Command& c) {
+	// share the page first in case c is this command
+	if (c.IsPooledCommand())
+		cmdParamsPool.SharePage(c.pageIndex);
+
 	// clear existing params
+	ReleaseParams();
+
+	pageIndex = c.pageIndex;
+	numParams = c.numParams;
+
+	memcpy(&params[0], &c.params[0], sizeof(params));
+}
+
+void Command::ReleaseParams() {
 	if (IsPooledCommand())
 		cmdParamsPool.ReleasePage(pageIndex);
 
 	pageIndex = -1u;
 	numParams = 0;
-
-	assert(IsEmptyCommand());
-
-	for (unsigned int i = 0; i < c.numParams; i++) {
-		PushParam(c.GetParam(i));
-	}
 }
 
 void Command::Serialize(creg::ISerializer* s) {
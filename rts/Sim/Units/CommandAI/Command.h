@@ -6,6 +6,7 @@
 #include <string>
 #include <climits> // INT_MAX
 #include <cstring> // memset
+#include <utility> // move
 
 #include "System/creg/creg_cond.h"
 #include "System/float3.h"
@@ -173,6 +174,29 @@ public:
 		return *this;
 	}
 
+	Command(Command&& c) {
+		*this = std::move(c);
+	}
+
+	Command& operator = (Command&& c) {
+		if (this == &c)
+			return *this;
+
+		memcpy(&id[0], &c.id[0], sizeof(id));
+		memcpy(&params[0], &c.params[0], sizeof(params));
+
+		SetFlags(c.timeOut, c.tag, c.options);
+		ReleaseParams();
+
+		// take over c's page (if any) and leave it empty
+		pageIndex = c.pageIndex;
+		numParams = c.numParams;
+
+		c.pageIndex = -1u;
+		c.numParams = 0;
+		return *this;
+	}
+
 	Command(const float3& pos) {
 		memset(&params[0], 0, sizeof(params));
 
@@ -245,24 +269,7 @@ public:
 		return rc;
 	}
 
-	void FromRawCommand(const RawCommand& rc) {
-		pageIndex = rc.pageIndex;
-		numParams = rc.numParams;
-
-		memcpy(&id[0], &rc.id[0], sizeof(id));
-		memset(&params[0], 0, sizeof(params));
-
-		SetFlags(rc.timeOut, rc.tag, rc.options);
-
-		if (IsPooledCommand()) {
-			// actual params should still be in pool, original command exists on AI side
-			assert(numParams > MAX_COMMAND_PARAMS);
-			return;
-		}
-
-		assert(numParams <= MAX_COMMAND_PARAMS);
-		memcpy(&params[0], &rc.params[0], rc.numParams);
-	}
+	void FromRawCommand(const RawCommand& rc);
 
 
 	// returns true if the command references another object and
@@ -423,6 +430,7 @@ public:
 	}
 
 	void CopyParams(const Command& c);
+	void ReleaseParams();
 
 	void Serialize(creg::ISerializer* s);
 
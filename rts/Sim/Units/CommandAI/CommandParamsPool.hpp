@@ -22,29 +22,59 @@ public:
 		return (pages[i].size());
 	}
 
+	// pages are reference-counted so copies of a command can share its
+	// parameters; a holder must DetachPage before modifying a shared page
+	void SharePage(unsigned int i) {
+		assert(i < pages.size());
+		assert(counts[i] > 0);
+		counts[i] += 1;
+	}
+
 	void ReleasePage(unsigned int i) {
 		assert(i < pages.size());
+		assert(counts[i] > 0);
+
+		if ((counts[i] -= 1) > 0)
+			return;
+
 		indcs.push_back(i);
 	}
 
+	bool IsSharedPage(unsigned int i) const {
+		assert(i < pages.size());
+		return (counts[i] > 1);
+	}
+
+	unsigned int DetachPage(unsigned int i) {
+		if (!IsSharedPage(i))
+			return i;
+
+		const unsigned int j = AcquirePage();
+
+		// AcquirePage may have resized <pages>, index again
+		pages[j].assign(pages[i].begin(), pages[i].end());
+		ReleasePage(i);
+		return j;
+	}
+
 	unsigned int AcquirePage() {
 		if (indcs.empty()) {
-			const size_t numIndices = indcs.size();
-
-			pages.resize(std::max(N, pages.size() << 1));
-			indcs.resize(std::max(N, indcs.size() << 1));
+			const size_t numPages = pages.size();
 
-			const auto beg = indcs.begin() + numIndices;
-			const auto end = indcs.end();
+			pages.resize(std::max(N, numPages << 1));
+			counts.resize(pages.size(), 0);
 
-			// generate new indices
-			std::for_each(beg, end, [&](const unsigned int& i) { indcs[&i - &indcs[0]] = &i - &indcs[0]; });
+			// all existing pages are in use, only hand out the new ones
+			for (size_t i = pages.size(); i > numPages; i--) {
+				indcs.push_back(i - 1);
+			}
 		}
 
 		const unsigned int pageIndex = indcs.back();
 
 		pages[pageIndex].clear();
 		pages[pageIndex].reserve(S);
+		counts[pageIndex] = 1;
 
 		indcs.pop_back();
 		return pageIndex;
@@ -53,6 +83,7 @@ public:
 private:
 	std::vector< std::vector<T> > pages;
 	std::vector<unsigned int> indcs;
+	std::vector<unsigned int> counts;
 };
 
 typedef TCommandParamsPool<float, 256, 32> CommandParamsPool;
@@ -4,6 +4,8 @@
 #include "CobEngine.h"
 #include "CobThread.h"
 #include "CobFile.h"
+#include "Sim/Misc/ModInfo.h"
+#include "System/Threading/ThreadPool.h"
 
 
 CR_BIND(CCobEngine, )
@@ -16,8 +18,14 @@ CR_REG_METADATA(CCobEngine, (
 	CR_MEMBER(sleepingThreadIDs),
 	// always null/empty when saving
 	CR_IGNORED(waitingThreadIDs),
+	CR_IGNORED(wokenThreadIDs),
+
+	CR_IGNORED(batchGroups),
+	CR_IGNORED(batchThreads),
+	CR_IGNORED(batchGroupIndices),
 
 	CR_IGNORED(curThread),
+	CR_IGNORED(deferScheduling),
 
 	CR_MEMBER(currentTime),
 	CR_MEMBER(threadCounter)
@@ -49,6 +57,10 @@ int CCobEngine::AddThread(CCobThread&& thread)
 // a thread wants to continue running at a later time, and adds itself to the scheduler
 void CCobEngine::ScheduleThread(const CCobThread* thread)
 {
+	// TickThreadBatch schedules the sleepers itself, in order
+	if (deferScheduling)
+		return;
+
 	switch (thread->GetState()) {
 		case CCobThread::Run: {
 			waitingThreadIDs.push_back(thread->GetID());
@@ -124,14 +136,132 @@ void CCobEngine::WakeSleepingThreads()
 	}
 }
 
+void CCobEngine::WakeSleepingThreadsMT()
+{
+	// same as WakeSleepingThreads, except that all due sleepers are collected
+	// before any is ticked; repeat since a negative sleep can make a thread
+	// due again immediately
+	while (!sleepingThreadIDs.empty()) {
+		wokenThreadIDs.clear();
+
+		while (!sleepingThreadIDs.empty()) {
+			CCobThread* zzzThread = GetThread((sleepingThreadIDs.top()).id);
+
+			if (zzzThread == nullptr) {
+				sleepingThreadIDs.pop();
+				continue;
+			}
+
+			if (zzzThread->GetWakeTime() >= currentTime)
+				break;
+
+			sleepingThreadIDs.pop();
+
+			// dead threads are removed by TickThread in the same order as before
+			switch (zzzThread->GetState()) {
+				case CCobThread::Sleep: {
+					zzzThread->SetState(CCobThread::Run);
+					wokenThreadIDs.push_back(zzzThread->GetID());
+				} break;
+				case CCobThread::Dead: {
+					wokenThreadIDs.push_back(zzzThread->GetID());
+				} break;
+				default: {
+					LOG_L(L_ERROR, "[COBEngine::%s] unknown state %d for thread %d", __func__, zzzThread->GetState(), zzzThread->GetID());
+				} break;
+			}
+		}
+
+		if (wokenThreadIDs.empty())
+			break;
+
+		TickThreadBatch(wokenThreadIDs);
+	}
+}
+
+void CCobEngine::TickThreadBatch(const std::vector<int>& threadIDs)
+{
+	batchGroups.clear();
+	batchThreads.clear();
+	batchGroupIndices.clear();
+
+	// group by owner, keeping each owner's threads in their original order
+	for (const int threadID: threadIDs) {
+		CCobThread* thread = GetThread(threadID);
+
+		if (thread == nullptr)
+			continue;
+
+		const auto pair = batchGroupIndices.insert({thread->cobInst, batchGroups.size()});
+		const int groupIdx = pair.first->second;
+		const int threadIdx = batchThreads.size();
+
+		if (pair.second) {
+			batchGroups.push_back({threadIdx, threadIdx, true});
+		} else {
+			batchThreads[batchGroups[groupIdx].tail].next = threadIdx;
+			batchGroups[groupIdx].tail = threadIdx;
+		}
+
+		batchGroups[groupIdx].local &= (thread->IsDead() || thread->IsLocal());
+		batchThreads.push_back({thread, threadID, groupIdx, -1, true, false});
+	}
+
+	// local threads only touch themselves and their owner, and nothing can
+	// be added to threadInstances while they run so the pointers stay valid
+	deferScheduling = true;
+
+	for_mt(0, batchGroups.size(), [this](const int groupIdx) {
+		if (!batchGroups[groupIdx].local)
+			return;
+
+		for (int i = batchGroups[groupIdx].head; i != -1; i = batchThreads[i].next) {
+			BatchThread& bt = batchThreads[i];
+
+			bt.alive = bt.thread->Tick();
+			bt.slept = (bt.alive && bt.thread->GetState() == CCobThread::Sleep);
+		}
+	});
+
+	deferScheduling = false;
+
+	// replay in the original order; threads of non-local owners are ticked
+	// here, which can also add to or remove from threadInstances
+	for (const BatchThread& bt: batchThreads) {
+		if (!batchGroups[bt.group].local) {
+			TickThread(GetThread(bt.id));
+			continue;
+		}
+
+		const CCobThread* thread = GetThread(bt.id);
+
+		if (thread == nullptr)
+			continue;
+
+		if (!bt.alive) {
+			RemoveThread(bt.id);
+			continue;
+		}
+
+		// not through ScheduleThread, the thread might be signalled by now
+		if (bt.slept)
+			sleepingThreadIDs.push(SleepingThread{bt.id, thread->GetWakeTime()});
+	}
+}
+
 void CCobEngine::Tick(int deltaTime)
 {
 	currentTime += deltaTime;
 
-	TickRunningThreads();
+	TickRunningThreads(modInfo.mtCobUpdate);
 	AddQueuedThreads();
 
-	WakeSleepingThreads();
+	if (modInfo.mtCobUpdate) {
+		WakeSleepingThreadsMT();
+	} else {
+		WakeSleepingThreads();
+	}
+
 	AddQueuedThreads();
 }
 
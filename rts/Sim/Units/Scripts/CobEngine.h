@@ -34,6 +34,23 @@ private:
 		int wt;
 	};
 
+	// used by TickThreadBatch
+	struct BatchGroup {
+		int head;
+		int tail;
+		bool local;
+	};
+	struct BatchThread {
+		CCobThread* thread;
+
+		int id;
+		int group;
+		int next;
+
+		bool alive;
+		bool slept;
+	};
+
 	struct CCobThreadComp: public spring::binary_function<const SleepingThread&, const SleepingThread&, bool> {
 	public:
 		bool operator() (const SleepingThread& a, const SleepingThread& b) const {
@@ -48,6 +65,7 @@ public:
 
 		runningThreadIDs.reserve(512);
 		waitingThreadIDs.reserve(512);
+		wokenThreadIDs.reserve(512);
 
 		threadCounter = 0;
 	}
@@ -60,6 +78,11 @@ public:
 
 		runningThreadIDs.clear();
 		waitingThreadIDs.clear();
+		wokenThreadIDs.clear();
+
+		batchGroups.clear();
+		batchThreads.clear();
+		batchGroupIndices.clear();
 
 		while (!sleepingThreadIDs.empty()) {
 			sleepingThreadIDs.pop();
@@ -112,11 +135,24 @@ public:
 private:
 	void TickThread(CCobThread* thread);
 
+	/**
+	 * Ticks <threadIDs> with the same observable order of side-effects as
+	 * calling TickThread on each, but runs the threads of every owner whose
+	 * threads are all local (see CCobThread::IsLocal) in parallel first and
+	 * only replays their scheduling and removal in order.
+	 */
+	void TickThreadBatch(const std::vector<int>& threadIDs);
+
 	void WakeSleepingThreads();
-	void TickRunningThreads() {
+	void WakeSleepingThreadsMT();
+	void TickRunningThreads(bool mtTick) {
 		// advance all currently running threads
-		for (const int threadID: runningThreadIDs) {
-			TickThread(GetThread(threadID));
+		if (mtTick) {
+			TickThreadBatch(runningThreadIDs);
+		} else {
+			for (const int threadID: runningThreadIDs) {
+				TickThread(GetThread(threadID));
+			}
 		}
 
 		// a thread can never go from running->running, so clear the list
@@ -137,6 +173,12 @@ private:
 
 	std::vector<int> runningThreadIDs;
 	std::vector<int> waitingThreadIDs;
+	// sleepers due this tick, only used by WakeSleepingThreadsMT
+	std::vector<int> wokenThreadIDs;
+
+	std::vector<BatchGroup> batchGroups;
+	std::vector<BatchThread> batchThreads;
+	spring::unordered_map<const CCobInstance*, int> batchGroupIndices;
 
 	// stores <id, waketime> pairs s.t. after waking up the ID can be checked
 	// for validity; thread owner might get removed while a thread is sleeping
@@ -144,6 +186,9 @@ private:
 
 	CCobThread* curThread = nullptr;
 
+	// set while TickThreadBatch runs local threads, which must not schedule
+	bool deferScheduling = false;
+
 	int currentTime = 0;
 	int threadCounter = 0;
 };
@@ -3,6 +3,7 @@
 
 #include "Sim/Misc/GlobalConstants.h"
 #include "CobFile.h"
+#include "CobOpcodes.h"
 #include "System/FileSystem/FileHandler.h"
 #include "System/Log/ILog.h"
 #include "System/Sound/ISound.h"
@@ -159,6 +160,18 @@ CCobFile::CCobFile(CFileHandler& in, const std::string& scriptName)
 		swabDWordInPlace(code[i]);
 	}
 
+	// threads start at these without checking, point broken ones at the
+	// trailing zero words so they die as unknown opcode
+	for (int i = 0; i < ch.NumberOfScripts; ++i) {
+		if (static_cast<unsigned int>(scriptOffsets[i]) < (codeWords - 3u))
+			continue;
+
+		LOG_L(L_WARNING, "[%s] script \"%s\" has an invalid offset for function \"%s\"", __func__, name.c_str(), scriptNames[i].c_str());
+
+		scriptOffsets[i] = codeWords - 1;
+		scriptLengths[i] = 0;
+	}
+
 	numStaticVars = ch.NumberOfStaticVars;
 
 	// if this is a TA:K script, read the sound names
@@ -187,6 +200,8 @@ CCobFile::CCobFile(CFileHandler& in, const std::string& scriptName)
 		scriptMap[scriptNames[i]] = i;
 	}
 
+	ResolveCalls();
+
 	// map common function names to indices
 	for (const auto& pair: CCobUnitScriptNames::GetScriptMap()) {
 		const int fn = GetFunctionId(pair.first);
@@ -199,6 +214,105 @@ CCobFile::CCobFile(CFileHandler& in, const std::string& scriptName)
 }
 
 
+// number of operands following <opcode> in the code stream, -1 if unknown
+static int GetOperandCount(int opcode)
+{
+	switch (opcode) {
+		case MOVE: case TURN: case SPIN: case STOP_SPIN: case MOVE_NOW: case TURN_NOW:
+		case WAIT_TURN: case WAIT_MOVE:
+		case START: case CALL: case REAL_CALL: case LUA_CALL:
+			return 2;
+
+		case SHOW: case HIDE: case CACHE: case DONT_CACHE: case SHADE: case DONT_SHADE: case EMIT_SFX:
+		case PUSH_CONSTANT: case PUSH_LOCAL_VAR: case PUSH_STATIC: case POP_LOCAL_VAR: case POP_STATIC:
+		case JUMP: case JUMP_NOT_EQUAL:
+		case EXPLODE: case PLAY_SOUND:
+			return 1;
+
+		case SLEEP: case CREATE_LOCAL_VAR: case POP_STACK:
+		case ADD: case SUB: case MUL: case DIV: case MOD:
+		case BITWISE_AND: case BITWISE_OR: case BITWISE_XOR: case BITWISE_NOT:
+		case RAND: case GET_UNIT_VALUE: case GET:
+		case SET_LESS: case SET_LESS_OR_EQUAL: case SET_GREATER: case SET_GREATER_OR_EQUAL:
+		case SET_EQUAL: case SET_NOT_EQUAL:
+		case LOGICAL_AND: case LOGICAL_OR: case LOGICAL_XOR: case LOGICAL_NOT:
+		case RETURN: case SIGNAL: case SET_SIGNAL_MASK:
+		case SET: case ATTACH: case DROP:
+			return 0;
+	}
+
+	return -1;
+}
+
+// true if executing <opcode> only reads or writes the thread itself and the
+// static vars and animations of its own instance; REAL_CALL depends on the
+// callee and is handled by ResolveCalls
+static bool IsLocalOpcode(int opcode)
+{
+	switch (opcode) {
+		case PUSH_CONSTANT: case PUSH_LOCAL_VAR: case PUSH_STATIC:
+		case CREATE_LOCAL_VAR: case POP_LOCAL_VAR: case POP_STATIC: case POP_STACK:
+		case ADD: case SUB: case MUL:
+		case BITWISE_AND: case BITWISE_OR: case BITWISE_XOR: case BITWISE_NOT:
+		case SET_LESS: case SET_LESS_OR_EQUAL: case SET_GREATER: case SET_GREATER_OR_EQUAL:
+		case SET_EQUAL: case SET_NOT_EQUAL:
+		case LOGICAL_AND: case LOGICAL_OR: case LOGICAL_XOR: case LOGICAL_NOT:
+		case JUMP: case JUMP_NOT_EQUAL: case RETURN: case REAL_CALL:
+		case SET_SIGNAL_MASK: case SLEEP: case WAIT_TURN: case WAIT_MOVE:
+		case CACHE: case DONT_CACHE: case SHADE: case DONT_SHADE:
+			return true;
+	}
+
+	// DIV and MOD log on division by zero, everything else reaches the unit,
+	// the sim (RAND, START, ...) or Lua
+	return false;
+}
+
+void CCobFile::ResolveCalls()
+{
+	std::vector< std::pair<int, int> > calls;
+
+	localScripts.clear();
+	localScripts.resize(scriptNames.size(), true);
+
+	for (size_t i = 0, n = scriptNames.size(); i < n; ++i) {
+		for (size_t pc = scriptOffsets[i], end = pc + scriptLengths[i]; pc < end; ) {
+			const int opcode = (pc < code.size())? code[pc]: 0;
+			const int numOps = GetOperandCount(opcode);
+
+			if (numOps < 0 || (pc + numOps) >= code.size()) {
+				localScripts[i] = false;
+				break;
+			}
+
+			if (opcode == CALL && static_cast<size_t>(code[pc + 1]) < n) {
+				// same rewrite the VM would do the first time this call executes,
+				// done here so that code is never modified while threads are run
+				code[pc] = (scriptNames[code[pc + 1]].find("lua_") == 0)? LUA_CALL: REAL_CALL;
+			}
+			if (code[pc] == REAL_CALL && static_cast<size_t>(code[pc + 1]) < n)
+				calls.emplace_back(i, code[pc + 1]);
+
+			localScripts[i] = localScripts[i] && IsLocalOpcode(code[pc]);
+			pc += (1 + numOps);
+		}
+	}
+
+	// propagate non-locality from callees to their callers
+	for (bool changed = true; changed; ) {
+		changed = false;
+
+		for (const auto& call: calls) {
+			if (!localScripts[call.first] || localScripts[call.second])
+				continue;
+
+			localScripts[call.first] = false;
+			changed = true;
+		}
+	}
+}
+
+
 int CCobFile::GetFunctionId(const std::string& name)
 {
 	const auto i = scriptMap.find(name);
@@ -32,6 +32,7 @@ public:
 		sounds = std::move(f.sounds);
 		luaScripts = std::move(f.luaScripts);
 		scriptMap = std::move(f.scriptMap);
+		localScripts = std::move(f.localScripts);
 
 		name = std::move(f.name);
 		return *this;
@@ -39,6 +40,11 @@ public:
 
 	int GetFunctionId(const std::string& name);
 
+	bool IsLocalScript(int functionId) const { return localScripts[functionId]; }
+
+private:
+	void ResolveCalls();
+
 public:
 	int numStaticVars = 0;
 
@@ -52,6 +58,9 @@ public:
 	std::vector<int> sounds;
 	std::vector<LuaHashString> luaScripts;
 	spring::unordered_map<std::string, int> scriptMap;
+	/// per script; true if it and everything it calls only touches the
+	/// running thread and its instance's static vars (see ResolveCalls)
+	std::vector<bool> localScripts;
 
 	std::string name;
 };
@@ -89,6 +89,9 @@ public:
 		return ((state == WaitMove && type == CCobInstance::AMove) || (state == WaitTurn && type == CCobInstance::ATurn));
 	}
 
+	/// true if no function on the call-stack can reach beyond this thread
+	/// and its instance's static vars, see CCobFile::ResolveCalls
+	bool IsLocal() const;
 	bool IsDead() const { return (state == Dead); }
 	bool IsGarbage() const { return (cobInst == nullptr); }
 	bool IsWaiting() const { return (waitAxis != -1); }
@@ -106,6 +109,7 @@ protected:
 	};
 
 	void LuaCall();
+	void Jump(int target);
 
 	bool PushCallStack(CallInfo v) { return (callStackSize < callStack.size() && PushCallStackRaw(v)); }
 	bool PushDataStack(     int v) { return (dataStackSize < dataStack.size() && PushDataStackRaw(v)); }
@@ -19,6 +19,8 @@
 #include "Sim/Projectiles/ExplosionGenerator.h"
 #include "Sim/Units/UnitHandler.h"
 #include "Sim/Units/Unit.h"
+#include "Sim/Units/UnitDef.h"
+#include "Sim/Units/UnitDefProfiler.h"
 #include "Sim/Weapons/PlasmaRepulser.h"
 #include "System/ContainerUtil.h"
 #include "System/SafeUtil.h"
@@ -903,7 +905,12 @@ bool CLuaUnitScript::RawRunCallIn(int functionId, int inArgs, int outArgs)
 	activeScript = this;
 
 	std::string err;
-	const int error = handle->RunCallInLUS(L, &err, inArgs, outArgs);
+	int error = 0;
+
+	{
+		SCOPED_UNITDEF_TIMER(unit->unitDef, CAT_LUA);
+		error = handle->RunCallInLUS(L, &err, inArgs, outArgs);
+	}
 
 	activeUnit = oldActiveUnit;
 	activeScript = oldActiveScript;
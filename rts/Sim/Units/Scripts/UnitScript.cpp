@@ -53,6 +53,9 @@ CR_REG_METADATA(CUnitScript, (
 	CR_MEMBER(unit),
 	CR_MEMBER(busy),
 	CR_MEMBER(anims),
+	// always empty when saving
+	CR_IGNORED(doneAnims),
+	CR_IGNORED(animsTicked),
 
 	//Populated by children
 	CR_IGNORED(pieces),
@@ -199,16 +202,28 @@ void CUnitScript::TickAnims(int tickRate, const TickAnimFunc& tickAnimFunc, Anim
  */
 bool CUnitScript::Tick(int deltaTime)
 {
-	// vector of indexes of finished animations,
-	// so we can get rid of them in constant time
-	static AnimContainerType doneAnims[AMove + 1];
+	TickAllAnims(deltaTime);
+	return (FinishAnims());
+}
+
+void CUnitScript::TickAllAnims(int deltaTime)
+{
 	// tick-functions; these never change address
 	static constexpr TickAnimFunc tickAnimFuncs[AMove + 1] = {&CUnitScript::TickTurnAnim, &CUnitScript::TickSpinAnim, &CUnitScript::TickMoveAnim};
 
+	assert(!animsTicked);
+
 	for (int animType = ATurn; animType <= AMove; animType++) {
 		TickAnims(1000 / deltaTime, tickAnimFuncs[animType], anims[animType], doneAnims[animType]);
 	}
 
+	animsTicked = true;
+}
+
+bool CUnitScript::FinishAnims()
+{
+	animsTicked = false;
+
 	// Tell listeners to unblock, and remove finished animations from the unit/script.
 	for (int animType = ATurn; animType <= AMove; animType++) {
 		for (AnimInfo& ai: doneAnims[animType]) {
@@ -43,6 +43,10 @@ protected:
 	typedef bool(CUnitScript::*TickAnimFunc)(int, LocalModelPiece&, AnimInfo&);
 
 	AnimContainerType anims[AMove + 1];
+	// finished animations with listeners, between TickAllAnims and FinishAnims
+	AnimContainerType doneAnims[AMove + 1];
+
+	bool animsTicked = false;
 
 
 	bool hasSetSFXOccupy;
@@ -107,6 +111,11 @@ public:
 	const CUnit* GetUnit() const { return unit; }
 
 	bool Tick(int tickRate);
+	/// first half of Tick; only touches this script's own pieces and animations
+	void TickAllAnims(int tickRate);
+	/// second half of Tick; notifies listeners of the animations finished by TickAllAnims
+	bool FinishAnims();
+	bool HasTickedAnims() const { return animsTicked; }
 	// note: must copy-and-set here (LMP dirty flag, etc)
 	bool TickMoveAnim(int tickRate, LocalModelPiece& lmp, AnimInfo& ai) { float3 pos = lmp.GetPosition(); const bool ret = MoveToward(pos[ai.axis], ai.dest, ai.speed / tickRate); lmp.SetPosition(pos); return ret; }
 	bool TickTurnAnim(int tickRate, LocalModelPiece& lmp, AnimInfo& ai) { float3 rot = lmp.GetRotation(); const bool ret = TurnToward(rot[ai.axis], ai.dest, ai.speed / tickRate); lmp.SetRotation(rot); return ret; }
@@ -142,7 +151,8 @@ public:
 		return (FindAnim(type, piece, axis) != anims[type].end());
 	}
 	bool HaveAnimations() const {
-		return (!anims[ATurn].empty() || !anims[ASpin].empty() || !anims[AMove].empty());
+		// also true while finished animations are still waiting for FinishAnims
+		return (animsTicked || !anims[ATurn].empty() || !anims[ASpin].empty() || !anims[AMove].empty());
 	}
 
 	// checks for callin existence
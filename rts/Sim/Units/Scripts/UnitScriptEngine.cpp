@@ -8,11 +8,14 @@
 #include "CobFileHandler.h"
 #include "UnitScript.h"
 #include "UnitScriptFactory.h"
+#include "Sim/Misc/ModInfo.h"
 #include "Sim/Units/Unit.h"
 #include "Sim/Units/UnitDef.h"
+#include "Sim/Units/UnitDefProfiler.h"
 #include "Sim/Units/UnitHandler.h"
 #include "System/ContainerUtil.h"
 #include "System/SafeUtil.h"
+#include "System/Threading/ThreadPool.h"
 
 static CCobEngine gCobEngine;
 static CCobFileHandler gCobFileHandler;
@@ -118,11 +121,30 @@ void CUnitScriptEngine::Tick(int deltaTime)
 {
 	cobEngine->Tick(deltaTime);
 
+	if (modInfo.mtScriptAnimUpdate) {
+		// advance every animation up front, this only moves the scripts'
+		// own pieces; listeners are notified below in the usual order
+		// the moved pieces' matrices are flushed here as well, since one
+		// of sim, collision or drawing will read most of them this frame
+		// and the values do not depend on when they are computed
+		for_mt(0, animating.size(), [&](const int i) {
+			SCOPED_UNITDEF_TIMER(animating[i]->GetUnit()->unitDef, CAT_SCRIPT);
+			animating[i]->TickAllAnims(deltaTime);
+			animating[i]->GetUnit()->localModel.UpdatePieceMatrices();
+		});
+	}
+
 	// tick all (COB or LUS) script instances that have registered themselves as animating
+	// instances added by a listener during this loop have not been ticked yet
 	for (size_t i = 0; i < animating.size(); ) {
 		currentScript = animating[i];
 
-		if (!currentScript->Tick(deltaTime)) {
+		if (!currentScript->HasTickedAnims()) {
+			SCOPED_UNITDEF_TIMER(currentScript->GetUnit()->unitDef, CAT_SCRIPT);
+			currentScript->TickAllAnims(deltaTime);
+		}
+
+		if (!currentScript->FinishAnims()) {
 			animating[i] = animating.back();
 			animating.pop_back();
 			continue;
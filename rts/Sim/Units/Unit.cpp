@@ -81,6 +81,8 @@ float CUnit::expHealthScale = 0.0f;
 float CUnit::expReloadScale = 0.0f;
 float CUnit::expGrade       = 0.0f;
 
+unsigned int CUnit::losStatusVersion = 0;
+
 
 CUnit::CUnit(): CSolidObject()
 {
@@ -198,22 +200,13 @@ void CUnit::PreInit(const UnitLoadParams& params)
 	{
 		const FeatureDef* wreckFeatureDef = featureDefHandler->GetFeatureDef(unitDef->wreckName);
 
-		if (wreckFeatureDef != nullptr) {
+		if (wreckFeatureDef != nullptr)
 			featureDefID = wreckFeatureDef->id;
-
-			while (wreckFeatureDef != nullptr) {
-				wreckFeatureDef->PreloadModel();
-				wreckFeatureDef = featureDefHandler->GetFeatureDefByID(wreckFeatureDef->deathFeatureDefID);
-			}
-		}
-	}
-	for (const auto it: unitDef->buildOptions) {
-		const UnitDef* ud = unitDefHandler->GetUnitDefByName(it.second);
-		if (ud == nullptr)
-			continue;
-		ud->PreloadModel();
 	}
 
+	if (!params.defModelsPreloaded)
+		CUnitLoader::PreloadUnitDefModels(unitDef);
+
 	team = params.teamID;
 	allyteam = teamHandler.AllyTeam(team);
 
@@ -630,9 +623,25 @@ void CUnit::Update()
 {
 	ASSERT_SYNCED(pos);
 
+	// already done by CUnitHandler's parallel compute phase if enabled
+	if (!localStateUpdated)
+		UpdateLocalState();
+
+	localStateUpdated = false;
+
+	UpdateTransportees(); // none if already dead
+}
+
+void CUnit::UpdateLocalState()
+{
+	// NOTE:
+	//   may run concurrently for different units (see CUnitHandler::UpdateUnits)
+	//   so must only read shared state and write to members of this unit or its
+	//   weapons; anything with external side-effects belongs in Update
 	UpdatePhysicalState(0.1f);
 	UpdatePosErrorParams(true, false);
-	UpdateTransportees(); // none if already dead
+
+	localStateUpdated = true;
 
 	if (beingBuilt)
 		return;
@@ -826,6 +835,8 @@ void CUnit::SetLosStatus(int at, unsigned short newStatus)
 	// without first clearing the IN{LOS, RADAR} bit
 	losStatus[at] |= newStatus;
 
+	losStatusVersion += ((diffBits & (LOS_INLOS | LOS_INRADAR)) != 0);
+
 	if (diffBits) {
 		if (diffBits & LOS_INLOS) {
 			if (newStatus & LOS_INLOS) {
@@ -2807,6 +2818,7 @@ CR_REG_METADATA(CUnit, (
 
 	CR_MEMBER(weapons),
 	CR_IGNORED(los),
+	CR_IGNORED(localStateUpdated),
 	CR_MEMBER(losStatus),
 	CR_MEMBER(posErrorMask),
 	CR_MEMBER(quads),
@@ -85,6 +85,11 @@ public:
 	virtual void Update();
 	virtual void SlowUpdate();
 
+	/// self-contained part of Update, safe to run for many units in parallel
+	void UpdateLocalState();
+	/// false if other units can change our state during the same update phase
+	bool CanUpdateLocalStateMT() const { return (!beingBuilt && transporter == nullptr); }
+
 	const SolidObjectDef* GetDef() const { return ((const SolidObjectDef*) unitDef); }
 
 	virtual void DoDamage(const DamageArray& damages, const float3& impulse, CUnit* attacker, int weaponDefID, int projectileID);
@@ -191,6 +196,8 @@ public:
 	bool IsInLosForAllyTeam(int allyTeam) const { return ((losStatus[allyTeam] & LOS_INLOS) != 0); }
 
 	void SetLosStatus(int allyTeam, unsigned short newStatus);
+	/// changes whenever any unit enters or leaves LOS or radar of any allyteam
+	static unsigned int GetLosStatusVersion() { return losStatusVersion; }
 	unsigned short CalcLosStatus(int allyTeam);
 	void UpdateLosStatus(int allyTeam);
 
@@ -568,6 +575,8 @@ public:
 private:
 	// if we are stunned by a weapon or for other reason, access via IsStunned/SetStunned(bool)
 	bool stunned = false;
+	// set by UpdateLocalState, consumed by Update; never true between frames
+	bool localStateUpdated = false;
 
 	static float empDeclineRate;
 	static float expMultiplier;
@@ -575,6 +584,8 @@ private:
 	static float expHealthScale;
 	static float expReloadScale;
 	static float expGrade;
+
+	static unsigned int losStatusVersion;
 };
 
 #endif // UNIT_H
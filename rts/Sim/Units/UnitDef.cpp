@@ -39,11 +39,11 @@ UnitDefWeapon::UnitDefWeapon(const WeaponDef* weaponDef, const LuaTable& weaponT
 	//     (arcs are always symmetric around mainDir)
 	this->maxMainDirAngleDif = math::cos((weaponTable.GetFloat("maxAngleDif", 360.0f) * 0.5f) * math::DEG_TO_RAD);
 
-	const string& btcString = weaponTable.GetString("badTargetCategory", "");
-	const string& otcString = weaponTable.GetString("onlyTargetCategory", "");
+	// resolved by UnitDef::ResolveCategories
+	this->badTargetCatString = weaponTable.GetString("badTargetCategory", "");
+	this->onlyTargetCatString = weaponTable.GetString("onlyTargetCategory", "");
 
-	this->badTargetCat =                                   CCategoryHandler::Instance()->GetCategories(btcString);
-	this->onlyTargetCat = (otcString.empty())? 0xffffffff: CCategoryHandler::Instance()->GetCategories(otcString);
+	this->onlyTargetCat = 0xffffffff;
 
 	this->mainDir = weaponTable.GetFloat3("mainDir", FwdVector);
 	this->mainDir.SafeNormalize();
@@ -483,10 +483,9 @@ UnitDef::UnitDef(const LuaTable& udTable, const std::string& unitName, int id)
 	maxThisUnit = udTable.GetInt("unitRestricted", MAX_UNITS);
 	maxThisUnit = std::min(maxThisUnit, gameSetup->GetRestrictedUnitLimit(name, MAX_UNITS));
 
+	// the bits are resolved later, see ResolveCategories
 	categoryString = udTable.GetString("category", "");
-
-	category = CCategoryHandler::Instance()->GetCategories(udTable.GetString("category", ""));
-	noChaseCategory = CCategoryHandler::Instance()->GetCategories(udTable.GetString("noChaseCategory", ""));
+	noChaseCategoryString = udTable.GetString("noChaseCategory", "");
 
 	iconType = icon::iconHandler.GetIcon(udTable.GetString("iconType", "default"));
 
@@ -793,6 +792,22 @@ void UnitDef::CreateYardMap(std::string&& yardMapStr)
 
 
 
+void UnitDef::ResolveCategories()
+{
+	CCategoryHandler* categoryHandler = CCategoryHandler::Instance();
+
+	category = categoryHandler->GetCategories(categoryString);
+	noChaseCategory = categoryHandler->GetCategories(noChaseCategoryString);
+
+	for (UnitDefWeapon& udw: weapons) {
+		udw.badTargetCat = categoryHandler->GetCategories(udw.badTargetCatString);
+
+		if (!udw.onlyTargetCatString.empty())
+			udw.onlyTargetCat = categoryHandler->GetCategories(udw.onlyTargetCatString);
+	}
+}
+
+
 void UnitDef::SetNoCost(bool noCost)
 {
 	if (noCost) {
@@ -41,6 +41,9 @@ struct UnitDefWeapon {
 	unsigned int badTargetCat = 0;
 	unsigned int onlyTargetCat = 0;
 
+	std::string badTargetCatString;
+	std::string onlyTargetCatString;
+
 	float3 mainDir = FwdVector;
 };
 
@@ -51,6 +54,11 @@ public:
 	UnitDef(const LuaTable& udTable, const std::string& unitName, int id);
 	UnitDef();
 
+	/**
+	 * Category bits are handed out in order of first use, so unlike
+	 * the constructor this has to be called serially and in ID order.
+	 */
+	void ResolveCategories();
 	void SetNoCost(bool noCost);
 
 	bool IsTransportUnit()     const { return (transportCapacity > 0 && transportMass > 0.0f); }
@@ -208,6 +216,7 @@ public:
 	std::string tooltip;
 	std::string wreckName;
 	std::string categoryString;
+	std::string noChaseCategoryString;
 	std::string buildPicName;
 
 	std::array<UnitDefWeapon, MAX_WEAPONS_PER_UNIT> weapons;
@@ -12,7 +12,9 @@
 #include "System/Exceptions.h"
 #include "System/Log/ILog.h"
 #include "System/StringUtil.h"
+#include "System/Platform/Watchdog.h"
 #include "System/Sound/ISound.h"
+#include "System/Threading/ThreadPool.h"
 
 
 static CUnitDefHandler gUnitDefHandler;
@@ -42,12 +44,37 @@ void CUnitDefHandler::Init(LuaParser* defsParser)
 	unitDefsVector.reserve(unitDefNames.size() + 1);
 	unitDefsVector.emplace_back();
 
-	for (unsigned int a = 0; a < unitDefNames.size(); ++a) {
-		const string& unitName = unitDefNames[a];
-		const LuaTable& udTable = rootTable.SubTable(unitName);
+	std::vector<LuaTable> udTables(unitDefNames.size());
+	std::vector<UnitDef> unitDefs(unitDefNames.size());
+	std::vector<std::exception_ptr> errors(unitDefNames.size());
 
+	const auto ParseUnitDef = [&](int i) {
 		// parse the unitdef data (but don't load buildpics, etc...)
-		PushNewUnitDef(StringToLower(unitName), udTable);
+		try {
+			unitDefs[i] = UnitDef(udTables[i], StringToLower(unitDefNames[i]), 0);
+		} catch (...) {
+			errors[i] = std::current_exception();
+		}
+	};
+
+	// only the Lua state is single-threaded; detached tables are plain data
+	for (unsigned int a = 0; a < unitDefNames.size(); ++a) {
+		udTables[a] = rootTable.SubTable(unitDefNames[a]).Detach();
+
+		if (!udTables[a].IsDetached())
+			ParseUnitDef(a);
+	}
+
+	for_mt(0, unitDefNames.size(), [&](const int i) {
+		Watchdog::ClearTimer(WDT_LOAD);
+
+		if (udTables[i].IsDetached())
+			ParseUnitDef(i);
+	});
+
+	// everything order-dependent (categories, sounds, IDs) happens in sequence
+	for (unsigned int a = 0; a < unitDefNames.size(); ++a) {
+		PushNewUnitDef(StringToLower(unitDefNames[a]), udTables[a], std::move(unitDefs[a]), errors[a]);
 	}
 
 	CleanBuildOptions();
@@ -57,6 +84,20 @@ void CUnitDefHandler::Init(LuaParser* defsParser)
 
 
 int CUnitDefHandler::PushNewUnitDef(const std::string& unitName, const LuaTable& udTable)
+{
+	std::exception_ptr error;
+	UnitDef unitDef;
+
+	try {
+		unitDef = UnitDef(udTable, unitName, 0);
+	} catch (...) {
+		error = std::current_exception();
+	}
+
+	return (PushNewUnitDef(unitName, udTable, std::move(unitDef), error));
+}
+
+int CUnitDefHandler::PushNewUnitDef(const std::string& unitName, const LuaTable& udTable, UnitDef&& unitDef, std::exception_ptr error)
 {
 	if (std::find_if(unitName.begin(), unitName.end(), isblank) != unitName.end())
 		LOG_L(L_WARNING, "[%s] UnitDef name \"%s\" contains white-spaces", __func__, unitName.c_str());
@@ -64,8 +105,13 @@ int CUnitDefHandler::PushNewUnitDef(const std::string& unitName, const LuaTable&
 	const int defID = unitDefsVector.size();
 
 	try {
-		unitDefsVector.emplace_back(udTable, unitName, defID);
+		if (error != nullptr)
+			std::rethrow_exception(error);
+
+		unitDefsVector.emplace_back(std::move(unitDef));
 		UnitDef& newDef = unitDefsVector.back();
+		newDef.id = defID;
+		newDef.ResolveCategories();
 		UnitDefLoadSounds(&newDef, udTable);
 
 		// map unitName to newDef.decoyName
@@ -3,6 +3,7 @@
 #ifndef UNITDEFHANDLER_H
 #define UNITDEFHANDLER_H
 
+#include <exception>
 #include <string>
 #include <vector>
 
@@ -53,6 +54,8 @@ public:
 	unsigned int NumUnitDefs() const { return (unitDefsVector.size() - 1); }
 
 	int PushNewUnitDef(const std::string& unitName, const LuaTable& udTable);
+	/// takes a def created from udTable (or the error this produced) for ID assignment
+	int PushNewUnitDef(const std::string& unitName, const LuaTable& udTable, UnitDef&& unitDef, std::exception_ptr error);
 
 	const std::vector<UnitDef>& GetUnitDefsVec() const { return unitDefsVector; }
 	const spring::unordered_map<std::string, int>& GetUnitDefIDs() const { return unitDefIDs; }
@@ -0,0 +1,75 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+
+#include "UnitDefProfiler.h"
+#include "UnitDefHandler.h"
+#include "System/Config/ConfigHandler.h"
+
+CONFIG(bool, ProfileUnitDefs).defaultValue(false).description("Accumulate sim time spent per UnitDef (update, weapons, movetype, scripts), see Spring.GetUnitDefProfile.");
+
+CUnitDefProfiler unitDefProfiler;
+
+
+void CUnitDefProfiler::Init()
+{
+	enabled = configHandler->GetBool("ProfileUnitDefs");
+	// ID 0 is reserved for the null-def
+	numUnitDefs = unitDefHandler->NumUnitDefs() + 1;
+
+	threadCounters.clear();
+
+	if (!enabled)
+		return;
+
+	threadCounters.resize(ThreadPool::GetMaxThreads());
+
+	for (auto& counters: threadCounters) {
+		counters.resize(numUnitDefs * CAT_COUNT);
+	}
+}
+
+void CUnitDefProfiler::Kill()
+{
+	enabled = false;
+	numUnitDefs = 0;
+
+	threadCounters.clear();
+}
+
+void CUnitDefProfiler::Reset()
+{
+	for (auto& counters: threadCounters) {
+		std::fill(counters.begin(), counters.end(), Counter{});
+	}
+}
+
+
+std::vector<CUnitDefProfiler::Counter> CUnitDefProfiler::GetTotals() const
+{
+	std::vector<Counter> totals(numUnitDefs * CAT_COUNT);
+
+	for (const auto& counters: threadCounters) {
+		for (size_t i = 0, n = counters.size(); i < n; i++) {
+			totals[i].nanos += counters[i].nanos;
+			totals[i].calls += counters[i].calls;
+		}
+	}
+
+	return totals;
+}
+
+const char* CUnitDefProfiler::GetCategoryName(unsigned int cat)
+{
+	constexpr const char* names[CAT_COUNT + 1] = {
+		"update",
+		"slowUpdate",
+		"weapons",
+		"moveType",
+		"script",
+		"lua",
+		"unknown",
+	};
+
+	return names[std::min(cat, unsigned(CAT_COUNT))];
+}
@@ -0,0 +1,97 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef UNITDEF_PROFILER_H
+#define UNITDEF_PROFILER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "System/Misc/SpringTime.h"
+#include "System/Threading/ThreadPool.h"
+
+/**
+ * Optional accounting of sim time per UnitDef, so the types behind a slow
+ * Sim::Unit or script timer can be found. Samples go into counters owned
+ * by the calling thread (no atomics or locks), GetTotals sums them and is
+ * meant to be called from the main thread between sim frames.
+ *
+ * Categories are measured independently and nest, e.g. call-ins of
+ * Lua unit scripts made from CUnit::Update count towards both UPDATE and
+ * LUA. Disabled (the default) each scope costs a single branch.
+ */
+class CUnitDefProfiler {
+public:
+	enum Category {
+		CAT_UPDATE     = 0, // CUnit::Update
+		CAT_SLOWUPDATE = 1, // CUnit::SlowUpdate
+		CAT_WEAPONS    = 2, // CUnit::{Slow}UpdateWeapons
+		CAT_MOVETYPE   = 3, // AMoveType::Update
+		CAT_SCRIPT     = 4, // COB threads and piece animations
+		CAT_LUA        = 5, // Lua unit script call-ins
+		CAT_COUNT      = 6,
+	};
+
+	struct Counter {
+		uint64_t nanos = 0;
+		uint64_t calls = 0;
+	};
+
+	struct Scope {
+	public:
+		Scope(int unitDefID, Category cat);
+		~Scope();
+
+	private:
+		Counter* counter;
+		spring_time startTime;
+	};
+
+public:
+	void Init();
+	void Kill();
+	void Reset();
+
+	bool IsEnabled() const { return enabled; }
+	size_t NumUnitDefs() const { return numUnitDefs; }
+
+	/// summed over all threads, indexed by unitDefID * CAT_COUNT + category
+	std::vector<Counter> GetTotals() const;
+
+	static const char* GetCategoryName(unsigned int cat);
+
+	Counter* GetCounter(int unitDefID, Category cat) {
+		if (!enabled)
+			return nullptr;
+
+		return &threadCounters[ThreadPool::GetThreadNum()][unitDefID * CAT_COUNT + cat];
+	}
+
+private:
+	// [threadNum][unitDefID * CAT_COUNT + category]
+	std::vector< std::vector<Counter> > threadCounters;
+
+	size_t numUnitDefs = 0;
+	bool enabled = false;
+};
+
+extern CUnitDefProfiler unitDefProfiler;
+
+
+inline CUnitDefProfiler::Scope::Scope(int unitDefID, Category cat): counter(unitDefProfiler.GetCounter(unitDefID, cat))
+{
+	if (counter != nullptr)
+		startTime = spring_gettime();
+}
+
+inline CUnitDefProfiler::Scope::~Scope()
+{
+	if (counter == nullptr)
+		return;
+
+	counter->nanos += (spring_gettime() - startTime).toNanoSecsi();
+	counter->calls += 1;
+}
+
+#define SCOPED_UNITDEF_TIMER(unitDef, cat) CUnitDefProfiler::Scope __unitDefTimer((unitDef)->id, CUnitDefProfiler::cat)
+
+#endif // UNITDEF_PROFILER_H
@@ -1,10 +1,13 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <algorithm>
 #include <cassert>
 
 #include "UnitHandler.h"
 #include "Unit.h"
+#include "UnitDef.h"
 #include "UnitDefHandler.h"
+#include "UnitDefProfiler.h"
 #include "UnitMemPool.h"
 #include "UnitTypes/Builder.h"
 #include "UnitTypes/ExtractorBuilding.h"
@@ -12,7 +15,9 @@
 
 #include "CommandAI/BuilderCAI.h"
 #include "Sim/Misc/GlobalSynced.h"
+#include "Sim/Misc/ModInfo.h"
 #include "Sim/Misc/TeamHandler.h"
+#include "Sim/MoveTypes/AAirMoveType.h"
 #include "Sim/MoveTypes/MoveType.h"
 #include "Sim/Path/IPathManager.h"
 #include "Sim/Weapons/Weapon.h"
@@ -36,9 +41,13 @@ CR_REG_METADATA(CUnitHandler, (
 	CR_MEMBER(unitsToBeRemoved),
 
 	CR_MEMBER(builderCAIs),
+	CR_IGNORED(unitLosStates),
+	CR_IGNORED(deletedUnitMask),
+	CR_IGNORED(deletedTeamMask),
 
 	CR_MEMBER(activeSlowUpdateUnit),
 	CR_MEMBER(activeUpdateUnit),
+	CR_MEMBER(slowUpdateBudget),
 
 	CR_MEMBER(maxUnits),
 	CR_MEMBER(maxUnitRadius),
@@ -100,6 +109,7 @@ void CUnitHandler::Init() {
 	{
 		activeSlowUpdateUnit = 0;
 		activeUpdateUnit = 0;
+		slowUpdateBudget = 0;
 	}
 	{
 		units.resize(maxUnits, nullptr);
@@ -116,6 +126,8 @@ void CUnitHandler::Init() {
 			unitsByDefs[teamNum].resize(unitDefHandler->NumUnitDefs() + 1);
 		}
 	}
+
+	unitDefProfiler.Init();
 }
 
 
@@ -151,6 +163,8 @@ void CUnitHandler::Kill()
 		maxUnits = 0;
 		maxUnitRadius = 0.0f;
 	}
+
+	unitDefProfiler.Kill();
 }
 
 
@@ -258,9 +272,66 @@ bool CUnitHandler::QueueDeleteUnit(CUnit* unit)
 
 void CUnitHandler::DeleteUnits()
 {
-	while (!unitsToBeRemoved.empty()) {
+	if (unitsToBeRemoved.empty())
+		return;
+
+	// single deaths (and GarbageCollectUnit) are not worth building masks
+	if (unitsToBeRemoved.size() == 1) {
 		DeleteUnit(unitsToBeRemoved.back());
 		unitsToBeRemoved.pop_back();
+		return;
+	}
+
+	// after a mass death, finding and erasing every unit separately in
+	// activeUnits and its team's list is quadratic; mark them instead so
+	// each list is compacted in one pass (activeUnits keeps its order)
+	deletedUnitMask.clear();
+	deletedUnitMask.resize(units.size(), false);
+	deletedTeamMask.fill(false);
+
+	for (auto it = unitsToBeRemoved.rbegin(); it != unitsToBeRemoved.rend(); ++it) {
+		CUnit* delUnit = *it;
+
+		assert(delUnit->isDead);
+		// we want to call RenderUnitDestroyed while the unit is still valid
+		eventHandler.RenderUnitDestroyed(delUnit);
+		teamHandler.Team(delUnit->team)->RemoveUnit(delUnit, CTeam::RemoveDied);
+
+		deletedUnitMask[delUnit->id] = true;
+		deletedTeamMask[delUnit->team] = true;
+	}
+
+	const auto isDeleted = [&](const CUnit* u) { return deletedUnitMask[u->id]; };
+
+	{
+		// units before the SlowUpdate cursor shift it down, as in DeleteUnit
+		const size_t slowUpdateEnd = std::min(activeSlowUpdateUnit, activeUnits.size());
+
+		activeSlowUpdateUnit -= std::count_if(activeUnits.begin(), activeUnits.begin() + slowUpdateEnd, isDeleted);
+		activeUnits.erase(std::remove_if(activeUnits.begin(), activeUnits.end(), isDeleted), activeUnits.end());
+	}
+
+	for (int teamNum = 0; teamNum < MAX_TEAMS; teamNum++) {
+		if (!deletedTeamMask[teamNum])
+			continue;
+
+		for (std::vector<CUnit*>& teamDefUnits: unitsByDefs[teamNum]) {
+			teamDefUnits.erase(std::remove_if(teamDefUnits.begin(), teamDefUnits.end(), isDeleted), teamDefUnits.end());
+		}
+	}
+
+	while (!unitsToBeRemoved.empty()) {
+		CUnit* delUnit = unitsToBeRemoved.back();
+
+		idPool.FreeID(delUnit->id, true);
+
+		units[delUnit->id] = nullptr;
+
+		CSolidObject::SetDeletingRefID(delUnit->id);
+		unitMemPool.free(delUnit);
+		CSolidObject::SetDeletingRefID(-1);
+
+		unitsToBeRemoved.pop_back();
 	}
 }
 
@@ -304,6 +375,9 @@ void CUnitHandler::UpdateUnitMoveTypes()
 {
 	SCOPED_TIMER("Sim::Unit::MoveType");
 
+	if (modInfo.mtAirCollisionChecks)
+		AAirMoveType::PrecomputeCollisionChecks(activeUnits);
+
 	for (activeUpdateUnit = 0; activeUpdateUnit < activeUnits.size(); ++activeUpdateUnit) {
 		CUnit* unit = activeUnits[activeUpdateUnit];
 		AMoveType* moveType = unit->moveType;
@@ -311,7 +385,14 @@ void CUnitHandler::UpdateUnitMoveTypes()
 		unit->SanityCheck();
 		unit->PreUpdate();
 
-		if (moveType->Update())
+		bool moved = false;
+
+		{
+			SCOPED_UNITDEF_TIMER(unit->unitDef, CAT_MOVETYPE);
+			moved = moveType->Update();
+		}
+
+		if (moved)
 			eventHandler.UnitMoved(unit);
 
 		// this unit is not coming back, kill it now without any death
@@ -326,28 +407,77 @@ void CUnitHandler::UpdateUnitMoveTypes()
 
 void CUnitHandler::UpdateUnitLosStates()
 {
-	for (CUnit* unit: activeUnits) {
-		for (int at = 0; at < teamHandler.ActiveAllyTeams(); ++at) {
+	const size_t numUnits = activeUnits.size();
+	const size_t numAllyTeams = teamHandler.ActiveAllyTeams();
+
+	// compute phase; CalcLosStatus only reads the LOS maps and unit state
+	unitLosStates.resize(numUnits * numAllyTeams);
+
+	for_mt_chunk(0, numUnits, [&](const int i) {
+		CUnit* unit = activeUnits[i];
+
+		for (size_t at = 0; at < numAllyTeams; ++at) {
+			unitLosStates[i * numAllyTeams + at] = unit->CalcLosStatus(at);
+		}
+	});
+
+	// commit phase, in activeUnits order; statuses that did not change are
+	// skipped, all others are recomputed since LOS call-ins sent for units
+	// earlier in the list may have changed masks, cloak state or positions
+	// (anything that only such a call-in would change is picked up a frame
+	// later, units created by them are always updated)
+	for (size_t i = 0; i < activeUnits.size(); ++i) {
+		CUnit* unit = activeUnits[i];
+
+		for (size_t at = 0; at < numAllyTeams; ++at) {
+			if (i < numUnits && unitLosStates[i * numAllyTeams + at] == unit->losStatus[at])
+				continue;
+
 			unit->UpdateLosStatus(at);
 		}
 	}
 }
 
 
+// relative SlowUpdate cost, estimated from synced state only; weapons
+// (target search) and builders (area scans) dominate, walls are cheap
+static size_t SlowUpdateCost(const CUnit* unit)
+{
+	size_t cost = 1;
+
+	cost += (unit->weapons.size() * 2);
+	cost += (unit->unitDef->IsBuilderUnit() * 4);
+	cost += (unit->moveDef != nullptr);
+	return cost;
+}
+
 void CUnitHandler::SlowUpdateUnits()
 {
 	SCOPED_TIMER("Sim::Unit::SlowUpdate");
 	assert(activeSlowUpdateUnit >= 0);
 
-	// reset the iterator every <UNIT_SLOWUPDATE_RATE> frames
-	if ((gs->frameNum % UNIT_SLOWUPDATE_RATE) == 0)
+	// reset the iterator every <UNIT_SLOWUPDATE_RATE> frames, and spread
+	// the estimated cost of the whole cycle (rather than the unit count)
+	// evenly over its frames so clusters of heavy units do not all land
+	// in the same one; each frame still covers a contiguous range, every
+	// unit present at the start of a cycle is reached within it
+	if ((gs->frameNum % UNIT_SLOWUPDATE_RATE) == 0) {
 		activeSlowUpdateUnit = 0;
+		slowUpdateBudget = 0;
+
+		for (const CUnit* unit: activeUnits) {
+			slowUpdateBudget += SlowUpdateCost(unit);
+		}
 
-	const size_t idxBeg = activeSlowUpdateUnit;
-	const size_t maximumCnt = activeUnits.size() - idxBeg;
-	const size_t logicalCnt = (activeUnits.size() / UNIT_SLOWUPDATE_RATE) + 1;
-	const size_t indCnt = logicalCnt > maximumCnt ? maximumCnt : logicalCnt;
-	const size_t idxEnd = idxBeg + indCnt;
+		slowUpdateBudget = (slowUpdateBudget / UNIT_SLOWUPDATE_RATE) + 1;
+	}
+
+	const size_t idxBeg = std::min(activeSlowUpdateUnit, activeUnits.size());
+	size_t idxEnd = idxBeg;
+
+	for (size_t cost = 0; idxEnd < activeUnits.size() && cost < slowUpdateBudget; ++idxEnd) {
+		cost += SlowUpdateCost(activeUnits[idxEnd]);
+	}
 
 	activeSlowUpdateUnit = idxEnd;
 
@@ -356,8 +486,14 @@ void CUnitHandler::SlowUpdateUnits()
 		CUnit* unit = activeUnits[i];
 
 		unit->SanityCheck();
-		unit->SlowUpdate();
-		unit->SlowUpdateWeapons();
+		{
+			SCOPED_UNITDEF_TIMER(unit->unitDef, CAT_SLOWUPDATE);
+			unit->SlowUpdate();
+		}
+		{
+			SCOPED_UNITDEF_TIMER(unit->unitDef, CAT_WEAPONS);
+			unit->SlowUpdateWeapons();
+		}
 		unit->localModel.UpdateBoundingVolume();
 		unit->SanityCheck();
 	}
@@ -411,9 +547,16 @@ void CUnitHandler::MultiThreadPathRequests(std::vector<CUnit*>& unitsToMove)
 	size_t unitsToMoveCount = unitsToMove.size();
 
 	// Carry out the pathing requests without heatmap updates.
+	// Identical searches are shared between requests, the index
+	// of each request decides whose result is used.
+	TKPFS::BeginPathRequests(unitsToMoveCount);
+
 	for_mt(0, unitsToMoveCount, [&unitsToMove](const int i){
 		CUnit* unit = unitsToMove[i];
+
+		TKPFS::SetPathRequestIndex(i);
 		unit->moveType->DelayedReRequestPath();
+		TKPFS::FinishPathRequest(i);
 	});
 
 	// update cache
@@ -462,11 +605,31 @@ void CUnitHandler::UpdateUnits()
 {
 	SCOPED_TIMER("Sim::Unit::Update");
 
+	if (modInfo.mtUnitUpdate) {
+		// compute phase; each unit only writes to its own state here so the
+		// order does not matter, units that can be moved or finished by some
+		// other unit's Update (transportees, buildees) are left to the serial
+		// phase
+		for_mt_chunk(0, activeUnits.size(), [this](const int i) {
+			CUnit* unit = activeUnits[i];
+
+			if (!unit->CanUpdateLocalStateMT())
+				return;
+
+			unit->UpdateLocalState();
+		});
+	}
+
+	// commit phase; side-effects (transportee moves, blocking-map updates,
+	// build progress, events) always happen in fixed activeUnits order
 	for (activeUpdateUnit = 0; activeUpdateUnit < activeUnits.size(); ++activeUpdateUnit) {
 		CUnit* unit = activeUnits[activeUpdateUnit];
 
 		unit->SanityCheck();
-		unit->Update();
+		{
+			SCOPED_UNITDEF_TIMER(unit->unitDef, CAT_UPDATE);
+			unit->Update();
+		}
 		unit->moveType->UpdateCollisionMap();
 		// unsynced; done on-demand when drawing unit
 		// unit->UpdateLocalModel();
@@ -480,13 +643,18 @@ void CUnitHandler::UpdateUnitWeapons()
 {
 	SCOPED_TIMER("Sim::Unit::Weapon");
 	for (activeUpdateUnit = 0; activeUpdateUnit < activeUnits.size(); ++activeUpdateUnit) {
-		activeUnits[activeUpdateUnit]->UpdateWeapons();
+		CUnit* unit = activeUnits[activeUpdateUnit];
+
+		SCOPED_UNITDEF_TIMER(unit->unitDef, CAT_WEAPONS);
+		unit->UpdateWeapons();
 	}
 }
 
 
 void CUnitHandler::Update()
 {
+	SCOPED_TIMER("Sim::Unit");
+
 	inUpdateCall = true;
 
 	DeleteUnits();
@@ -101,9 +101,17 @@ private:
 
 	spring::unordered_map<unsigned int, CBuilderCAI*> builderCAIs;
 
+	///< scratch buffer for UpdateUnitLosStates, {activeUnits x allyteams}
+	std::vector<unsigned short> unitLosStates;
+
+	///< scratch buffers for DeleteUnits, indexed by unit ID and by team
+	std::vector<bool> deletedUnitMask;
+	std::array<bool, MAX_TEAMS> deletedTeamMask;
+
 
 	size_t activeSlowUpdateUnit = 0;  ///< first unit of batch that will be SlowUpdate'd this frame
 	size_t activeUpdateUnit = 0;      ///< first unit of batch that will be SlowUpdate'd this frame
+	size_t slowUpdateBudget = 0;      ///< estimated SlowUpdate cost per frame of the current cycle
 
 
 	///< global unit-limit (derived from the per-team limit)
@@ -107,6 +107,72 @@ CUnit* CUnitLoader::LoadUnit(const UnitLoadParams& params)
 	return unit;
 }
 
+void CUnitLoader::LoadUnits(const UnitLoadParams& params, const std::vector<float3>& positions, bool checkTeamLimits, std::vector<CUnit*>& units)
+{
+	units.clear();
+	units.reserve(positions.size());
+
+	const UnitDef* ud = params.unitDef;
+
+	if (ud == nullptr)
+		return;
+
+	UnitLoadParams unitParams = params;
+
+	if (unitParams.teamID < 0) {
+		if (teamHandler.GaiaTeamID() < 0) {
+			LOG_L(L_WARNING, "[%s] invalid team %d and no Gaia-team", __func__, unitParams.teamID);
+			return;
+		}
+
+		unitParams.teamID = teamHandler.GaiaTeamID();
+	}
+
+	// per-def work shared by the whole batch; otherwise every
+	// spawn re-queues a preload for each of its build options
+	if (!unitParams.defModelsPreloaded)
+		PreloadUnitDefModels(ud);
+
+	unitParams.unitID = -1;
+	unitParams.defModelsPreloaded = true;
+
+	for (const float3& pos: positions) {
+		if (!unitHandler.CanAddUnit(-1))
+			break;
+		if (checkTeamLimits && !unitHandler.CanBuildUnit(ud, unitParams.teamID))
+			break;
+
+		unitParams.pos = pos;
+
+		CUnit* unit = CUnitHandler::NewUnit(ud);
+
+		unit->PreInit(unitParams);
+		unit->PostInit(unitParams.builder);
+
+		if (unitParams.flattenGround)
+			FlattenGround(unit);
+
+		units.push_back(unit);
+	}
+}
+
+void CUnitLoader::PreloadUnitDefModels(const UnitDef* ud)
+{
+	const FeatureDef* wreckFeatureDef = featureDefHandler->GetFeatureDef(ud->wreckName);
+
+	while (wreckFeatureDef != nullptr) {
+		wreckFeatureDef->PreloadModel();
+		wreckFeatureDef = featureDefHandler->GetFeatureDefByID(wreckFeatureDef->deathFeatureDefID);
+	}
+
+	for (const auto it: ud->buildOptions) {
+		const UnitDef* bod = unitDefHandler->GetUnitDefByName(it.second);
+		if (bod == nullptr)
+			continue;
+		bod->PreloadModel();
+	}
+}
+
 
 
 void CUnitLoader::ParseAndExecuteGiveUnitsCommand(const std::vector<std::string>& args, int team)
@@ -249,30 +315,41 @@ void CUnitLoader::GiveUnits(const std::string& objectName, float3 pos, int amoun
 
 			int unitsLoaded = numRequestedUnits;
 
+			std::vector<float3> positions;
+			std::vector<CUnit*> units;
+
+			positions.reserve(numRequestedUnits);
+
 			for (int z = 0; z < squareSize; ++z) {
 				for (int x = 0; x < squareSize && (unitsLoaded-- > 0); ++x) {
 					const float px = squarePos.x + x * xsize * SQUARE_SIZE;
 					const float pz = squarePos.z + z * zsize * SQUARE_SIZE;
 
-					Watchdog::ClearTimers(false, true);
+					positions.emplace_back(px, CGround::GetHeightReal(px, pz), pz);
+				}
+			}
 
-					const UnitLoadParams unitParams = {
-						unitDef,
-						nullptr,
+			const UnitLoadParams unitParams = {
+				unitDef,
+				nullptr,
 
-						float3(px, CGround::GetHeightReal(px, pz), pz),
-						ZeroVector,
+				ZeroVector,
+				ZeroVector,
 
-						-1,
-						team,
-						FACING_SOUTH,
+				-1,
+				team,
+				FACING_SOUTH,
 
-						false,
-						true,
-					};
+				false,
+				true,
+			};
 
-					LoadUnit(unitParams);
-				}
+			// spawn in slices so the watchdog still sees progress
+			for (size_t i = 0; i < positions.size(); i += 64) {
+				const std::vector<float3> slice(positions.begin() + i, positions.begin() + std::min(i + 64, positions.size()));
+
+				Watchdog::ClearTimers(false, true);
+				LoadUnits(unitParams, slice, false, units);
 			}
 
 			LOG("[%s] spawned %i %s unit(s) for team %i",
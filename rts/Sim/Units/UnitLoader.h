@@ -28,6 +28,9 @@ struct UnitLoadParams {
 
 	bool beingBuilt;
 	bool flattenGround;
+
+	/// set if PreloadUnitDefModels was already called for unitDef
+	bool defModelsPreloaded = false;
 };
 
 class CUnitLoader
@@ -38,6 +41,12 @@ public:
 
 	CUnit* LoadUnit(const std::string& name, const UnitLoadParams& params);
 	CUnit* LoadUnit(const UnitLoadParams& params);
+	/// spawns one unit of params.unitDef at each position (params.pos and
+	/// params.unitID are ignored), stops early if the unit limit is reached
+	void LoadUnits(const UnitLoadParams& params, const std::vector<float3>& positions, bool checkTeamLimits, std::vector<CUnit*>& units);
+
+	/// preloads the wreck and build-option models of a unit type
+	static void PreloadUnitDefModels(const UnitDef* ud);
 
 	CWeapon* LoadWeapon(CUnit* owner, const UnitDefWeapon* udw);
 
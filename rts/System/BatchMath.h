@@ -0,0 +1,173 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef BATCH_MATH_H
+#define BATCH_MATH_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "System/float3.h"
+#include "System/Matrix44f.h"
+#include "System/FastMath.h"
+
+#include "xsimd/xsimd.hpp"
+
+/**
+ * SIMD kernels over arrays of vectors stored as one array per component.
+ *
+ * Every kernel performs the same operations in the same order per lane as
+ * the scalar float3 / CMatrix44f code it replaces, and elements which do
+ * not fill a whole register go through that scalar code; results are thus
+ * bit-identical to the scalar path (and sync-safe wherever it is), as long
+ * as neither side is compiled with FMA contraction.
+ */
+namespace BatchMath {
+	using SIMDVfloat = xsimd::simd_type<float>;
+	using SIMDVint = xsimd::batch<std::int32_t, SIMDVfloat::size>;
+
+	static constexpr size_t SIMD_SIZE = SIMDVfloat::size;
+
+	namespace detail {
+		// fastmath::isqrt2_nosse (math::isqrt) per lane
+		inline SIMDVfloat isqrt(const SIMDVfloat& v) {
+			const SIMDVfloat xh = SIMDVfloat(0.5f) * v;
+			const SIMDVint i = SIMDVint(0x5f375a86) - (xsimd::bitwise_cast<SIMDVint>(v) >> 1);
+
+			SIMDVfloat x = xsimd::bitwise_cast<SIMDVfloat>(i);
+
+			x = x * (SIMDVfloat(1.5f) - xh * (x * x));
+			x = x * (SIMDVfloat(1.5f) - xh * (x * x));
+			return x;
+		}
+
+		// the full-register part of [0, n)
+		inline size_t SIMDEnd(size_t n) { return (n - (n % SIMD_SIZE)); }
+	}
+
+
+	/// o = m * float4(v, w); w is 1 for points and 0 for directions
+	inline void Transform(
+		const CMatrix44f& m,
+		const float* xs, const float* ys, const float* zs,
+		float* oxs, float* oys, float* ozs,
+		size_t n,
+		float w = 1.0f
+	) {
+		const SIMDVfloat c0[3] = {SIMDVfloat(m.md[0][0]), SIMDVfloat(m.md[0][1]), SIMDVfloat(m.md[0][2])};
+		const SIMDVfloat c1[3] = {SIMDVfloat(m.md[1][0]), SIMDVfloat(m.md[1][1]), SIMDVfloat(m.md[1][2])};
+		const SIMDVfloat c2[3] = {SIMDVfloat(m.md[2][0]), SIMDVfloat(m.md[2][1]), SIMDVfloat(m.md[2][2])};
+		const SIMDVfloat c3[3] = {SIMDVfloat(m.md[3][0]), SIMDVfloat(m.md[3][1]), SIMDVfloat(m.md[3][2])};
+		const SIMDVfloat vw(w);
+
+		float* outs[3] = {oxs, oys, ozs};
+
+		const size_t end = detail::SIMDEnd(n);
+
+		for (size_t i = 0; i < end; i += SIMD_SIZE) {
+			const SIMDVfloat vx = xsimd::load_unaligned(xs + i);
+			const SIMDVfloat vy = xsimd::load_unaligned(ys + i);
+			const SIMDVfloat vz = xsimd::load_unaligned(zs + i);
+
+			// same order as CMatrix44f::operator*(float4)
+			for (int c = 0; c < 3; c++) {
+				SIMDVfloat out = c0[c] * vx;
+				out = out + c1[c] * vy;
+				out = out + c2[c] * vz;
+				out = out + c3[c] * vw;
+				xsimd::store_unaligned(outs[c] + i, out);
+			}
+		}
+
+		for (size_t i = end; i < n; i++) {
+			const float4 out = m * float4(xs[i], ys[i], zs[i], w);
+
+			oxs[i] = out.x;
+			oys[i] = out.y;
+			ozs[i] = out.z;
+		}
+	}
+
+	/// o = a.dot(b)
+	inline void Dot(
+		const float* axs, const float* ays, const float* azs,
+		const float* bxs, const float* bys, const float* bzs,
+		float* os,
+		size_t n
+	) {
+		const size_t end = detail::SIMDEnd(n);
+
+		for (size_t i = 0; i < end; i += SIMD_SIZE) {
+			SIMDVfloat dot = xsimd::load_unaligned(axs + i) * xsimd::load_unaligned(bxs + i);
+			dot = dot + xsimd::load_unaligned(ays + i) * xsimd::load_unaligned(bys + i);
+			dot = dot + xsimd::load_unaligned(azs + i) * xsimd::load_unaligned(bzs + i);
+			xsimd::store_unaligned(os + i, dot);
+		}
+
+		for (size_t i = end; i < n; i++) {
+			os[i] = float3(axs[i], ays[i], azs[i]).dot(float3(bxs[i], bys[i], bzs[i]));
+		}
+	}
+
+	/// o = a.cross(b)
+	inline void Cross(
+		const float* axs, const float* ays, const float* azs,
+		const float* bxs, const float* bys, const float* bzs,
+		float* oxs, float* oys, float* ozs,
+		size_t n
+	) {
+		const size_t end = detail::SIMDEnd(n);
+
+		for (size_t i = 0; i < end; i += SIMD_SIZE) {
+			const SIMDVfloat ax = xsimd::load_unaligned(axs + i);
+			const SIMDVfloat ay = xsimd::load_unaligned(ays + i);
+			const SIMDVfloat az = xsimd::load_unaligned(azs + i);
+			const SIMDVfloat bx = xsimd::load_unaligned(bxs + i);
+			const SIMDVfloat by = xsimd::load_unaligned(bys + i);
+			const SIMDVfloat bz = xsimd::load_unaligned(bzs + i);
+
+			xsimd::store_unaligned(oxs + i, (ay * bz) - (az * by));
+			xsimd::store_unaligned(oys + i, (az * bx) - (ax * bz));
+			xsimd::store_unaligned(ozs + i, (ax * by) - (ay * bx));
+		}
+
+		for (size_t i = end; i < n; i++) {
+			const float3 out = float3(axs[i], ays[i], azs[i]).cross(float3(bxs[i], bys[i], bzs[i]));
+
+			oxs[i] = out.x;
+			oys[i] = out.y;
+			ozs[i] = out.z;
+		}
+	}
+
+	/// v.SafeNormalize() in place
+	inline void SafeNormalize(float* xs, float* ys, float* zs, size_t n) {
+		const SIMDVfloat eps(float3::nrm_eps());
+		const size_t end = detail::SIMDEnd(n);
+
+		for (size_t i = 0; i < end; i += SIMD_SIZE) {
+			const SIMDVfloat vx = xsimd::load_unaligned(xs + i);
+			const SIMDVfloat vy = xsimd::load_unaligned(ys + i);
+			const SIMDVfloat vz = xsimd::load_unaligned(zs + i);
+
+			// same order as float3::SqLength
+			const SIMDVfloat sql = vx * vx + vy * vy + vz * vz;
+			const SIMDVfloat isl = detail::isqrt(sql);
+			const auto valid = (sql > eps);
+
+			xsimd::store_unaligned(xs + i, xsimd::select(valid, vx * isl, vx));
+			xsimd::store_unaligned(ys + i, xsimd::select(valid, vy * isl, vy));
+			xsimd::store_unaligned(zs + i, xsimd::select(valid, vz * isl, vz));
+		}
+
+		for (size_t i = end; i < n; i++) {
+			float3 v(xs[i], ys[i], zs[i]);
+			v.SafeNormalize();
+
+			xs[i] = v.x;
+			ys[i] = v.y;
+			zs[i] = v.z;
+		}
+	}
+}
+
+#endif // BATCH_MATH_H
@@ -48,6 +48,29 @@ enum DbgTimingInfoType {
 };
 
 
+/**
+ * One UnitDamaged event as buffered by CEventHandler for UnitDamagedBatch;
+ * stores ids rather than pointers since either unit can die before a batch
+ * is delivered (attacker{ID,DefID,Team} are -1 if there was no attacker).
+ */
+struct UnitDamagedEvent {
+	int unitID;
+	int unitDefID;
+	int unitTeam;
+	int unitAllyTeam;
+
+	int attackerID;
+	int attackerDefID;
+	int attackerTeam;
+
+	int weaponDefID;
+	int projectileID;
+
+	float damage;
+	bool paralyzer;
+};
+
+
 class CEventClient
 {
 	public:
@@ -140,6 +163,7 @@ class CEventClient
 			int weaponDefID,
 			int projectileID,
 			bool paralyzer) {}
+		virtual void UnitDamagedBatch(const std::vector<UnitDamagedEvent>& events) {}
 		virtual void UnitStunned(const CUnit* unit, bool stunned) {}
 		virtual void UnitExperience(const CUnit* unit, float oldExperience) {}
 		virtual void UnitHarvestStorageFull(const CUnit* unit) {}
@@ -4,7 +4,9 @@
 
 #include "Lua/LuaCallInCheck.h"
 #include "Lua/LuaOpenGL.h"  // FIXME -- should be moved
+#include "Rendering/GPUProfiler.h"
 
+#include "Sim/Units/UnitDef.h"
 #include "System/Config/ConfigHandler.h"
 #include "System/Platform/Threading.h"
 #include "System/GlobalConfig.h"
@@ -33,6 +35,9 @@ void CEventHandler::ResetState()
 {
 	mouseOwner = nullptr;
 
+	unitDamagedEvents[0].clear();
+	unitDamagedEvents[1].clear();
+
 	eventMap.clear();
 	eventMap.reserve(64);
 	handles.clear();
@@ -501,6 +506,7 @@ void CEventHandler::GamePaused(int playerID, bool paused)
 
 void CEventHandler::GameFrame(int gameFrame)
 {
+	UnitDamagedBatch();
 	ITERATE_EVENTCLIENTLIST(GameFrame, gameFrame);
 }
 
@@ -515,6 +521,46 @@ void CEventHandler::GameID(const unsigned char* gameID, unsigned int numBytes)
 }
 
 
+void CEventHandler::QueueUnitDamagedEvent(
+	const CUnit* unit,
+	const CUnit* attacker,
+	float damage,
+	int weaponDefID,
+	int projectileID,
+	bool paralyzer)
+{
+	unitDamagedEvents[0].push_back({
+		unit->id,
+		unit->unitDef->id,
+		unit->team,
+		unit->allyteam,
+
+		(attacker != nullptr)? attacker->id: -1,
+		(attacker != nullptr)? attacker->unitDef->id: -1,
+		(attacker != nullptr)? attacker->team: -1,
+
+		weaponDefID,
+		projectileID,
+
+		damage,
+		paralyzer
+	});
+}
+
+void CEventHandler::UnitDamagedBatch()
+{
+	auto& events = unitDamagedEvents[1];
+
+	// events raised by the call-ins themselves go into the next batch
+	std::swap(unitDamagedEvents[0], events);
+
+	if (!events.empty())
+		ITERATE_EVENTCLIENTLIST(UnitDamagedBatch, events);
+
+	events.clear();
+}
+
+
 void CEventHandler::TeamDied(int teamID)
 {
 	ITERATE_EVENTCLIENTLIST(TeamDied, teamID);
@@ -600,6 +646,7 @@ void CEventHandler::ViewResize()
 		if (listDraw ## name.empty())                                       \
 			return;                                                         \
                                                                             \
+		SCOPED_GPU_TIMER("Lua::Draw" #name);                                \
 		LuaOpenGL::EnableDraw ## name ();                                   \
 		listDraw ## name [0]->Draw ## name ();                              \
                                                                             \
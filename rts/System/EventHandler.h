@@ -90,6 +90,8 @@ class CEventHandler
 			int weaponDefID,
 			int projectileID,
 			bool paralyzer);
+		/// delivers all UnitDamaged events buffered since the last call
+		void UnitDamagedBatch();
 		void UnitStunned(const CUnit* unit, bool stunned);
 		void UnitExperience(const CUnit* unit, float oldExperience);
 		void UnitHarvestStorageFull(const CUnit* unit);
@@ -339,9 +341,21 @@ class CEventHandler
 		void ListInsert(EventClientList& ciList, CEventClient* ec);
 		void ListRemove(EventClientList& ciList, CEventClient* ec);
 
+		void QueueUnitDamagedEvent(
+			const CUnit* unit,
+			const CUnit* attacker,
+			float damage,
+			int weaponDefID,
+			int projectileID,
+			bool paralyzer);
+
 	private:
 		CEventClient* mouseOwner;
 
+		// only filled while clients are subscribed to UnitDamagedBatch;
+		// double-buffered so events raised during delivery are kept
+		std::vector<UnitDamagedEvent> unitDamagedEvents[2];
+
 	private:
 		EventMap eventMap;
 
@@ -530,6 +544,11 @@ inline void CEventHandler::UnitDamaged(
 	bool paralyzer)
 {
 	ITERATE_UNIT_ALLYTEAM_EVENTCLIENTLIST(UnitDamaged, unit, attacker, damage, weaponDefID, projectileID, paralyzer)
+
+	if (listUnitDamagedBatch.empty())
+		return;
+
+	QueueUnitDamagedEvent(unit, attacker, damage, weaponDefID, projectileID, paralyzer);
 }
 
 inline void CEventHandler::UnitStunned(
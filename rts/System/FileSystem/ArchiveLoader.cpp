@@ -7,6 +7,7 @@
 #include "Archives/IArchiveFactory.h"
 #include "Archives/IArchive.h"
 #include "Archives/PoolArchive.h"
+#include "Archives/ChunkPoolArchive.h"
 #include "Archives/DirArchive.h"
 #include "Archives/ZipArchive.h"
 #include "Archives/SevenZipArchive.h"
@@ -21,6 +22,7 @@ static CDirArchiveFactory sddArchiveFactory;
 static CZipArchiveFactory sdzArchiveFactory;
 static CSevenZipArchiveFactory sd7ArchiveFactory;
 static CVirtualArchiveFactory sdvArchiveFactory;
+static CChunkPoolArchiveFactory sdcArchiveFactory;
 
 CArchiveLoader::CArchiveLoader()
 {
@@ -32,6 +34,7 @@ CArchiveLoader::CArchiveLoader()
 	AddFactory(ARCHIVE_TYPE_SDZ, sdzArchiveFactory);
 	AddFactory(ARCHIVE_TYPE_SD7, sd7ArchiveFactory);
 	AddFactory(ARCHIVE_TYPE_SDV, sdvArchiveFactory);
+	AddFactory(ARCHIVE_TYPE_SDC, sdcArchiveFactory);
 
 	using P = decltype(archiveFactories)::value_type;
 	std::sort(archiveFactories.begin(), archiveFactories.end(), [](const P& a, const P& b) { return (a.first < b.first); });
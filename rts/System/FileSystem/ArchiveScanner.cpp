@@ -27,6 +27,7 @@
 #include "System/Log/ILog.h"
 #include "System/Threading/SpringThreading.h"
 #include "System/UnorderedMap.hpp"
+#include "System/UnorderedSet.hpp"
 
 #if !defined(DEDICATED) && !defined(UNITSYNC)
 	#include "System/TimeProfiler.h"
@@ -389,12 +390,15 @@ CArchiveScanner::CArchiveScanner()
 	Clear();
 	// the "cache" dir is created in DataDirLocater
 	ReadCacheData(cachefile = FileSystem::EnsurePathSepAtEnd(FileSystem::GetCacheDir()) + IntToString(INTERNAL_VER, "ArchiveCache%i.lua"));
+	fileHashCache.Read(FileSystem::EnsurePathSepAtEnd(FileSystem::GetCacheDir()) + "FileHashCache.bin");
 	ScanAllDirs();
 }
 
 
 CArchiveScanner::~CArchiveScanner()
 {
+	fileHashCache.Write();
+
 	if (!isDirty)
 		return;
 
@@ -498,12 +502,54 @@ void CArchiveScanner::ScanDirs(const std::vector<std::string>& scanDirs)
 		}
 	}*/
 
-	// Create archiveInfos etc. if not in cache already
+	std::vector<std::string> scanArchives;
+	std::vector<std::string> dupeArchives;
+	std::vector<uint32_t> scanModTimes;
+	std::vector<ScanResult> scanResults;
+
+	spring::unordered_set<std::string> scanNames;
+
+	// filter out the archives whose cached info is still valid
 	for (const std::string& archive: foundArchives) {
+		unsigned modifiedTime = 0;
+
+		if (CheckCachedData(archive, modifiedTime, false))
+			continue;
+
+		// archives sharing a name are handled serially afterwards, so
+		// that duplicates are detected in the same way and order as a
+		// regular ScanArchive would
+		if (!scanNames.insert(StringToLower(FileSystem::GetFilename(archive))).second) {
+			dupeArchives.push_back(archive);
+			continue;
+		}
+
+		scanArchives.push_back(archive);
+		scanModTimes.push_back(modifiedTime);
+	}
+
+	scanResults.resize(scanArchives.size());
+
+	// create archiveInfos etc. for the remainder, in parallel
+	{
+		isInScan = true;
+
+		for_mt(0, scanArchives.size(), [&](const int i) {
+			ScanArchiveData(scanArchives[i], scanModTimes[i], false, scanResults[i]);
+		#if !defined(DEDICATED) && !defined(UNITSYNC)
+			Watchdog::ClearTimer(WDT_MAIN);
+		#endif
+		});
+
+		for (size_t i = 0; i < scanArchives.size(); i++) {
+			AddScanResult(scanArchives[i], scanResults[i]);
+		}
+
+		isInScan = false;
+	}
+
+	for (const std::string& archive: dupeArchives) {
 		ScanArchive(archive, false);
-	#if !defined(DEDICATED) && !defined(UNITSYNC)
-		Watchdog::ClearTimer(WDT_MAIN);
-	#endif
 	}
 
 	// Now we'll have to parse the replaces-stuff found in the mods
@@ -659,6 +705,27 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 
 	const ScanScope scanScope(&isInScan);
 
+	ScanResult result;
+	ScanArchiveData(fullName, modifiedTime, doChecksum, result);
+	AddScanResult(fullName, result);
+}
+
+void CArchiveScanner::AddScanResult(const std::string& fullName, ScanResult& result)
+{
+	const std::string& lcfn = StringToLower(FileSystem::GetFilename(fullName));
+
+	if (result.isBroken) {
+		GetAddBrokenArchive(lcfn) = std::move(result.brokenArchive);
+	} else {
+		archiveInfosIndex.insert(lcfn, archiveInfos.size());
+		archiveInfos.emplace_back(std::move(result.archiveInfo));
+	}
+
+	numScannedArchives += result.isScanned;
+}
+
+void CArchiveScanner::ScanArchiveData(const std::string& fullName, uint32_t modifiedTime, bool doChecksum, ScanResult& result)
+{
 	const std::string& fname = FileSystem::GetFilename(fullName);
 	const std::string& fpath = FileSystem::GetDirectory(fullName);
 	const std::string& lcfn  = StringToLower(fname);
@@ -669,7 +736,7 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 		LOG_L(L_WARNING, "[AS::%s] unable to open archive \"%s\"", __func__, fullName.c_str());
 
 		// record it as broken, so we don't need to look inside everytime
-		BrokenArchive& ba = GetAddBrokenArchive(lcfn);
+		BrokenArchive& ba = result.brokenArchive;
 		ba.name = lcfn;
 		ba.path = fpath;
 		ba.modified = modifiedTime;
@@ -677,7 +744,7 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 		ba.problem = "Unable to open archive";
 
 		// does not count as a scan
-		// numScannedArchives += 1;
+		result.isBroken = true;
 		return;
 	}
 
@@ -690,7 +757,7 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 	const bool hasMapInfo = ar->FileExists("mapinfo.lua");
 
 
-	ArchiveInfo ai;
+	ArchiveInfo& ai = result.archiveInfo;
 	ArchiveData& ad = ai.archiveData;
 
 	// execute the respective .lua, otherwise assume this archive is a map
@@ -713,7 +780,7 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 		LOG_L(L_WARNING, "[AS::%s] failed to scan \"%s\" (%s)", __func__, fullName.c_str(), error.c_str());
 
 		// mark archive as broken, so we don't need to look inside everytime
-		BrokenArchive& ba = GetAddBrokenArchive(lcfn);
+		BrokenArchive& ba = result.brokenArchive;
 		ba.name = lcfn;
 		ba.path = fpath;
 		ba.modified = modifiedTime;
@@ -721,7 +788,8 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 		ba.problem = error;
 
 		// does count as a scan
-		numScannedArchives += 1;
+		result.isBroken = true;
+		result.isScanned = true;
 		return;
 	}
 
@@ -763,12 +831,9 @@ void CArchiveScanner::ScanArchive(const std::string& fullName, bool doChecksum)
 
 	ai.origName = fname;
 	ai.updated = true;
-	ai.hashed = doChecksum && GetArchiveChecksum(fullName, ai);
+	ai.hashed = doChecksum && GetArchiveChecksum(fullName, ai.checksum);
 
-	archiveInfosIndex.insert(lcfn, archiveInfos.size());
-	archiveInfos.emplace_back(std::move(ai));
-
-	numScannedArchives += 1;
+	result.isScanned = true;
 }
 
 
@@ -827,7 +892,7 @@ bool CArchiveScanner::CheckCachedData(const std::string& fullName, unsigned& mod
 		ai.updated = true;
 
 		if (doChecksum && !ai.hashed)
-			isDirty |= (ai.hashed = GetArchiveChecksum(fullName, ai));
+			isDirty |= (ai.hashed = GetArchiveChecksum(fullName, ai.checksum));
 
 		return true;
 	}
@@ -869,7 +934,7 @@ bool CArchiveScanner::ScanArchiveLua(IArchive* ar, const std::string& fileName,
 	if (!ar->GetFile(fileName, buf) || buf.empty()) {
 		err = "Error reading " + fileName;
 
-		if (ar->GetArchiveFile().find(".sdp") != std::string::npos)
+		if (ar->GetArchiveFile().find(".sdp") != std::string::npos || ar->GetArchiveFile().find(".sdc") != std::string::npos)
 			err += " (archive's rapid tag: " + GetRapidTagFromPackage(FileSystem::GetBasename(ar->GetArchiveFile())) + ")";
 
 		return false;
@@ -916,7 +981,7 @@ IFileFilter* CArchiveScanner::CreateIgnoreFilter(IArchive* ar)
  * Get checksum of the data in the specified archive.
  * Returns 0 if file could not be opened.
  */
-bool CArchiveScanner::GetArchiveChecksum(const std::string& archiveName, ArchiveInfo& archiveInfo)
+bool CArchiveScanner::GetArchiveChecksum(const std::string& archiveName, uint8_t checksum[sha512::SHA_LEN])
 {
 	// try to open an archive
 	std::unique_ptr<IArchive> ar(archiveLoader.OpenArchive(archiveName));
@@ -947,9 +1012,23 @@ bool CArchiveScanner::GetArchiveChecksum(const std::string& archiveName, Archive
 	// sort by filename
 	std::stable_sort(fileNames.begin(), fileNames.end());
 
-	// compute hashes of the files
+	// compute hashes of the files, reusing those of unchanged pool files
 	for_mt(0, fileNames.size(), [&](const int i) {
-		ar->CalcHash(ar->FindFile(fileNames[i]), fileHashes[i].data(), fileBuffers[ ThreadPool::GetThreadNum() ]);
+		const unsigned int fid = ar->FindFile(fileNames[i]);
+		const std::string& fileSource = ar->GetFileSource(fid);
+
+		uint64_t fileSize = 0;
+		uint32_t fileTime = 0;
+
+		if (!fileSource.empty()) {
+			fileSize = FileSystemAbstraction::GetFileSize(fileSource);
+			fileTime = FileSystemAbstraction::GetFileModificationTime(fileSource);
+		}
+
+		if (fileSource.empty() || !fileHashCache.GetHash(fileSource, fileSize, fileTime, fileHashes[i])) {
+			if (ar->CalcHash(fid, fileHashes[i].data(), fileBuffers[ ThreadPool::GetThreadNum() ]) && !fileSource.empty())
+				fileHashCache.SetHash(fileSource, fileSize, fileTime, fileHashes[i]);
+		}
 
 		#if !defined(DEDICATED) && !defined(UNITSYNC)
 		Watchdog::ClearTimer(WDT_MAIN);
@@ -958,14 +1037,14 @@ bool CArchiveScanner::GetArchiveChecksum(const std::string& archiveName, Archive
 
 	// combine individual hashes, initialize to hash(name)
 	for (size_t i = 0; i < fileNames.size(); i++) {
-		sha512::calc_digest(reinterpret_cast<const uint8_t*>(fileNames[i].c_str()), fileNames[i].size(), archiveInfo.checksum);
+		sha512::calc_digest(reinterpret_cast<const uint8_t*>(fileNames[i].c_str()), fileNames[i].size(), checksum);
 
 		for (uint8_t j = 0; j < sha512::SHA_LEN; j++) {
-			archiveInfo.checksum[j] ^= fileHashes[i][j];
+			checksum[j] ^= fileHashes[i][j];
 		}
 
 		#if !defined(DEDICATED) && !defined(UNITSYNC)
-		Watchdog::ClearTimer();
+		Watchdog::ClearTimer(WDT_MAIN);
 		#endif
 	}
 
@@ -1074,6 +1153,9 @@ void FilterDep(std::vector<std::string>& deps, const std::string& exclude)
 void CArchiveScanner::WriteCacheData(const std::string& filename)
 {
 	std::lock_guard<decltype(scannerMutex)> lck(scannerMutex);
+
+	fileHashCache.Write();
+
 	if (!isDirty)
 		return;
 
@@ -1416,15 +1498,85 @@ sha512::raw_digest CArchiveScanner::GetArchiveSingleChecksumBytes(const std::str
 	return checksum;
 }
 
+void CArchiveScanner::HashArchives(const std::vector<std::string>& archivePaths)
+{
+	std::unique_lock<decltype(scannerMutex)> lck(scannerMutex);
+
+	std::vector<std::string> hashPaths;
+	std::vector<std::string> hashNames;
+
+	for (const std::string& archivePath: archivePaths) {
+		// brings the ArchiveInfo up to date but leaves hashing to us
+		ScanArchive(archivePath, false);
+
+		const std::string& lcName = StringToLower(FileSystem::GetFilename(archivePath));
+		const auto aiIter = archiveInfosIndex.find(lcName);
+
+		if (aiIter == archiveInfosIndex.end())
+			continue;
+
+		const ArchiveInfo& ai = archiveInfos[aiIter->second];
+
+		if (ai.hashed || !ai.replaced.empty())
+			continue;
+
+		hashPaths.push_back(archivePath);
+		hashNames.push_back(lcName);
+	}
+
+	if (hashPaths.empty())
+		return;
+
+	std::vector<sha512::raw_digest> checksums(hashPaths.size());
+	std::vector<uint8_t> hashed(hashPaths.size(), false);
+
+	// hashing only reads the archives, so other threads (e.g. unitsync's
+	// batch workers) may use the scanner meanwhile and hash concurrently
+	lck.unlock();
+
+	for_mt(0, hashPaths.size(), [&](const int i) {
+		hashed[i] = GetArchiveChecksum(hashPaths[i], checksums[i].data());
+	});
+
+	lck.lock();
+
+	// indices can shift while unlocked, only resolve them now
+	for (size_t i = 0; i < hashNames.size(); i++) {
+		const auto aiIter = archiveInfosIndex.find(hashNames[i]);
+
+		if (aiIter == archiveInfosIndex.end() || !hashed[i])
+			continue;
+
+		ArchiveInfo& ai = archiveInfos[aiIter->second];
+
+		// another caller got here first
+		if (ai.hashed)
+			continue;
+
+		std::memcpy(ai.checksum, checksums[i].data(), sha512::SHA_LEN);
+		ai.hashed = true;
+	}
+
+	isDirty = true;
+}
+
 sha512::raw_digest CArchiveScanner::GetArchiveCompleteChecksumBytes(const std::string& name)
 {
 	sha512::raw_digest checksum;
 	std::fill(checksum.begin(), checksum.end(), 0);
 
+	std::vector<std::string> archivePaths;
+
 	for (const std::string& depName: GetAllArchivesUsedBy(name)) {
 		const std::string& archiveName = ArchiveFromName(depName);
-		const std::string  archivePath = GetArchivePath(archiveName) + archiveName;
 
+		archivePaths.push_back(GetArchivePath(archiveName) + archiveName);
+	}
+
+	// hash the dependencies concurrently rather than one after another
+	HashArchives(archivePaths);
+
+	for (const std::string& archivePath: archivePaths) {
 		const sha512::raw_digest& archiveChecksum = GetArchiveSingleChecksumBytes(archivePath);
 
 		for (uint8_t i = 0; i < sha512::SHA_LEN; i++) {
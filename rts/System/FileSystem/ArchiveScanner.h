@@ -8,6 +8,7 @@
 #include <deque>
 #include <vector>
 
+#include "FileHashCache.h"
 #include "System/Info.h"
 #include "System/Sync/SHA512.hpp"
 #include "System/UnorderedMap.hpp"
@@ -184,6 +185,13 @@ private:
 		uint32_t modified = 0;
 		bool updated = false;
 	};
+	struct ScanResult {
+		ArchiveInfo archiveInfo;
+		BrokenArchive brokenArchive;
+
+		bool isBroken = false;
+		bool isScanned = false; // counts towards numScannedArchives
+	};
 
 private:
 	ArchiveInfo& GetAddArchiveInfo(const std::string& lcfn);
@@ -192,6 +200,18 @@ private:
 	void ScanDirs(const std::vector<std::string>& dirs);
 	void ScanDir(const std::string& curPath, std::deque<std::string>& foundArchives);
 
+	/**
+	 * Reads the meta-data of an archive that is not (validly) cached; only
+	 * touches the scanner's state through GetArchiveChecksum so it can run
+	 * for several archives in parallel, AddScanResult commits the result.
+	 */
+	void ScanArchiveData(const std::string& fullName, uint32_t modifiedTime, bool doChecksum, ScanResult& result);
+	void AddScanResult(const std::string& fullName, ScanResult& result);
+
+	/// hashes all archives in the list that are not yet hashed, in parallel
+	/// and without holding the scanner lock (concurrent callers may overlap)
+	void HashArchives(const std::vector<std::string>& archivePaths);
+
 	/// scan mapinfo / modinfo lua files
 	bool ScanArchiveLua(IArchive* ar, const std::string& fileName, ArchiveInfo& ai, std::string& err);
 
@@ -211,7 +231,7 @@ private:
 	 * Get hash of the data in the specified archive.
 	 * Returns false if file could not be opened.
 	 */
-	bool GetArchiveChecksum(const std::string& filename, ArchiveInfo& archiveInfo);
+	bool GetArchiveChecksum(const std::string& filename, uint8_t checksum[sha512::SHA_LEN]);
 
 	bool CheckCachedData(const std::string& fullName, unsigned& modified, bool doChecksum);
 
@@ -243,6 +263,8 @@ private:
 	std::vector<ArchiveInfo> archiveInfos;
 	std::vector<BrokenArchive> brokenArchives;
 
+	CFileHashCache fileHashCache;
+
 	std::string cachefile;
 
 	bool isDirty = false;
@@ -41,6 +41,57 @@ bool CBufferedArchive::GetFile(unsigned int fid, std::vector<std::uint8_t>& buff
 		return (ret == 1);
 	}
 
+	const FileBuffer& fb = GetCachedFile(fid, ret);
+
+	if (!fb.exists) {
+		LOG_L(L_WARNING, "[BufferedArchive::%s(fid=%u)][!fb.exists] name=%s ret=%d size=" _STPF_, __func__, fid, archiveFile.c_str(), ret, fb.data.size());
+		return false;
+	}
+
+	buffer.assign(fb.data.begin(), fb.data.end());
+	return true;
+}
+
+bool CBufferedArchive::GetFileView(unsigned int fid, CFileView& view)
+{
+	std::lock_guard<spring::mutex> lck(archiveLock);
+	assert(IsFileId(fid));
+
+	int ret = 0;
+
+	if (noCache || !globalConfig.vfsCacheArchiveFiles) {
+		if ((ret = GetFileViewImpl(fid, view)) != 1)
+			LOG_L(L_WARNING, "[BufferedArchive::%s(fid=%u)][noCache] name=%s ret=%d size=" _STPF_, __func__, fid, archiveFile.c_str(), ret, view.size());
+
+		return (ret == 1);
+	}
+
+	const FileBuffer& fb = GetCachedFile(fid, ret);
+
+	if (!fb.exists) {
+		LOG_L(L_WARNING, "[BufferedArchive::%s(fid=%u)][!fb.exists] name=%s ret=%d size=" _STPF_, __func__, fid, archiveFile.c_str(), ret, fb.data.size());
+		return false;
+	}
+
+	view = fb.data;
+	return true;
+}
+
+
+int CBufferedArchive::GetFileViewImpl(unsigned int fid, CFileView& view)
+{
+	std::vector<std::uint8_t> buffer;
+
+	const int ret = GetFileImpl(fid, buffer);
+
+	if (ret == 1)
+		view = CFileView(std::move(buffer));
+
+	return ret;
+}
+
+const CBufferedArchive::FileBuffer& CBufferedArchive::GetCachedFile(unsigned int fid, int& ret)
+{
 	// NumFiles is virtual, can't do this in ctor
 	if (fileCache.empty())
 		fileCache.resize(NumFiles());
@@ -48,22 +99,12 @@ bool CBufferedArchive::GetFile(unsigned int fid, std::vector<std::uint8_t>& buff
 	FileBuffer& fb = fileCache.at(fid);
 
 	if (!fb.populated) {
-		fb.exists = ((ret = GetFileImpl(fid, fb.data)) == 1);
+		fb.exists = ((ret = GetFileViewImpl(fid, fb.data)) == 1);
 		fb.populated = true;
 
 		cacheSize += fb.data.size();
 		fileCount += fb.exists;
 	}
 
-	if (!fb.exists) {
-		LOG_L(L_WARNING, "[BufferedArchive::%s(fid=%u)][!fb.exists] name=%s ret=%d size=" _STPF_, __func__, fid, archiveFile.c_str(), ret, fb.data.size());
-		return false;
-	}
-
-	if (buffer.size() != fb.data.size())
-		buffer.resize(fb.data.size());
-
-	// TODO: zero-copy access
-	std::copy(fb.data.begin(), fb.data.end(), buffer.begin());
-	return true;
+	return fb;
 }
@@ -22,9 +22,12 @@ public:
 	virtual int GetType() const override { return ARCHIVE_TYPE_BUF; }
 
 	bool GetFile(unsigned int fid, std::vector<std::uint8_t>& buffer) override;
+	bool GetFileView(unsigned int fid, CFileView& view) override;
 
 protected:
 	virtual int GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffer) = 0;
+	// defaults to wrapping the buffer filled by GetFileImpl
+	virtual int GetFileViewImpl(unsigned int fid, CFileView& view);
 
 	struct FileBuffer {
 		FileBuffer() = default;
@@ -37,9 +40,12 @@ protected:
 		bool populated = false; // files may be empty (0 bytes)
 		bool exists = false;
 
-		std::vector<std::uint8_t> data;
+		// shared with GetFileView callers
+		CFileView data;
 	};
 
+	const FileBuffer& GetCachedFile(unsigned int fid, int& ret);
+
 	// indexed by file-id
 	std::vector<FileBuffer> fileCache;
 	// neither 7zip (.sd7) nor minizip (.sdz) are thread-safe
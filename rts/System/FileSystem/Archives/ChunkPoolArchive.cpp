@@ -0,0 +1,385 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+
+#include "ChunkPoolArchive.h"
+#include "PoolBlobCache.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#include <zlib.h>
+
+#include "System/FileSystem/FileSystem.h"
+#include "System/Exceptions.h"
+#include "System/StringUtil.h"
+#include "System/Log/ILog.h"
+
+
+CChunkPoolArchiveFactory::CChunkPoolArchiveFactory(): IArchiveFactory("sdc")
+{
+}
+
+IArchive* CChunkPoolArchiveFactory::DoCreateArchive(const std::string& filePath) const
+{
+	return new CChunkPoolArchive(filePath);
+}
+
+
+
+static constexpr uint8_t INDEX_MAGIC[4] = {'s', 'd', 'c', CChunkPoolArchive::FORMAT_VERSION};
+
+// normalized chunking: boundaries are harder to hit below the average size
+// and easier above it, which narrows the chunk size distribution
+static constexpr uint64_t CHUNK_MASK_S = ~uint64_t(0) << (64 - 18);
+static constexpr uint64_t CHUNK_MASK_L = ~uint64_t(0) << (64 - 14);
+
+struct GearTable {
+	GearTable() {
+		// splitmix64 with a fixed seed, must never change
+		uint64_t x = 0x537072696e674344ull;
+
+		for (uint64_t& g: table) {
+			uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			g = z ^ (z >> 31);
+		}
+	}
+
+	std::array<uint64_t, 256> table;
+};
+
+static const GearTable gearTable;
+
+
+static uint32_t parse_uint32(const uint8_t c[4])
+{
+	return ((uint32_t(c[0]) << 24) | (c[1] << 16) | (c[2] << 8) | (c[3] << 0));
+}
+
+static void write_uint32(uint8_t c[4], uint32_t i)
+{
+	c[0] = (i >> 24) & 0xff;
+	c[1] = (i >> 16) & 0xff;
+	c[2] = (i >>  8) & 0xff;
+	c[3] = (i >>  0) & 0xff;
+}
+
+static bool gz_really_read(gzFile file, voidp buf, unsigned int len)
+{
+	return (gzread(file, reinterpret_cast<char*>(buf), len) == len);
+}
+
+static bool gz_really_write(gzFile file, const void* buf, unsigned int len)
+{
+	return (len == 0 || gzwrite(file, buf, len) == len);
+}
+
+static std::string GetChunkPath(const std::string& poolRootDir, const CChunkPoolArchive::ChunkDigest& digest)
+{
+	constexpr const char table[] = "0123456789abcdef";
+	char c_hex[32];
+
+	for (int i = 0; i < 16; ++i) {
+		c_hex[2 * i    ] = table[(digest[i] >> 4) & 0xf];
+		c_hex[2 * i + 1] = table[ digest[i]       & 0xf];
+	}
+
+	const std::string prefix(c_hex,      2);
+	const std::string pstfix(c_hex + 2, 30);
+
+	std::string rpath = poolRootDir + "/pool/" + prefix + "/" + pstfix + ".gz";
+	return (FileSystem::FixSlashes(rpath));
+}
+
+static CPoolBlobCache::MD5 GetBlobKey(const sha512::raw_digest& shasum)
+{
+	CPoolBlobCache::MD5 key;
+	std::copy_n(shasum.begin(), key.size(), key.begin());
+	return key;
+}
+
+
+
+CChunkPoolArchive::CChunkPoolArchive(const std::string& name): CBufferedArchive(name)
+{
+	gzFile in = gzopen(name.c_str(), "rb");
+
+	if (in == nullptr)
+		throw content_error("[" + std::string(__func__) + "] could not open " + name);
+
+	uint8_t c_magic[4];
+
+	if (!gz_really_read(in, c_magic, sizeof(c_magic)) || memcmp(c_magic, INDEX_MAGIC, sizeof(c_magic)) != 0) {
+		gzclose(in);
+		throw content_error("[" + std::string(__func__) + "] unknown format of " + name);
+	}
+
+	// get pool dir from .sdc absolute path
+	assert(FileSystem::IsAbsolutePath(name));
+	poolRootDir = FileSystem::GetParent(FileSystem::GetDirectory(name));
+	assert(!poolRootDir.empty());
+
+	files.reserve(1024);
+	chunks.reserve(1024);
+
+	char c_name[255];
+	uint8_t c_digest[sha512::SHA_LEN];
+	uint8_t c_crc32[4];
+	uint8_t c_size[4];
+	uint8_t c_count[4];
+	uint8_t length;
+
+	bool complete = true;
+
+	while (gz_really_read(in, &length, 1)) {
+		complete = false;
+
+		if (!gz_really_read(in, &c_name, length)) break;
+		if (!gz_really_read(in, &c_digest, sha512::SHA_LEN)) break;
+		if (!gz_really_read(in, &c_crc32, 4)) break;
+		if (!gz_really_read(in, &c_size, 4)) break;
+		if (!gz_really_read(in, &c_count, 4)) break;
+
+		FileData f;
+
+		f.name = std::string(c_name, length);
+
+		std::memcpy(f.shasum.data(), c_digest, sha512::SHA_LEN);
+
+		f.crc32 = parse_uint32(c_crc32);
+		f.size = parse_uint32(c_size);
+		f.firstChunk = chunks.size();
+		f.numChunks = parse_uint32(c_count);
+
+		uint64_t chunkedSize = 0;
+		uint32_t numChunks = 0;
+
+		for (; numChunks < f.numChunks; numChunks++) {
+			Chunk c;
+
+			if (!gz_really_read(in, c.digest.data(), c.digest.size())) break;
+			if (!gz_really_read(in, &c_size, 4)) break;
+
+			c.size = parse_uint32(c_size);
+			chunkedSize += c.size;
+			chunks.push_back(c);
+		}
+
+		if (numChunks != f.numChunks || chunkedSize != f.size)
+			break;
+
+		lcNameIndex[StringToLower(f.name)] = files.size();
+		files.push_back(std::move(f));
+
+		complete = true;
+	}
+
+	isOpen = complete && gzeof(in);
+	gzclose(in);
+}
+
+
+int CChunkPoolArchive::GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffer)
+{
+	assert(IsFileId(fid));
+
+	const FileData& f = files[fid];
+
+	CPoolBlobCache& blobCache = CPoolBlobCache::GetInstance();
+
+	const bool useBlobCache = (f.size > 0 && blobCache.IsEnabled());
+
+	if (useBlobCache) {
+		const CFileView blob = blobCache.GetBlob(GetBlobKey(f.shasum), f.size, f.crc32);
+
+		if (blob.IsValid()) {
+			buffer.assign(blob.begin(), blob.end());
+			return 1;
+		}
+	}
+
+	buffer.clear();
+	buffer.resize(f.size);
+
+	size_t offset = 0;
+
+	for (uint32_t n = f.firstChunk; n < (f.firstChunk + f.numChunks); n++) {
+		const Chunk& c = chunks[n];
+		const std::string& path = GetChunkPath(poolRootDir, c.digest);
+
+		gzFile in = gzopen(path.c_str(), "rb");
+
+		const bool chunkRead = (in != nullptr && gz_really_read(in, buffer.data() + offset, c.size));
+
+		if (in != nullptr)
+			gzclose(in);
+
+		if (!chunkRead) {
+			LOG_L(L_ERROR, "[ChunkPoolArchive::%s] could not read chunk \"%s\" of file \"%s\"", __func__, path.c_str(), f.name.c_str());
+			buffer.clear();
+			return 0;
+		}
+
+		offset += c.size;
+	}
+
+	sha512::raw_digest shasum;
+	sha512::calc_digest(buffer.data(), buffer.size(), shasum.data());
+
+	if (shasum != f.shasum) {
+		LOG_L(L_ERROR, "[ChunkPoolArchive::%s] file \"%s\" does not match its digest, pool is corrupt", __func__, f.name.c_str());
+		buffer.clear();
+		return 0;
+	}
+
+	if (useBlobCache)
+		blobCache.AddBlob(GetBlobKey(f.shasum), buffer);
+
+	return 1;
+}
+
+int CChunkPoolArchive::GetFileViewImpl(unsigned int fid, CFileView& view)
+{
+	assert(IsFileId(fid));
+
+	const FileData& f = files[fid];
+
+	CPoolBlobCache& blobCache = CPoolBlobCache::GetInstance();
+
+	// a cached blob can be handed out as-is, without reassembling the chunks
+	if (f.size > 0 && blobCache.IsEnabled()) {
+		if ((view = blobCache.GetBlob(GetBlobKey(f.shasum), f.size, f.crc32)).IsValid())
+			return 1;
+	}
+
+	return (CBufferedArchive::GetFileViewImpl(fid, view));
+}
+
+
+
+void CChunkPoolArchive::SplitChunks(const uint8_t* data, size_t size, std::vector<uint32_t>& chunkSizes)
+{
+	for (size_t pos = 0; pos < size; ) {
+		const size_t maxLen = std::min(size - pos, MAX_CHUNK_SIZE);
+
+		size_t len = std::min(maxLen, MIN_CHUNK_SIZE);
+		uint64_t hash = 0;
+
+		// bytes before MIN_CHUNK_SIZE can not end a chunk and are skipped
+		for (; len < maxLen; ) {
+			hash = (hash << 1) + gearTable.table[ data[pos + len++] ];
+
+			if ((hash & ((len < AVG_CHUNK_SIZE)? CHUNK_MASK_S: CHUNK_MASK_L)) == 0)
+				break;
+		}
+
+		chunkSizes.push_back(len);
+		pos += len;
+	}
+}
+
+bool CChunkPoolArchive::WritePackage(const std::string& packagePath, const std::vector< std::pair<std::string, std::vector<std::uint8_t>> >& files)
+{
+	const std::string poolRootDir = FileSystem::GetParent(FileSystem::GetDirectory(packagePath));
+	const std::string tempPath = packagePath + ".tmp";
+
+	const auto WriteChunk = [&](const ChunkDigest& digest, const uint8_t* data, uint32_t size) {
+		const std::string& path = GetChunkPath(poolRootDir, digest);
+
+		// content-addressed, an existing chunk can only be identical
+		if (FileSystem::FileExists(path))
+			return true;
+		if (!FileSystem::CreateDirectory(FileSystem::GetDirectory(path)))
+			return false;
+
+		gzFile out = gzopen((path + ".tmp").c_str(), "wb");
+
+		if (out == nullptr)
+			return false;
+
+		bool ret = gz_really_write(out, data, size);
+
+		ret &= (gzclose(out) == Z_OK);
+		ret &= (std::rename((path + ".tmp").c_str(), path.c_str()) == 0);
+
+		if (!ret)
+			std::remove((path + ".tmp").c_str());
+
+		return ret;
+	};
+
+	gzFile out = gzopen(tempPath.c_str(), "wb");
+
+	if (out == nullptr)
+		return false;
+
+	bool ret = gz_really_write(out, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+
+	std::vector<uint32_t> chunkSizes;
+
+	for (const auto& file: files) {
+		const std::string& name = file.first;
+		const std::vector<std::uint8_t>& data = file.second;
+
+		if (name.size() > 255 || data.size() > uint32_t(-1)) {
+			LOG_L(L_ERROR, "[ChunkPoolArchive::%s] can not store file \"%s\"", __func__, name.c_str());
+			ret = false;
+			break;
+		}
+
+		chunkSizes.clear();
+		SplitChunks(data.data(), data.size(), chunkSizes);
+
+		uint8_t c_digest[sha512::SHA_LEN];
+		uint8_t c_crc32[4];
+		uint8_t c_size[4];
+		uint8_t c_count[4];
+		uint8_t length = name.size();
+
+		sha512::calc_digest(data.data(), data.size(), c_digest);
+		write_uint32(c_crc32, crc32(crc32(0L, Z_NULL, 0), data.data(), data.size()));
+		write_uint32(c_size, data.size());
+		write_uint32(c_count, chunkSizes.size());
+
+		ret &= gz_really_write(out, &length, 1);
+		ret &= gz_really_write(out, name.data(), length);
+		ret &= gz_really_write(out, c_digest, sizeof(c_digest));
+		ret &= gz_really_write(out, c_crc32, 4);
+		ret &= gz_really_write(out, c_size, 4);
+		ret &= gz_really_write(out, c_count, 4);
+
+		for (size_t n = 0, offset = 0; n < chunkSizes.size(); offset += chunkSizes[n++]) {
+			ChunkDigest digest;
+
+			sha512::calc_digest(data.data() + offset, chunkSizes[n], c_digest);
+			std::copy_n(c_digest, digest.size(), digest.begin());
+			write_uint32(c_size, chunkSizes[n]);
+
+			ret &= WriteChunk(digest, data.data() + offset, chunkSizes[n]);
+			ret &= gz_really_write(out, digest.data(), digest.size());
+			ret &= gz_really_write(out, c_size, 4);
+		}
+
+		if (!ret)
+			break;
+	}
+
+	ret &= (gzclose(out) == Z_OK);
+
+	if (ret) {
+		#ifdef _WIN32
+		std::remove(packagePath.c_str());
+		#endif
+		ret = (std::rename(tempPath.c_str(), packagePath.c_str()) == 0);
+	}
+
+	if (!ret) {
+		LOG_L(L_ERROR, "[ChunkPoolArchive::%s] could not write \"%s\"", __func__, packagePath.c_str());
+		std::remove(tempPath.c_str());
+	}
+
+	return ret;
+}
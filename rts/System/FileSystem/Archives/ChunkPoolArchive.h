@@ -0,0 +1,124 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _CHUNK_POOL_ARCHIVE_H
+#define _CHUNK_POOL_ARCHIVE_H
+
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include "IArchiveFactory.h"
+#include "BufferedArchive.h"
+
+
+/**
+ * Creates chunked pool archives.
+ * @see CChunkPoolArchive
+ */
+class CChunkPoolArchiveFactory : public IArchiveFactory {
+public:
+	CChunkPoolArchiveFactory();
+private:
+	IArchive* DoCreateArchive(const std::string& filePath) const;
+};
+
+
+/**
+ * Variant of the pool archive format (see CPoolArchive) which deduplicates
+ * parts of files rather than whole files, so that changing a few bytes of a
+ * large file (e.g. one tile of a texture pack) only adds a few new chunks to
+ * the pool instead of another copy of the entire file.
+ *
+ * Technical details
+ * -----------------
+ * Files are split with content-defined chunking: a gear rolling-hash over
+ * the content decides where chunks end (see SplitChunks), so boundaries move
+ * along with inserted or removed data and all chunks outside the changed
+ * region keep their identity. Chunks are stored in the same directory layout
+ * as pool files, as gzip-compressed blobs named after the first 16 bytes of
+ * their SHA-512 digest:
+ *   /pool/\<first 2 hex chars\>/\<next 30 hex chars\>.gz
+ *
+ * An .sdc file under packages represents one archive and, like an .sdp, is
+ * a gzip-compressed index. It starts with the 4 bytes "sdc" FORMAT_VERSION,
+ * followed by one entry per indexed file until EOF:
+ *   \<1 byte file name length\>\<file name\>\<64 byte SHA-512 digest\>
+ *   \<4 byte CRC32\>\<4 byte file size\>\<4 byte chunk count\>
+ *   (\<16 byte chunk digest\>\<4 byte chunk size\>) * chunk count
+ * All integers are big-endian. The SHA-512 is that of the entire file, which
+ * makes computing the archive checksum free; it is verified on every read.
+ */
+class CChunkPoolArchive : public CBufferedArchive
+{
+public:
+	static constexpr uint8_t FORMAT_VERSION = 1;
+
+	static constexpr size_t MIN_CHUNK_SIZE =  16 * 1024;
+	static constexpr size_t AVG_CHUNK_SIZE =  64 * 1024;
+	static constexpr size_t MAX_CHUNK_SIZE = 256 * 1024;
+
+	typedef std::array<uint8_t, 16> ChunkDigest;
+
+public:
+	CChunkPoolArchive(const std::string& name);
+
+	int GetType() const override { return ARCHIVE_TYPE_SDC; }
+
+	bool IsOpen() override { return isOpen; }
+
+	unsigned NumFiles() const override { return (files.size()); }
+	void FileInfo(unsigned int fid, std::string& name, int& size) const override {
+		assert(IsFileId(fid));
+		name = files[fid].name;
+		size = files[fid].size;
+	}
+	bool CalcHash(uint32_t fid, uint8_t hash[sha512::SHA_LEN], std::vector<std::uint8_t>& fb) override {
+		assert(IsFileId(fid));
+		memcpy(hash, files[fid].shasum.data(), sha512::SHA_LEN);
+		return true;
+	}
+
+	/**
+	 * Appends the sizes of the content-defined chunks of <data> to <chunkSizes>.
+	 * Boundaries only depend on the content, the gear-table and the constants
+	 * above; changing any of them breaks deduplication with existing pools.
+	 */
+	static void SplitChunks(const uint8_t* data, size_t size, std::vector<uint32_t>& chunkSizes);
+
+	/**
+	 * Writes the index <packagePath> (under packages/) for <files> and adds
+	 * all of their chunks which are not yet present to the adjacent pool.
+	 * @return false if any part could not be written
+	 */
+	static bool WritePackage(const std::string& packagePath, const std::vector< std::pair<std::string, std::vector<std::uint8_t>> >& files);
+
+protected:
+	int GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffer) override;
+	int GetFileViewImpl(unsigned int fid, CFileView& view) override;
+
+	struct FileData {
+		std::string name;
+		sha512::raw_digest shasum;
+
+		uint32_t crc32;
+		uint32_t size;
+
+		// range in chunks
+		uint32_t firstChunk;
+		uint32_t numChunks;
+	};
+	struct Chunk {
+		ChunkDigest digest;
+		uint32_t size;
+	};
+
+private:
+	bool isOpen = false;
+
+	std::string poolRootDir;
+
+	std::vector<FileData> files;
+	std::vector<Chunk> chunks;
+};
+
+#endif // _CHUNK_POOL_ARCHIVE_H
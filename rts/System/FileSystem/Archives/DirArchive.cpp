@@ -63,6 +63,17 @@ bool CDirArchive::GetFile(unsigned int fid, std::vector<std::uint8_t>& buffer)
 	return true;
 }
 
+bool CDirArchive::GetFileView(unsigned int fid, CFileView& view)
+{
+	assert(IsFileId(fid));
+
+	if ((view = CFileView::MapFile(dataDirsAccess.LocateFile(dirName + searchFiles[fid]))).IsValid())
+		return true;
+
+	// not mappable (e.g. out of address space), read it instead
+	return (IArchive::GetFileView(fid, view));
+}
+
 void CDirArchive::FileInfo(unsigned int fid, std::string& name, int& size) const
 {
 	assert(IsFileId(fid));
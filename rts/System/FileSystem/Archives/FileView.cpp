@@ -0,0 +1,108 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "FileView.h"
+
+#include <cassert>
+
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#else
+	#include <windows.h>
+#endif
+
+
+CFileView::CFileView(std::vector<std::uint8_t>&& buffer)
+{
+	const auto vec = std::make_shared<const std::vector<std::uint8_t>>(std::move(buffer));
+
+	ptr = vec->data();
+	len = vec->size();
+
+	memory = vec;
+}
+
+CFileView::CFileView(const CFileView& view, size_t offset, size_t size)
+	: memory(view.memory)
+	, ptr(view.ptr + offset)
+	, len(size)
+{
+	assert((offset + size) <= view.size());
+}
+
+
+CFileView CFileView::MapFile(const std::string& filePath)
+{
+	CFileView view;
+
+	#ifndef _WIN32
+	const int fd = open(filePath.c_str(), O_RDONLY);
+
+	if (fd < 0)
+		return view;
+
+	struct stat info;
+
+	if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+		close(fd);
+		return view;
+	}
+
+	const size_t size = info.st_size;
+
+	// zero-length mappings are not allowed
+	if (size == 0) {
+		close(fd);
+		return CFileView(std::vector<std::uint8_t>());
+	}
+
+	void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// the mapping keeps its own reference to the file
+	close(fd);
+
+	if (addr == MAP_FAILED)
+		return view;
+
+	view.memory = std::shared_ptr<const void>(addr, [size](const void* p) { munmap(const_cast<void*>(p), size); });
+	#else
+	const HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return view;
+
+	LARGE_INTEGER fileSize;
+
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return view;
+	}
+
+	const size_t size = fileSize.QuadPart;
+
+	if (size == 0) {
+		CloseHandle(file);
+		return CFileView(std::vector<std::uint8_t>());
+	}
+
+	const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	const void* addr = (mapping != nullptr)? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0): nullptr;
+
+	// the view keeps its own references to both
+	if (mapping != nullptr)
+		CloseHandle(mapping);
+
+	CloseHandle(file);
+
+	if (addr == nullptr)
+		return view;
+
+	view.memory = std::shared_ptr<const void>(addr, [](const void* p) { UnmapViewOfFile(p); });
+	#endif
+
+	view.ptr = static_cast<const std::uint8_t*>(view.memory.get());
+	view.len = size;
+	return view;
+}
@@ -0,0 +1,51 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _FILE_VIEW_H
+#define _FILE_VIEW_H
+
+#include <cinttypes>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Read-only view of the contents of a file
+ *
+ * The viewed memory is either a (read-only) mapping of the file or a buffer
+ * owned by the view, and remains valid for as long as any copy of the view
+ * (or of a sub-view) exists; copies are cheap and share the same memory.
+ */
+class CFileView
+{
+public:
+	CFileView() = default;
+	CFileView(std::vector<std::uint8_t>&& buffer);
+	// sub-range [offset, offset + size) of <view>, sharing its memory
+	CFileView(const CFileView& view, size_t offset, size_t size);
+
+	/**
+	 * Maps <filePath> into memory.
+	 * @return an empty view if the file could not be mapped
+	 */
+	static CFileView MapFile(const std::string& filePath);
+
+	const std::uint8_t* data() const { return ptr; }
+	const std::uint8_t* begin() const { return ptr; }
+	const std::uint8_t* end() const { return (ptr + len); }
+
+	size_t size() const { return len; }
+	bool empty() const { return (len == 0); }
+
+	/// false if nothing is viewed, files may be empty (0 bytes) but valid
+	bool IsValid() const { return (memory != nullptr); }
+
+	void clear() { *this = {}; }
+
+private:
+	std::shared_ptr<const void> memory;
+
+	const std::uint8_t* ptr = nullptr;
+	size_t len = 0;
+};
+
+#endif // _FILE_VIEW_H
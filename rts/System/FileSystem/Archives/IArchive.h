@@ -8,6 +8,7 @@
 #include <cinttypes>
 
 #include "ArchiveTypes.h"
+#include "FileView.h"
 #include "System/Sync/SHA512.hpp"
 #include "System/UnorderedMap.hpp"
 
@@ -82,6 +83,18 @@ public:
 	 */
 	bool GetFile(const std::string& name, std::vector<std::uint8_t>& buffer);
 
+	/**
+	 * Fetches a read-only view of the content of a file by its ID.
+	 * Unlike GetFile, this does not copy the content when the archive can
+	 * provide it in place (uncompressed files are mapped into memory, and
+	 * buffered archives share their cached copy); the view stays valid
+	 * after the archive is closed.
+	 * @param fid file ID in [0, NumFiles())
+	 * @return true if the file was found and view refers to its contents
+	 */
+	virtual bool GetFileView(unsigned int fid, CFileView& view);
+	bool GetFileView(const std::string& name, CFileView& view);
+
 	std::pair<std::string, int> FileInfo(unsigned int fid) const {
 		std::pair<std::string, int> info;
 		FileInfo(fid, info.first, info.second);
@@ -125,6 +138,13 @@ public:
 	 * Fetches the (SHA512) hash of a file by its ID.
 	 */
 	virtual bool CalcHash(uint32_t fid, uint8_t hash[sha512::SHA_LEN], std::vector<std::uint8_t>& fb);
+	/**
+	 * Returns the path of the file on disk that holds the contents of the
+	 * file with this ID and nothing else (such that its hash only changes
+	 * along with that file), or an empty string for archives storing their
+	 * files differently.
+	 */
+	virtual std::string GetFileSource(unsigned int fid) const { return ""; }
 
 
 protected:
@@ -2,6 +2,7 @@
 
 
 #include "PoolArchive.h"
+#include "PoolBlobCache.h"
 
 #include <algorithm>
 #include <stdexcept>
@@ -123,12 +124,11 @@ CPoolArchive::~CPoolArchive()
 	}
 }
 
-int CPoolArchive::GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffer)
+std::string CPoolArchive::GetFileSource(unsigned int fid) const
 {
 	assert(IsFileId(fid));
 
-	FileData* f = &files[fid];
-	FileStat* s = &stats[fid];
+	const FileData* f = &files[fid];
 
 	constexpr const char table[] = "0123456789abcdef";
 	char c_hex[32];
@@ -141,11 +141,37 @@ int CPoolArchive::GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffe
 	const std::string prefix(c_hex,      2);
 	const std::string pstfix(c_hex + 2, 30);
 
-	      std::string rpath = poolRootDir + "/pool/" + prefix + "/" + pstfix + ".gz";
-	const std::string  path = FileSystem::FixSlashes(rpath);
+	std::string rpath = poolRootDir + "/pool/" + prefix + "/" + pstfix + ".gz";
+	return (FileSystem::FixSlashes(rpath));
+}
+
+int CPoolArchive::GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffer)
+{
+	assert(IsFileId(fid));
+
+	FileData* f = &files[fid];
+	FileStat* s = &stats[fid];
+
+	const std::string path = GetFileSource(fid);
 
 	const spring_time startTime = spring_now();
 
+	CPoolBlobCache& blobCache = CPoolBlobCache::GetInstance();
+
+	const bool useBlobCache = (f->size > 0 && blobCache.IsEnabled());
+
+	if (useBlobCache) {
+		const CFileView blob = blobCache.GetBlob(f->md5sum, f->size, f->crc32);
+
+		if (blob.IsValid()) {
+			buffer.assign(blob.begin(), blob.end());
+
+			s->readTime = (spring_now() - startTime).toNanoSecsi();
+			sha512::calc_digest(buffer.data(), buffer.size(), f->shasum.data());
+			return 1;
+		}
+	}
+
 
 	buffer.clear();
 	buffer.resize(f->size);
@@ -197,6 +223,35 @@ int CPoolArchive::GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffe
 		LOG_L(L_WARNING, "[PoolArchive::%s] could read file \"%s\" only after %d tries", __func__, path.c_str(), readTry);
 	}
 
+	if (useBlobCache)
+		blobCache.AddBlob(f->md5sum, buffer);
+
 	sha512::calc_digest(buffer.data(), buffer.size(), f->shasum.data());
 	return 1;
 }
+
+int CPoolArchive::GetFileViewImpl(unsigned int fid, CFileView& view)
+{
+	assert(IsFileId(fid));
+
+	FileData* f = &files[fid];
+	FileStat* s = &stats[fid];
+
+	CPoolBlobCache& blobCache = CPoolBlobCache::GetInstance();
+
+	// a cached blob can be handed out as-is, without copying
+	if (f->size > 0 && blobCache.IsEnabled()) {
+		const spring_time startTime = spring_now();
+
+		if ((view = blobCache.GetBlob(f->md5sum, f->size, f->crc32)).IsValid()) {
+			s->readTime = (spring_now() - startTime).toNanoSecsi();
+
+			if (memcmp(f->shasum.data(), dummyFileHash.data(), sizeof(f->shasum)) == 0)
+				sha512::calc_digest(view.data(), view.size(), f->shasum.data());
+
+			return 1;
+		}
+	}
+
+	return (CBufferedArchive::GetFileViewImpl(fid, view));
+}
@@ -101,8 +101,12 @@ public:
 		return (memcmp(fd.shasum.data(), dummyFileHash.data(), sizeof(fd.shasum)) != 0);
 	}
 
+	// pool files are content-addressed and can be shared by many archives
+	std::string GetFileSource(unsigned int fid) const override;
+
 protected:
 	int GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffer) override;
+	int GetFileViewImpl(unsigned int fid, CFileView& view) override;
 
 	std::pair<uint64_t, uint64_t> GetSums() const {
 		std::pair<uint64_t, uint64_t> p;
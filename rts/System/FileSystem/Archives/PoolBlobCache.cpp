@@ -0,0 +1,204 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "PoolBlobCache.h"
+
+#include "System/Config/ConfigHandler.h"
+#include "System/FileSystem/DataDirsAccess.h"
+#include "System/FileSystem/FileQueryFlags.h"
+#include "System/FileSystem/FileSystem.h"
+#include "System/Log/ILog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <thread>
+
+#include <zlib.h>
+
+CONFIG(int, PoolArchiveBlobCacheSize).defaultValue(0).minimumValue(0).description("Maximum size in MB of the cache of decompressed pool archive files, 0 disables it.");
+CONFIG(std::string, PoolArchiveBlobCacheDir).defaultValue("").description("Directory of the decompressed pool archive file cache, <CacheDir>/blobs/ if empty. Engine instances using the same directory share their caches.");
+
+
+// blobs can vanish at any time if another process evicts them
+static uint64_t GetBlobSize(const std::string& path)
+{
+	const size_t size = FileSystemAbstraction::GetFileSize(path);
+	return ((size != size_t(-1))? size: 0);
+}
+
+
+CPoolBlobCache& CPoolBlobCache::GetInstance()
+{
+	static CPoolBlobCache cache;
+	return cache;
+}
+
+
+void CPoolBlobCache::Init()
+{
+	initialized = true;
+
+	// not every tool that can open archives has a config
+	if (configHandler == nullptr)
+		return;
+
+	if ((maxSize = configHandler->GetInt("PoolArchiveBlobCacheSize") * uint64_t(1024 * 1024)) == 0)
+		return;
+
+	std::string dir = configHandler->GetString("PoolArchiveBlobCacheDir");
+
+	if (dir.empty()) {
+		dir = dataDirsAccess.LocateDir(FileSystem::GetCacheDir() + "/blobs/", FileQueryFlags::WRITE | FileQueryFlags::CREATE_DIRS);
+	} else if (!FileSystem::CreateDirectory(dir)) {
+		dir.clear();
+	}
+
+	if (dir.empty()) {
+		LOG_L(L_WARNING, "[PoolBlobCache::%s] no writable cache directory, disabled", __func__);
+		maxSize = 0;
+		return;
+	}
+
+	cacheDir = FileSystem::EnsurePathSepAtEnd(dir);
+
+	std::vector<std::string> blobs;
+	FileSystemAbstraction::FindFiles(blobs, cacheDir, "", "[0-9a-f]{32}\\.blob", 0);
+
+	for (const std::string& blob: blobs) {
+		curSize += GetBlobSize(cacheDir + blob);
+	}
+
+	LOG("[PoolBlobCache::%s] using \"%s\" (%u blobs, %" PRIu64 "/%" PRIu64 "MB)", __func__, cacheDir.c_str(), uint32_t(blobs.size()), curSize >> 20, maxSize >> 20);
+}
+
+bool CPoolBlobCache::IsEnabled()
+{
+	std::lock_guard<spring::mutex> lck(mutex);
+
+	if (!initialized)
+		Init();
+
+	return (maxSize != 0);
+}
+
+
+std::string CPoolBlobCache::GetBlobPath(const MD5& md5) const
+{
+	constexpr const char table[] = "0123456789abcdef";
+	char c_hex[32 + 6];
+
+	for (size_t i = 0; i < md5.size(); ++i) {
+		c_hex[2 * i    ] = table[(md5[i] >> 4) & 0xf];
+		c_hex[2 * i + 1] = table[(md5[i]     ) & 0xf];
+	}
+
+	std::copy_n(".blob", 6, c_hex + 32);
+	return (cacheDir + c_hex);
+}
+
+
+CFileView CPoolBlobCache::GetBlob(const MD5& md5, uint32_t size, uint32_t crc32)
+{
+	if (!IsEnabled())
+		return {};
+
+	const std::string blobPath = GetBlobPath(md5);
+
+	CFileView view = CFileView::MapFile(blobPath);
+
+	if (!view.IsValid())
+		return view;
+
+	// blobs are renamed into place when complete, so this should only fail
+	// if one was damaged on disk; it will be replaced by the caller's copy
+	if (view.size() != size || ::crc32(::crc32(0L, Z_NULL, 0), view.data(), view.size()) != crc32) {
+		LOG_L(L_WARNING, "[PoolBlobCache::%s] discarding corrupt blob \"%s\"", __func__, blobPath.c_str());
+
+		view.clear();
+		std::remove(blobPath.c_str());
+		return view;
+	}
+
+	// modification time doubles as last-use time for eviction
+	FileSystemAbstraction::TouchFile(blobPath);
+	return view;
+}
+
+void CPoolBlobCache::AddBlob(const MD5& md5, const std::vector<std::uint8_t>& data)
+{
+	if (!IsEnabled())
+		return;
+
+	const std::string blobPath = GetBlobPath(md5);
+
+	if (FileSystem::FileExists(blobPath))
+		return;
+
+	// unique per thread and process; concurrent writers of one blob race harmlessly
+	char tempName[64];
+	snprintf(tempName, sizeof(tempName), ".%zx-%" PRIx64 ".tmp",
+		std::hash<std::thread::id>()(std::this_thread::get_id()),
+		uint64_t(std::chrono::steady_clock::now().time_since_epoch().count())
+	);
+
+	const std::string tempPath = blobPath + tempName;
+
+	FILE* file = fopen(tempPath.c_str(), "wb");
+
+	if (file == nullptr)
+		return;
+
+	bool ret = (data.empty() || fwrite(data.data(), data.size(), 1, file) == 1);
+
+	ret &= (fclose(file) != EOF);
+	ret &= (std::rename(tempPath.c_str(), blobPath.c_str()) == 0);
+
+	if (!ret) {
+		std::remove(tempPath.c_str());
+		return;
+	}
+
+	std::lock_guard<spring::mutex> lck(mutex);
+
+	if ((curSize += data.size()) > maxSize)
+		Evict();
+}
+
+
+void CPoolBlobCache::Evict()
+{
+	struct Blob {
+		std::string path;
+
+		uint64_t size;
+		uint32_t time;
+	};
+
+	std::vector<std::string> blobPaths;
+	std::vector<Blob> blobs;
+
+	// rescan, the directory is shared with other processes
+	FileSystemAbstraction::FindFiles(blobPaths, cacheDir, "", "[0-9a-f]{32}\\.blob", 0);
+
+	blobs.reserve(blobPaths.size());
+	curSize = 0;
+
+	for (const std::string& blobPath: blobPaths) {
+		const std::string path = cacheDir + blobPath;
+
+		blobs.push_back({path, GetBlobSize(path), FileSystemAbstraction::GetFileModificationTime(path)});
+		curSize += blobs.back().size;
+	}
+
+	std::sort(blobs.begin(), blobs.end(), [](const Blob& a, const Blob& b) { return (a.time < b.time); });
+
+	// leave some headroom so not every new blob triggers a rescan
+	const uint64_t minSize = maxSize - maxSize / 4;
+
+	// blobs which are still mapped can not be removed on Windows, just skip them
+	for (size_t i = 0; i < blobs.size() && curSize > minSize; i++) {
+		if (std::remove(blobs[i].path.c_str()) == 0)
+			curSize -= blobs[i].size;
+	}
+}
@@ -0,0 +1,60 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _POOL_BLOB_CACHE_H
+#define _POOL_BLOB_CACHE_H
+
+#include <array>
+#include <cinttypes>
+#include <string>
+#include <vector>
+
+#include "FileView.h"
+#include "System/Threading/SpringThreading.h"
+
+/**
+ * Optional cache of decompressed pool (rapid) files, shared by all engine
+ * instances that point PoolArchiveBlobCacheDir at the same directory.
+ *
+ * A blob is stored once per pool file under the file's MD5 and mapped (not
+ * copied) by readers, so concurrent processes only pay for the disk-read;
+ * blobs are written through temporary files and renamed into place, which
+ * readers never see half-finished. Every hit refreshes the blob's modified
+ * time, and the least recently used blobs are removed once the directory
+ * grows beyond PoolArchiveBlobCacheSize.
+ */
+class CPoolBlobCache
+{
+public:
+	typedef std::array<std::uint8_t, 16> MD5;
+
+	static CPoolBlobCache& GetInstance();
+
+	bool IsEnabled();
+
+	/**
+	 * @return a view of the cached contents of the pool file with this
+	 *   digest, or an invalid view if the blob is missing or does not
+	 *   match the expected size and CRC32
+	 */
+	CFileView GetBlob(const MD5& md5, uint32_t size, uint32_t crc32);
+	void AddBlob(const MD5& md5, const std::vector<std::uint8_t>& data);
+
+private:
+	void Init();
+	void Evict();
+
+	std::string GetBlobPath(const MD5& md5) const;
+
+private:
+	spring::mutex mutex;
+
+	std::string cacheDir;
+
+	uint64_t maxSize = 0;
+	// only approximate, other processes add blobs too
+	uint64_t curSize = 0;
+
+	bool initialized = false;
+};
+
+#endif // _POOL_BLOB_CACHE_H
@@ -117,3 +117,43 @@ int CZipArchive::GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffer
 	return ret;
 }
 
+int CZipArchive::GetFileViewImpl(unsigned int fid, CFileView& view)
+{
+	if (zip == nullptr)
+		return -4;
+
+	assert(IsFileId(fid));
+
+	unzGoToFilePos(zip, &fileEntries[fid].fp);
+
+	unz_file_info fi;
+	unzGetCurrentFileInfo(zip, &fi, nullptr, 0, nullptr, 0, nullptr, 0);
+
+	// deflated or encrypted entries have to be extracted
+	if (fi.compression_method != 0 || (fi.flag & 1) != 0 || fi.compressed_size != fi.uncompressed_size)
+		return (CBufferedArchive::GetFileViewImpl(fid, view));
+
+	if (unzOpenCurrentFile(zip) != UNZ_OK)
+		return -3;
+
+	const ZPOS64_T offset = unzGetCurrentFileZStreamPos64(zip);
+
+	unzCloseCurrentFile(zip);
+
+	if (!archiveView.IsValid())
+		archiveView = CFileView::MapFile(archiveFile);
+
+	if (!archiveView.IsValid() || (offset + fi.uncompressed_size) > archiveView.size())
+		return (CBufferedArchive::GetFileViewImpl(fid, view));
+
+	view = CFileView(archiveView, offset, fi.uncompressed_size);
+
+	// same integrity check as unzCloseCurrentFile does after extraction
+	if (crc32(0, view.data(), view.size()) != fi.crc) {
+		view.clear();
+		return 0;
+	}
+
+	return 1;
+}
+
@@ -60,7 +60,11 @@ protected:
 
 	std::vector<FileEntry> fileEntries;
 
+	// mapped on demand, stored entries are viewed in place
+	CFileView archiveView;
+
 	int GetFileImpl(unsigned int fid, std::vector<std::uint8_t>& buffer) override;
+	int GetFileViewImpl(unsigned int fid, CFileView& view) override;
 };
 
 #endif // _ZIP_ARCHIVE_H
@@ -92,11 +92,11 @@ bool CFileHandler::TryReadFromVFS(const string& fileName, int section)
 	if (vfsHandler == nullptr)
 		return (loadCode = -2, false);
 
-	if ((loadCode = vfsHandler->LoadFile(StringToLower(fileName), fileBuffer, (CVFSHandler::Section) section)) == 1) {
-		// capacity can exceed size if FH was used to open more than one file
-		// assert(fileBuffer.size() == fileBuffer.capacity());
+	// keeps its capacity, in case the caller reuses the buffer
+	fileBuffer.clear();
 
-		fileSize = fileBuffer.size();
+	if ((loadCode = vfsHandler->LoadFileView(StringToLower(fileName), fileView, (CVFSHandler::Section) section)) == 1) {
+		fileSize = fileView.size();
 		return true;
 	}
 #endif
@@ -122,6 +122,17 @@ void CFileHandler::Open(const string& fileName, const string& modes)
 	}
 }
 
+void CFileHandler::OpenView(const string& fileName, const CFileView& view)
+{
+	Close();
+
+	this->fileName = fileName;
+
+	fileView = view;
+	fileSize = view.size();
+	loadCode = 1;
+}
+
 void CFileHandler::Close()
 {
 	filePos = 0;
@@ -130,6 +141,7 @@ void CFileHandler::Close()
 
 	ifs.close();
 	fileBuffer.clear();
+	fileView.clear();
 }
 
 
@@ -173,15 +185,15 @@ int CFileHandler::Read(void* buf, int length)
 		return ifs.gcount();
 	}
 
-	if (fileBuffer.empty())
+	if (fileView.empty())
 		return 0;
 
 	if ((length + filePos) > fileSize)
 		length = fileSize - filePos;
 
 	if (length > 0) {
-		assert(fileBuffer.size() >= (filePos + length));
-		memcpy(buf, &fileBuffer[filePos], length);
+		assert(fileView.size() >= (filePos + length));
+		memcpy(buf, fileView.data() + filePos, length);
 		filePos += length;
 	}
 
@@ -218,7 +230,7 @@ void CFileHandler::Seek(int length, std::ios_base::seekdir where)
 		ifs.seekg(length, where);
 		return;
 	}
-	if (fileBuffer.empty())
+	if (fileView.empty())
 		return;
 
 	switch (where) {
@@ -234,7 +246,7 @@ bool CFileHandler::Eof() const
 	if (ifs.is_open())
 		return ifs.eof();
 
-	if (!fileBuffer.empty())
+	if (!fileView.empty())
 		return (filePos >= fileSize);
 
 	return true;
@@ -9,6 +9,7 @@
 #include <cinttypes>
 
 #include "VFSModes.h"
+#include "Archives/FileView.h"
 
 /**
  * This is for direct VFS file content access.
@@ -27,6 +28,8 @@ public:
 	virtual ~CFileHandler() { Close(); }
 
 	void Open(const std::string& fileName, const std::string& modes = SPRING_VFS_RAW_FIRST);
+	/// serves <fileName> from contents loaded elsewhere, e.g. from an archive that is not in the VFS
+	void OpenView(const std::string& fileName, const CFileView& view);
 	void Close();
 
 	int Read(void* buf, int length);
@@ -37,7 +40,7 @@ public:
 	// true if any of TryReadFrom{RawFS,PWD,VFS} succeed
 	bool FileExists() const { return (fileSize >= 0); }
 	// true if (and only if) TryReadFromVFS succeeds
-	bool IsBuffered() const { return (!fileBuffer.empty()); }
+	bool IsBuffered() const { return (!fileView.empty()); }
 
 	bool Eof() const;
 	int GetPos();
@@ -49,7 +52,15 @@ public:
 	static std::string GetFileAbsolutePath(const std::string& filePath, const std::string& modes);
 	static std::string GetArchiveContainingFile(const std::string& filePath, const std::string& modes);
 
-	std::vector<std::uint8_t>& GetBuffer() { return fileBuffer; }
+	// VFS contents are only copied out of their view when the buffer is requested
+	std::vector<std::uint8_t>& GetBuffer() {
+		if (fileBuffer.empty())
+			fileBuffer.assign(fileView.begin(), fileView.end());
+
+		return fileBuffer;
+	}
+	// in-place access to VFS contents, empty if !IsBuffered
+	const CFileView& GetView() const { return fileView; }
 
 	static bool InReadDir(const std::string& path);
 	static bool InWriteDir(const std::string& path);
@@ -79,6 +90,8 @@ protected:
 	std::ifstream ifs;
 	std::vector<std::uint8_t> fileBuffer;
 
+	CFileView fileView;
+
 	int filePos = 0;
 	int fileSize = -1;
 	int loadCode = -3; // {-1,0,1} if loaded from VFS
@@ -0,0 +1,219 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "FileHashCache.h"
+
+#include "System/Log/ILog.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+
+static constexpr char CACHE_MAGIC[8] = {'S', 'P', 'R', 'F', 'H', 'C', '0', '1'};
+
+// {uint16 pathLen, char path[pathLen], uint64 size, uint32 modified, uint8 hash[SHA_LEN]}
+static bool ReadRecord(FILE* file, std::string& path, uint64_t& size, uint32_t& modified, sha512::raw_digest& hash)
+{
+	uint16_t pathLen = 0;
+
+	if (fread(&pathLen, sizeof(pathLen), 1, file) != 1 || pathLen == 0)
+		return false;
+
+	path.resize(pathLen);
+
+	bool ret = true;
+	ret = ret && (fread(&path[0], pathLen, 1, file) == 1);
+	ret = ret && (fread(&size, sizeof(size), 1, file) == 1);
+	ret = ret && (fread(&modified, sizeof(modified), 1, file) == 1);
+	ret = ret && (fread(hash.data(), hash.size(), 1, file) == 1);
+	return ret;
+}
+
+static bool WriteRecord(FILE* file, const std::string& path, uint64_t size, uint32_t modified, const sha512::raw_digest& hash)
+{
+	const uint16_t pathLen = path.size();
+
+	bool ret = true;
+	ret = ret && (fwrite(&pathLen, sizeof(pathLen), 1, file) == 1);
+	ret = ret && (fwrite(path.data(), pathLen, 1, file) == 1);
+	ret = ret && (fwrite(&size, sizeof(size), 1, file) == 1);
+	ret = ret && (fwrite(&modified, sizeof(modified), 1, file) == 1);
+	ret = ret && (fwrite(hash.data(), hash.size(), 1, file) == 1);
+	return ret;
+}
+
+
+void CFileHashCache::Read(const std::string& filename)
+{
+	std::lock_guard<spring::mutex> lck(mutex);
+
+	entries.clear();
+	cacheFile = filename;
+
+	numRecords = 0;
+	numPending = 0;
+
+	needCompaction = false;
+
+	FILE* file = fopen(cacheFile.c_str(), "rb");
+
+	if (file == nullptr)
+		return;
+
+	char magic[sizeof(CACHE_MAGIC)];
+
+	if (fread(magic, sizeof(magic), 1, file) != 1 || memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0) {
+		LOG_L(L_WARNING, "[FileHashCache::%s] ignoring \"%s\" (unknown format)", __func__, cacheFile.c_str());
+		fclose(file);
+
+		needCompaction = true;
+		return;
+	}
+
+	std::string path;
+	Entry entry = {0, 0, {}, false};
+
+	while (ReadRecord(file, path, entry.size, entry.modified, entry.hash)) {
+		entries[path] = entry;
+		numRecords += 1;
+	}
+
+	// a partial record at the end (interrupted write) must not stay in front of new ones
+	needCompaction = !feof(file);
+
+	fclose(file);
+}
+
+void CFileHashCache::Write()
+{
+	std::lock_guard<spring::mutex> lck(mutex);
+
+	if (cacheFile.empty())
+		return;
+
+	// rewrite once more than half of the records are superseded
+	if (needCompaction || (numRecords + numPending) > (entries.size() * 2)) {
+		if (Compact())
+			return;
+	}
+
+	if (numPending == 0)
+		return;
+
+	FILE* file = fopen(cacheFile.c_str(), "ab");
+
+	if (file == nullptr) {
+		LOG_L(L_ERROR, "[FileHashCache::%s] failed to open \"%s\"", __func__, cacheFile.c_str());
+		return;
+	}
+
+	bool ret = true;
+
+	// a new (or emptied) file needs its header
+	fseek(file, 0, SEEK_END);
+
+	if (ftell(file) == 0)
+		ret = (fwrite(CACHE_MAGIC, sizeof(CACHE_MAGIC), 1, file) == 1);
+
+	for (auto& pair: entries) {
+		Entry& e = pair.second;
+
+		if (!e.pending)
+			continue;
+
+		if (!(ret = ret && WriteRecord(file, pair.first, e.size, e.modified, e.hash)))
+			break;
+
+		e.pending = false;
+
+		numRecords += 1;
+		numPending -= 1;
+	}
+
+	if (fclose(file) == EOF || !ret) {
+		LOG_L(L_ERROR, "[FileHashCache::%s] failed to write to \"%s\"", __func__, cacheFile.c_str());
+		needCompaction = true;
+	}
+}
+
+bool CFileHashCache::Compact()
+{
+	const std::string tempFile = cacheFile + ".tmp";
+
+	FILE* file = fopen(tempFile.c_str(), "wb");
+
+	if (file == nullptr)
+		return false;
+
+	bool ret = (fwrite(CACHE_MAGIC, sizeof(CACHE_MAGIC), 1, file) == 1);
+
+	for (const auto& pair: entries) {
+		ret = ret && WriteRecord(file, pair.first, pair.second.size, pair.second.modified, pair.second.hash);
+	}
+
+	ret &= (fclose(file) != EOF);
+
+	// rename does not replace existing files everywhere
+	std::remove(cacheFile.c_str());
+
+	if (!ret || std::rename(tempFile.c_str(), cacheFile.c_str()) != 0) {
+		LOG_L(L_ERROR, "[FileHashCache::%s] failed to write to \"%s\"", __func__, cacheFile.c_str());
+		std::remove(tempFile.c_str());
+
+		// start over with an empty file
+		for (auto& pair: entries) {
+			pair.second.pending = true;
+		}
+
+		numRecords = 0;
+		numPending = entries.size();
+		needCompaction = false;
+		return false;
+	}
+
+	for (auto& pair: entries) {
+		pair.second.pending = false;
+	}
+
+	numRecords = entries.size();
+	numPending = 0;
+	needCompaction = false;
+	return true;
+}
+
+
+bool CFileHashCache::GetHash(const std::string& path, uint64_t size, uint32_t modified, sha512::raw_digest& hash)
+{
+	std::lock_guard<spring::mutex> lck(mutex);
+
+	const auto it = entries.find(path);
+
+	if (it == entries.end())
+		return false;
+
+	const Entry& e = it->second;
+
+	if (e.size != size || e.modified != modified)
+		return false;
+
+	hash = e.hash;
+	return true;
+}
+
+void CFileHashCache::SetHash(const std::string& path, uint64_t size, uint32_t modified, const sha512::raw_digest& hash)
+{
+	std::lock_guard<spring::mutex> lck(mutex);
+
+	// paths longer than a record can hold are just not cached
+	if (path.empty() || path.size() > 0xFFFF)
+		return;
+
+	Entry& e = entries[path];
+
+	numPending += (!e.pending);
+
+	e.size = size;
+	e.modified = modified;
+	e.hash = hash;
+	e.pending = true;
+}
@@ -0,0 +1,56 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _FILE_HASH_CACHE_H
+#define _FILE_HASH_CACHE_H
+
+#include <string>
+
+#include "System/Sync/SHA512.hpp"
+#include "System/Threading/SpringThreading.h"
+#include "System/UnorderedMap.hpp"
+
+/**
+ * Remembers the content hashes of files on disk (e.g. the pool files shared
+ * between rapid archive versions) so each is hashed only once; an entry is
+ * valid for as long as the size and modification time of its file match.
+ *
+ * The cache file is append-only: every Write adds the records of new hashes,
+ * later records supersede earlier ones for the same path, and the file is
+ * compacted once most of its records are superseded. Thread-safe.
+ */
+class CFileHashCache
+{
+public:
+	void Read(const std::string& filename);
+	void Write();
+
+	bool GetHash(const std::string& path, uint64_t size, uint32_t modified, sha512::raw_digest& hash);
+	void SetHash(const std::string& path, uint64_t size, uint32_t modified, const sha512::raw_digest& hash);
+
+private:
+	struct Entry {
+		uint64_t size;
+		uint32_t modified;
+
+		sha512::raw_digest hash;
+
+		// not yet written to the cache file
+		bool pending;
+	};
+
+	bool Compact();
+
+private:
+	spring::unordered_map<std::string, Entry> entries;
+	spring::mutex mutex;
+
+	std::string cacheFile;
+
+	// records in the file, including superseded ones
+	size_t numRecords = 0;
+	size_t numPending = 0;
+
+	bool needCompaction = false;
+};
+
+#endif // _FILE_HASH_CACHE_H
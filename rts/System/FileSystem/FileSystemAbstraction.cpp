@@ -24,10 +24,12 @@
 	#include <dirent.h>
 	#include <sstream>
 	#include <unistd.h>
+	#include <utime.h>
 	#include <ctime>
 #else
 	#include <windows.h>
 	#include <io.h>
+	#include <sys/utime.h>
 	#include <direct.h>
 	#include <fstream>
 	// Win-API redefines these, which breaks things
@@ -186,6 +188,15 @@ unsigned int FileSystemAbstraction::GetFileModificationTime(const std::string& f
 	return info.st_mtime;
 }
 
+bool FileSystemAbstraction::TouchFile(const std::string& file)
+{
+#ifndef _WIN32
+	return (utime(file.c_str(), nullptr) == 0);
+#else
+	return (_utime(file.c_str(), nullptr) == 0);
+#endif
+}
+
 std::string FileSystemAbstraction::GetFileModificationDate(const std::string& file)
 {
 	const std::time_t t = GetFileModificationTime(file);
@@ -110,6 +110,8 @@ public:
 	static bool IsReadableFile(const std::string& file);
 
 	static unsigned int GetFileModificationTime(const std::string& file);
+	/// sets the modification time of an existing file to the current time
+	static bool TouchFile(const std::string& file);
 	/**
 	 * Returns the last file modification time formatted in a sort friendly
 	 * way, with second resolution.
@@ -203,6 +203,7 @@ bool CVFSHandler::AddArchive(const std::string& archiveName, bool overwrite)
 	}
 
 	std::stable_sort(files[rawSection].begin(), files[rawSection].end(), [](const FileEntry& a, const FileEntry& b) { return (a.first < b.first); });
+	InvalidateIndex(rawSection);
 	return true;
 }
 
@@ -271,6 +272,7 @@ bool CVFSHandler::RemoveArchive(const std::string& archiveName)
 
 		// wipe entries belonging to the to-be-deleted archive
 		files[section].erase(pos, end);
+		InvalidateIndex(section);
 	}
 
 
@@ -309,6 +311,8 @@ void CVFSHandler::DeleteArchives(Section section)
 
 	archives[section].clear();
 	files[section].clear();
+
+	InvalidateIndex(section);
 }
 
 void CVFSHandler::ReserveArchives()
@@ -327,6 +331,8 @@ void CVFSHandler::ReserveArchives()
 		files[section].reserve(2048);
 	}
 
+	InvalidateIndices();
+
 	// preload universal dependencies
 	AddArchive(CArchiveScanner::GetSpringBaseContentName(), false);
 }
@@ -369,6 +375,8 @@ void CVFSHandler::UnMapArchives(bool reload)
 		files[Section::Map ].clear();
 		files[Section::Menu].clear();
 	}
+
+	InvalidateIndices();
 }
 
 void CVFSHandler::ReMapArchives(bool reload)
@@ -388,6 +396,8 @@ void CVFSHandler::ReMapArchives(bool reload)
 		files[Section::TempMap ].clear();
 		files[Section::TempMenu].clear();
 	}
+
+	InvalidateIndices();
 }
 
 
@@ -399,6 +409,7 @@ void CVFSHandler::SwapArchiveSections(Section src, Section dst)
 
 	std::swap(   files[src],    files[dst]);
 	std::swap(archives[src], archives[dst]);
+	std::swap( indices[src],  indices[dst]);
 }
 
 
@@ -411,31 +422,70 @@ std::string CVFSHandler::GetNormalizedPath(const std::string& rawPath)
 }
 
 
-CVFSHandler::FileData CVFSHandler::GetFileData(const std::string& normalizedFilePath, Section section) const
+const CVFSHandler::SectionIndex& CVFSHandler::GetSectionIndex(Section section) const
 {
 	assert(section < Section::Count);
 	std::lock_guard<decltype(vfsMutex)> lck(vfsMutex);
 
+	SectionIndex& index = indices[section];
+
+	if (index.valid)
+		return index;
+
 	const auto& vect = files[section];
-	const auto  cbeg = vect.cbegin();
-	const auto  cend = vect.cend();
-	const auto  file = FileEntry{normalizedFilePath, FileData{}};
-	const auto  sane = [&]() -> bool {
-		for (size_t i = 1, n = vect.size(); i < n; i++) {
-			if (vect[i - 1].first > vect[i].first)
-				return false;
+
+	index.paths = {};
+	index.dirs = {};
+	index.paths.reserve(vect.size());
+
+	for (uint32_t i = 0, n = vect.size(); i < n; i++) {
+		const std::string& path = vect[i].first;
+
+		// of duplicate entries the first (in sorted order) is found
+		if (index.paths.find(path) == index.paths.end())
+			index.paths[path] = i;
+
+		size_t sepPos = path.find_last_of("/\\");
+
+		index.dirs[(sepPos == std::string::npos)? "": path.substr(0, sepPos + 1)].files.push_back(i);
+
+		// register each directory on the path with its parent
+		while (sepPos != std::string::npos) {
+			const size_t dirEnd = sepPos + 1;
+			const size_t dirBeg = (sepPos == 0)? std::string::npos: path.find_last_of("/\\", sepPos - 1);
+
+			if (dirBeg == std::string::npos) {
+				index.dirs[""].dirs.emplace_back(path.substr(0, dirEnd));
+			} else {
+				index.dirs[path.substr(0, dirBeg + 1)].dirs.emplace_back(path.substr(dirBeg + 1, dirEnd - (dirBeg + 1)));
+			}
+
+			sepPos = dirBeg;
 		}
-		return true;
-	};
+	}
 
-	{
-		assert(sane());
+	for (auto& pair: index.dirs) {
+		std::vector<std::string>& dirs = pair.second.dirs;
+
+		std::sort(dirs.begin(), dirs.end());
+		dirs.erase(std::unique(dirs.begin(), dirs.end()), dirs.end());
+	}
+
+	index.valid = true;
+	return index;
+}
+
+CVFSHandler::FileData CVFSHandler::GetFileData(const std::string& normalizedFilePath, Section section) const
+{
+	assert(section < Section::Count);
+	std::lock_guard<decltype(vfsMutex)> lck(vfsMutex);
 
-		const auto pred = [ ](const FileEntry& a, const FileEntry& b) { return (a.first < b.first); };
-		const auto iter = std::lower_bound(cbeg, cend, file, pred);
+	const SectionIndex& index = GetSectionIndex(section);
+	const auto iter = index.paths.find(normalizedFilePath);
 
-		if (iter != cend && iter->first == normalizedFilePath)
-			return {iter->second.ar, iter->second.size};
+	if (iter != index.paths.end()) {
+		const FileEntry& entry = files[section][iter->second];
+		return {entry.second.ar, entry.second.size};
 	}
 
 	// file does not exist in the VFS
@@ -458,6 +508,20 @@ int CVFSHandler::LoadFile(const std::string& filePath, std::vector<std::uint8_t>
 	return (fileData.ar->GetFile(normalizedPath, buffer));
 }
 
+int CVFSHandler::LoadFileView(const std::string& filePath, CFileView& view, Section section)
+{
+	LOG_L(L_DEBUG, "[%s::%s<this=%p>(filePath=\"%s\", section=%d)]", vfsName, __func__, this, filePath.c_str(), section);
+
+	const std::string& normalizedPath = GetNormalizedPath(filePath);
+	const FileData& fileData = GetFileData(normalizedPath, section);
+
+	if (fileData.ar == nullptr)
+		return -1;
+
+	// 0 or 1
+	return (fileData.ar->GetFileView(normalizedPath, view));
+}
+
 int CVFSHandler::FileExists(const std::string& filePath, Section section)
 {
 	LOG_L(L_DEBUG, "[%s::%s<this=%p>(filePath=\"%s\", section=%d)]", vfsName, __func__, this, filePath.c_str(), section);
@@ -532,40 +596,21 @@ std::vector<std::string> CVFSHandler::GetFilesInDir(const std::string& rawDir, S
 	std::vector<std::string> dirFiles;
 	std::string dir = std::move(GetNormalizedPath(rawDir));
 
-
-	const auto filesPred = [](const FileEntry& a, const FileEntry& b) { return (a.first < b.first); };
-
-	auto& filesVec = files[section];
-	auto  filesBeg = filesVec.begin();
-	auto  filesEnd = filesVec.end();
-
 	// non-empty directories to look in should have a trailing backslash
-	if (!dir.empty()) {
-		if (dir.back() != '/')
-			dir += "/";
-
-		// limit the iterator range; turn '/' into '0' for filesEnd
-		filesBeg = std::lower_bound(filesVec.begin(), filesVec.end(), FileEntry{dir, FileData{}}, filesPred); dir.back() += 1;
-		filesEnd = std::upper_bound(filesVec.begin(), filesVec.end(), FileEntry{dir, FileData{}}, filesPred); dir.back() -= 1;
-	}
-
-	dirFiles.reserve(std::distance(filesBeg, filesEnd));
+	if (!dir.empty() && dir.back() != '/')
+		dir += "/";
 
-	for (; filesBeg != filesEnd; ++filesBeg) {
-		const std::string& path = FileSystem::GetDirectory(filesBeg->first);
-
-		// Check if this file starts with the dir path
-		if (path.compare(0, dir.length(), dir) != 0)
-			continue;
+	const SectionIndex& index = GetSectionIndex(section);
+	const auto iter = index.dirs.find(dir);
 
-		// strip pathname
-		std::string name = std::move(filesBeg->first.substr(dir.length()));
+	if (iter == index.dirs.end())
+		return dirFiles;
 
-		// do not return files in subfolders
-		if ((name.find('/') != std::string::npos) || (name.find('\\') != std::string::npos))
-			continue;
+	dirFiles.reserve(iter->second.files.size());
 
-		dirFiles.emplace_back(std::move(name));
+	// strip pathname
+	for (const uint32_t fileID: iter->second.files) {
+		dirFiles.emplace_back(files[section][fileID].first.substr(dir.length()));
 		LOG_L(L_DEBUG, "\t%s", dirFiles[dirFiles.size() - 1].c_str());
 	}
 
@@ -581,52 +626,17 @@ std::vector<std::string> CVFSHandler::GetDirsInDir(const std::string& rawDir, Se
 
 	LOG_L(L_DEBUG, "[%s::%s<this=%p>(rawDir=\"%s\")] section=%d", vfsName, __func__, this, rawDir.c_str(), section);
 
-	std::vector<std::string> dirs;
-	std::vector<std::string>::iterator iter;
 	std::string dir = std::move(GetNormalizedPath(rawDir));
 
-
-	const auto filesPred = [](const FileEntry& a, const FileEntry& b) { return (a.first < b.first); };
-
-	auto& filesVec = files[section];
-	auto  filesBeg = filesVec.begin();
-	auto  filesEnd = filesVec.end();
-
 	// non-empty directories to look in should have a trailing backslash
-	if (!dir.empty()) {
-		if (dir.back() != '/')
-			dir += "/";
-
-		// limit the iterator range (as in GetFilesInDir)
-		filesBeg = std::lower_bound(filesVec.begin(), filesVec.end(), FileEntry{dir, FileData{}}, filesPred); dir.back() += 1;
-		filesEnd = std::upper_bound(filesVec.begin(), filesVec.end(), FileEntry{dir, FileData{}}, filesPred); dir.back() -= 1;
-	}
-
-	dirs.reserve(std::distance(filesBeg, filesEnd));
-
-	for (; filesBeg != filesEnd; ++filesBeg) {
-		const std::string& path = FileSystem::GetDirectory(filesBeg->first);
+	if (!dir.empty() && dir.back() != '/')
+		dir += "/";
 
-		// test if this file starts with the dir path
-		if (path.compare(0, dir.length(), dir) != 0)
-			continue;
-
-		// strip pathname
-		const std::string& name = filesBeg->first.substr(dir.length());
-		const std::string::size_type slash = name.find_first_of("/\\");
-
-		if (slash == std::string::npos)
-			continue;
+	const SectionIndex& index = GetSectionIndex(section);
+	const auto iter = index.dirs.find(dir);
 
-		dirs.emplace_back(std::move(name.substr(0, slash + 1)));
-	}
-
-	std::stable_sort(dirs.begin(), dirs.end());
+	if (iter == index.dirs.end())
+		return {};
 
-	// filter duplicates
-	if ((iter = std::unique(dirs.begin(), dirs.end())) != dirs.end())
-		dirs.erase(iter, dirs.end());
-
-	return dirs;
+	return (iter->second.dirs);
 }
-
@@ -11,6 +11,7 @@
 #include "System/UnorderedMap.hpp"
 
 class IArchive;
+class CFileView;
 
 /**
  * Main API for accessing the Virtual File System (VFS).
@@ -103,6 +104,11 @@ public:
 	 * @return 1 if the file exists in the VFS and was successfully read
 	 */
 	int LoadFile(const std::string& filePath, std::vector<std::uint8_t>& buffer, Section section);
+	/**
+	 * Same as LoadFile, but avoids copying the contents where possible.
+	 * @see IArchive::GetFileView
+	 */
+	int LoadFileView(const std::string& filePath, CFileView& view, Section section);
 
 
 	/**
@@ -165,13 +171,40 @@ private:
 	};
 	typedef std::pair<std::string, FileData> FileEntry;
 
+	/**
+	 * Lookup structures over files[section], rebuilt on first use after any
+	 * archive was added to or removed from the section. Entries refer to
+	 * files by their index (ID) in the sorted vector.
+	 */
+	struct DirEntry {
+		std::vector<uint32_t> files; // direct children
+		std::vector<std::string> dirs; // direct sub-directories incl. separator, sorted and unique
+	};
+	struct SectionIndex {
+		spring::unsynced_map<std::string, uint32_t> paths;
+		spring::unsynced_map<std::string, DirEntry> dirs;
+
+		bool valid = false;
+	};
+
 	std::string GetNormalizedPath(const std::string& rawPath);
 	FileData GetFileData(const std::string& normalizedFilePath, Section section) const;
 
+	const SectionIndex& GetSectionIndex(Section section) const;
+
+	void InvalidateIndex(Section section) { indices[section].valid = false; }
+	void InvalidateIndices() {
+		for (SectionIndex& index: indices) {
+			index.valid = false;
+		}
+	}
+
 private:
 	std::array<std::vector<FileEntry>, Section::Count> files;
 	std::array<spring::unordered_map<std::string, IArchive*>, Section::Count> archives;
 
+	mutable std::array<SectionIndex, Section::Count> indices;
+
 	const char* vfsName = "";
 
 	bool insertAllowed = true;
@@ -367,6 +367,9 @@ void CCregLoadSaveHandler::LoadGame()
 		// the only job of gsc is to collect gamestate data
 		CGameStateCollector* gsc = static_cast<CGameStateCollector*>(pGSC);
 		spring::SafeDelete(gsc);
+
+		// the change-log is not saved, nothing before now is known
+		LuaRulesParams::unitParamChanges.Clear(gs->frameNum);
 	}
 
 	LEAVE_SYNCED_CODE();
@@ -186,7 +186,11 @@ void CDemoReader::LoadStats()
 
 		assert(fileHeader.numTeams <= numStatsPerTeam.size());
 		numStatsPerTeam.fill(0);
-		playbackDemo->Read(reinterpret_cast<char*>(numStatsPerTeam.data()), fileHeader.numTeams);
+		playbackDemo->Read(reinterpret_cast<char*>(numStatsPerTeam.data()), fileHeader.numTeams * sizeof(int));
+
+		for (int teamNum = 0; teamNum < fileHeader.numTeams; ++teamNum) {
+			swabDWordInPlace(numStatsPerTeam[teamNum]);
+		}
 
 		for (int teamNum = 0; teamNum < fileHeader.numTeams; ++teamNum) {
 			for (int i = 0; i < numStatsPerTeam[teamNum]; ++i) {
@@ -2,20 +2,26 @@
 
 #include <cassert>
 #include <cerrno>
+#include <cstdio>
 #include <cstring>
+#include <deque>
 #include <memory>
 
+#include <zlib.h>
+
 #include "DemoRecorder.h"
 #include "Game/GameVersion.h"
 #include "Sim/Misc/TeamStatistics.h"
 #include "System/TimeUtil.h"
 #include "System/StringUtil.h"
+#include "System/Config/ConfigHandler.h"
 #include "System/FileSystem/DataDirsAccess.h"
 #include "System/FileSystem/FileSystem.h"
 #include "System/FileSystem/FileQueryFlags.h"
 #include "System/FileSystem/FileHandler.h"
 #include "System/Log/ILog.h"
-#include "System/Threading/ThreadPool.h"
+#include "System/Platform/Threading.h"
+#include "System/Threading/SpringThreading.h"
 
 #ifdef CreateDirectory
 #undef CreateDirectory
@@ -25,43 +31,373 @@
 #undef GetCurrentTime
 #endif
 
+CONFIG(float, DemoLiveFlushInterval).defaultValue(0.0f).minimumValue(0.0f).description("If greater than 0, recorded demo data is compressed and flushed to disk at least every this many seconds of game time (instead of once per MB), and each flush point is appended to a <demo>.idx file, so a running demo can be streamed and joined at any such point by external tools.");
+
+
+/**
+ * @brief Compresses demo data into a gzip file on a dedicated thread
+ *
+ * The file is one gzip member whose deflate stream starts with a stored block
+ * holding the DemoFileHeader, so the header can be updated in place while the
+ * rest of the demo is still being written. Data is handed to the thread in
+ * blocks of roughly BLOCK_SIZE bytes; the deflate stream is fully flushed after
+ * each of them, and blocks starting at a chunk boundary are listed in the
+ * stream index appended on Close.
+ *
+ * With a live flush interval blocks are also sealed once they span that much
+ * game time, and the index entries are mirrored to a sidecar file as soon as
+ * their block is on disk; both files then always hold a decodable prefix.
+ */
+class CDemoStreamWriter
+{
+public:
+	static constexpr size_t BLOCK_SIZE = 1024 * 1024;
+	static constexpr size_t GZIP_HEADER_SIZE = 10;
+	static constexpr size_t STORED_BLOCK_HEADER_SIZE = 5;
+	static constexpr size_t DEMO_HEADER_OFFSET = GZIP_HEADER_SIZE + STORED_BLOCK_HEADER_SIZE;
+
+	/// <header> must already be in little endian
+	CDemoStreamWriter(const std::string& fileName, const DemoFileHeader& header);
+	~CDemoStreamWriter();
+
+	bool IsOpen() const { return (file != nullptr); }
+
+	void Append(const void* data, size_t size);
+	/// call before appending a DemoStreamChunkHeader
+	void BeginChunk(float modGameTime);
+
+	void WriteHeader(const DemoFileHeader& header);
+	/// flushes everything, writes the index and final <header>, then waits for the thread
+	void Close(const DemoFileHeader& header);
+
+private:
+	enum {
+		JOB_BLOCK  = 0,
+		JOB_HEADER = 1,
+		JOB_CLOSE  = 2,
+	};
 
-// server and client memory-streams
-static std::string demoStreams[2];
-static spring::mutex demoMutex;
+	struct Job {
+		int type;
+		bool restartPoint;
 
+		DemoStreamIndexEntry indexEntry;
+		std::vector<std::uint8_t> data;
+	};
 
-CDemoRecorder::CDemoRecorder(const std::string& mapName, const std::string& modName, bool serverDemo): isServerDemo(serverDemo)
+	void SealBlock();
+	void PushJob(Job&& job);
+
+	void ThreadFunc();
+	void Deflate(const std::uint8_t* data, size_t size, int flush);
+	void FileWrite(const void* data, size_t size);
+	void FileWriteHeader(const std::vector<std::uint8_t>& header);
+	void FileClose(const std::vector<std::uint8_t>& header);
+
+private:
+	// owned by the caller thread
+	std::vector<std::uint8_t> block;
+	DemoStreamIndexEntry blockIndexEntry;
+
+	float liveFlushInterval = 0.0f;
+
+	std::uint32_t streamSize = sizeof(DemoFileHeader);
+	bool blockRestartPoint = false;
+
+	spring::thread thread;
+	spring::mutex jobMutex;
+	spring::condition_variable jobCond;
+	std::deque<Job> jobs;
+
+	// owned by the writer thread
+	FILE* file = nullptr;
+	FILE* indexFile = nullptr;
+	z_stream zstream;
+
+	std::vector<std::uint8_t> zbuffer;
+	std::vector<DemoStreamIndexEntry> index;
+
+	std::uint64_t fileSize = 0;
+	std::uint64_t dataSize = 0;
+	std::uint32_t dataCRC = 0;
+};
+
+
+CDemoStreamWriter::CDemoStreamWriter(const std::string& fileName, const DemoFileHeader& header)
+{
+	if ((file = fopen(fileName.c_str(), "wb")) == nullptr) {
+		LOG_L(L_ERROR, "[DemoStreamWriter::%s] could not open \"%s\" (%s)", __func__, fileName.c_str(), strerror(errno));
+		return;
+	}
+
+	memset(&zstream, 0, sizeof(zstream));
+	memset(&blockIndexEntry, 0, sizeof(blockIndexEntry));
+
+	// raw deflate, the gzip wrapper is written by hand around it
+	if (deflateInit2(&zstream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 9, Z_DEFAULT_STRATEGY) != Z_OK) {
+		LOG_L(L_ERROR, "[DemoStreamWriter::%s] could not initialize zlib (%s)", __func__, zstream.msg);
+		fclose(file);
+		file = nullptr;
+		return;
+	}
+
+	constexpr std::uint16_t headerSize = sizeof(DemoFileHeader);
+
+	// magic, deflate, no flags, no mtime, no extra flags, unknown OS
+	const std::uint8_t gzipHeader[GZIP_HEADER_SIZE] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 255};
+	// no BFINAL, BTYPE=00 (stored), LEN and NLEN in little endian
+	const std::uint8_t storedHeader[STORED_BLOCK_HEADER_SIZE] = {
+		0,
+		std::uint8_t(headerSize & 0xff), std::uint8_t(headerSize >> 8),
+		std::uint8_t(~headerSize & 0xff), std::uint8_t((~headerSize >> 8) & 0xff),
+	};
+
+	FileWrite(gzipHeader, sizeof(gzipHeader));
+	FileWrite(storedHeader, sizeof(storedHeader));
+	FileWrite(&header, sizeof(header));
+
+	if ((liveFlushInterval = configHandler->GetFloat("DemoLiveFlushInterval")) > 0.0f) {
+		if ((indexFile = fopen((fileName + ".idx").c_str(), "wb")) == nullptr)
+			LOG_L(L_WARNING, "[DemoStreamWriter::%s] could not open live index for \"%s\" (%s)", __func__, fileName.c_str(), strerror(errno));
+	}
+
+	zbuffer.resize(64 * 1024);
+	block.reserve(BLOCK_SIZE + 64 * 1024);
+
+	thread = spring::thread(&CDemoStreamWriter::ThreadFunc, this);
+}
+
+CDemoStreamWriter::~CDemoStreamWriter()
+{
+	if (!thread.joinable())
+		return;
+
+	// normally done by Close
+	PushJob({JOB_CLOSE, false, {}, {}});
+	thread.join();
+}
+
+
+void CDemoStreamWriter::Append(const void* data, size_t size)
+{
+	const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(data);
+
+	block.insert(block.end(), bytes, bytes + size);
+	streamSize += size;
+}
+
+void CDemoStreamWriter::BeginChunk(float modGameTime)
+{
+	const bool sealLive = (liveFlushInterval > 0.0f && (modGameTime - blockIndexEntry.modGameTime) >= liveFlushInterval);
+
+	if (blockRestartPoint && block.size() < BLOCK_SIZE && !sealLive)
+		return;
+
+	SealBlock();
+
+	blockIndexEntry.modGameTime = modGameTime;
+	blockIndexEntry.streamOffset = streamSize;
+	blockIndexEntry.fileOffset = 0; // known once the writer thread gets here
+	blockRestartPoint = true;
+}
+
+void CDemoStreamWriter::SealBlock()
+{
+	if (block.empty())
+		return;
+
+	PushJob({JOB_BLOCK, blockRestartPoint, blockIndexEntry, std::move(block)});
+
+	block.clear();
+	block.reserve(BLOCK_SIZE + 64 * 1024);
+
+	blockRestartPoint = false;
+}
+
+void CDemoStreamWriter::WriteHeader(const DemoFileHeader& header)
+{
+	const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(&header);
+
+	PushJob({JOB_HEADER, false, {}, {bytes, bytes + sizeof(header)}});
+}
+
+void CDemoStreamWriter::Close(const DemoFileHeader& header)
+{
+	const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(&header);
+
+	SealBlock();
+	PushJob({JOB_CLOSE, false, {}, {bytes, bytes + sizeof(header)}});
+
+	thread.join();
+}
+
+void CDemoStreamWriter::PushJob(Job&& job)
+{
+	{
+		std::lock_guard<spring::mutex> lock(jobMutex);
+		jobs.emplace_back(std::move(job));
+	}
+
+	jobCond.notify_one();
+}
+
+
+void CDemoStreamWriter::ThreadFunc()
 {
-	std::lock_guard<spring::mutex> lock(demoMutex);
+	Threading::SetThreadName("demo-writer");
+
+	while (true) {
+		Job job;
+
+		{
+			std::unique_lock<spring::mutex> lock(jobMutex);
+			jobCond.wait(lock, [&]() { return (!jobs.empty()); });
+
+			job = std::move(jobs.front());
+			jobs.pop_front();
+		}
+
+		switch (job.type) {
+			case JOB_BLOCK: {
+				// the previous block ended with a full flush, inflation can restart here
+				if (job.restartPoint) {
+					job.indexEntry.fileOffset = fileSize;
+					index.push_back(job.indexEntry);
+				}
+
+				Deflate(job.data.data(), job.data.size(), Z_FULL_FLUSH);
+				fflush(file);
+
+				// only announce the restart point once its data is on disk
+				if (job.restartPoint && indexFile != nullptr) {
+					DemoStreamIndexEntry entry = job.indexEntry;
+
+					entry.swab();
+					fwrite(&entry, sizeof(entry), 1, indexFile);
+					fflush(indexFile);
+				}
+			} break;
+			case JOB_HEADER: {
+				FileWriteHeader(job.data);
+			} break;
+			case JOB_CLOSE: {
+				FileClose(job.data);
+				return;
+			} break;
+			default: {
+				assert(false);
+			} break;
+		}
+	}
+}
+
+void CDemoStreamWriter::Deflate(const std::uint8_t* data, size_t size, int flush)
+{
+	zstream.next_in = const_cast<std::uint8_t*>(data);
+	zstream.avail_in = size;
+
+	do {
+		zstream.next_out = zbuffer.data();
+		zstream.avail_out = zbuffer.size();
+
+		deflate(&zstream, flush);
+		FileWrite(zbuffer.data(), zbuffer.size() - zstream.avail_out);
+	} while (zstream.avail_out == 0);
+
+	dataCRC = crc32(dataCRC, data, size);
+	dataSize += size;
+}
+
+void CDemoStreamWriter::FileWrite(const void* data, size_t size)
+{
+	fileSize += fwrite(data, 1, size, file);
+}
+
+void CDemoStreamWriter::FileWriteHeader(const std::vector<std::uint8_t>& header)
+{
+	fseek(file, DEMO_HEADER_OFFSET, SEEK_SET);
+	fwrite(header.data(), 1, header.size(), file);
+	fseek(file, 0, SEEK_END);
+}
+
+void CDemoStreamWriter::FileClose(const std::vector<std::uint8_t>& header)
+{
+	DemoStreamIndexHeader indexHeader;
+	std::vector<std::uint8_t> indexData(sizeof(indexHeader) + index.size() * sizeof(DemoStreamIndexEntry));
+
+	memset(&indexHeader, 0, sizeof(indexHeader));
+	strcpy(indexHeader.magic, DEMOFILE_INDEX_MAGIC);
+	indexHeader.numEntries = index.size();
+	indexHeader.swab();
+	memcpy(indexData.data(), &indexHeader, sizeof(indexHeader));
+
+	for (size_t i = 0; i < index.size(); i++) {
+		index[i].swab();
+		memcpy(&indexData[sizeof(indexHeader) + i * sizeof(DemoStreamIndexEntry)], &index[i], sizeof(DemoStreamIndexEntry));
+	}
+
+	Deflate(indexData.data(), indexData.size(), Z_FINISH);
+	deflateEnd(&zstream);
+
+	// the trailer covers the uncompressed header as it is *now*
+	const std::uint32_t headerCRC = crc32(crc32(0, nullptr, 0), header.data(), header.size());
+	const std::uint32_t totalCRC = crc32_combine(headerCRC, dataCRC, dataSize);
+	const std::uint32_t totalSize = header.size() + dataSize;
+
+	const std::uint8_t gzipTrailer[8] = {
+		std::uint8_t(totalCRC      ), std::uint8_t(totalCRC  >>  8), std::uint8_t(totalCRC  >> 16), std::uint8_t(totalCRC  >> 24),
+		std::uint8_t(totalSize     ), std::uint8_t(totalSize >>  8), std::uint8_t(totalSize >> 16), std::uint8_t(totalSize >> 24),
+	};
+
+	FileWrite(gzipTrailer, sizeof(gzipTrailer));
+	FileWriteHeader(header);
 
-	SetStream();
+	fclose(file);
+	file = nullptr;
+
+	if (indexFile == nullptr)
+		return;
+
+	fclose(indexFile);
+	indexFile = nullptr;
+}
+
+
+
+CDemoRecorder::CDemoRecorder() { memset(&fileHeader, 0, sizeof(fileHeader)); }
+CDemoRecorder::CDemoRecorder(CDemoRecorder&& r) { *this = std::move(r); }
+
+CDemoRecorder::CDemoRecorder(const std::string& mapName, const std::string& modName, bool serverDemo): isServerDemo(serverDemo)
+{
 	SetName(mapName, modName);
 	SetFileHeader();
-	WriteFileHeader(false);
 
-	file = gzopen(demoName.c_str(), "wb9");
+	DemoFileHeader tmpHeader;
+	memcpy(&tmpHeader, &fileHeader, sizeof(fileHeader));
+	tmpHeader.swab();
+
+	writer.reset(new CDemoStreamWriter(demoName, tmpHeader));
+
+	if (writer->IsOpen())
+		return;
+
+	writer.reset();
 }
 
 CDemoRecorder::~CDemoRecorder()
 {
-	if (file == nullptr)
+	if (writer == nullptr)
 		return;
 
 	WriteWinnerList();
 	WritePlayerStats();
 	WriteTeamStats();
 	WriteFileHeader(true);
-	WriteDemoFile();
-}
 
-
-void CDemoRecorder::SetStream()
-{
-	demoStreams[isServerDemo].clear();
-	demoStreams[isServerDemo].reserve(8 * 1024 * 1024);
+	LOG("[DemoRecorder::%s] wrote %s-demo \"%s\"", __func__, (isServerDemo? "server": "client"), demoName.c_str());
 }
 
+
 void CDemoRecorder::SetFileHeader()
 {
 	memset(&fileHeader, 0, sizeof(DemoFileHeader));
@@ -76,33 +412,6 @@ void CDemoRecorder::SetFileHeader()
 	fileHeader.winningAllyTeamsSize = 0;
 }
 
-void CDemoRecorder::WriteDemoFile()
-{
-	// zlib FAQ claims the lib is thread-safe, "however any library routines that zlib uses and
-	// any application-provided memory allocation routines must also be thread-safe. zlib's gz*
-	// functions use stdio library routines, and most of zlib's functions use the library memory
-	// allocation routines by default" (so code below should be OK)
-	// gz* should usually be finished before ctor runs again when reloading, but take no chances
-	std::string& data = demoStreams[isServerDemo];
-	std::function<void(gzFile, std::string&)> func = [](gzFile file, std::string& data) {
-		std::lock_guard<spring::mutex> lock(demoMutex);
-
-		gzwrite(file, data.c_str(), data.size());
-		gzflush(file, Z_FINISH);
-		gzclose(file);
-	};
-
-	LOG("[DemoRecorder::%s] writing %s-demo \"%s\" (" _STPF_ " bytes)", __func__, (isServerDemo? "server": "client"), demoName.c_str(), data.size());
-
-	#ifndef _WIN32
-	// NOTE: can not use ThreadPool for this directly here, workers are already gone
-	// FIXME: does not currently (august 2017) compile on Windows mingw buildbots
-	ThreadPool::AddExtJob(spring::thread(std::move(func), file, std::ref(data)));
-	#else
-	ThreadPool::AddExtJob(std::move(std::async(std::launch::async, std::move(func), file, std::ref(data))));
-	#endif
-}
-
 void CDemoRecorder::WriteSetupText(const std::string& text)
 {
 	int length = text.length();
@@ -111,7 +420,7 @@ void CDemoRecorder::WriteSetupText(const std::string& text)
 	}
 
 	fileHeader.scriptSize = length;
-	demoStreams[isServerDemo].append(text.c_str(), length);
+	writer->Append(text.c_str(), length);
 }
 
 void CDemoRecorder::SaveToDemo(const unsigned char* buf, const unsigned length, const float modGameTime)
@@ -121,8 +430,9 @@ void CDemoRecorder::SaveToDemo(const unsigned char* buf, const unsigned length,
 	chunkHeader.modGameTime = modGameTime;
 	chunkHeader.length = length;
 	chunkHeader.swab();
-	demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&chunkHeader), sizeof(chunkHeader));
-	demoStreams[isServerDemo].append(reinterpret_cast<const char*>(buf), length);
+	writer->BeginChunk(modGameTime);
+	writer->Append(&chunkHeader, sizeof(chunkHeader));
+	writer->Append(buf, length);
 	fileHeader.demoStreamSize += (length + sizeof(chunkHeader));
 }
 
@@ -216,8 +526,8 @@ void CDemoRecorder::SetWinningAllyTeams(const std::vector<unsigned char>& winnin
 }
 
 /** @brief Write DemoFileHeader
-Write the DemoFileHeader at the start of the file and restores the original
-position in the file afterwards. */
+Overwrites the DemoFileHeader at the start of the file; when updateStreamLength
+is set the header is final and the file is closed. */
 unsigned int CDemoRecorder::WriteFileHeader(bool updateStreamLength)
 {
 	DemoFileHeader tmpHeader;
@@ -229,28 +539,25 @@ unsigned int CDemoRecorder::WriteFileHeader(bool updateStreamLength)
 	// to little endian
 	tmpHeader.swab();
 
-	if (demoStreams[isServerDemo].empty()) {
-		demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&tmpHeader), sizeof(tmpHeader));
+	if (updateStreamLength) {
+		writer->Close(tmpHeader);
 	} else {
-		assert(demoStreams[isServerDemo].size() >= sizeof(tmpHeader));
-		memcpy(&demoStreams[isServerDemo][0], reinterpret_cast<const char*>(&tmpHeader), sizeof(tmpHeader)); // no non-const .data() until C++17
+		writer->WriteHeader(tmpHeader);
 	}
 
-	return (demoStreams[isServerDemo].size());
+	return (sizeof(tmpHeader));
 }
 
 /** @brief Write the CPlayer::Statistics at the current position in the file. */
 void CDemoRecorder::WritePlayerStats()
 {
-	const size_t pos = demoStreams[isServerDemo].size();
-
 	for (PlayerStatistics& stats: playerStats) {
 		stats.swab();
-		demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&stats), sizeof(PlayerStatistics));
+		writer->Append(&stats, sizeof(PlayerStatistics));
 	}
 
 	fileHeader.numPlayers = playerStats.size();
-	fileHeader.playerStatSize = int(demoStreams[isServerDemo].size() - pos);
+	fileHeader.playerStatSize = int(playerStats.size() * sizeof(PlayerStatistics));
 
 	playerStats.clear();
 }
@@ -263,38 +570,36 @@ void CDemoRecorder::WriteWinnerList()
 	if (fileHeader.numTeams == 0)
 		return;
 
-	const size_t pos = demoStreams[isServerDemo].size();
-
 	// Write the array of winningAllyTeams.
-	for (size_t i = 0; i < winningAllyTeams.size(); i++) { // NOLINT{modernize-loop-convert}
-		demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&winningAllyTeams[i]), sizeof(unsigned char));
-	}
+	writer->Append(winningAllyTeams.data(), winningAllyTeams.size() * sizeof(unsigned char));
 
-	winningAllyTeams.clear();
+	fileHeader.winningAllyTeamsSize = int(winningAllyTeams.size() * sizeof(unsigned char));
 
-	fileHeader.winningAllyTeamsSize = int(demoStreams[isServerDemo].size() - pos);
+	winningAllyTeams.clear();
 }
 
 /** @brief Write the TeamStatistics at the current position in the file. */
 void CDemoRecorder::WriteTeamStats()
 {
-	const size_t pos = demoStreams[isServerDemo].size();
+	size_t numBytes = 0;
 
 	// Write array of dwords indicating number of TeamStatistics per team.
 	for (std::vector<TeamStatistics>& history: teamStats) {
 		unsigned int c = swabDWord(history.size());
-		demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&c), sizeof(unsigned int));
+		writer->Append(&c, sizeof(unsigned int));
+		numBytes += sizeof(unsigned int);
 	}
 
 	// Write big array of TeamStatistics.
 	for (std::vector<TeamStatistics>& history: teamStats) {
 		for (TeamStatistics& stats: history) {
 			stats.swab();
-			demoStreams[isServerDemo].append(reinterpret_cast<const char*>(&stats), sizeof(TeamStatistics));
+			writer->Append(&stats, sizeof(TeamStatistics));
+			numBytes += sizeof(TeamStatistics);
 		}
 	}
 
-	fileHeader.teamStatSize = int(demoStreams[isServerDemo].size() - pos);
+	fileHeader.teamStatSize = int(numBytes);
 
 	teamStats.clear();
 }
@@ -17,6 +17,9 @@
 /** The first 16 bytes of each demofile. */
 #define DEMOFILE_MAGIC "spring demofile"
 
+/** The first 16 bytes of the (optional) demo stream index. */
+#define DEMOFILE_INDEX_MAGIC "spring demoidx"
+
 /**
  * The current demofile version. Only change on major modifications for which
  * appending stuff to DemoFileHeader is not sufficient.
@@ -40,6 +43,7 @@
  *         CTeam::Statistics for each team.
  *       - Array of all CTeam::Statistics (total number of items is the
  *         sum of the elements in the array of dwords).
+ *     - Demo stream index (optional), see DemoStreamIndexHeader
  *
  * The header is designed to be extensible: it contains a version field and a
  * headerSize field to support this. The version field is a major version number
@@ -115,6 +119,47 @@ struct DemoStreamChunkHeader
 	}
 };
 
+/**
+ * @brief Spring demo stream index header
+ *
+ * Demos written by newer engines end with an index of points at which the
+ * compressed file can be decompressed without inflating everything before
+ * them. The index directly follows the team statistics in the uncompressed
+ * data:
+ *
+ * - DemoStreamIndexHeader
+ * - numEntries times DemoStreamIndexEntry, in order of increasing offsets
+ *
+ * The compressed file is a single gzip member whose deflate stream is flushed
+ * (Z_FULL_FLUSH) at each fileOffset, so a raw inflater (windowBits -15) that
+ * starts reading there produces the uncompressed data from streamOffset on.
+ * Each streamOffset is the position of a DemoStreamChunkHeader.
+ */
+struct DemoStreamIndexHeader
+{
+	char magic[16];             ///< DEMOFILE_INDEX_MAGIC
+	std::uint32_t numEntries;   ///< Number of DemoStreamIndexEntry items following this header.
+
+	/// Change structure from host endian to little endian or vice versa.
+	void swab() {
+		swabDWordInPlace(numEntries);
+	}
+};
+
+struct DemoStreamIndexEntry
+{
+	float modGameTime;          ///< Gametime of the chunk at streamOffset.
+	std::uint32_t streamOffset; ///< Offset of that chunk's header in the uncompressed data.
+	std::uint64_t fileOffset;   ///< Offset in the compressed file at which inflation can restart.
+
+	/// Change structure from host endian to little endian or vice versa.
+	void swab() {
+		swabFloatInPlace(modGameTime);
+		swabDWordInPlace(streamOffset);
+		swab64InPlace(fileOffset);
+	}
+};
+
 #pragma pack(pop)
 
 #endif // DEMO_FILE_H
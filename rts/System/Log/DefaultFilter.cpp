@@ -6,6 +6,7 @@
 #include <string>
 
 #include <algorithm>
+#include <chrono>
 #include <stack>
 
 #include "DefaultFilter.h"
@@ -39,6 +40,7 @@ struct log_filter_section_compare {
 namespace log_filter {
 	static int minLogLevel = LOG_LEVEL_ALL;
 	static int repeatLimit = 1;
+	static int rateLimit = 0;
 
 	static size_t numLevels = 0;
 	static size_t numSections = 0;
@@ -47,6 +49,18 @@ namespace log_filter {
 	static std::array< std::pair<const char*, int> , MAX_LOG_SECTIONS> sectionMinLevels;
 	static std::array<           const char*       , MAX_LOG_SECTIONS> registeredSections;
 
+	struct SectionRate {
+		const char* section;
+
+		int64_t windowStart; // millisecs
+		int numRecords;
+		int numDropped;
+	};
+
+	// keyed by pointer, the same section-name can be declared by multiple translation units
+	static std::array<SectionRate, MAX_LOG_SECTIONS * 2> sectionRates;
+	static size_t numRates = 0;
+
 	#if 0
 	void inline printSectionMinLevels(const char* func) {
 		printf("[%s][caller=%s]\n", __func__, func);
@@ -103,6 +117,9 @@ void log_filter_global_setMinLevel(int level) { log_filter_checkCompileTimeMinLe
 int log_filter_getRepeatLimit() { return log_filter::repeatLimit; }
 void log_filter_setRepeatLimit(int limit) { log_filter::repeatLimit = limit; }
 
+int log_filter_getRateLimit() { return log_filter::rateLimit; }
+void log_filter_setRateLimit(int limit) { log_filter::rateLimit = limit; }
+
 
 
 int log_filter_section_getMinLevel(const char* section)
@@ -218,6 +235,50 @@ const char* log_filter_section_getRegisteredIndex(int index) {
 	return log_filter::registeredSections[index];
 }
 
+// false if <section> already logged rateLimit records within the last second
+static bool log_filter_section_checkRate(int level, const char* section)
+{
+	if (log_filter::rateLimit <= 0 || level >= LOG_LEVEL_WARNING)
+		return true;
+
+	auto& rates = log_filter::sectionRates;
+
+	const auto beg = rates.begin();
+	const auto end = rates.begin() + log_filter::numRates;
+	const auto iter = std::find_if(beg, end, [section](const log_filter::SectionRate& r) { return (r.section == section); });
+
+	if (iter == end) {
+		// only reachable by a pathological number of distinct section pointers
+		if (log_filter::numRates == rates.size())
+			return true;
+
+		*iter = {section, 0, 0, 0};
+		log_filter::numRates++;
+	}
+
+	const int64_t curTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+	if ((curTime - iter->windowStart) >= 1000) {
+		const int numDropped = iter->numDropped;
+
+		iter->windowStart = curTime;
+		iter->numRecords = 0;
+		iter->numDropped = 0;
+
+		// reported with the first record of the next window, as a warning it is not limited
+		if (numDropped > 0)
+			log_frontend_record(LOG_LEVEL_WARNING, section, "[%s] dropped %d records (LogSectionRateLimit=%d)", __func__, numDropped, log_filter::rateLimit);
+	}
+
+	if (iter->numRecords >= log_filter::rateLimit) {
+		iter->numDropped++;
+		return false;
+	}
+
+	iter->numRecords++;
+	return true;
+}
+
 static void log_filter_record(int level, const char* section, const char* fmt, va_list arguments)
 {
 	assert(level > LOG_LEVEL_ALL);
@@ -225,6 +286,9 @@ static void log_filter_record(int level, const char* section, const char* fmt, v
 
 	if (!log_frontend_isEnabled(level, section))
 		return;
+	// checked before paying for formatting, unlike the repeat-limit
+	if (!log_filter_section_checkRate(level, section))
+		return;
 
 	// format (and later store) the log record
 	log_backend_record(level, section, fmt, arguments);
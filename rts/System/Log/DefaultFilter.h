@@ -23,6 +23,14 @@ extern "C" {
 void log_filter_setRepeatLimit(int limit);
 int log_filter_getRepeatLimit();
 
+/**
+ * Sets the maximum number of records per second that any one section may
+ * log below LOG_LEVEL_WARNING; excess records are dropped before they are
+ * formatted. 0 (the default) disables the limit.
+ */
+void log_filter_setRateLimit(int limit);
+int log_filter_getRateLimit();
+
 /**
  * Sets the minimum level to log for all sections, including the default one.
  *
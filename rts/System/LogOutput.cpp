@@ -43,6 +43,11 @@ CONFIG(int, LogRepeatLimit)
 	.defaultValue(10)
 	.description("Allow at most this many consecutive identical messages to be logged.");
 
+CONFIG(int, LogSectionRateLimit)
+	.defaultValue(0)
+	.minimumValue(0)
+	.description("Allow at most this many messages per second from any one log section, 0 disables the limit. Warnings and errors are never dropped.");
+
 /******************************************************************************/
 /******************************************************************************/
 
@@ -183,6 +188,7 @@ void CLogOutput::Initialize()
 		RotateLogFile();
 
 	log_filter_setRepeatLimit(configHandler->GetInt("LogRepeatLimit")); // all sinks
+	log_filter_setRateLimit(configHandler->GetInt("LogSectionRateLimit"));
 	log_file_addLogFile(filePath.c_str(), nullptr, LOG_LEVEL_ALL, configHandler->GetInt("LogFlushLevel"));
 
 	LOG("LogOutput initialized. Logging to %s", filePath.c_str());
@@ -0,0 +1,37 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "AllocCounter.h"
+
+#ifdef ALLOC_COUNTER
+#include <cstdlib>
+#include <new>
+
+// replaceable global allocation functions; the aligned and placement
+// forms are left alone, the former keep using their default pairing
+void* operator new(std::size_t size)
+{
+	AllocCounter::threadCount += 1;
+
+	// unlike malloc, new must return a unique non-null pointer for size 0
+	if (void* ptr = std::malloc(size + (size == 0)))
+		return ptr;
+
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	AllocCounter::threadCount += 1;
+	return (std::malloc(size + (size == 0)));
+}
+
+void* operator new[](std::size_t size) { return (operator new(size)); }
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return (operator new(size, tag)); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+#endif
@@ -0,0 +1,26 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+#include <cstdint>
+
+/**
+ * Per-thread count of global operator new calls, maintained by the
+ * replacement operators in AllocCounter.cpp when building with the
+ * ALLOC_COUNTER option and always zero otherwise. ScopedTimer picks
+ * this up so "/debuginfo profiling" can list allocations per timer.
+ */
+namespace AllocCounter {
+#ifdef ALLOC_COUNTER
+	static constexpr bool ENABLED = true;
+#else
+	static constexpr bool ENABLED = false;
+#endif
+
+	inline thread_local std::uint64_t threadCount = 0;
+
+	inline std::uint64_t GetThreadCount() { return threadCount; }
+};
+
+#endif
@@ -18,6 +18,7 @@ const std::string NoClientsExit = "No clients connected, shutting down server";
 
 const std::string NoSyncResponse = "Error: Player %s did not send sync checksum for frame %d";
 const std::string SyncError = "Sync error for %s in frame %d (got %x, correct is %x)";
+const std::string SyncTreeError = "Sync error for %s in frame %d is in subsystem(s): %s";
 const std::string NoSyncCheck = "Warning: Sync checking disabled!";
 
 const std::string ConnectionReject = "Connection attempt rejected from %s: %s";
@@ -37,6 +38,9 @@ const std::string UnknownNetmsg = "Unhandled net msg (%d) in server from %d";
 
 const std::string CommandNotAllowed = "Player %d is not allowed to execute command %s";
 
+const std::string NetStatsLine = "[netstats] %s (%d): rtt p50<%ums p95<%ums, ack p95<%ums, queued p95<%ums, jitter p95<%ums, %.1f%% resent, %u out of order, %u duplicate";
+const std::string NetStatsNone = "[netstats] no players connected over the network";
+
 const std::string UncontrolledPlayerName = "Uncontrolled";
 const std::string UnnamedPlayerName = "UnnamedPlayer";
 
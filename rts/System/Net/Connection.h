@@ -6,6 +6,7 @@
 #include <string>
 #include <memory>
 
+#include "NetTimingStats.h"
 #include "RawPacket.h"
 
 namespace netcode
@@ -66,10 +67,14 @@ public:
 	virtual unsigned int GetPacketQueueSize() const { return 0; }
 
 	virtual std::string Statistics() const = 0;
+	/// latency histograms, only tracked by connections over a real network
+	virtual const NetTimingStats* GetTimingStats() const { return nullptr; }
 	virtual std::string GetFullAddress() const = 0;
 	virtual void Unmute() = 0;
 	virtual void Close(bool flush = false) = 0;
 	virtual void SetLossFactor(int factor) = 0;
+	/// upper bound on chunks sent per second, only meaningful for real network links
+	virtual void SetChunksPerSec(int rate) {}
 
 	/**
 	 * @brief update internals
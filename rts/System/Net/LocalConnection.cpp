@@ -7,14 +7,92 @@
 #include "System/Log/ILog.h"
 #include "System/SpringFormat.h"
 
+#include <array>
+#include <atomic>
+
 namespace netcode {
 
+/**
+ * Fixed-size SPSC queue of packet pointers; the sender only writes tail and
+ * the receiver only writes head, so neither side ever has to take a lock.
+ * If the receiver falls far behind (e.g. while the client is busy loading)
+ * packets spill into a mutex-guarded overflow queue instead of blocking the
+ * sender, and keep doing so until the receiver has emptied it to preserve
+ * ordering.
+ */
+struct CLocalConnection::PacketRing {
+	static constexpr unsigned int NUM_SLOTS = 1024;
+	static constexpr unsigned int SLOT_MASK = NUM_SLOTS - 1;
+
+	static_assert((NUM_SLOTS & SLOT_MASK) == 0, "");
+
+	void Push(std::shared_ptr<const RawPacket> pkt) {
+		if (numOverflowed.load(std::memory_order_acquire) == 0) {
+			const unsigned int t = tail.load(std::memory_order_relaxed);
+
+			if ((t - head.load(std::memory_order_acquire)) < NUM_SLOTS) {
+				slots[t & SLOT_MASK] = std::move(pkt);
+				tail.store(t + 1, std::memory_order_release);
+				return;
+			}
+		}
+
+		std::lock_guard<spring::mutex> lock(overflowMutex);
+		overflow.push_back(std::move(pkt));
+		numOverflowed.fetch_add(1, std::memory_order_release);
+	}
+
+	void PopAll(std::deque< std::shared_ptr<const RawPacket> >& queue) {
+		PopSlots(queue);
+
+		if (numOverflowed.load(std::memory_order_acquire) == 0)
+			return;
+
+		// every ring entry pushed before the first overflowed packet is visible
+		// by now, drain those again before appending the overflow to the queue
+		std::lock_guard<spring::mutex> lock(overflowMutex);
+		PopSlots(queue);
+
+		for (auto& pkt: overflow) {
+			queue.push_back(std::move(pkt));
+		}
+
+		overflow.clear();
+		numOverflowed.store(0, std::memory_order_release);
+	}
+
+	void PopSlots(std::deque< std::shared_ptr<const RawPacket> >& queue) {
+		const unsigned int t = tail.load(std::memory_order_acquire);
+		unsigned int h = head.load(std::memory_order_relaxed);
+
+		for (; h != t; h++) {
+			queue.push_back(std::move(slots[h & SLOT_MASK]));
+		}
+
+		head.store(h, std::memory_order_release);
+	}
+
+	void Clear() {
+		std::deque< std::shared_ptr<const RawPacket> > queue;
+		PopAll(queue);
+	}
+
+	std::array<std::shared_ptr<const RawPacket>, NUM_SLOTS> slots;
+
+	alignas(64) std::atomic<unsigned int> head = {0}; ///< next slot to read
+	alignas(64) std::atomic<unsigned int> tail = {0}; ///< next slot to write
+	alignas(64) std::atomic<unsigned int> numOverflowed = {0};
+
+	spring::mutex overflowMutex;
+	std::deque< std::shared_ptr<const RawPacket> > overflow;
+};
+
+
 // static stuff
 unsigned int CLocalConnection::numInstances = 0;
 
+CLocalConnection::PacketRing CLocalConnection::pktRings[CLocalConnection::MAX_INSTANCES];
 std::deque< std::shared_ptr<const RawPacket> > CLocalConnection::pktQueues[CLocalConnection::MAX_INSTANCES];
-spring::mutex CLocalConnection::mutexes[CLocalConnection::MAX_INSTANCES];
-CLocalConnection* CLocalConnection::instancePtrs[MAX_INSTANCES] = {nullptr, nullptr};
 
 CLocalConnection::CLocalConnection()
 {
@@ -22,8 +100,8 @@ CLocalConnection::CLocalConnection()
 		throw network_error("Opening a third local connection is not allowed");
 
 	// clear data that might have been left over (if we reloaded)
-	pktQueues[instanceIdx = numInstances++].clear();
-	instancePtrs[instanceIdx] = this;
+	pktRings[instanceIdx = numInstances++].Clear();
+	pktQueues[instanceIdx].clear();
 
 	// make sure protocoldef is initialized
 	CBaseNetProtocol::Get();
@@ -31,9 +109,6 @@ CLocalConnection::CLocalConnection()
 
 CLocalConnection::~CLocalConnection()
 {
-	std::lock_guard<spring::mutex> scoped_lock(mutexes[instanceIdx]);
-
-	instancePtrs[instanceIdx] = nullptr;
 	numInstances--;
 }
 
@@ -43,8 +118,9 @@ void CLocalConnection::Close(bool flush)
 	if (!flush)
 		return;
 
-	std::lock_guard<spring::mutex> scoped_lock(mutexes[instanceIdx]);
+	pktRings[instanceIdx].Clear();
 	pktQueues[instanceIdx].clear();
+	numPings = 0;
 }
 
 void CLocalConnection::SendData(std::shared_ptr<const RawPacket> pkt)
@@ -57,27 +133,33 @@ void CLocalConnection::SendData(std::shared_ptr<const RawPacket> pkt)
 
 	dataSent += pkt->length;
 
-	{
-		// when sending from A to B we must lock B's queue
-		std::lock_guard<spring::mutex> scoped_lock(mutexes[RemoteInstanceIdx()]);
+	// outgoing for A, incoming for B
+	pktRings[RemoteInstanceIdx()].Push(std::move(pkt));
+}
 
-		// outgoing for A, incoming for B
-		if (instancePtrs[RemoteInstanceIdx()] != nullptr)
-			instancePtrs[RemoteInstanceIdx()]->numPings += (pkt->data[0] == NETMSG_PING);
+void CLocalConnection::ReceivePackets()
+{
+	std::deque<std::shared_ptr<const RawPacket>>& pktQueue = pktQueues[instanceIdx];
+
+	const size_t numQueued = pktQueue.size();
 
-		pktQueues[RemoteInstanceIdx()].push_back(pkt);
+	pktRings[instanceIdx].PopAll(pktQueue);
+
+	for (size_t i = numQueued, n = pktQueue.size(); i < n; i++) {
+		numPings += (pktQueue[i]->data[0] == NETMSG_PING);
 	}
 }
 
 std::shared_ptr<const RawPacket> CLocalConnection::GetData()
 {
-	std::lock_guard<spring::mutex> scoped_lock(mutexes[instanceIdx]);
 	std::deque<std::shared_ptr<const RawPacket>>& pktQueue = pktQueues[instanceIdx];
 
+	if (pktQueue.empty())
+		ReceivePackets();
 	if (pktQueue.empty())
 		return {};
 
-	std::shared_ptr<const RawPacket> pkt = pktQueue.front();
+	std::shared_ptr<const RawPacket> pkt = std::move(pktQueue.front());
 	pktQueue.pop_front();
 
 	dataRecv += pkt->length;
@@ -87,9 +169,11 @@ std::shared_ptr<const RawPacket> CLocalConnection::GetData()
 
 std::shared_ptr<const RawPacket> CLocalConnection::Peek(unsigned ahead) const
 {
-	std::lock_guard<spring::mutex> scoped_lock(mutexes[instanceIdx]);
 	std::deque<std::shared_ptr<const RawPacket>>& pktQueue = pktQueues[instanceIdx];
 
+	// receiving only moves packets between our own queues, so is logically const
+	if (ahead >= pktQueue.size())
+		const_cast<CLocalConnection*>(this)->ReceivePackets();
 	if (ahead >= pktQueue.size())
 		return {};
 
@@ -98,13 +182,12 @@ std::shared_ptr<const RawPacket> CLocalConnection::Peek(unsigned ahead) const
 
 void CLocalConnection::DeleteBufferPacketAt(unsigned index)
 {
-	std::lock_guard<spring::mutex> scoped_lock(mutexes[instanceIdx]);
 	std::deque<std::shared_ptr<const RawPacket>>& pktQueue = pktQueues[instanceIdx];
 
 	if (index >= pktQueue.size())
 		return;
 
-	numPings -= (pktQueue[0]->data[0] == NETMSG_PING);
+	numPings -= (pktQueue[index]->data[0] == NETMSG_PING);
 	pktQueue.erase(pktQueue.begin() + index);
 }
 
@@ -120,15 +203,16 @@ std::string CLocalConnection::Statistics() const
 
 bool CLocalConnection::HasIncomingData() const
 {
-	std::lock_guard<spring::mutex> scoped_lock(mutexes[instanceIdx]);
+	if (pktQueues[instanceIdx].empty())
+		const_cast<CLocalConnection*>(this)->ReceivePackets();
+
 	return (!pktQueues[instanceIdx].empty());
 }
 
 unsigned int CLocalConnection::GetPacketQueueSize() const
 {
-	std::lock_guard<spring::mutex> scoped_lock(mutexes[instanceIdx]);
-	return (!pktQueues[instanceIdx].size());
+	const_cast<CLocalConnection*>(this)->ReceivePackets();
+	return (pktQueues[instanceIdx].size());
 }
 
 } // namespace netcode
-
@@ -16,6 +16,9 @@ namespace netcode {
  * The server and the client have to run in one instance (same process)
  * of spring for this to work.
  * Otherwise, a normal UDP connection had to be used.
+ * Each direction is a lock-free single-producer single-consumer ring,
+ * sends and receives on one instance must therefore not run concurrently
+ * (CNetProtocol and CGameServer already serialize them).
  * IMPORTANT: You must not have more than two instances of this.
  */
 class CLocalConnection : public CConnection
@@ -44,6 +47,7 @@ public:
 	void Unmute() override {}
 	void Close(bool flush) override;
 	void SetLossFactor(int factor) override {}
+	void Update() override { ReceivePackets(); }
 
 	unsigned int GetPacketQueueSize() const override;
 
@@ -55,9 +59,15 @@ public:
 private:
 	static constexpr unsigned int MAX_INSTANCES = 2;
 
+	struct PacketRing;
+
+	/// moves everything the remote instance sent so far to our pktQueue
+	void ReceivePackets();
+
+	/// written by the remote instance, read by us
+	static PacketRing pktRings[MAX_INSTANCES];
+	/// packets taken off our ring, only ever touched by the receiving side
 	static std::deque< std::shared_ptr<const RawPacket> > pktQueues[MAX_INSTANCES];
-	static spring::mutex mutexes[MAX_INSTANCES];
-	static CLocalConnection* instancePtrs[MAX_INSTANCES];
 
 	unsigned int RemoteInstanceIdx() const { return ((instanceIdx + 1) % MAX_INSTANCES); }
 
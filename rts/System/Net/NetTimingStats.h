@@ -0,0 +1,88 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _NET_TIMING_STATS_H
+#define _NET_TIMING_STATS_H
+
+#include <array>
+#include <cstdint>
+
+namespace netcode
+{
+
+/**
+ * @brief Fixed-size histogram of millisecond durations
+ *
+ * Bucket 0 counts samples below 1ms, bucket i counts [2^(i-1), 2^i) ms
+ * and the last bucket everything above; that is coarse, but cheap enough
+ * to be fed for every chunk and still tells 20ms from 200ms from 2s.
+ */
+class NetHistogram
+{
+public:
+	static constexpr unsigned NUM_BUCKETS = 16;
+
+	void Add(float msecs) {
+		unsigned bucket = 0;
+
+		for (unsigned limit = 1; bucket < (NUM_BUCKETS - 1) && msecs >= limit; limit <<= 1) {
+			bucket += 1;
+		}
+
+		buckets[bucket] += 1;
+		numSamples += 1;
+		maxValue = (msecs > maxValue)? msecs: maxValue;
+	}
+
+	void Reset() { *this = {}; }
+
+	/// upper bound of the bucket containing the given fraction of samples
+	unsigned GetPercentile(float frac) const {
+		const std::uint32_t target = numSamples * frac;
+
+		std::uint32_t count = 0;
+
+		for (unsigned i = 0; i < NUM_BUCKETS; i++) {
+			if ((count += buckets[i]) > target)
+				return (1u << i);
+		}
+
+		return 0;
+	}
+
+	std::uint32_t GetBucket(unsigned i) const { return buckets[i]; }
+	std::uint32_t GetNumSamples() const { return numSamples; }
+	float GetMaxValue() const { return maxValue; }
+
+private:
+	std::array<std::uint32_t, NUM_BUCKETS> buckets = {};
+
+	std::uint32_t numSamples = 0;
+	float maxValue = 0.0f;
+};
+
+
+/// per-connection latency data, see UDPConnection for where each is sampled
+struct NetTimingStats
+{
+	void Reset() { *this = {}; }
+
+	/// first send until ack, for chunks that were never resent (Karn)
+	NetHistogram roundTrip;
+	/// first send until ack, for all chunks; includes time waiting on resends
+	NetHistogram unackedTime;
+	/// enqueued by SendData until turned into a chunk
+	NetHistogram outgoingQueue;
+	/// change in interval between consecutive frame messages
+	NetHistogram frameJitter;
+
+	std::uint32_t sentChunks = 0;
+	std::uint32_t resentChunks = 0;
+	/// received after a chunk with a higher number
+	std::uint32_t outOfOrderChunks = 0;
+	/// received after they were already processed or buffered
+	std::uint32_t duplicateChunks = 0;
+};
+
+} // namespace netcode
+
+#endif // _NET_TIMING_STATS_H
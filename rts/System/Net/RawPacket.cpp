@@ -6,14 +6,112 @@
 #include "RawPacket.h"
 
 #include "System/Log/ILog.h"
+#include "System/Threading/SpringThreading.h"
 
 namespace netcode
 {
 
+// power-of-two size-classes from 2^4 to MAX_POOLED_SIZE bytes; free
+// buffers are chained through their first bytes, which keeps the pool
+// trivially destructible (packets may still be freed during shutdown)
+static constexpr uint32_t MIN_CLASS_SHIFT = 4;
+static constexpr uint32_t MAX_CLASS_SHIFT = 12;
+static constexpr uint32_t NUM_SIZE_CLASSES = MAX_CLASS_SHIFT - MIN_CLASS_SHIFT + 1;
+static constexpr uint32_t MAX_FREE_BUFFERS = 1024;
+
+static_assert((1u << MAX_CLASS_SHIFT) == RawPacket::MAX_POOLED_SIZE, "");
+static_assert((1u << MIN_CLASS_SHIFT) >= sizeof(void*), "");
+
+struct FreeBuffer {
+	FreeBuffer* next;
+};
+
+struct BufferPool {
+	spring::spinlock mutex;
+
+	FreeBuffer* head;
+	uint32_t numFree;
+};
+
+static BufferPool bufferPools[NUM_SIZE_CLASSES];
+
+
+static uint32_t GetSizeClass(uint32_t size)
+{
+	uint32_t sizeClass = 0;
+
+	while ((1u << (sizeClass + MIN_CLASS_SHIFT)) < size)
+		sizeClass++;
+
+	return sizeClass;
+}
+
+uint8_t* RawPacket::AllocData(uint32_t size)
+{
+	if (size > MAX_POOLED_SIZE)
+		return (new uint8_t[size]);
+
+	const uint32_t sizeClass = GetSizeClass(size);
+
+	BufferPool& pool = bufferPools[sizeClass];
+	FreeBuffer* buffer = nullptr;
+
+	{
+		std::lock_guard<spring::spinlock> lock(pool.mutex);
+
+		if ((buffer = pool.head) != nullptr) {
+			pool.head = buffer->next;
+			pool.numFree -= 1;
+		}
+	}
+
+	if (buffer != nullptr)
+		return (reinterpret_cast<uint8_t*>(buffer));
+
+	return (new uint8_t[1u << (sizeClass + MIN_CLASS_SHIFT)]);
+}
+
+void RawPacket::FreeData(uint8_t* data, uint32_t size)
+{
+	if (size > MAX_POOLED_SIZE) {
+		delete[] data;
+		return;
+	}
+
+	BufferPool& pool = bufferPools[GetSizeClass(size)];
+
+	{
+		std::lock_guard<spring::spinlock> lock(pool.mutex);
+
+		if (pool.numFree < MAX_FREE_BUFFERS) {
+			FreeBuffer* buffer = reinterpret_cast<FreeBuffer*>(data);
+
+			buffer->next = pool.head;
+			pool.head = buffer;
+			pool.numFree += 1;
+			return;
+		}
+	}
+
+	delete[] data;
+}
+
+
+void* RawPacket::operator new(size_t size)
+{
+	return (AllocData(size));
+}
+
+void RawPacket::operator delete(void* p, size_t size)
+{
+	FreeData(static_cast<uint8_t*>(p), size);
+}
+
+
 RawPacket::RawPacket(const uint8_t* const tdata, const uint32_t newLength): length(newLength)
 {
 	if (length > 0) {
-		data = new uint8_t[length];
+		data = AllocData(length);
 		memcpy(data, tdata, length);
 	} else {
 		LOG_L(L_ERROR, "[%s] tried to pack a zero-length packet", __func__);
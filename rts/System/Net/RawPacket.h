@@ -19,6 +19,8 @@ namespace netcode
 
 /**
  * @brief simple structure to hold some data
+ * Packets and their data are allocated from size-class pools shared by all
+ * threads, since nearly every network message creates (at least) one.
  */
 class RawPacket
 {
@@ -40,7 +42,7 @@ public:
 		if (length == 0)
 			return;
 
-		data = new uint8_t[length];
+		data = AllocData(length);
 	}
 
 	RawPacket(const uint32_t length, uint8_t msgID): RawPacket(length) {
@@ -52,6 +54,9 @@ public:
 
 	~RawPacket() { Delete(); }
 
+	static void* operator new(size_t size);
+	static void operator delete(void* p, size_t size);
+
 
 	RawPacket& operator = (const RawPacket&  p) = delete;
 	RawPacket& operator = (      RawPacket&& p) {
@@ -117,12 +122,18 @@ public:
 		if (length == 0)
 			return;
 
-		delete[] data;
+		FreeData(data, length);
 		data = nullptr;
 
 		length = 0;
 	}
 
+	/// buffers of up to MAX_POOLED_SIZE bytes are recycled, larger ones use new[]
+	static uint8_t* AllocData(uint32_t size);
+	static void FreeData(uint8_t* data, uint32_t size);
+
+	static constexpr uint32_t MAX_POOLED_SIZE = 4096;
+
 public:
 	uint8_t id = 0;
 	uint8_t* data = nullptr;
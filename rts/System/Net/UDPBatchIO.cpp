@@ -0,0 +1,165 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "UDPBatchIO.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <asio.hpp>
+
+#if defined(__linux__)
+	#include <cerrno>
+	#include <sys/socket.h>
+	#include <sys/uio.h>
+#endif
+
+
+namespace netcode
+{
+
+// flips to false at runtime if the kernel does not implement {recv,send}mmsg
+static std::atomic<bool> haveBatchSyscalls = {true};
+
+
+unsigned int UDPReceiveRing::Receive(asio::ip::udp::socket& socket, asio::error_code& err)
+{
+	err.clear();
+	buffers.resize(NUM_SLOTS * SLOT_SIZE, 0);
+	datagrams.resize(NUM_SLOTS);
+
+	#if defined(__linux__)
+	if (haveBatchSyscalls) {
+		std::array<mmsghdr, NUM_SLOTS> msgs;
+		std::array<iovec, NUM_SLOTS> iovs;
+
+		for (unsigned int i = 0; i < NUM_SLOTS; i++) {
+			iovs[i].iov_base = &buffers[i * SLOT_SIZE];
+			iovs[i].iov_len  = SLOT_SIZE;
+
+			msgs[i] = {};
+			msgs[i].msg_hdr.msg_name    = datagrams[i].endpoint.data();
+			msgs[i].msg_hdr.msg_namelen = datagrams[i].endpoint.capacity();
+			msgs[i].msg_hdr.msg_iov     = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen  = 1;
+		}
+
+		const int numReceived = recvmmsg(socket.native_handle(), msgs.data(), NUM_SLOTS, MSG_DONTWAIT, nullptr);
+
+		if (numReceived >= 0) {
+			for (int i = 0; i < numReceived; i++) {
+				Datagram& dgram = datagrams[i];
+
+				dgram.endpoint.resize(msgs[i].msg_hdr.msg_namelen);
+				dgram.data = &buffers[i * SLOT_SIZE];
+				// truncated datagrams can not be valid packets, let the caller skip them
+				dgram.size = ((msgs[i].msg_hdr.msg_flags & MSG_TRUNC) == 0) * msgs[i].msg_len;
+			}
+
+			return numReceived;
+		}
+
+		if (errno == EAGAIN || errno == EWOULDBLOCK)
+			return 0;
+
+		if (errno != ENOSYS) {
+			err = asio::error_code(errno, asio::error::get_system_category());
+			return 0;
+		}
+
+		haveBatchSyscalls = false;
+	}
+	#endif
+
+	unsigned int numReceived = 0;
+
+	while (numReceived < NUM_SLOTS && socket.available(err) > 0) {
+		Datagram& dgram = datagrams[numReceived];
+		asio::ip::udp::socket::message_flags msgFlags = 0;
+
+		dgram.data = &buffers[numReceived * SLOT_SIZE];
+		dgram.size = socket.receive_from(asio::buffer(&buffers[numReceived * SLOT_SIZE], SLOT_SIZE), dgram.endpoint, msgFlags, err);
+
+		if (err)
+			break;
+
+		numReceived += 1;
+	}
+
+	return numReceived;
+}
+
+
+void UDPSendBatch::Add(const asio::ip::udp::endpoint& endpoint, const std::vector<std::uint8_t>& data)
+{
+	datagrams.push_back({endpoint, buffer.size(), data.size()});
+	buffer.insert(buffer.end(), data.begin(), data.end());
+}
+
+size_t UDPSendBatch::Flush(asio::ip::udp::socket& socket, asio::error_code& err, unsigned int* numSent)
+{
+	size_t numBytes = 0;
+	size_t numDgrams = 0;
+
+	err.clear();
+
+	#if defined(__linux__)
+	constexpr size_t MAX_BATCH_SIZE = 64;
+
+	std::array<mmsghdr, MAX_BATCH_SIZE> msgs;
+	std::array<iovec, MAX_BATCH_SIZE> iovs;
+
+	while (haveBatchSyscalls && numDgrams < datagrams.size()) {
+		const size_t batchSize = std::min(datagrams.size() - numDgrams, MAX_BATCH_SIZE);
+
+		for (size_t i = 0; i < batchSize; i++) {
+			Datagram& dgram = datagrams[numDgrams + i];
+
+			iovs[i].iov_base = &buffer[dgram.offset];
+			iovs[i].iov_len  = dgram.size;
+
+			msgs[i] = {};
+			msgs[i].msg_hdr.msg_name    = dgram.endpoint.data();
+			msgs[i].msg_hdr.msg_namelen = dgram.endpoint.size();
+			msgs[i].msg_hdr.msg_iov     = &iovs[i];
+			msgs[i].msg_hdr.msg_iovlen  = 1;
+		}
+
+		const int batchSent = sendmmsg(socket.native_handle(), msgs.data(), batchSize, 0);
+
+		if (batchSent < 0) {
+			if (errno == ENOSYS) {
+				haveBatchSyscalls = false;
+				break;
+			}
+
+			err = asio::error_code(errno, asio::error::get_system_category());
+			break;
+		}
+
+		for (int i = 0; i < batchSent; i++) {
+			numBytes += msgs[i].msg_len;
+		}
+
+		numDgrams += batchSent;
+	}
+	#endif
+
+	for (; !err && numDgrams < datagrams.size(); numDgrams++) {
+		const Datagram& dgram = datagrams[numDgrams];
+		asio::ip::udp::socket::message_flags msgFlags = 0;
+
+		numBytes += socket.send_to(asio::buffer(&buffer[dgram.offset], dgram.size), dgram.endpoint, msgFlags, err);
+
+		if (err)
+			break;
+	}
+
+	if (numSent != nullptr)
+		*numSent = numDgrams;
+
+	buffer.clear();
+	datagrams.clear();
+	return numBytes;
+}
+
+} // namespace netcode
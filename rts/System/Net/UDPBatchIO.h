@@ -0,0 +1,85 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _UDP_BATCH_IO_H
+#define _UDP_BATCH_IO_H
+
+#include <cinttypes>
+#include <vector>
+
+#include <asio/ip/udp.hpp>
+
+namespace netcode
+{
+
+/**
+ * @brief Fixed set of reusable receive slots for one UDP socket
+ * On Linux all slots are filled by a single recvmmsg call, elsewhere
+ * (or if the call is unsupported) by one receive_from per datagram.
+ * Datagrams stay valid until the next call to Receive, slot memory is
+ * only allocated once a ring is first used.
+ */
+class UDPReceiveRing
+{
+public:
+	static constexpr unsigned NUM_SLOTS = 64;
+	static constexpr unsigned SLOT_SIZE = 4096; // >= any MTU UDPConnection uses
+
+	struct Datagram {
+		asio::ip::udp::endpoint endpoint;
+
+		const std::uint8_t* data = nullptr;
+		unsigned int size = 0;
+	};
+
+public:
+	/**
+	 * @brief receive as many pending datagrams as there are slots, without blocking
+	 * @return number of datagrams received; fewer than NUM_SLOTS means the socket
+	 *         has been drained (or an error occurred, which is stored in err)
+	 */
+	unsigned int Receive(asio::ip::udp::socket& socket, asio::error_code& err);
+
+	const Datagram& operator [] (unsigned int i) const { return datagrams[i]; }
+
+private:
+	// heap-allocated, rings are embedded in every connection
+	std::vector<std::uint8_t> buffers;
+	std::vector<Datagram> datagrams;
+};
+
+
+/**
+ * @brief Queue of outgoing datagrams sent with as few syscalls as possible
+ * On Linux everything queued since the last Flush goes out through sendmmsg.
+ */
+class UDPSendBatch
+{
+public:
+	/// copies <data> to the end of the queue
+	void Add(const asio::ip::udp::endpoint& endpoint, const std::vector<std::uint8_t>& data);
+
+	/**
+	 * @brief send (and dequeue) all queued datagrams
+	 * Sending stops at the first error, the remaining datagrams are dropped
+	 * just as individual send_to calls would have dropped them.
+	 * @return number of bytes sent
+	 */
+	size_t Flush(asio::ip::udp::socket& socket, asio::error_code& err, unsigned int* numSent = nullptr);
+
+	bool Empty() const { return datagrams.empty(); }
+
+private:
+	struct Datagram {
+		asio::ip::udp::endpoint endpoint;
+
+		size_t offset;
+		size_t size;
+	};
+
+	std::vector<std::uint8_t> buffer;
+	std::vector<Datagram> datagrams;
+};
+
+} // namespace netcode
+
+#endif // _UDP_BATCH_IO_H
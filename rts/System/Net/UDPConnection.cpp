@@ -3,6 +3,7 @@
 #include "UDPConnection.h"
 
 #include <cinttypes>
+#include <cmath>
 
 
 #include "Socket.h"
@@ -26,7 +27,9 @@ using namespace asio;
 
 static constexpr unsigned udpMaxPacketSize = 4096;
 static constexpr int maxChunkSize = 254;
-static constexpr int chunksPerSec = 30;
+static constexpr int maxChunksPerSec = 30;
+// lower bound of the measured resend timeout, in milliseconds
+static constexpr int minResendTimeout = 30;
 
 
 
@@ -298,6 +301,7 @@ void UDPConnection::Init()
 	numTotalGetDataCalls = 0;
 	#endif
 	currentPacketChunkNum = 0;
+	outgoingOffset = 0;
 
 	lastNak = -1;
 	sentOverhead = 0;
@@ -310,6 +314,15 @@ void UDPConnection::Init()
 	mtu = globalConfig.mtu;
 	reconnectTime = globalConfig.reconnectTimeout;
 
+	timingStats.Reset();
+	lastFrameMsgRecvTime = spring_notime;
+	lastFrameMsgDelta = -1.0f;
+	maxRecvChunkNum = -1;
+
+	smoothedRoundTrip = -1.0f;
+	roundTripVariance = 0.0f;
+	resendBackoff = 0;
+
 	muted = true;
 	closed = false;
 	resend = false;
@@ -319,6 +332,7 @@ void UDPConnection::Init()
 	#endif
 
 	netLossFactor = globalConfig.networkLossFactor;
+	chunksPerSec = maxChunksPerSec;
 	lastMidChunk = -1;
 #if	NETWORK_TEST
 	lossCounter = 0;
@@ -350,6 +364,7 @@ void UDPConnection::SendData(std::shared_ptr<const RawPacket> pkt)
 {
 	assert(pkt->length > 0);
 	outgoingData.push_back(pkt);
+	outgoingTimes.push_back(spring_gettime());
 }
 
 std::shared_ptr<const RawPacket> UDPConnection::Peek(unsigned ahead) const
@@ -441,34 +456,32 @@ void UDPConnection::Update()
 		// duplicated code with UDPListener
 		netservice.poll();
 
-		size_t bytesAvailable = 0;
+		unsigned int numReceived = 0;
 
-		while ((bytesAvailable = mySocket->available()) > 0) {
-			recvBuffer.clear();
-			recvBuffer.resize(bytesAvailable, 0);
-
-			ip::udp::endpoint udpEndPoint;
-			ip::udp::socket::message_flags msgFlags = 0;
+		do {
 			asio::error_code err;
 
-			const size_t bytesReceived = mySocket->receive_from(asio::buffer(recvBuffer), udpEndPoint, msgFlags, err);
+			numReceived = recvRing.Receive(*mySocket, err);
 
-			if (CheckErrorCode(err))
-				break;
+			for (unsigned int n = 0; n < numReceived; n++) {
+				const UDPReceiveRing::Datagram& dgram = recvRing[n];
 
-			if (bytesReceived < Packet::headerSize)
-				continue;
+				if (dgram.size < Packet::headerSize)
+					continue;
 
-			Packet data(&recvBuffer[0], bytesReceived);
+				Packet data(dgram.data, dgram.size);
 
-			if (IsUsingAddress(udpEndPoint))
-				ProcessRawPacket(data);
+				if (IsUsingAddress(dgram.endpoint))
+					ProcessRawPacket(data);
+			}
+
+			if (CheckErrorCode(err))
+				break;
 
 			// not likely, but make sure we do not get stuck here
-			if ((spring_gettime() - curTime) > spring_msecs(10)) {
+			if ((spring_gettime() - curTime) > spring_msecs(10))
 				break;
-			}
-		}
+		} while (numReceived == UDPReceiveRing::NUM_SLOTS);
 	}
 
 
@@ -558,7 +571,8 @@ void UDPConnection::ProcessRawPacket(Packet& incoming)
 		if (-256 <= unAckDiff && unAckDiff <= 256) {
 			if (incoming.nakType < 0) {
 				for (int i = 0; i != -incoming.nakType; ++i) {
-					const int unAckPos = i + unAckDiff;
+					// unackedChunks[0] holds nextCont + unAckDiff
+					const int unAckPos = i - unAckDiff;
 
 					if (unAckPos >= 0 && unAckPos < unackedChunks.size()) {
 						assert(unackedChunks[unAckPos]->chunkNumber == nextCont + i);
@@ -569,10 +583,10 @@ void UDPConnection::ProcessRawPacket(Packet& incoming)
 				int unAckPos = 0;
 
 				for (int i = 0; i != incoming.naks.size(); ++i) {
-					if (unAckDiff + incoming.naks[i] < 0)
+					if (incoming.naks[i] - unAckDiff < 0)
 						continue;
 
-					while (unAckPos < (unAckDiff + incoming.naks[i])) {
+					while (unAckPos < (incoming.naks[i] - unAckDiff)) {
 						// if there are gaps in the array, assume that further resends are not needed
 						if (unAckPos < unackedChunks.size())
 							erasedResendChunks.insert(unackedChunks[unAckPos]->chunkNumber);
@@ -597,9 +611,13 @@ void UDPConnection::ProcessRawPacket(Packet& incoming)
 	for (const std::shared_ptr<netcode::Chunk>& c: incoming.chunks) {
 		if ((lastInOrder >= c->chunkNumber) || incomingChunkNums.find(c->chunkNumber) != incomingChunkNums.end()) {
 			++droppedChunks;
+			++timingStats.duplicateChunks;
 			continue;
 		}
 
+		timingStats.outOfOrderChunks += (c->chunkNumber < maxRecvChunkNum);
+		maxRecvChunkNum = std::max(maxRecvChunkNum, c->chunkNumber);
+
 		waitingPackets.emplace_back(c->chunkNumber, std::move(RawPacket(&c->data[0], c->data.size())));
 		incomingChunkNums.insert(c->chunkNumber);
 	}
@@ -647,6 +665,22 @@ void UDPConnection::ProcessRawPacket(Packet& incoming)
 				msgQueue.emplace_back(new RawPacket(bufp, pktLength));
 				std::shared_ptr<const RawPacket>& msgPacket = msgQueue.back();
 
+				if (msgPacket->data[0] == NETMSG_NEWFRAME || msgPacket->data[0] == NETMSG_KEYFRAME) {
+					const spring_time curTime = spring_gettime();
+
+					// jitter as in RFC 3550, the change between two consecutive intervals
+					if (spring_istime(lastFrameMsgRecvTime)) {
+						const float delta = (curTime - lastFrameMsgRecvTime).toMilliSecsf();
+
+						if (lastFrameMsgDelta >= 0.0f)
+							timingStats.frameJitter.Add(std::fabs(delta - lastFrameMsgDelta));
+
+						lastFrameMsgDelta = delta;
+					}
+
+					lastFrameMsgRecvTime = curTime;
+				}
+
 				#ifdef ENABLE_DEBUG_STATS
 				// server sends both of these, clients send only keyframe messages
 				// TODO: would be easy to feed this data into a Q3A-style lagometer
@@ -708,6 +742,9 @@ void UDPConnection::Flush(const bool forced)
 	int outgoingLength = 0;
 
 	if (!waitMore) {
+		// the front packet may already have been partially chunked
+		outgoingLength = -int(outgoingOffset);
+
 		for (auto pi = outgoingData.begin(); (pi != outgoingData.end()) && (outgoingLength <= requiredLength); ++pi) {
 			outgoingLength += (*pi)->length;
 		}
@@ -736,23 +773,27 @@ void UDPConnection::Flush(const bool forced)
 						__func__, ((packet->length > 0) ? (int)packet->data[0] : -1), packet->length
 					);
 					outgoingData.pop_front();
+					outgoingTimes.pop_front();
 				} else {
-					const unsigned numBytes = std::min((unsigned)maxChunkSize - pos, packet->length);
+					const unsigned numBytes = std::min((unsigned)maxChunkSize - pos, packet->length - outgoingOffset);
 
-					assert(packet->length > 0);
-					memcpy(buffer + pos, packet->data, numBytes);
+					assert(packet->length > outgoingOffset);
+					memcpy(buffer + pos, packet->data + outgoingOffset, numBytes);
 
 					pos += numBytes;
 					sentOverhead += Packet::headerSize;
 
 					outgoing.DataSent(numBytes, true);
 
-					if ((partialPacket = (numBytes != packet->length))) {
-						// partially transfered
-						packet.reset(new RawPacket(packet->data + numBytes, packet->length - numBytes));
-					} else {
+					// partially transfered packets are continued from
+					// their offset instead of copying the remainder
+					if (!(partialPacket = ((outgoingOffset += numBytes) != packet->length))) {
 						// full packet copied
+						timingStats.outgoingQueue.Add((curTime - outgoingTimes.front()).toMilliSecsf());
+
 						outgoingData.pop_front();
+						outgoingTimes.pop_front();
+						outgoingOffset = 0;
 					}
 				}
 			}
@@ -809,14 +850,27 @@ std::string UDPConnection::Statistics() const
 		"\t{%.3fx, %.3fx} relative protocol overhead {up, down}\n",
 		"\t%u incoming chunks dropped, %u outgoing chunks resent\n",
 		"\t%u incoming chunks processed\n",
+		"\t%u incoming chunks out of order, %.2f%% of outgoing chunks resent\n",
+		"\t%s p50 <%ums p95 <%ums max %.1fms (%u samples)\n",
+		"\tsmoothed round-trip %.1fms (variance %.1fms), resend timeout %ims\n",
 	};
 
+	const char* histNames[] = {"round-trip     ", "unacked-time   ", "outgoing-queue ", "frame-jitter   "};
+	const NetHistogram* hists[] = {&timingStats.roundTrip, &timingStats.unackedTime, &timingStats.outgoingQueue, &timingStats.frameJitter};
+
 	std::string msg = "[UDPConnection::Statistics]\n";
 	msg += spring::format(fmts[0], dataSent, sentPackets, spring::SafeDivide(dataSent * 1.0f, sentPackets * 1.0f));
 	msg += spring::format(fmts[1], dataRecv, recvPackets, spring::SafeDivide(dataRecv * 1.0f, recvPackets * 1.0f));
 	msg += spring::format(fmts[2], spring::SafeDivide(sentOverhead * 1.0f, dataSent * 1.0f), spring::SafeDivide(recvOverhead * 1.0f, dataRecv * 1.0f));
 	msg += spring::format(fmts[3], droppedChunks, resentChunks);
 	msg += spring::format(fmts[4], lastInOrder + 1);
+	msg += spring::format(fmts[5], timingStats.outOfOrderChunks, spring::SafeDivide(timingStats.resentChunks * 100.0f, timingStats.sentChunks * 1.0f));
+
+	for (size_t i = 0; i < (sizeof(hists) / sizeof(hists[0])); i++) {
+		msg += spring::format(fmts[6], histNames[i], hists[i]->GetPercentile(0.5f), hists[i]->GetPercentile(0.95f), hists[i]->GetMaxValue(), hists[i]->GetNumSamples());
+	}
+
+	msg += spring::format(fmts[7], smoothedRoundTrip, roundTripVariance, GetResendTimeout(spring_msecs(400 >> netLossFactor)).toMilliSecsi());
 	return msg;
 }
 
@@ -835,10 +889,10 @@ void UDPConnection::SetMTU(unsigned mtu2)
 void UDPConnection::CreateChunk(const unsigned char* data, const unsigned length, const int packetNum)
 {
 	assert((length > 0) && (length < 255));
-	ChunkPtr buf(new Chunk);
+	ChunkPtr buf = std::make_shared<Chunk>();
 	buf->chunkNumber = packetNum;
 	buf->chunkSize = length;
-	std::copy(data, data + length, std::back_inserter(buf->data));
+	buf->data.assign(data, data + length);
 	newChunks.push_back(buf);
 	lastChunkCreatedTime = spring_gettime();
 }
@@ -848,6 +902,7 @@ void UDPConnection::SendIfNecessary(bool flushed)
 	const spring_time curTime = spring_gettime();
 	const spring_time difTime = curTime - lastPacketSendTime;
 	const spring_time unackTime = spring_msecs(400 >> netLossFactor);
+	const spring_time resendTime = GetResendTimeout(unackTime);
 
 	int nak = 0;
 	int rev = 0;
@@ -881,7 +936,7 @@ void UDPConnection::SendIfNecessary(bool flushed)
 			numContinuous++;
 		}
 
-		if ((numContinuous < 8) && (curTime - lastNakTime) > (unackTime * 0.5f)) {
+		if ((numContinuous < 8) && (curTime - lastNakTime) > (resendTime * 0.5f)) {
 			nak = std::min(droppedPackets.size(), (size_t)127);
 			// needs 1 byte per requested packet, so do not spam to often
 			lastNakTime = curTime;
@@ -891,8 +946,8 @@ void UDPConnection::SendIfNecessary(bool flushed)
 	}
 
 	if (!unackedChunks.empty() &&
-		(curTime - lastChunkCreatedTime) > unackTime &&
-		(curTime - lastUnackResentTime) > unackTime) {
+		(curTime - lastChunkCreatedTime) > resendTime &&
+		(curTime - lastUnackResentTime) > resendTime) {
 
 		// resend last packet if we didn't get an ack within reasonable time
 		// and don't plan sending out a new chunk either
@@ -900,6 +955,7 @@ void UDPConnection::SendIfNecessary(bool flushed)
 			RequestResend(*unackedChunks.rbegin(), false);
 
 		lastUnackResentTime = curTime;
+		resendBackoff = std::min(resendBackoff + 1, 4);
 	}
 
 
@@ -981,6 +1037,8 @@ void UDPConnection::SendIfNecessary(bool flushed)
 			resend = !resend;
 
 			if (resend && canResend) {
+				const size_t numChunks = buf.chunks.size();
+
 				if (UseMinLossFactor()) {
 					if (erasedResendChunks.find(resFwdIter->first) == erasedResendChunks.end())
 						buf.chunks.push_back(resFwdIter->second);
@@ -1011,14 +1069,24 @@ void UDPConnection::SendIfNecessary(bool flushed)
 					rev = (rev + 1) % 4;
 				}
 
+				// resent chunks give ambiguous round-trip samples
+				if (buf.chunks.size() > numChunks)
+					buf.chunks.back()->resent = true;
+
 				resentChunks += 1;
 				maxResend -= 1;
 
+				timingStats.resentChunks += 1;
+
 				sent = true;
 			} else if (!resend && canSendNew) {
+				newChunks[0]->firstSendTime = spring_gettime();
+
 				buf.chunks.push_back(newChunks[0]);
 				unackedChunks.push_back(newChunks[0]);
 				newChunks.pop_front();
+
+				timingStats.sentChunks += 1;
 				sent = true;
 			}
 		}
@@ -1032,6 +1100,9 @@ void UDPConnection::SendIfNecessary(bool flushed)
 			break;
 	}
 
+	// everything assembled above goes out in one go
+	FlushSendBatch();
+
 
 	if (UseMinLossFactor()) {
 		UpdateResendRequests();
@@ -1053,23 +1124,46 @@ void UDPConnection::SendPacket(Packet& pkt)
 	outgoing.DataSent(sendBuffer.size());
 	lastPacketSendTime = spring_gettime();
 
+	#if NETWORK_TEST
 	ip::udp::socket::message_flags flags = 0;
 	asio::error_code err;
+	#endif
 
+	// queued until FlushSendBatch
 	EMULATE_LATENCY( !EMULATE_PACKET_LOSS( LOSS_COUNTER ) ) {
-		mySocket->send_to(buffer(sendBuffer), addr, flags, err);
+		sendBatch.Add(addr, sendBuffer);
 	}
+}
 
-	if (CheckErrorCode(err))
+void UDPConnection::FlushSendBatch()
+{
+	if (sendBatch.Empty())
 		return;
 
-	dataSent += sendBuffer.size();
-	sentPackets += 1;
+	asio::error_code err;
+	unsigned int numSent = 0;
+
+	dataSent += sendBatch.Flush(*mySocket, err, &numSent);
+	sentPackets += numSent;
+
+	CheckErrorCode(err);
 }
 
 void UDPConnection::AckChunks(int lastAck)
 {
+	const spring_time curTime = spring_gettime();
+
 	while (!unackedChunks.empty() && (lastAck >= (*unackedChunks.begin())->chunkNumber)) {
+		const Chunk& chunk = *unackedChunks.front();
+		const float ackTime = (curTime - chunk.firstSendTime).toMilliSecsf();
+
+		timingStats.unackedTime.Add(ackTime);
+
+		if (!chunk.resent) {
+			timingStats.roundTrip.Add(ackTime);
+			UpdateRoundTrip(ackTime);
+		}
+
 		unackedChunks.pop_front();
 	}
 
@@ -1082,6 +1176,31 @@ void UDPConnection::AckChunks(int lastAck)
 	}
 }
 
+void UDPConnection::UpdateRoundTrip(float rtt)
+{
+	if (smoothedRoundTrip < 0.0f) {
+		smoothedRoundTrip = rtt;
+		roundTripVariance = rtt * 0.5f;
+	} else {
+		roundTripVariance = roundTripVariance * 0.75f + std::fabs(smoothedRoundTrip - rtt) * 0.25f;
+		smoothedRoundTrip = smoothedRoundTrip * 0.875f + rtt * 0.125f;
+	}
+
+	resendBackoff = 0;
+}
+
+spring_time UDPConnection::GetResendTimeout(spring_time maxTime) const
+{
+	// fixed timeout until measured; never waits longer than that either,
+	// those are tuned for the worst links and bound the backoff
+	if (smoothedRoundTrip < 0.0f)
+		return maxTime;
+
+	const float timeout = (smoothedRoundTrip + roundTripVariance * 4.0f) * (1 << resendBackoff);
+
+	return std::min(spring_msecs(std::max(timeout, float(minResendTimeout))), maxTime);
+}
+
 void UDPConnection::RequestResend(ChunkPtr ptr, bool noSort)
 {
 	resendRequested.emplace_back(ptr->chunkNumber, ptr);
@@ -1142,6 +1261,12 @@ void UDPConnection::Close(bool flush) {
 	closed = true;
 }
 
+void UDPConnection::SetChunksPerSec(int rate) {
+	chunksPerSec = rate;
+	chunksPerSec = std::max(chunksPerSec, 1);
+	chunksPerSec = std::min(chunksPerSec, maxChunksPerSec);
+}
+
 void UDPConnection::SetLossFactor(int factor) {
 	netLossFactor = factor;
 	netLossFactor = std::max(netLossFactor, int(MIN_LOSS_FACTOR));
@@ -8,6 +8,7 @@
 #include <deque>
 
 #include "Connection.h"
+#include "UDPBatchIO.h"
 #include "System/Misc/SpringTime.h"
 #include "System/UnorderedSet.hpp"
 
@@ -36,6 +37,10 @@ public:
 	std::int32_t chunkNumber;
 	std::uint8_t chunkSize;
 	std::vector<std::uint8_t> data;
+
+	/// when first handed to the socket, zero until then
+	spring_time firstSendTime;
+	bool resent = false;
 };
 typedef std::shared_ptr<Chunk> ChunkPtr;
 
@@ -108,6 +113,7 @@ public:
 	unsigned int GetPacketQueueSize() const override { return msgQueue.size(); }
 
 	std::string Statistics() const override;
+	const NetTimingStats* GetTimingStats() const override { return &timingStats; }
 	std::string GetFullAddress() const override;
 
 	void Update() override;
@@ -131,6 +137,7 @@ public:
 	void Unmute() override { muted = false; }
 	void Close(bool flush) override;
 	void SetLossFactor(int factor) override;
+	void SetChunksPerSec(int rate) override;
 
 	const asio::ip::udp::endpoint& GetEndpoint() const { return addr; }
 
@@ -149,8 +156,14 @@ private:
 	void SendIfNecessary(bool flushed);
 	void AckChunks(int lastAck);
 
+	/// RFC 6298 smoothing of unambiguous round-trip samples
+	void UpdateRoundTrip(float rtt);
+	/// how long to wait for an ack before resending, at most maxTime
+	spring_time GetResendTimeout(spring_time maxTime) const;
+
 	void RequestResend(ChunkPtr ptr, bool noSort);
 	void SendPacket(Packet& pkt);
+	void FlushSendBatch();
 
 	void UpdateWaitingPackets();
 	void UpdateResendRequests();
@@ -182,9 +195,14 @@ private:
 
 	int netLossFactor;
 	int reconnectTime;
+	int chunksPerSec;
 
 	/// outgoing stuff (pure data without header) waiting to be sent
 	std::deque< std::shared_ptr<const RawPacket> > outgoingData;
+	/// time each packet in outgoingData was enqueued
+	std::deque<spring_time> outgoingTimes;
+	/// number of bytes of the front packet already turned into chunks
+	unsigned int outgoingOffset;
 	/// packets we have received but not yet read
 	std::vector< std::pair<int, RawPacket> > waitingPackets;
 	spring::unordered_set<int> incomingChunkNums;
@@ -203,7 +221,11 @@ private:
 	std::deque< std::shared_ptr<const RawPacket> > msgQueue;
 
 	std::vector<std::uint8_t> sendBuffer;
-	std::vector<std::uint8_t> recvBuffer;
+
+	/// packets serialized by SendIfNecessary, sent in one batch
+	UDPSendBatch sendBatch;
+	/// datagrams received by the last batch (own socket only)
+	UDPReceiveRing recvRing;
 	std::vector<std::uint8_t> waitBuffer;
 
 	std::vector<int> droppedPackets;
@@ -261,6 +283,17 @@ private:
 	};
 
 	BandwidthUsage outgoing;
+
+	NetTimingStats timingStats;
+	spring_time lastFrameMsgRecvTime;
+	float lastFrameMsgDelta;
+	std::int32_t maxRecvChunkNum;
+
+	/// in milliseconds, negative until the first sample
+	float smoothedRoundTrip;
+	float roundTripVariance;
+	/// doublings of the resend timeout since the last fresh sample
+	int resendBackoff;
 };
 
 } // namespace netcode
@@ -3,6 +3,7 @@
 #ifndef _UDP_LISTENER_H
 #define _UDP_LISTENER_H
 
+#include "UDPBatchIO.h"
 #include "System/Misc/NonCopyable.h"
 #include <memory>
 #include <asio/ip/udp.hpp>
@@ -75,6 +76,10 @@ public:
 	void RejectConnection() { waiting.pop(); }
 	void UpdateConnections(); // Updates connections when the endpoint has been reconnected
 
+private:
+	/// hand a received datagram to its connection, or open a new one
+	void ProcessDatagram(const UDPReceiveRing::Datagram& dgram);
+
 private:
 	/**
 	 * @brief Do we accept packets from unknown sources?
@@ -85,7 +90,8 @@ private:
 	/// socket being listened on
 	std::shared_ptr<asio::ip::udp::socket> socket;
 
-	std::vector<std::uint8_t> recvBuffer;
+	/// datagrams received by the last batch
+	UDPReceiveRing recvRing;
 
 	/// all connections
 	std::map< asio::ip::udp::endpoint, std::weak_ptr<UDPConnection> > connMap;
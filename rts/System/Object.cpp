@@ -3,7 +3,6 @@
 
 #include "System/Object.h"
 #include "System/ContainerUtil.h"
-#include "System/creg/STL_Map.h"
 #include "System/Log/ILog.h"
 #include "System/Platform/CrashHandler.h"
 
@@ -46,6 +45,9 @@ CObject::CObject() : detached(false)
 	sync_id = ++cur_sync_id;
 
 	assert((sync_id + 1) > sync_id); // check for overflow
+
+	listenersDepTbl.fill(-1);
+	listeningDepTbl.fill(-1);
 }
 
 
@@ -54,33 +56,33 @@ CObject::~CObject()
 	assert(!detached);
 	detached = true;
 
-	for (const auto& p: listenersDepTbl) {
-		assert(p.first >= DEPENDENCE_ATTACKER && p.first < DEPENDENCE_COUNT);
-		assert(p.second < listeners.size());
+	for (int dep = DEPENDENCE_ATTACKER; dep < DEPENDENCE_COUNT; dep++) {
+		if (listenersDepTbl[dep] < 0)
+			continue;
 
-		for (CObject* obj: listeners[p.second]) {
-			obj->DependentDied(this);
+		assert(listenersDepTbl[dep] < listeners.size());
 
-			const auto jt = obj->listeningDepTbl.find(p.first);
+		for (CObject* obj: listeners[ listenersDepTbl[dep] ]) {
+			obj->DependentDied(this);
 
-			if (jt == obj->listeningDepTbl.end())
+			if (obj->listeningDepTbl[dep] < 0)
 				continue;
 
-			VectorEraseSorted(obj->listening[ jt->second ], this);
+			VectorEraseSorted(obj->listening[ obj->listeningDepTbl[dep] ], this);
 		}
 	}
 
-	for (const auto& p: listeningDepTbl) {
-		assert(p.first >= DEPENDENCE_ATTACKER && p.first < DEPENDENCE_COUNT);
-		assert(p.second < listening.size());
+	for (int dep = DEPENDENCE_ATTACKER; dep < DEPENDENCE_COUNT; dep++) {
+		if (listeningDepTbl[dep] < 0)
+			continue;
 
-		for (CObject* obj: listening[p.second]) {
-			const auto jt = obj->listenersDepTbl.find(p.first);
+		assert(listeningDepTbl[dep] < listening.size());
 
-			if (jt == obj->listenersDepTbl.end())
+		for (CObject* obj: listening[ listeningDepTbl[dep] ]) {
+			if (obj->listenersDepTbl[dep] < 0)
 				continue;
 
-			VectorEraseSorted(obj->listeners[ jt->second ], this);
+			VectorEraseSorted(obj->listeners[ obj->listenersDepTbl[dep] ], this);
 		}
 	}
 }
@@ -111,10 +113,10 @@ void CObject::DeleteDeathDependence(CObject* obj, DependenceType dep)
 	if (detached || obj->detached)
 		return;
 
-	const auto it =      listeningDepTbl.find(dep);
-	const auto jt = obj->listenersDepTbl.find(dep);
+	const int i =      listeningDepTbl[dep];
+	const int j = obj->listenersDepTbl[dep];
 
-	if (it !=      listeningDepTbl.end()) VectorEraseSorted(     listening[ it->second ],  obj);
-	if (jt != obj->listenersDepTbl.end()) VectorEraseSorted(obj->listeners[ jt->second ], this);
+	if (i >= 0) VectorEraseSorted(     listening[i],  obj);
+	if (j >= 0) VectorEraseSorted(obj->listeners[j], this);
 }
 
@@ -3,7 +3,9 @@
 #ifndef OBJECT_H
 #define OBJECT_H
 
+#include <array>
 #include <atomic>
+#include <cstdint>
 #include <functional>
 #include <vector>
 
@@ -82,26 +84,20 @@ public:
 
 protected:
 	const TSyncSafeSet& GetListeners(const DependenceType dep) {
-		const auto it = listenersDepTbl.find(dep);
-
-		if (it == listenersDepTbl.end()) {
+		if (listenersDepTbl[dep] < 0) {
+			listenersDepTbl[dep] = listeners.size();
 			listeners.emplace_back();
-			listenersDepTbl[dep] = listeners.size() - 1;
-			return (listeners.back());
 		}
 
-		return (listeners[it->second]);
+		return (listeners[ listenersDepTbl[dep] ]);
 	}
 	const TSyncSafeSet& GetListening(const DependenceType dep) {
-		const auto it = listeningDepTbl.find(dep);
-
-		if (it == listeningDepTbl.end()) {
+		if (listeningDepTbl[dep] < 0) {
+			listeningDepTbl[dep] = listening.size();
 			listening.emplace_back();
-			listeningDepTbl[dep] = listening.size() - 1;
-			return (listening.back());
 		}
 
-		return (listening[it->second]);
+		return (listening[ listeningDepTbl[dep] ]);
 	}
 
 	const TDependenceMap& GetAllListeners() const { return listeners; }
@@ -125,8 +121,11 @@ protected:
 	template<size_t N> void FilterListening(const TObjFilterPred& fp, std::array<int, N>& ids) const { FilterDepObjects(listening, fp, ids); }
 
 protected:
-	spring::unordered_map<int, size_t> listenersDepTbl; // maps dependence-type to index into listeners
-	spring::unordered_map<int, size_t> listeningDepTbl; // maps dependence-type to index into listening
+	// map dependence-type to index into listeners or listening, -1 if none
+	// (fixed tables, objects are created and destroyed far too often for
+	// a pair of hash-maps each)
+	std::array<std::int8_t, DEPENDENCE_COUNT> listenersDepTbl;
+	std::array<std::int8_t, DEPENDENCE_COUNT> listeningDepTbl;
 
 	TDependenceMap listeners;
 	TDependenceMap listening;
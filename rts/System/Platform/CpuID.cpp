@@ -82,7 +82,8 @@ namespace springproc {
 
 
 	CPUID::CPUID()
-		: shiftCore(0)
+		: maskOfPerformanceCores(0)
+		, shiftCore(0)
 		, shiftPackage(0)
 
 		, maskVirtual(0)
@@ -260,12 +261,31 @@ namespace springproc {
 	{
 		const auto oldAffinity = Threading::GetAffinity();
 
+		uint32_t regs[REG_CNT] = {0, 0, 0, 0};
+		ExecCPUID(&regs[REG_EAX], &regs[REG_EBX], &regs[REG_ECX], &regs[REG_EDX]);
+
+		bool isHybrid = false;
+
+		// CPUID.07H:EDX[15] flags a hybrid part, leaf 1AH then gives the per-core type
+		if (regs[REG_EAX] >= 0x1A) {
+			regs[REG_EAX] = 7;
+			regs[REG_ECX] = 0;
+			ExecCPUID(&regs[REG_EAX], &regs[REG_EBX], &regs[REG_ECX], &regs[REG_EDX]);
+			isHybrid = ((regs[REG_EDX] >> 15) & 1) != 0;
+		}
+
 		for (int processor = 0; processor < numLogicalCores; processor++) {
 			Threading::SetAffinity(1u << processor, true);
 			spring::this_thread::yield();
 			processorApicIds[processor] = GetApicIdIntel();
+
+			if (isHybrid && GetCoreTypeIntel() == 0x40)
+				maskOfPerformanceCores |= (1lu << processor);
 		}
 
+		if (maskOfPerformanceCores != 0)
+			LOG("[CpuId] hybrid CPU, performance-core mask: 0x%llx", static_cast<unsigned long long>(maskOfPerformanceCores));
+
 		spring::unordered_set<uint32_t> cores;
 		spring::unordered_set<uint32_t> packages;
 
@@ -308,6 +328,15 @@ namespace springproc {
 		return (regs[REG_EBX] >> 24);
 	}
 
+	uint32_t CPUID::GetCoreTypeIntel()
+	{
+		// 0x20 := Atom (efficiency), 0x40 := Core (performance)
+		uint32_t regs[REG_CNT] = {0x1A, 0, 0, 0};
+
+		ExecCPUID(&regs[REG_EAX], &regs[REG_EBX], &regs[REG_ECX], &regs[REG_EDX]);
+		return (regs[REG_EAX] >> 24);
+	}
+
 	void CPUID::GetIdsAMD()
 	{
 		#pragma message ("TODO")
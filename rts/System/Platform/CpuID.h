@@ -50,6 +50,10 @@ namespace springproc {
 		uint64_t GetCoreAffinityMask(int x) const { return affinityMaskOfCores[x & (MAX_PROCESSORS - 1)]; }
 		uint64_t GetPackageAffinityMask(int x) { return affinityMaskOfPackages[x & (MAX_PROCESSORS - 1)]; }
 
+		/** Logical processors that are performance cores on a hybrid CPU
+		    (e.g. Alder Lake), 0 if all cores are of the same type. */
+		uint64_t GetPerformanceCoresMask() const { return maskOfPerformanceCores; }
+
 	private:
 		void GetIdsAMD();
 		void GetIdsIntel();
@@ -63,6 +67,7 @@ namespace springproc {
 		void GetMasksIntelLeaf1and4();
 
 		uint32_t GetApicIdIntel();
+		uint32_t GetCoreTypeIntel();
 
 	private:
 		int numLogicalCores;
@@ -76,6 +81,8 @@ namespace springproc {
 		uint64_t affinityMaskOfCores[MAX_PROCESSORS];
 		uint64_t affinityMaskOfPackages[MAX_PROCESSORS];
 
+		uint64_t maskOfPerformanceCores;
+
 		////////////////////////
 		// Intel specific fields
 
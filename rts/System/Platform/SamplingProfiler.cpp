@@ -0,0 +1,398 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "SamplingProfiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "System/Config/ConfigHandler.h"
+#include "System/Log/ILog.h"
+#include "System/Threading/SpringThreading.h"
+#include "System/UnorderedMap.hpp"
+
+#if defined(__linux__)
+	#include <cerrno>
+	#include <cxxabi.h>
+	#include <execinfo.h>
+	#include <pthread.h>
+	#include <signal.h>
+	#include <time.h>
+	#include <unistd.h>
+	#include <sys/syscall.h>
+
+	// older glibc versions only expose the raw union member
+	#ifndef sigev_notify_thread_id
+	#define sigev_notify_thread_id _sigev_un._tid
+	#endif
+#endif
+
+CONFIG(int, SamplingProfilerThreshold).defaultValue(0).minimumValue(0)
+		.description("Frame time in milliseconds above which the call-stacks sampled during that frame are written to SamplingProfile-*.txt (Linux only); 0 disables the sampling profiler.");
+CONFIG(int, SamplingProfilerRate).defaultValue(1000).minimumValue(100).maximumValue(4000)
+		.description("Number of call-stack samples per second taken from each thread by the sampling profiler.");
+
+namespace SamplingProfiler
+{
+#if defined(__linux__)
+	static constexpr unsigned int MAX_THREADS = 4;
+	static constexpr unsigned int MAX_DEPTH = 48;
+	// power of two, covers one to four seconds per thread
+	static constexpr unsigned int NUM_SAMPLES = 4096;
+	static constexpr unsigned int MAX_DUMPS = 16;
+
+	// a hitch is often several long frames in a row, only dump the first
+	static constexpr int64_t MIN_DUMP_INTERVAL = 10 * 1000 * 1000 * 1000LL;
+
+	// innermost frames of each stack are the handler and the signal trampoline
+	static constexpr int NUM_HANDLER_FRAMES = 2;
+
+	struct Sample {
+		int64_t time;
+		int numFrames;
+		void* frames[MAX_DEPTH];
+	};
+
+	struct ThreadSamples {
+		std::vector<Sample> samples;
+		std::atomic<unsigned int> sampleIdx = {0};
+		std::atomic<bool> active = {false};
+
+		timer_t timer = {};
+		pid_t tid = 0;
+
+		char name[32] = {0};
+	};
+
+	static ThreadSamples threadSamples[MAX_THREADS];
+	static spring::mutex regMutex;
+
+	static int64_t frameThreshold = 0;
+	static int64_t lastBoundary = 0;
+	static int64_t lastDumpTime = 0;
+
+	static int samplingRate = 0;
+	static unsigned int numDumps = 0;
+
+	static bool installed = false;
+
+
+	static int64_t GetMonotonicTime()
+	{
+		timespec ts;
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (int64_t(ts.tv_sec) * 1000000000LL + ts.tv_nsec);
+	}
+
+	// only async-signal-safe calls in here; backtrace was primed in Install
+	static void SampleHandler(int signum, siginfo_t* info, void* pCtx)
+	{
+		const int savedErrno = errno;
+		const int idx = info->si_value.sival_int;
+
+		if (idx >= 0 && idx < int(MAX_THREADS)) {
+			ThreadSamples& ts = threadSamples[idx];
+
+			if (ts.active.load(std::memory_order_relaxed)) {
+				Sample& s = ts.samples[ts.sampleIdx.load(std::memory_order_relaxed) & (NUM_SAMPLES - 1)];
+
+				s.time = GetMonotonicTime();
+				s.numFrames = backtrace(s.frames, MAX_DEPTH);
+
+				ts.sampleIdx.fetch_add(1, std::memory_order_release);
+			}
+		}
+
+		errno = savedErrno;
+	}
+
+
+	static const std::string& Symbolize(void* addr, spring::unordered_map<void*, std::string>& symbols)
+	{
+		const auto it = symbols.find(addr);
+
+		if (it != symbols.end())
+			return it->second;
+
+		std::string& symbol = symbols[addr];
+		char** lines = backtrace_symbols(&addr, 1);
+
+		// "module(mangled+0x1f) [0xaddr]", or "module(+0x1234) [0xaddr]"
+		// without a dynamic symbol; the latter is kept as module+offset
+		// which addr2line can resolve against the matching debug-symbols
+		const char* line = (lines != nullptr)? lines[0]: "";
+		const char* beg = strchr(line, '(');
+		const char* end = (beg != nullptr)? strchr(beg, ')'): nullptr;
+		const char* ofs = (beg != nullptr)? strchr(beg, '+'): nullptr;
+
+		if (beg != nullptr && end != nullptr && ofs != nullptr && ofs < end) {
+			if (ofs > (beg + 1)) {
+				const std::string mangled(beg + 1, ofs);
+
+				int status = 0;
+				char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+
+				symbol = (status == 0 && demangled != nullptr)? demangled: mangled;
+				free(demangled);
+			} else {
+				const char* mod = strrchr(line, '/');
+
+				symbol.assign((mod != nullptr && mod < beg)? (mod + 1): line, beg);
+				symbol.append(ofs, end);
+			}
+		} else {
+			char buf[32];
+			snprintf(buf, sizeof(buf), "%p", addr);
+			symbol = buf;
+		}
+
+		free(lines);
+		return symbol;
+	}
+
+	static void Dump(int frameNum, int64_t frameStart, int64_t frameEnd)
+	{
+		sigset_t sigSet;
+		sigset_t oldSet;
+
+		// keep this thread's own handler from writing into the ring while it is read
+		sigemptyset(&sigSet);
+		sigaddset(&sigSet, SIGPROF);
+		pthread_sigmask(SIG_BLOCK, &sigSet, &oldSet);
+
+		spring::unordered_map<void*, std::string> symbols;
+		spring::unordered_map<std::string, unsigned int> stacks;
+
+		unsigned int numSamples = 0;
+
+		for (ThreadSamples& ts: threadSamples) {
+			if (!ts.active.load())
+				continue;
+
+			const unsigned int idxEnd = ts.sampleIdx.load(std::memory_order_acquire);
+			const unsigned int idxBeg = idxEnd - std::min(idxEnd, NUM_SAMPLES);
+
+			for (unsigned int i = idxBeg; i != idxEnd; i++) {
+				const Sample& s = ts.samples[i & (NUM_SAMPLES - 1)];
+
+				if (s.time < frameStart || s.time > frameEnd)
+					continue;
+
+				// collapsed stacks are written root first
+				std::string stack = ts.name;
+
+				for (int f = s.numFrames - 1; f >= NUM_HANDLER_FRAMES; f--) {
+					stack += ';';
+					stack += Symbolize(s.frames[f], symbols);
+				}
+
+				stacks[stack] += 1;
+				numSamples += 1;
+			}
+		}
+
+		pthread_sigmask(SIG_SETMASK, &oldSet, nullptr);
+
+		const int frameTime = (frameEnd - frameStart) / (1000 * 1000);
+
+		char name[128];
+		snprintf(name, sizeof(name), "SamplingProfile-[%d]-%dms.txt", frameNum, frameTime);
+
+		FILE* out = fopen(name, "wt");
+
+		if (out == nullptr) {
+			LOG_L(L_ERROR, "[SamplingProfiler::%s] could not open \"%s\"", __func__, name);
+			return;
+		}
+
+		for (const auto& p: stacks) {
+			fprintf(out, "%s %u\n", p.first.c_str(), p.second);
+		}
+
+		fclose(out);
+
+		LOG_L(L_WARNING, "[SamplingProfiler::%s] frame %d took %dms, wrote %u samples (%u stacks) to \"%s\"", __func__, frameNum, frameTime, numSamples, static_cast<unsigned int>(stacks.size()), name);
+	}
+
+
+	void Install()
+	{
+		frameThreshold = configHandler->GetInt("SamplingProfilerThreshold") * 1000LL * 1000LL;
+		samplingRate = configHandler->GetInt("SamplingProfilerRate");
+
+		if (frameThreshold <= 0)
+			return;
+
+		{
+			// the first call loads libgcc, which is not async-signal-safe
+			void* frames[1];
+			backtrace(frames, 1);
+		}
+
+		struct sigaction sa;
+
+		memset(&sa, 0, sizeof(sa));
+		sigemptyset(&sa.sa_mask);
+
+		sa.sa_sigaction = SampleHandler;
+		sa.sa_flags = SA_SIGINFO | SA_RESTART;
+
+		if (sigaction(SIGPROF, &sa, nullptr) != 0) {
+			LOG_L(L_WARNING, "[SamplingProfiler::%s] could not install SIGPROF handler (errno=%d)", __func__, errno);
+			return;
+		}
+
+		installed = true;
+		numDumps = 0;
+		lastDumpTime = 0;
+		lastBoundary = GetMonotonicTime();
+
+		LOG("[SamplingProfiler::%s] sampling at %dHz, dumping frames longer than %dms", __func__, samplingRate, int(frameThreshold / (1000 * 1000)));
+	}
+
+	void Uninstall()
+	{
+		if (!installed)
+			return;
+
+		{
+			std::lock_guard<spring::mutex> lock(regMutex);
+
+			for (ThreadSamples& ts: threadSamples) {
+				if (ts.tid == 0)
+					continue;
+
+				ts.active.store(false);
+				timer_delete(ts.timer);
+				ts.tid = 0;
+			}
+		}
+
+		// not SIG_DFL, a signal still in flight would terminate the process
+		signal(SIGPROF, SIG_IGN);
+
+		installed = false;
+	}
+
+
+	bool RegisterThread(const char* name)
+	{
+		if (!installed)
+			return false;
+
+		std::lock_guard<spring::mutex> lock(regMutex);
+
+		const pid_t tid = syscall(SYS_gettid);
+
+		for (unsigned int idx = 0; idx < MAX_THREADS; idx++) {
+			ThreadSamples& ts = threadSamples[idx];
+
+			if (ts.tid != 0)
+				continue;
+
+			ts.samples.resize(NUM_SAMPLES);
+			ts.sampleIdx.store(0);
+
+			strncpy(ts.name, name, sizeof(ts.name) - 1);
+
+			sigevent sev;
+			memset(&sev, 0, sizeof(sev));
+
+			sev.sigev_notify = SIGEV_THREAD_ID;
+			sev.sigev_signo = SIGPROF;
+			sev.sigev_value.sival_int = idx;
+			sev.sigev_notify_thread_id = tid;
+
+			// wall-clock, so time spent blocked shows up under the waiting call;
+			// CPU-time clocks are only checked on scheduler ticks, too coarse
+			if (timer_create(CLOCK_MONOTONIC, &sev, &ts.timer) != 0) {
+				LOG_L(L_WARNING, "[SamplingProfiler::%s] could not create timer for thread \"%s\" (errno=%d)", __func__, name, errno);
+				return false;
+			}
+
+			const long interval = 1000000000L / samplingRate;
+
+			itimerspec its;
+			its.it_interval.tv_sec = 0;
+			its.it_interval.tv_nsec = interval;
+			its.it_value = its.it_interval;
+
+			ts.tid = tid;
+			ts.active.store(true);
+
+			timer_settime(ts.timer, 0, &its, nullptr);
+			return true;
+		}
+
+		LOG_L(L_WARNING, "[SamplingProfiler::%s] no slot left for thread \"%s\"", __func__, name);
+		return false;
+	}
+
+	void DeregisterThread()
+	{
+		if (!installed)
+			return;
+
+		std::lock_guard<spring::mutex> lock(regMutex);
+
+		const pid_t tid = syscall(SYS_gettid);
+
+		for (ThreadSamples& ts: threadSamples) {
+			if (ts.tid != tid)
+				continue;
+
+			ts.active.store(false);
+			timer_delete(ts.timer);
+			ts.tid = 0;
+			return;
+		}
+	}
+
+
+	void FrameBoundary(int frameNum)
+	{
+		if (!installed)
+			return;
+
+		const int64_t frameEnd = GetMonotonicTime();
+		const int64_t frameStart = lastBoundary;
+
+		lastBoundary = frameEnd;
+
+		if ((frameEnd - frameStart) < frameThreshold)
+			return;
+		if (numDumps >= MAX_DUMPS)
+			return;
+		if (lastDumpTime != 0 && (frameEnd - lastDumpTime) < MIN_DUMP_INTERVAL)
+			return;
+
+		numDumps += 1;
+		lastDumpTime = frameEnd;
+
+		Dump(frameNum, frameStart, frameEnd);
+
+		// symbolizing and writing must not count towards the next frame
+		lastBoundary = GetMonotonicTime();
+	}
+
+	bool IsInstalled() { return installed; }
+
+#else
+
+	void Install() {}
+	void Uninstall() {}
+
+	bool RegisterThread(const char* name) { return false; }
+	void DeregisterThread() {}
+
+	void FrameBoundary(int frameNum) {}
+
+	bool IsInstalled() { return false; }
+
+#endif
+}
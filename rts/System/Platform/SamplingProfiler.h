@@ -0,0 +1,33 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef _SAMPLING_PROFILER_H
+#define _SAMPLING_PROFILER_H
+
+/**
+ * Statistical profiler for intermittent long frames.
+ *
+ * While installed (SamplingProfilerThreshold > 0, Linux only) every
+ * registered thread is interrupted SamplingProfilerRate times per second
+ * by a per-thread timer signal whose handler copies the raw call-stack into
+ * a ring buffer. Nothing else happens until a frame takes longer than the
+ * threshold; then the samples that fall inside that frame are symbolized
+ * and written as collapsed stacks (one "thread;outer;...;inner count" line
+ * each, the input format of flamegraph.pl and speedscope).
+ */
+namespace SamplingProfiler
+{
+	void Install();
+	void Uninstall();
+
+	// call these in the threads you want to sample
+	bool RegisterThread(const char* name);
+	void DeregisterThread();
+
+	// call once per frame from the main loop; dumps the samples of the
+	// frame that just ended if it exceeded the threshold
+	void FrameBoundary(int frameNum);
+
+	bool IsInstalled();
+}
+
+#endif // _SAMPLING_PROFILER_H
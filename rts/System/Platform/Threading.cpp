@@ -199,9 +199,17 @@ namespace Threading {
 	/** Function that returns the number of real cpu cores (not
 	    hyperthreading ones). These are the total cores in the system
 	    (across all existing processors, if more than one)*/
-	int GetPhysicalCpuCores() {
+	static const springproc::CPUID& GetCPUID() {
 		static springproc::CPUID cpuid;
-		return cpuid.GetNumPhysicalCores();
+		return cpuid;
+	}
+
+	int GetPhysicalCpuCores() {
+		return GetCPUID().GetNumPhysicalCores();
+	}
+
+	std::uint32_t GetPerformanceCoresMask() {
+		return static_cast<std::uint32_t>(GetCPUID().GetPerformanceCoresMask());
 	}
 
 	bool HasHyperThreading() { return (GetLogicalCpuCores() > GetPhysicalCpuCores()); }
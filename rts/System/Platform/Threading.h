@@ -116,6 +116,8 @@ namespace Threading {
 	std::uint32_t SetAffinity(std::uint32_t cores_bitmask, bool hard = true);
 	void SetAffinityHelper(const char* threadName, std::uint32_t affinity);
 	std::uint32_t GetAvailableCoresMask();
+	/// performance cores of a hybrid CPU, 0 if unknown or not hybrid
+	std::uint32_t GetPerformanceCoresMask();
 
 	/**
 	 * returns count of cpu cores/ hyperthreadings cores
@@ -60,10 +60,15 @@ struct SRectangle {
 	}
 
 	bool operator< (const SRectangle& other) const {
-		if (x1 == other.x1)
+		// total order, so sorting does not depend on the std::sort implementation
+		if (x1 != other.x1)
+			return (x1 < other.x1);
+		if (z1 != other.z1)
 			return (z1 < other.z1);
+		if (x2 != other.x2)
+			return (x2 < other.x2);
 
-		return (x1 < other.x1);
+		return (z2 < other.z2);
 	}
 
 	template<typename T>
@@ -0,0 +1,93 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef SMALL_VECTOR_MAP_H
+#define SMALL_VECTOR_MAP_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace spring {
+	/**
+	 * Map for containers that only ever hold a handful of entries, e.g. the
+	 * loopback and AI links of a player. Entries are stored unsorted in a
+	 * vector and looked up by linear search, which for small sizes works out
+	 * cheaper than hashing and keeps everything in one or two cache lines.
+	 * Erasing moves the last entry into the hole and invalidates iterators.
+	 */
+	template<typename K, typename V>
+	class SmallVectorMap {
+	public:
+		typedef std::pair<K, V> value_type;
+		typedef typename std::vector<value_type>::iterator iterator;
+		typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+		iterator begin() { return entries.begin(); }
+		iterator end() { return entries.end(); }
+		const_iterator begin() const { return entries.cbegin(); }
+		const_iterator end() const { return entries.cend(); }
+
+		size_t size() const { return entries.size(); }
+		bool empty() const { return entries.empty(); }
+
+		void reserve(size_t n) { entries.reserve(n); }
+		void clear() { entries.clear(); }
+
+		iterator find(const K& key) {
+			iterator it = entries.begin();
+
+			for (; it != entries.end() && it->first != key; ++it) {
+			}
+
+			return it;
+		}
+		const_iterator find(const K& key) const {
+			const_iterator it = entries.cbegin();
+
+			for (; it != entries.cend() && it->first != key; ++it) {
+			}
+
+			return it;
+		}
+
+		size_t count(const K& key) const { return (find(key) != end()); }
+
+		V& operator [] (const K& key) {
+			const iterator it = find(key);
+
+			if (it != end())
+				return it->second;
+
+			entries.emplace_back(key, V());
+			return entries.back().second;
+		}
+
+		std::pair<iterator, bool> insert(const value_type& kv) {
+			const iterator it = find(kv.first);
+
+			if (it != end())
+				return {it, false};
+
+			entries.push_back(kv);
+			return {entries.end() - 1, true};
+		}
+
+		size_t erase(const K& key) {
+			const iterator it = find(key);
+
+			if (it == end())
+				return 0;
+
+			if (it != (entries.end() - 1))
+				*it = std::move(entries.back());
+
+			entries.pop_back();
+			return 1;
+		}
+
+	private:
+		std::vector<value_type> entries;
+	};
+}
+
+#endif // SMALL_VECTOR_MAP_H
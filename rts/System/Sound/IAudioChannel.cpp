@@ -7,6 +7,7 @@ IAudioChannel::IAudioChannel()
 	, enabled(true)
 	, emitsPerFrame(1000)
 	, emitsThisFrame(0)
+	, emitsFrame(0)
 	, maxConcurrentSources(1024)
 {
 }
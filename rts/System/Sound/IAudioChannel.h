@@ -5,6 +5,7 @@
 
 #include "System/float3.h"
 
+#include <atomic>
 #include <string>
 
 struct GuiSoundSet;
@@ -62,7 +63,8 @@ public:
 	virtual float StreamGetTime() = 0;
 	virtual float StreamGetPlayTime() = 0;
 
-	void UpdateFrame() { emitsThisFrame = 0; }
+	// emitsThisFrame is reset by the sound thread once it reaches requests of the new frame
+	void UpdateFrame() { curFrame += 1; }
 	void SetMaxEmits(unsigned max) { emitsPerFrame = max; }
 	void SetMaxConcurrent(unsigned max) { maxConcurrentSources = max; }
 
@@ -79,7 +81,10 @@ public:
 protected:
 	unsigned emitsPerFrame;
 	unsigned emitsThisFrame;
+	unsigned emitsFrame;
 	unsigned maxConcurrentSources;
+
+	std::atomic<unsigned> curFrame = {0};
 };
 
 #endif // I_AUDIO_CHANNEL_H
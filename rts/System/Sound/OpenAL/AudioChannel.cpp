@@ -11,12 +11,43 @@
 #include "System/Sound/ISound.h"
 #include "System/Sound/SoundLog.h"
 #include "System/Threading/SpringThreading.h"
+#include "System/ConcurrentQueue.h"
+#include "System/HashSpec.h"
+#include "System/UnorderedMap.hpp"
 
 #include <climits>
+#include <cmath>
+#include <tuple>
+#include <vector>
 
 extern spring::recursive_mutex soundMutex;
 
 
+struct PlayRequest {
+	AudioChannel* channel;
+
+	size_t id;
+	float3 pos;
+	float3 velocity;
+	float volume;
+
+	unsigned frame;
+	bool relative;
+};
+
+// channel, item, frame, cell-x, cell-z, relative
+typedef std::tuple<const AudioChannel*, size_t, unsigned, int, int, bool> PlayRequestKey;
+
+// filled by any thread so callers never wait for the sound mutex, drained by the sound thread
+static moodycamel::ConcurrentQueue<PlayRequest> playRequests;
+
+// sound thread only
+static std::vector<PlayRequest> mergedPlayRequests;
+static spring::unordered_map<PlayRequestKey, size_t> mergedPlayRequestIndices;
+
+static constexpr float PLAY_REQUEST_MERGE_DIST = 64.0f;
+
+
 
 void AudioChannel::SetVolume(float newVolume)
 {
@@ -66,7 +97,67 @@ void AudioChannel::FindSourceAndPlay(size_t id, const float3& pos, const float3&
 	if (id == 0 || volume <= 0.0f)
 		return;
 
-	std::lock_guard<spring::recursive_mutex> lck(soundMutex);
+	// the sound thread may hold the mutex for a while (buffer loading, stream
+	// decoding), queue the request instead of waiting; it would only be played
+	// on the sound thread's next update anyway (see CSoundSource::PlayAsync)
+	playRequests.enqueue({this, id, pos, velocity, volume, curFrame.load(), relative});
+}
+
+void AudioChannel::UpdatePlayRequests()
+{
+	PlayRequest reqs[64];
+
+	// identical items requested in the same frame at (nearly) the same spot, e.g. by
+	// a group of units firing the same weapon, are merged into one voice whose gain is
+	// that of the summed power; volume holds the squared gain until the group is done
+	for (size_t n = 0; (n = playRequests.try_dequeue_bulk(reqs, sizeof(reqs) / sizeof(reqs[0]))) != 0; ) {
+		for (size_t i = 0; i < n; i++) {
+			const PlayRequest& r = reqs[i];
+			const PlayRequestKey k = {
+				r.channel,
+				r.id,
+				r.frame,
+				int(std::floor(r.pos.x / PLAY_REQUEST_MERGE_DIST)),
+				int(std::floor(r.pos.z / PLAY_REQUEST_MERGE_DIST)),
+				r.relative
+			};
+
+			const auto iter = mergedPlayRequestIndices.find(k);
+
+			if (iter != mergedPlayRequestIndices.end()) {
+				mergedPlayRequests[iter->second].volume += (r.volume * r.volume);
+				continue;
+			}
+
+			mergedPlayRequestIndices.emplace(k, mergedPlayRequests.size());
+			mergedPlayRequests.push_back(r);
+			mergedPlayRequests.back().volume *= r.volume;
+		}
+	}
+
+	// requests stay in order of arrival, which matters for the emit limit
+	for (const PlayRequest& r: mergedPlayRequests) {
+		r.channel->FindSourceAndPlayReal(r.id, r.pos, r.velocity, std::sqrt(r.volume), r.frame, r.relative);
+	}
+
+	mergedPlayRequests.clear();
+	mergedPlayRequestIndices.clear();
+}
+
+void AudioChannel::ClearPlayRequests()
+{
+	PlayRequest reqs[64];
+
+	while (playRequests.try_dequeue_bulk(reqs, sizeof(reqs) / sizeof(reqs[0])) != 0);
+}
+
+void AudioChannel::FindSourceAndPlayReal(size_t id, const float3& pos, const float3& velocity, float volume, unsigned frame, bool relative)
+{
+	// emit limit applies to the frame in which a request was made
+	if (frame != emitsFrame) {
+		emitsFrame = frame;
+		emitsThisFrame = 0;
+	}
 
 	if (!enabled)
 		return;
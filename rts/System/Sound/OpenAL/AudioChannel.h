@@ -49,10 +49,21 @@ public:
 	float StreamGetTime();
 	float StreamGetPlayTime();
 
+	/**
+	 * @brief Starts the samples requested on any channel since the last call
+	 *
+	 * Called by the sound thread, which holds the sound mutex.
+	 */
+	static void UpdatePlayRequests();
+	static void ClearPlayRequests();
+
 protected:
 	void FindSourceAndPlay(size_t id, const float3& pos, const float3& velocity, float volume, bool relative) override;
 	void SoundSourceFinished(CSoundSource* sndSource) override;
 
+private:
+	void FindSourceAndPlayReal(size_t id, const float3& pos, const float3& velocity, float volume, unsigned frame, bool relative);
+
 private:
 	spring::unsynced_set<CSoundSource*> curSources;
 	std::deque<StreamQueueItem> streamQueue;
@@ -22,6 +22,7 @@
 
 #include "System/Sound/ISoundChannels.h"
 #include "System/Sound/SoundLog.h"
+#include "AudioChannel.h"
 #include "SoundSource.h"
 #include "SoundBuffer.h"
 #include "SoundItem.h"
@@ -699,6 +700,9 @@ void CSound::UpdateThread(int cfgMaxSounds)
 
 		LOG("[Sound::%s][3] #sources=%u #items=%u", __func__, uint32_t(soundSources.size()), uint32_t(soundItems.size()));
 
+		// channels are destructed after this thread exits
+		AudioChannel::ClearPlayRequests();
+
 		// destruct items before context cleanup
 		soundSources.clear();
 		soundItems.clear();
@@ -727,6 +731,8 @@ void CSound::Update()
 		GetSoundId(*preloadSet.begin());
 	}
 
+	AudioChannel::UpdatePlayRequests();
+
 	for (CSoundSource& source: soundSources) {
 		source.Update();
 	}
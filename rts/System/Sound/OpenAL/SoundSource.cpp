@@ -159,7 +159,7 @@ void CSoundSource::Stop()
 		//   ::Play via ::Update (*)
 		//   ::PlayStream via AudioChannel::StreamPlay (*)
 		//   ::StreamStop via AudioChannel::StreamStop (*)
-		//   AudioChannel::FindSourceAndPlay (*)
+		//   AudioChannel::FindSourceAndPlayReal via CSound::Update (*)
 		if (sound != nullptr)
 			item = sound->GetSoundItem(curPlayingItem.id);
 		if (item != nullptr)
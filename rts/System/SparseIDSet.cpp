@@ -0,0 +1,9 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "SparseIDSet.h"
+
+CR_BIND(spring::SparseIDSet, )
+CR_REG_METADATA(spring::SparseIDSet, (
+	CR_MEMBER(members),
+	CR_MEMBER(indices)
+))
@@ -0,0 +1,134 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef SPARSE_ID_SET_H
+#define SPARSE_ID_SET_H
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#include "System/creg/creg_cond.h"
+
+namespace spring {
+	/**
+	 * Set of small non-negative integer IDs (unit, feature, projectile, ...)
+	 * stored as a dense array of members plus an ID-indexed table of their
+	 * positions in it. Lookup, insertion and removal are a single index each
+	 * and iteration is a linear walk over the members, with no hashing.
+	 *
+	 * Iteration order is insertion order, except that erase moves the last
+	 * member into the hole; it depends only on the sequence of operations,
+	 * so unlike a hash set it is identical on fresh and reloaded clients no
+	 * matter what the table size is. Erasing invalidates iterators.
+	 *
+	 * The index table grows to the largest ID ever inserted, reserve() the
+	 * full ID range up front to avoid reallocating.
+	 */
+	class SparseIDSet {
+		CR_DECLARE_STRUCT(SparseIDSet)
+
+	public:
+		typedef int value_type;
+		typedef std::vector<int>::const_iterator iterator;
+		typedef std::vector<int>::const_iterator const_iterator;
+
+		SparseIDSet() = default;
+		SparseIDSet(std::initializer_list<int> ids) {
+			for (const int id: ids) {
+				insert(id);
+			}
+		}
+
+		iterator begin() const { return members.cbegin(); }
+		iterator end() const { return members.cend(); }
+		const_iterator cbegin() const { return members.cbegin(); }
+		const_iterator cend() const { return members.cend(); }
+
+		size_t size() const { return members.size(); }
+		bool empty() const { return members.empty(); }
+
+		void reserve(size_t maxID) {
+			members.reserve(maxID);
+			indices.reserve(maxID);
+		}
+
+		void clear() {
+			// only reset the slots that are in use, keeps clear() O(size)
+			for (const int id: members) {
+				indices[id] = -1;
+			}
+
+			members.clear();
+		}
+
+		bool contains(int id) const { return (IndexOf(id) >= 0); }
+		size_t count(int id) const { return contains(id); }
+
+		iterator find(int id) const {
+			const int idx = IndexOf(id);
+
+			if (idx < 0)
+				return end();
+
+			return (begin() + idx);
+		}
+
+		std::pair<iterator, bool> insert(int id) {
+			assert(id >= 0);
+
+			if (size_t(id) >= indices.size())
+				indices.resize(id + 1, -1);
+
+			if (indices[id] >= 0)
+				return {begin() + indices[id], false};
+
+			indices[id] = members.size();
+			members.push_back(id);
+			return {end() - 1, true};
+		}
+
+		size_t erase(int id) {
+			const int idx = IndexOf(id);
+
+			if (idx < 0)
+				return 0;
+
+			indices[members.back()] = idx;
+			indices[id] = -1;
+
+			members[idx] = members.back();
+			members.pop_back();
+			return 1;
+		}
+
+		// order-independent, like comparing two hash sets
+		bool operator == (const SparseIDSet& s) const {
+			if (size() != s.size())
+				return false;
+
+			for (const int id: members) {
+				if (!s.contains(id))
+					return false;
+			}
+
+			return true;
+		}
+		bool operator != (const SparseIDSet& s) const { return !(*this == s); }
+
+	private:
+		int IndexOf(int id) const {
+			if (id < 0 || size_t(id) >= indices.size())
+				return -1;
+
+			return indices[id];
+		}
+
+	private:
+		std::vector<int> members;
+		std::vector<int> indices;
+	};
+}
+
+#endif // SPARSE_ID_SET_H
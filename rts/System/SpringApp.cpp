@@ -31,6 +31,7 @@
 #include "ExternalAI/AILibraryManager.h"
 #include "Game/CameraHandler.h"
 #include "Game/ClientSetup.h"
+#include "Game/DemoBenchmark.h"
 #include "Game/GameSetup.h"
 #include "Game/GameVersion.h"
 #include "Game/GameController.h"
@@ -91,6 +92,7 @@
 #include "System/Platform/errorhandler.h"
 #include "System/Platform/CrashHandler.h"
 #include "System/Platform/Threading.h"
+#include "System/Platform/SamplingProfiler.h"
 #include "System/Platform/Watchdog.h"
 #include "System/Sound/ISound.h"
 #include "System/Sync/FPUCheck.h"
@@ -140,6 +142,9 @@ DEFINE_string   (menu,                                     "",    "Specify a lua
 DEFINE_string   (name,                                     "",    "Set your player name");
 DEFINE_bool     (oldmenu,                                  false, "Start the old menu");
 
+DEFINE_string_EX(benchmark_demo,     "benchmark-demo",     "",    "Replay the given demo as fast as possible and write per-frame sim timings and sync checksums to benchmark.json");
+DEFINE_int32    (frames,                                   0,     "Number of frames to replay with --benchmark-demo (0 = entire demo)");
+
 
 
 int spring::exitCode = spring::EXIT_CODE_SUCCESS;
@@ -231,6 +236,9 @@ bool SpringApp::Init()
 	Watchdog::Install();
 	Watchdog::RegisterThread(WDT_MAIN, true);
 
+	SamplingProfiler::Install();
+	SamplingProfiler::RegisterThread("main");
+
 	// Create Window
 	if (!InitWindow(("Spring " + SpringVersion::GetSync()).c_str())) {
 		SDL_Quit();
@@ -434,6 +442,11 @@ void SpringApp::ParseCmdLine(int argc, char* argv[])
 	if (argc >= 2)
 		inputFile = argv[1];
 
+	if (!FLAGS_benchmark_demo.empty()) {
+		inputFile = FLAGS_benchmark_demo;
+		demoBenchmark.Init(FLAGS_benchmark_demo, FLAGS_frames);
+	}
+
 #ifndef _WIN32
 	if (!FLAGS_nocolor && (getenv("SPRING_NOCOLOR") == nullptr)) {
 		// don't colorize, if our output is piped to a diff tool or file
@@ -833,6 +846,8 @@ int SpringApp::Run()
 
 		while (!gu->globalQuit) {
 			Watchdog::ClearTimer(WDT_MAIN);
+			SamplingProfiler::FrameBoundary(globalRendering->drawFrame);
+			globalRendering->PaceFrame();
 			input.PushEvents();
 
 			// move to clear global data if a save is queued
@@ -967,6 +982,7 @@ void SpringApp::Kill(bool fromRun)
 	ThreadPool::ClearExtJobs();
 
 	LOG("[SpringApp::%s][8]", __func__);
+	SamplingProfiler::Uninstall();
 	Watchdog::DeregisterThread(WDT_MAIN);
 	Watchdog::Uninstall();
 	LOG("[SpringApp::%s][9]", __func__);
@@ -1,11 +1,21 @@
 /* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <string>
 #include <fstream>
+#include <initializer_list>
 #include <vector>
 #include <list>
 
 #include "DumpState.h"
+#ifdef SYNCCHECK
+	#include "SyncChecker.h"
+#endif
 
 #include "Game/GameSetup.h"
 #include "Game/GlobalUnsynced.h"
@@ -30,10 +40,16 @@
 #include "Sim/Weapons/WeaponDefHandler.h"
 #include "Map/ReadMap.h"
 #include "System/StringUtil.h"
+#include "System/Config/ConfigHandler.h"
 #include "System/Log/ILog.h"
 #include "System/SpringHash.h"
+#include "System/Threading/ThreadPool.h"
+
+CONFIG(bool, DumpStateBinary).defaultValue(true)
+	.description("Write /DumpState output in the compact binary format read by tools/scripts/dumpstate_diff.py instead of as text.");
 
 static std::fstream file;
+static FILE* binFile = nullptr;
 
 static int gMinFrameNum = -1;
 static int gMaxFrameNum = -1;
@@ -114,6 +130,558 @@ namespace {
 }
 
 
+
+/*
+ * Binary format, all values little-endian:
+ *
+ *   file   := "SPRSTATE" u32:version str:mapName str:modName
+ *             i32:minFrame i32:maxFrame u32:randSeed u32:initSeed frame*
+ *   frame  := "FRAM" i32:frameNum u32:seed u32:numSections (u32:size section)*
+ *   section:= str:name u16:numFields (u8:type str:fieldName)* u32:numRecords
+ *             (i32:id i32:subIndex u32[numFields])*
+ *   str    := u16:length char[length]
+ *
+ * type is 'f' (float bits), 'i' (signed) or 'u' (unsigned or hash); each
+ * section is built on its own thread and whole frames are written out by
+ * a pool job, so the sim only waits for the slowest section
+ */
+namespace {
+	static constexpr char BIN_MAGIC[8] = {'S', 'P', 'R', 'S', 'T', 'A', 'T', 'E'};
+	static constexpr char BIN_FRAME_MAGIC[4] = {'F', 'R', 'A', 'M'};
+	static constexpr std::uint32_t BIN_VERSION = 1;
+
+	#ifdef THREADPOOL
+	static std::shared_ptr<std::future<void>> pendingWrite;
+	#endif
+
+	struct DumpField {
+		char type; // additionally 'v' for a float3, expanded to three 'f' fields
+		const char* name;
+	};
+
+	class DumpBuffer {
+	public:
+		void PutBytes(const void* p, size_t n) {
+			const std::uint8_t* b = reinterpret_cast<const std::uint8_t*>(p);
+			data.insert(data.end(), b, b + n);
+		}
+		void PutU16(std::uint16_t v) { PutBytes(&v, sizeof(v)); }
+		void PutU32(std::uint32_t v) { PutBytes(&v, sizeof(v)); }
+		void PutString(const std::string& str) {
+			PutU16(std::min(str.size(), size_t(0xFFFF)));
+			PutBytes(str.data(), std::min(str.size(), size_t(0xFFFF)));
+		}
+
+	public:
+		std::vector<std::uint8_t> data;
+	};
+
+	class DumpSection: public DumpBuffer {
+	public:
+		DumpSection(const char* name, std::initializer_list<DumpField> fields) {
+			std::vector<std::pair<char, std::string>> flat;
+
+			for (const DumpField& f: fields) {
+				if (f.type != 'v') {
+					flat.emplace_back(f.type, f.name);
+					continue;
+				}
+
+				for (const char* c: {".x", ".y", ".z"}) {
+					flat.emplace_back('f', std::string(f.name) + c);
+				}
+			}
+
+			PutString(name);
+			PutU16(numFields = flat.size());
+
+			for (const auto& f: flat) {
+				PutBytes(&f.first, 1);
+				PutString(f.second);
+			}
+
+			countOffset = data.size();
+			PutU32(0);
+		}
+
+		void Record(int id, int subIndex = -1) {
+			assert(numValues == numRecords * numFields);
+			PutU32(id);
+			PutU32(subIndex);
+			numRecords += 1;
+		}
+
+		void Add(float v) { PutBytes(&v, sizeof(v)); numValues += 1; }
+		void Add(int v) { PutBytes(&v, sizeof(v)); numValues += 1; }
+		void Add(std::uint32_t v) { PutU32(v); numValues += 1; }
+		void Add(const float3& v) { Add(v.x); Add(v.y); Add(v.z); }
+
+		std::vector<std::uint8_t>& Finish() {
+			assert(numValues == numRecords * numFields);
+			std::memcpy(&data[countOffset], &numRecords, sizeof(numRecords));
+			return data;
+		}
+
+	private:
+		size_t countOffset = 0;
+
+		std::uint32_t numFields = 0;
+		std::uint32_t numRecords = 0;
+		std::uint32_t numValues = 0;
+	};
+
+
+	enum {
+		SECTION_CHECKSUMS,
+		SECTION_UNITS,
+		SECTION_UNIT_PIECES,
+		SECTION_UNIT_WEAPONS,
+		SECTION_UNIT_COMMANDS,
+		SECTION_UNIT_MOVETYPES,
+		SECTION_FEATURES,
+		SECTION_PROJECTILES,
+		SECTION_TEAMS,
+		SECTION_LOSMAPS,
+		SECTION_MAP,
+		SECTION_MODELS,
+		SECTION_COUNT,
+	};
+
+	static std::vector<std::uint8_t> DumpChecksumSection()
+	{
+		#ifdef SYNCCHECK
+		// same values a client reports in NETMSG_SYNCTREE_RESPONSE
+		DumpSection s("checksums", {
+			{'u', CSyncChecker::GetSubsystemName(0)}, {'u', CSyncChecker::GetSubsystemName(1)},
+			{'u', CSyncChecker::GetSubsystemName(2)}, {'u', CSyncChecker::GetSubsystemName(3)},
+			{'u', CSyncChecker::GetSubsystemName(4)}, {'u', CSyncChecker::GetSubsystemName(5)},
+			{'u', CSyncChecker::GetSubsystemName(6)},
+		});
+		static_assert(CSyncChecker::SUBSYS_COUNT == 7, "");
+
+		s.Record(0);
+
+		for (unsigned int i = 0; i < CSyncChecker::SUBSYS_COUNT; i++) {
+			s.Add(std::uint32_t(CSyncChecker::GetSubsystemChecksum(i)));
+		}
+		#else
+		DumpSection s("checksums", {});
+		#endif
+
+		return std::move(s.Finish());
+	}
+
+	static std::vector<std::uint8_t> DumpUnitSection()
+	{
+		DumpSection s("units", {
+			{'v', "pos"}, {'v', "xdir"}, {'v', "ydir"}, {'v', "zdir"},
+			{'i', "heading"}, {'i', "mapSquare"}, {'f', "health"}, {'f', "experience"},
+			{'i', "isDead"}, {'i', "activated"}, {'u', "physicalState"},
+			{'i', "fireState"}, {'i', "moveState"}, {'i', "numPieces"}, {'i', "numWeapons"},
+			{'i', "orderTarget"}, {'i', "commandQueSize"},
+		});
+
+		for (const CUnit* u: unitHandler.GetActiveUnits()) {
+			const CCommandAI* cai = u->commandAI;
+
+			s.Record(u->id);
+			s.Add(u->pos);
+			s.Add(u->rightdir);
+			s.Add(u->updir);
+			s.Add(u->frontdir);
+			s.Add(int(u->heading));
+			s.Add(u->mapSquare);
+			s.Add(u->health);
+			s.Add(u->experience);
+			s.Add(int(u->isDead));
+			s.Add(int(u->activated));
+			s.Add(std::uint32_t(u->physicalState));
+			s.Add(int(u->fireState));
+			s.Add(int(u->moveState));
+			s.Add(int(u->localModel.pieces.size()));
+			s.Add(int(u->weapons.size()));
+			s.Add((cai->orderTarget != nullptr)? cai->orderTarget->id: -1);
+			s.Add(int(cai->commandQue.size()));
+		}
+
+		return std::move(s.Finish());
+	}
+
+	static std::vector<std::uint8_t> DumpUnitPieceSection()
+	{
+		DumpSection s("unitPieces", {{'v', "pos"}, {'v', "rot"}, {'i', "visible"}});
+
+		for (const CUnit* u: unitHandler.GetActiveUnits()) {
+			const std::vector<LocalModelPiece>& pieces = u->localModel.pieces;
+
+			for (size_t i = 0; i < pieces.size(); i++) {
+				s.Record(u->id, i);
+				s.Add(pieces[i].GetPosition());
+				s.Add(pieces[i].GetRotation());
+				s.Add(int(pieces[i].GetScriptVisible()));
+			}
+		}
+
+		return std::move(s.Finish());
+	}
+
+	static std::vector<std::uint8_t> DumpUnitWeaponSection()
+	{
+		DumpSection s("unitWeapons", {
+			{'i', "weaponNum"}, {'v', "weaponDir"}, {'v', "absWeaponPos"}, {'v', "relAimFromPos"},
+			{'v', "absWeaponMuzzlePos"}, {'v', "relWeaponMuzzlePos"},
+		});
+
+		for (const CUnit* u: unitHandler.GetActiveUnits()) {
+			for (size_t i = 0; i < u->weapons.size(); i++) {
+				const CWeapon* w = u->weapons[i];
+
+				s.Record(u->id, i);
+				s.Add(w->weaponNum);
+				s.Add(w->weaponDir);
+				s.Add(w->aimFromPos);
+				s.Add(w->relAimFromPos);
+				s.Add(w->weaponMuzzlePos);
+				s.Add(w->relWeaponMuzzlePos);
+			}
+		}
+
+		return std::move(s.Finish());
+	}
+
+	static std::vector<std::uint8_t> DumpUnitCommandSection()
+	{
+		DumpSection s("unitCommands", {{'i', "commandID"}, {'u', "tag"}, {'u', "options"}, {'i', "numParams"}, {'u', "paramsHash"}});
+
+		for (const CUnit* u: unitHandler.GetActiveUnits()) {
+			int i = 0;
+
+			for (const Command& c: u->commandAI->commandQue) {
+				std::uint32_t paramsHash = 0;
+
+				for (unsigned int n = 0; n < c.GetNumParams(); n++) {
+					paramsHash = spring::LiteHash(c.GetParam(n), paramsHash);
+				}
+
+				s.Record(u->id, i++);
+				s.Add(c.GetID());
+				s.Add(std::uint32_t(c.GetTag()));
+				s.Add(std::uint32_t(c.GetOpts()));
+				s.Add(int(c.GetNumParams()));
+				s.Add(paramsHash);
+			}
+		}
+
+		return std::move(s.Finish());
+	}
+
+	static std::vector<std::uint8_t> DumpUnitMoveTypeSection()
+	{
+		DumpSection s("unitMoveTypes", {
+			{'v', "goalPos"}, {'v', "oldUpdatePos"}, {'v', "oldSlowUpPos"},
+			{'f', "maxSpeed"}, {'f', "maxWantedSpeed"}, {'i', "progressState"},
+		});
+
+		for (const CUnit* u: unitHandler.GetActiveUnits()) {
+			const AMoveType* amt = u->moveType;
+
+			s.Record(u->id);
+			s.Add(amt->goalPos);
+			s.Add(amt->oldPos);
+			s.Add(amt->oldSlowUpdatePos);
+			s.Add(amt->GetMaxSpeed());
+			s.Add(amt->GetMaxWantedSpeed());
+			s.Add(int(amt->progressState));
+		}
+
+		return std::move(s.Finish());
+	}
+
+	static std::vector<std::uint8_t> DumpFeatureSection()
+	{
+		DumpSection s("features", {{'v', "pos"}, {'f', "health"}, {'f', "reclaimLeft"}});
+
+		for (const int featureID: featureHandler.GetActiveFeatureIDs()) {
+			const CFeature* f = featureHandler.GetFeature(featureID);
+
+			s.Record(f->id);
+			s.Add(f->pos);
+			s.Add(f->health);
+			s.Add(f->reclaimLeft);
+		}
+
+		return std::move(s.Finish());
+	}
+
+	static std::vector<std::uint8_t> DumpProjectileSection()
+	{
+		DumpSection s("projectiles", {
+			{'v', "pos"}, {'v', "dir"}, {'v', "speed"},
+			{'i', "weapon"}, {'i', "piece"}, {'i', "checkCol"}, {'i', "deleteMe"},
+		});
+
+		// we only care about the synced projectile data here
+		for (const CProjectile* p: projectileHandler.projectileContainers[true]) {
+			s.Record(p->id);
+			s.Add(p->pos);
+			s.Add(p->dir);
+			s.Add(p->speed);
+			s.Add(int(p->weapon));
+			s.Add(int(p->piece));
+			s.Add(int(p->checkCol));
+			s.Add(int(p->deleteMe));
+		}
+
+		return std::move(s.Finish());
+	}
+
+	static std::vector<std::uint8_t> DumpTeamSection()
+	{
+		DumpSection s("teams", {
+			{'f', "metal"}, {'f', "energy"}, {'f', "metalPull"}, {'f', "energyPull"},
+			{'f', "metalIncome"}, {'f', "energyIncome"}, {'f', "metalExpense"}, {'f', "energyExpense"},
+		});
+
+		for (int a = 0; a < teamHandler.ActiveTeams(); ++a) {
+			const CTeam* t = teamHandler.Team(a);
+
+			s.Record(t->teamNum);
+			s.Add(t->res.metal);
+			s.Add(t->res.energy);
+			s.Add(t->resPull.metal);
+			s.Add(t->resPull.energy);
+			s.Add(t->resIncome.metal);
+			s.Add(t->resIncome.energy);
+			s.Add(t->resExpense.metal);
+			s.Add(t->resExpense.energy);
+		}
+
+		return std::move(s.Finish());
+	}
+
+	static std::vector<std::uint8_t> DumpLosMapSection()
+	{
+		DumpSection s("losMaps", {{'u', "hash"}});
+
+		const std::array<const ILosType*, 7> losTypes = {
+			&losHandler->los,
+			&losHandler->airLos,
+			&losHandler->radar,
+			&losHandler->sonar,
+			&losHandler->seismic,
+			&losHandler->jammer,
+			&losHandler->sonarJammer
+		};
+
+		for (int a = 0; a < teamHandler.ActiveAllyTeams(); ++a) {
+			for (size_t lti = 0; lti < losTypes.size(); ++lti) {
+				const ILosType* lt = losTypes[lti];
+				const auto* lm = &lt->losMaps[a].front();
+
+				std::uint32_t hash = 0;
+
+				for (int i = 0; i < (lt->size.x * lt->size.y); i++) {
+					hash = spring::LiteHash(lm[i], hash);
+				}
+
+				s.Record(a, lti);
+				s.Add(hash);
+			}
+		}
+
+		return std::move(s.Finish());
+	}
+
+	static std::vector<std::uint8_t> DumpMapSection()
+	{
+		DumpSection s("map", {{'u', "heightmap"}, {'u', "centerNormals"}, {'u', "faceNormals"}, {'u', "smoothMesh"}});
+
+		const float* heightmap = readMap->GetCornerHeightMapSynced();
+		const float3* centerNormals = readMap->GetCenterNormalsSynced();
+		const float3* faceNormals = readMap->GetFaceNormalsSynced();
+		const float* smoothMesh = smoothGround.GetMeshData();
+
+		std::uint32_t hmCs = 0;
+		std::uint32_t cnCs = 0;
+		std::uint32_t fnCs = 0;
+		std::uint32_t smCs = 0;
+
+		for (int i = 0; i < (mapDims.mapxp1 * mapDims.mapyp1); i++) {
+			hmCs = spring::LiteHash(heightmap[i], hmCs);
+		}
+		for (int i = 0; i < (mapDims.mapx * mapDims.mapy); i++) {
+			cnCs = spring::LiteHash(centerNormals[i], cnCs);
+			fnCs = spring::LiteHash(faceNormals[i + 0], fnCs);
+			fnCs = spring::LiteHash(faceNormals[i + 1], fnCs);
+		}
+		for (int i = 0; i < (smoothGround.GetMaxX() * smoothGround.GetMaxY()); i++) {
+			smCs = spring::LiteHash(smoothMesh[i], smCs);
+		}
+
+		s.Record(0);
+		s.Add(hmCs);
+		s.Add(cnCs);
+		s.Add(fnCs);
+		s.Add(smCs);
+
+		return std::move(s.Finish());
+	}
+
+	static std::vector<std::uint8_t> DumpModelSection()
+	{
+		DumpSection s("models", {
+			{'i', "numPieces"}, {'i', "textureType"}, {'i', "modelType"}, {'f', "radius"}, {'f', "height"},
+			{'v', "mins"}, {'v', "maxs"}, {'v', "relMidPos"}, {'u', "piecesHash"},
+		});
+
+		for (const auto& m: modelLoader.GetModelsVec()) {
+			std::uint32_t piecesHash = 0;
+
+			for (const auto* p: m.pieceObjects) {
+				piecesHash = spring::LiteHash(p->bposeMatrix, piecesHash);
+				piecesHash = spring::LiteHash(p->bakedMatrix, piecesHash);
+				piecesHash = spring::LiteHash(p->offset, piecesHash);
+				piecesHash = spring::LiteHash(p->goffset, piecesHash);
+				piecesHash = spring::LiteHash(p->scales, piecesHash);
+				piecesHash = spring::LiteHash(p->mins, piecesHash);
+				piecesHash = spring::LiteHash(p->maxs, piecesHash);
+
+				for (const auto& v: p->GetVerticesVec()) {
+					piecesHash = spring::LiteHash(v.pos, piecesHash);
+				}
+				for (const auto& i: p->GetIndicesVec()) {
+					piecesHash = spring::LiteHash(i, piecesHash);
+				}
+			}
+
+			s.Record(m.id);
+			s.Add(int(m.numPieces));
+			s.Add(int(m.textureType));
+			s.Add(int(m.type));
+			s.Add(m.radius);
+			s.Add(m.height);
+			s.Add(m.mins);
+			s.Add(m.maxs);
+			s.Add(m.relMidPos);
+			s.Add(piecesHash);
+		}
+
+		return std::move(s.Finish());
+	}
+
+
+	static void WaitForBinaryWrite()
+	{
+		#ifdef THREADPOOL
+		if (pendingWrite == nullptr)
+			return;
+
+		pendingWrite->get();
+		pendingWrite.reset();
+		#endif
+	}
+
+	static void WriteBinary(std::vector<std::uint8_t>&& buffer)
+	{
+		// at most one frame in flight, which also keeps them in order
+		WaitForBinaryWrite();
+
+		auto writeFunc = [buf = std::move(buffer)]() {
+			fwrite(buf.data(), buf.size(), 1, binFile);
+			fflush(binFile);
+		};
+
+		#ifdef THREADPOOL
+		pendingWrite = ThreadPool::Enqueue(std::move(writeFunc));
+		#else
+		writeFunc();
+		#endif
+	}
+
+	static void OpenBinaryFile(const std::string& name)
+	{
+		if ((binFile = fopen(name.c_str(), "wb")) == nullptr)
+			return;
+
+		DumpBuffer header;
+		header.PutBytes(BIN_MAGIC, sizeof(BIN_MAGIC));
+		header.PutU32(BIN_VERSION);
+		header.PutString(gameSetup->mapName);
+		header.PutString(gameSetup->modName);
+		header.PutU32(gMinFrameNum);
+		header.PutU32(gMaxFrameNum);
+		header.PutU32(gsRNG.GetLastSeed());
+		header.PutU32(gsRNG.GetInitSeed());
+
+		WriteBinary(std::move(header.data));
+	}
+
+	static void CloseBinaryFile()
+	{
+		WaitForBinaryWrite();
+
+		if (binFile == nullptr)
+			return;
+
+		fclose(binFile);
+		binFile = nullptr;
+	}
+
+	static void DumpBinaryFrame()
+	{
+		std::array<std::vector<std::uint8_t>, SECTION_COUNT> sections;
+
+		// the sim is paused until this returns, so sections can be read concurrently
+		for_mt(0, SECTION_COUNT, [&sections](const int i) {
+			switch (i) {
+				case SECTION_CHECKSUMS     : { sections[i] = DumpChecksumSection    (); } break;
+				case SECTION_UNITS         : { sections[i] = DumpUnitSection        (); } break;
+				case SECTION_UNIT_PIECES   : { sections[i] = DumpUnitPieceSection   (); } break;
+				case SECTION_UNIT_WEAPONS  : { sections[i] = DumpUnitWeaponSection  (); } break;
+				case SECTION_UNIT_COMMANDS : { sections[i] = DumpUnitCommandSection (); } break;
+				case SECTION_UNIT_MOVETYPES: { sections[i] = DumpUnitMoveTypeSection(); } break;
+				case SECTION_FEATURES      : { sections[i] = DumpFeatureSection     (); } break;
+				case SECTION_PROJECTILES   : { sections[i] = DumpProjectileSection  (); } break;
+				case SECTION_TEAMS         : { sections[i] = DumpTeamSection        (); } break;
+				case SECTION_LOSMAPS       : { sections[i] = DumpLosMapSection      (); } break;
+				case SECTION_MAP           : { sections[i] = DumpMapSection         (); } break;
+				case SECTION_MODELS        : {
+					// dump once
+					if (gs->frameNum == gMinFrameNum)
+						sections[i] = DumpModelSection();
+				} break;
+				default: {
+					assert(false);
+				} break;
+			}
+		});
+
+		DumpBuffer frame;
+		size_t frameSize = 4 + 4 + 4 + 4;
+
+		for (const auto& section: sections) {
+			frameSize += (4 + section.size());
+		}
+
+		frame.data.reserve(frameSize);
+		frame.PutBytes(BIN_FRAME_MAGIC, sizeof(BIN_FRAME_MAGIC));
+		frame.PutU32(gs->frameNum);
+		frame.PutU32(gsRNG.GetLastSeed());
+		frame.PutU32(std::count_if(sections.begin(), sections.end(), [](const std::vector<std::uint8_t>& s) { return !s.empty(); }));
+
+		for (const auto& section: sections) {
+			if (section.empty())
+				continue;
+
+			frame.PutU32(section.size());
+			frame.PutBytes(section.data(), section.size());
+		}
+
+		WriteBinary(std::move(frame.data));
+	}
+}
+
+
 void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, bool outputFloats)
 {
 	onlyHash = !outputFloats;
@@ -140,6 +708,10 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, bool
 			file.close();
 		}
 
+		CloseBinaryFile();
+
+		const bool binary = configHandler->GetBool("DumpStateBinary");
+
 		std::string name = (gameServer != nullptr)? "Server": "Client";
 		name += "GameState-";
 		name += IntToString(guRNG.NextInt());
@@ -147,9 +719,13 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, bool
 		name += IntToString(gMinFrameNum);
 		name += "-";
 		name += IntToString(gMaxFrameNum);
-		name += "].txt";
+		name += (binary)? "].bin": "].txt";
 
-		file.open(name.c_str(), std::ios::out);
+		if (binary) {
+			OpenBinaryFile(name);
+		} else {
+			file.open(name.c_str(), std::ios::out);
+		}
 
 		if (file.is_open()) {
 			file << " mapName: " << gameSetup->mapName << "\n";
@@ -163,7 +739,7 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, bool
 		LOG("[%s] using dump-file \"%s\"", __func__, name.c_str());
 	}
 
-	if (file.bad() || !file.is_open())
+	if (binFile == nullptr && (file.bad() || !file.is_open()))
 		return;
 	// check if the CURRENT frame lies within the bounds
 	if (gs->frameNum < gMinFrameNum)
@@ -173,6 +749,11 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, bool
 	if ((gs->frameNum % gFramePeriod) != 0)
 		return;
 
+	if (binFile != nullptr) {
+		DumpBinaryFrame();
+		return;
+	}
+
 	// we only care about the synced projectile data here
 	const std::vector<CUnit*>& activeUnits = unitHandler.GetActiveUnits();
 	const auto& activeFeatureIDs = featureHandler.GetActiveFeatureIDs();
@@ -180,6 +761,15 @@ void DumpState(int newMinFrameNum, int newMaxFrameNum, int newFramePeriod, bool
 
 	file << "frame: " << gs->frameNum << ", seed: " << gsRNG.GetLastSeed() << "\n";
 
+	#ifdef SYNCCHECK
+	// same values a client reports in NETMSG_SYNCTREE_RESPONSE
+	file << "checksums:";
+	for (unsigned int i = 0; i < CSyncChecker::SUBSYS_COUNT; i++) {
+		file << " " << CSyncChecker::GetSubsystemName(i) << "=" << CSyncChecker::GetSubsystemChecksum(i);
+	}
+	file << "\n";
+	#endif
+
 	#define DUMP_MODEL_DATA
 	#define DUMP_UNIT_DATA
 	#define DUMP_UNIT_PIECE_DATA
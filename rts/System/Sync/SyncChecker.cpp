@@ -9,7 +9,8 @@
 #include "System/Threading/ThreadPool.h"
 
 
-unsigned CSyncChecker::g_checksum;
+unsigned CSyncChecker::g_checksums[SUBSYS_COUNT];
+CSyncChecker::Subsystem CSyncChecker::g_subsystem = SUBSYS_OTHER;
 int CSyncChecker::inSyncedCode;
 
 
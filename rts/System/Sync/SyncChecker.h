@@ -7,9 +7,8 @@
 
 #ifdef SYNC_HSIEH
 	#include "HsiehHash.h"
-#else
-	#include "System/SpringHash.h"
 #endif
+#include "System/SpringHash.h"
 
 #include <assert.h>
 
@@ -18,10 +17,37 @@
  *
  * A Lightweight sync debugger that just keeps a running checksum over all
  * assignments to synced variables.
+ * Each subsystem gets its own running checksum, the top-level checksum is
+ * a hash over all of them so that a desync can be narrowed down from the
+ * subsystem checksums of two clients without running the SyncDebugger.
  */
 class CSyncChecker {
 
 	public:
+		enum Subsystem {
+			SUBSYS_OTHER       = 0,
+			SUBSYS_LUA         = 1,
+			SUBSYS_PATH        = 2,
+			SUBSYS_UNITS       = 3,
+			SUBSYS_PROJECTILES = 4,
+			SUBSYS_FEATURES    = 5,
+			SUBSYS_RNG         = 6,
+			SUBSYS_COUNT       = 7,
+		};
+
+		/**
+		 * @brief scoped subsystem
+		 *
+		 * Attributes all synced assignments made during its lifetime to <s>.
+		 */
+		class ScopedSubsystem {
+		public:
+			ScopedSubsystem(Subsystem s): prev(g_subsystem) { g_subsystem = s; }
+			~ScopedSubsystem() { g_subsystem = prev; }
+		private:
+			Subsystem prev;
+		};
+
 		/**
 		 * Whether one thread (doesn't have to be the current thread!!!) is currently processing a SimFrame.
 		 */
@@ -32,8 +58,23 @@ class CSyncChecker {
 		/**
 		 * Keeps a running checksum over all assignments to synced variables.
 		 */
-		static unsigned GetChecksum() { return g_checksum; }
-		static void NewFrame() { g_checksum = 0xfade1eaf; }
+		static unsigned GetChecksum() { return (CombineChecksums(g_checksums)); }
+		static unsigned GetSubsystemChecksum(unsigned s) { return g_checksums[s]; }
+		static const unsigned* GetSubsystemChecksums() { return g_checksums; }
+		static const char* GetSubsystemName(unsigned s) {
+			constexpr const char* names[SUBSYS_COUNT] = {"other", "lua", "path", "units", "projectiles", "features", "rng"};
+			return ((s < SUBSYS_COUNT)? names[s]: "unknown");
+		}
+
+		static unsigned CombineChecksums(const unsigned* checksums) {
+			return (spring::LiteHash(checksums, SUBSYS_COUNT * sizeof(checksums[0]), 0));
+		}
+
+		static void NewFrame() {
+			for (unsigned& checksum: g_checksums) {
+				checksum = 0xfade1eaf;
+			}
+		}
 		static void debugSyncCheckThreading();
 		static void Sync(const void* p, unsigned size) {
 #ifdef DEBUG_SYNC_MT_CHECK
@@ -42,20 +83,22 @@ class CSyncChecker {
 #endif
 			// most common cases first, make it easy for compiler to optimize for it
 			// simple xor is not enough to detect multiple zeroes, e.g.
+			unsigned& checksum = g_checksums[g_subsystem];
 #ifdef SYNC_HSIEH
-			g_checksum = HsiehHash((const char*)p, size, g_checksum);
+			checksum = HsiehHash((const char*)p, size, checksum);
 #else
-			g_checksum = spring::LiteHash((const char*)p, size, g_checksum);
+			checksum = spring::LiteHash((const char*)p, size, checksum);
 #endif
-			//LOG("[Sync::Checker] chksum=%u\n", g_checksum);
+			//LOG("[Sync::Checker] chksum=%u\n", checksum);
 		}
 
 	private:
 
 		/**
-		 * The sync checksum
+		 * The sync checksums, one per subsystem
 		 */
-		static unsigned g_checksum;
+		static unsigned g_checksums[SUBSYS_COUNT];
+		static Subsystem g_subsystem;
 
 		/**
 		 * @brief in synced code
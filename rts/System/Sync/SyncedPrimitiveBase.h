@@ -77,4 +77,10 @@ namespace Sync {
 #  define ASSERT_SYNCED(x)
 #endif
 
+#ifdef SYNCCHECK
+#  define SCOPED_SYNC_SUBSYSTEM(s) CSyncChecker::ScopedSubsystem scopedSyncSubsystem(CSyncChecker::s)
+#else
+#  define SCOPED_SYNC_SUBSYSTEM(s)
+#endif
+
 #endif
@@ -5,6 +5,7 @@
 #include "ThreadPool.h"
 #include "System/Exceptions.h"
 #include "System/SpringMath.h"
+#include "System/bitops.h"
 #if (!defined(UNITSYNC) && !defined(UNIT_TEST))
 	#include "System/OffscreenGLContext.h"
 #endif
@@ -65,8 +66,10 @@ static std::vector< std::future<void> > extFutures;
 // note: std::shared_ptr<T> can not be made atomic, queues must store T*'s
 #ifdef USE_BOOST_LOCKFREE_QUEUE
 static std::array<boost::lockfree::queue<ITaskGroup*>, ThreadPool::MAX_THREADS> taskQueues[2];
+static std::array<boost::lockfree::queue<ITaskGroup*>, ThreadPool::MAX_THREADS> lowPrioTaskQueues;
 #else
 static std::array<moodycamel::ConcurrentQueue<ITaskGroup*>, ThreadPool::MAX_THREADS> taskQueues[2];
+static std::array<moodycamel::ConcurrentQueue<ITaskGroup*>, ThreadPool::MAX_THREADS> lowPrioTaskQueues;
 #endif
 
 static std::vector<void*> workerThreads[2];
@@ -75,6 +78,7 @@ static std::array<ThreadStats, ThreadPool::MAX_THREADS> threadStats[2];
 static spring::signal newTasksSignal[2];
 
 static _threadlocal int threadnum(0);
+static _threadlocal int priority(ThreadPool::PRIORITY_HIGH);
 
 #ifndef UNITSYNC
 // if enabled, allows OpenGL calls from ThreadPool tasks
@@ -95,6 +99,9 @@ namespace ThreadPool {
 int GetThreadNum() { return threadnum; }
 static void SetThreadNum(const int idx) { threadnum = idx; }
 
+int GetTaskPriority() { return priority; }
+void SetTaskPriority(const int prio) { priority = prio; }
+
 
 static int GetConfigNumWorkers() {
 	#ifndef UNIT_TEST
@@ -130,7 +137,30 @@ bool HasThreads() { return !workerThreads[false].empty(); }
 
 
 
-static bool DoTask(int tid, bool async)
+static void ExecuteTaskGroup(ITaskGroup* tg, int tid, bool async)
+{
+	assert(!async || tg->IsAsyncTask());
+
+	// nested for_mt's and parallel's spawned by this group inherit its priority
+	ScopedTaskPriority stp(async? GetTaskPriority(): tg->GetPriority());
+
+	#ifdef USE_TASK_STATS_TRACKING
+	const uint64_t wdt = tg->GetDeltaTime(spring_now());
+	const uint64_t edt = tg->ExecuteLoop(tid, false);
+
+	threadStats[async][tid].numTasksRun += 1;
+	threadStats[async][tid].sumExecTime += edt;
+	threadStats[async][tid].sumWaitTime += wdt;
+	threadStats[async][tid].minExecTime  = std::min(threadStats[async][tid].minExecTime, edt);
+	threadStats[async][tid].maxExecTime  = std::max(threadStats[async][tid].maxExecTime, edt);
+	threadStats[async][tid].minWaitTime  = std::min(threadStats[async][tid].minWaitTime, wdt);
+	threadStats[async][tid].maxWaitTime  = std::max(threadStats[async][tid].maxWaitTime, wdt);
+	#else
+	tg->ExecuteLoop(tid, false);
+	#endif
+}
+
+static bool DoTask(int tid, bool async, bool lowPrio)
 {
 	#ifndef UNIT_TEST
 	SCOPED_MT_TIMER("ThreadPool::RunTask");
@@ -155,22 +185,7 @@ static bool DoTask(int tid, bool async)
 			if (idx == 0)
 				NotifyWorkerThreads(true, async);
 
-			assert(!async || tg->IsAsyncTask());
-
-			#ifdef USE_TASK_STATS_TRACKING
-			const uint64_t wdt = tg->GetDeltaTime(spring_now());
-			const uint64_t edt = tg->ExecuteLoop(tid, false);
-
-			threadStats[async][tid].numTasksRun += 1;
-			threadStats[async][tid].sumExecTime += edt;
-			threadStats[async][tid].sumWaitTime += wdt;
-			threadStats[async][tid].minExecTime  = std::min(threadStats[async][tid].minExecTime, edt);
-			threadStats[async][tid].maxExecTime  = std::max(threadStats[async][tid].maxExecTime, edt);
-			threadStats[async][tid].minWaitTime  = std::min(threadStats[async][tid].minWaitTime, wdt);
-			threadStats[async][tid].maxWaitTime  = std::max(threadStats[async][tid].maxWaitTime, wdt);
-			#else
-			tg->ExecuteLoop(tid, false);
-			#endif
+			ExecuteTaskGroup(tg, tid, async);
 		}
 
 		#ifdef USE_BOOST_LOCKFREE_QUEUE
@@ -178,27 +193,34 @@ static bool DoTask(int tid, bool async)
 		#else
 		while (queue.try_dequeue(tg)) {
 		#endif
-			assert(!async || tg->IsAsyncTask());
-
-			#ifdef USE_TASK_STATS_TRACKING
-			const uint64_t wdt = tg->GetDeltaTime(spring_now());
-			const uint64_t edt = tg->ExecuteLoop(tid, false);
-
-			threadStats[async][tid].numTasksRun += 1;
-			threadStats[async][tid].sumExecTime += edt;
-			threadStats[async][tid].sumWaitTime += wdt;
-			threadStats[async][tid].minExecTime  = std::min(threadStats[async][tid].minExecTime, edt);
-			threadStats[async][tid].maxExecTime  = std::max(threadStats[async][tid].maxExecTime, edt);
-			threadStats[async][tid].minWaitTime  = std::min(threadStats[async][tid].minWaitTime, wdt);
-			threadStats[async][tid].maxWaitTime  = std::max(threadStats[async][tid].maxWaitTime, wdt);
-			#else
-			tg->ExecuteLoop(tid, false);
-			#endif
+			ExecuteTaskGroup(tg, tid, async);
 		}
 	}
 
-	// if true, queue contained at least one element
-	return (tg != nullptr);
+	if (tg != nullptr || async || !lowPrio)
+		return (tg != nullptr);
+
+	// high-priority queues are empty; take at most one low-priority group
+	// per call so anything (sim-)critical pushed in the meantime is picked
+	// up as soon as the current group has been run
+	for (int idx = 0; idx <= tid; idx += std::max(tid, 1)) {
+		auto& queue = lowPrioTaskQueues[idx];
+
+		#ifdef USE_BOOST_LOCKFREE_QUEUE
+		if (!queue.pop(tg))
+		#else
+		if (!queue.try_dequeue(tg))
+		#endif
+			continue;
+
+		if (idx == 0)
+			NotifyWorkerThreads(true, async);
+
+		ExecuteTaskGroup(tg, tid, async);
+		return true;
+	}
+
+	return false;
 }
 
 
@@ -223,7 +245,7 @@ static void WorkerLoop(int tid, bool async)
 		const auto spinlockEnd = spring_now() + ourSpinTime;
 		      auto sleepTime   = spring_time::fromMicroSecs(1);
 
-		while (!DoTask(tid, async) && !exitFlags[tid]) {
+		while (!DoTask(tid, async, true) && !exitFlags[tid]) {
 			if (spring_now() < spinlockEnd)
 				continue;
 
@@ -240,6 +262,8 @@ void WaitForFinished(std::shared_ptr<ITaskGroup>&& taskGroup)
 {
 	// can be any worker-thread (for_mt inside another for_mt, etc)
 	const int tid = GetThreadNum();
+	// a high-priority waiter must not get stuck behind low-priority work
+	const bool lowPrio = (GetTaskPriority() != PRIORITY_HIGH);
 
 	{
 		#ifndef UNIT_TEST
@@ -259,7 +283,7 @@ void WaitForFinished(std::shared_ptr<ITaskGroup>&& taskGroup)
 	//   or reassigned prematurely) --> wait
 	if (taskGroup->IsFinished()) {
 		while (taskGroup->IsInJobQueue()) {
-			DoTask(tid, false);
+			DoTask(tid, false, lowPrio);
 		}
 
 		taskGroup->ResetState(false, taskGroup->IsInTaskPool(), false);
@@ -273,7 +297,7 @@ void WaitForFinished(std::shared_ptr<ITaskGroup>&& taskGroup)
 	do {
 		const auto spinlockEnd = spring_now() + spring_time::fromMilliSecs(500);
 
-		while (!DoTask(tid, false) && !taskGroup->IsFinished() && !exitFlags[tid]) {
+		while (!DoTask(tid, false, lowPrio) && !taskGroup->IsFinished() && !exitFlags[tid]) {
 			if (spring_now() < spinlockEnd)
 				continue;
 
@@ -284,7 +308,7 @@ void WaitForFinished(std::shared_ptr<ITaskGroup>&& taskGroup)
 	} while (!taskGroup->IsFinished() && !exitFlags[tid]);
 
 	while (taskGroup->IsInJobQueue()) {
-		DoTask(tid, false);
+		DoTask(tid, false, lowPrio);
 	}
 
 	taskGroup->ResetState(false, taskGroup->IsInTaskPool(), false);
@@ -298,7 +322,13 @@ void WaitForFinished(std::shared_ptr<ITaskGroup>&& taskGroup)
 void PushTaskGroup(std::shared_ptr<ITaskGroup>&& taskGroup) { PushTaskGroup(taskGroup.get()); }
 void PushTaskGroup(ITaskGroup* taskGroup)
 {
-	auto& queue = taskQueues[ taskGroup->IsAsyncTask() ][ taskGroup->WantedThread() ];
+	// async tasks have their own workers and are not prioritized
+	if (!taskGroup->IsAsyncTask())
+		taskGroup->taskPriority.store(GetTaskPriority());
+
+	const bool lowPrio = (taskGroup->GetPriority() != PRIORITY_HIGH);
+
+	auto& queue = lowPrio? lowPrioTaskQueues[ taskGroup->WantedThread() ]: taskQueues[ taskGroup->IsAsyncTask() ][ taskGroup->WantedThread() ];
 
 	#if 0
 	// fake single-task group, handled by WaitForFinished to
@@ -404,9 +434,11 @@ static void KillThreads(int wantedNumThreads, int curNumThreads)
 		#ifdef USE_BOOST_LOCKFREE_QUEUE
 		while (taskQueues[false][i].pop(tg));
 		while (taskQueues[ true][i].pop(tg));
+		while (lowPrioTaskQueues[i].pop(tg));
 		#else
 		while (taskQueues[false][i].try_dequeue(tg));
 		while (taskQueues[ true][i].try_dequeue(tg));
+		while (lowPrioTaskQueues[i].try_dequeue(tg));
 		#endif
 	}
 
@@ -414,12 +446,11 @@ static void KillThreads(int wantedNumThreads, int curNumThreads)
 }
 
 
-static std::uint32_t FindWorkerThreadCore(std::int32_t index, std::uint32_t availCores, std::uint32_t avoidCores)
+static std::uint32_t FindWorkerThreadCore(std::int32_t index, std::uint32_t availCores, std::uint32_t avoidCores, std::uint32_t preferCores)
 {
 	// find an unused core for worker-thread <index>
-	const auto FindCore = [&index](std::uint32_t targetCores) {
+	const auto FindCore = [](std::uint32_t targetCores, std::int32_t n) {
 		std::uint32_t workerCore = 1;
-		std::int32_t n = index;
 
 		while ((workerCore != 0) && !(workerCore & targetCores))
 			workerCore <<= 1;
@@ -433,9 +464,18 @@ static std::uint32_t FindWorkerThreadCore(std::int32_t index, std::uint32_t avai
 
 		return workerCore;
 	};
+	// hand out the preferred cores first, then continue with the rest
+	const auto FindPreferredCore = [&](std::uint32_t targetCores) {
+		const std::int32_t numPreferred = count_bits_set(targetCores & preferCores);
+
+		if (index < numPreferred)
+			return (FindCore(targetCores & preferCores, index));
+
+		return (FindCore(targetCores & ~preferCores, index - numPreferred));
+	};
 
-	const std::uint32_t threadAvailCore = FindCore(availCores);
-	const std::uint32_t threadAvoidCore = FindCore(avoidCores);
+	const std::uint32_t threadAvailCore = FindPreferredCore(availCores);
+	const std::uint32_t threadAvoidCore = FindPreferredCore(avoidCores);
 
 	if (threadAvailCore != 0)
 		return threadAvailCore;
@@ -475,6 +515,7 @@ void SetThreadCount(int wantedNumThreads)
 		#ifdef USE_BOOST_LOCKFREE_QUEUE
 		taskQueues[false][0].reserve(1024);
 		taskQueues[ true][0].reserve(1024);
+		lowPrioTaskQueues[0].reserve(1024);
 		#endif
 
 		#ifdef USE_TASK_STATS_TRACKING
@@ -591,6 +632,12 @@ void SetDefaultThreadCount()
 	#endif
 
 	std::uint32_t workerAvailCores = systemCores & ~mainAffinity;
+	// on hybrid CPUs workers fill up the efficiency cores first, s.t. the
+	// cores left over for the main thread are performance cores
+	std::uint32_t workerPreferCores = systemCores & ~Threading::GetPerformanceCoresMask();
+
+	if (workerPreferCores == systemCores)
+		workerPreferCores = 0;
 
 	SetThreadCount(GetDefaultNumWorkers());
 
@@ -605,7 +652,7 @@ void SetDefaultThreadCount()
 			if (i == 0)
 				return 0;
 
-			const std::uint32_t workerCore = FindWorkerThreadCore(i - 1, workerAvailCores, mainAffinity);
+			const std::uint32_t workerCore = FindWorkerThreadCore(i - 1, workerAvailCores, mainAffinity, workerPreferCores);
 			// const std::uint32_t workerCore = workerAvailCores;
 
 			Threading::SetAffinity(workerCore);
@@ -27,6 +27,15 @@ namespace ThreadPool {
 	static inline void NotifyWorkerThreads(bool force, bool async) {}
 	static inline bool HasThreads() { return false; }
 
+	enum { PRIORITY_HIGH = 0, PRIORITY_LOW = 1 };
+
+	static inline int GetTaskPriority() { return PRIORITY_HIGH; }
+	static inline void SetTaskPriority(int prio) {}
+
+	struct ScopedTaskPriority {
+		ScopedTaskPriority(int prio) {}
+	};
+
 	static constexpr int MAX_THREADS = 1;
 }
 
@@ -109,6 +118,21 @@ namespace ThreadPool {
 	int GetNumThreads();
 	void NotifyWorkerThreads(bool force, bool async);
 
+	// sync task-groups inherit the priority of the thread that pushes them;
+	// low-priority groups (e.g. unsynced drawing updates) are only picked up
+	// by workers that have no high-priority (e.g. sim) work left to do
+	enum { PRIORITY_HIGH = 0, PRIORITY_LOW = 1 };
+
+	int GetTaskPriority();
+	void SetTaskPriority(int prio);
+
+	struct ScopedTaskPriority {
+		ScopedTaskPriority(int prio): prevPrio(GetTaskPriority()) { SetTaskPriority(prio); }
+		~ScopedTaskPriority() { SetTaskPriority(prevPrio); }
+
+		int prevPrio;
+	};
+
 	static constexpr int MAX_THREADS = 32;
 }
 
@@ -178,6 +202,7 @@ public:
 
 	int RemainingTasks() const { return remainingTasks; }
 	int WantedThread() const { return wantedThread; }
+	int GetPriority() const { return taskPriority; }
 
 	bool WaitFor(const spring_time& rel_time) const {
 		const auto end = spring_now() + rel_time;
@@ -194,6 +219,7 @@ public:
 	void ResetState(bool queued, bool pooled, bool inuse) {
 		remainingTasks.store(0);
 		wantedThread.store(0);
+		taskPriority.store(0);
 		taskPoolMask.store(((1 * pooled) << 0) + ((1 * inuse) << 1));
 
 		inTaskQueue.store(queued);
@@ -203,6 +229,7 @@ public:
 public:
 	std::atomic_int remainingTasks;
 	std::atomic_int wantedThread; // if 0 (default), task will be executed by an arbitrary thread
+	std::atomic_int taskPriority; // ThreadPool::PRIORITY_*, set when the task is pushed
 	std::atomic_int taskPoolMask; // whether this task is managed (owned) and in use by a TaskPool
 
 	std::atomic_bool inTaskQueue; // whether this task is still in a thread's queue
@@ -704,9 +731,15 @@ static inline void for_mt(int start, int end, int step, F&& f)
 	#if 0
 	ThreadPool::PushTaskGroup(taskGroup);
 	#else
-	// store the group in all worker queues s.t. each executes a slice
-	for (size_t i = 1; i < ThreadPool::GetNumThreads(); ++i) {
-		taskGroup->wantedThread.store(i);
+	// store the group in (at most) all worker queues s.t. each executes a slice;
+	// the caller runs one as well, so more copies than remaining iterations are
+	// useless and only make nested loops oversubscribe the pool with stale ones
+	// (rotate the start so short loops do not always land on the same workers)
+	const int numWorkers = ThreadPool::GetNumThreads() - 1;
+	const int numCopies = std::min(numWorkers, taskGroup->RemainingTasks() - 1);
+
+	for (int i = 0; i < numCopies; ++i) {
+		taskGroup->wantedThread.store(1 + (taskGroup->GetId() + i) % numWorkers);
 		ThreadPool::PushTaskGroup(taskGroup);
 	}
 	#endif
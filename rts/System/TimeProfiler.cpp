@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <climits>
+#include <cstdio>
 #include <cstring>
 
 #include "System/TimeProfiler.h"
@@ -24,6 +25,9 @@ static spring::unordered_map<unsigned, int> refCounters;
 
 static CGlobalUnsyncedRNG profileColorRNG;
 
+// enough for a few hundred frames with every timer enabled
+static constexpr size_t NUM_TRACE_EVENTS = 1 << 20;
+
 
 spring_time BasicTimer::GetDuration() const
 {
@@ -54,8 +58,13 @@ ScopedTimer::~ScopedTimer()
 	assert(iter != refCounters.end());
 	assert(iter->second > 0);
 
+	const spring_time deltaTime = GetDuration();
+
+	// trace every span, nested timers with the same name included
+	profiler.AddTraceEvent(nameHash, startTime, deltaTime);
+
 	if (--(iter->second) == 0) {
-		profiler.AddTime(nameHash, startTime, GetDuration(), autoShowGraph, specialTimer, false);
+		profiler.AddTime(nameHash, startTime, deltaTime, autoShowGraph, specialTimer, false, GetNumAllocs());
 	}
 }
 
@@ -99,7 +108,10 @@ ScopedMtTimer::ScopedMtTimer(unsigned _nameHash, bool _autoShowGraph)
 
 ScopedMtTimer::~ScopedMtTimer()
 {
-	profiler.AddTime(nameHash, startTime, GetDuration(), autoShowGraph, false, true);
+	const spring_time deltaTime = GetDuration();
+
+	profiler.AddTraceEvent(nameHash, startTime, deltaTime);
+	profiler.AddTime(nameHash, startTime, deltaTime, autoShowGraph, false, true, GetNumAllocs());
 }
 
 
@@ -341,7 +353,8 @@ void CTimeProfiler::AddTime(
 	const spring_time deltaTime,
 	const bool showGraph,
 	const bool specialTimer,
-	const bool threadTimer
+	const bool threadTimer,
+	const std::uint64_t numAllocs
 ) {
 	const spring_time t0 = spring_now();
 
@@ -350,7 +363,7 @@ void CTimeProfiler::AddTime(
 			return;
 
 		assert(!threadTimer);
-		AddTimeRaw(nameHash, startTime, deltaTime, showGraph, threadTimer);
+		AddTimeRaw(nameHash, startTime, deltaTime, showGraph, threadTimer, numAllocs);
 		AddTimeRaw(hashString("Misc::Profiler::AddTime"), t0, spring_now() - t0, false, false);
 		return;
 	}
@@ -359,7 +372,7 @@ void CTimeProfiler::AddTime(
 	// cause a profile rehash and invalidate <pi> for another
 	std::lock_guard<ProfileMutexType> lock(profileMutex);
 
-	AddTimeRaw(nameHash, startTime, deltaTime, showGraph, threadTimer);
+	AddTimeRaw(nameHash, startTime, deltaTime, showGraph, threadTimer, numAllocs);
 	AddTimeRaw(hashString("Misc::Profiler::AddTime"), t0, spring_now() - t0, false, false);
 }
 
@@ -368,7 +381,8 @@ void CTimeProfiler::AddTimeRaw(
 	const spring_time startTime,
 	const spring_time deltaTime,
 	const bool showGraph,
-	const bool threadTimer
+	const bool threadTimer,
+	const std::uint64_t numAllocs
 ) {
 #ifdef THREADPOOL
 	if (threadTimer)
@@ -382,6 +396,9 @@ void CTimeProfiler::AddTimeRaw(
 	p.total   += deltaTime;
 	p.current += deltaTime;
 
+	p.numCalls  += 1;
+	p.numAllocs += numAllocs;
+
 	p.newLagPeak = (p.stats.x > 0.0f && deltaTime.toMilliSecsf() > p.stats.x);
 	p.stats.x    = std::max(p.stats.x, deltaTime.toMilliSecsf());
 
@@ -399,18 +416,128 @@ void CTimeProfiler::AddTimeRaw(
 	}
 }
 
+void CTimeProfiler::AddTraceEvent(const unsigned nameHash, const spring_time startTime, const spring_time deltaTime, const int threadNum)
+{
+	if (!tracing.load(std::memory_order_relaxed))
+		return;
+
+	TraceEvent& e = traceEvents[traceEventIdx.fetch_add(1, std::memory_order_relaxed) & (NUM_TRACE_EVENTS - 1)];
+
+	e.nameHash = nameHash;
+	e.threadNum = std::max(threadNum, 0);
+	#ifdef THREADPOOL
+	if (threadNum < 0)
+		e.threadNum = ThreadPool::GetThreadNum();
+	#endif
+	e.frameNum = traceFrame.load(std::memory_order_relaxed);
+	e.startTime = startTime;
+	e.deltaTime = deltaTime;
+}
+
+
+bool CTimeProfiler::StartTrace(int numFrames)
+{
+	const int curFrame = traceFrame.load();
+
+	if (tracing.load())
+		return false;
+
+	// allocated on first use, a trace is not something most clients ever capture
+	traceEvents.resize(NUM_TRACE_EVENTS);
+	traceEventIdx.store(0);
+
+	traceStartTime = spring_gettime();
+	traceStartFrame = curFrame;
+	traceEndFrame = curFrame + std::max(numFrames, 1);
+
+	LOG("[TimeProfiler::%s] capturing trace for frames [%d,%d)", __func__, traceStartFrame, traceEndFrame);
+
+	tracing.store(true);
+	return true;
+}
+
+bool CTimeProfiler::StopTrace()
+{
+	if (!tracing.load())
+		return false;
+
+	tracing.store(false);
+
+	const size_t numEvents = std::min(traceEventIdx.load(), NUM_TRACE_EVENTS);
+	const size_t baseIndex = traceEventIdx.load() - numEvents;
+
+	char name[128];
+	snprintf(name, sizeof(name), "ProfileTrace-[%d-%d].json", traceStartFrame, traceFrame.load());
+
+	FILE* out = fopen(name, "wt");
+
+	if (out == nullptr) {
+		LOG_L(L_ERROR, "[TimeProfiler::%s] could not open trace-file \"%s\"", __func__, name);
+		return false;
+	}
+
+	std::lock_guard<HashNamMutexType> lock(hashToNameMutex);
+
+	fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"GPU\"}}\n", GPU_TRACE_THREAD);
+
+	for (size_t i = 0; i < numEvents; i++) {
+		const TraceEvent& e = traceEvents[(baseIndex + i) & (NUM_TRACE_EVENTS - 1)];
+		const auto iter = hashToName.find(e.nameHash);
+
+		// chrome://tracing and Perfetto both expect timestamps in microseconds
+		const int64_t ts = (e.startTime - traceStartTime).toNanoSecsi() / 1000;
+		const int64_t tt = e.deltaTime.toNanoSecsi() / 1000;
+
+		fprintf(out, ",{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%lld,\"dur\":%lld,\"args\":{\"frame\":%d}}\n",
+			(iter != hashToName.end())? iter->second.c_str(): "???",
+			e.threadNum,
+			static_cast<long long>(ts),
+			static_cast<long long>(tt),
+			e.frameNum
+		);
+	}
+
+	fprintf(out, "]}\n");
+	fclose(out);
+
+	LOG("[TimeProfiler::%s] wrote %u events to trace-file \"%s\"", __func__, static_cast<unsigned>(numEvents), name);
+	return true;
+}
+
+void CTimeProfiler::SetTraceFrame(int curFrame)
+{
+	traceFrame.store(curFrame, std::memory_order_relaxed);
+
+	if (!tracing.load(std::memory_order_relaxed))
+		return;
+	if (curFrame < traceEndFrame)
+		return;
+
+	StopTrace();
+}
+
+
 void CTimeProfiler::PrintProfilingInfo() const
 {
 	if (sortedProfiles.empty())
 		return;
 
-	LOG("%35s|%18s|%s", "Part", "Total Time", "Time of the last 0.5s");
+	if (AllocCounter::ENABLED) {
+		LOG("%35s|%18s|%21s|%s", "Part", "Total Time", "Time of the last 0.5s", "Allocations per call");
+	} else {
+		LOG("%35s|%18s|%s", "Part", "Total Time", "Time of the last 0.5s");
+	}
 
 	for (const auto& sortedProfile: sortedProfiles) {
 		const std::string& name = sortedProfile.first;
 		const TimeRecord& tr = sortedProfile.second;
 
-		LOG("%35s %16.2fms %5.2f%%", name.c_str(), tr.total.toMilliSecsf(), tr.stats.y * 100);
+		if (AllocCounter::ENABLED) {
+			LOG("%35s %16.2fms %20.2f%% %.2f", name.c_str(), tr.total.toMilliSecsf(), tr.stats.y * 100, tr.numAllocs / std::max(1.0, double(tr.numCalls)));
+		} else {
+			LOG("%35s %16.2fms %5.2f%%", name.c_str(), tr.total.toMilliSecsf(), tr.stats.y * 100);
+		}
 	}
 }
 
@@ -9,6 +9,7 @@
 #include <vector>
 #include <array>
 
+#include "System/Misc/AllocCounter.h"
 #include "System/Misc/SpringTime.h"
 #include "System/Misc/NonCopyable.h"
 #include "System/float3.h"
@@ -31,13 +32,19 @@ class BasicTimer : public spring::noncopyable
 {
 public:
 	//BasicTimer(const spring_time time): nameHash(0), startTime(time) {}
-	BasicTimer(unsigned _nameHash) : nameHash(_nameHash), startTime(spring_gettime()) { }
+	BasicTimer(unsigned _nameHash)
+		: nameHash(_nameHash)
+		, startTime(spring_gettime())
+		, startAllocs(AllocCounter::GetThreadCount())
+	{ }
 
 	spring_time GetDuration() const;
+	std::uint64_t GetNumAllocs() const { return (AllocCounter::GetThreadCount() - startAllocs); }
 
 protected:
 	const unsigned nameHash;
 	const spring_time startTime;
+	const std::uint64_t startAllocs;
 };
 
 
@@ -104,6 +111,16 @@ public:
 	static bool UnRegisterTimer(const char* name);
 
 
+	// single span recorded while a trace capture is running
+	struct TraceEvent {
+		unsigned nameHash = 0;
+		int threadNum = 0;
+		int frameNum = 0;
+
+		spring_time startTime;
+		spring_time deltaTime;
+	};
+
 	struct TimeRecord {
 		TimeRecord() {
 			frames.fill(spring_time(0));
@@ -115,6 +132,10 @@ public:
 		spring_time current = spring_notime;
 		std::array<spring_time, numFrames> frames;
 
+		// only counted with ALLOC_COUNTER
+		std::uint64_t numCalls = 0;
+		std::uint64_t numAllocs = 0;
+
 		// .x := maximum dt, .y := time-percentage, .z := peak-percentage
 		float3 stats;
 		float3 color;
@@ -165,22 +186,38 @@ public:
 	void RefreshProfilesRaw();
 
 	void SetEnabled(bool b) { enabled = b; }
+	bool IsEnabled() const { return enabled.load(std::memory_order_relaxed); }
 	void PrintProfilingInfo() const;
 
+	// trace capture; records every timer span during the next <numFrames>
+	// (sim-)frames and writes them as Chrome trace JSON once these passed
+	bool StartTrace(int numFrames);
+	bool StopTrace();
+	bool IsTracing() const { return tracing.load(std::memory_order_relaxed); }
+
+	void SetTraceFrame(int curFrame);
+	// threadNum < 0 stands for the calling thread
+	void AddTraceEvent(unsigned nameHash, const spring_time startTime, const spring_time deltaTime, int threadNum = -1);
+
+	// pseudo-thread for spans measured by GPU timer queries
+	static constexpr int GPU_TRACE_THREAD = 1000;
+
 	void AddTime(
 		unsigned nameHash,
 		const spring_time startTime,
 		const spring_time deltaTime,
 		const bool showGraph = false,
 		const bool specialTimer = false,
-		const bool threadTimer = false
+		const bool threadTimer = false,
+		const std::uint64_t numAllocs = 0
 	);
 	void AddTimeRaw(
 		unsigned nameHash,
 		const spring_time startTime,
 		const spring_time deltaTime,
 		const bool showGraph,
-		const bool threadTimer
+		const bool threadTimer,
+		const std::uint64_t numAllocs = 0
 	);
 
 private:
@@ -197,6 +234,18 @@ private:
 
 	// if false, AddTime is a no-op for (almost) all timers
 	std::atomic<bool> enabled;
+
+	// ring-buffer of trace events; slots are claimed via fetch_add so
+	// any thread may write concurrently, oldest spans are overwritten
+	std::vector<TraceEvent> traceEvents;
+	std::atomic<size_t> traceEventIdx = {0};
+	std::atomic<int> traceFrame = {0};
+	std::atomic<bool> tracing = {false};
+
+	spring_time traceStartTime;
+
+	int traceStartFrame = 0;
+	int traceEndFrame = 0;
 };
 
 
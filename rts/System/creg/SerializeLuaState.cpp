@@ -14,7 +14,11 @@
 #include "System/UnorderedMap.hpp"
 #include "System/StringUtil.h"
 #include "System/Log/ILog.h"
+
+#include <cinttypes>
 #include <deque>
+#include <type_traits>
+#include <vector>
 
 struct creg_lua_State;
 struct creg_Proto;
@@ -68,6 +72,10 @@ static bool inClosure = false;
 static spring::unsynced_map<std::string, lua_CFunction> nameToFunc;
 static spring::unsynced_map<lua_CFunction, std::string> funcToName;
 
+// C functions already written (or read) by the current SerializeLuaState
+static spring::unsynced_map<lua_CFunction, std::uint32_t> funcToIndex;
+static std::vector<lua_CFunction> funcIndexed;
+
 
 /*
  * Copied from lfunc.h
@@ -654,20 +662,31 @@ CR_REG_METADATA(creg_LG, (
 ))
 
 
+template<typename T, typename C>
+inline T* AllocCVector(creg::ISerializer* s, T** vecPtr, C count)
+{
+	if (!(s->IsWriting()))
+		*vecPtr = (T*) luaContext.alloc(count * sizeof(T));
+
+	return *vecPtr;
+}
+
 template<typename T, typename C>
 inline void SerializeCVector(creg::ISerializer* s, T** vecPtr, C count)
 {
-	std::unique_ptr<creg::IType> elemType = creg::DeduceType<T>::Get();
-	T* vec;
-	if (!(s->IsWriting())) {
-		vec = (T*) luaContext.alloc(count * sizeof(T));
-		*vecPtr = vec;
+	T* vec = AllocCVector(s, vecPtr, count);
+
+	// bytecode and line-info go straight to the stream
+	if constexpr (std::is_arithmetic<T>::value) {
+		for (unsigned i = 0; i < unsigned(count); ++i) {
+			s->SerializeInt(&vec[i], sizeof(T));
+		}
 	} else {
-		vec = *vecPtr;
-	}
+		std::unique_ptr<creg::IType> elemType = creg::DeduceType<T>::Get();
 
-	for (unsigned i = 0; i < unsigned(count); ++i) {
-		elemType->Serialize(s, &vec[i]);
+		for (unsigned i = 0; i < unsigned(count); ++i) {
+			elemType->Serialize(s, &vec[i]);
+		}
 	}
 }
 
@@ -682,6 +701,25 @@ void SerializeInstance(creg::ISerializer* s, T* t) {
 	s->SerializeObjectInstance(t, t->GetClass());
 }
 
+// Table slots, constants and C-closure upvalues are never the target of
+// a creg pointer (open upvalues only point into stacks, closed ones into
+// themselves) so they are written inline instead of as creg instances;
+// registering every one of them as an object dominated save time and size
+static void SerializeValue(creg::ISerializer* s, creg_TValue* tv)
+{
+	s->SerializeInt(&tv->tt, sizeof(tv->tt));
+	tv->Serialize(s);
+}
+
+static void SerializeValues(creg::ISerializer* s, creg_TValue** vecPtr, int count)
+{
+	creg_TValue* vec = AllocCVector(s, vecPtr, count);
+
+	for (int i = 0; i < count; ++i) {
+		SerializeValue(s, &vec[i]);
+	}
+}
+
 void SerializeLightUserData(creg::ISerializer* s, void **p)
 {
 	if (!inClosure) {
@@ -751,11 +789,34 @@ void creg_Node::Serialize(creg::ISerializer* s)
 }
 
 
+static void SerializeNodes(creg::ISerializer* s, creg_Node** vecPtr, int count)
+{
+	creg_Node* vec = AllocCVector(s, vecPtr, count);
+
+	for (int i = 0; i < count; ++i) {
+		creg_Node& n = vec[i];
+
+		// chain links always stay within the node array
+		std::int32_t next = -1;
+
+		if (s->IsWriting() && n.i_key.nk.next != nullptr)
+			next = n.i_key.nk.next - vec;
+
+		SerializeValue(s, &n.i_val);
+		SerializeValue(s, &n.i_key.tvk);
+		s->SerializeInt(&next, sizeof(next));
+
+		if (!s->IsWriting())
+			n.i_key.nk.next = (next >= 0)? &vec[next]: nullptr;
+	}
+}
+
+
 void creg_Table::Serialize(creg::ISerializer* s)
 {
 	int sizenode = twoto(lsizenode);
 
-	SerializeCVector(s, &array, sizearray);
+	SerializeValues(s, &array, sizearray);
 	bool empty;
 	creg_Node* dummy = GetDummyNode();
 	if (s->IsWriting())
@@ -770,7 +831,7 @@ void creg_Table::Serialize(creg::ISerializer* s)
 			assert(node == dummy);
 		}
 	} else {
-		SerializeCVector(s, &node, sizenode);
+		SerializeNodes(s, &node, sizenode);
 	}
 
 	ptrdiff_t lastfreeOffset;
@@ -817,7 +878,7 @@ void creg_Table::PostLoad()
 
 void creg_Proto::Serialize(creg::ISerializer* s)
 {
-	SerializeCVector(s, &k,        sizek);
+	SerializeValues(s, &k,         sizek);
 	SerializeCVector(s, &code,     sizecode);
 	SerializeCVector(s, &p,        sizep);
 	SerializeCVector(s, &lineinfo, sizelineinfo);
@@ -868,19 +929,42 @@ void creg_CClosure::Serialize(creg::ISerializer* s)
 {
 	inClosure = true;
 	for (unsigned i = 0; i < nupvalues; ++i) {
-		SerializeInstance(s, &upvalue[i]);
+		SerializeValue(s, &upvalue[i]);
 	}
 	inClosure = false;
 
+	// every closure of the same C function refers to it by the index of
+	// the first one, reading sees the same sequence and rebuilds the list
 	creg::StringType sType;
+	std::uint32_t nameIdx;
 	if (s->IsWriting()) {
+		const auto it = funcToIndex.find(f);
+
+		if ((nameIdx = funcIndexed.size(), it != funcToIndex.end()))
+			nameIdx = it->second;
+
+		s->SerializeInt(&nameIdx, sizeof(nameIdx));
+
+		if (nameIdx < funcIndexed.size())
+			return;
+
 		if (funcToName.find(f) == funcToName.end()) {
 			LOG_L(L_ERROR, "Function with address 0x%p not found during serialization", f);
 		}
 		assert(funcToName.find(f) != funcToName.end());
 		std::string name = funcToName[f];
 		sType.Serialize(s, &name);
+
+		funcToIndex[f] = nameIdx;
+		funcIndexed.push_back(f);
 	} else {
+		s->SerializeInt(&nameIdx, sizeof(nameIdx));
+
+		if (nameIdx < funcIndexed.size()) {
+			f = funcIndexed[nameIdx];
+			return;
+		}
+
 		std::string name;
 		sType.Serialize(s, &name);
 		if (nameToFunc.find(name) == nameToFunc.end()) {
@@ -888,6 +972,8 @@ void creg_CClosure::Serialize(creg::ISerializer* s)
 		}
 		assert(nameToFunc.find(name) != nameToFunc.end());
 		f = nameToFunc[name];
+
+		funcIndexed.push_back(f);
 	}
 }
 
@@ -1093,6 +1179,10 @@ namespace creg {
 void SerializeLuaState(creg::ISerializer* s, lua_State** L)
 {
 	creg_LG* clg;
+
+	funcToIndex.clear();
+	funcIndexed.clear();
+
 	if (s->IsWriting()) {
 		assert(*L != nullptr);
 		clg = (creg_LG*) *L;
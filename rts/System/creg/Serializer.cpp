@@ -102,6 +102,11 @@ template<typename T>
 void WriteVarSizeUInt(std::ostream* stream, T val)
 {
 	std::uint64_t v = val;
+
+	// at most ceil(64 / 7) bytes, written at once (stream writes are not cheap)
+	unsigned char buf[10];
+	unsigned char* end = &buf[0];
+
 	do {
 		unsigned char a = v & 0x7F;
 		v >>= 7;
@@ -109,8 +114,10 @@ void WriteVarSizeUInt(std::ostream* stream, T val)
 		if (v > 0)
 			a |= 0x80;
 
-		stream->write((char*)&a, sizeof(char));
+		*(end++) = a;
 	} while (v > 0);
+
+	stream->write((char*)&buf[0], end - &buf[0]);
 }
 
 void creg::ReadUInt(std::istream* stream, std::uint64_t* buf)
@@ -209,12 +216,11 @@ void COutputStreamSerializer::SerializeObjectInstance(void* inst, creg::Class* o
 	} else if (obj->isEmbedded) {
 		throw std::string("Reserialization of embedded object (") + objClass->name + ")";
 	} else {
-		std::vector<ObjectRef*>::iterator it = std::find(pendingObjects.begin(), pendingObjects.end(), obj);
-		if (it == pendingObjects.end()) {
+		if (!obj->isPending)
 			throw std::string("Object pointer was serialized (") + objClass->name + ")";
-		} else {
-			pendingObjects.erase(it);
-		}
+
+		// skipped by SavePackage, cheaper than erasing from pendingObjects
+		obj->isPending = false;
 	}
 	obj->class_ = objClass;
 	obj->isEmbedded = true;
@@ -237,6 +243,7 @@ void COutputStreamSerializer::SerializeObjectPtr(void** ptr, creg::Class* objCla
 			obj = &objects.back();
 			ptrToId[*ptr].push_back(obj);
 			pendingObjects.push_back(obj);
+			obj->isPending = true;
 		}
 		id = obj->id;
 
@@ -297,11 +304,23 @@ void COutputStreamSerializer::SavePackage(std::ostream* s, void* rootObj, Class*
 	obj = &objects.back();
 	ptrToId[rootObj].push_back(obj);
 	pendingObjects.push_back(obj);
+	obj->isPending = true;
+
+	std::vector<ObjectRef*> po;
 
 	// Save until all the referenced objects have been stored
 	while (!pendingObjects.empty())
 	{
-		const std::vector<ObjectRef*> po = pendingObjects;
+		po.clear();
+
+		for (ObjectRef* obj: pendingObjects) {
+			if (!obj->isPending)
+				continue;
+
+			obj->isPending = false;
+			po.push_back(obj);
+		}
+
 		pendingObjects.clear();
 
 		for (ObjectRef* obj: po) {
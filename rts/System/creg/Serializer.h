@@ -13,6 +13,8 @@
 #include <deque>
 #include <istream>
 
+#include "System/UnorderedMap.hpp"
+
 namespace creg {
 
 	/**
@@ -39,6 +41,7 @@ namespace creg {
 				id=0;
 				classIndex=0;
 				isEmbedded=false;
+				isPending=false;
 				class_=0;
 			}
 			ObjectRef(void* ptr, int id, bool isEmbedded, Class* class_) {
@@ -46,6 +49,7 @@ namespace creg {
 				this->id=id;
 				classIndex=0;
 				this->isEmbedded=isEmbedded;
+				this->isPending=false;
 				this->class_=class_;
 			}
 			ObjectRef(const ObjectRef&src) :memberGroups(src.memberGroups){
@@ -53,11 +57,13 @@ namespace creg {
 				id=src.id;
 				classIndex=src.classIndex;
 				isEmbedded=src.isEmbedded;
+				isPending=src.isPending;
 				class_=src.class_;
 			}
 			void* ptr;
 			int id, classIndex;
 			bool isEmbedded;
+			bool isPending; // true while listed (and not yet saved) in pendingObjects
 			Class* class_;
 			std::vector<COutputStreamSerializer::ObjectMemberGroup> memberGroups;
 			bool isThisObject(void* objPtr, Class* objClass, bool objEmbedded) const
@@ -81,11 +87,11 @@ namespace creg {
 		struct ClassRef;
 
 		std::ostream* stream;
-		std::map<void*,std::vector<ObjectRef*> > ptrToId;
+		spring::unordered_map<void*, std::vector<ObjectRef*> > ptrToId;
 		std::deque<ObjectRef> objects;
-		std::vector<ObjectRef*> pendingObjects; // these objects still have to be saved
-		std::map<Class*, int> classSizes;
-		std::map<Class*, int> classCounts;
+		std::vector<ObjectRef*> pendingObjects; // these objects still have to be saved, unless no longer isPending
+		spring::unordered_map<Class*, int> classSizes;
+		spring::unordered_map<Class*, int> classCounts;
 
 		// Serialize all class names
 		void WriteObjectInfo();
@@ -190,10 +190,20 @@ int main(int argc, char* argv[])
 				dsGameData->SetMapChecksum(&archiveScanner->GetArchiveCompleteChecksumBytes(dsGameSetup->mapName)[0]);
 
 				CFileHandler f("maps/" + dsGameSetup->mapName);
-				if (!f.FileExists())
+				const bool addMapArchives = !f.FileExists();
+
+				if (addMapArchives)
 					vfsHandler->AddArchiveWithDeps(dsGameSetup->mapName, false);
 
 				dsGameSetup->LoadStartPositions(); // full mode
+
+				// the server never reads map content again; release the archives
+				// (and their index / decompression buffers) for the whole game
+				if (addMapArchives) {
+					for (const std::string& archiveName: archiveScanner->GetAllArchivesUsedBy(dsGameSetup->mapName)) {
+						vfsHandler->RemoveArchive(archiveName);
+					}
+				}
 			}
 
 			if (std::find_if(dsModChecksum.begin(), dsModChecksum.end(), hashPred) != dsModChecksum.end()) {
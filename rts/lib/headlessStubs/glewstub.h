@@ -58,6 +58,7 @@ extern "C" {
 #define GLEW_ARB_vertex_array_object GL_FALSE
 #define GLEW_ARB_vertex_shader GL_FALSE
 #define GLEW_ARB_vertex_program GL_FALSE
+#define GLEW_ARB_get_program_binary GL_FALSE
 #define GLEW_ARB_shader_objects GL_FALSE
 #define GLEW_ARB_shading_language_100 GL_FALSE
 #define GLEW_ARB_fragment_shader GL_FALSE
@@ -55,6 +55,8 @@ GLAPI void APIENTRY glProgramParameteriEXT(GLuint program, GLenum pname, GLint v
 GLAPI void APIENTRY glLinkProgram(GLuint program) {}
 GLAPI void APIENTRY glGetProgramiv(GLuint program, GLenum pname, GLint *params) {}
 GLAPI void APIENTRY glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog) {}
+GLAPI void APIENTRY glGetProgramBinary(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary) {}
+GLAPI void APIENTRY glProgramBinary(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length) {}
 
 GLAPI void APIENTRY glMultiTexCoord2fARB(GLenum target, GLfloat s, GLfloat t) {}
 GLAPI void APIENTRY glPointParameterf(GLenum pname, GLfloat param) {}
@@ -74,6 +76,7 @@ GLAPI void APIENTRY glGetQueryObjectuiv(GLuint id, GLenum pname, GLuint *params)
 GLAPI void APIENTRY glGetQueryObjectiv(GLuint id, GLenum pname, GLint* params) {}
 GLAPI void APIENTRY glGetQueryObjectui64v(GLuint id, GLenum pname, GLuint64* params) {}
 GLAPI void APIENTRY glQueryCounter(GLuint id, GLenum target) {}
+GLAPI void APIENTRY glGetInteger64v(GLenum pname, GLint64* data) {}
 GLAPI GLint APIENTRY glGetUniformLocation(GLuint program, const GLchar *name) {
 	return 0;
 }
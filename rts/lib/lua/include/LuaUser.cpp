@@ -294,6 +294,8 @@ void* spring_lua_alloc(void* ud, void* ptr, size_t osize, size_t nsize)
 	las->numLuaAllocs += 1;
 	las->luaAllocTime += (t1 - t0).toMicroSecsi();
 
+	lcd->profileState.AddAlloc(osize, nsize);
+
 	return mem;
 }
 
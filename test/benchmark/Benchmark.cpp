@@ -0,0 +1,184 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+static constexpr double SAMPLE_TIME = 10.0e6; // ns
+static constexpr size_t NUM_SAMPLES = 21;
+
+struct BenchmarkCase {
+	const char* name;
+	bench::BenchmarkFunc func;
+};
+
+struct BenchmarkResult {
+	std::string name;
+	double median; // ns/iteration
+	double mad;
+	double min;
+};
+
+
+static std::vector<BenchmarkCase>& GetCases()
+{
+	static std::vector<BenchmarkCase> cases;
+	return cases;
+}
+
+bench::Registrar::Registrar(const char* name, BenchmarkFunc func)
+{
+	GetCases().push_back({name, func});
+}
+
+
+static double Median(std::vector<double> v)
+{
+	std::sort(v.begin(), v.end());
+	return ((v.size() & 1) != 0)? v[v.size() / 2]: (v[v.size() / 2 - 1] + v[v.size() / 2]) * 0.5;
+}
+
+static double RunSample(const BenchmarkCase& c, size_t numIters)
+{
+	bench::State state(numIters);
+	c.func(state);
+	return (state.GetElapsedNanos() / numIters);
+}
+
+static BenchmarkResult RunCase(const BenchmarkCase& c)
+{
+	// grow the iteration count until one sample takes long enough to time reliably
+	size_t numIters = 1;
+
+	for (double t = 0.0; numIters < (size_t(1) << 30); numIters *= 2) {
+		if ((t = RunSample(c, numIters) * numIters) >= SAMPLE_TIME * 0.1) {
+			numIters = std::max(size_t(1), size_t(numIters * (SAMPLE_TIME / t)));
+			break;
+		}
+	}
+
+	std::vector<double> samples(NUM_SAMPLES);
+	std::vector<double> deviations(NUM_SAMPLES);
+
+	for (double& s: samples) {
+		s = RunSample(c, numIters);
+	}
+
+	const double median = Median(samples);
+
+	for (size_t i = 0; i < NUM_SAMPLES; i++) {
+		deviations[i] = std::fabs(samples[i] - median);
+	}
+
+	return {c.name, median, Median(deviations), *std::min_element(samples.begin(), samples.end())};
+}
+
+
+// one "<median ns>\t<name>" line per benchmark
+static std::map<std::string, double> LoadBaseline(const char* file)
+{
+	std::map<std::string, double> baseline;
+	std::ifstream fs(file);
+	std::string name;
+	double median = 0.0;
+
+	while (fs >> median && std::getline(fs >> std::ws, name)) {
+		baseline[name] = median;
+	}
+
+	return baseline;
+}
+
+static void SaveBaseline(const char* file, const std::vector<BenchmarkResult>& results)
+{
+	std::ofstream fs(file);
+
+	for (const BenchmarkResult& r: results) {
+		fs << r.median << '\t' << r.name << '\n';
+	}
+}
+
+
+static void PrintUsage(const char* exe)
+{
+	printf("usage: %s [--filter <substring>] [--baseline <file>] [--save <file>] [--threshold <percent>]\n", exe);
+	printf("  --filter     only run benchmarks whose name contains <substring>\n");
+	printf("  --baseline   compare medians against a file written by --save\n");
+	printf("  --save       write the medians of this run to <file>\n");
+	printf("  --threshold  slowdown relative to the baseline counted as a regression (default 10)\n");
+}
+
+int main(int argc, char** argv)
+{
+	const char* filter = "";
+	const char* baselineFile = nullptr;
+	const char* saveFile = nullptr;
+	double threshold = 10.0;
+
+	for (int i = 1; i < argc; i++) {
+		const bool hasValue = (i + 1 < argc);
+
+		if (hasValue && strcmp(argv[i], "--filter") == 0) {
+			filter = argv[++i];
+		} else if (hasValue && strcmp(argv[i], "--baseline") == 0) {
+			baselineFile = argv[++i];
+		} else if (hasValue && strcmp(argv[i], "--save") == 0) {
+			saveFile = argv[++i];
+		} else if (hasValue && strcmp(argv[i], "--threshold") == 0) {
+			threshold = atof(argv[++i]);
+		} else {
+			PrintUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	const std::map<std::string, double> baseline = (baselineFile != nullptr)? LoadBaseline(baselineFile): std::map<std::string, double>{};
+
+	std::vector<BenchmarkCase> cases = GetCases();
+	std::vector<BenchmarkResult> results;
+
+	std::sort(cases.begin(), cases.end(), [](const BenchmarkCase& a, const BenchmarkCase& b) { return (strcmp(a.name, b.name) < 0); });
+
+	int numRegressions = 0;
+
+	printf("%-48s %14s %10s %14s %10s\n", "benchmark", "median ns/it", "mad %", "min ns/it", "baseline");
+
+	for (const BenchmarkCase& c: cases) {
+		if (strstr(c.name, filter) == nullptr)
+			continue;
+
+		results.push_back(RunCase(c));
+
+		const BenchmarkResult& r = results.back();
+		const auto iter = baseline.find(r.name);
+
+		printf("%-48s %14.2f %10.2f %14.2f", r.name.c_str(), r.median, r.mad * 100.0 / std::max(r.median, 1e-9), r.min);
+
+		if (iter == baseline.end()) {
+			printf(" %10s\n", "-");
+			continue;
+		}
+
+		const double change = (r.median / std::max(iter->second, 1e-9) - 1.0) * 100.0;
+		const bool regressed = (change > threshold);
+
+		printf(" %+9.1f%%%s\n", change, regressed? " REGRESSION": "");
+		numRegressions += regressed;
+	}
+
+	if (saveFile != nullptr)
+		SaveBaseline(saveFile, results);
+
+	if (numRegressions > 0)
+		printf("%d benchmark(s) regressed by more than %.1f%%\n", numRegressions, threshold);
+
+	return ((numRegressions > 0)? EXIT_FAILURE: EXIT_SUCCESS);
+}
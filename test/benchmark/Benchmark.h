@@ -0,0 +1,86 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#ifndef SPRING_BENCHMARK_H
+#define SPRING_BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Minimal micro-benchmark harness for spring-benchmarks.
+ *
+ * A benchmark body does its setup first and then times its hot loop:
+ *
+ *   BENCHMARK_CASE("Foo::Bar") {
+ *     Foo foo;
+ *     while (state.KeepRunning())
+ *       bench::DoNotOptimize(foo.Bar());
+ *   }
+ *
+ * The harness calls the body repeatedly. Each call is one sample: the
+ * harness picks an iteration count so that a sample lasts about
+ * SAMPLE_TIME, and only the time from the first KeepRunning() until the
+ * last one counts. Samples are summarized by median and median absolute
+ * deviation, which are much less sensitive to scheduler noise than mean
+ * and standard deviation.
+ */
+namespace bench {
+	using Clock = std::chrono::steady_clock;
+
+	class State {
+	public:
+		explicit State(size_t n): numIterations(n) {}
+
+		bool KeepRunning() {
+			if (numDone == 0)
+				startTime = Clock::now();
+
+			if (numDone == numIterations) {
+				endTime = Clock::now();
+				return false;
+			}
+
+			numDone += 1;
+			return true;
+		}
+
+		size_t GetIterations() const { return numIterations; }
+		double GetElapsedNanos() const { return std::chrono::duration<double, std::nano>(endTime - startTime).count(); }
+
+	private:
+		size_t numIterations = 0;
+		size_t numDone = 0;
+
+		Clock::time_point startTime;
+		Clock::time_point endTime;
+	};
+
+	typedef void (*BenchmarkFunc)(State&);
+
+	struct Registrar {
+		Registrar(const char* name, BenchmarkFunc func);
+	};
+
+	/// keeps the compiler from discarding a computed value
+	template<typename T> inline void DoNotOptimize(const T& value) {
+		#if defined(__GNUC__)
+		asm volatile("" : : "r,m"(value) : "memory");
+		#else
+		static volatile const T* sink;
+		sink = &value;
+		#endif
+	}
+}
+
+#define BENCHMARK_CONCAT_(a, b) a ## b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_(a, b)
+
+#define BENCHMARK_CASE_(name, func)                                   \
+	static void func(bench::State& state);                            \
+	static const bench::Registrar BENCHMARK_CONCAT(func, Reg)(name, func); \
+	static void func(bench::State& state)
+
+#define BENCHMARK_CASE(name) BENCHMARK_CASE_(name, BENCHMARK_CONCAT(BenchmarkCase, __LINE__))
+
+#endif // SPRING_BENCHMARK_H
@@ -0,0 +1,89 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "Benchmark.h"
+
+#include "System/BatchMath.h"
+#include "System/float3.h"
+#include "System/Matrix44f.h"
+
+#include <random>
+#include <vector>
+
+static constexpr size_t NUM_VECTORS = 4096;
+
+struct SoA {
+	SoA(): xs(NUM_VECTORS), ys(NUM_VECTORS), zs(NUM_VECTORS) {
+		std::mt19937 rng(1);
+		std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+
+		for (size_t i = 0; i < NUM_VECTORS; i++) {
+			xs[i] = dist(rng);
+			ys[i] = dist(rng);
+			zs[i] = dist(rng);
+		}
+	}
+
+	std::vector<float> xs;
+	std::vector<float> ys;
+	std::vector<float> zs;
+};
+
+static const CMatrix44f TRANSFORM(float3(10.0f, -20.0f, 30.0f), float3(0.6f, 0.8f, 0.0f), float3(0.0f, 0.0f, 1.0f), float3(-0.8f, 0.6f, 0.0f));
+
+
+BENCHMARK_CASE("BatchMath::Transform x4096 (scalar)")
+{
+	SoA v;
+	SoA o;
+
+	while (state.KeepRunning()) {
+		for (size_t i = 0; i < NUM_VECTORS; i++) {
+			const float3 p = TRANSFORM * float3(v.xs[i], v.ys[i], v.zs[i]);
+
+			o.xs[i] = p.x;
+			o.ys[i] = p.y;
+			o.zs[i] = p.z;
+		}
+
+		bench::DoNotOptimize(o.xs.data());
+	}
+}
+
+BENCHMARK_CASE("BatchMath::Transform x4096")
+{
+	SoA v;
+	SoA o;
+
+	while (state.KeepRunning()) {
+		BatchMath::Transform(TRANSFORM, v.xs.data(), v.ys.data(), v.zs.data(), o.xs.data(), o.ys.data(), o.zs.data(), NUM_VECTORS);
+		bench::DoNotOptimize(o.xs.data());
+	}
+}
+
+BENCHMARK_CASE("BatchMath::SafeNormalize x4096 (scalar)")
+{
+	SoA v;
+
+	while (state.KeepRunning()) {
+		for (size_t i = 0; i < NUM_VECTORS; i++) {
+			float3 p(v.xs[i], v.ys[i], v.zs[i]);
+			p.SafeNormalize();
+
+			v.xs[i] = p.x;
+			v.ys[i] = p.y;
+			v.zs[i] = p.z;
+		}
+
+		bench::DoNotOptimize(v.xs.data());
+	}
+}
+
+BENCHMARK_CASE("BatchMath::SafeNormalize x4096")
+{
+	SoA v;
+
+	while (state.KeepRunning()) {
+		BatchMath::SafeNormalize(v.xs.data(), v.ys.data(), v.zs.data(), NUM_VECTORS);
+		bench::DoNotOptimize(v.xs.data());
+	}
+}
@@ -0,0 +1,150 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "Benchmark.h"
+
+#include "System/SmallVectorMap.h"
+#include "System/SparseIDSet.h"
+#include "System/UnorderedMap.hpp"
+#include "System/UnorderedSet.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// ID spaces and occupancy like the feature handler sees on a typical map:
+// IDs come from a shuffled pool, so live IDs are spread over the full range
+static constexpr int MAX_IDS = 32000;
+static constexpr int NUM_LIVE_IDS = 8000;
+static constexpr size_t NUM_OPS = 4096;
+
+// selections and groups: a few hundred IDs
+static constexpr int NUM_SELECTED_IDS = 200;
+
+// per-player AI links: loopback plus a couple of AIs
+static constexpr int NUM_SMALL_KEYS = 3;
+
+struct IDStream {
+	IDStream(int numLive, unsigned int seed) {
+		std::mt19937 rng(seed);
+		std::vector<int> pool(MAX_IDS);
+
+		for (int i = 0; i < MAX_IDS; i++) {
+			pool[i] = i;
+		}
+
+		std::shuffle(pool.begin(), pool.end(), rng);
+
+		live.assign(pool.begin(), pool.begin() + numLive);
+		free.assign(pool.begin() + numLive, pool.end());
+
+		std::uniform_int_distribution<int> liveDist(0, numLive - 1);
+		std::uniform_int_distribution<int> freeDist(0, MAX_IDS - numLive - 1);
+
+		for (size_t i = 0; i < NUM_OPS; i++) {
+			lookups.push_back(((i & 1) == 0)? live[liveDist(rng)]: free[freeDist(rng)]);
+		}
+	}
+
+	std::vector<int> live;
+	std::vector<int> free;
+	std::vector<int> lookups; // half hits, half misses
+};
+
+
+template<typename Set> static void FindIDs(bench::State& state, int numLive)
+{
+	const IDStream ids(numLive, 1);
+
+	Set set;
+	set.reserve(MAX_IDS);
+
+	for (const int id: ids.live) {
+		set.insert(id);
+	}
+
+	size_t i = 0;
+
+	while (state.KeepRunning()) {
+		bench::DoNotOptimize(set.find(ids.lookups[(i++) % NUM_OPS]) != set.end());
+	}
+}
+
+template<typename Set> static void ChurnIDs(bench::State& state)
+{
+	const IDStream ids(NUM_LIVE_IDS, 2);
+
+	Set set;
+	set.reserve(MAX_IDS);
+
+	for (const int id: ids.live) {
+		set.insert(id);
+	}
+
+	size_t i = 0;
+
+	// remove one live ID and add it back, like features being destroyed and created
+	while (state.KeepRunning()) {
+		const int id = ids.live[(i++) % ids.live.size()];
+
+		set.erase(id);
+		set.insert(id);
+	}
+}
+
+template<typename Set> static void IterateIDs(bench::State& state)
+{
+	const IDStream ids(NUM_LIVE_IDS, 3);
+
+	Set set;
+	set.reserve(MAX_IDS);
+
+	for (const int id: ids.live) {
+		set.insert(id);
+	}
+
+	while (state.KeepRunning()) {
+		int sum = 0;
+
+		for (const int id: set) {
+			sum += id;
+		}
+
+		bench::DoNotOptimize(sum);
+	}
+}
+
+template<typename Map> static void FindSmallKeys(bench::State& state)
+{
+	Map map;
+
+	for (int k = 0; k < NUM_SMALL_KEYS; k++) {
+		map[uint8_t(255 - k)] = k;
+	}
+
+	std::mt19937 rng(4);
+	std::uniform_int_distribution<int> dist(0, NUM_SMALL_KEYS - 1);
+	std::vector<uint8_t> keys(NUM_OPS);
+
+	for (uint8_t& k: keys) {
+		k = 255 - dist(rng);
+	}
+
+	size_t i = 0;
+
+	while (state.KeepRunning()) {
+		bench::DoNotOptimize(map.find(keys[(i++) % NUM_OPS])->second);
+	}
+}
+
+
+BENCHMARK_CASE("Containers::find features (unordered_set)") { FindIDs<spring::unordered_set<int>>(state, NUM_LIVE_IDS); }
+BENCHMARK_CASE("Containers::find features (SparseIDSet)") { FindIDs<spring::SparseIDSet>(state, NUM_LIVE_IDS); }
+BENCHMARK_CASE("Containers::find selection (unordered_set)") { FindIDs<spring::unordered_set<int>>(state, NUM_SELECTED_IDS); }
+BENCHMARK_CASE("Containers::find selection (SparseIDSet)") { FindIDs<spring::SparseIDSet>(state, NUM_SELECTED_IDS); }
+BENCHMARK_CASE("Containers::erase+insert features (unordered_set)") { ChurnIDs<spring::unordered_set<int>>(state); }
+BENCHMARK_CASE("Containers::erase+insert features (SparseIDSet)") { ChurnIDs<spring::SparseIDSet>(state); }
+BENCHMARK_CASE("Containers::iterate features (unordered_set)") { IterateIDs<spring::unordered_set<int>>(state); }
+BENCHMARK_CASE("Containers::iterate features (SparseIDSet)") { IterateIDs<spring::SparseIDSet>(state); }
+BENCHMARK_CASE("Containers::find AI links (unordered_map)") { FindSmallKeys<spring::unordered_map<uint8_t, int>>(state); }
+BENCHMARK_CASE("Containers::find AI links (SmallVectorMap)") { FindSmallKeys<spring::SmallVectorMap<uint8_t, int>>(state); }
@@ -0,0 +1,71 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "Benchmark.h"
+
+#include "Lua/LuaMemPool.h"
+
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static constexpr size_t NUM_LIVE_ALLOCS = 4096;
+
+// mostly small blocks like the Lua allocator sees (strings, tables, closures)
+static std::vector<size_t> RandomSizes()
+{
+	std::mt19937 rng(1);
+	std::geometric_distribution<size_t> dist(1.0 / 48.0);
+
+	std::vector<size_t> sizes(NUM_LIVE_ALLOCS);
+
+	for (size_t& s: sizes) {
+		s = 8 + dist(rng);
+	}
+
+	return sizes;
+}
+
+
+BENCHMARK_CASE("LuaMemPool::Alloc+Free")
+{
+	static LuaMemPool* pool = (LuaMemPool::InitStatic(true), LuaMemPool::GetSharedPtr());
+
+	const std::vector<size_t> sizes = RandomSizes();
+	std::vector<void*> ptrs(NUM_LIVE_ALLOCS, nullptr);
+
+	size_t i = 0;
+
+	while (state.KeepRunning()) {
+		const size_t j = (i++) % NUM_LIVE_ALLOCS;
+
+		if (ptrs[j] != nullptr)
+			pool->Free(ptrs[j], sizes[j]);
+
+		bench::DoNotOptimize(ptrs[j] = pool->Alloc(sizes[j]));
+	}
+
+	for (size_t j = 0; j < NUM_LIVE_ALLOCS; j++) {
+		if (ptrs[j] != nullptr)
+			pool->Free(ptrs[j], sizes[j]);
+	}
+}
+
+// reference for the above
+BENCHMARK_CASE("LuaMemPool::malloc+free")
+{
+	const std::vector<size_t> sizes = RandomSizes();
+	std::vector<void*> ptrs(NUM_LIVE_ALLOCS, nullptr);
+
+	size_t i = 0;
+
+	while (state.KeepRunning()) {
+		const size_t j = (i++) % NUM_LIVE_ALLOCS;
+
+		free(ptrs[j]);
+		bench::DoNotOptimize(ptrs[j] = malloc(sizes[j]));
+	}
+
+	for (void* p: ptrs) {
+		free(p);
+	}
+}
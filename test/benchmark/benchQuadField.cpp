@@ -0,0 +1,85 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "Benchmark.h"
+
+#include "Sim/Misc/GlobalConstants.h"
+#include "Sim/Misc/QuadField.h"
+#include "System/float3.h"
+
+#include <random>
+#include <vector>
+
+// 16x16 map with the default quad size (64x64 quads)
+static constexpr int MAP_SQUARES = 1024;
+static constexpr size_t NUM_QUERIES = 1024;
+
+static std::vector<float3> RandomPositions(unsigned int seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> dist(0.0f, MAP_SQUARES * SQUARE_SIZE);
+
+	std::vector<float3> positions(NUM_QUERIES);
+
+	for (float3& p: positions) {
+		p = {dist(rng), 0.0f, dist(rng)};
+	}
+
+	return positions;
+}
+
+static void InitQuadField()
+{
+	// normally set by the map loader
+	float3::maxxpos = MAP_SQUARES * SQUARE_SIZE - 1.0f;
+	float3::maxzpos = MAP_SQUARES * SQUARE_SIZE - 1.0f;
+
+	quadField.Init(int2(MAP_SQUARES, MAP_SQUARES), CQuadField::BASE_QUAD_SIZE);
+}
+
+
+BENCHMARK_CASE("QuadField::GetQuads r=500")
+{
+	InitQuadField();
+
+	const std::vector<float3> positions = RandomPositions(1);
+	size_t i = 0;
+
+	while (state.KeepRunning()) {
+		QuadFieldQuery qfQuery;
+		quadField.GetQuads(qfQuery, positions[(i++) % NUM_QUERIES], 500.0f);
+		bench::DoNotOptimize(qfQuery.quads->size());
+	}
+}
+
+BENCHMARK_CASE("QuadField::GetQuadsRectangle 1000x1000")
+{
+	InitQuadField();
+
+	const std::vector<float3> positions = RandomPositions(2);
+	size_t i = 0;
+
+	while (state.KeepRunning()) {
+		const float3& p = positions[(i++) % NUM_QUERIES];
+
+		QuadFieldQuery qfQuery;
+		quadField.GetQuadsRectangle(qfQuery, p, p + float3(1000.0f, 0.0f, 1000.0f));
+		bench::DoNotOptimize(qfQuery.quads->size());
+	}
+}
+
+BENCHMARK_CASE("QuadField::GetQuadsOnRay l=2000")
+{
+	InitQuadField();
+
+	const std::vector<float3> positions = RandomPositions(3);
+	const std::vector<float3> targets = RandomPositions(4);
+	size_t i = 0;
+
+	while (state.KeepRunning()) {
+		const size_t j = (i++) % NUM_QUERIES;
+
+		QuadFieldQuery qfQuery;
+		quadField.GetQuadsOnRay(qfQuery, positions[j], (targets[j] - positions[j]).SafeNormalize2D(), 2000.0f);
+		bench::DoNotOptimize(qfQuery.quads->size());
+	}
+}
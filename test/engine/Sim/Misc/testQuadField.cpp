@@ -6,6 +6,8 @@
 #include <stdlib.h>
 #include <time.h>
 
+#include <chrono>
+
 #define CATCH_CONFIG_MAIN
 #include "lib/catch.hpp"
 
@@ -99,3 +101,92 @@ TEST_CASE("QuadField")
 	INFO("Too little quads returned!");
 	CHECK_FALSE(fail);
 }
+
+
+
+TEST_CASE("QuadFieldQuadSize")
+{
+	// 16x16 map: 8192 elmos per side
+	CHECK(CQuadField::CalcQuadSize(int2(1024, 1024),    0) == CQuadField::BASE_QUAD_SIZE);
+	CHECK(CQuadField::CalcQuadSize(int2(1024, 1024),   64) ==   64);
+	CHECK(CQuadField::CalcQuadSize(int2(1024, 1024),  100) ==   64);
+	CHECK(CQuadField::CalcQuadSize(int2(1024, 1024), 4096) == CQuadField::MAX_QUAD_SIZE);
+	CHECK(CQuadField::CalcQuadSize(int2(1024, 1024),    1) == SQUARE_SIZE);
+	// must divide odd map sizes (3 and 5 squares) evenly
+	CHECK(CQuadField::CalcQuadSize(int2(3, 5), 0) == SQUARE_SIZE);
+	// default grows on huge maps, explicit sizes are kept
+	CHECK(CQuadField::CalcQuadSize(int2(8192, 8192),  0) == 256);
+	CHECK(CQuadField::CalcQuadSize(int2(8192, 8192), 64) ==  64);
+}
+
+
+TEST_CASE("QuadFieldQueryBenchmark")
+{
+	srand(1);
+
+	static constexpr int MAP_SIZE = 1024; // squares
+	static constexpr int NUM_QUERIES = 20000;
+
+	struct Query {
+		float3 pos;
+		float3 dir;
+		float radius;
+	};
+
+	std::vector<Query> queries(NUM_QUERIES);
+
+	float3::maxxpos = MAP_SIZE * SQUARE_SIZE - 1;
+	float3::maxzpos = MAP_SIZE * SQUARE_SIZE - 1;
+
+	// mix of projectile-, unit- and explosion-sized areas plus weapon-range rays
+	for (Query& q: queries) {
+		q.pos = float3(randf() * MAP_SIZE * SQUARE_SIZE, 0.0f, randf() * MAP_SIZE * SQUARE_SIZE);
+		q.dir = float3(randf() - 0.5f, 0.0f, randf() - 0.5f).SafeNormalize();
+		q.radius = std::pow(randf(), 3.0f) * 1000.0f + 8.0f;
+	}
+
+	for (int quadSize = 32; quadSize <= 512; quadSize *= 2) {
+		quadField.Kill();
+		quadField.Init(int2(MAP_SIZE, MAP_SIZE), CQuadField::CalcQuadSize(int2(MAP_SIZE, MAP_SIZE), quadSize));
+
+		size_t numQuads[3] = {0, 0, 0};
+
+		const auto t0 = std::chrono::steady_clock::now();
+
+		for (const Query& q: queries) {
+			QuadFieldQuery qfQuery;
+			quadField.GetQuads(qfQuery, q.pos, q.radius);
+			numQuads[0] += qfQuery.quads->size();
+		}
+
+		const auto t1 = std::chrono::steady_clock::now();
+
+		for (const Query& q: queries) {
+			QuadFieldQuery qfQuery;
+			quadField.GetQuadsRectangle(qfQuery, q.pos - float3(q.radius, 0.0f, q.radius), q.pos + float3(q.radius, 0.0f, q.radius));
+			numQuads[1] += qfQuery.quads->size();
+		}
+
+		const auto t2 = std::chrono::steady_clock::now();
+
+		for (const Query& q: queries) {
+			QuadFieldQuery qfQuery;
+			quadField.GetQuadsOnRay(qfQuery, q.pos, q.dir, q.radius);
+			numQuads[2] += qfQuery.quads->size();
+		}
+
+		const auto t3 = std::chrono::steady_clock::now();
+
+		const auto us = [](const auto& a, const auto& b) { return int(std::chrono::duration_cast<std::chrono::microseconds>(b - a).count()); };
+
+		printf("[QuadFieldQueryBenchmark] quadSize=%4d circle=%6dus (%7u quads) rect=%6dus (%7u quads) ray=%6dus (%7u quads)\n",
+			quadField.GetQuadSizeX(),
+			us(t0, t1), unsigned(numQuads[0]),
+			us(t1, t2), unsigned(numQuads[1]),
+			us(t2, t3), unsigned(numQuads[2])
+		);
+
+		CHECK(numQuads[0] >= queries.size());
+		CHECK(numQuads[2] >= queries.size());
+	}
+}
@@ -0,0 +1,61 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#define CATCH_CONFIG_MAIN
+#include "lib/catch.hpp"
+
+#include "System/Misc/AllocCounter.h"
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("AllocCounter")
+{
+	REQUIRE(AllocCounter::ENABLED);
+
+	SECTION("counts every allocation") {
+		const std::uint64_t count = AllocCounter::GetThreadCount();
+
+		// new-expressions may legally be elided, direct calls may not
+		void* p = ::operator new(sizeof(int));
+		void* a = ::operator new[](16 * sizeof(int));
+
+		CHECK(AllocCounter::GetThreadCount() == (count + 2));
+
+		::operator delete[](a);
+		::operator delete(p);
+	}
+
+	SECTION("reused storage is free") {
+		std::vector<int> v;
+		v.reserve(64);
+
+		const std::uint64_t count = AllocCounter::GetThreadCount();
+
+		for (int i = 0; i < 64; i++) {
+			v.push_back(i);
+		}
+
+		v.clear();
+		v.push_back(0);
+
+		CHECK(AllocCounter::GetThreadCount() == count);
+	}
+
+	SECTION("counts per thread") {
+		std::uint64_t count = AllocCounter::GetThreadCount();
+		std::uint64_t threadCount = 0;
+
+		std::thread t([&]() {
+			const std::uint64_t c = AllocCounter::GetThreadCount();
+			std::vector<int> v(128);
+			threadCount = AllocCounter::GetThreadCount() - c;
+		});
+
+		// spawning the thread may allocate on this one
+		count = AllocCounter::GetThreadCount();
+		t.join();
+
+		CHECK(threadCount == 1);
+		CHECK(AllocCounter::GetThreadCount() == count);
+	}
+}
@@ -0,0 +1,318 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include "System/Net/UDPConnection.h"
+#include "System/Net/Socket.h"
+#include "Net/Protocol/BaseNetProtocol.h"
+#include "System/Log/ILog.h"
+#include "System/Misc/SpringTime.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <random>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include "lib/catch.hpp"
+
+InitSpringTime ist;
+
+using namespace netcode;
+
+/*
+ * Two UDPConnections talking through an in-process relay which drops,
+ * delays and throttles datagrams. The relay owns one socket per side and
+ * learns each peer address from the first datagram it receives there.
+ * Everything runs in real time on loopback, so each scenario is short.
+ */
+struct LinkParams {
+	float lossRate = 0.0f;       // per datagram
+	int burstLength = 1;         // datagrams dropped in a row once a loss starts
+	int minLatency = 0;          // ms, one-way
+	int maxLatency = 0;          // ms, one-way; uniform jitter in [min, max]
+	int bandwidth = 0;           // bytes per second and direction, 0 is unlimited
+};
+
+class LinkSimulator {
+public:
+	LinkSimulator(const LinkParams& p): params(p), rng(1234) {
+		for (int i = 0; i < 2; i++) {
+			sockets[i].reset(new asio::ip::udp::socket(netservice, asio::ip::udp::endpoint(asio::ip::address_v4::loopback(), 0)));
+			sockets[i]->non_blocking(true);
+		}
+	}
+
+	unsigned int GetPort(int side) const { return sockets[side]->local_endpoint().port(); }
+
+	unsigned int GetNumDropped() const { return numDropped; }
+	unsigned int GetNumForwarded() const { return numForwarded; }
+
+	void Update() {
+		const spring_time now = spring_gettime();
+
+		for (int side = 0; side < 2; side++) {
+			Receive(side, now);
+		}
+
+		while (!inFlight.empty() && inFlight.begin()->first <= now) {
+			const Datagram& d = inFlight.begin()->second;
+			const int dst = 1 - d.srcSide;
+
+			if (havePeer[dst]) {
+				asio::error_code err;
+				sockets[dst]->send_to(asio::buffer(d.data), peers[dst], 0, err);
+				numForwarded += 1;
+			}
+
+			inFlight.erase(inFlight.begin());
+		}
+	}
+
+private:
+	struct Datagram {
+		int srcSide;
+		std::vector<std::uint8_t> data;
+	};
+
+	void Receive(int side, spring_time now) {
+		std::uint8_t buffer[4096];
+		asio::ip::udp::endpoint from;
+		asio::error_code err;
+
+		while (true) {
+			const size_t size = sockets[side]->receive_from(asio::buffer(buffer), from, 0, err);
+
+			if (err)
+				break;
+
+			peers[side] = from;
+			havePeer[side] = true;
+
+			if (droppedInBurst > 0 || lossDist(rng) < params.lossRate) {
+				droppedInBurst = (droppedInBurst + 1) % params.burstLength;
+				numDropped += 1;
+				continue;
+			}
+
+			std::uniform_int_distribution<int> latencyDist(params.minLatency, params.maxLatency);
+			spring_time arrival = now + spring_msecs(latencyDist(rng));
+
+			if (params.bandwidth > 0) {
+				// serialize through a pipe of the given width
+				arrival = std::max(arrival, linkFreeTime[side]);
+				linkFreeTime[side] = arrival + spring_time::fromMicroSecs((size * 1000000LL) / params.bandwidth);
+			}
+
+			inFlight.emplace(arrival, Datagram{side, std::vector<std::uint8_t>(buffer, buffer + size)});
+		}
+	}
+
+private:
+	LinkParams params;
+
+	std::shared_ptr<asio::ip::udp::socket> sockets[2];
+	asio::ip::udp::endpoint peers[2];
+	bool havePeer[2] = {false, false};
+
+	std::multimap<spring_time, Datagram> inFlight;
+	spring_time linkFreeTime[2];
+
+	std::mt19937 rng;
+	std::uniform_real_distribution<float> lossDist{0.0f, 1.0f};
+
+	int droppedInBurst = 0;
+
+	unsigned int numDropped = 0;
+	unsigned int numForwarded = 0;
+};
+
+
+/*
+ * Sequence-numbered message stream over one direction of a connection;
+ * the receiving end checks order and measures send-to-delivery latency.
+ */
+class MessageStream {
+public:
+	void SendFrame(CConnection& conn) {
+		sendTimes.push_back(spring_gettime());
+		conn.SendData(CBaseNetProtocol::Get().SendKeyFrame(sendTimes.size() - 1));
+	}
+
+	// stands in for command blocks and Lua messages, fragmented across chunks
+	void SendBlock(CConnection& conn, unsigned int size) {
+		std::vector<std::uint8_t> payload(std::max(size, 4u), 0);
+		const std::int32_t seq = sendTimes.size();
+
+		std::memcpy(payload.data(), &seq, sizeof(seq));
+		sendTimes.push_back(spring_gettime());
+		conn.SendData(CBaseNetProtocol::Get().SendLuaMsg(0, 0, 0, payload));
+
+		bytesSent += payload.size();
+	}
+
+	void Receive(CConnection& conn) {
+		while (conn.HasIncomingData()) {
+			const std::shared_ptr<const RawPacket> pkt = conn.GetData();
+			std::int32_t seq = -1;
+
+			switch (pkt->data[0]) {
+				case NETMSG_KEYFRAME: { std::memcpy(&seq, pkt->data + 1, sizeof(seq)); } break;
+				case NETMSG_LUAMSG  : { std::memcpy(&seq, pkt->data + 7, sizeof(seq)); } break;
+				default: { continue; } break;
+			}
+
+			numOutOfOrder += (seq != nextSeq);
+			nextSeq = seq + 1;
+
+			if (seq >= 0 && seq < int(sendTimes.size()))
+				latencies.push_back((spring_gettime() - sendTimes[seq]).toMilliSecsf());
+		}
+	}
+
+	bool AllDelivered() const { return (nextSeq == int(sendTimes.size())); }
+
+	float GetLatency(float frac) const {
+		if (latencies.empty())
+			return 0.0f;
+
+		std::vector<float> sorted = latencies;
+		std::sort(sorted.begin(), sorted.end());
+		return sorted[std::min(sorted.size() - 1, size_t(sorted.size() * frac))];
+	}
+
+public:
+	std::vector<spring_time> sendTimes;
+	std::vector<float> latencies;
+
+	int nextSeq = 0;
+	unsigned int numOutOfOrder = 0;
+	unsigned int bytesSent = 0;
+};
+
+
+struct SimResult {
+	bool delivered;
+	unsigned int numOutOfOrder;
+	float frameLatencyP50;
+	float frameLatencyP95;
+	float blockLatencyP95;
+	float throughput; // client to server, KB/s
+};
+
+/*
+ * simulates a game for the given number of 30Hz frames: the "server" sends a
+ * keyframe each frame and a large data block every second, the "client" sends
+ * bursts of command blocks; afterwards waits up to 10s for all data to arrive
+ */
+static SimResult RunSimulation(const char* name, const LinkParams& params, int numFrames)
+{
+	LinkSimulator link(params);
+
+	UDPConnection server(0, "127.0.0.1", link.GetPort(0));
+	UDPConnection client(0, "127.0.0.1", link.GetPort(1));
+
+	server.Unmute();
+	client.Unmute();
+
+	MessageStream serverToClient;
+	MessageStream clientToServer;
+	std::mt19937 rng(5678);
+
+	const spring_time startTime = spring_gettime();
+	spring_time nextFrameTime = startTime;
+
+	int frameNum = 0;
+
+	while ((spring_gettime() - startTime) < spring_secs(numFrames / 30 + 10)) {
+		const spring_time now = spring_gettime();
+
+		if (frameNum < numFrames && now >= nextFrameTime) {
+			serverToClient.SendFrame(server);
+
+			if ((frameNum % 30) == 0)
+				serverToClient.SendBlock(server, 4000);
+
+			// a few frames of heavy orders every couple of seconds
+			const int burstCount = ((frameNum % 60) < 3)? 8: ((rng() % 4) == 0);
+
+			for (int i = 0; i < burstCount; i++) {
+				clientToServer.SendBlock(client, 20 + rng() % 600);
+			}
+
+			nextFrameTime += spring_msecs(33);
+			frameNum += 1;
+		}
+
+		link.Update();
+		server.Update();
+		client.Update();
+
+		serverToClient.Receive(client);
+		clientToServer.Receive(server);
+
+		if (frameNum == numFrames && serverToClient.AllDelivered() && clientToServer.AllDelivered())
+			break;
+
+		spring_sleep(spring_msecs(1));
+	}
+
+	const float elapsed = (spring_gettime() - startTime).toSecsf();
+
+	SimResult r;
+	r.delivered = (serverToClient.AllDelivered() && clientToServer.AllDelivered());
+	r.numOutOfOrder = serverToClient.numOutOfOrder + clientToServer.numOutOfOrder;
+	r.frameLatencyP50 = serverToClient.GetLatency(0.5f);
+	r.frameLatencyP95 = serverToClient.GetLatency(0.95f);
+	r.blockLatencyP95 = clientToServer.GetLatency(0.95f);
+	r.throughput = clientToServer.bytesSent / (elapsed * 1024.0f);
+
+	LOG("[%s] %s: delivered=%d latency{p50=%.1fms p95=%.1fms blocks-p95=%.1fms} %.1fKB/s up, %u/%u datagrams dropped",
+		__func__, name, r.delivered, r.frameLatencyP50, r.frameLatencyP95, r.blockLatencyP95, r.throughput,
+		link.GetNumDropped(), link.GetNumDropped() + link.GetNumForwarded());
+	LOG("%s", client.Statistics().c_str());
+
+	return r;
+}
+
+
+TEST_CASE("UDPConnectionCleanLink")
+{
+	LinkParams params;
+	params.minLatency = 5;
+	params.maxLatency = 5;
+
+	const SimResult r = RunSimulation("clean", params, 90);
+
+	CHECK(r.delivered);
+	CHECK(r.numOutOfOrder == 0);
+	CHECK(r.frameLatencyP95 < 100.0f);
+}
+
+TEST_CASE("UDPConnectionLossyLink")
+{
+	LinkParams params;
+	params.lossRate = 0.1f;
+	params.minLatency = 20;
+	params.maxLatency = 80;
+
+	const SimResult r = RunSimulation("lossy", params, 90);
+
+	// reliability must hold, latency is only reported
+	CHECK(r.delivered);
+	CHECK(r.numOutOfOrder == 0);
+}
+
+TEST_CASE("UDPConnectionBurstLossCappedLink")
+{
+	LinkParams params;
+	params.lossRate = 0.02f;
+	params.burstLength = 5;
+	params.minLatency = 40;
+	params.maxLatency = 60;
+	params.bandwidth = 64 * 1024;
+
+	const SimResult r = RunSimulation("burst-loss+64KB/s", params, 90);
+
+	CHECK(r.delivered);
+	CHECK(r.numOutOfOrder == 0);
+}
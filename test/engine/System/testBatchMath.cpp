@@ -0,0 +1,108 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "System/BatchMath.h"
+#include "System/float3.h"
+#include "System/float4.h"
+#include "System/Matrix44f.h"
+
+#define CATCH_CONFIG_MAIN
+#include "lib/catch.hpp"
+
+
+// odd count so the scalar tail is exercised for every SIMD width
+static constexpr size_t NUM_VECTORS = 1027;
+
+struct SoA {
+	SoA(size_t n): xs(n), ys(n), zs(n) {}
+
+	float3 Get(size_t i) const { return {xs[i], ys[i], zs[i]}; }
+
+	std::vector<float> xs;
+	std::vector<float> ys;
+	std::vector<float> zs;
+};
+
+static SoA RandomVectors(unsigned int seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+
+	SoA v(NUM_VECTORS);
+
+	for (size_t i = 0; i < NUM_VECTORS; i++) {
+		v.xs[i] = dist(rng);
+		v.ys[i] = dist(rng);
+		v.zs[i] = dist(rng);
+	}
+
+	// degenerate inputs
+	v.xs[0] = 0.0f; v.ys[0] = 0.0f; v.zs[0] = 0.0f;
+	v.xs[1] = 1e-7f; v.ys[1] = 0.0f; v.zs[1] = 0.0f;
+	return v;
+}
+
+static bool BitEqual(const float3& a, const float3& b) { return (std::memcmp(&a.x, &b.x, sizeof(float) * 3) == 0); }
+static bool BitEqual(float a, float b) { return (std::memcmp(&a, &b, sizeof(float)) == 0); }
+
+
+TEST_CASE("BatchMath_Dot")
+{
+	const SoA a = RandomVectors(1);
+	const SoA b = RandomVectors(2);
+
+	std::vector<float> out(NUM_VECTORS);
+	BatchMath::Dot(a.xs.data(), a.ys.data(), a.zs.data(), b.xs.data(), b.ys.data(), b.zs.data(), out.data(), NUM_VECTORS);
+
+	for (size_t i = 0; i < NUM_VECTORS; i++) {
+		CHECK(BitEqual(out[i], a.Get(i).dot(b.Get(i))));
+	}
+}
+
+TEST_CASE("BatchMath_Cross")
+{
+	const SoA a = RandomVectors(3);
+	const SoA b = RandomVectors(4);
+
+	SoA out(NUM_VECTORS);
+	BatchMath::Cross(a.xs.data(), a.ys.data(), a.zs.data(), b.xs.data(), b.ys.data(), b.zs.data(), out.xs.data(), out.ys.data(), out.zs.data(), NUM_VECTORS);
+
+	for (size_t i = 0; i < NUM_VECTORS; i++) {
+		CHECK(BitEqual(out.Get(i), a.Get(i).cross(b.Get(i))));
+	}
+}
+
+TEST_CASE("BatchMath_SafeNormalize")
+{
+	const SoA a = RandomVectors(5);
+
+	SoA out = a;
+	BatchMath::SafeNormalize(out.xs.data(), out.ys.data(), out.zs.data(), NUM_VECTORS);
+
+	for (size_t i = 0; i < NUM_VECTORS; i++) {
+		CHECK(BitEqual(out.Get(i), a.Get(i).SafeNormalize()));
+	}
+}
+
+TEST_CASE("BatchMath_Transform")
+{
+	const SoA a = RandomVectors(6);
+	const CMatrix44f m(float3(10.0f, -20.0f, 30.0f), float3(0.6f, 0.8f, 0.0f), float3(0.0f, 0.0f, 1.0f), float3(-0.8f, 0.6f, 0.0f));
+
+	SoA out(NUM_VECTORS);
+
+	BatchMath::Transform(m, a.xs.data(), a.ys.data(), a.zs.data(), out.xs.data(), out.ys.data(), out.zs.data(), NUM_VECTORS, 1.0f);
+
+	for (size_t i = 0; i < NUM_VECTORS; i++) {
+		CHECK(BitEqual(out.Get(i), m * a.Get(i)));
+	}
+
+	BatchMath::Transform(m, a.xs.data(), a.ys.data(), a.zs.data(), out.xs.data(), out.ys.data(), out.zs.data(), NUM_VECTORS, 0.0f);
+
+	for (size_t i = 0; i < NUM_VECTORS; i++) {
+		CHECK(BitEqual(out.Get(i), m * float4(a.Get(i), 0.0f)));
+	}
+}
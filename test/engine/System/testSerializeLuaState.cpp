@@ -65,7 +65,8 @@ TEST_CASE("SerializeLuaState")
 	creg::AutoRegisterCFunctions("Test::", flh.L);
 	flh.L_GC = lua_newthread(flh.L);
 	int idx = luaL_ref(flh.L, LUA_REGISTRYINDEX);
-	const char* code = "local co = coroutine.create(function ()\n local function f()\n coroutine.yield()\n end\n f()\n end);\ncoroutine.resume(co);\n";
+	const char* code = "local co = coroutine.create(function ()\n local function f()\n coroutine.yield()\n end\n f()\n end);\ncoroutine.resume(co);\n"
+	                   "t = {1, 2, 3, a = 'x', b = {c = 4}, f = string.format, g = string.format}\n";
 
 	int err = luaL_loadbuffer(flh.L, code, strlen(code), "yield");
 	if (err)
@@ -97,5 +98,10 @@ TEST_CASE("SerializeLuaState")
 	lua_State* L_GC = lua_tothread(flh.L, -1);
 	CHECK(L_GC == flh.L_GC);
 
+	const char* check = "return (t[3] + t.b.c == 7 and t.a == 'x' and t.f == t.g and t.f('%d', 5) == '5')";
+	CHECK(luaL_loadbuffer(flh.L, check, strlen(check), "check") == 0);
+	CHECK(lua_pcall(flh.L, 0, 1, 0) == 0);
+	CHECK(lua_toboolean(flh.L, -1));
+
 	lua_close(flh.L);
 }
\ No newline at end of file
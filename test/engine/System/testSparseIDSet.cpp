@@ -0,0 +1,92 @@
+/* This file is part of the Spring engine (GPL v2 or later), see LICENSE.html */
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "System/SmallVectorMap.h"
+#include "System/SparseIDSet.h"
+
+#define CATCH_CONFIG_MAIN
+#include "lib/catch.hpp"
+
+
+TEST_CASE("SparseIDSet")
+{
+	spring::SparseIDSet s;
+
+	CHECK(s.empty());
+	CHECK(s.find(0) == s.end());
+	CHECK(s.find(-1) == s.end());
+	CHECK(s.find(1000) == s.end());
+
+	CHECK(s.insert(5).second);
+	CHECK(s.insert(2).second);
+	CHECK(s.insert(9).second);
+	CHECK_FALSE(s.insert(2).second);
+	CHECK(s.size() == 3);
+
+	// insertion order
+	CHECK(std::vector<int>(s.begin(), s.end()) == std::vector<int>{5, 2, 9});
+
+	// erase moves the last member into the hole
+	CHECK(s.erase(5) == 1);
+	CHECK(s.erase(5) == 0);
+	CHECK(std::vector<int>(s.begin(), s.end()) == std::vector<int>{9, 2});
+	CHECK(*s.find(9) == 9);
+	CHECK(*s.find(2) == 2);
+	CHECK(s.count(5) == 0);
+
+	CHECK(s == spring::SparseIDSet{2, 9});
+	CHECK(s != spring::SparseIDSet{2});
+
+	s.clear();
+	CHECK(s.empty());
+	CHECK(s.find(9) == s.end());
+	CHECK(s.insert(9).second);
+}
+
+TEST_CASE("SparseIDSet_Random")
+{
+	std::mt19937 rng(1);
+	std::uniform_int_distribution<int> dist(0, 999);
+
+	spring::SparseIDSet s;
+	std::set<int> ref;
+
+	for (int i = 0; i < 20000; i++) {
+		const int id = dist(rng);
+
+		if ((rng() & 1) != 0) {
+			CHECK(s.insert(id).second == ref.insert(id).second);
+		} else {
+			CHECK(s.erase(id) == ref.erase(id));
+		}
+	}
+
+	std::vector<int> ids(s.begin(), s.end());
+	std::sort(ids.begin(), ids.end());
+
+	CHECK(ids == std::vector<int>(ref.begin(), ref.end()));
+}
+
+TEST_CASE("SmallVectorMap")
+{
+	spring::SmallVectorMap<int, int> m;
+
+	m[3] = 30;
+	m[1] = 10;
+	CHECK(m.insert({2, 20}).second);
+	CHECK_FALSE(m.insert({2, 21}).second);
+	CHECK(m.size() == 3);
+	CHECK(m.find(2)->second == 20);
+	CHECK(m.find(4) == m.end());
+
+	CHECK(m.erase(3) == 1);
+	CHECK(m.erase(3) == 0);
+	CHECK(m.size() == 2);
+	CHECK(m[1] == 10);
+	CHECK(m[2] == 20);
+	CHECK(m.count(3) == 0);
+}
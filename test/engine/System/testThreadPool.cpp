@@ -256,6 +256,86 @@ TEST_CASE("test_for_vs_for_mt")
 }
 
 
+static void nested_for_mt_kernel(const int numOuter, const int numInner, const spring_time kernelLoad)
+{
+	LOG("\t[%s] running %.3fms kernel for %ix%i nested runs (%.0fms total runtime):", __func__, kernelLoad.toMilliSecsf(), numOuter, numInner, (kernelLoad * (numOuter * numInner)).toMilliSecsf());
+
+	spring_time t_flat;
+	spring_time t_nested;
+
+	std::atomic<int> cnt(0);
+
+	const auto& ExecKernel = [](const spring_time t) {
+		const spring_time finish = spring_now() + t;
+		while (spring_now() < finish) {}
+	};
+
+	{
+		const spring_time start = spring_now();
+
+		for_mt(0, numOuter * numInner, [&](const int i) {
+			ExecKernel(kernelLoad);
+		});
+
+		t_flat = (spring_now() - start);
+	}
+	{
+		const spring_time start = spring_now();
+
+		for_mt(0, numOuter, [&](const int y) {
+			for_mt(0, numInner, [&](const int x) {
+				ExecKernel(kernelLoad);
+				cnt.fetch_add(1);
+			});
+		});
+
+		t_nested = (spring_now() - start);
+	}
+
+	CHECK(cnt.load() == (numOuter * numInner));
+
+	LOG("\t\tflat   for_mt took %.4fms (%.1f iterations/ms)", t_flat.toMilliSecsf(), (numOuter * numInner) / std::max(t_flat.toMilliSecsf(), 0.001f));
+	LOG("\t\tnested for_mt took %.4fms (%.1f iterations/ms)", t_nested.toMilliSecsf(), (numOuter * numInner) / std::max(t_nested.toMilliSecsf(), 0.001f));
+	LOG("\t\tnested runtime: %.0f%%", (t_nested.toMilliSecsf() / t_flat.toMilliSecsf()) * 100.0f);
+}
+
+TEST_CASE("test_nested_for_mt_throughput")
+{
+	nested_for_mt_kernel(  4,  250, spring_time::fromMicroSecs(5));
+	nested_for_mt_kernel(100,   10, spring_time::fromMicroSecs(5));
+	nested_for_mt_kernel( 10,   10, spring_time::fromMicroSecs(50));
+	nested_for_mt_kernel(  2,    2, spring_time::fromMicroSecs(1000));
+}
+
+TEST_CASE("test_low_priority_for_mt")
+{
+	LOG("[%s::test_low_priority_for_mt]", __func__);
+
+	std::atomic<int> cnt(0);
+
+	{
+		ThreadPool::ScopedTaskPriority stp(ThreadPool::PRIORITY_LOW);
+
+		for_mt(0, 100, [&](const int y) {
+			// nested loops inherit the priority of their parent
+			SAFE_CHECK(ThreadPool::GetTaskPriority() == ThreadPool::PRIORITY_LOW);
+
+			for_mt(0, 100, [&](const int x) {
+				SAFE_CHECK(ThreadPool::GetTaskPriority() == ThreadPool::PRIORITY_LOW);
+				cnt.fetch_add(1);
+			});
+		});
+	}
+
+	CHECK(cnt.load() == 100 * 100);
+	CHECK(ThreadPool::GetTaskPriority() == ThreadPool::PRIORITY_HIGH);
+
+	for_mt(0, 100, [&](const int i) {
+		SAFE_CHECK(ThreadPool::GetTaskPriority() == ThreadPool::PRIORITY_HIGH);
+	});
+}
+
+
 static void test_parallel_reaction_times_aux(int numRuns)
 {
 	LOG("\t[%s]", __func__);
@@ -2,13 +2,20 @@
 
 #include <string>
 #include <map>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <thread>
+#include <vector>
 #include <gflags/gflags.h>
 #include <iomanip> //hex
 
 #include "StringSerializer.h"
 
 #include "Net/Protocol/BaseNetProtocol.h"
+#include "System/FileSystem/FileSystemAbstraction.h"
 #include "System/LoadSave/DemoReader.h"
 #include "System/Net/RawPacket.h"
 #include "Sim/Units/CommandAI/Command.h"
@@ -17,6 +24,10 @@
 Usage:
 Start with the full! path to the demofile as the only argument
 
+With --batchdir=<dir> all demos in <dir> are scanned by a pool of threads
+instead, and per-game, per-player and per-team tables are written to
+<batchcsv>_games.csv, <batchcsv>_players.csv and <batchcsv>_teams.csv
+
 Please note that not all NETMSG's are implemented, expand if needed.
 
 When compiling for windows with MinGW, make sure to use the
@@ -32,10 +43,14 @@ no console output (you still could use this.exe > z.tzt though).
 	DEFINE_bool  (teamstats,    false, "Print teamstats");
 	DEFINE_int32 (team,         -1,    "Select team");
 	DEFINE_string(teamsstatcsv, "",    "Write teamstats in a csv file");
+	DEFINE_string(batchdir,     "",    "Scan all demos in this directory in parallel");
+	DEFINE_string(batchcsv,     "demostats", "Prefix of the csv files written for batchdir");
+	DEFINE_int32 (threads,      0,     "Number of threads used for batchdir (0: one per core)");
 
 
 void TrafficDump(CDemoReader& reader, bool trafficStats);
 void WriteTeamstatHistory(CDemoReader& reader, unsigned team, const std::string& file);
+int BatchScan(const std::string& dir, const std::string& csvPrefix, int numThreads);
 
 int main (int argc, char* argv[])
 {
@@ -43,6 +58,9 @@ int main (int argc, char* argv[])
 
 	gflags::SetUsageMessage(std::string("Usage: ") + argv[0] + " [options] path_to_demo.sdfz");
 	gflags::ParseCommandLineFlags(&argc, &argv, true);
+	if (!FLAGS_batchdir.empty())
+		return BatchScan(FLAGS_batchdir, FLAGS_batchcsv, FLAGS_threads);
+
 	if (!FLAGS_demofile.empty()) {
 		filename = FLAGS_demofile;
 	} else if (argc >= 2) {
@@ -342,6 +360,26 @@ void TrafficDump(CDemoReader& reader, bool trafficStats)
 				}
 				std::cout << std::endl;
 				break;
+			case NETMSG_SELECT_DELTA: {
+				std::cout << "NETMGS_SELECT_DELTA: Playernum: " << (unsigned)buffer[3];
+				std::cout << " Length: " << (unsigned)packet->length;
+				std::cout << " Unit IDs:";
+				int unitID = -1;
+				unsigned delta = 0;
+				unsigned shift = 0;
+				for (unsigned short i = 4; i < packet->length; i += 1) {
+					delta |= (buffer[i] & 0x7F) << shift;
+					shift += 7;
+					if (buffer[i] & 0x80)
+						continue;
+					unitID += delta + 1;
+					std::cout << " " << unitID;
+					delta = 0;
+					shift = 0;
+				}
+				std::cout << std::endl;
+				break;
+			}
 			case NETMSG_GAMEOVER:
 				std::cout << "NETMSG_GAMEOVER";
 				std::cout << " Length: " << (unsigned)packet->length;
@@ -421,6 +459,9 @@ void TrafficDump(CDemoReader& reader, bool trafficStats)
 				std::cout << " Checksum: " << (unsigned)buffer[6];
 				std::cout << std::endl;
 				break;
+			case NETMSG_SYNCTREE_REQUEST:
+				std::cout << "NETMSG_SYNCTREE_REQUEST: Framenum: " << *(int*)(buffer+1) << std::endl;
+				break;
 			case NETMSG_DIRECT_CONTROL:
 				std::cout << "NETMSG_DIRECT_CONTROL: " << std::endl;
 				break;
@@ -504,3 +545,185 @@ void WriteTeamstatHistory(CDemoReader& reader, unsigned team, const std::string&
 		exit(1);
 	}
 };
+
+
+struct DemoSummary
+{
+	std::string file;
+	std::string error;
+
+	DemoFileHeader header;
+
+	std::vector<PlayerStatistics> playerStats;
+	std::vector<TeamStatistics> finalTeamStats; // last entry of each team's history
+	std::vector<unsigned char> winningAllyTeams;
+	std::vector<unsigned> playerCommands; // NETMSG_(AI)COMMAND(S) packets per player
+};
+
+void ScanDemo(const std::string& file, DemoSummary& summary)
+{
+	summary.file = file;
+	memset(&summary.header, 0, sizeof(summary.header));
+
+	try {
+		CDemoReader reader(file, 0.0f);
+		reader.LoadStats();
+
+		summary.header = reader.GetFileHeader();
+
+		// the reader only warns about these in tools
+		if (memcmp(summary.header.magic, DEMOFILE_MAGIC, sizeof(summary.header.magic)) != 0) {
+			summary.error = "not a demo file";
+			return;
+		}
+
+		summary.playerStats = reader.GetPlayerStats();
+		summary.winningAllyTeams = reader.GetWinningAllyTeams();
+
+		for (const std::vector<TeamStatistics>& history: reader.GetTeamStats()) {
+			summary.finalTeamStats.emplace_back();
+
+			if (history.empty()) {
+				memset(&summary.finalTeamStats.back(), 0, sizeof(TeamStatistics));
+			} else {
+				summary.finalTeamStats.back() = history.back();
+			}
+		}
+
+		while (!reader.ReachedEnd()) {
+			netcode::RawPacket* packet = reader.GetData(3.402823466e+38f);
+			if (packet == NULL)
+				continue;
+
+			switch (packet->data[0]) {
+				case NETMSG_COMMAND:
+				case NETMSG_AICOMMAND:
+				case NETMSG_AICOMMANDS: {
+					if (packet->length <= 3)
+						break;
+
+					const unsigned playerNum = packet->data[3];
+
+					if (playerNum >= summary.playerCommands.size())
+						summary.playerCommands.resize(playerNum + 1, 0);
+
+					summary.playerCommands[playerNum] += 1;
+				} break;
+				default: {
+				} break;
+			}
+
+			delete packet;
+		}
+	} catch (const std::exception& ex) {
+		summary.error = ex.what();
+	}
+}
+
+int BatchScan(const std::string& dir, const std::string& csvPrefix, int numThreads)
+{
+	std::vector<std::string> files;
+	FileSystemAbstraction::FindFiles(files, FileSystemAbstraction::EnsurePathSepAtEnd(dir), "", "^.*\\.sdfz$", 0);
+	std::sort(files.begin(), files.end());
+
+	for (std::string& file: files) {
+		file = FileSystemAbstraction::EnsurePathSepAtEnd(dir) + file;
+	}
+
+	if (numThreads <= 0)
+		numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+	std::cout << "Scanning " << files.size() << " demos with " << numThreads << " threads" << std::endl;
+
+	// demos are independent, every worker picks the next unscanned one
+	std::vector<DemoSummary> summaries(files.size());
+	std::vector<std::thread> workers;
+	std::atomic<size_t> nextFile = {0};
+
+	for (int i = 0; i < numThreads; ++i) {
+		workers.emplace_back([&]() {
+			for (size_t n = nextFile++; n < files.size(); n = nextFile++) {
+				ScanDemo(files[n], summaries[n]);
+			}
+		});
+	}
+	for (std::thread& worker: workers) {
+		worker.join();
+	}
+
+	std::ofstream games((csvPrefix + "_games.csv").c_str());
+	std::ofstream players((csvPrefix + "_players.csv").c_str());
+	std::ofstream teams((csvPrefix + "_teams.csv").c_str());
+
+	games << "File;GameID;GameTime;WallclockTime;NumPlayers;NumTeams;WinningAllyTeams;Error" << std::endl;
+	players << "File;Player;MousePixels;MouseClicks;KeyPresses;NumCommands;UnitCommands;CommandPackets" << std::endl;
+	teams << "File;Team;Frame;MetalUsed;EnergyUsed;MetalProduced;EnergyProduced;MetalExcess;EnergyExcess;"
+	      << "MetalReceived;EnergyReceived;MetalSent;EnergySent;DamageDealt;DamageReceived;"
+	      << "UnitsProduced;UnitsDied;UnitsReceived;UnitsSent;UnitsCaptured;"
+	      << "UnitsOutCaptured;UnitsKilled" << std::endl;
+
+	unsigned numErrors = 0;
+
+	for (const DemoSummary& summary: summaries) {
+		PrintSep(games, summary.file);
+		for (unsigned char c: summary.header.gameID) {
+			games << std::setw(2) << std::setfill('0') << std::hex << (unsigned) c;
+		}
+		games << std::dec << ";";
+		PrintSep(games, summary.header.gameTime);
+		PrintSep(games, summary.header.wallclockTime);
+		PrintSep(games, summary.header.numPlayers);
+		PrintSep(games, summary.header.numTeams);
+		for (unsigned char allyTeam: summary.winningAllyTeams) {
+			games << (unsigned) allyTeam << " ";
+		}
+		games << ";" << summary.error << std::endl;
+
+		numErrors += !summary.error.empty();
+
+		for (unsigned i = 0; i < summary.playerStats.size(); ++i) {
+			const PlayerStatistics& stats = summary.playerStats[i];
+
+			PrintSep(players, summary.file);
+			PrintSep(players, i);
+			PrintSep(players, stats.mousePixels);
+			PrintSep(players, stats.mouseClicks);
+			PrintSep(players, stats.keyPresses);
+			PrintSep(players, stats.numCommands);
+			PrintSep(players, stats.unitCommands);
+			PrintSep(players, (i < summary.playerCommands.size())? summary.playerCommands[i]: 0u);
+			players << std::endl;
+		}
+
+		for (unsigned i = 0; i < summary.finalTeamStats.size(); ++i) {
+			const TeamStatistics& stats = summary.finalTeamStats[i];
+
+			PrintSep(teams, summary.file);
+			PrintSep(teams, i);
+			PrintSep(teams, stats.frame);
+			PrintSep(teams, stats.metalUsed);
+			PrintSep(teams, stats.energyUsed);
+			PrintSep(teams, stats.metalProduced);
+			PrintSep(teams, stats.energyProduced);
+			PrintSep(teams, stats.metalExcess);
+			PrintSep(teams, stats.energyExcess);
+			PrintSep(teams, stats.metalReceived);
+			PrintSep(teams, stats.energyReceived);
+			PrintSep(teams, stats.metalSent);
+			PrintSep(teams, stats.energySent);
+			PrintSep(teams, stats.damageDealt);
+			PrintSep(teams, stats.damageReceived);
+			PrintSep(teams, stats.unitsProduced);
+			PrintSep(teams, stats.unitsDied);
+			PrintSep(teams, stats.unitsReceived);
+			PrintSep(teams, stats.unitsSent);
+			PrintSep(teams, stats.unitsCaptured);
+			PrintSep(teams, stats.unitsOutCaptured);
+			PrintSep(teams, stats.unitsKilled);
+			teams << std::endl;
+		}
+	}
+
+	std::cout << "Scanned " << summaries.size() << " demos, " << numErrors << " could not be read" << std::endl;
+	return (numErrors == 0)? 0: 1;
+}
@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+
+## purpose: compares two binary /DumpState files (DumpStateBinary=1) frame by
+##          frame and prints the first object and field where they diverge
+##
+## usage:   ./dumpstate_diff.py [--all] ServerGameState-*.bin ClientGameState-*.bin
+##          --all keeps going and reports the first difference of every frame
+##
+## see rts/System/Sync/DumpState.cpp for the file layout
+
+import struct
+import sys
+
+FILE_MAGIC  = b"SPRSTATE"
+FRAME_MAGIC = b"FRAM"
+VERSION     = 1
+
+
+class Reader:
+	def __init__(self, data):
+		self.data = data
+		self.pos = 0
+
+	def eof(self):
+		return (self.pos >= len(self.data))
+
+	def read(self, n):
+		if (self.pos + n) > len(self.data):
+			raise EOFError("truncated file")
+
+		b = self.data[self.pos: self.pos + n]
+		self.pos += n
+		return b
+
+	def unpack(self, fmt):
+		return struct.unpack(fmt, self.read(struct.calcsize(fmt)))
+
+	def string(self):
+		(n, ) = self.unpack("<H")
+		return self.read(n).decode("utf-8", "replace")
+
+
+def read_section(data):
+	r = Reader(data)
+
+	name = r.string()
+	(numFields, ) = r.unpack("<H")
+	fields = []
+
+	for i in range(numFields):
+		fields.append((chr(r.read(1)[0]), r.string()))
+
+	(numRecords, ) = r.unpack("<I")
+	fmt = "<ii" + ("I" * numFields)
+	records = []
+
+	for i in range(numRecords):
+		rec = r.unpack(fmt)
+		records.append(((rec[0], rec[1]), rec[2:]))
+
+	return name, fields, records
+
+
+def read_dump(fileName):
+	with open(fileName, "rb") as f:
+		r = Reader(f.read())
+
+	if r.read(len(FILE_MAGIC)) != FILE_MAGIC:
+		raise ValueError("%s is not a binary state dump" % fileName)
+
+	(version, ) = r.unpack("<I")
+
+	if version != VERSION:
+		raise ValueError("%s has version %d, expected %d" % (fileName, version, VERSION))
+
+	header = {
+		"mapName": r.string(),
+		"modName": r.string(),
+	}
+	header["minFrame"], header["maxFrame"], header["randSeed"], header["initSeed"] = r.unpack("<iiII")
+
+	frames = []
+
+	try:
+		while not r.eof():
+			if r.read(len(FRAME_MAGIC)) != FRAME_MAGIC:
+				raise ValueError("%s: bad frame marker at offset %d" % (fileName, r.pos - len(FRAME_MAGIC)))
+
+			frameNum, seed, numSections = r.unpack("<iII")
+			sections = {}
+			order = []
+
+			for i in range(numSections):
+				(size, ) = r.unpack("<I")
+				name, fields, records = read_section(r.read(size))
+				sections[name] = (fields, records)
+				order.append(name)
+
+			frames.append((frameNum, seed, order, sections))
+	except EOFError:
+		# the last frame may still have been in flight when the game ended
+		print("%s: truncated after frame %d" % (fileName, frames[-1][0] if frames else -1))
+
+	return header, frames
+
+
+def format_value(fieldType, value):
+	if fieldType == "f":
+		return "%.9g (0x%08x)" % (struct.unpack("<f", struct.pack("<I", value))[0], value)
+	if fieldType == "i":
+		return "%d" % struct.unpack("<i", struct.pack("<I", value))[0]
+
+	return "%u (0x%08x)" % (value, value)
+
+
+def format_key(key):
+	if key[1] < 0:
+		return "id=%d" % key[0]
+
+	return "id=%d[%d]" % key
+
+
+## returns a description of the first difference between two sections, or None
+def diff_section(name, a, b):
+	fieldsA, recordsA = a
+	fieldsB, recordsB = b
+
+	if fieldsA != fieldsB:
+		return "section %s: different fields, the dumps were written by different engine versions" % name
+
+	mapB = dict(recordsB)
+	keysA = set()
+
+	for key, valuesA in recordsA:
+		keysA.add(key)
+
+		if key not in mapB:
+			return "section %s: %s only in the first dump" % (name, format_key(key))
+
+		valuesB = mapB[key]
+
+		for (fieldType, fieldName), va, vb in zip(fieldsA, valuesA, valuesB):
+			if va != vb:
+				return "section %s: %s field %s: %s != %s" % (name, format_key(key), fieldName, format_value(fieldType, va), format_value(fieldType, vb))
+
+	for key, valuesB in recordsB:
+		if key not in keysA:
+			return "section %s: %s only in the second dump" % (name, format_key(key))
+
+	if [k for k, v in recordsA] != [k for k, v in recordsB]:
+		return "section %s: same objects, but in a different order" % name
+
+	return None
+
+
+def diff_frame(frameA, frameB):
+	frameNum, seedA, orderA, sectionsA = frameA
+	frameNum, seedB, orderB, sectionsB = frameB
+
+	diffs = []
+
+	## checksums come first, so a mismatch there names the subsystem before the object
+	for name in orderA:
+		if name not in sectionsB:
+			diffs.append("section %s only in the first dump" % name)
+			continue
+
+		d = diff_section(name, sectionsA[name], sectionsB[name])
+
+		if d is not None:
+			diffs.append(d)
+
+	for name in orderB:
+		if name not in sectionsA:
+			diffs.append("section %s only in the second dump" % name)
+
+	if seedA != seedB:
+		diffs.append("RNG seed: %u != %u" % (seedA, seedB))
+
+	return diffs
+
+
+def main(argv):
+	reportAll = ("--all" in argv)
+	fileNames = [a for a in argv[1:] if a != "--all"]
+
+	if len(fileNames) != 2:
+		print("usage: %s [--all] <dump1.bin> <dump2.bin>" % argv[0])
+		return 2
+
+	headerA, framesA = read_dump(fileNames[0])
+	headerB, framesB = read_dump(fileNames[1])
+
+	for key in ("mapName", "modName", "initSeed"):
+		if headerA[key] != headerB[key]:
+			print("warning: %s differs (%s vs %s)" % (key, headerA[key], headerB[key]))
+
+	framesB = dict((f[0], f) for f in framesB)
+	numCompared = 0
+	numDiverged = 0
+
+	for frameA in framesA:
+		frameB = framesB.get(frameA[0])
+
+		if frameB is None:
+			continue
+
+		numCompared += 1
+		diffs = diff_frame(frameA, frameB)
+
+		if not diffs:
+			continue
+
+		numDiverged += 1
+		print("frame %d: %s" % (frameA[0], diffs[0]))
+
+		for d in diffs[1:]:
+			print("frame %d: %s" % (frameA[0], d))
+
+		if not reportAll:
+			break
+
+	if numCompared == 0:
+		print("no common frames")
+		return 2
+
+	if numDiverged == 0:
+		print("%d common frames, no differences" % numCompared)
+		return 0
+
+	return 1
+
+
+if __name__ == "__main__":
+	sys.exit(main(sys.argv))
@@ -4,7 +4,9 @@
 #include "unitsync_api.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <memory>
 #include <string>
 #include <vector>
 #include <set>
@@ -34,6 +36,7 @@
 #include "System/Log/DefaultFilter.h"
 #include "System/Misc/SpringTime.h"
 #include "System/Platform/Misc.h" //!!
+#include "System/Platform/Threading.h"
 #include "System/Threading/ThreadPool.h"
 #include "System/Exceptions.h"
 #include "System/Info.h"
@@ -903,14 +906,12 @@ static unsigned short* GetMinimapSM3(std::string mapFileName, int mipLevel)
 	*/
 }
 
-static unsigned short* GetMinimapSMF(std::string mapFileName, int mipLevel)
+static void DecodeMinimapSMF(CSMFMapFile& in, int mipLevel, unsigned short* colors)
 {
-	CSMFMapFile in(mapFileName);
 	std::vector<uint8_t> buffer;
 	const int mipsize = in.ReadMinimap(buffer, mipLevel);
 
 	// Do stuff
-	unsigned short* colors = (unsigned short*)((void*)imgbuf);
 	unsigned char* temp = &buffer[0];
 
 	const int numblocks = buffer.size() / 8;
@@ -958,8 +959,13 @@ static unsigned short* GetMinimapSMF(std::string mapFileName, int mipLevel)
 		}
 		temp += 8;
 	}
+}
 
-	return colors;
+static unsigned short* GetMinimapSMF(std::string mapFileName, int mipLevel)
+{
+	CSMFMapFile in(mapFileName);
+	DecodeMinimapSMF(in, mipLevel, imgbuf);
+	return imgbuf;
 }
 
 EXPORT(unsigned short*) GetMinimap(const char* mapName, int mipLevel)
@@ -989,6 +995,186 @@ EXPORT(unsigned short*) GetMinimap(const char* mapName, int mipLevel)
 }
 
 
+//////////////////////////
+//////////////////////////
+
+/**
+ * @brief result of ProcessMapsBatch for one map
+ */
+struct BatchMapInfo
+{
+	std::string name;
+	std::string error;                 ///< empty if the map was processed
+	std::vector<InfoItem> infoItems;   ///< scanned mapinfo.lua root entries
+	std::vector<unsigned short> minimap;
+	unsigned int checksum = 0;
+	int width = 0;
+	int height = 0;
+};
+
+static std::vector<BatchMapInfo> batchMapInfos;
+
+
+// runs on a worker; may only touch <info> and the (locked) archive-scanner
+static void ProcessBatchMap(BatchMapInfo& info, int mipLevel)
+{
+	const std::string mapFile = GetMapFile(info.name);
+	const std::string archiveName = archiveScanner->ArchiveFromName(info.name);
+
+	info.infoItems = archiveScanner->GetArchiveData(info.name).GetInfoItems();
+	info.checksum = archiveScanner->GetArchiveCompleteChecksum(info.name);
+
+	if (FileSystem::GetExtension(mapFile) != "smf")
+		throw content_error("unsupported map format of \"" + mapFile + "\"");
+
+	// the map is read straight from its archive, ScopedMapLoader swaps the global VFS
+	std::unique_ptr<IArchive> archive(archiveLoader.OpenArchive(archiveScanner->GetArchivePath(archiveName) + archiveName));
+	CFileView mapFileView;
+
+	if (archive == nullptr || !archive->IsOpen())
+		throw content_error("could not open archive \"" + archiveName + "\"");
+	if (!archive->GetFileView(mapFile, mapFileView))
+		throw content_error("could not read \"" + mapFile + "\" from \"" + archiveName + "\"");
+
+	CSMFMapFile file(mapFile, mapFileView);
+	const SMFHeader& mh = file.GetHeader();
+
+	info.width  = mh.mapx * SQUARE_SIZE;
+	info.height = mh.mapy * SQUARE_SIZE;
+
+	info.minimap.resize((1024 >> mipLevel) * (1024 >> mipLevel));
+	DecodeMinimapSMF(file, mipLevel, info.minimap.data());
+}
+
+EXPORT(int) ProcessMapsBatch(int firstIndex, int count, int mipLevel)
+{
+	try {
+		CheckInit();
+		CheckBounds(firstIndex, mapNames.size());
+		CheckPositive(count);
+
+		if (mipLevel < 0 || mipLevel > 8)
+			throw std::out_of_range("Miplevel must be between 0 and 8 (inclusive) in ProcessMapsBatch.");
+
+		count = std::min(count, int(mapNames.size()) - firstIndex);
+
+		batchMapInfos.clear();
+		batchMapInfos.resize(count);
+
+		for (int i = 0; i < count; i++) {
+			batchMapInfos[i].name = mapNames[firstIndex + i];
+		}
+
+		// unitsync has no thread-pool, so spawn the workers here
+		std::vector<spring::thread> workers(std::min(count, std::max(1, Threading::GetLogicalCpuCores())));
+		std::atomic<int> nextMap = {0};
+
+		for (spring::thread& worker: workers) {
+			worker = spring::thread([&]() {
+				for (int i = nextMap++; i < count; i = nextMap++) {
+					try {
+						ProcessBatchMap(batchMapInfos[i], mipLevel);
+					} catch (const std::exception& ex) {
+						batchMapInfos[i].error = ex.what();
+					}
+				}
+			});
+		}
+
+		for (spring::thread& worker: workers) {
+			worker.join();
+		}
+
+		const auto isValid = [](const BatchMapInfo& info) { return info.error.empty(); };
+		const int numValid = std::count_if(batchMapInfos.begin(), batchMapInfos.end(), isValid);
+
+		if (numValid < count)
+			SetLastError(IntToString(count - numValid) + " of " + IntToString(count) + " maps could not be processed");
+
+		return numValid;
+	}
+	UNITSYNC_CATCH_BLOCKS;
+
+	batchMapInfos.clear();
+	return -1;
+}
+
+static BatchMapInfo& GetBatchMapInfo(int batchIndex)
+{
+	CheckInit();
+	CheckBounds(batchIndex, batchMapInfos.size());
+
+	return batchMapInfos[batchIndex];
+}
+
+EXPORT(const char*) GetBatchMapError(int batchIndex)
+{
+	try {
+		const BatchMapInfo& info = GetBatchMapInfo(batchIndex);
+
+		if (info.error.empty())
+			return nullptr;
+
+		return GetStr(info.error);
+	}
+	UNITSYNC_CATCH_BLOCKS;
+	return nullptr;
+}
+
+EXPORT(unsigned int) GetBatchMapChecksum(int batchIndex)
+{
+	try {
+		return (GetBatchMapInfo(batchIndex).checksum);
+	}
+	UNITSYNC_CATCH_BLOCKS;
+	return 0;
+}
+
+EXPORT(int) GetBatchMapWidth(int batchIndex)
+{
+	try {
+		return (GetBatchMapInfo(batchIndex).width);
+	}
+	UNITSYNC_CATCH_BLOCKS;
+	return -1;
+}
+
+EXPORT(int) GetBatchMapHeight(int batchIndex)
+{
+	try {
+		return (GetBatchMapInfo(batchIndex).height);
+	}
+	UNITSYNC_CATCH_BLOCKS;
+	return -1;
+}
+
+EXPORT(unsigned short*) GetBatchMapMinimap(int batchIndex)
+{
+	try {
+		BatchMapInfo& info = GetBatchMapInfo(batchIndex);
+
+		if (info.minimap.empty())
+			return nullptr;
+
+		return (info.minimap.data());
+	}
+	UNITSYNC_CATCH_BLOCKS;
+	return nullptr;
+}
+
+EXPORT(int) GetBatchMapInfoCount(int batchIndex)
+{
+	try {
+		infoItems = GetBatchMapInfo(batchIndex).infoItems;
+		return (int)infoItems.size();
+	}
+	UNITSYNC_CATCH_BLOCKS;
+
+	infoItems.clear();
+	return -1;
+}
+
+
 EXPORT(int) GetInfoMapSize(const char* mapName, const char* name, int* width, int* height)
 {
 	try {
@@ -329,6 +329,66 @@ EXPORT(unsigned int) GetMapChecksumFromName(const char* mapName);
  * This would return a 16 bit packed RGB-565 256x256 (= 1024/2^2) bitmap.
  */
 EXPORT(unsigned short*) GetMinimap(const char* fileName, int mipLevel);
+/**
+ * @brief Processes a range of maps at once, on as many threads as there are
+ *   CPU cores
+ * @param firstIndex index of the first map to process
+ * @param count      number of maps to process, clamped to GetMapCount()
+ * @param mipLevel   minimap mip-level to extract, see GetMinimap
+ * @return negative integer (< 0) on error; the number of maps which could be
+ *   processed (>= 0) on success
+ * @see GetMapCount
+ * @see GetBatchMapError
+ *
+ * Meant for indexing large collections of maps: each map's checksum, size,
+ * minimap and scanned info items are extracted in one go, and the maps are
+ * read directly from their archives instead of being loaded into the VFS one
+ * after another. Batch index i refers to the map at firstIndex + i, results
+ * remain valid until the next call of this function.
+ *
+ * Be sure to call GetMapCount() prior to using this function.
+ */
+EXPORT(int         ) ProcessMapsBatch(int firstIndex, int count, int mipLevel);
+/**
+ * @brief Why a map of the last batch could not be processed
+ * @param batchIndex index of the map in the last batch
+ * @return NULL if the map was processed (or on error); the error otherwise
+ * @see ProcessMapsBatch
+ */
+EXPORT(const char* ) GetBatchMapError(int batchIndex);
+/**
+ * @brief Get the checksum of a map of the last batch
+ * @return Zero on error; the checksum on success
+ * @see GetMapChecksum
+ */
+EXPORT(unsigned int) GetBatchMapChecksum(int batchIndex);
+/**
+ * @brief Get the width of a map of the last batch
+ * @return negative integer (< 0) on error; the width in elmos on success
+ */
+EXPORT(int         ) GetBatchMapWidth(int batchIndex);
+/**
+ * @brief Get the height of a map of the last batch
+ * @return negative integer (< 0) on error; the height in elmos on success
+ */
+EXPORT(int         ) GetBatchMapHeight(int batchIndex);
+/**
+ * @brief Get the minimap of a map of the last batch
+ * @return NULL on error; the minimap at the batch's mip-level in the same
+ *   format as GetMinimap on success
+ * @see GetMinimap
+ */
+EXPORT(unsigned short*) GetBatchMapMinimap(int batchIndex);
+/**
+ * @brief Retrieves the number of info items of a map of the last batch
+ * @return negative integer (< 0) on error;
+ *   the number of info items available (>= 0) on success
+ * @see GetInfoKey
+ *
+ * These are the entries of the map's mapinfo.lua as known to the archive
+ * scanner (e.g. "description", "author", "maxmetal").
+ */
+EXPORT(int         ) GetBatchMapInfoCount(int batchIndex);
 /**
  * @brief Retrieves dimensions of infomap for a map.
  * @param mapName  The name of the map, e.g. "SmallDivide".